@@ -0,0 +1,188 @@
+/*
+ * MotorObs.c - Sensorless Rotor Position and Speed Observer
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains a voltage-model flux observer with a
+ *              phase-locked loop, in per-unit fixed-point arithmetic:
+ *
+ *              psi_s = integral(v - Rs * i) with a shift-based leak
+ *              psi_r = psi_s - Ls * i          (rotor flux, at rotor angle)
+ *              err   = psi_r x [cos, sin](theta) = |psi_r| * sin(angle error)
+ *              PI on err gives the electrical speed, its integral the angle
+ *
+ *              Signals are Q15 per-unit of the bases in MotorObs_Cfg.h,
+ *              the stator flux state is kept in Q24 so the leak and small
+ *              voltage drops do not vanish in truncation. The angle is a
+ *              32-bit phase accumulator, upper 16 bits = 1/65536 turn.
+ */
+
+#include "MotorObs.h"
+#include "MotorObs_Cfg.h"
+#include "Det.h"
+#include "Lut.h"
+
+/* Q15 constants */
+#define MOTOROBS_ONE_THIRD           MOTOROBS_Q15(1.0 / 3.0)
+#define MOTOROBS_INV_SQRT3           MOTOROBS_Q15(0.57735026918963)
+
+/* Internal variables */
+static boolean MotorObs_Initialized = FALSE;
+static sint32 MotorObs_Vdc;              /* DC link voltage, Q15 pu */
+static sint32 MotorObs_PsiAlpha;         /* Stator flux, Q24 pu */
+static sint32 MotorObs_PsiBeta;
+static sint32 MotorObs_SpeedInt;         /* PLL integrator = filtered speed, Q30 pu (+/-2) */
+static sint32 MotorObs_Speed;            /* PLL output speed, Q15 pu */
+static uint32 MotorObs_Phase;            /* Rotor angle, 2^32 per electrical turn */
+static uint32 MotorObs_LockCount;
+
+/**
+ * @brief Initialize the observer
+ */
+void MotorObs_Init(void)
+{
+    MotorObs_Vdc = MOTOROBS_Q15(MOTOROBS_VDC_NOMINAL / MOTOROBS_V_BASE);
+    MotorObs_PsiAlpha = 0;
+    MotorObs_PsiBeta = 0;
+    MotorObs_SpeedInt = 0;
+    MotorObs_Speed = 0;
+    MotorObs_Phase = 0u;
+    MotorObs_LockCount = 0u;
+    MotorObs_Initialized = TRUE;
+}
+
+/**
+ * @brief Set the DC link voltage used to convert duty cycles to voltages
+ * @param raw ADC result of the DC link voltage channel
+ */
+void MotorObs_SetDcLinkVoltage(AdcIf_ValueType raw)
+{
+    MotorObs_Vdc = ((sint32)raw * MOTOROBS_VDC_SCALE_Q8) >> 8;
+}
+
+/**
+ * @brief Run one observer step
+ * 
+ * To be called once per PWM period with the phase currents sampled in
+ * that period and the duty cycles that were active while they were sampled.
+ * 
+ * @param phaseCurrents ADC results of the U, V, W phase currents
+ * @param dutyU Applied duty cycle of phase U
+ * @param dutyV Applied duty cycle of phase V
+ * @param dutyW Applied duty cycle of phase W
+ */
+void MotorObs_Update(const AdcIf_ValueType *phaseCurrents, PwmIf_DutyType dutyU,
+                     PwmIf_DutyType dutyV, PwmIf_DutyType dutyW)
+{
+    sint32 iu, iv, iw;
+    sint32 vu, vv, vw;
+    sint32 iAlpha, iBeta;
+    sint32 vAlpha, vBeta;
+    sint32 psiRAlpha, psiRBeta;
+    sint32 sinTheta, cosTheta;
+    sint32 err;
+    uint16 angle;
+
+    if (MotorObs_Initialized == FALSE)
+    {
+        Det_ReportError(MOTOROBS_MODULE_ID, 0, MOTOROBS_UPDATE_SID, MOTOROBS_E_UNINIT);
+        return;
+    }
+    if (phaseCurrents == NULL_PTR)
+    {
+        Det_ReportError(MOTOROBS_MODULE_ID, 0, MOTOROBS_UPDATE_SID, MOTOROBS_E_PARAM_POINTER);
+        return;
+    }
+
+    /* Phase currents and phase-to-midpoint voltages, Q15 pu */
+    iu = (((sint32)phaseCurrents[0] - MOTOROBS_ADC_CURRENT_OFFSET) * MOTOROBS_CURRENT_SCALE_Q8) >> 8;
+    iv = (((sint32)phaseCurrents[1] - MOTOROBS_ADC_CURRENT_OFFSET) * MOTOROBS_CURRENT_SCALE_Q8) >> 8;
+    iw = (((sint32)phaseCurrents[2] - MOTOROBS_ADC_CURRENT_OFFSET) * MOTOROBS_CURRENT_SCALE_Q8) >> 8;
+    vu = (((sint32)dutyU - 32768) * MotorObs_Vdc) >> 16;
+    vv = (((sint32)dutyV - 32768) * MotorObs_Vdc) >> 16;
+    vw = (((sint32)dutyW - 32768) * MotorObs_Vdc) >> 16;
+
+    /* Clarke transform using all three phases (rejects common mode) */
+    iAlpha = ((2 * iu - iv - iw) * MOTOROBS_ONE_THIRD) >> 15;
+    iBeta = ((iv - iw) * MOTOROBS_INV_SQRT3) >> 15;
+    vAlpha = ((2 * vu - vv - vw) * MOTOROBS_ONE_THIRD) >> 15;
+    vBeta = ((vv - vw) * MOTOROBS_INV_SQRT3) >> 15;
+
+    /* Stator flux: leaky integration of the back-EMF, Q15 * Q15 >> 6 = Q24 */
+    MotorObs_PsiAlpha += ((vAlpha - ((MOTOROBS_RS_PU * iAlpha) >> 15)) * MOTOROBS_WTS_PU) >> 6;
+    MotorObs_PsiBeta += ((vBeta - ((MOTOROBS_RS_PU * iBeta) >> 15)) * MOTOROBS_WTS_PU) >> 6;
+    MotorObs_PsiAlpha -= MotorObs_PsiAlpha >> MOTOROBS_FLUX_LEAK_SHIFT;
+    MotorObs_PsiBeta -= MotorObs_PsiBeta >> MOTOROBS_FLUX_LEAK_SHIFT;
+
+    /* Rotor flux, Q15 */
+    psiRAlpha = (MotorObs_PsiAlpha >> 9) - ((MOTOROBS_LS_PU * iAlpha) >> 15);
+    psiRBeta = (MotorObs_PsiBeta >> 9) - ((MOTOROBS_LS_PU * iBeta) >> 15);
+
+    /* PLL phase detector */
+    angle = (uint16)(MotorObs_Phase >> 16);
+    sinTheta = Lut_Sin(angle);
+    cosTheta = Lut_Cos(angle);
+    err = (psiRBeta * cosTheta - psiRAlpha * sinTheta) >> 15;
+
+    /* PI loop filter and angle integration; the integrator keeps 15 extra
+     * bits, truncating err * Ki to Q15 would bias the speed by ~0.5 %
+     */
+    MotorObs_SpeedInt += err * MOTOROBS_PLL_KI;
+    MotorObs_Speed = (MotorObs_SpeedInt >> 15) + ((err * MOTOROBS_PLL_KP) >> 15);
+    MotorObs_Phase += (uint32)(MotorObs_Speed * MOTOROBS_ANGLE_STEP);
+
+    /* Lock detection */
+    if (err < MOTOROBS_LOCK_ERROR && err > -MOTOROBS_LOCK_ERROR)
+    {
+        if (MotorObs_LockCount < MOTOROBS_LOCK_PERIODS)
+        {
+            MotorObs_LockCount++;
+        }
+    }
+    else
+    {
+        MotorObs_LockCount = 0u;
+    }
+}
+
+/**
+ * @brief Get the estimated electrical rotor angle
+ * 
+ * The angle is advanced by one period after each update, so it predicts
+ * the rotor position at the center of the period in which the duty
+ * cycles computed from it are applied.
+ * 
+ * @return Angle, full turn = 65536
+ */
+uint16 MotorObs_GetAngle(void)
+{
+    return (uint16)(MotorObs_Phase >> 16);
+}
+
+/**
+ * @brief Get the estimated electrical speed
+ * @return Speed, Q15 per-unit of MOTOROBS_W_BASE
+ */
+sint32 MotorObs_GetSpeed(void)
+{
+    return MotorObs_SpeedInt >> 15;
+}
+
+/**
+ * @brief Get the estimated mechanical speed
+ * @return Speed in 0.1 rpm, the raw scaling of ACTUAL_SPEED
+ */
+sint32 MotorObs_GetMechanicalSpeed(void)
+{
+    return (sint32)(((sint64)MotorObs_SpeedInt * MOTOROBS_SPEED_TO_RPM10) >> 30);
+}
+
+/**
+ * @brief Check whether the PLL tracks the rotor flux
+ * @return TRUE after MOTOROBS_LOCK_PERIODS periods with a small angle error
+ */
+boolean MotorObs_IsLocked(void)
+{
+    return (MotorObs_LockCount >= MOTOROBS_LOCK_PERIODS) ? TRUE : FALSE;
+}
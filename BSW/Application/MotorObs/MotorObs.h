@@ -0,0 +1,28 @@
+/*
+ * MotorObs.h - Sensorless Rotor Position and Speed Observer Header
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface definitions of the
+ *              fixed-point flux observer with PLL for the motor on TC377
+ */
+
+#ifndef MOTOROBS_H
+#define MOTOROBS_H
+
+#include "Std_Types.h"
+#include "AdcIf.h"
+#include "PwmIf.h"
+
+/* Function Prototypes */
+void MotorObs_Init(void);
+void MotorObs_SetDcLinkVoltage(AdcIf_ValueType raw);
+void MotorObs_Update(const AdcIf_ValueType *phaseCurrents, PwmIf_DutyType dutyU,
+                     PwmIf_DutyType dutyV, PwmIf_DutyType dutyW);
+uint16 MotorObs_GetAngle(void);
+sint32 MotorObs_GetSpeed(void);
+sint32 MotorObs_GetMechanicalSpeed(void);
+boolean MotorObs_IsLocked(void);
+
+#endif /* MOTOROBS_H */
@@ -0,0 +1,98 @@
+/*
+ * MotorObs_Cfg.h - Sensorless Rotor Observer Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Configuration file for the sensorless observer: motor
+ *              parameters, per-unit base values, measurement scaling and
+ *              PLL gains. All gains are folded into fixed-point constants
+ *              at compile time.
+ */
+
+#ifndef MOTOROBS_CFG_H
+#define MOTOROBS_CFG_H
+
+/* Module ID and Vendor ID */
+#define MOTOROBS_MODULE_ID          200
+#define MOTOROBS_VENDOR_ID          0xABCD
+
+/* Software Version Information */
+#define MOTOROBS_SW_MAJOR_VERSION   1
+#define MOTOROBS_SW_MINOR_VERSION   0
+#define MOTOROBS_SW_PATCH_VERSION   0
+
+/* API Service IDs */
+#define MOTOROBS_INIT_SID                0x01
+#define MOTOROBS_UPDATE_SID              0x02
+
+/* Development Error Codes */
+#define MOTOROBS_E_UNINIT                0x10
+#define MOTOROBS_E_PARAM_POINTER         0x11
+
+/* Conversion of a real constant to Q15 (non-negative values only) */
+#define MOTOROBS_Q15(x)                  ((sint32)((x) * 32768.0 + 0.5))
+
+/* Control period: one update per PWM period (20 kHz) */
+#define MOTOROBS_TS                      (50.0e-6)
+
+/* Motor parameters */
+#define MOTOROBS_RS                      (0.10)      /* Stator resistance [Ohm] */
+#define MOTOROBS_LS                      (200.0e-6)  /* Stator inductance [H] */
+#define MOTOROBS_PSI_M                   (0.010)     /* Permanent magnet flux [Vs] */
+#define MOTOROBS_POLE_PAIRS              (4)
+
+/* Per-unit base values */
+#define MOTOROBS_V_BASE                  (60.0)      /* [V] */
+#define MOTOROBS_I_BASE                  (20.0)      /* [A] */
+#define MOTOROBS_W_BASE                  (2.0 * 3.14159265358979 * 500.0) /* [rad/s electrical] */
+
+/* Phase current measurement: 12 bit, mid-scale offset, +/-25 A full scale */
+#define MOTOROBS_ADC_CURRENT_OFFSET      2048
+#define MOTOROBS_ADC_CURRENT_FULL_SCALE  (25.0)
+#define MOTOROBS_CURRENT_SCALE_Q8        ((sint32)(MOTOROBS_ADC_CURRENT_FULL_SCALE / MOTOROBS_I_BASE * \
+                                                   32768.0 / 2048.0 * 256.0 + 0.5))
+
+/* DC link voltage measurement: 12 bit, 0..100 V */
+#define MOTOROBS_ADC_VDC_FULL_SCALE      (100.0)
+#define MOTOROBS_VDC_SCALE_Q8            ((sint32)(MOTOROBS_ADC_VDC_FULL_SCALE / MOTOROBS_V_BASE * \
+                                                   32768.0 / 4096.0 * 256.0 + 0.5))
+#define MOTOROBS_VDC_NOMINAL             (48.0)
+
+/* Per-unit model constants */
+#define MOTOROBS_RS_PU                   MOTOROBS_Q15(MOTOROBS_RS * MOTOROBS_I_BASE / MOTOROBS_V_BASE)
+#define MOTOROBS_LS_PU                   MOTOROBS_Q15(MOTOROBS_LS * MOTOROBS_W_BASE * MOTOROBS_I_BASE / \
+                                                      MOTOROBS_V_BASE)
+#define MOTOROBS_WTS_PU                  MOTOROBS_Q15(MOTOROBS_W_BASE * MOTOROBS_TS)
+#define MOTOROBS_PSI_M_PU                (MOTOROBS_PSI_M * MOTOROBS_W_BASE / MOTOROBS_V_BASE)
+
+/*
+ * Leak of the flux integrator as a right shift, removes offset drift:
+ * corner frequency 1 / (2^shift * Ts) = 9.8 rad/s for shift 11
+ */
+#define MOTOROBS_FLUX_LEAK_SHIFT         11
+
+/* PLL: natural frequency and damping of the angle tracking loop */
+#define MOTOROBS_PLL_WN                  (2.0 * 3.14159265358979 * 100.0)
+#define MOTOROBS_PLL_ZETA                (1.0)
+#define MOTOROBS_PLL_KP                  MOTOROBS_Q15(2.0 * MOTOROBS_PLL_ZETA * MOTOROBS_PLL_WN / \
+                                                      (MOTOROBS_W_BASE * MOTOROBS_PSI_M_PU))
+#define MOTOROBS_PLL_KI                  MOTOROBS_Q15(MOTOROBS_PLL_WN * MOTOROBS_PLL_WN * MOTOROBS_TS / \
+                                                      (MOTOROBS_W_BASE * MOTOROBS_PSI_M_PU))
+
+/* Phase accumulator (2^32 per electrical turn) increment per period for a Q15 speed of 1 LSB */
+#define MOTOROBS_ANGLE_STEP              ((sint32)(MOTOROBS_W_BASE * MOTOROBS_TS / \
+                                                   (2.0 * 3.14159265358979) * 131072.0 + 0.5))
+
+/* 1 pu electrical speed in 0.1 rpm mechanical */
+#define MOTOROBS_SPEED_TO_RPM10          ((sint32)(MOTOROBS_W_BASE / (2.0 * 3.14159265358979) * 600.0 / \
+                                                   MOTOROBS_POLE_PAIRS + 0.5))
+
+/*
+ * Lock detection: the PLL error must stay below the threshold (Q15 of the
+ * nominal flux, ~3 electrical degrees) for this many periods
+ */
+#define MOTOROBS_LOCK_ERROR              MOTOROBS_Q15(0.05 * MOTOROBS_PSI_M_PU)
+#define MOTOROBS_LOCK_PERIODS            200u
+
+#endif /* MOTOROBS_CFG_H */
@@ -0,0 +1,374 @@
+/*
+ * SetpointGen.c - Setpoint Trajectory Generator Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the jerk-limited (S-curve) speed ramp.
+ *              A new target or new limits are planned once into up to
+ *              three constant-jerk segments (build up acceleration, hold
+ *              it, release it) starting from the current speed and
+ *              acceleration, so commands may arrive mid-ramp. The
+ *              periodic main function then only integrates the active
+ *              segment:
+ *
+ *              v(n+1) = v(n) + a(n) + j/2,   a(n+1) = a(n) + j
+ *
+ *              Speed is kept in raw units (0.1 rpm) and acceleration in
+ *              raw units per tick, both with SETPOINTGEN_FRAC_BITS
+ *              fractional bits. Each segment restarts from its planned
+ *              start state, so truncation does not accumulate.
+ */
+
+#include "SetpointGen.h"
+#include "SetpointGen_Cfg.h"
+#include "Det.h"
+
+/* Segments: acceleration build-up, constant acceleration, release, hold */
+#define SETPOINTGEN_MAX_SEGMENTS     4u
+
+#define SETPOINTGEN_ONE              ((sint64)1 << SETPOINTGEN_FRAC_BITS)
+
+typedef struct {
+    sint64 speed;       /* Start speed */
+    sint32 accel;       /* Start acceleration */
+    sint32 jerk;
+    uint32 ticks;       /* 0: hold until the next plan */
+} SetpointGen_SegmentType;
+
+/* Internal variables */
+static boolean SetpointGen_Initialized = FALSE;
+static sint64 SetpointGen_Speed;
+static sint32 SetpointGen_Accel;
+static sint32 SetpointGen_Jerk;
+static sint32 SetpointGen_HalfJerk;
+static uint32 SetpointGen_Remaining;
+static sint64 SetpointGen_Target;
+static sint16 SetpointGen_Torque;
+static uint16 SetpointGen_MaxSpeed;     /* raw, 0 = no limit */
+static sint16 SetpointGen_MaxTorque;    /* raw, 0 = no limit */
+static sint32 SetpointGen_AccelLimit;   /* per tick, 0 = no ramp */
+static sint32 SetpointGen_JerkLimit;    /* per tick^2 */
+static SetpointGen_SegmentType SetpointGen_Segments[SETPOINTGEN_MAX_SEGMENTS];
+static uint8 SetpointGen_SegmentCount;
+static uint8 SetpointGen_Segment;
+
+/* Forward declarations */
+static void SetpointGen_Plan(void);
+static void SetpointGen_LoadSegment(uint8 index);
+static uint32 SetpointGen_CeilDiv(sint64 num, sint32 den);
+static sint64 SetpointGen_Sqrt(uint64 value);
+
+/**
+ * @brief Initialize the setpoint generator (standstill, no limits)
+ */
+void SetpointGen_Init(void)
+{
+    SetpointGen_Speed = 0;
+    SetpointGen_Accel = 0;
+    SetpointGen_Jerk = 0;
+    SetpointGen_HalfJerk = 0;
+    SetpointGen_Remaining = 0u;
+    SetpointGen_Target = 0;
+    SetpointGen_Torque = 0;
+    SetpointGen_MaxSpeed = 0u;
+    SetpointGen_MaxTorque = 0;
+    SetpointGen_AccelLimit = 0;
+    SetpointGen_JerkLimit = 0;
+    SetpointGen_SegmentCount = 0u;
+    SetpointGen_Segment = 0u;
+    SetpointGen_Initialized = TRUE;
+}
+
+/**
+ * @brief Apply the limits of a MOTOR_CONFIG frame
+ * 
+ * A ramp in progress is re-planned with the new limits.
+ * 
+ * @param maxSpeed MAX_SPEED raw value (0.1 rpm), 0 = no limit
+ * @param maxTorque MAX_TORQUE raw value (0.1 %), 0 = no limit
+ * @param acceleration ACCELERATION raw value (0.1 rpm/s), 0 = no ramp
+ */
+void SetpointGen_SetLimits(uint16 maxSpeed, sint16 maxTorque, sint16 acceleration)
+{
+    if (SetpointGen_Initialized == FALSE)
+    {
+        Det_ReportError(SETPOINTGEN_MODULE_ID, 0, SETPOINTGEN_SET_LIMITS_SID, SETPOINTGEN_E_UNINIT);
+        return;
+    }
+
+    SetpointGen_MaxSpeed = maxSpeed;
+    SetpointGen_MaxTorque = maxTorque;
+    if (acceleration > 0)
+    {
+        SetpointGen_AccelLimit = (sint32)(((sint64)acceleration * SETPOINTGEN_ONE * SETPOINTGEN_TICK_MS) / 1000);
+        SetpointGen_JerkLimit = SetpointGen_AccelLimit / (sint32)(SETPOINTGEN_JERK_TIME_MS / SETPOINTGEN_TICK_MS);
+        if (SetpointGen_AccelLimit < 1)
+        {
+            SetpointGen_AccelLimit = 1;
+        }
+        if (SetpointGen_JerkLimit < 1)
+        {
+            SetpointGen_JerkLimit = 1;
+        }
+    }
+    else
+    {
+        SetpointGen_AccelLimit = 0;
+        SetpointGen_JerkLimit = 0;
+    }
+
+    /* A lowered limit applies at once */
+    if (SetpointGen_Accel > SetpointGen_AccelLimit)
+    {
+        SetpointGen_Accel = SetpointGen_AccelLimit;
+    }
+    else if (SetpointGen_Accel < -SetpointGen_AccelLimit)
+    {
+        SetpointGen_Accel = -SetpointGen_AccelLimit;
+    }
+
+    (void)SetpointGen_SetTarget((sint32)(SetpointGen_Target >> SETPOINTGEN_FRAC_BITS), SetpointGen_Torque);
+}
+
+/**
+ * @brief Apply the set points of a MOTOR_CMD frame
+ * @param speed TARGET_SPEED raw value (0.1 rpm)
+ * @param torque TARGET_TORQUE raw value (0.1 %)
+ * @return SETPOINTGEN_SPEED_LIMITED / SETPOINTGEN_TORQUE_LIMITED if a
+ *         set point was clipped to the configured maximum
+ */
+uint8 SetpointGen_SetTarget(sint32 speed, sint16 torque)
+{
+    uint8 limited = 0u;
+
+    if (SetpointGen_Initialized == FALSE)
+    {
+        Det_ReportError(SETPOINTGEN_MODULE_ID, 0, SETPOINTGEN_SET_TARGET_SID, SETPOINTGEN_E_UNINIT);
+        return 0u;
+    }
+
+    if (SetpointGen_MaxSpeed != 0u && (speed > SetpointGen_MaxSpeed || speed < -(sint32)SetpointGen_MaxSpeed))
+    {
+        speed = (speed > 0) ? (sint32)SetpointGen_MaxSpeed : -(sint32)SetpointGen_MaxSpeed;
+        limited |= SETPOINTGEN_SPEED_LIMITED;
+    }
+    if (SetpointGen_MaxTorque > 0 && (torque > SetpointGen_MaxTorque || torque < -SetpointGen_MaxTorque))
+    {
+        torque = (torque > 0) ? SetpointGen_MaxTorque : (sint16)(-SetpointGen_MaxTorque);
+        limited |= SETPOINTGEN_TORQUE_LIMITED;
+    }
+
+    SetpointGen_Target = (sint64)speed * SETPOINTGEN_ONE;
+    SetpointGen_Torque = torque;
+    SetpointGen_Plan();
+
+    return limited;
+}
+
+/**
+ * @brief Advance the trajectory by one tick (every SETPOINTGEN_TICK_MS)
+ */
+void SetpointGen_MainFunction(void)
+{
+    if (SetpointGen_Remaining > 0u)
+    {
+        SetpointGen_Speed += SetpointGen_Accel + SetpointGen_HalfJerk;
+        SetpointGen_Accel += SetpointGen_Jerk;
+        SetpointGen_Remaining--;
+        if (SetpointGen_Remaining == 0u)
+        {
+            SetpointGen_LoadSegment((uint8)(SetpointGen_Segment + 1u));
+        }
+    }
+}
+
+/**
+ * @brief Get the current speed set point
+ * @return Speed in raw units (0.1 rpm)
+ */
+sint32 SetpointGen_GetSpeed(void)
+{
+    return (sint32)((SetpointGen_Speed + (SETPOINTGEN_ONE / 2)) >> SETPOINTGEN_FRAC_BITS);
+}
+
+/**
+ * @brief Get the current acceleration (torque feed-forward)
+ * @return Acceleration in 0.1 rpm/s
+ */
+sint32 SetpointGen_GetAcceleration(void)
+{
+    return (sint32)(((sint64)SetpointGen_Accel * (1000 / SETPOINTGEN_TICK_MS)) >> SETPOINTGEN_FRAC_BITS);
+}
+
+/**
+ * @brief Get the current torque set point
+ * @return Torque in raw units (0.1 %), clipped to MAX_TORQUE
+ */
+sint16 SetpointGen_GetTorque(void)
+{
+    return SetpointGen_Torque;
+}
+
+/**
+ * @brief Check whether the speed set point has reached the target
+ */
+boolean SetpointGen_IsSettled(void)
+{
+    return (SetpointGen_Remaining == 0u) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Plan the segments from the current state to the target
+ * 
+ * The direction follows from the speed reached by releasing the current
+ * acceleration at full jerk. The problem is mirrored to a rising ramp,
+ * solved with the acceleration limit (trapezoid) or, if the speed change
+ * is too small for that, with the peak acceleration reachable within it
+ * (triangle), and mirrored back.
+ */
+static void SetpointGen_Plan(void)
+{
+    sint64 v0 = SetpointGen_Speed;
+    sint64 target = SetpointGen_Target;
+    sint32 a0 = SetpointGen_Accel;
+    sint32 jerk = SetpointGen_JerkLimit;
+    sint32 sign = 1;
+    sint32 peak = SetpointGen_AccelLimit;
+    sint32 j1, j3;
+    uint32 n1, n2, n3;
+    sint64 gain1, gain3, rest;
+    sint64 delta;
+    sint64 stop;
+    uint8 count = 0u;
+
+    if (SetpointGen_AccelLimit == 0)
+    {
+        /* No ramp configured: step */
+        SetpointGen_Speed = target;
+        SetpointGen_Accel = 0;
+        SetpointGen_Segments[0].speed = target;
+        SetpointGen_Segments[0].accel = 0;
+        SetpointGen_Segments[0].jerk = 0;
+        SetpointGen_Segments[0].ticks = 0u;
+        SetpointGen_SegmentCount = 1u;
+        SetpointGen_LoadSegment(0u);
+        return;
+    }
+
+    stop = v0 + ((sint64)a0 * ((a0 < 0) ? -a0 : a0)) / (2 * (sint64)jerk);
+    if (target < stop)
+    {
+        sign = -1;
+        v0 = -v0;
+        target = -target;
+        a0 = -a0;
+    }
+    delta = target - v0;
+
+    for (uint8 pass = 0u; pass < 2u; pass++)
+    {
+        n1 = (peak > a0) ? SetpointGen_CeilDiv((sint64)peak - a0, jerk) : 0u;
+        n3 = SetpointGen_CeilDiv(peak, jerk);
+        j1 = (n1 > 0u) ? (sint32)(((sint64)peak - a0) / (sint64)n1) : 0;
+        j3 = (n3 > 0u) ? -(sint32)(peak / (sint32)n3) : 0;
+        gain1 = (sint64)n1 * a0 + ((sint64)j1 * n1 * n1) / 2;
+        gain3 = (sint64)n3 * peak + ((sint64)j3 * n3 * n3) / 2;
+        rest = delta - gain1 - gain3;
+        if (rest >= 0 || pass == 1u)
+        {
+            break;
+        }
+
+        /* Triangle: peak^2 = (2 J delta + a0^2) / 2 */
+        peak = (sint32)SetpointGen_Sqrt((uint64)(2 * (sint64)jerk * delta + (sint64)a0 * a0) / 2u);
+        if (peak < a0)
+        {
+            peak = a0;
+        }
+    }
+    n2 = (rest > 0 && peak > 0) ? (uint32)(rest / peak) : 0u;
+
+    /* Segment start states, mirrored back; the hold starts exactly at the target */
+    if (n1 > 0u)
+    {
+        SetpointGen_Segments[count].speed = sign * v0;
+        SetpointGen_Segments[count].accel = sign * a0;
+        SetpointGen_Segments[count].jerk = sign * j1;
+        SetpointGen_Segments[count].ticks = n1;
+        count++;
+    }
+    if (n2 > 0u)
+    {
+        SetpointGen_Segments[count].speed = sign * (v0 + gain1);
+        SetpointGen_Segments[count].accel = sign * peak;
+        SetpointGen_Segments[count].jerk = 0;
+        SetpointGen_Segments[count].ticks = n2;
+        count++;
+    }
+    if (n3 > 0u)
+    {
+        SetpointGen_Segments[count].speed = sign * (v0 + gain1 + (sint64)n2 * peak);
+        SetpointGen_Segments[count].accel = sign * peak;
+        SetpointGen_Segments[count].jerk = sign * j3;
+        SetpointGen_Segments[count].ticks = n3;
+        count++;
+    }
+    SetpointGen_Segments[count].speed = sign * target;
+    SetpointGen_Segments[count].accel = 0;
+    SetpointGen_Segments[count].jerk = 0;
+    SetpointGen_Segments[count].ticks = 0u;
+    count++;
+
+    SetpointGen_SegmentCount = count;
+    SetpointGen_LoadSegment(0u);
+}
+
+static void SetpointGen_LoadSegment(uint8 index)
+{
+    const SetpointGen_SegmentType *seg;
+
+    if (index >= SetpointGen_SegmentCount)
+    {
+        SetpointGen_Remaining = 0u;
+        return;
+    }
+
+    seg = &SetpointGen_Segments[index];
+    SetpointGen_Segment = index;
+    SetpointGen_Speed = seg->speed;
+    SetpointGen_Accel = seg->accel;
+    SetpointGen_Jerk = seg->jerk;
+    SetpointGen_HalfJerk = seg->jerk / 2;
+    SetpointGen_Remaining = seg->ticks;
+}
+
+static uint32 SetpointGen_CeilDiv(sint64 num, sint32 den)
+{
+    return (num > 0) ? (uint32)((num + den - 1) / den) : 0u;
+}
+
+static sint64 SetpointGen_Sqrt(uint64 value)
+{
+    uint64 result = 0u;
+    uint64 bit = (uint64)1u << 62;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0u)
+    {
+        if (value >= result + bit)
+        {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (sint64)result;
+}
@@ -0,0 +1,32 @@
+/*
+ * SetpointGen.h - Setpoint Trajectory Generator Header
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface of the jerk-limited speed
+ *              setpoint generator fed by MOTOR_CMD and MOTOR_CONFIG.
+ *              Speeds, torques and accelerations use the raw scaling of
+ *              the MotorControl.dbc signals.
+ */
+
+#ifndef SETPOINTGEN_H
+#define SETPOINTGEN_H
+
+#include "Std_Types.h"
+
+/* Limit flags returned by SetpointGen_SetTarget */
+#define SETPOINTGEN_SPEED_LIMITED        (0x01u)
+#define SETPOINTGEN_TORQUE_LIMITED       (0x02u)
+
+/* Function Prototypes */
+void SetpointGen_Init(void);
+void SetpointGen_SetLimits(uint16 maxSpeed, sint16 maxTorque, sint16 acceleration);
+uint8 SetpointGen_SetTarget(sint32 speed, sint16 torque);
+void SetpointGen_MainFunction(void);
+sint32 SetpointGen_GetSpeed(void);
+sint32 SetpointGen_GetAcceleration(void);
+sint16 SetpointGen_GetTorque(void);
+boolean SetpointGen_IsSettled(void);
+
+#endif /* SETPOINTGEN_H */
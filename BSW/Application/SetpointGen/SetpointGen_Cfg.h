@@ -0,0 +1,43 @@
+/*
+ * SetpointGen_Cfg.h - Setpoint Trajectory Generator Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Configuration file for the S-curve setpoint generator
+ */
+
+#ifndef SETPOINTGEN_CFG_H
+#define SETPOINTGEN_CFG_H
+
+/* Module ID and Vendor ID */
+#define SETPOINTGEN_MODULE_ID          201
+#define SETPOINTGEN_VENDOR_ID          0xABCD
+
+/* Software Version Information */
+#define SETPOINTGEN_SW_MAJOR_VERSION   1
+#define SETPOINTGEN_SW_MINOR_VERSION   0
+#define SETPOINTGEN_SW_PATCH_VERSION   0
+
+/* API Service IDs */
+#define SETPOINTGEN_INIT_SID             0x01
+#define SETPOINTGEN_SET_LIMITS_SID       0x02
+#define SETPOINTGEN_SET_TARGET_SID       0x03
+#define SETPOINTGEN_MAIN_FUNCTION_SID    0x04
+
+/* Development Error Codes */
+#define SETPOINTGEN_E_UNINIT             0x10
+
+/* Period of SetpointGen_MainFunction */
+#define SETPOINTGEN_TICK_MS              1u
+
+/*
+ * Jerk limit, expressed as the time to build up the configured
+ * ACCELERATION from zero (MOTOR_CONFIG carries no jerk signal)
+ */
+#define SETPOINTGEN_JERK_TIME_MS         100u
+
+/* Fractional bits of the internal speed and acceleration */
+#define SETPOINTGEN_FRAC_BITS            20
+
+#endif /* SETPOINTGEN_CFG_H */
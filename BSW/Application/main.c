@@ -11,6 +11,17 @@
 #include "Det.h"
 #include "EcuM.h"
 #include "ComM.h"
+#include "BSWM.h"
+#include "CanSM.h"
+#include "CanTp.h"
+#include "E2E.h"
+#include "PduR.h"
+#include "SomeIp.h"
+#include "WdgM.h"
+#include "Tm.h"
+#include "SwTmr.h"
+#include "Idle.h"
+#include "Gpt.h"
 
 /**
  * @brief   Main function - AUTOSAR application entry point
@@ -23,20 +34,94 @@ int main(void)
     /* 2. Initialize ECU State Manager */
     EcuM_Init();
     
-    /* 3. Initialize Communication Manager */
+    /* 3. Initialize Software Timers, the Communication Manager, which
+     *    uses them for its release timeouts, the CAN State Manager, whose
+     *    start-up request for full communication ComM must already
+     *    accept, and the Mode Manager; mode requests are served by
+     *    BSWM_MainFunction, ComM_MainFunction and CanSM_MainFunction in
+     *    this order from the 1 ms tick. The transport layer segments and
+     *    reassembles on top of CanSM. The E2E protection of the motor
+     *    PDUs and the gateway start before the first frame;
+     *    PduR_MainFunction sends the rate-limited PDUs from the tick, and
+     *    SomeIp_MainFunction reads the motor service messages received
+     *    on the Ethernet channel. */
+    SwTmr_Init();
     ComM_Init();
+    CanSM_Init();
+    CanTp_Init();
+    BSWM_Init();
+    E2E_Init();
+    PduR_Init();
+    SomeIp_Init();
     
-    /* 4. Start the ECU */
+    /* 4. Initialize Time Service, Idle management and Watchdog Manager;
+     *    their main functions and SwTmr_MainFunction run from the 1 ms tick */
+    Tm_Init();
+    Idle_Init();
+    WdgM_Init();
+    
+    /* 5. Start the 1 ms system tick (GPT channel 0, Gpt_Notification_0) */
+    Gpt_Init(&Gpt_Configuration);
+    Gpt_StartTimer(GPT_CHANNEL_0, Gpt_Configuration.channels[GPT_CHANNEL_0].maxValue);
+    Gpt_EnableNotification(GPT_CHANNEL_0);
+    
+    /* 6. Start the ECU */
     EcuM_Startup();
     
-    /* 5. Main application loop */
+    /* 7. Main application loop */
     while(1)
     {
+        /* Main loop alive indication */
+        WdgM_CheckpointReached(WDGM_SE_BACKGROUND, WDGM_CP_BACKGROUND_LOOP);
+        
         /* Placeholder for periodic tasks */
-        /* - Watchdog refresh */
         /* - Communication handling */
         /* - Application logic */
+        
+        /* Sleep until the next heartbeat or event */
+        (void)Idle_Wait();
     }
     
     return 0;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief   System tick timer interrupt handler
+ * @details Called on each system tick (1 ms)
+ */
+void Gpt_Notification_0(void)
+{
+    CanSM_FdFrameType frame;
+    
+    Idle_IsrEnter();
+    
+    /* Account for timer wraps of the 64-bit time base */
+    Tm_MainFunction();
+    
+    /* Run expired software timers */
+    SwTmr_MainFunction();
+    
+    /* Serve mode requests: BswM coalesces them, ComM forwards the
+     * result, CanSM switches the bus */
+    BSWM_MainFunction();
+    ComM_MainFunction();
+    CanSM_MainFunction();
+    
+    /* Hand received frames to the transport layer, which ignores the
+     * identifiers it is not configured for, then send pending segments */
+    while (CanSM_ReceiveFdFrame(&frame) == E_OK)
+    {
+        CanTp_RxIndication(&frame);
+    }
+    CanTp_MainFunction();
+    
+    /* Rate-limited gateway transmissions and received service messages */
+    PduR_MainFunction();
+    SomeIp_MainFunction();
+    
+    /* Evaluate the supervised entities, trigger the watchdog if all are OK */
+    WdgM_MainFunction();
+    
+    /* Wake the background loop for its heartbeat, account the CPU load */
+    Idle_MainFunction();
+}
@@ -6,13 +6,79 @@
  *
  * Description: This file contains the implementation of
  *              ADC interface for Infineon TC377
+ *
+ *              Every channel passes through the filter stage configured in
+ *              AdcIf_Cfg.c. Filters use shifts only (no division in the
+ *              interrupt path) and process blocks of samples, so group 1
+ *              is oversampled and filtered once per block.
+ *
+ *              Filter outputs are written straight into a snapshot buffer
+ *              of the group, which becomes the newest one once complete;
+ *              readers use it in place instead of copying the results.
  */
 
 #include "AdcIf.h"
+#include "AdcIf_Cfg.h"
 #include "Det.h"
 
+/* Ordering between the snapshot values and the generations */
+#if defined(__GNUC__)
+#define ADCIF_LOAD_ACQUIRE(ptr)          __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define ADCIF_STORE_RELEASE(ptr, value)  __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#define ADCIF_FENCE_ACQUIRE()            __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define ADCIF_FENCE_RELEASE()            __atomic_thread_fence(__ATOMIC_RELEASE)
+#else
+#error "AdcIf requires atomic load and store support"
+#endif
+
+#define ADCIF_SNAPSHOT_INDEX             (ADCIF_SNAPSHOT_BUFFERS - 1u)
+
+/* Filter state of one channel */
+typedef struct {
+    uint8 type;                                         /* Configured type, NONE if invalid */
+    boolean primed;                                     /* State preset from the first sample */
+    uint32 integrator[ADCIF_FILTER_CIC_MAX_ORDER];      /* CIC integrators; [0]: MA sum, IIR state */
+    uint32 comb[ADCIF_FILTER_CIC_MAX_ORDER];            /* CIC comb delays */
+    AdcIf_ValueType history[1u << ADCIF_FILTER_MA_MAX_SHIFT];   /* MA window */
+    uint32 phase;                                       /* MA window position, CIC decimation phase */
+    uint32 warmup;                                      /* CIC outputs still to discard */
+    AdcIf_ValueType output;                             /* Latest filter output */
+} AdcIf_FilterStateType;
+
 /* Internal variables */
 static AdcIf_CallbackType AdcIf_Callbacks[4] = {NULL_PTR};
+static AdcIf_GroupNotificationType AdcIf_GroupNotifications[ADCIF_MAX_GROUPS] = {NULL_PTR};
+static uint32 AdcIf_ChainCounter = 0u;
+static AdcIf_FilterStateType AdcIf_FilterState[ADCIF_FILTER_CHANNELS];
+static AdcIf_SnapshotType AdcIf_Snapshots[ADCIF_MAX_GROUPS][ADCIF_SNAPSHOT_BUFFERS];
+static volatile uint32 AdcIf_Latest[ADCIF_MAX_GROUPS];     /* Newest generation, 0 if none */
+static volatile uint32 AdcIf_LatestBuffer[ADCIF_MAX_GROUPS];   /* Buffer holding it */
+static uint32 AdcIf_NextBuffer[ADCIF_MAX_GROUPS];          /* Buffer the writer fills next */
+static AdcIf_ValueType AdcIf_Group1Block[ADCIF_GROUP1_CHANNELS][ADCIF_GROUP1_OVERSAMPLING];
+static uint32 AdcIf_Group1BlockFill = 0u;
+
+/* Number of channels converted by each group */
+static const uint8 AdcIf_GroupChannels[ADCIF_MAX_GROUPS] = {
+    ADCIF_GROUP0_CHANNELS, ADCIF_GROUP1_CHANNELS
+};
+
+/* Forward declarations */
+static boolean AdcIf_FilterConfigValid(const AdcIf_FilterConfigType *config);
+static void AdcIf_FilterPrime(const AdcIf_FilterConfigType *config, AdcIf_FilterStateType *state,
+                              AdcIf_ValueType sample);
+static uint32 AdcIf_MovingAverage(const AdcIf_FilterConfigType *config, AdcIf_FilterStateType *state,
+                                  const AdcIf_ValueType *samples, uint32 count, AdcIf_ValueType *output);
+static uint32 AdcIf_Iir(const AdcIf_FilterConfigType *config, AdcIf_FilterStateType *state,
+                        const AdcIf_ValueType *samples, uint32 count, AdcIf_ValueType *output);
+static uint32 AdcIf_Cic(const AdcIf_FilterConfigType *config, AdcIf_FilterStateType *state,
+                        const AdcIf_ValueType *samples, uint32 count, AdcIf_ValueType *output);
+static AdcIf_SnapshotType *AdcIf_BeginSnapshot(uint8 group, uint32 *generation);
+static void AdcIf_PublishSnapshot(uint8 group, AdcIf_SnapshotType *snapshot, uint32 generation);
+
+/* ADC Hardware Abstraction (VADC request sources) */
+extern void AdcHw_EnableHwTrigger(uint8 group, boolean enable);
+extern void AdcHw_StartGroup(uint8 group);
+extern void AdcHw_ReadGroupResults(uint8 group, AdcIf_ValueType *buffer, uint8 count);
 
 /**
  * @brief Initialize ADC Interface
@@ -27,6 +93,37 @@ void AdcIf_Init(void)
     {
         AdcIf_Callbacks[i] = NULL_PTR;
     }
+    for (uint8 i = 0; i < ADCIF_MAX_GROUPS; i++)
+    {
+        AdcIf_GroupNotifications[i] = NULL_PTR;
+    }
+    AdcIf_ChainCounter = 0u;
+    AdcIf_Group1BlockFill = 0u;
+
+    /* No snapshot published yet */
+    for (uint8 i = 0; i < ADCIF_MAX_GROUPS; i++)
+    {
+        AdcIf_Latest[i] = 0u;
+        AdcIf_LatestBuffer[i] = 0u;
+        AdcIf_NextBuffer[i] = 0u;
+        for (uint8 j = 0; j < ADCIF_SNAPSHOT_BUFFERS; j++)
+        {
+            AdcIf_Snapshots[i][j].generation = 0u;
+        }
+    }
+
+    /* Reset the filters; an invalid configuration falls back to raw samples */
+    for (uint8 i = 0; i < ADCIF_FILTER_CHANNELS; i++)
+    {
+        AdcIf_FilterState[i].type = AdcIf_FilterConfig[i].type;
+        if (AdcIf_FilterConfigValid(&AdcIf_FilterConfig[i]) == FALSE)
+        {
+            Det_ReportError(ADCIF_MODULE_ID, 0, ADCIF_INIT_SID, ADCIF_E_PARAM_FILTER);
+            AdcIf_FilterState[i].type = ADCIF_FILTER_NONE;
+        }
+        AdcIf_FilterState[i].primed = FALSE;
+        AdcIf_FilterState[i].output = 0u;
+    }
 }
 
 /**
@@ -45,7 +142,7 @@ void AdcIf_StartConversion(uint8 channel)
     }
     else
     {
-        Det_ReportError(ADCIF_MODULE_ID, 0, ADCIF_START_CONVERSION_SID, DET_E_PARAM);
+        Det_ReportError(ADCIF_MODULE_ID, 0, ADCIF_START_CONVERSION_SID, ADCIF_E_PARAM_CHANNEL);
     }
 }
 
@@ -62,7 +159,7 @@ void AdcIf_RegisterCallback(uint8 channel, AdcIf_CallbackType callback)
     }
     else
     {
-        Det_ReportError(ADCIF_MODULE_ID, 0, ADCIF_REGISTER_CALLBACK_SID, DET_E_PARAM);
+        Det_ReportError(ADCIF_MODULE_ID, 0, ADCIF_REGISTER_CALLBACK_SID, ADCIF_E_PARAM_CHANNEL);
     }
 }
 
@@ -82,4 +179,526 @@ void AdcIf_Isr(uint8 channel, AdcIf_ValueType result)
         /* Call application layer callback */
         AdcIf_Callbacks[channel](result);
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Register conversion complete notification for an ADC group
+ * @param group ADC group number
+ * @param notification Notification function pointer
+ */
+void AdcIf_RegisterGroupNotification(uint8 group, AdcIf_GroupNotificationType notification)
+{
+    if (group < ADCIF_MAX_GROUPS)
+    {
+        AdcIf_GroupNotifications[group] = notification;
+    }
+    else
+    {
+        Det_ReportError(ADCIF_MODULE_ID, 0, ADCIF_REGISTER_GROUP_NOTIFICATION_SID, ADCIF_E_PARAM_GROUP);
+    }
+}
+
+/**
+ * @brief Route the PWM trigger to group 0
+ * 
+ * From the next PWM trigger on, group 0 is sampled at the center of every
+ * period and group 1 is chained after every ADCIF_GROUP1_CHAIN_DIVIDER-th
+ * group 0 conversion. No software start is needed.
+ */
+void AdcIf_EnableGroupTrigger(void)
+{
+    /* Chain group 1 after the first group 0 conversion, start a new block */
+    AdcIf_ChainCounter = 0u;
+    AdcIf_Group1BlockFill = 0u;
+    AdcHw_EnableHwTrigger(ADCIF_GROUP_0, TRUE);
+}
+
+/**
+ * @brief Stop PWM triggered conversions
+ */
+void AdcIf_DisableGroupTrigger(void)
+{
+    AdcHw_EnableHwTrigger(ADCIF_GROUP_0, FALSE);
+}
+
+/**
+ * @brief Read the filtered results of a group
+ * 
+ * Group 0 results are updated by every conversion, group 1 results once
+ * per block of ADCIF_GROUP1_OVERSAMPLING conversions. Copies the newest
+ * snapshot, again if it was rewritten meanwhile; all zero before the
+ * first one.
+ * 
+ * @param group ADC group number
+ * @param buffer Destination for one result per group channel
+ * @return E_OK if the results were copied
+ */
+Std_ReturnType AdcIf_ReadGroup(uint8 group, AdcIf_ValueType *buffer)
+{
+    const AdcIf_SnapshotType *snapshot;
+    uint32 generation;
+
+    if (group >= ADCIF_MAX_GROUPS)
+    {
+        Det_ReportError(ADCIF_MODULE_ID, 0, ADCIF_READ_GROUP_SID, ADCIF_E_PARAM_GROUP);
+        return E_NOT_OK;
+    }
+    if (buffer == NULL_PTR)
+    {
+        Det_ReportError(ADCIF_MODULE_ID, 0, ADCIF_READ_GROUP_SID, ADCIF_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+
+    do
+    {
+        snapshot = AdcIf_GetSnapshot(group, &generation);
+        for (uint8 i = 0; i < AdcIf_GroupChannels[group]; i++)
+        {
+            buffer[i] = (snapshot != NULL_PTR) ? snapshot->values[i] : 0u;
+        }
+    } while (snapshot != NULL_PTR && AdcIf_SnapshotValid(snapshot, generation) == FALSE);
+    return E_OK;
+}
+
+/**
+ * @brief Newest published results of a group, read in place
+ * 
+ * Retries only if the writer published between the loads of the
+ * generation and its buffer, or rewrote that buffer in the meantime.
+ * 
+ * @param group ADC group number
+ * @param generation Generation of the snapshot
+ * @return Snapshot, NULL_PTR before the first publication
+ */
+const AdcIf_SnapshotType *AdcIf_GetSnapshot(uint8 group, uint32 *generation)
+{
+    const AdcIf_SnapshotType *snapshot;
+    uint32 latest;
+
+    if (group >= ADCIF_MAX_GROUPS)
+    {
+        Det_ReportError(ADCIF_MODULE_ID, 0, ADCIF_GET_SNAPSHOT_SID, ADCIF_E_PARAM_GROUP);
+        return NULL_PTR;
+    }
+    if (generation == NULL_PTR)
+    {
+        Det_ReportError(ADCIF_MODULE_ID, 0, ADCIF_GET_SNAPSHOT_SID, ADCIF_E_PARAM_POINTER);
+        return NULL_PTR;
+    }
+
+    for (;;)
+    {
+        latest = ADCIF_LOAD_ACQUIRE(&AdcIf_Latest[group]);
+        if (latest == 0u)
+        {
+            *generation = 0u;
+            return NULL_PTR;
+        }
+        snapshot = &AdcIf_Snapshots[group][ADCIF_LOAD_ACQUIRE(&AdcIf_LatestBuffer[group])];
+        if (ADCIF_LOAD_ACQUIRE(&snapshot->generation) == latest)
+        {
+            *generation = latest;
+            return snapshot;
+        }
+    }
+}
+
+/**
+ * @brief Check that a snapshot still holds the values of a generation
+ * 
+ * Called after the values were used: they were consistent if the buffer
+ * still carries the generation it was fetched with.
+ * 
+ * @param snapshot Snapshot from AdcIf_GetSnapshot
+ * @param generation Generation returned with it
+ * @return TRUE if the values used were not rewritten
+ */
+boolean AdcIf_SnapshotValid(const AdcIf_SnapshotType *snapshot, uint32 generation)
+{
+    if (snapshot == NULL_PTR || generation == 0u)
+    {
+        return FALSE;
+    }
+    ADCIF_FENCE_ACQUIRE();
+    return (snapshot->generation == generation) ? TRUE : FALSE;
+}
+
+/**
+ * @brief ADC Group Conversion Complete Interrupt Service Routine
+ * 
+ * This function should be called from the end-of-conversion ISR of the
+ * request source that converted the group. Group 1 is started here,
+ * before the group 0 notification runs, so that its conversion overlaps
+ * with the control step instead of delaying the next current sample.
+ * Group 1 conversions are only collected; the block is filtered and
+ * notified when it is complete. The snapshot is published before the
+ * notification.
+ * 
+ * @param group ADC group number
+ */
+void AdcIf_GroupConversionComplete(uint8 group)
+{
+    AdcIf_ValueType raw[ADCIF_FILTER_CHANNELS];
+    AdcIf_SnapshotType *snapshot;
+    uint32 generation;
+
+    if (group >= ADCIF_MAX_GROUPS)
+    {
+        return;
+    }
+
+    if (group == ADCIF_GROUP_0)
+    {
+        AdcHw_ReadGroupResults(ADCIF_GROUP_0, raw, ADCIF_GROUP0_CHANNELS);
+        snapshot = AdcIf_BeginSnapshot(ADCIF_GROUP_0, &generation);
+        for (uint8 i = 0; i < ADCIF_GROUP0_CHANNELS; i++)
+        {
+            if (AdcIf_FilterState[ADCIF_FILTER_PHASE_U + i].type == ADCIF_FILTER_NONE)
+            {
+                snapshot->values[i] = raw[i];
+            }
+            else
+            {
+                (void)AdcIf_FilterBlock(ADCIF_FILTER_PHASE_U + i, &raw[i], 1u, NULL_PTR);
+                snapshot->values[i] = AdcIf_FilterState[ADCIF_FILTER_PHASE_U + i].output;
+            }
+        }
+        AdcIf_PublishSnapshot(ADCIF_GROUP_0, snapshot, generation);
+
+        if (AdcIf_ChainCounter == 0u)
+        {
+            AdcHw_StartGroup(ADCIF_GROUP_1);
+        }
+        AdcIf_ChainCounter++;
+        if (AdcIf_ChainCounter >= ADCIF_GROUP1_CHAIN_DIVIDER)
+        {
+            AdcIf_ChainCounter = 0u;
+        }
+    }
+    else
+    {
+        AdcHw_ReadGroupResults(ADCIF_GROUP_1, raw, ADCIF_GROUP1_CHANNELS);
+        for (uint8 i = 0; i < ADCIF_GROUP1_CHANNELS; i++)
+        {
+            AdcIf_Group1Block[i][AdcIf_Group1BlockFill] = raw[i];
+        }
+        AdcIf_Group1BlockFill++;
+        if (AdcIf_Group1BlockFill < ADCIF_GROUP1_OVERSAMPLING)
+        {
+            return;
+        }
+        AdcIf_Group1BlockFill = 0u;
+        snapshot = AdcIf_BeginSnapshot(ADCIF_GROUP_1, &generation);
+        for (uint8 i = 0; i < ADCIF_GROUP1_CHANNELS; i++)
+        {
+            (void)AdcIf_FilterBlock(ADCIF_FILTER_DC_LINK + i, AdcIf_Group1Block[i],
+                                    ADCIF_GROUP1_OVERSAMPLING, NULL_PTR);
+            snapshot->values[i] = AdcIf_FilterState[ADCIF_FILTER_DC_LINK + i].output;
+        }
+        AdcIf_PublishSnapshot(ADCIF_GROUP_1, snapshot, generation);
+    }
+
+    if (AdcIf_GroupNotifications[group] != NULL_PTR)
+    {
+        AdcIf_GroupNotifications[group]();
+    }
+}
+
+/**
+ * @brief Run a block of samples through the filter of a channel
+ * 
+ * The first sample after AdcIf_Init presets the filter state as if the
+ * input had been constant, so no start-up transient from zero reaches the
+ * threshold checks. The CIC stage produces one output per 2^shift samples,
+ * the other stages one output per sample.
+ * 
+ * @param filter Filter channel (ADCIF_FILTER_<channel>)
+ * @param samples Input samples, oldest first
+ * @param count Number of input samples
+ * @param output Destination for the outputs, or NULL_PTR to keep the latest only
+ * @return Number of outputs produced
+ */
+uint32 AdcIf_FilterBlock(uint8 filter, const AdcIf_ValueType *samples, uint32 count,
+                         AdcIf_ValueType *output)
+{
+    const AdcIf_FilterConfigType *config;
+    AdcIf_FilterStateType *state;
+
+    if (filter >= ADCIF_FILTER_CHANNELS)
+    {
+        Det_ReportError(ADCIF_MODULE_ID, 0, ADCIF_FILTER_BLOCK_SID, ADCIF_E_PARAM_FILTER);
+        return 0u;
+    }
+    if (samples == NULL_PTR)
+    {
+        Det_ReportError(ADCIF_MODULE_ID, 0, ADCIF_FILTER_BLOCK_SID, ADCIF_E_PARAM_POINTER);
+        return 0u;
+    }
+    if (count == 0u)
+    {
+        return 0u;
+    }
+
+    config = &AdcIf_FilterConfig[filter];
+    state = &AdcIf_FilterState[filter];
+    if (state->primed == FALSE)
+    {
+        AdcIf_FilterPrime(config, state, samples[0]);
+    }
+
+    switch (state->type)
+    {
+        case ADCIF_FILTER_MOVING_AVERAGE:
+            return AdcIf_MovingAverage(config, state, samples, count, output);
+
+        case ADCIF_FILTER_IIR:
+            return AdcIf_Iir(config, state, samples, count, output);
+
+        case ADCIF_FILTER_CIC:
+            return AdcIf_Cic(config, state, samples, count, output);
+
+        default:
+            if (output != NULL_PTR)
+            {
+                for (uint32 i = 0; i < count; i++)
+                {
+                    output[i] = samples[i];
+                }
+            }
+            state->output = samples[count - 1u];
+            return count;
+    }
+}
+
+/**
+ * @brief Take the buffer after the newest snapshot of a group for writing
+ * 
+ * The buffers are used in turn, independent of the generation, which skips
+ * 0 when it wraps. The buffer is marked as being rewritten before any
+ * value changes, so a reader still using it fails AdcIf_SnapshotValid.
+ * 
+ * @param group ADC group number
+ * @param generation Generation the buffer gets when published
+ * @return Buffer to fill
+ */
+static AdcIf_SnapshotType *AdcIf_BeginSnapshot(uint8 group, uint32 *generation)
+{
+    AdcIf_SnapshotType *snapshot;
+    uint32 next = AdcIf_Latest[group] + 1u;
+
+    if (next == 0u)
+    {
+        next = 1u;
+    }
+    snapshot = &AdcIf_Snapshots[group][AdcIf_NextBuffer[group]];
+    snapshot->generation = 0u;
+    ADCIF_FENCE_RELEASE();
+
+    *generation = next;
+    return snapshot;
+}
+
+/**
+ * @brief Make a filled snapshot buffer the newest one of its group
+ * @param group ADC group number
+ * @param snapshot Buffer from AdcIf_BeginSnapshot
+ * @param generation Generation from AdcIf_BeginSnapshot
+ */
+static void AdcIf_PublishSnapshot(uint8 group, AdcIf_SnapshotType *snapshot, uint32 generation)
+{
+    ADCIF_STORE_RELEASE(&snapshot->generation, generation);
+    ADCIF_STORE_RELEASE(&AdcIf_LatestBuffer[group], AdcIf_NextBuffer[group]);
+    ADCIF_STORE_RELEASE(&AdcIf_Latest[group], generation);
+    AdcIf_NextBuffer[group] = (AdcIf_NextBuffer[group] + 1u) & ADCIF_SNAPSHOT_INDEX;
+}
+
+/**
+ * @brief Check a filter configuration against the limits of AdcIf_Cfg.h
+ * @param config Filter configuration
+ * @return TRUE if the filter can run with this configuration
+ */
+static boolean AdcIf_FilterConfigValid(const AdcIf_FilterConfigType *config)
+{
+    switch (config->type)
+    {
+        case ADCIF_FILTER_NONE:
+            return TRUE;
+
+        case ADCIF_FILTER_MOVING_AVERAGE:
+            return (config->shift <= ADCIF_FILTER_MA_MAX_SHIFT) ? TRUE : FALSE;
+
+        case ADCIF_FILTER_IIR:
+            return (config->shift > 0u && config->shift <= ADCIF_FILTER_IIR_FRAC_BITS) ? TRUE : FALSE;
+
+        case ADCIF_FILTER_CIC:
+            return (config->order > 0u && config->order <= ADCIF_FILTER_CIC_MAX_ORDER &&
+                    config->shift > 0u &&
+                    (uint32)config->order * config->shift <= ADCIF_FILTER_CIC_MAX_GROWTH) ? TRUE : FALSE;
+
+        default:
+            return FALSE;
+    }
+}
+
+/**
+ * @brief Preset a filter to the steady state of a constant input
+ * @param config Filter configuration
+ * @param state Filter state
+ * @param sample First input sample
+ */
+static void AdcIf_FilterPrime(const AdcIf_FilterConfigType *config, AdcIf_FilterStateType *state,
+                              AdcIf_ValueType sample)
+{
+    for (uint32 i = 0; i < ADCIF_FILTER_CIC_MAX_ORDER; i++)
+    {
+        state->integrator[i] = 0u;
+        state->comb[i] = 0u;
+    }
+    state->phase = 0u;
+    state->warmup = 0u;
+
+    switch (state->type)
+    {
+        case ADCIF_FILTER_MOVING_AVERAGE:
+            for (uint32 i = 0; i < (1u << config->shift); i++)
+            {
+                state->history[i] = sample;
+            }
+            state->integrator[0] = (uint32)sample << config->shift;
+            break;
+
+        case ADCIF_FILTER_IIR:
+            state->integrator[0] = (uint32)sample << ADCIF_FILTER_IIR_FRAC_BITS;
+            break;
+
+        case ADCIF_FILTER_CIC:
+            /* The first order - 1 outputs still see the zero start state; hold the sample */
+            state->warmup = config->order - 1u;
+            break;
+
+        default:
+            break;
+    }
+
+    state->output = sample;
+    state->primed = TRUE;
+}
+
+/**
+ * @brief Moving average over 2^shift samples with a running sum
+ */
+static uint32 AdcIf_MovingAverage(const AdcIf_FilterConfigType *config, AdcIf_FilterStateType *state,
+                                  const AdcIf_ValueType *samples, uint32 count, AdcIf_ValueType *output)
+{
+    uint32 sum = state->integrator[0];
+    uint32 pos = state->phase;
+    uint32 mask = (1u << config->shift) - 1u;
+    uint32 shift = config->shift;
+    AdcIf_ValueType y = state->output;
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        sum += (uint32)samples[i] - state->history[pos];
+        state->history[pos] = samples[i];
+        pos = (pos + 1u) & mask;
+        y = (AdcIf_ValueType)(sum >> shift);
+        if (output != NULL_PTR)
+        {
+            output[i] = y;
+        }
+    }
+
+    state->integrator[0] = sum;
+    state->phase = pos;
+    state->output = y;
+    return count;
+}
+
+/**
+ * @brief First-order low pass y += (x - y) / 2^shift
+ * 
+ * The state keeps ADCIF_FILTER_IIR_FRAC_BITS fraction bits, so small
+ * input changes are not lost in the truncation of the shift.
+ */
+static uint32 AdcIf_Iir(const AdcIf_FilterConfigType *config, AdcIf_FilterStateType *state,
+                        const AdcIf_ValueType *samples, uint32 count, AdcIf_ValueType *output)
+{
+    sint32 acc = (sint32)state->integrator[0];
+    uint32 shift = config->shift;
+    AdcIf_ValueType y = state->output;
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        acc += (((sint32)samples[i] << ADCIF_FILTER_IIR_FRAC_BITS) - acc) >> shift;
+        y = (AdcIf_ValueType)((acc + (1 << (ADCIF_FILTER_IIR_FRAC_BITS - 1u))) >> ADCIF_FILTER_IIR_FRAC_BITS);
+        if (output != NULL_PTR)
+        {
+            output[i] = y;
+        }
+    }
+
+    state->integrator[0] = (uint32)acc;
+    state->output = y;
+    return count;
+}
+
+/**
+ * @brief CIC decimator: order integrators at the input rate, order combs
+ *        at the output rate, decimation and gain compensation by shifts
+ * 
+ * The registers wrap modulo 2^32; the output stays exact as long as the
+ * growth order * shift plus the sample width fits in 32 bits.
+ */
+static uint32 AdcIf_Cic(const AdcIf_FilterConfigType *config, AdcIf_FilterStateType *state,
+                        const AdcIf_ValueType *samples, uint32 count, AdcIf_ValueType *output)
+{
+    uint32 order = config->order;
+    uint32 mask = (1u << config->shift) - 1u;
+    uint32 gainShift = order * config->shift;
+    uint32 phase = state->phase;
+    uint32 produced = 0u;
+    uint32 i0 = state->integrator[0];
+    uint32 i1 = state->integrator[1];
+    uint32 i2 = state->integrator[2];
+    uint32 acc;
+    uint32 delayed;
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        /* Integrators of the unused stages run along but are never read */
+        i0 += samples[i];
+        i1 += i0;
+        i2 += i1;
+
+        phase = (phase + 1u) & mask;
+        if (phase == 0u)
+        {
+            acc = (order == 1u) ? i0 : ((order == 2u) ? i1 : i2);
+            for (uint32 k = 0; k < order; k++)
+            {
+                delayed = state->comb[k];
+                state->comb[k] = acc;
+                acc -= delayed;
+            }
+            if (state->warmup > 0u)
+            {
+                state->warmup--;
+            }
+            else
+            {
+                state->output = (AdcIf_ValueType)(acc >> gainShift);
+            }
+            if (output != NULL_PTR)
+            {
+                output[produced] = state->output;
+            }
+            produced++;
+        }
+    }
+
+    state->integrator[0] = i0;
+    state->integrator[1] = i1;
+    state->integrator[2] = i2;
+    state->phase = phase;
+    return produced;
+}
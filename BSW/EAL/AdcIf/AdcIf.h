@@ -12,6 +12,7 @@
 #define ADCIF_H
 
 #include "Std_Types.h"
+#include "AdcIf_Cfg.h"
 
 /* ADC Channel IDs */
 #define ADCIF_CHANNEL_0  0
@@ -19,15 +20,58 @@
 #define ADCIF_CHANNEL_2  2
 #define ADCIF_CHANNEL_3  3
 
+/* ADC Group IDs */
+#define ADCIF_GROUP_0    0  /* Phase currents, triggered by the PWM carrier */
+#define ADCIF_GROUP_1    1  /* DC link voltage and temperatures, chained after group 0 */
+
 /* ADC Result Type */
 typedef uint16 AdcIf_ValueType;
 
+/*
+ * Filtered results of one publication of a group: every conversion of
+ * group 0, every block of group 1. The generation counts the publications
+ * of the group from 1 (wrapping to 1 after 0xFFFFFFFF) and is 0 while the
+ * buffer is being rewritten; consecutive generations tell the reader
+ * whether it missed publications or saw the same one twice.
+ */
+typedef struct {
+    volatile uint32 generation;
+    AdcIf_ValueType values[ADCIF_SNAPSHOT_CHANNELS];   /* One per group channel */
+} AdcIf_SnapshotType;
+
 /* ADC Callback Function Pointer */
 typedef void (*AdcIf_CallbackType)(AdcIf_ValueType result);
 
+/* ADC Group Conversion Complete Notification */
+typedef void (*AdcIf_GroupNotificationType)(void);
+
 /* Function Prototypes */
 void AdcIf_Init(void);
 void AdcIf_StartConversion(uint8 channel);
 void AdcIf_RegisterCallback(uint8 channel, AdcIf_CallbackType callback);
+void AdcIf_RegisterGroupNotification(uint8 group, AdcIf_GroupNotificationType notification);
+void AdcIf_EnableGroupTrigger(void);
+void AdcIf_DisableGroupTrigger(void);
+Std_ReturnType AdcIf_ReadGroup(uint8 group, AdcIf_ValueType *buffer);
+
+/**
+ * @brief   Newest published results of a group, read in place
+ * @details All values of the snapshot come from the same publication.
+ *          Readers that can be preempted by ADCIF_SNAPSHOT_BUFFERS - 1
+ *          publications must confirm the values they used with
+ *          AdcIf_SnapshotValid and fetch the snapshot again if it failed;
+ *          the group notification and code of the same or higher priority
+ *          need not.
+ * @param   generation  Generation of the snapshot
+ * @return  NULL_PTR before the first publication or for an invalid group
+ */
+const AdcIf_SnapshotType *AdcIf_GetSnapshot(uint8 group, uint32 *generation);
+
+/* TRUE if the snapshot has not been rewritten since it had this generation */
+boolean AdcIf_SnapshotValid(const AdcIf_SnapshotType *snapshot, uint32 generation);
+
+void AdcIf_GroupConversionComplete(uint8 group);
+uint32 AdcIf_FilterBlock(uint8 filter, const AdcIf_ValueType *samples, uint32 count,
+                         AdcIf_ValueType *output);
 
 #endif /* ADCIF_H */
\ No newline at end of file
@@ -0,0 +1,24 @@
+/*
+ * AdcIf_Cfg.c - AUTOSAR ADC Interface Configuration Data
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the filter stage of every ADC channel
+ */
+
+#include "AdcIf_Cfg.h"
+
+/* Filter configurations, indexed by ADCIF_FILTER_<channel> */
+const AdcIf_FilterConfigType AdcIf_FilterConfig[ADCIF_FILTER_CHANNELS] = {
+    /* Phase currents: sampled once per PWM period for the control step, unfiltered */
+    {ADCIF_FILTER_NONE, 0u, 0u},
+    {ADCIF_FILTER_NONE, 0u, 0u},
+    {ADCIF_FILTER_NONE, 0u, 0u},
+    /* DC link voltage: 2nd order CIC, decimates each block of 8 to one result */
+    {ADCIF_FILTER_CIC, 3u, 2u},
+    /* Temperatures: first-order low pass, time constant 16 samples (20 ms) */
+    {ADCIF_FILTER_IIR, 4u, 0u},
+    {ADCIF_FILTER_IIR, 4u, 0u},
+    {ADCIF_FILTER_IIR, 4u, 0u}
+};
@@ -10,6 +10,8 @@
 #ifndef ADCIF_CFG_H
 #define ADCIF_CFG_H
 
+#include "Std_Types.h"
+
 /* Module ID and Vendor ID */
 #define ADCIF_MODULE_ID          120
 #define ADCIF_VENDOR_ID          0xABCD
@@ -23,9 +25,16 @@
 #define ADCIF_INIT_SID                   0x01
 #define ADCIF_START_CONVERSION_SID        0x02
 #define ADCIF_REGISTER_CALLBACK_SID       0x03
+#define ADCIF_REGISTER_GROUP_NOTIFICATION_SID 0x04
+#define ADCIF_ENABLE_GROUP_TRIGGER_SID    0x05
+#define ADCIF_READ_GROUP_SID              0x06
+#define ADCIF_FILTER_BLOCK_SID            0x07
+#define ADCIF_GET_SNAPSHOT_SID            0x08
 
 /* Error Codes */
 #define ADCIF_E_PARAM_CHANNEL            0x01
+#define ADCIF_E_PARAM_GROUP              0x02
+#define ADCIF_E_PARAM_FILTER             0x03
 
 /* Development Error Codes */
 #define ADCIF_E_UNINIT                   0x10
@@ -34,4 +43,61 @@
 /* Maximum number of ADC channels */
 #define ADCIF_MAX_CHANNELS               4
 
-#endif /* ADCIF_CFG_H */
\ No newline at end of file
+/* Conversion groups */
+#define ADCIF_MAX_GROUPS                 2
+#define ADCIF_GROUP0_CHANNELS            3u  /* U, V, W phase currents */
+#define ADCIF_GROUP1_CHANNELS            4u  /* DC link voltage and temperatures */
+
+/*
+ * Group 0 is started by the PWM trigger (center of every period); group 1
+ * is chained after every Nth group 0 conversion and oversampled: blocks of
+ * ADCIF_GROUP1_OVERSAMPLING conversions at 20 kHz / 25 = 800 Hz are
+ * filtered together and decimated to one result per block (100 Hz)
+ */
+#define ADCIF_GROUP1_CHAIN_DIVIDER       25u
+#define ADCIF_GROUP1_OVERSAMPLING        8u
+
+/*
+ * Results of each group are published into a ring of snapshot buffers
+ * (power of two), read in place: a reader of the newest snapshot is only
+ * overwritten after ADCIF_SNAPSHOT_BUFFERS - 1 further publications, i.e.
+ * 150 us for group 0 and 30 ms for group 1
+ */
+#define ADCIF_SNAPSHOT_BUFFERS           4u
+#define ADCIF_SNAPSHOT_CHANNELS          4u  /* Channels of the largest group */
+
+/* Filter types */
+#define ADCIF_FILTER_NONE                0u  /* Raw sample */
+#define ADCIF_FILTER_MOVING_AVERAGE      1u  /* Mean of the last 2^shift samples */
+#define ADCIF_FILTER_IIR                 2u  /* y += (x - y) / 2^shift */
+#define ADCIF_FILTER_CIC                 3u  /* order-stage CIC, decimation by 2^shift */
+
+/* Filter limits: window of the moving average, CIC stages and register growth */
+#define ADCIF_FILTER_MA_MAX_SHIFT        5u
+#define ADCIF_FILTER_CIC_MAX_ORDER       3u   /* AdcIf.c runs three integrators */
+#define ADCIF_FILTER_CIC_MAX_GROWTH      16u  /* order * shift, bits */
+
+/* Fraction bits kept by the IIR state below the sample LSB */
+#define ADCIF_FILTER_IIR_FRAC_BITS       12u
+
+/* Filter channels: group 0 channels followed by group 1 channels */
+#define ADCIF_FILTER_PHASE_U             0u
+#define ADCIF_FILTER_PHASE_V             1u
+#define ADCIF_FILTER_PHASE_W             2u
+#define ADCIF_FILTER_DC_LINK             3u
+#define ADCIF_FILTER_TEMPERATURE_1       4u
+#define ADCIF_FILTER_TEMPERATURE_2       5u
+#define ADCIF_FILTER_TEMPERATURE_3       6u
+#define ADCIF_FILTER_CHANNELS            (ADCIF_GROUP0_CHANNELS + ADCIF_GROUP1_CHANNELS)
+
+/* Filter stage of one channel */
+typedef struct {
+    uint8 type;         /* ADCIF_FILTER_* */
+    uint8 shift;        /* Window, coefficient or decimation as a power of two */
+    uint8 order;        /* CIC stages, 1..ADCIF_FILTER_CIC_MAX_ORDER */
+} AdcIf_FilterConfigType;
+
+/* Filter configuration per channel (AdcIf_Cfg.c) */
+extern const AdcIf_FilterConfigType AdcIf_FilterConfig[ADCIF_FILTER_CHANNELS];
+
+#endif /* ADCIF_CFG_H */
@@ -0,0 +1,137 @@
+/*
+ * PwmIf.c - AUTOSAR PWM Interface Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the implementation of
+ *              the motor phase PWM interface for Infineon TC377
+ */
+
+#include "PwmIf.h"
+#include "PwmIf_Cfg.h"
+#include "Det.h"
+
+/* Internal variables */
+static boolean PwmIf_Initialized = FALSE;
+
+/* Hardware channel of each phase */
+static const uint8 PwmIf_HwChannel[PWMIF_MAX_CHANNELS] = {
+    PWMIF_HW_CHANNEL_U, PWMIF_HW_CHANNEL_V, PWMIF_HW_CHANNEL_W
+};
+
+/* PWM Hardware Abstraction (GTM ATOM shadow registers) */
+extern void PwmHw_WriteShadowCompare(uint8 channel, uint32 compare);
+extern void PwmHw_SetShadowTransfer(uint32 channelMask, boolean enable);
+extern void PwmHw_ForceShadowTransfer(uint32 channelMask);
+extern void PwmHw_SetTriggerCompare(uint32 compare);
+
+/* Convert a duty cycle into a compare value for the configured period, rounded
+ * to nearest so that 0xFFFF reaches the full period */
+#define PWMIF_DUTY_TO_COMPARE(duty)  ((((uint32)(duty) * PWMIF_PERIOD_TICKS) + 0x7FFFu) / 0xFFFFu)
+
+/**
+ * @brief Initialize PWM Interface
+ */
+void PwmIf_Init(void)
+{
+    /* Start with all phases at 0 % duty */
+    PwmHw_SetShadowTransfer(PWMIF_PHASE_MASK, FALSE);
+    for (uint8 i = 0; i < PWMIF_MAX_CHANNELS; i++)
+    {
+        PwmHw_WriteShadowCompare(PwmIf_HwChannel[i], 0u);
+    }
+    PwmHw_ForceShadowTransfer(PWMIF_PHASE_MASK);
+
+    /* ADC trigger output, routed to the group 0 request source */
+    PwmHw_SetTriggerCompare(PWMIF_ADC_TRIGGER_TICKS);
+
+    PwmIf_Initialized = TRUE;
+}
+
+/**
+ * @brief De-initialize PWM Interface
+ */
+void PwmIf_DeInit(void)
+{
+    if (PwmIf_Initialized == TRUE)
+    {
+        PwmIf_StopPhases();
+        PwmIf_Initialized = FALSE;
+    }
+}
+
+/**
+ * @brief Set the duty cycle of a single phase
+ * 
+ * The new value takes effect at the next period boundary. Updating the
+ * three phases with three calls can straddle a boundary; use
+ * PwmIf_SetPhaseDutyCycles for a consistent update.
+ * 
+ * @param channel PWM channel number
+ * @param duty Duty cycle
+ */
+void PwmIf_SetDutyCycle(uint8 channel, PwmIf_DutyType duty)
+{
+    if (PwmIf_Initialized == FALSE)
+    {
+        Det_ReportError(PWMIF_MODULE_ID, 0, PWMIF_SET_DUTY_CYCLE_SID, PWMIF_E_UNINIT);
+    }
+    else if (channel < PWMIF_MAX_CHANNELS)
+    {
+        PwmHw_SetShadowTransfer(1u << PwmIf_HwChannel[channel], FALSE);
+        PwmHw_WriteShadowCompare(PwmIf_HwChannel[channel], PWMIF_DUTY_TO_COMPARE(duty));
+        PwmHw_SetShadowTransfer(1u << PwmIf_HwChannel[channel], TRUE);
+    }
+    else
+    {
+        Det_ReportError(PWMIF_MODULE_ID, 0, PWMIF_SET_DUTY_CYCLE_SID, PWMIF_E_PARAM_CHANNEL);
+    }
+}
+
+/**
+ * @brief Set the duty cycles of all three phases atomically
+ * 
+ * Shadow transfer is held off while the three shadow registers are
+ * written and then enabled for all phases with one access, so the
+ * hardware latches all three values at the same period boundary.
+ * 
+ * @param dutyU Duty cycle of phase U
+ * @param dutyV Duty cycle of phase V
+ * @param dutyW Duty cycle of phase W
+ */
+void PwmIf_SetPhaseDutyCycles(PwmIf_DutyType dutyU, PwmIf_DutyType dutyV, PwmIf_DutyType dutyW)
+{
+    if (PwmIf_Initialized == FALSE)
+    {
+        Det_ReportError(PWMIF_MODULE_ID, 0, PWMIF_SET_PHASE_DUTY_CYCLES_SID, PWMIF_E_UNINIT);
+        return;
+    }
+
+    PwmHw_SetShadowTransfer(PWMIF_PHASE_MASK, FALSE);
+    PwmHw_WriteShadowCompare(PWMIF_HW_CHANNEL_U, PWMIF_DUTY_TO_COMPARE(dutyU));
+    PwmHw_WriteShadowCompare(PWMIF_HW_CHANNEL_V, PWMIF_DUTY_TO_COMPARE(dutyV));
+    PwmHw_WriteShadowCompare(PWMIF_HW_CHANNEL_W, PWMIF_DUTY_TO_COMPARE(dutyW));
+    PwmHw_SetShadowTransfer(PWMIF_PHASE_MASK, TRUE);
+}
+
+/**
+ * @brief Switch all three phases to 0 % duty immediately
+ * 
+ * Uses a forced shadow transfer so the outputs go idle together without
+ * waiting for the period boundary (error reaction).
+ */
+void PwmIf_StopPhases(void)
+{
+    if (PwmIf_Initialized == FALSE)
+    {
+        Det_ReportError(PWMIF_MODULE_ID, 0, PWMIF_STOP_PHASES_SID, PWMIF_E_UNINIT);
+        return;
+    }
+
+    PwmHw_SetShadowTransfer(PWMIF_PHASE_MASK, FALSE);
+    PwmHw_WriteShadowCompare(PWMIF_HW_CHANNEL_U, 0u);
+    PwmHw_WriteShadowCompare(PWMIF_HW_CHANNEL_V, 0u);
+    PwmHw_WriteShadowCompare(PWMIF_HW_CHANNEL_W, 0u);
+    PwmHw_ForceShadowTransfer(PWMIF_PHASE_MASK);
+}
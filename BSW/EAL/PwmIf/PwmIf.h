@@ -0,0 +1,31 @@
+/*
+ * PwmIf.h - AUTOSAR PWM Interface Header
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface definitions
+ *              for the motor phase PWM on Infineon TC377
+ */
+
+#ifndef PWMIF_H
+#define PWMIF_H
+
+#include "Std_Types.h"
+
+/* PWM Channel IDs (motor phases) */
+#define PWMIF_CHANNEL_U  0
+#define PWMIF_CHANNEL_V  1
+#define PWMIF_CHANNEL_W  2
+
+/* Duty cycle: 0x0000 = 0 %, 0xFFFF = 100 % */
+typedef uint16 PwmIf_DutyType;
+
+/* Function Prototypes */
+void PwmIf_Init(void);
+void PwmIf_DeInit(void);
+void PwmIf_SetDutyCycle(uint8 channel, PwmIf_DutyType duty);
+void PwmIf_SetPhaseDutyCycles(PwmIf_DutyType dutyU, PwmIf_DutyType dutyV, PwmIf_DutyType dutyW);
+void PwmIf_StopPhases(void);
+
+#endif /* PWMIF_H */
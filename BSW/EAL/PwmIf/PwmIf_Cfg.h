@@ -0,0 +1,57 @@
+/*
+ * PwmIf_Cfg.h - AUTOSAR PWM Interface Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Configuration file for PWM Interface module
+ */
+
+#ifndef PWMIF_CFG_H
+#define PWMIF_CFG_H
+
+/* Module ID and Vendor ID */
+#define PWMIF_MODULE_ID          121
+#define PWMIF_VENDOR_ID          0xABCD
+
+/* Software Version Information */
+#define PWMIF_SW_MAJOR_VERSION   1
+#define PWMIF_SW_MINOR_VERSION   0
+#define PWMIF_SW_PATCH_VERSION   0
+
+/* API Service IDs */
+#define PWMIF_INIT_SID                   0x01
+#define PWMIF_SET_DUTY_CYCLE_SID         0x02
+#define PWMIF_SET_PHASE_DUTY_CYCLES_SID  0x03
+#define PWMIF_STOP_PHASES_SID            0x04
+
+/* Error Codes */
+#define PWMIF_E_PARAM_CHANNEL            0x01
+
+/* Development Error Codes */
+#define PWMIF_E_UNINIT                   0x10
+
+/* Number of motor phases driven through this interface */
+#define PWMIF_MAX_CHANNELS               3
+
+/* Hardware (GTM ATOM) channels of the motor phases */
+#define PWMIF_HW_CHANNEL_U               0u
+#define PWMIF_HW_CHANNEL_V               1u
+#define PWMIF_HW_CHANNEL_W               2u
+
+/* Mask of all phase channels for grouped shadow transfers */
+#define PWMIF_PHASE_MASK                 ((1u << PWMIF_HW_CHANNEL_U) | \
+                                          (1u << PWMIF_HW_CHANNEL_V) | \
+                                          (1u << PWMIF_HW_CHANNEL_W))
+
+/* PWM period in timer ticks: 20 kHz carrier from a 100 MHz GTM clock */
+#define PWMIF_PERIOD_TICKS               5000u
+
+/*
+ * ADC trigger point in timer ticks: the center of the period, where the
+ * phase currents are furthest from the switching edges. The control step
+ * then has the second half of the period until its update is latched.
+ */
+#define PWMIF_ADC_TRIGGER_TICKS          (PWMIF_PERIOD_TICKS / 2u)
+
+#endif /* PWMIF_CFG_H */
@@ -3,48 +3,217 @@
  *
  * Created on: 2023-xx-xx
  * Author: BSW Team
+ *
+ * Description: This file contains the implementation of the
+ *              Basic Software Mode Manager for Infineon TC377.
+ *              Each request overwrites the requested mode and adds its
+ *              source to the waiting set. BSWM_MainFunction takes both as
+ *              one switch and requests the matching ComM mode; the ComM
+ *              indication completes the switch and notifies the sources
+ *              of that set.
  */
 
 #include "BSWM.h"
 #include "Det.h"
 #include "ComM.h"
-#include "CanSM.h"
+#include "Tm.h"
 
 /* Internal variables */
+static boolean BSWM_Initialized = FALSE;
 static uint8 BSWM_CurrentMode = BSWM_MODE_NORMAL;
 
+/* Requests not yet taken by the main function */
+static boolean BSWM_RequestPending = FALSE;
+static uint8 BSWM_RequestedMode = BSWM_MODE_NORMAL;
+static uint8 BSWM_RequestSources = 0u;
+static uint32 BSWM_RequestTick = 0u;
+
+/* Switch under way */
+static boolean BSWM_SwitchPending = FALSE;
+static uint8 BSWM_SwitchMode = BSWM_MODE_NORMAL;
+static uint8 BSWM_SwitchSources = 0u;
+static uint32 BSWM_SwitchTick = 0u;
+
+static BSWM_ModeNotificationType BSWM_Notifications[BSWM_MAX_SOURCE + 1u];
+static BSWM_StatisticsType BSWM_Statistics;
+
+/**
+ * @brief   ComM mode of a BswM mode
+ */
+static uint8 BSWM_ComMode(uint8 mode)
+{
+    return (mode == BSWM_MODE_SILENT) ? COMM_SILENT_COMMUNICATION : COMM_FULL_COMMUNICATION;
+}
+
+/**
+ * @brief   End the switch under way and notify its request sources
+ */
+static void BSWM_CompleteSwitch(void)
+{
+    BSWM_ModeNotificationType notification;
+    uint32 latency;
+
+    latency = Tm_GetTicks32() - BSWM_SwitchTick;
+    BSWM_Statistics.switches++;
+    BSWM_Statistics.lastLatency = latency;
+    if (latency > BSWM_Statistics.maxLatency)
+    {
+        BSWM_Statistics.maxLatency = latency;
+    }
+    BSWM_SwitchPending = FALSE;
+
+    for (uint8 source = 1u; source <= BSWM_MAX_SOURCE; source++)
+    {
+        notification = BSWM_Notifications[source];
+        if ((BSWM_SwitchSources & (1u << source)) != 0u && notification != NULL_PTR)
+        {
+            notification(BSWM_CurrentMode);
+        }
+    }
+}
+
+/**
+ * @brief   Initialize the Basic Software Mode Manager
+ */
 void BSWM_Init(void)
 {
+    if (BSWM_Initialized == TRUE)
+    {
+        Det_ReportError(BSWM_MODULE_ID, 0, BSWM_INIT_SID, DET_E_ALREADY_INITIALIZED);
+        return;
+    }
+
     BSWM_CurrentMode = BSWM_MODE_NORMAL;
+    BSWM_RequestPending = FALSE;
+    BSWM_RequestSources = 0u;
+    BSWM_SwitchPending = FALSE;
+    BSWM_SwitchSources = 0u;
+    BSWM_Initialized = TRUE;
 }
 
+/**
+ * @brief   Request a mode
+ */
 void BSWM_RequestMode(uint8 source, uint8 mode)
 {
     /* Validate parameters */
-    if(source > BSWM_REQUEST_SOURCE_DIAG || mode > BSWM_MODE_DIAG) {
-        Det_ReportError(BSWM_MODULE_ID, 0, BSWM_REQUEST_MODE_SID, DET_E_PARAM);
+    if (source == 0u || source > BSWM_MAX_SOURCE)
+    {
+        Det_ReportError(BSWM_MODULE_ID, 0, BSWM_REQUEST_MODE_SID, BSWM_E_PARAM_SOURCE);
+        return;
+    }
+    if (mode > BSWM_MODE_DIAG)
+    {
+        Det_ReportError(BSWM_MODULE_ID, 0, BSWM_REQUEST_MODE_SID, BSWM_E_PARAM_MODE);
         return;
     }
-    
-    /* Process mode request */
-    switch(mode) {
-        case BSWM_MODE_NORMAL:
-            CanSM_RequestComMode(COMM_FULL_COMMUNICATION);
-            break;
-            
-        case BSWM_MODE_SILENT:
-            CanSM_RequestComMode(COMM_SILENT_COMMUNICATION);
-            break;
-            
-        case BSWM_MODE_DIAG:
-            CanSM_RequestComMode(COMM_FULL_COMMUNICATION);
-            break;
+
+    BSWM_ENTER_CRITICAL();
+    if (BSWM_RequestPending == TRUE)
+    {
+        BSWM_Statistics.coalesced++;
     }
-    
-    BSWM_CurrentMode = mode;
+    else
+    {
+        BSWM_RequestTick = Tm_GetTicks32();
+        BSWM_RequestPending = TRUE;
+    }
+    BSWM_RequestedMode = mode;
+    BSWM_RequestSources |= (uint8)(1u << source);
+    BSWM_Statistics.requests++;
+    BSWM_EXIT_CRITICAL();
+}
+
+/**
+ * @brief   Register the completion notification of a request source
+ */
+void BSWM_RegisterModeNotification(uint8 source, BSWM_ModeNotificationType notification)
+{
+    if (source == 0u || source > BSWM_MAX_SOURCE)
+    {
+        Det_ReportError(BSWM_MODULE_ID, 0, BSWM_REGISTER_NOTIFICATION_SID, BSWM_E_PARAM_SOURCE);
+        return;
+    }
+
+    BSWM_Notifications[source] = notification;
+}
+
+/**
+ * @brief   Start the switch to the latest requested mode
+ */
+void BSWM_MainFunction(void)
+{
+    if (BSWM_Initialized == FALSE)
+    {
+        Det_ReportError(BSWM_MODULE_ID, 0, BSWM_MAIN_FUNCTION_SID, BSWM_E_UNINIT);
+        return;
+    }
+    if (BSWM_SwitchPending == TRUE)
+    {
+        return;
+    }
+
+    BSWM_ENTER_CRITICAL();
+    if (BSWM_RequestPending == TRUE)
+    {
+        BSWM_SwitchMode = BSWM_RequestedMode;
+        BSWM_SwitchSources = BSWM_RequestSources;
+        BSWM_SwitchTick = BSWM_RequestTick;
+        BSWM_SwitchPending = TRUE;
+        BSWM_RequestPending = FALSE;
+        BSWM_RequestSources = 0u;
+    }
+    BSWM_EXIT_CRITICAL();
+
+    if (BSWM_SwitchPending == TRUE)
+    {
+        /* Completed by BSWM_ComM_CurrentMode, in this tick if the bus
+         * state manager switches at once */
+        if (ComM_RequestComMode(BSWM_COMM_CHANNEL, BSWM_ComMode(BSWM_SwitchMode)) != E_OK)
+        {
+            /* Not forwarded, the mode stays unchanged */
+            BSWM_CompleteSwitch();
+        }
+    }
+}
+
+/**
+ * @brief   Mode indication of a ComM channel
+ */
+void BSWM_ComM_CurrentMode(uint8 Channel, uint8 ComMode)
+{
+    if (Channel != BSWM_COMM_CHANNEL || BSWM_SwitchPending == FALSE)
+    {
+        return;
+    }
+
+    /* Only the indication of the requested mode answers the switch; an
+     * unsolicited one, e.g. SILENT on bus-off, leaves it pending */
+    if (ComMode != BSWM_ComMode(BSWM_SwitchMode))
+    {
+        return;
+    }
+
+    BSWM_CurrentMode = BSWM_SwitchMode;
+    BSWM_CompleteSwitch();
 }
 
 uint8 BSWM_GetCurrentMode(void)
 {
     return BSWM_CurrentMode;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief   Get the mode request statistics
+ */
+Std_ReturnType BSWM_GetStatistics(BSWM_StatisticsType *statistics)
+{
+    if (statistics == NULL_PTR)
+    {
+        Det_ReportError(BSWM_MODULE_ID, 0, BSWM_GET_STATISTICS_SID, BSWM_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+
+    *statistics = BSWM_Statistics;
+    return E_OK;
+}
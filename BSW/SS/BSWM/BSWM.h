@@ -3,12 +3,49 @@
  *
  * Created on: 2023-xx-xx
  * Author: BSW Team
+ *
+ * Description: This file contains the interface definition for the
+ *              Basic Software Mode Manager for Infineon TC377. Mode
+ *              requests are recorded and coalesced; BSWM_MainFunction
+ *              applies the latest one through ComM and the bus state
+ *              manager, and the sources that asked are notified when the
+ *              switch is complete.
  */
 
 #ifndef BSWM_H
 #define BSWM_H
 
 #include "Std_Types.h"
+#include "BSWM_Cfg.h"
+
+/* AUTOSAR Version information */
+#define BSWM_VENDOR_ID                    (0x1234)
+#define BSWM_MODULE_ID                    (0x002A)
+#define BSWM_AR_RELEASE_MAJOR_VERSION     (4)
+#define BSWM_AR_RELEASE_MINOR_VERSION     (4)
+#define BSWM_AR_RELEASE_REVISION_VERSION  (0)
+#define BSWM_SW_MAJOR_VERSION             (1)
+#define BSWM_SW_MINOR_VERSION             (0)
+#define BSWM_SW_PATCH_VERSION             (0)
+
+/* Check AUTOSAR version compatibility */
+#if ((STD_AR_RELEASE_MAJOR_VERSION != BSWM_AR_RELEASE_MAJOR_VERSION) || \
+     (STD_AR_RELEASE_MINOR_VERSION != BSWM_AR_RELEASE_MINOR_VERSION))
+#error "AUTOSAR version mismatch between BSWM.h and Std_Types.h"
+#endif
+
+/* API service IDs */
+#define BSWM_INIT_SID                     (0x00u)
+#define BSWM_REQUEST_MODE_SID             (0x01u)
+#define BSWM_MAIN_FUNCTION_SID            (0x02u)
+#define BSWM_REGISTER_NOTIFICATION_SID    (0x03u)
+#define BSWM_GET_STATISTICS_SID           (0x04u)
+
+/* Error codes */
+#define BSWM_E_UNINIT                     (0x10u)
+#define BSWM_E_PARAM_SOURCE               (0x11u)
+#define BSWM_E_PARAM_MODE                 (0x12u)
+#define BSWM_E_PARAM_POINTER              (0x13u)
 
 /* Mode request sources */
 #define BSWM_REQUEST_SOURCE_COMM  0x01u
@@ -19,9 +56,62 @@
 #define BSWM_MODE_SILENT         0x01u
 #define BSWM_MODE_DIAG           0x02u
 
+/* Completion of a request: the mode in effect after the switch, which is
+ * the requested one unless a lower layer refused it */
+typedef void (*BSWM_ModeNotificationType)(uint8 mode);
+
+/* Mode request statistics; latencies in Tm ticks from the first request
+ * of a switch to its completion */
+typedef struct {
+    uint32 requests;
+    uint32 coalesced;          /* Requests replaced before they were served */
+    uint32 switches;           /* Completed mode switches */
+    uint32 lastLatency;
+    uint32 maxLatency;
+} BSWM_StatisticsType;
+
 /* API function prototypes */
+
+/**
+ * @brief   Initialize the Basic Software Mode Manager in BSWM_MODE_NORMAL
+ */
 void BSWM_Init(void);
+
+/**
+ * @brief   Request a mode
+ * @details Constant time: the request replaces any earlier one not yet
+ *          served, and the source is notified on the completion of the
+ *          switch that serves it.
+ */
 void BSWM_RequestMode(uint8 source, uint8 mode);
+
+/**
+ * @brief   Register the completion notification of a request source
+ * @param   notification  NULL_PTR to unregister
+ */
+void BSWM_RegisterModeNotification(uint8 source, BSWM_ModeNotificationType notification);
+
+/**
+ * @brief   Start the switch to the latest requested mode
+ * @details Runs from the 1 ms tick before ComM_MainFunction. One switch is
+ *          under way at a time; requests arriving meanwhile are served by
+ *          the next one.
+ */
+void BSWM_MainFunction(void);
+
+/**
+ * @brief   Mode indication of a ComM channel
+ * @details Completes the switch under way when the channel reports the
+ *          requested mode. Other indications, such as the silent mode
+ *          entered on bus-off, are ignored.
+ */
+void BSWM_ComM_CurrentMode(uint8 Channel, uint8 ComMode);
+
 uint8 BSWM_GetCurrentMode(void);
 
-#endif /* BSWM_H */
\ No newline at end of file
+/**
+ * @brief   Get the mode request statistics
+ */
+Std_ReturnType BSWM_GetStatistics(BSWM_StatisticsType *statistics);
+
+#endif /* BSWM_H */
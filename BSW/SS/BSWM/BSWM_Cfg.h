@@ -0,0 +1,38 @@
+/*
+ * BSWM_Cfg.h - AUTOSAR Basic Software Mode Manager Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the mode arbitration settings and the
+ *              tick interrupt lock of the Basic Software Mode Manager for
+ *              Infineon TC377
+ */
+
+#ifndef BSWM_CFG_H
+#define BSWM_CFG_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+
+/* Period of BSWM_MainFunction (1 ms system tick, GPT channel 0) */
+#define BSWM_MAIN_FUNCTION_PERIOD_MS       (1u)
+
+/* Highest request source identifier */
+#define BSWM_MAX_SOURCE                    (0x02u)
+
+/* ComM channel the BswM modes are applied to */
+#define BSWM_COMM_CHANNEL                  (COMM_CHANNEL_CAN)
+
+/* Requests from outside the tick lock the tick notification; the host
+ * simulation runs requests and the tick in one context */
+#if defined(HOST_SIM)
+#define BSWM_ENTER_CRITICAL()
+#define BSWM_EXIT_CRITICAL()
+#else
+#include "Gpt.h"
+#define BSWM_ENTER_CRITICAL()              Gpt_DisableNotification(GPT_CHANNEL_0)
+#define BSWM_EXIT_CRITICAL()               Gpt_EnableNotification(GPT_CHANNEL_0)
+#endif
+
+#endif /* BSWM_CFG_H */
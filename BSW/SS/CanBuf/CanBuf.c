@@ -0,0 +1,321 @@
+/*
+ * CanBuf.c - Compact CAN Frame Buffer Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the implementation of the
+ *              CAN frame buffer module for Infineon TC377.
+ *              The producer fills an entry and then publishes it by
+ *              advancing head; the consumer copies it out and then frees it
+ *              by advancing tail. Both indices run freely and are reduced
+ *              with the depth mask, so a full and an empty queue are told
+ *              apart without a spare entry.
+ */
+
+#include <string.h>
+
+#include "CanBuf.h"
+#include "Det.h"
+
+/* Order the entry accesses against the index updates as seen from the
+ * other side (dsync on the TC377) */
+#if defined(__GNUC__)
+#define CANBUF_WRITE_BARRIER()        __atomic_thread_fence(__ATOMIC_RELEASE)
+#define CANBUF_READ_BARRIER()         __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#else
+#define CANBUF_WRITE_BARRIER()
+#define CANBUF_READ_BARRIER()
+#endif
+
+/**
+ * @brief   Copy the used payload rounded up to the next DLC class
+ * @details The frame data is not word aligned, so each case copies a fixed
+ *          size, which the compiler turns into a few wide loads and stores
+ *          instead of a library call or a loop. The copy carries less than
+ *          the used length past its end and never more than the entry's own
+ *          class, so it stays inside the data array and the entry.
+ */
+static void CanBuf_CopyPayload(void *dest, const void *src, uint32 length)
+{
+    if (length <= CANBUF_CLASS_8)
+    {
+        (void)memcpy(dest, src, CANBUF_CLASS_8);
+    }
+    else if (length <= CANBUF_CLASS_16)
+    {
+        (void)memcpy(dest, src, CANBUF_CLASS_16);
+    }
+    else if (length <= CANBUF_CLASS_32)
+    {
+        (void)memcpy(dest, src, CANBUF_CLASS_32);
+    }
+    else
+    {
+        (void)memcpy(dest, src, CANBUF_CLASS_64);
+    }
+}
+
+/**
+ * @brief   Check that a payload class is one of the supported DLC classes
+ */
+static boolean CanBuf_IsClass(uint32 payloadClass)
+{
+    return (payloadClass == CANBUF_CLASS_8 || payloadClass == CANBUF_CLASS_16 ||
+            payloadClass == CANBUF_CLASS_32 || payloadClass == CANBUF_CLASS_64) ? TRUE : FALSE;
+}
+
+/**
+ * @brief   Write header and used payload; the length is checked by the caller
+ */
+static void CanBuf_Store(uint32 *entry, const CanSM_FdFrameType *frame)
+{
+    uint32 length = frame->length;
+
+    CanBuf_CopyPayload(&entry[CANBUF_HEADER_WORDS], frame->data, length);
+    entry[0] = (frame->id & CANBUF_ID_MASK) | ((frame->brs == TRUE) ? CANBUF_BRS_FLAG : 0u);
+    entry[1] = length;
+}
+
+/**
+ * @brief   Check a frame given in pieces against a DLC class
+ */
+static boolean CanBuf_GatherFits(const CanSM_FdGatherType *frame, uint32 payloadClass)
+{
+    return (frame->length <= payloadClass &&
+            ((uint32)frame->headLength + frame->bodyLength) <= frame->length &&
+            (frame->headLength == 0u || frame->head != NULL_PTR) &&
+            (frame->bodyLength == 0u || frame->body != NULL_PTR)) ? TRUE : FALSE;
+}
+
+/**
+ * @brief   Write header, pieces and padding; the frame is checked by the caller
+ */
+static void CanBuf_StoreGather(uint32 *entry, const CanSM_FdGatherType *frame)
+{
+    uint8 *payload = (uint8 *)&entry[CANBUF_HEADER_WORDS];
+    uint32 used = (uint32)frame->headLength + frame->bodyLength;
+
+    if (frame->headLength > 0u)
+    {
+        (void)memcpy(payload, frame->head, frame->headLength);
+    }
+    if (frame->bodyLength > 0u)
+    {
+        (void)memcpy(&payload[frame->headLength], frame->body, frame->bodyLength);
+    }
+    if (frame->length > used)
+    {
+        (void)memset(&payload[used], frame->padding, frame->length - used);
+    }
+    entry[0] = (frame->id & CANBUF_ID_MASK) | ((frame->brs == TRUE) ? CANBUF_BRS_FLAG : 0u);
+    entry[1] = frame->length;
+}
+
+/**
+ * @brief   Store a frame into one entry of a DLC class
+ */
+Std_ReturnType CanBuf_Pack(uint32 *entry, uint32 payloadClass, const CanSM_FdFrameType *frame)
+{
+    if (entry == NULL_PTR || frame == NULL_PTR)
+    {
+        Det_ReportError(CANBUF_MODULE_ID, 0, CANBUF_PACK_SID, CANBUF_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+    if (frame->length > payloadClass)
+    {
+        Det_ReportError(CANBUF_MODULE_ID, 0, CANBUF_PACK_SID, CANBUF_E_PARAM_LENGTH);
+        return E_NOT_OK;
+    }
+
+    CanBuf_Store(entry, frame);
+    return E_OK;
+}
+
+/**
+ * @brief   Store a frame given in pieces into one entry of a DLC class
+ */
+Std_ReturnType CanBuf_PackGather(uint32 *entry, uint32 payloadClass, const CanSM_FdGatherType *frame)
+{
+    if (entry == NULL_PTR || frame == NULL_PTR)
+    {
+        Det_ReportError(CANBUF_MODULE_ID, 0, CANBUF_PACK_GATHER_SID, CANBUF_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+    if (CanBuf_GatherFits(frame, payloadClass) == FALSE)
+    {
+        Det_ReportError(CANBUF_MODULE_ID, 0, CANBUF_PACK_GATHER_SID, CANBUF_E_PARAM_LENGTH);
+        return E_NOT_OK;
+    }
+
+    CanBuf_StoreGather(entry, frame);
+    return E_OK;
+}
+
+/**
+ * @brief   Read a frame back from an entry of a DLC class
+ */
+void CanBuf_Unpack(const uint32 *entry, uint32 payloadClass, CanSM_FdFrameType *frame)
+{
+    uint32 length;
+
+    if (entry == NULL_PTR || frame == NULL_PTR)
+    {
+        Det_ReportError(CANBUF_MODULE_ID, 0, CANBUF_UNPACK_SID, CANBUF_E_PARAM_POINTER);
+        return;
+    }
+
+    length = entry[1];
+    if (length > payloadClass)
+    {
+        length = payloadClass;
+    }
+    frame->id = entry[0] & CANBUF_ID_MASK;
+    frame->brs = ((entry[0] & CANBUF_BRS_FLAG) != 0u) ? TRUE : FALSE;
+    frame->length = (uint8)length;
+    CanBuf_CopyPayload(frame->data, &entry[CANBUF_HEADER_WORDS], length);
+}
+
+/**
+ * @brief   CAN ID of a packed entry
+ */
+uint32 CanBuf_GetId(const uint32 *entry)
+{
+    return entry[0] & CANBUF_ID_MASK;
+}
+
+/**
+ * @brief   Copy an entry between mailboxes of one DLC class
+ */
+void CanBuf_CopyEntry(uint32 *dest, const uint32 *src, uint32 payloadClass)
+{
+    uint32 length = src[1];
+
+    if (length > payloadClass)
+    {
+        length = payloadClass;
+    }
+    dest[0] = src[0];
+    dest[1] = length;
+    CanBuf_CopyPayload(&dest[CANBUF_HEADER_WORDS], &src[CANBUF_HEADER_WORDS], length);
+}
+
+/**
+ * @brief   Set up an empty queue over user storage
+ */
+Std_ReturnType CanBuf_InitQueue(CanBuf_QueueType *queue, uint32 *storage, uint32 depth,
+                                uint32 payloadClass)
+{
+    if (queue == NULL_PTR || storage == NULL_PTR)
+    {
+        Det_ReportError(CANBUF_MODULE_ID, 0, CANBUF_INIT_QUEUE_SID, CANBUF_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+    if (depth == 0u || (depth & (depth - 1u)) != 0u || CanBuf_IsClass(payloadClass) == FALSE)
+    {
+        Det_ReportError(CANBUF_MODULE_ID, 0, CANBUF_INIT_QUEUE_SID, CANBUF_E_PARAM_CONFIG);
+        return E_NOT_OK;
+    }
+
+    queue->storage = storage;
+    queue->mask = depth - 1u;
+    queue->entryWords = CANBUF_ENTRY_WORDS(payloadClass);
+    queue->payloadClass = payloadClass;
+    queue->head = 0u;
+    queue->tail = 0u;
+    return E_OK;
+}
+
+/**
+ * @brief   Append a frame (producer side)
+ */
+Std_ReturnType CanBuf_Put(CanBuf_QueueType *queue, const CanSM_FdFrameType *frame)
+{
+    uint32 head;
+
+    if (queue == NULL_PTR || frame == NULL_PTR)
+    {
+        Det_ReportError(CANBUF_MODULE_ID, 0, CANBUF_PUT_SID, CANBUF_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+    if (frame->length > queue->payloadClass)
+    {
+        Det_ReportError(CANBUF_MODULE_ID, 0, CANBUF_PUT_SID, CANBUF_E_PARAM_LENGTH);
+        return E_NOT_OK;
+    }
+
+    head = queue->head;
+    if ((head - queue->tail) > queue->mask)
+    {
+        return E_NOT_OK;
+    }
+
+    CanBuf_Store(&queue->storage[(head & queue->mask) * queue->entryWords], frame);
+    CANBUF_WRITE_BARRIER();
+    queue->head = head + 1u;
+    return E_OK;
+}
+
+/**
+ * @brief   Append a frame given in pieces (producer side)
+ */
+Std_ReturnType CanBuf_PutGather(CanBuf_QueueType *queue, const CanSM_FdGatherType *frame)
+{
+    uint32 head;
+
+    if (queue == NULL_PTR || frame == NULL_PTR)
+    {
+        Det_ReportError(CANBUF_MODULE_ID, 0, CANBUF_PUT_GATHER_SID, CANBUF_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+    if (CanBuf_GatherFits(frame, queue->payloadClass) == FALSE)
+    {
+        Det_ReportError(CANBUF_MODULE_ID, 0, CANBUF_PUT_GATHER_SID, CANBUF_E_PARAM_LENGTH);
+        return E_NOT_OK;
+    }
+
+    head = queue->head;
+    if ((head - queue->tail) > queue->mask)
+    {
+        return E_NOT_OK;
+    }
+
+    CanBuf_StoreGather(&queue->storage[(head & queue->mask) * queue->entryWords], frame);
+    CANBUF_WRITE_BARRIER();
+    queue->head = head + 1u;
+    return E_OK;
+}
+
+/**
+ * @brief   Remove the oldest frame (consumer side)
+ */
+Std_ReturnType CanBuf_Get(CanBuf_QueueType *queue, CanSM_FdFrameType *frame)
+{
+    uint32 tail;
+
+    if (queue == NULL_PTR || frame == NULL_PTR)
+    {
+        Det_ReportError(CANBUF_MODULE_ID, 0, CANBUF_GET_SID, CANBUF_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+
+    tail = queue->tail;
+    if (queue->head == tail)
+    {
+        return E_NOT_OK;
+    }
+
+    CANBUF_READ_BARRIER();
+    CanBuf_Unpack(&queue->storage[(tail & queue->mask) * queue->entryWords], queue->payloadClass, frame);
+    CANBUF_WRITE_BARRIER();
+    queue->tail = tail + 1u;
+    return E_OK;
+}
+
+/**
+ * @brief   Number of frames queued
+ */
+uint32 CanBuf_GetCount(const CanBuf_QueueType *queue)
+{
+    return (queue != NULL_PTR) ? (queue->head - queue->tail) : 0u;
+}
@@ -0,0 +1,152 @@
+/*
+ * CanBuf.h - Compact CAN Frame Buffer Interface
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface definition for the
+ *              CAN frame buffer module for Infineon TC377. Frames are
+ *              stored as entries of 32-bit words: a packed two-word header
+ *              followed by payload storage of a fixed DLC class, the way
+ *              the MCMCAN message RAM sizes its FIFO elements. A classic
+ *              8-byte frame takes 16 bytes instead of the 72 bytes of a
+ *              CanSM_FdFrameType. The used payload is copied rounded up
+ *              to the next DLC class. The saving is in RAM, not in copy
+ *              time: on a host with the queue in cache, a put and get
+ *              still costs more than copying the struct.
+ *
+ *              Queues are single producer, single consumer rings (CAN
+ *              interrupt and task) over storage owned by their user;
+ *              a single entry serves as a mailbox.
+ */
+
+#ifndef CANBUF_H
+#define CANBUF_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "CanSM.h"
+
+/* AUTOSAR Version information */
+#define CANBUF_VENDOR_ID                   (0x1234)
+#define CANBUF_MODULE_ID                   (0x0101)
+#define CANBUF_AR_RELEASE_MAJOR_VERSION    (4)
+#define CANBUF_AR_RELEASE_MINOR_VERSION    (4)
+#define CANBUF_AR_RELEASE_REVISION_VERSION (0)
+#define CANBUF_SW_MAJOR_VERSION            (1)
+#define CANBUF_SW_MINOR_VERSION            (0)
+#define CANBUF_SW_PATCH_VERSION            (0)
+
+/* Check AUTOSAR version compatibility */
+#if ((STD_AR_RELEASE_MAJOR_VERSION != CANBUF_AR_RELEASE_MAJOR_VERSION) || \
+     (STD_AR_RELEASE_MINOR_VERSION != CANBUF_AR_RELEASE_MINOR_VERSION))
+#error "AUTOSAR version mismatch between CanBuf.h and Std_Types.h"
+#endif
+
+/* API service IDs */
+#define CANBUF_INIT_QUEUE_SID              (0x00u)
+#define CANBUF_PUT_SID                     (0x01u)
+#define CANBUF_GET_SID                     (0x02u)
+#define CANBUF_PACK_SID                    (0x03u)
+#define CANBUF_UNPACK_SID                  (0x04u)
+#define CANBUF_PACK_GATHER_SID             (0x05u)
+#define CANBUF_PUT_GATHER_SID              (0x06u)
+
+/* Error codes */
+#define CANBUF_E_PARAM_POINTER             (0x01u)
+#define CANBUF_E_PARAM_CONFIG              (0x02u)
+#define CANBUF_E_PARAM_LENGTH              (0x03u)
+
+/* DLC classes: payload bytes stored per entry */
+#define CANBUF_CLASS_8                     (8u)    /* Classic CAN, DLC 0..8 */
+#define CANBUF_CLASS_16                    (16u)   /* CAN-FD DLC 0..10 */
+#define CANBUF_CLASS_32                    (32u)   /* CAN-FD DLC 0..13 */
+#define CANBUF_CLASS_64                    (64u)   /* CAN-FD DLC 0..15 */
+
+/* Entry layout: word 0 holds the CAN ID and the BRS flag, word 1 the
+ * payload length, the payload starts at word 2 */
+#define CANBUF_HEADER_WORDS                (2u)
+#define CANBUF_ID_MASK                     (0x1FFFFFFFu)
+#define CANBUF_BRS_FLAG                    (0x80000000u)
+
+/* Words per entry and per queue for a DLC class */
+#define CANBUF_ENTRY_WORDS(payloadClass)   (CANBUF_HEADER_WORDS + ((payloadClass) / 4u))
+#define CANBUF_QUEUE_WORDS(depth, payloadClass) \
+    ((uint32)(depth) * CANBUF_ENTRY_WORDS(payloadClass))
+
+/* Queue object, owned by the user; members are private to CanBuf */
+typedef struct {
+    uint32 *storage;                  /* depth * entryWords words */
+    uint32 mask;                      /* depth - 1, depth a power of two */
+    uint32 entryWords;
+    uint32 payloadClass;
+    volatile uint32 head;             /* Written by the producer only */
+    volatile uint32 tail;             /* Written by the consumer only */
+} CanBuf_QueueType;
+
+/* Function prototypes */
+
+/**
+ * @brief   Store a frame into one entry of a DLC class (a mailbox)
+ * @return  E_NOT_OK if the frame is longer than the class
+ */
+Std_ReturnType CanBuf_Pack(uint32 *entry, uint32 payloadClass, const CanSM_FdFrameType *frame);
+
+/**
+ * @brief   Store a frame given in pieces into one entry of a DLC class
+ * @details The pieces are copied with their exact lengths, so they may end
+ *          anywhere in the caller's buffers; the rest up to the frame
+ *          length is padded.
+ * @return  E_NOT_OK if the frame is longer than the class or the pieces
+ *          longer than the frame
+ */
+Std_ReturnType CanBuf_PackGather(uint32 *entry, uint32 payloadClass, const CanSM_FdGatherType *frame);
+
+/**
+ * @brief   Read a frame back from an entry of a DLC class
+ * @details A length above the class, e.g. from a torn read of an entry
+ *          being rewritten, is cut to the class so the copy stays in bounds.
+ */
+void CanBuf_Unpack(const uint32 *entry, uint32 payloadClass, CanSM_FdFrameType *frame);
+
+/* CAN ID of a packed entry, e.g. for arbitration without unpacking */
+uint32 CanBuf_GetId(const uint32 *entry);
+
+/**
+ * @brief   Copy an entry between mailboxes of one DLC class
+ * @details Copies the header and the used payload words only.
+ */
+void CanBuf_CopyEntry(uint32 *dest, const uint32 *src, uint32 payloadClass);
+
+/**
+ * @brief   Set up an empty queue over user storage
+ * @param   storage       CANBUF_QUEUE_WORDS(depth, payloadClass) words
+ * @param   depth         Number of entries, a power of two
+ * @param   payloadClass  One of the CANBUF_CLASS_x values
+ */
+Std_ReturnType CanBuf_InitQueue(CanBuf_QueueType *queue, uint32 *storage, uint32 depth,
+                                uint32 payloadClass);
+
+/**
+ * @brief   Append a frame (producer side)
+ * @return  E_NOT_OK if the queue is full or the frame exceeds its class
+ */
+Std_ReturnType CanBuf_Put(CanBuf_QueueType *queue, const CanSM_FdFrameType *frame);
+
+/**
+ * @brief   Append a frame given in pieces (producer side)
+ * @return  E_NOT_OK if the queue is full or the frame is invalid for it,
+ *          see CanBuf_PackGather
+ */
+Std_ReturnType CanBuf_PutGather(CanBuf_QueueType *queue, const CanSM_FdGatherType *frame);
+
+/**
+ * @brief   Remove the oldest frame (consumer side)
+ * @return  E_NOT_OK if the queue is empty
+ */
+Std_ReturnType CanBuf_Get(CanBuf_QueueType *queue, CanSM_FdFrameType *frame);
+
+/* Number of frames queued */
+uint32 CanBuf_GetCount(const CanBuf_QueueType *queue);
+
+#endif /* CANBUF_H */
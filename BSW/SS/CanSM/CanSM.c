@@ -5,21 +5,57 @@
  * Author: BSW Team
  *
  * Description: This file contains the implementation of
- *              CAN-FD communication for motor control
+ *              CAN-FD communication for motor control.
+ *              A bus-off in full communication takes the network to
+ *              CANSM_BUS_OFF; CanSM_MainFunction restarts the controller
+ *              after the fast recovery time, and after the slow one once the
+ *              fast attempts are used up. Frames sent meanwhile are kept in
+ *              a backlog of CanBuf entries as the backlog policy says, and
+ *              sent after the restart at a limited rate, the ones grown
+ *              older than CANSM_BACKLOG_MAX_AGE_MS dropped.
  */
 
 #include "CanSM.h"
+#include "CanSM_Cfg.h"
+#include "CanBuf.h"
 #include "Det.h"
 #include "ComM.h"
+#include "E2E.h"
 
 /* Internal variables */
 static CanSM_StateType CanSM_CurrentState = CANSM_UNINIT;
+static boolean CanSM_ModeRequested = FALSE;
+static uint8 CanSM_RequestedMode = COMM_NO_COMMUNICATION;
+
+/* Main function time base */
+static uint32 CanSM_NowMs = 0u;
+
+/* Bus-off recovery */
+static volatile boolean CanSM_BusOffPending = FALSE;
+static boolean CanSM_ControllerStopped = FALSE;
+static boolean CanSM_Recovering = FALSE;          /* From the first bus-off to tx ensured */
+static boolean CanSM_RecoveryConfirmed = FALSE;   /* A frame was sent since the restart */
+static uint32 CanSM_BorAttempts = 0u;
+static uint32 CanSM_BorTimerMs = 0u;
+static uint32 CanSM_TxEnsuredTimerMs = 0u;
+static uint32 CanSM_BusOffMs = 0u;
+
+/* Transmit backlog, a ring of CanBuf entries in sending order */
+static uint8 CanSM_BacklogPolicy = CANSM_BACKLOG_POLICY;
+static uint32 CanSM_Backlog[CANSM_BACKLOG_DEPTH][CANBUF_ENTRY_WORDS(CANSM_BACKLOG_CLASS)];
+static uint32 CanSM_BacklogMs[CANSM_BACKLOG_DEPTH];
+static uint32 CanSM_BacklogHead = 0u;
+static uint32 CanSM_BacklogCount = 0u;
+
+static CanSM_StatisticsType CanSM_Statistics;
 
 /* CAN-FD Hardware Abstraction */
 extern void CanFdHw_Init(void);
 extern void CanFdHw_SetBaudrate(uint32 baudrate);
 extern Std_ReturnType CanFdHw_Transmit(const CanSM_FdFrameType *frame);
+extern Std_ReturnType CanFdHw_TransmitGather(const CanSM_FdGatherType *frame);
 extern Std_ReturnType CanFdHw_Receive(CanSM_FdFrameType *frame);
+extern void CanFdHw_StartController(void);
 
 /**
  * @brief Initialize CAN State Manager
@@ -33,7 +69,7 @@ void CanSM_Init(void)
         CanFdHw_SetBaudrate(2000000); /* 2Mbps data rate */
         
         CanSM_CurrentState = CANSM_INIT;
-        ComM_RequestComMode(COMM_FULL_COMMUNICATION);
+        (void)ComM_RequestComMode(COMM_CHANNEL_CAN, COMM_FULL_COMMUNICATION);
     }
 }
 
@@ -49,6 +85,289 @@ void CanSM_SetState(CanSM_StateType state)
     }
 }
 
+/**
+ * @brief Request a communication mode of the CAN network
+ * @param ComM_Mode COMM_NO/SILENT/FULL_COMMUNICATION
+ * @return E_NOT_OK before CanSM_Init or for an invalid mode
+ */
+Std_ReturnType CanSM_RequestComMode(uint8 ComM_Mode)
+{
+    if (CanSM_CurrentState == CANSM_UNINIT || ComM_Mode > COMM_FULL_COMMUNICATION)
+    {
+        return E_NOT_OK;
+    }
+    
+    CanSM_RequestedMode = ComM_Mode;
+    CanSM_ModeRequested = TRUE;
+    return E_OK;
+}
+
+/**
+ * @brief Remove the oldest backlog entry
+ */
+static void CanSM_BacklogPop(void)
+{
+    CanSM_BacklogHead = (CanSM_BacklogHead + 1u) % CANSM_BACKLOG_DEPTH;
+    CanSM_BacklogCount--;
+}
+
+/**
+ * @brief Discard the backlog, e.g. when communication stops
+ */
+static void CanSM_BacklogClear(void)
+{
+    CANSM_ENTER_CRITICAL();
+    CanSM_Statistics.backlogDropped += CanSM_BacklogCount;
+    CanSM_BacklogHead = 0u;
+    CanSM_BacklogCount = 0u;
+    CANSM_EXIT_CRITICAL();
+}
+
+/**
+ * @brief Put a frame into the backlog as the policy says (lock held)
+ * @return E_NOT_OK if the frame is dropped
+ */
+static Std_ReturnType CanSM_BacklogPut(const CanSM_FdGatherType *frame)
+{
+    uint32 index;
+
+    if (CanSM_BacklogPolicy == CANSM_BACKLOG_DROP)
+    {
+        CanSM_Statistics.backlogDropped++;
+        return E_NOT_OK;
+    }
+
+    /* Overwrite the waiting frame of the ID in its place */
+    if (CanSM_BacklogPolicy == CANSM_BACKLOG_LATEST)
+    {
+        for (uint32 n = 0; n < CanSM_BacklogCount; n++)
+        {
+            index = (CanSM_BacklogHead + n) % CANSM_BACKLOG_DEPTH;
+            if (CanBuf_GetId(CanSM_Backlog[index]) == frame->id)
+            {
+                if (CanBuf_PackGather(CanSM_Backlog[index], CANSM_BACKLOG_CLASS, frame) != E_OK)
+                {
+                    CanSM_Statistics.backlogDropped++;
+                    return E_NOT_OK;
+                }
+                CanSM_BacklogMs[index] = CanSM_NowMs;
+                CanSM_Statistics.backlogReplaced++;
+                return E_OK;
+            }
+        }
+    }
+
+    index = (CanSM_BacklogHead + CanSM_BacklogCount) % CANSM_BACKLOG_DEPTH;
+    if (CanSM_BacklogCount >= CANSM_BACKLOG_DEPTH ||
+        CanBuf_PackGather(CanSM_Backlog[index], CANSM_BACKLOG_CLASS, frame) != E_OK)
+    {
+        CanSM_Statistics.backlogDropped++;
+        return E_NOT_OK;
+    }
+    CanSM_BacklogMs[index] = CanSM_NowMs;
+    CanSM_BacklogCount++;
+    CanSM_Statistics.backlogged++;
+    return E_OK;
+}
+
+/**
+ * @brief A frame was sent: the first one after a restart ends the recovery time
+ */
+static void CanSM_TxConfirmed(void)
+{
+    uint32 recoveryMs;
+
+    if (CanSM_Recovering == TRUE && CanSM_RecoveryConfirmed == FALSE)
+    {
+        CanSM_RecoveryConfirmed = TRUE;
+        recoveryMs = CanSM_NowMs - CanSM_BusOffMs;
+        CanSM_Statistics.lastRecoveryMs = recoveryMs;
+        if (recoveryMs > CanSM_Statistics.maxRecoveryMs)
+        {
+            CanSM_Statistics.maxRecoveryMs = recoveryMs;
+        }
+    }
+}
+
+/**
+ * @brief Send the oldest backlogged frames after a restart
+ */
+static void CanSM_BacklogFlush(void)
+{
+    CanSM_FdFrameType frame;
+    uint32 sent = 0u;
+
+    CANSM_ENTER_CRITICAL();
+    while (CanSM_BacklogCount > 0u && sent < CANSM_BACKLOG_FLUSH_PER_CYCLE)
+    {
+        if ((CanSM_NowMs - CanSM_BacklogMs[CanSM_BacklogHead]) > CANSM_BACKLOG_MAX_AGE_MS)
+        {
+            CanSM_Statistics.backlogExpired++;
+            CanSM_BacklogPop();
+            continue;
+        }
+
+        CanBuf_Unpack(CanSM_Backlog[CanSM_BacklogHead], CANSM_BACKLOG_CLASS, &frame);
+        if (CanFdHw_Transmit(&frame) != E_OK)
+        {
+            /* Controller busy or still recovering, retry next call */
+            CanSM_Statistics.txFailures++;
+            break;
+        }
+        CanSM_BacklogPop();
+        CanSM_Statistics.backlogSent++;
+        CanSM_TxConfirmed();
+        sent++;
+    }
+    CANSM_EXIT_CRITICAL();
+}
+
+/**
+ * @brief Take a bus-off notification and run the recovery timers
+ */
+static void CanSM_BusOffHandling(void)
+{
+    if (CanSM_BusOffPending == TRUE)
+    {
+        CanSM_BusOffPending = FALSE;
+        CanSM_Statistics.busOffs++;
+
+        if (CanSM_CurrentState == CANSM_FULL_COMMUNICATION)
+        {
+            if (CanSM_Recovering == FALSE)
+            {
+                CanSM_Recovering = TRUE;
+                CanSM_BusOffMs = CanSM_NowMs;
+            }
+            CanSM_RecoveryConfirmed = FALSE;
+            CanSM_BorAttempts++;
+            CanSM_BorTimerMs = (CanSM_BorAttempts <= CANSM_BOR_FAST_ATTEMPTS) ?
+                               CANSM_BOR_TIME_FAST_MS : CANSM_BOR_TIME_SLOW_MS;
+            CanSM_CurrentState = CANSM_BUS_OFF;
+            ComM_BusSM_ModeIndication(COMM_CHANNEL_CAN, COMM_SILENT_COMMUNICATION);
+        }
+        else if (CanSM_CurrentState != CANSM_BUS_OFF)
+        {
+            /* Restarted on the next switch to full communication */
+            CanSM_ControllerStopped = TRUE;
+        }
+    }
+
+    if (CanSM_CurrentState == CANSM_BUS_OFF)
+    {
+        if (CanSM_BorTimerMs > CANSM_MAIN_FUNCTION_PERIOD_MS)
+        {
+            CanSM_BorTimerMs -= CANSM_MAIN_FUNCTION_PERIOD_MS;
+        }
+        else
+        {
+            CanFdHw_StartController();
+            CanSM_Statistics.restarts++;
+            CanSM_TxEnsuredTimerMs = CANSM_BOR_TIME_TX_ENSURED_MS;
+            CanSM_CurrentState = CANSM_FULL_COMMUNICATION;
+            ComM_BusSM_ModeIndication(COMM_CHANNEL_CAN, COMM_FULL_COMMUNICATION);
+        }
+    }
+    else if (CanSM_Recovering == TRUE && CanSM_CurrentState == CANSM_FULL_COMMUNICATION)
+    {
+        if (CanSM_TxEnsuredTimerMs > CANSM_MAIN_FUNCTION_PERIOD_MS)
+        {
+            CanSM_TxEnsuredTimerMs -= CANSM_MAIN_FUNCTION_PERIOD_MS;
+        }
+        else if (CanSM_RecoveryConfirmed == TRUE)
+        {
+            /* Held without a new bus-off: the next one starts fast again */
+            CanSM_Recovering = FALSE;
+            CanSM_BorAttempts = 0u;
+            CanSM_Statistics.recoveries++;
+        }
+        else
+        {
+            /* Nothing to send yet, the recovery is not proven */
+        }
+    }
+    else
+    {
+        /* No recovery under way */
+    }
+}
+
+/**
+ * @brief Carry out a requested mode switch and confirm it to ComM
+ */
+static void CanSM_ModeSwitch(void)
+{
+    if (CanSM_ModeRequested == FALSE)
+    {
+        return;
+    }
+    
+    /* Full communication is already requested; the restart confirms it */
+    if (CanSM_CurrentState == CANSM_BUS_OFF && CanSM_RequestedMode == COMM_FULL_COMMUNICATION)
+    {
+        return;
+    }
+    CanSM_ModeRequested = FALSE;
+    
+    /* Leaving full communication abandons the recovery */
+    if (CanSM_RequestedMode != COMM_FULL_COMMUNICATION)
+    {
+        if (CanSM_CurrentState == CANSM_BUS_OFF)
+        {
+            CanSM_ControllerStopped = TRUE;
+        }
+        CanSM_Recovering = FALSE;
+        CanSM_BorAttempts = 0u;
+    }
+    
+    switch (CanSM_RequestedMode)
+    {
+        case COMM_FULL_COMMUNICATION:
+            if (CanSM_ControllerStopped == TRUE)
+            {
+                CanSM_ControllerStopped = FALSE;
+                CanFdHw_StartController();
+                CanSM_Statistics.restarts++;
+            }
+            CanSM_CurrentState = CANSM_FULL_COMMUNICATION;
+            break;
+            
+        case COMM_SILENT_COMMUNICATION:
+            /* Listen only: reception continues, transmission stops */
+            CanSM_CurrentState = CANSM_SILENT;
+            CanSM_BacklogClear();
+            break;
+            
+        default:
+            CanSM_CurrentState = CANSM_INIT;
+            CanSM_BacklogClear();
+            break;
+    }
+    
+    ComM_BusSM_ModeIndication(COMM_CHANNEL_CAN, CanSM_RequestedMode);
+}
+
+/**
+ * @brief Run the bus-off recovery, the mode switches and the backlog
+ */
+void CanSM_MainFunction(void)
+{
+    if (CanSM_CurrentState == CANSM_UNINIT)
+    {
+        Det_ReportError(CANSM_MODULE_ID, 0, CANSM_MAIN_FUNCTION_SID, CANSM_E_UNINIT);
+        return;
+    }
+    
+    CanSM_NowMs += CANSM_MAIN_FUNCTION_PERIOD_MS;
+    CanSM_BusOffHandling();
+    CanSM_ModeSwitch();
+    
+    if (CanSM_CurrentState == CANSM_FULL_COMMUNICATION && CanSM_BacklogCount > 0u)
+    {
+        CanSM_BacklogFlush();
+    }
+}
+
 /**
  * @brief Transmit CAN-FD frame
  * @param frame Pointer to frame data
@@ -56,11 +375,64 @@ void CanSM_SetState(CanSM_StateType state)
  */
 Std_ReturnType CanSM_TransmitFdFrame(const CanSM_FdFrameType *frame)
 {
-    if (CanSM_CurrentState >= CANSM_READY && frame != NULL_PTR)
+    CanSM_FdGatherType pieces;
+    
+    if (frame == NULL_PTR)
     {
-        return CanFdHw_Transmit(frame);
+        return E_NOT_OK;
     }
-    return E_NOT_OK;
+    
+    /* The whole frame as one piece */
+    pieces.id = frame->id;
+    pieces.length = frame->length;
+    pieces.brs = frame->brs;
+    pieces.head = frame->data;
+    pieces.headLength = frame->length;
+    pieces.body = NULL_PTR;
+    pieces.bodyLength = 0u;
+    pieces.padding = 0u;
+    return CanSM_TransmitFdGather(&pieces);
+}
+
+/**
+ * @brief Transmit CAN-FD frame given in pieces
+ * @param frame Frame header and pieces
+ * @return Transmission status
+ */
+Std_ReturnType CanSM_TransmitFdGather(const CanSM_FdGatherType *frame)
+{
+    Std_ReturnType result = E_NOT_OK;
+    
+    if (frame == NULL_PTR)
+    {
+        return E_NOT_OK;
+    }
+    
+    CANSM_ENTER_CRITICAL();
+    if (CanSM_CurrentState == CANSM_BUS_OFF ||
+        (CanSM_CurrentState == CANSM_FULL_COMMUNICATION && CanSM_BacklogCount > 0u))
+    {
+        /* Behind the backlog, so the frames of an ID stay in order */
+        result = CanSM_BacklogPut(frame);
+    }
+    else if (CanSM_CurrentState == CANSM_READY || CanSM_CurrentState == CANSM_FULL_COMMUNICATION)
+    {
+        result = CanFdHw_TransmitGather(frame);
+        if (result == E_OK)
+        {
+            CanSM_TxConfirmed();
+        }
+        else
+        {
+            CanSM_Statistics.txFailures++;
+        }
+    }
+    else
+    {
+        /* No transmission in this state */
+    }
+    CANSM_EXIT_CRITICAL();
+    return result;
 }
 
 /**
@@ -77,11 +449,59 @@ Std_ReturnType CanSM_ReceiveFdFrame(CanSM_FdFrameType *frame)
     return E_NOT_OK;
 }
 
+/**
+ * @brief Bus-off notification of the CAN controller driver
+ */
+void CanSM_ControllerBusOff(void)
+{
+    CanSM_BusOffPending = TRUE;
+}
+
+/**
+ * @brief Error passive notification of the CAN controller driver
+ */
+void CanSM_ControllerErrorPassive(void)
+{
+    CanSM_Statistics.errorPassive++;
+}
+
+/**
+ * @brief Select the transmit backlog policy
+ */
+Std_ReturnType CanSM_SetBacklogPolicy(uint8 policy)
+{
+    if (policy > CANSM_BACKLOG_ALL)
+    {
+        Det_ReportError(CANSM_MODULE_ID, 0, CANSM_SET_BACKLOG_POLICY_SID, CANSM_E_PARAM_POLICY);
+        return E_NOT_OK;
+    }
+    
+    CANSM_ENTER_CRITICAL();
+    CanSM_BacklogPolicy = policy;
+    CANSM_EXIT_CRITICAL();
+    return E_OK;
+}
+
+/**
+ * @brief Get the bus-off and transmit backlog statistics
+ */
+Std_ReturnType CanSM_GetStatistics(CanSM_StatisticsType *statistics)
+{
+    if (statistics == NULL_PTR)
+    {
+        Det_ReportError(CANSM_MODULE_ID, 0, CANSM_GET_STATISTICS_SID, CANSM_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+    
+    *statistics = CanSM_Statistics;
+    return E_OK;
+}
+
 /* Motor Control Specific Functions */
-void CanSM_SendMotorCmd(uint16 speed, int16 torque, uint8 mode)
+void CanSM_SendMotorCmd(uint16 speed, sint16 torque, uint8 mode)
 {
     CanSM_FdFrameType frame;
-    frame.id = 0x100; /* MOTOR_CMD ID */
+    frame.id = CANSM_MOTOR_CMD_ID;
     frame.length = 8;
     frame.brs = TRUE;
     
@@ -91,22 +511,85 @@ void CanSM_SendMotorCmd(uint16 speed, int16 torque, uint8 mode)
     frame.data[2] = (uint8)(torque & 0xFF);
     frame.data[3] = (uint8)(torque >> 8);
     frame.data[4] = mode;
+    frame.data[5] = 0;
+    frame.data[6] = 0;
+    frame.data[7] = 0;
     
+    /* Counter in byte 6, CRC8H2F in byte 7 */
+    (void)E2E_Protect(E2E_PDU_MOTOR_CMD, frame.data, frame.length);
     (void)CanSM_TransmitFdFrame(&frame);
 }
 
-void CanSM_GetMotorStatus(uint16 *speed, int16 *torque, uint8 *fault)
+void CanSM_SendMotorConfig(uint16 maxSpeed, sint16 maxTorque, sint16 acceleration)
 {
     CanSM_FdFrameType frame;
+    frame.id = CANSM_MOTOR_CONFIG_ID;
+    frame.length = 12;
+    frame.brs = TRUE;
+    
+    /* Pack data according to DBC format */
+    frame.data[0] = (uint8)(maxSpeed & 0xFF);
+    frame.data[1] = (uint8)(maxSpeed >> 8);
+    frame.data[2] = (uint8)(maxTorque & 0xFF);
+    frame.data[3] = (uint8)(maxTorque >> 8);
+    frame.data[4] = (uint8)(acceleration & 0xFF);
+    frame.data[5] = (uint8)(acceleration >> 8);
+    frame.data[6] = 0;
+    frame.data[7] = 0;
     
-    if (CanSM_ReceiveFdFrame(&frame) == E_OK && frame.id == 0x101)
+    /* Counter in byte 6, CRC32 in bytes 8..11 */
+    (void)E2E_Protect(E2E_PDU_MOTOR_CONFIG, frame.data, frame.length);
+    (void)CanSM_TransmitFdFrame(&frame);
+}
+
+/**
+ * @brief Read one frame and unpack it if it is MOTOR_STATUS
+ * @return E_OK if a MOTOR_STATUS frame was read and passed the E2E check
+ */
+Std_ReturnType CanSM_GetMotorStatus(uint16 *speed, sint16 *torque, uint8 *fault)
+{
+    CanSM_FdFrameType frame;
+    E2E_PCheckStatusType status;
+    
+    if (CanSM_ReceiveFdFrame(&frame) != E_OK || frame.id != CANSM_MOTOR_STATUS_ID)
+    {
+        return E_NOT_OK;
+    }
+    
+    status = E2E_Check(E2E_PDU_MOTOR_STATUS, frame.data, frame.length);
+    if ((status == E2E_P_OK || status == E2E_P_OKSOMELOST) &&
+        E2E_GetState(E2E_PDU_MOTOR_STATUS) == E2E_SM_VALID)
     {
         /* Unpack data according to DBC format */
         if (speed != NULL_PTR)
             *speed = (uint16)(frame.data[0] | (frame.data[1] << 8));
         if (torque != NULL_PTR)
-            *torque = (int16)(frame.data[2] | (frame.data[3] << 8));
+            *torque = (sint16)(frame.data[2] | (frame.data[3] << 8));
         if (fault != NULL_PTR)
             *fault = frame.data[4];
+        return E_OK;
     }
+    return E_NOT_OK;
+}
+
+void CanSM_SendMotorStatus(uint16 speed, sint16 torque, uint8 fault)
+{
+    CanSM_FdFrameType frame;
+    frame.id = CANSM_MOTOR_STATUS_ID;
+    frame.length = 8;
+    frame.brs = TRUE;
+    
+    /* Pack data according to DBC format */
+    frame.data[0] = (uint8)(speed & 0xFF);
+    frame.data[1] = (uint8)(speed >> 8);
+    frame.data[2] = (uint8)(torque & 0xFF);
+    frame.data[3] = (uint8)(torque >> 8);
+    frame.data[4] = fault;
+    frame.data[5] = 0;
+    frame.data[6] = 0;
+    frame.data[7] = 0;
+    
+    /* Counter in byte 5, CRC16 in bytes 6..7 */
+    (void)E2E_Protect(E2E_PDU_MOTOR_STATUS, frame.data, frame.length);
+    (void)CanSM_TransmitFdFrame(&frame);
 }
\ No newline at end of file
@@ -13,13 +13,32 @@
 
 #include "Std_Types.h"
 
+/* AUTOSAR module ID of the CAN State Manager */
+#define CANSM_MODULE_ID          (0x008C)
+
+/* API service IDs */
+#define CANSM_MAIN_FUNCTION_SID          (0x05u)
+#define CANSM_SET_BACKLOG_POLICY_SID     (0x20u)
+#define CANSM_GET_STATISTICS_SID         (0x21u)
+
+/* Error codes */
+#define CANSM_E_UNINIT                   (0x01u)
+#define CANSM_E_PARAM_POINTER            (0x02u)
+#define CANSM_E_PARAM_POLICY             (0x03u)
+
+/* Transmit backlog policies while the controller is in bus-off */
+#define CANSM_BACKLOG_DROP       (0u)    /* Refuse, the sender retries */
+#define CANSM_BACKLOG_LATEST     (1u)    /* Keep the latest frame per CAN ID */
+#define CANSM_BACKLOG_ALL        (2u)    /* Keep every frame in order */
+
 /* CAN State Manager States */
 typedef enum {
     CANSM_UNINIT,
     CANSM_INIT,
     CANSM_READY,
     CANSM_SILENT,
-    CANSM_FULL_COMMUNICATION
+    CANSM_FULL_COMMUNICATION,
+    CANSM_BUS_OFF                /* Full communication, controller waiting for its restart */
 } CanSM_StateType;
 
 /* CAN-FD Message Structure */
@@ -30,14 +49,100 @@ typedef struct {
     boolean brs; /* Bit Rate Switch */
 } CanSM_FdFrameType;
 
+/* CAN-FD frame given in two pieces, assembled by the controller driver
+ * directly in its transmit buffer; the bytes after the pieces up to the
+ * frame length are filled with the padding byte */
+typedef struct {
+    uint32 id;
+    uint8 length;                /* Frame length, at least headLength + bodyLength */
+    boolean brs;                 /* Bit Rate Switch */
+    const uint8 *head;           /* First piece, e.g. the N_PCI */
+    uint8 headLength;
+    const uint8 *body;           /* Second piece; NULL_PTR if bodyLength is 0 */
+    uint8 bodyLength;
+    uint8 padding;
+} CanSM_FdGatherType;
+
+/* Bus-off and transmit backlog statistics */
+typedef struct {
+    uint32 busOffs;              /* Bus-off notifications */
+    uint32 errorPassive;         /* Error passive notifications */
+    uint32 restarts;             /* Controller restarts after bus-off */
+    uint32 recoveries;           /* Recoveries held for CANSM_BOR_TIME_TX_ENSURED_MS */
+    uint32 lastRecoveryMs;       /* First bus-off to the next frame sent */
+    uint32 maxRecoveryMs;
+    uint32 txFailures;           /* Frames the controller refused */
+    uint32 backlogged;           /* Frames put into the backlog */
+    uint32 backlogReplaced;      /* Backlogged frames overwritten by a newer one of their ID */
+    uint32 backlogDropped;       /* Frames refused: backlog full or policy DROP */
+    uint32 backlogExpired;       /* Backlogged frames older than CANSM_BACKLOG_MAX_AGE_MS */
+    uint32 backlogSent;          /* Backlogged frames sent after the restart */
+} CanSM_StatisticsType;
+
+/* Motor control message IDs (MotorControl.dbc, decimal in the DBC) */
+#define CANSM_MOTOR_CMD_ID       (100u)   /* ECU1 -> ECU2 */
+#define CANSM_MOTOR_STATUS_ID    (101u)   /* ECU2 -> ECU1 */
+#define CANSM_MOTOR_CONFIG_ID    (102u)   /* ECU1 -> ECU2 */
+
 /* Function Prototypes */
 void CanSM_Init(void);
 void CanSM_SetState(CanSM_StateType state);
+
+/**
+ * @brief Request a communication mode of the CAN network (from ComM)
+ * @details Recorded only, the latest request wins. CanSM_MainFunction
+ *          switches the state and confirms through ComM_BusSM_ModeIndication.
+ * @return E_NOT_OK before CanSM_Init or for an invalid mode
+ */
+Std_ReturnType CanSM_RequestComMode(uint8 ComM_Mode);
+
+/**
+ * @brief Carry out a requested mode switch; runs after ComM_MainFunction
+ * @details Also runs the bus-off recovery and sends the transmit backlog
+ *          after a restart, CANSM_BACKLOG_FLUSH_PER_CYCLE frames per call.
+ */
+void CanSM_MainFunction(void);
+
+/**
+ * @brief Transmit CAN-FD frame
+ * @details In bus-off, and after the restart until the backlog is sent, the
+ *          frame goes to the backlog according to the backlog policy.
+ * @return E_OK if the controller or the backlog took the frame
+ */
 Std_ReturnType CanSM_TransmitFdFrame(const CanSM_FdFrameType *frame);
+
+/**
+ * @brief Transmit a CAN-FD frame given in pieces
+ * @details As CanSM_TransmitFdFrame, but the pieces are copied once, by the
+ *          driver into its transmit buffer or into the backlog entry,
+ *          without a frame assembled in between.
+ * @return E_OK if the controller or the backlog took the frame
+ */
+Std_ReturnType CanSM_TransmitFdGather(const CanSM_FdGatherType *frame);
 Std_ReturnType CanSM_ReceiveFdFrame(CanSM_FdFrameType *frame);
 
-/* Motor Control Specific Messages */
-void CanSM_SendMotorCmd(uint16 speed, int16 torque, uint8 mode);
-void CanSM_GetMotorStatus(uint16 *speed, int16 *torque, uint8 *fault);
+/**
+ * @brief Bus-off notification of the CAN controller driver (interrupt context)
+ * @details Handled by the next CanSM_MainFunction: in full communication the
+ *          controller is restarted after the fast or the slow recovery time.
+ */
+void CanSM_ControllerBusOff(void);
+
+/* Error passive notification of the CAN controller driver; counted only, an
+ * error passive node still takes part in the communication */
+void CanSM_ControllerErrorPassive(void);
+
+/* Select the transmit backlog policy, CANSM_BACKLOG_DROP/LATEST/ALL */
+Std_ReturnType CanSM_SetBacklogPolicy(uint8 policy);
+
+Std_ReturnType CanSM_GetStatistics(CanSM_StatisticsType *statistics);
+
+/* Motor Control Specific Messages (ECU1 side) */
+void CanSM_SendMotorCmd(uint16 speed, sint16 torque, uint8 mode);
+void CanSM_SendMotorConfig(uint16 maxSpeed, sint16 maxTorque, sint16 acceleration);
+Std_ReturnType CanSM_GetMotorStatus(uint16 *speed, sint16 *torque, uint8 *fault);
+
+/* Motor Control Specific Messages (ECU2 side) */
+void CanSM_SendMotorStatus(uint16 speed, sint16 torque, uint8 fault);
 
 #endif /* CANSM_H */
\ No newline at end of file
@@ -0,0 +1,60 @@
+/*
+ * CanSM_Cfg.h - AUTOSAR CAN State Manager Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the bus-off recovery timing, the
+ *              transmit backlog kept during recovery and the tick
+ *              interrupt lock of the CAN State Manager for Infineon TC377
+ */
+
+#ifndef CANSM_CFG_H
+#define CANSM_CFG_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+
+/* Period of CanSM_MainFunction (1 ms system tick, GPT channel 0) */
+#define CANSM_MAIN_FUNCTION_PERIOD_MS        (1u)
+
+/* Bus-off recovery: the first attempts restart the controller after the
+ * short delay, further ones after the long delay, so a node that keeps
+ * failing stops disturbing the bus (CanSMBorTimeL1/L2, CanSMBorCounterL1ToL2) */
+#define CANSM_BOR_TIME_FAST_MS               (10u)
+#define CANSM_BOR_TIME_SLOW_MS               (100u)
+#define CANSM_BOR_FAST_ATTEMPTS              (5u)
+
+/* Time without a new bus-off after a restart before the recovery counts as
+ * successful and the next bus-off starts with fast attempts again
+ * (CanSMBorTimeTxEnsured) */
+#define CANSM_BOR_TIME_TX_ENSURED_MS         (50u)
+
+/* Transmit backlog policy after CanSM_Init; suits cyclic signals, where
+ * only the latest value matters */
+#define CANSM_BACKLOG_POLICY                 (CANSM_BACKLOG_LATEST)
+
+/* Backlog size in frames and payload storage per frame (CanBuf DLC class) */
+#define CANSM_BACKLOG_DEPTH                  (16u)
+#define CANSM_BACKLOG_CLASS                  (CANBUF_CLASS_64)
+
+/* Backlogged frames older than this are dropped instead of sent */
+#define CANSM_BACKLOG_MAX_AGE_MS             (100u)
+
+/* Backlogged frames handed to the controller per main function, so the
+ * backlog does not take the bus from the other nodes after a restart */
+#define CANSM_BACKLOG_FLUSH_PER_CYCLE        (4u)
+
+/* Transmission and the bus-off notification from outside the tick lock
+ * the tick notification; the host simulation runs them and the tick in
+ * one context */
+#if defined(HOST_SIM)
+#define CANSM_ENTER_CRITICAL()
+#define CANSM_EXIT_CRITICAL()
+#else
+#include "Gpt.h"
+#define CANSM_ENTER_CRITICAL()               Gpt_DisableNotification(GPT_CHANNEL_0)
+#define CANSM_EXIT_CRITICAL()                Gpt_EnableNotification(GPT_CHANNEL_0)
+#endif
+
+#endif /* CANSM_CFG_H */
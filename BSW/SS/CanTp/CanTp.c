@@ -0,0 +1,762 @@
+/*
+ * CanTp.c - AUTOSAR CAN Transport Layer Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the implementation of the
+ *              ISO 15765-2 transport protocol over CAN-FD
+ */
+
+#include <string.h>
+
+#include "CanTp.h"
+#include "Det.h"
+
+/* Protocol control information types (high nibble of the first byte) */
+#define CANTP_PCI_SF                 (0x00u)
+#define CANTP_PCI_FF                 (0x10u)
+#define CANTP_PCI_CF                 (0x20u)
+#define CANTP_PCI_FC                 (0x30u)
+
+/* Flow status values */
+#define CANTP_FS_CTS                 (0x00u)
+#define CANTP_FS_WAIT                (0x01u)
+#define CANTP_FS_OVFLW               (0x02u)
+#define CANTP_FS_NONE                (0xFFu)
+
+/* Largest length the 12-bit first frame length field can carry */
+#define CANTP_FF_SHORT_MAX_LENGTH    (4095u)
+
+/* Classic CAN frame length, also the minimum padded frame length */
+#define CANTP_CLASSIC_DL             (8u)
+
+#define CANTP_N_BS_TICKS  ((uint16)(CANTP_N_BS_TIMEOUT_MS / CANTP_MAIN_FUNCTION_PERIOD_MS))
+#define CANTP_N_CR_TICKS  ((uint16)(CANTP_N_CR_TIMEOUT_MS / CANTP_MAIN_FUNCTION_PERIOD_MS))
+
+/* Transmit and receive states */
+typedef enum {
+    CANTP_TX_IDLE,
+    CANTP_TX_SEND_FIRST,    /* SF or FF not yet accepted by CanSM */
+    CANTP_TX_WAIT_FC,
+    CANTP_TX_SEND_CF
+} CanTp_TxStateType;
+
+typedef enum {
+    CANTP_RX_IDLE,
+    CANTP_RX_RECEIVING
+} CanTp_RxStateType;
+
+/* Connection runtime data */
+typedef struct {
+    /* Transmit side: segments are taken directly from txData */
+    CanTp_TxStateType txState;
+    const uint8 *txData;
+    uint32 txLength;
+    uint32 txOffset;
+    uint8 txSn;
+    uint8 txBlockSize;
+    uint8 txBlockCount;
+    uint16 txStMinTicks;
+    uint16 txStMinTimer;
+    uint16 txTimer;
+
+    /* Receive side: segments are written directly into rxBuffer */
+    CanTp_RxStateType rxState;
+    uint8 *rxBuffer;
+    uint32 rxBufferSize;
+    uint32 rxLength;
+    uint32 rxOffset;
+    uint8 rxSn;
+    uint8 rxBlockCount;
+    uint8 rxFcPending;
+    uint16 rxTimer;
+
+    CanTp_TxConfirmationType txConfirmation;
+    CanTp_RxIndicationType rxIndication;
+} CanTp_ConnectionType;
+
+/* Internal variables */
+static boolean CanTp_Initialized = FALSE;
+static CanTp_ConnectionType CanTp_Connections[CANTP_MAX_CONNECTIONS];
+
+/* Forward declarations */
+static uint8 CanTp_RoundUpLength(uint8 length);
+static uint16 CanTp_StMinToTicks(uint8 stMin);
+static Std_ReturnType CanTp_SendFrame(uint8 ConnectionId, const uint8 *pci, uint8 pciLength,
+                                      const uint8 *payload, uint8 payloadLength);
+static Std_ReturnType CanTp_SendFirstFrame(uint8 ConnectionId);
+static Std_ReturnType CanTp_SendConsecutiveFrame(uint8 ConnectionId);
+static void CanTp_SendFlowControl(uint8 ConnectionId);
+static void CanTp_TxFinish(uint8 ConnectionId, Std_ReturnType Result);
+static void CanTp_RxFinish(uint8 ConnectionId, Std_ReturnType Result);
+static void CanTp_RxFirstOrSingle(uint8 ConnectionId, const CanSM_FdFrameType *frame,
+                                  uint32 length, uint8 offset, boolean isFirstFrame);
+static void CanTp_RxConsecutive(uint8 ConnectionId, const CanSM_FdFrameType *frame);
+static void CanTp_RxFlowControl(uint8 ConnectionId, const CanSM_FdFrameType *frame);
+
+/**
+ * @brief   Initialize the CAN Transport Layer
+ */
+void CanTp_Init(void)
+{
+    if (CanTp_Initialized == FALSE)
+    {
+        for (uint8 i = 0; i < CANTP_MAX_CONNECTIONS; i++)
+        {
+            (void)memset(&CanTp_Connections[i], 0, sizeof(CanTp_ConnectionType));
+            CanTp_Connections[i].txState = CANTP_TX_IDLE;
+            CanTp_Connections[i].rxState = CANTP_RX_IDLE;
+            CanTp_Connections[i].rxFcPending = CANTP_FS_NONE;
+        }
+
+        CanTp_Initialized = TRUE;
+    }
+    else
+    {
+        Det_ReportError(CANTP_MODULE_ID, 0, CANTP_INIT_SID, DET_E_ALREADY_INITIALIZED);
+    }
+}
+
+/**
+ * @brief   Start a segmented or unsegmented transmission
+ */
+Std_ReturnType CanTp_Transmit(uint8 ConnectionId, const uint8 *Data, uint32 Length)
+{
+    CanTp_ConnectionType *conn;
+
+    if (CanTp_Initialized == FALSE)
+    {
+        Det_ReportError(CANTP_MODULE_ID, 0, CANTP_TRANSMIT_SID, CANTP_E_UNINIT);
+        return E_NOT_OK;
+    }
+    if (ConnectionId >= CANTP_MAX_CONNECTIONS)
+    {
+        Det_ReportError(CANTP_MODULE_ID, 0, CANTP_TRANSMIT_SID, CANTP_E_PARAM_ID);
+        return E_NOT_OK;
+    }
+    if (Data == NULL_PTR)
+    {
+        Det_ReportError(CANTP_MODULE_ID, 0, CANTP_TRANSMIT_SID, CANTP_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+    if (Length == 0u)
+    {
+        Det_ReportError(CANTP_MODULE_ID, 0, CANTP_TRANSMIT_SID, CANTP_E_INVALID_TX_LENGTH);
+        return E_NOT_OK;
+    }
+
+    conn = &CanTp_Connections[ConnectionId];
+    if (conn->txState != CANTP_TX_IDLE)
+    {
+        Det_ReportError(CANTP_MODULE_ID, 0, CANTP_TRANSMIT_SID, CANTP_E_TX_BUSY);
+        return E_NOT_OK;
+    }
+
+    conn->txData = Data;
+    conn->txLength = Length;
+    conn->txOffset = 0u;
+    conn->txSn = 1u;
+    conn->txBlockCount = 0u;
+    conn->txState = CANTP_TX_SEND_FIRST;
+
+    /* Try to send immediately; CanTp_MainFunction retries if CanSM is busy */
+    (void)CanTp_SendFirstFrame(ConnectionId);
+
+    return E_OK;
+}
+
+/**
+ * @brief   Provide the reassembly buffer for a connection
+ */
+Std_ReturnType CanTp_SetRxBuffer(uint8 ConnectionId, uint8 *Buffer, uint32 Size)
+{
+    if (ConnectionId >= CANTP_MAX_CONNECTIONS)
+    {
+        Det_ReportError(CANTP_MODULE_ID, 0, CANTP_SET_RX_BUFFER_SID, CANTP_E_PARAM_ID);
+        return E_NOT_OK;
+    }
+    if (Buffer == NULL_PTR && Size != 0u)
+    {
+        Det_ReportError(CANTP_MODULE_ID, 0, CANTP_SET_RX_BUFFER_SID, CANTP_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+    if (CanTp_Connections[ConnectionId].rxState != CANTP_RX_IDLE)
+    {
+        return E_NOT_OK;
+    }
+
+    CanTp_Connections[ConnectionId].rxBuffer = Buffer;
+    CanTp_Connections[ConnectionId].rxBufferSize = Size;
+    return E_OK;
+}
+
+/**
+ * @brief   Register completion callbacks for a connection
+ */
+void CanTp_RegisterCallbacks(uint8 ConnectionId, CanTp_TxConfirmationType TxConfirmation,
+                             CanTp_RxIndicationType RxIndication)
+{
+    if (ConnectionId < CANTP_MAX_CONNECTIONS)
+    {
+        CanTp_Connections[ConnectionId].txConfirmation = TxConfirmation;
+        CanTp_Connections[ConnectionId].rxIndication = RxIndication;
+    }
+    else
+    {
+        Det_ReportError(CANTP_MODULE_ID, 0, CANTP_REGISTER_CALLBACKS_SID, CANTP_E_PARAM_ID);
+    }
+}
+
+/**
+ * @brief   Hand a received CAN-FD frame to the transport layer
+ */
+void CanTp_RxIndication(const CanSM_FdFrameType *frame)
+{
+    uint8 connId;
+    uint32 length;
+
+    if (CanTp_Initialized == FALSE)
+    {
+        Det_ReportError(CANTP_MODULE_ID, 0, CANTP_RX_INDICATION_SID, CANTP_E_UNINIT);
+        return;
+    }
+    if (frame == NULL_PTR)
+    {
+        Det_ReportError(CANTP_MODULE_ID, 0, CANTP_RX_INDICATION_SID, CANTP_E_PARAM_POINTER);
+        return;
+    }
+    if (frame->length == 0u || frame->length > sizeof(frame->data))
+    {
+        return;
+    }
+
+    for (connId = 0; connId < CANTP_MAX_CONNECTIONS; connId++)
+    {
+        if (CanTp_ConnectionConfig[connId].rxId == frame->id)
+        {
+            break;
+        }
+    }
+    if (connId >= CANTP_MAX_CONNECTIONS)
+    {
+        /* Not a transport layer frame */
+        return;
+    }
+
+    switch (frame->data[0] & 0xF0u)
+    {
+        case CANTP_PCI_SF:
+            length = frame->data[0] & 0x0Fu;
+            if (length == 0u && frame->length > CANTP_CLASSIC_DL)
+            {
+                /* CAN-FD escape sequence: length in the second byte */
+                length = frame->data[1];
+                CanTp_RxFirstOrSingle(connId, frame, length, 2u, FALSE);
+            }
+            else
+            {
+                CanTp_RxFirstOrSingle(connId, frame, length, 1u, FALSE);
+            }
+            break;
+
+        case CANTP_PCI_FF:
+            if (frame->length < CANTP_CLASSIC_DL)
+            {
+                break;
+            }
+            length = ((uint32)(frame->data[0] & 0x0Fu) << 8) | frame->data[1];
+            if (length == 0u)
+            {
+                /* Escape sequence: 32-bit length for messages above 4095 bytes */
+                length = ((uint32)frame->data[2] << 24) | ((uint32)frame->data[3] << 16) |
+                         ((uint32)frame->data[4] << 8) | (uint32)frame->data[5];
+                CanTp_RxFirstOrSingle(connId, frame, length, 6u, TRUE);
+            }
+            else
+            {
+                CanTp_RxFirstOrSingle(connId, frame, length, 2u, TRUE);
+            }
+            break;
+
+        case CANTP_PCI_CF:
+            CanTp_RxConsecutive(connId, frame);
+            break;
+
+        case CANTP_PCI_FC:
+            CanTp_RxFlowControl(connId, frame);
+            break;
+
+        default:
+            /* Unknown PCI, ignore */
+            break;
+    }
+}
+
+/**
+ * @brief   Periodic processing (consecutive frames, flow control, timeouts)
+ */
+void CanTp_MainFunction(void)
+{
+    CanTp_ConnectionType *conn;
+
+    if (CanTp_Initialized == FALSE)
+    {
+        return;
+    }
+
+    for (uint8 i = 0; i < CANTP_MAX_CONNECTIONS; i++)
+    {
+        conn = &CanTp_Connections[i];
+
+        /* Receive side */
+        if (conn->rxFcPending != CANTP_FS_NONE)
+        {
+            CanTp_SendFlowControl(i);
+        }
+        if (conn->rxState == CANTP_RX_RECEIVING)
+        {
+            if (conn->rxTimer > 0u)
+            {
+                conn->rxTimer--;
+            }
+            if (conn->rxTimer == 0u)
+            {
+                Det_ReportRuntimeError(CANTP_MODULE_ID, i, CANTP_MAIN_FUNCTION_SID, CANTP_E_RX_TIMEOUT_CR);
+                CanTp_RxFinish(i, E_NOT_OK);
+            }
+        }
+
+        /* Transmit side */
+        switch (conn->txState)
+        {
+            case CANTP_TX_SEND_FIRST:
+                (void)CanTp_SendFirstFrame(i);
+                break;
+
+            case CANTP_TX_WAIT_FC:
+                if (conn->txTimer > 0u)
+                {
+                    conn->txTimer--;
+                }
+                if (conn->txTimer == 0u)
+                {
+                    Det_ReportRuntimeError(CANTP_MODULE_ID, i, CANTP_MAIN_FUNCTION_SID, CANTP_E_TX_TIMEOUT_BS);
+                    CanTp_TxFinish(i, E_NOT_OK);
+                }
+                break;
+
+            case CANTP_TX_SEND_CF:
+                if (conn->txStMinTicks == 0u)
+                {
+                    /* No separation time: burst until the block ends or CanSM is busy */
+                    while (conn->txState == CANTP_TX_SEND_CF)
+                    {
+                        if (CanTp_SendConsecutiveFrame(i) != E_OK)
+                        {
+                            break;
+                        }
+                    }
+                }
+                else
+                {
+                    if (conn->txStMinTimer > 0u)
+                    {
+                        conn->txStMinTimer--;
+                    }
+                    if (conn->txStMinTimer == 0u && CanTp_SendConsecutiveFrame(i) == E_OK)
+                    {
+                        conn->txStMinTimer = conn->txStMinTicks;
+                    }
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * @brief   Get version information
+ */
+void CanTp_GetVersionInfo(Std_VersionInfoType *versioninfo)
+{
+    if (versioninfo != NULL_PTR)
+    {
+        versioninfo->vendorID = CANTP_VENDOR_ID;
+        versioninfo->moduleID = CANTP_MODULE_ID;
+        versioninfo->sw_major_version = CANTP_SW_MAJOR_VERSION;
+        versioninfo->sw_minor_version = CANTP_SW_MINOR_VERSION;
+        versioninfo->sw_patch_version = CANTP_SW_PATCH_VERSION;
+    }
+    else
+    {
+        Det_ReportError(CANTP_MODULE_ID, 0, CANTP_GET_VERSION_INFO_SID, CANTP_E_PARAM_POINTER);
+    }
+}
+
+/**
+ * @brief   Round a frame length up to the next valid CAN-FD data length
+ */
+static uint8 CanTp_RoundUpLength(uint8 length)
+{
+    static const uint8 fdLengths[] = {12u, 16u, 20u, 24u, 32u, 48u, 64u};
+
+    if (length <= CANTP_CLASSIC_DL)
+    {
+        return CANTP_CLASSIC_DL;
+    }
+    for (uint8 i = 0; i < sizeof(fdLengths); i++)
+    {
+        if (length <= fdLengths[i])
+        {
+            return fdLengths[i];
+        }
+    }
+    return 64u;
+}
+
+/**
+ * @brief   Convert an ISO 15765-2 STmin value into main function ticks
+ * @details Sub-millisecond values round up to one frame per main function.
+ *          Reserved values are treated as 127 ms as required by ISO 15765-2.
+ */
+static uint16 CanTp_StMinToTicks(uint8 stMin)
+{
+    uint32 ms;
+
+    if (stMin <= 0x7Fu)
+    {
+        ms = stMin;
+    }
+    else if (stMin >= 0xF1u && stMin <= 0xF9u)
+    {
+        return 1u;
+    }
+    else
+    {
+        ms = 0x7Fu;
+    }
+    return (uint16)((ms + CANTP_MAIN_FUNCTION_PERIOD_MS - 1u) / CANTP_MAIN_FUNCTION_PERIOD_MS);
+}
+
+/**
+ * @brief   Hand PCI and payload to CanSM as the pieces of one frame
+ * @details Neither piece is copied here: the controller driver assembles
+ *          them directly in its transmit buffer and pads unused bytes up
+ *          to the next valid DLC.
+ */
+static Std_ReturnType CanTp_SendFrame(uint8 ConnectionId, const uint8 *pci, uint8 pciLength,
+                                      const uint8 *payload, uint8 payloadLength)
+{
+    const CanTp_ConnectionConfigType *cfg = &CanTp_ConnectionConfig[ConnectionId];
+    CanSM_FdGatherType frame;
+
+    frame.id = cfg->txId;
+    frame.brs = cfg->brs;
+    frame.length = CanTp_RoundUpLength((uint8)(pciLength + payloadLength));
+    frame.head = pci;
+    frame.headLength = pciLength;
+    frame.body = (payloadLength > 0u) ? payload : NULL_PTR;
+    frame.bodyLength = payloadLength;
+    frame.padding = CANTP_PADDING_BYTE;
+
+    return CanSM_TransmitFdGather(&frame);
+}
+
+/**
+ * @brief   Send the single frame or first frame of the pending transfer
+ */
+static Std_ReturnType CanTp_SendFirstFrame(uint8 ConnectionId)
+{
+    const CanTp_ConnectionConfigType *cfg = &CanTp_ConnectionConfig[ConnectionId];
+    CanTp_ConnectionType *conn = &CanTp_Connections[ConnectionId];
+    uint8 pci[6];
+    uint8 pciLength;
+    uint8 payloadLength;
+    uint32 sfMax = (cfg->txDl <= CANTP_CLASSIC_DL) ? 7u : (uint32)cfg->txDl - 2u;
+    boolean isSingle = (conn->txLength <= sfMax) ? TRUE : FALSE;
+
+    if (isSingle == TRUE)
+    {
+        if (conn->txLength <= 7u)
+        {
+            pci[0] = (uint8)(CANTP_PCI_SF | conn->txLength);
+            pciLength = 1u;
+        }
+        else
+        {
+            pci[0] = CANTP_PCI_SF;
+            pci[1] = (uint8)conn->txLength;
+            pciLength = 2u;
+        }
+        payloadLength = (uint8)conn->txLength;
+    }
+    else if (conn->txLength <= CANTP_FF_SHORT_MAX_LENGTH)
+    {
+        pci[0] = (uint8)(CANTP_PCI_FF | (conn->txLength >> 8));
+        pci[1] = (uint8)(conn->txLength & 0xFFu);
+        pciLength = 2u;
+        payloadLength = (uint8)(cfg->txDl - pciLength);
+    }
+    else
+    {
+        pci[0] = CANTP_PCI_FF;
+        pci[1] = 0u;
+        pci[2] = (uint8)(conn->txLength >> 24);
+        pci[3] = (uint8)(conn->txLength >> 16);
+        pci[4] = (uint8)(conn->txLength >> 8);
+        pci[5] = (uint8)(conn->txLength & 0xFFu);
+        pciLength = 6u;
+        payloadLength = (uint8)(cfg->txDl - pciLength);
+    }
+
+    if (CanTp_SendFrame(ConnectionId, pci, pciLength, conn->txData, payloadLength) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    if (isSingle == TRUE)
+    {
+        CanTp_TxFinish(ConnectionId, E_OK);
+    }
+    else
+    {
+        conn->txOffset = payloadLength;
+        conn->txTimer = CANTP_N_BS_TICKS;
+        conn->txState = CANTP_TX_WAIT_FC;
+    }
+    return E_OK;
+}
+
+/**
+ * @brief   Send the next consecutive frame of the pending transfer
+ */
+static Std_ReturnType CanTp_SendConsecutiveFrame(uint8 ConnectionId)
+{
+    const CanTp_ConnectionConfigType *cfg = &CanTp_ConnectionConfig[ConnectionId];
+    CanTp_ConnectionType *conn = &CanTp_Connections[ConnectionId];
+    uint8 pci = (uint8)(CANTP_PCI_CF | conn->txSn);
+    uint32 remaining = conn->txLength - conn->txOffset;
+    uint8 payloadLength = (uint8)(cfg->txDl - 1u);
+
+    if (remaining < payloadLength)
+    {
+        payloadLength = (uint8)remaining;
+    }
+
+    if (CanTp_SendFrame(ConnectionId, &pci, 1u, &conn->txData[conn->txOffset], payloadLength) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    conn->txOffset += payloadLength;
+    conn->txSn = (uint8)((conn->txSn + 1u) & 0x0Fu);
+
+    if (conn->txOffset >= conn->txLength)
+    {
+        CanTp_TxFinish(ConnectionId, E_OK);
+    }
+    else if (conn->txBlockSize != 0u)
+    {
+        conn->txBlockCount++;
+        if (conn->txBlockCount >= conn->txBlockSize)
+        {
+            conn->txBlockCount = 0u;
+            conn->txTimer = CANTP_N_BS_TICKS;
+            conn->txState = CANTP_TX_WAIT_FC;
+        }
+    }
+    return E_OK;
+}
+
+/**
+ * @brief   Send the pending flow control frame of a connection
+ */
+static void CanTp_SendFlowControl(uint8 ConnectionId)
+{
+    const CanTp_ConnectionConfigType *cfg = &CanTp_ConnectionConfig[ConnectionId];
+    CanTp_ConnectionType *conn = &CanTp_Connections[ConnectionId];
+    uint8 pci[3];
+
+    pci[0] = (uint8)(CANTP_PCI_FC | conn->rxFcPending);
+    pci[1] = cfg->blockSize;
+    pci[2] = cfg->stMin;
+
+    if (CanTp_SendFrame(ConnectionId, pci, 3u, NULL_PTR, 0u) == E_OK)
+    {
+        conn->rxFcPending = CANTP_FS_NONE;
+    }
+}
+
+/**
+ * @brief   Terminate the transmit side of a connection and notify the user
+ */
+static void CanTp_TxFinish(uint8 ConnectionId, Std_ReturnType Result)
+{
+    CanTp_ConnectionType *conn = &CanTp_Connections[ConnectionId];
+
+    conn->txState = CANTP_TX_IDLE;
+    conn->txData = NULL_PTR;
+
+    if (conn->txConfirmation != NULL_PTR)
+    {
+        conn->txConfirmation(ConnectionId, Result);
+    }
+}
+
+/**
+ * @brief   Terminate the receive side of a connection and notify the user
+ */
+static void CanTp_RxFinish(uint8 ConnectionId, Std_ReturnType Result)
+{
+    CanTp_ConnectionType *conn = &CanTp_Connections[ConnectionId];
+
+    conn->rxState = CANTP_RX_IDLE;
+
+    if (conn->rxIndication != NULL_PTR)
+    {
+        conn->rxIndication(ConnectionId, conn->rxBuffer, conn->rxOffset, Result);
+    }
+}
+
+/**
+ * @brief   Handle a received single frame or first frame
+ */
+static void CanTp_RxFirstOrSingle(uint8 ConnectionId, const CanSM_FdFrameType *frame,
+                                  uint32 length, uint8 offset, boolean isFirstFrame)
+{
+    CanTp_ConnectionType *conn = &CanTp_Connections[ConnectionId];
+    uint32 available = (uint32)frame->length - offset;
+    uint32 copyLength;
+
+    if (length == 0u || offset >= frame->length)
+    {
+        return;
+    }
+    if (isFirstFrame == FALSE && length > available)
+    {
+        return;
+    }
+    if (isFirstFrame == TRUE && length <= available)
+    {
+        /* A first frame must announce more than it carries */
+        return;
+    }
+
+    /* A new SF or FF terminates a reception in progress */
+    if (conn->rxState == CANTP_RX_RECEIVING)
+    {
+        CanTp_RxFinish(ConnectionId, E_NOT_OK);
+    }
+
+    if (conn->rxBuffer == NULL_PTR || length > conn->rxBufferSize)
+    {
+        Det_ReportRuntimeError(CANTP_MODULE_ID, ConnectionId, CANTP_RX_INDICATION_SID, CANTP_E_RX_OVERFLOW);
+        if (isFirstFrame == TRUE)
+        {
+            conn->rxFcPending = CANTP_FS_OVFLW;
+            CanTp_SendFlowControl(ConnectionId);
+        }
+        return;
+    }
+
+    copyLength = (isFirstFrame == TRUE) ? available : length;
+    (void)memcpy(conn->rxBuffer, &frame->data[offset], copyLength);
+    conn->rxLength = length;
+    conn->rxOffset = copyLength;
+
+    if (isFirstFrame == FALSE)
+    {
+        CanTp_RxFinish(ConnectionId, E_OK);
+        return;
+    }
+
+    conn->rxSn = 1u;
+    conn->rxBlockCount = 0u;
+    conn->rxTimer = CANTP_N_CR_TICKS;
+    conn->rxState = CANTP_RX_RECEIVING;
+    conn->rxFcPending = CANTP_FS_CTS;
+    CanTp_SendFlowControl(ConnectionId);
+}
+
+/**
+ * @brief   Handle a received consecutive frame
+ */
+static void CanTp_RxConsecutive(uint8 ConnectionId, const CanSM_FdFrameType *frame)
+{
+    const CanTp_ConnectionConfigType *cfg = &CanTp_ConnectionConfig[ConnectionId];
+    CanTp_ConnectionType *conn = &CanTp_Connections[ConnectionId];
+    uint32 copyLength = (uint32)frame->length - 1u;
+    uint32 remaining;
+
+    if (conn->rxState != CANTP_RX_RECEIVING)
+    {
+        return;
+    }
+    if ((frame->data[0] & 0x0Fu) != conn->rxSn)
+    {
+        Det_ReportRuntimeError(CANTP_MODULE_ID, ConnectionId, CANTP_RX_INDICATION_SID, CANTP_E_INVALID_SN);
+        CanTp_RxFinish(ConnectionId, E_NOT_OK);
+        return;
+    }
+
+    remaining = conn->rxLength - conn->rxOffset;
+    if (copyLength > remaining)
+    {
+        copyLength = remaining;
+    }
+    (void)memcpy(&conn->rxBuffer[conn->rxOffset], &frame->data[1], copyLength);
+    conn->rxOffset += copyLength;
+    conn->rxSn = (uint8)((conn->rxSn + 1u) & 0x0Fu);
+    conn->rxTimer = CANTP_N_CR_TICKS;
+
+    if (conn->rxOffset >= conn->rxLength)
+    {
+        CanTp_RxFinish(ConnectionId, E_OK);
+    }
+    else if (cfg->blockSize != 0u)
+    {
+        conn->rxBlockCount++;
+        if (conn->rxBlockCount >= cfg->blockSize)
+        {
+            conn->rxBlockCount = 0u;
+            conn->rxFcPending = CANTP_FS_CTS;
+            CanTp_SendFlowControl(ConnectionId);
+        }
+    }
+}
+
+/**
+ * @brief   Handle a received flow control frame
+ */
+static void CanTp_RxFlowControl(uint8 ConnectionId, const CanSM_FdFrameType *frame)
+{
+    CanTp_ConnectionType *conn = &CanTp_Connections[ConnectionId];
+
+    if (conn->txState != CANTP_TX_WAIT_FC || frame->length < 3u)
+    {
+        return;
+    }
+
+    switch (frame->data[0] & 0x0Fu)
+    {
+        case CANTP_FS_CTS:
+            conn->txBlockSize = frame->data[1];
+            conn->txBlockCount = 0u;
+            conn->txStMinTicks = CanTp_StMinToTicks(frame->data[2]);
+            conn->txStMinTimer = 0u;
+            conn->txState = CANTP_TX_SEND_CF;
+            break;
+
+        case CANTP_FS_WAIT:
+            conn->txTimer = CANTP_N_BS_TICKS;
+            break;
+
+        default:
+            /* Overflow or invalid flow status aborts the transfer */
+            CanTp_TxFinish(ConnectionId, E_NOT_OK);
+            break;
+    }
+}
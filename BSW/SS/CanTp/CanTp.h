@@ -0,0 +1,116 @@
+/*
+ * CanTp.h - AUTOSAR CAN Transport Layer Interface
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface definition for the
+ *              ISO 15765-2 transport protocol over CAN-FD
+ */
+
+#ifndef CANTP_H
+#define CANTP_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "CanSM.h"
+#include "CanTp_Cfg.h"
+
+/* AUTOSAR Version information */
+#define CANTP_VENDOR_ID                    (0x1234)
+#define CANTP_MODULE_ID                    (0x0023)
+#define CANTP_AR_RELEASE_MAJOR_VERSION     (4)
+#define CANTP_AR_RELEASE_MINOR_VERSION     (4)
+#define CANTP_AR_RELEASE_REVISION_VERSION  (0)
+#define CANTP_SW_MAJOR_VERSION             (1)
+#define CANTP_SW_MINOR_VERSION             (0)
+#define CANTP_SW_PATCH_VERSION             (0)
+
+/* Check AUTOSAR version compatibility */
+#if ((STD_AR_RELEASE_MAJOR_VERSION != CANTP_AR_RELEASE_MAJOR_VERSION) || \
+     (STD_AR_RELEASE_MINOR_VERSION != CANTP_AR_RELEASE_MINOR_VERSION))
+#error "AUTOSAR version mismatch between CanTp.h and Std_Types.h"
+#endif
+
+/* API service IDs */
+#define CANTP_INIT_SID                     (0x01u)
+#define CANTP_TRANSMIT_SID                 (0x49u)
+#define CANTP_SET_RX_BUFFER_SID            (0x4Au)
+#define CANTP_REGISTER_CALLBACKS_SID       (0x4Bu)
+#define CANTP_RX_INDICATION_SID            (0x42u)
+#define CANTP_MAIN_FUNCTION_SID            (0x06u)
+#define CANTP_GET_VERSION_INFO_SID         (0x07u)
+
+/* Error codes */
+#define CANTP_E_PARAM_ID                   (0x02u)
+#define CANTP_E_PARAM_POINTER              (0x03u)
+#define CANTP_E_UNINIT                     (0x20u)
+#define CANTP_E_INVALID_TX_LENGTH          (0x90u)
+#define CANTP_E_TX_BUSY                    (0x91u)
+
+/* Runtime error codes (reported through Det_ReportRuntimeError) */
+#define CANTP_E_RX_TIMEOUT_CR              (0x30u)
+#define CANTP_E_TX_TIMEOUT_BS              (0x31u)
+#define CANTP_E_INVALID_SN                 (0x32u)
+#define CANTP_E_RX_OVERFLOW                (0x33u)
+
+/* Largest payload an ISO 15765-2 escaped first frame can announce */
+#define CANTP_MAX_MESSAGE_LENGTH           (0xFFFFFFFFu)
+
+/* Transfer completion callbacks */
+typedef void (*CanTp_TxConfirmationType)(uint8 ConnectionId, Std_ReturnType Result);
+typedef void (*CanTp_RxIndicationType)(uint8 ConnectionId, const uint8 *Data,
+                                       uint32 Length, Std_ReturnType Result);
+
+/* Function prototypes */
+
+/**
+ * @brief   Initialize the CAN Transport Layer
+ */
+void CanTp_Init(void);
+
+/**
+ * @brief   Start a segmented or unsegmented transmission
+ * @details Data is not buffered by CanTp: each segment is read from it
+ *          when its frame is built, so the buffer must stay valid until
+ *          the TX confirmation for ConnectionId is called.
+ * @param   ConnectionId  Index into CanTp_ConnectionConfig
+ * @param   Data          Payload to send
+ * @param   Length        Payload length in bytes
+ * @return  E_OK if the transfer was accepted
+ */
+Std_ReturnType CanTp_Transmit(uint8 ConnectionId, const uint8 *Data, uint32 Length);
+
+/**
+ * @brief   Provide the reassembly buffer for a connection
+ * @details Received segments are written directly into Buffer. A first
+ *          frame announcing more than Size bytes is rejected with an
+ *          overflow flow control.
+ */
+Std_ReturnType CanTp_SetRxBuffer(uint8 ConnectionId, uint8 *Buffer, uint32 Size);
+
+/**
+ * @brief   Register completion callbacks for a connection
+ */
+void CanTp_RegisterCallbacks(uint8 ConnectionId, CanTp_TxConfirmationType TxConfirmation,
+                             CanTp_RxIndicationType RxIndication);
+
+/**
+ * @brief   Hand a received CAN-FD frame to the transport layer
+ * @details Frames whose identifier is not a configured RX identifier are
+ *          ignored, so the caller may pass every received frame.
+ */
+void CanTp_RxIndication(const CanSM_FdFrameType *frame);
+
+/**
+ * @brief   Periodic processing (consecutive frames, flow control, timeouts)
+ * @details Must be called every CANTP_MAIN_FUNCTION_PERIOD_MS.
+ */
+void CanTp_MainFunction(void);
+
+/**
+ * @brief   Get version information
+ */
+void CanTp_GetVersionInfo(Std_VersionInfoType *versioninfo);
+
+#endif /* CANTP_H */
@@ -0,0 +1,23 @@
+/*
+ * CanTp_Cfg.c - AUTOSAR CAN Transport Layer Configuration Data
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the connection table of the
+ *              CAN Transport Layer module for Infineon TC377
+ */
+
+#include "CanTp_Cfg.h"
+
+/* Connection configurations */
+const CanTp_ConnectionConfigType CanTp_ConnectionConfig[CANTP_MAX_CONNECTIONS] = {
+    /* Diagnostic request/response */
+    {0x7E8u, 0x7E0u, 64u, TRUE, 0u, 0u},
+    /* Calibration download */
+    {0x608u, 0x600u, 64u, TRUE, 16u, 0u},
+    /* Trace upload */
+    {0x618u, 0x610u, 64u, TRUE, 0u, 0u},
+    /* ECU2 bulk link */
+    {0x628u, 0x620u, 64u, TRUE, 8u, 1u}
+};
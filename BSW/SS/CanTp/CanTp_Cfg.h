@@ -0,0 +1,51 @@
+/*
+ * CanTp_Cfg.h - AUTOSAR CAN Transport Layer Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the configuration definitions for the
+ *              CAN Transport Layer module for Infineon TC377
+ */
+
+#ifndef CANTP_CFG_H
+#define CANTP_CFG_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+
+/* Number of configured connections */
+#define CANTP_MAX_CONNECTIONS              (4u)
+
+/* Connection identifiers */
+#define CANTP_CONN_DIAG                    (0u)
+#define CANTP_CONN_CALIBRATION             (1u)
+#define CANTP_CONN_TRACE                   (2u)
+#define CANTP_CONN_ECU2                    (3u)
+
+/* Period of CanTp_MainFunction */
+#define CANTP_MAIN_FUNCTION_PERIOD_MS      (1u)
+
+/* Value used to fill unused bytes of a frame up to the next valid DLC */
+#define CANTP_PADDING_BYTE                 (0xCCu)
+
+/* N_Bs: time to wait for a flow control frame */
+#define CANTP_N_BS_TIMEOUT_MS              (1000u)
+
+/* N_Cr: time to wait for the next consecutive frame */
+#define CANTP_N_CR_TIMEOUT_MS              (1000u)
+
+/* Connection configuration */
+typedef struct {
+    uint32 txId;        /* CAN ID used for outgoing SF/FF/CF and FC */
+    uint32 rxId;        /* CAN ID of incoming frames */
+    uint8 txDl;         /* Transmit data link layer length: 8 (classic) or 12..64 (FD) */
+    boolean brs;        /* Bit Rate Switch for outgoing frames */
+    uint8 blockSize;    /* BS announced in our flow control (0 = no further FC) */
+    uint8 stMin;        /* STmin announced in our flow control (ISO encoding) */
+} CanTp_ConnectionConfigType;
+
+/* Connection configurations (CanTp_Cfg.c) */
+extern const CanTp_ConnectionConfigType CanTp_ConnectionConfig[CANTP_MAX_CONNECTIONS];
+
+#endif /* CANTP_CFG_H */
@@ -5,11 +5,20 @@
  * Author: BSW Team
  *
  * Description: This file contains the implementation of the
- *              Communication Manager module for Infineon TC377
+ *              Communication Manager module for Infineon TC377.
+ *              A request stores the requested mode and, for the first
+ *              request of a switch, its time. ComM_MainFunction takes the
+ *              latest mode of each channel with a request pending and hands
+ *              it to the bus state manager, so a burst of requests costs one
+ *              switch. Requests arriving while a switch is under way start
+ *              the next one.
  */
 
 #include "ComM.h"
 #include "Det.h"
+#include "SwTmr.h"
+#include "Tm.h"
+#include "BSWM.h"
 
 /* Internal variables */
 static boolean ComM_Initialized = FALSE;
@@ -19,9 +28,47 @@ typedef struct {
     uint8 currentMode;
     uint8 requestedMode;
     boolean isActive;
+    boolean requestPending;     /* requestedMode not yet taken by the main function */
+    boolean switchPending;      /* Handed to the bus state manager, not yet indicated */
+    uint32 requestTick;         /* First request since the main function took the last */
+    uint32 switchTick;          /* First request of the switch under way */
 } ComM_ChannelType;
 
 static ComM_ChannelType ComM_Channels[COMM_MAX_CHANNELS];
+static ComM_StatisticsType ComM_Statistics[COMM_MAX_CHANNELS];
+
+/* Release timeouts, one per channel */
+static SwTmr_TimerType ComM_ReleaseTimers[COMM_MAX_CHANNELS];
+
+/**
+ * @brief   Record a mode request, replacing one not yet served
+ */
+static void ComM_PostRequest(uint8 Channel, uint8 RequestedMode)
+{
+    ComM_ChannelType *channel = &ComM_Channels[Channel];
+    
+    COMM_ENTER_CRITICAL();
+    if (channel->requestPending == TRUE)
+    {
+        ComM_Statistics[Channel].coalesced++;
+    }
+    else
+    {
+        channel->requestTick = Tm_GetTicks32();
+        channel->requestPending = TRUE;
+    }
+    channel->requestedMode = RequestedMode;
+    ComM_Statistics[Channel].requests++;
+    COMM_EXIT_CRITICAL();
+}
+
+/**
+ * @brief   Release timeout of a channel expired, drop its communication
+ */
+static void ComM_ReleaseTimeout(uint32 Channel)
+{
+    ComM_PostRequest((uint8)Channel, COMM_NO_COMMUNICATION);
+}
 
 /**
  * @brief   Initialize the Communication Manager module
@@ -36,6 +83,9 @@ void ComM_Init(void)
             ComM_Channels[i].currentMode = COMM_NO_COMMUNICATION;
             ComM_Channels[i].requestedMode = COMM_NO_COMMUNICATION;
             ComM_Channels[i].isActive = FALSE;
+            ComM_Channels[i].requestPending = FALSE;
+            ComM_Channels[i].switchPending = FALSE;
+            SwTmr_Setup(&ComM_ReleaseTimers[i], ComM_ReleaseTimeout, i);
         }
         
         ComM_Initialized = TRUE;
@@ -57,7 +107,8 @@ Std_ReturnType ComM_RequestComMode(uint8 Channel, uint8 RequestedMode)
     {
         if (RequestedMode <= COMM_FULL_COMMUNICATION)
         {
-            ComM_Channels[Channel].requestedMode = RequestedMode;
+            SwTmr_Stop(&ComM_ReleaseTimers[Channel]);
+            ComM_PostRequest(Channel, RequestedMode);
             retVal = E_OK;
         }
         else
@@ -82,8 +133,16 @@ Std_ReturnType ComM_ReleaseComMode(uint8 Channel)
     
     if (Channel < COMM_MAX_CHANNELS)
     {
-        ComM_Channels[Channel].requestedMode = COMM_NO_COMMUNICATION;
-        retVal = E_OK;
+        if (ComM_ChannelConfig[Channel].timeoutMs > 0u)
+        {
+            retVal = SwTmr_Start(&ComM_ReleaseTimers[Channel],
+                                 ComM_ChannelConfig[Channel].timeoutMs / SWTMR_TICK_MS, 0u);
+        }
+        else
+        {
+            ComM_PostRequest(Channel, COMM_NO_COMMUNICATION);
+            retVal = E_OK;
+        }
     }
     else
     {
@@ -93,6 +152,139 @@ Std_ReturnType ComM_ReleaseComMode(uint8 Channel)
     return retVal;
 }
 
+/**
+ * @brief   Forward the pending mode requests to the bus state managers
+ */
+void ComM_MainFunction(void)
+{
+    ComM_ChannelType *channel;
+    ComM_BusSmRequestType busSmRequest;
+    boolean pending;
+    uint8 mode;
+    
+    if (ComM_Initialized == FALSE)
+    {
+        Det_ReportError(COMM_MODULE_ID, 0, COMM_MAIN_FUNCTION_SID, COMM_E_UNINIT);
+        return;
+    }
+    
+    for (uint8 i = 0; i < COMM_MAX_CHANNELS; i++)
+    {
+        channel = &ComM_Channels[i];
+        
+        COMM_ENTER_CRITICAL();
+        pending = channel->requestPending;
+        mode = channel->requestedMode;
+        channel->requestPending = FALSE;
+        if (pending == TRUE)
+        {
+            channel->switchTick = channel->requestTick;
+        }
+        COMM_EXIT_CRITICAL();
+        
+        if (pending == FALSE)
+        {
+            continue;
+        }
+        
+        channel->switchPending = TRUE;
+        busSmRequest = ComM_ChannelConfig[i].busSmRequest;
+        if (busSmRequest == NULL_PTR)
+        {
+            /* No bus state manager, the switch is immediate */
+            ComM_BusSM_ModeIndication(i, mode);
+        }
+        else if (busSmRequest(mode) != E_OK)
+        {
+            /* Rejected, complete the request with the mode kept */
+            ComM_BusSM_ModeIndication(i, channel->currentMode);
+        }
+        else
+        {
+            /* Completed by the indication of the bus state manager */
+        }
+    }
+}
+
+/**
+ * @brief   Mode switch of a channel confirmed by its bus state manager
+ */
+void ComM_BusSM_ModeIndication(uint8 Channel, uint8 ComMode)
+{
+    ComM_StatisticsType *statistics;
+    uint32 latency;
+    
+    if (Channel >= COMM_MAX_CHANNELS || ComMode > COMM_FULL_COMMUNICATION)
+    {
+        Det_ReportError(COMM_MODULE_ID, 0, COMM_BUSSM_MODE_INDICATION_SID, DET_E_PARAM_INVALID);
+        return;
+    }
+    
+    ComM_Channels[Channel].currentMode = ComMode;
+    if (ComM_Channels[Channel].switchPending == TRUE)
+    {
+        ComM_Channels[Channel].switchPending = FALSE;
+        statistics = &ComM_Statistics[Channel];
+        latency = Tm_GetTicks32() - ComM_Channels[Channel].switchTick;
+        statistics->switches++;
+        statistics->lastLatency = latency;
+        if (latency > statistics->maxLatency)
+        {
+            statistics->maxLatency = latency;
+        }
+    }
+    
+    COMM_MODE_INDICATION(Channel, ComMode);
+}
+
+/**
+ * @brief   Get the current communication mode of a channel
+ */
+Std_ReturnType ComM_GetCurrentComMode(uint8 Channel, uint8 *ComMode)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    
+    if (Channel >= COMM_MAX_CHANNELS)
+    {
+        Det_ReportError(COMM_MODULE_ID, 0, COMM_GET_CURRENT_COMM_SID, DET_E_PARAM_INVALID);
+    }
+    else if (ComMode == NULL_PTR)
+    {
+        Det_ReportError(COMM_MODULE_ID, 0, COMM_GET_CURRENT_COMM_SID, DET_E_PARAM_POINTER);
+    }
+    else
+    {
+        *ComMode = ComM_Channels[Channel].currentMode;
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief   Get the mode request statistics of a channel
+ */
+Std_ReturnType ComM_GetStatistics(uint8 Channel, ComM_StatisticsType *statistics)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    
+    if (Channel >= COMM_MAX_CHANNELS)
+    {
+        Det_ReportError(COMM_MODULE_ID, 0, COMM_GET_STATISTICS_SID, DET_E_PARAM_INVALID);
+    }
+    else if (statistics == NULL_PTR)
+    {
+        Det_ReportError(COMM_MODULE_ID, 0, COMM_GET_STATISTICS_SID, DET_E_PARAM_POINTER);
+    }
+    else
+    {
+        *statistics = ComM_Statistics[Channel];
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
 /**
  * @brief   Get version information
  */
@@ -13,6 +13,7 @@
 
 /* Include AUTOSAR standard types */
 #include "Std_Types.h"
+#include "ComM_Cfg.h"
 
 /* AUTOSAR Version information */
 #define COMM_VENDOR_ID                    (0x1234)
@@ -35,6 +36,23 @@
 #define COMM_REQUEST_COMM_SID             (0x01u)
 #define COMM_RELEASE_COMM_SID             (0x02u)
 #define COMM_GET_VERSION_INFO_SID         (0x03u)
+#define COMM_GET_CURRENT_COMM_SID         (0x04u)
+#define COMM_MAIN_FUNCTION_SID            (0x05u)
+#define COMM_BUSSM_MODE_INDICATION_SID    (0x06u)
+#define COMM_GET_STATISTICS_SID           (0x07u)
+
+/* Error codes */
+#define COMM_E_UNINIT                     (0x10u)
+
+/* Mode request statistics of a channel; latencies in Tm ticks from the
+ * first request of a switch to its indication */
+typedef struct {
+    uint32 requests;
+    uint32 coalesced;          /* Requests replaced before they were served */
+    uint32 switches;           /* Completed mode switches */
+    uint32 lastLatency;
+    uint32 maxLatency;
+} ComM_StatisticsType;
 
 /* Function prototypes */
 
@@ -45,14 +63,44 @@ void ComM_Init(void);
 
 /**
  * @brief   Request communication mode for a channel
+ * @details The request is only recorded, in constant time; the latest
+ *          request per channel replaces any earlier one not yet served.
+ *          The next ComM_MainFunction forwards it to the bus state
+ *          manager, and COMM_MODE_INDICATION reports the switch.
  */
 Std_ReturnType ComM_RequestComMode(uint8 Channel, uint8 RequestedMode);
 
 /**
  * @brief   Release communication mode for a channel
+ * @details The channel keeps its current mode for the timeoutMs of its
+ *          configuration, then falls back to COMM_NO_COMMUNICATION. A new
+ *          request within that time cancels the fall-back.
  */
 Std_ReturnType ComM_ReleaseComMode(uint8 Channel);
 
+/**
+ * @brief   Forward the pending mode requests to the bus state managers
+ * @details Runs from the 1 ms tick, after BSWM_MainFunction and before the
+ *          bus state manager main functions, so a request completes within
+ *          one pass.
+ */
+void ComM_MainFunction(void);
+
+/**
+ * @brief   Mode switch of a channel confirmed by its bus state manager
+ */
+void ComM_BusSM_ModeIndication(uint8 Channel, uint8 ComMode);
+
+/**
+ * @brief   Get the current communication mode of a channel
+ */
+Std_ReturnType ComM_GetCurrentComMode(uint8 Channel, uint8 *ComMode);
+
+/**
+ * @brief   Get the mode request statistics of a channel
+ */
+Std_ReturnType ComM_GetStatistics(uint8 Channel, ComM_StatisticsType *statistics);
+
 /**
  * @brief   Get version information
  */
@@ -0,0 +1,24 @@
+/*
+ * ComM_Cfg.c - AUTOSAR Communication Manager Configuration Data
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the channel table of the
+ *              Communication Manager module for Infineon TC377
+ */
+
+#include "ComM_Cfg.h"
+#include "CanSM.h"
+
+/* Channel configurations */
+const ComM_ChannelConfigType ComM_ChannelConfig[COMM_MAX_CHANNELS] = {
+    /* CAN channel */
+    {COMM_FULL_COMMUNICATION, 1000, TRUE, CanSM_RequestComMode},
+    /* LIN channel */
+    {COMM_SILENT_COMMUNICATION, 500, FALSE, NULL_PTR},
+    /* FR channel */
+    {COMM_NO_COMMUNICATION, 0, FALSE, NULL_PTR},
+    /* ETH channel */
+    {COMM_FULL_COMMUNICATION, 2000, TRUE, NULL_PTR}
+};
@@ -28,23 +28,36 @@
 #define COMM_CHANNEL_FR              (2u)
 #define COMM_CHANNEL_ETH             (3u)
 
+/* Period of ComM_MainFunction (1 ms system tick, GPT channel 0) */
+#define COMM_MAIN_FUNCTION_PERIOD_MS (1u)
+
+/* Mode request of the bus state manager of a channel; the bus state
+ * manager confirms through ComM_BusSM_ModeIndication */
+typedef Std_ReturnType (*ComM_BusSmRequestType)(uint8 ComMode);
+
 /* Configuration structure */
 typedef struct {
     uint8 defaultMode;
     uint16 timeoutMs;
     boolean wakeupSupport;
+    ComM_BusSmRequestType busSmRequest;   /* NULL_PTR: switched by ComM alone */
 } ComM_ChannelConfigType;
 
-/* Channel configurations */
-const ComM_ChannelConfigType ComM_ChannelConfig[COMM_MAX_CHANNELS] = {
-    /* CAN channel */
-    {COMM_FULL_COMMUNICATION, 1000, TRUE},
-    /* LIN channel */
-    {COMM_SILENT_COMMUNICATION, 500, FALSE},
-    /* FR channel */
-    {COMM_NO_COMMUNICATION, 0, FALSE},
-    /* ETH channel */
-    {COMM_FULL_COMMUNICATION, 2000, TRUE}
-};
+/* Mode switch completed on a channel (BswM notification) */
+#define COMM_MODE_INDICATION(Channel, ComMode)  BSWM_ComM_CurrentMode((Channel), (ComMode))
+
+/* Requests from outside the tick lock the tick notification; the host
+ * simulation runs requests and the tick in one context */
+#if defined(HOST_SIM)
+#define COMM_ENTER_CRITICAL()
+#define COMM_EXIT_CRITICAL()
+#else
+#include "Gpt.h"
+#define COMM_ENTER_CRITICAL()        Gpt_DisableNotification(GPT_CHANNEL_0)
+#define COMM_EXIT_CRITICAL()         Gpt_EnableNotification(GPT_CHANNEL_0)
+#endif
+
+/* Channel configurations (ComM_Cfg.c) */
+extern const ComM_ChannelConfigType ComM_ChannelConfig[COMM_MAX_CHANNELS];
 
 #endif /* COMM_CFG_H */
\ No newline at end of file
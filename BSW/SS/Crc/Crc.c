@@ -0,0 +1,118 @@
+/*
+ * Crc.c - AUTOSAR CRC Library Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the CRC calculation for Infineon TC377.
+ *              The method of each width is selected in Crc_Cfg.h at compile
+ *              time. Slice-by-4 runs the reflected CRC32 over four bytes
+ *              per step with four table lookups, reading the data a byte at
+ *              a time so it needs no alignment.
+ */
+
+#include "Crc.h"
+
+/**
+ * @brief CRC8 SAE J1850
+ */
+uint8 Crc_CalculateCRC8(const uint8 *Crc_DataPtr, uint32 Crc_Length, uint8 Crc_StartValue8,
+                        boolean Crc_IsFirstCall)
+{
+    uint8 crc = (Crc_IsFirstCall == TRUE) ? CRC_INITIAL_VALUE8 : (uint8)(Crc_StartValue8 ^ CRC_XOR_VALUE8);
+
+    for (uint32 i = 0; i < Crc_Length; i++)
+    {
+#if (CRC_8_MODE == CRC_TABLE)
+        crc = Crc_Table8[crc ^ Crc_DataPtr[i]];
+#else
+        crc ^= Crc_DataPtr[i];
+        for (uint32 bit = 0; bit < 8u; bit++)
+        {
+            crc = ((crc & 0x80u) != 0u) ? (uint8)((crc << 1) ^ CRC_8_POLYNOMIAL) : (uint8)(crc << 1);
+        }
+#endif
+    }
+    return (uint8)(crc ^ CRC_XOR_VALUE8);
+}
+
+/**
+ * @brief CRC8H2F
+ */
+uint8 Crc_CalculateCRC8H2F(const uint8 *Crc_DataPtr, uint32 Crc_Length, uint8 Crc_StartValue8H2F,
+                           boolean Crc_IsFirstCall)
+{
+    uint8 crc = (Crc_IsFirstCall == TRUE) ? CRC_INITIAL_VALUE8H2F :
+                                            (uint8)(Crc_StartValue8H2F ^ CRC_XOR_VALUE8H2F);
+
+    for (uint32 i = 0; i < Crc_Length; i++)
+    {
+#if (CRC_8H2F_MODE == CRC_TABLE)
+        crc = Crc_Table8H2F[crc ^ Crc_DataPtr[i]];
+#else
+        crc ^= Crc_DataPtr[i];
+        for (uint32 bit = 0; bit < 8u; bit++)
+        {
+            crc = ((crc & 0x80u) != 0u) ? (uint8)((crc << 1) ^ CRC_8H2F_POLYNOMIAL) : (uint8)(crc << 1);
+        }
+#endif
+    }
+    return (uint8)(crc ^ CRC_XOR_VALUE8H2F);
+}
+
+/**
+ * @brief CRC16 CCITT-FALSE
+ */
+uint16 Crc_CalculateCRC16(const uint8 *Crc_DataPtr, uint32 Crc_Length, uint16 Crc_StartValue16,
+                          boolean Crc_IsFirstCall)
+{
+    uint16 crc = (Crc_IsFirstCall == TRUE) ? CRC_INITIAL_VALUE16 : Crc_StartValue16;
+
+    for (uint32 i = 0; i < Crc_Length; i++)
+    {
+#if (CRC_16_MODE == CRC_TABLE)
+        crc = (uint16)((crc << 8) ^ Crc_Table16[(uint8)((crc >> 8) ^ Crc_DataPtr[i])]);
+#else
+        crc ^= (uint16)((uint16)Crc_DataPtr[i] << 8);
+        for (uint32 bit = 0; bit < 8u; bit++)
+        {
+            crc = ((crc & 0x8000u) != 0u) ? (uint16)((crc << 1) ^ CRC_16_POLYNOMIAL) : (uint16)(crc << 1);
+        }
+#endif
+    }
+    return crc;
+}
+
+/**
+ * @brief CRC32 IEEE 802.3
+ */
+uint32 Crc_CalculateCRC32(const uint8 *Crc_DataPtr, uint32 Crc_Length, uint32 Crc_StartValue32,
+                          boolean Crc_IsFirstCall)
+{
+    uint32 crc = (Crc_IsFirstCall == TRUE) ? CRC_INITIAL_VALUE32 : (Crc_StartValue32 ^ CRC_XOR_VALUE32);
+    uint32 i = 0u;
+
+#if (CRC_32_MODE == CRC_SLICE_BY_4)
+    for (; i + 4u <= Crc_Length; i += 4u)
+    {
+        crc ^= (uint32)Crc_DataPtr[i] | ((uint32)Crc_DataPtr[i + 1u] << 8) |
+               ((uint32)Crc_DataPtr[i + 2u] << 16) | ((uint32)Crc_DataPtr[i + 3u] << 24);
+        crc = Crc_Table32[3][crc & 0xFFu] ^ Crc_Table32[2][(crc >> 8) & 0xFFu] ^
+              Crc_Table32[1][(crc >> 16) & 0xFFu] ^ Crc_Table32[0][crc >> 24];
+    }
+#endif
+
+    for (; i < Crc_Length; i++)
+    {
+#if (CRC_32_MODE == CRC_RUNTIME)
+        crc ^= Crc_DataPtr[i];
+        for (uint32 bit = 0; bit < 8u; bit++)
+        {
+            crc = ((crc & 1u) != 0u) ? ((crc >> 1) ^ CRC_32_POLYNOMIAL_REFLECTED) : (crc >> 1);
+        }
+#else
+        crc = (crc >> 8) ^ Crc_Table32[0][(crc ^ Crc_DataPtr[i]) & 0xFFu];
+#endif
+    }
+    return crc ^ CRC_XOR_VALUE32;
+}
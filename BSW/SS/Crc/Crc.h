@@ -0,0 +1,68 @@
+/*
+ * Crc.h - AUTOSAR CRC Library Interface
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface of the CRC library for
+ *              Infineon TC377. The functions are reentrant and need no
+ *              initialization. A CRC over several buffers is calculated in
+ *              calls with Crc_IsFirstCall FALSE after the first, each given
+ *              the result of the previous call as start value.
+ */
+
+#ifndef CRC_H
+#define CRC_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "Crc_Cfg.h"
+
+/* AUTOSAR Version information */
+#define CRC_VENDOR_ID                    (0x1234)
+#define CRC_MODULE_ID                    (0x00C9)
+#define CRC_AR_RELEASE_MAJOR_VERSION     (4)
+#define CRC_AR_RELEASE_MINOR_VERSION     (4)
+#define CRC_AR_RELEASE_REVISION_VERSION  (0)
+#define CRC_SW_MAJOR_VERSION             (1)
+#define CRC_SW_MINOR_VERSION             (0)
+#define CRC_SW_PATCH_VERSION             (0)
+
+/* Check AUTOSAR version compatibility */
+#if ((STD_AR_RELEASE_MAJOR_VERSION != CRC_AR_RELEASE_MAJOR_VERSION) || \
+     (STD_AR_RELEASE_MINOR_VERSION != CRC_AR_RELEASE_MINOR_VERSION))
+#error "AUTOSAR version mismatch between Crc.h and Std_Types.h"
+#endif
+
+/* Function prototypes */
+
+/**
+ * @brief   CRC8 SAE J1850
+ * @param   Crc_StartValue8  Result of the previous call; ignored on the first call
+ * @return  CRC of the data, "123456789" gives 0x4B
+ */
+uint8 Crc_CalculateCRC8(const uint8 *Crc_DataPtr, uint32 Crc_Length, uint8 Crc_StartValue8,
+                        boolean Crc_IsFirstCall);
+
+/**
+ * @brief   CRC8H2F
+ * @return  CRC of the data, "123456789" gives 0xDF
+ */
+uint8 Crc_CalculateCRC8H2F(const uint8 *Crc_DataPtr, uint32 Crc_Length, uint8 Crc_StartValue8H2F,
+                           boolean Crc_IsFirstCall);
+
+/**
+ * @brief   CRC16 CCITT-FALSE
+ * @return  CRC of the data, "123456789" gives 0x29B1
+ */
+uint16 Crc_CalculateCRC16(const uint8 *Crc_DataPtr, uint32 Crc_Length, uint16 Crc_StartValue16,
+                          boolean Crc_IsFirstCall);
+
+/**
+ * @brief   CRC32 IEEE 802.3
+ * @return  CRC of the data, "123456789" gives 0xCBF43926
+ */
+uint32 Crc_CalculateCRC32(const uint8 *Crc_DataPtr, uint32 Crc_Length, uint32 Crc_StartValue32,
+                          boolean Crc_IsFirstCall);
+
+#endif /* CRC_H */
@@ -0,0 +1,62 @@
+/*
+ * Crc_Cfg.h - AUTOSAR CRC Library Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the calculation method of each CRC
+ *              width. The tables of the table-driven methods are generated
+ *              at build time by Tools/CrcGen (Crc_Tables.c) and placed in
+ *              ROM; the unused ones are removed by the linker.
+ */
+
+#ifndef CRC_CFG_H
+#define CRC_CFG_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+
+/* Calculation methods */
+#define CRC_RUNTIME                  (0u)    /* Bit by bit, no table */
+#define CRC_TABLE                    (1u)    /* One table lookup per byte */
+#define CRC_SLICE_BY_4               (2u)    /* Four tables, one word per step (CRC32 only) */
+
+/* Method per width; MOTOR_CMD and MOTOR_STATUS are 8 bytes, MOTOR_CONFIG 12 */
+#define CRC_8_MODE                   (CRC_TABLE)
+#define CRC_8H2F_MODE                (CRC_TABLE)
+#define CRC_16_MODE                  (CRC_TABLE)
+#define CRC_32_MODE                  (CRC_SLICE_BY_4)
+
+#if (CRC_8_MODE > CRC_TABLE) || (CRC_8H2F_MODE > CRC_TABLE) || (CRC_16_MODE > CRC_TABLE) || \
+    (CRC_32_MODE > CRC_SLICE_BY_4)
+#error "Crc_Cfg.h: unsupported calculation method"
+#endif
+
+/* CRC8 SAE J1850: polynomial 0x1D, start and final XOR 0xFF */
+#define CRC_8_POLYNOMIAL             (0x1Du)
+#define CRC_INITIAL_VALUE8           (0xFFu)
+#define CRC_XOR_VALUE8               (0xFFu)
+
+/* CRC8H2F: polynomial 0x2F, start and final XOR 0xFF; Hamming distance 4
+ * up to 119 data bits, where SAE J1850 misses some 3-bit errors */
+#define CRC_8H2F_POLYNOMIAL          (0x2Fu)
+#define CRC_INITIAL_VALUE8H2F        (0xFFu)
+#define CRC_XOR_VALUE8H2F            (0xFFu)
+
+/* CRC16 CCITT-FALSE: polynomial 0x1021, start 0xFFFF, no final XOR */
+#define CRC_16_POLYNOMIAL            (0x1021u)
+#define CRC_INITIAL_VALUE16          (0xFFFFu)
+
+/* CRC32 IEEE 802.3: polynomial 0x04C11DB7, reflected, start and final
+ * XOR 0xFFFFFFFF */
+#define CRC_32_POLYNOMIAL_REFLECTED  (0xEDB88320u)
+#define CRC_INITIAL_VALUE32          (0xFFFFFFFFu)
+#define CRC_XOR_VALUE32              (0xFFFFFFFFu)
+
+/* Generated tables (Crc_Tables.c) */
+extern const uint8 Crc_Table8[256];
+extern const uint8 Crc_Table8H2F[256];
+extern const uint16 Crc_Table16[256];
+extern const uint32 Crc_Table32[4][256];   /* [0] byte table, [1..3] slice-by-4 */
+
+#endif /* CRC_CFG_H */
@@ -9,10 +9,16 @@
  */
 
 #include "Det.h"
+#include "Det_Cfg.h"
 
 /* Internal variables */
 static boolean Det_Initialized = FALSE;
 
+#if (DET_USE_TIMESTAMP == STD_ON)
+/* Time of the last reported error, for the debugger */
+static volatile uint64 Det_LastErrorTimestamp = 0u;
+#endif
+
 /* Forward declarations */
 static void Det_LogError(uint16 ModuleId, uint8 InstanceId, uint8 ApiId, uint8 ErrorId);
 
@@ -117,6 +123,11 @@ static void Det_LogError(uint16 ModuleId, uint8 InstanceId, uint8 ApiId, uint8 E
     (void)ApiId;       /* Suppress unused parameter warning */
     (void)ErrorId;     /* Suppress unused parameter warning */
     
+#if (DET_USE_TIMESTAMP == STD_ON)
+    /* Safe from any context, no critical section needed */
+    Det_LastErrorTimestamp = DET_TIMESTAMP();
+#endif
+    
     /* In a production system, you might implement a circular buffer
      * to store recent errors for later retrieval
      */
@@ -40,6 +40,7 @@
 #define DET_E_PARAM_POINTER              (0x01u)
 #define DET_E_INIT_FAILED                (0x02u)
 #define DET_E_ALREADY_INITIALIZED        (0x03u)
+#define DET_E_PARAM_INVALID              (0x04u)
 
 /* Function prototypes */
 
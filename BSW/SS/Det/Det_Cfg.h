@@ -51,10 +51,10 @@
 
 #if (DET_USE_TIMESTAMP == STD_ON)
     /* Include necessary header for timestamp functionality */
-    /* #include "Gpt.h" */
+    #include "Tm.h"
     
-    /* Define timestamp source */
-    #define DET_TIMESTAMP_SOURCE        (0u)
+    /* Define timestamp source: lock-free 64-bit tick count */
+    #define DET_TIMESTAMP()             (Tm_GetTicks())
 #endif
 
 #endif /* DET_CFG_H */
\ No newline at end of file
@@ -0,0 +1,317 @@
+/*
+ * E2E.c - AUTOSAR E2E Protection Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the protection and the check of the
+ *              PDUs configured in E2E_Cfg.c for Infineon TC377. The CRC
+ *              runs over the data ID, then over the PDU without the CRC
+ *              bytes, in chained Crc library calls. The state machine
+ *              counts OK and OKSOMELOST as good and ERROR and WRONGSEQUENCE
+ *              as errors over the last windowSize checks.
+ */
+
+#include "E2E.h"
+#include "Crc.h"
+#include "Det.h"
+
+/* Runtime state of a PDU */
+typedef struct {
+    uint8 txCounter;
+    boolean rxSynced;            /* A counter was received since E2E_Init */
+    uint8 rxCounter;
+    E2E_SMStateType state;
+    uint8 history[E2E_MAX_WINDOW];
+    uint8 historyIndex;
+    uint8 historyCount;
+    uint8 okCount;
+    uint8 errorCount;
+} E2E_PduStateType;
+
+/* History entries */
+#define E2E_HISTORY_NONE             (0u)
+#define E2E_HISTORY_OK               (1u)
+#define E2E_HISTORY_ERROR            (2u)
+
+/* CRC bytes per CRC type */
+static const uint8 E2E_CrcBytes[] = {1u, 1u, 2u, 4u};
+
+/* Internal variables */
+static const E2E_StatisticsType E2E_NoStatistics = {0};
+static E2E_PduStateType E2E_PduState[E2E_MAX_PDUS];
+static E2E_StatisticsType E2E_Statistics[E2E_MAX_PDUS];
+
+/**
+ * @brief   CRC over the data ID and the PDU, the CRC bytes left out
+ */
+static uint32 E2E_CalculateCrc(const E2E_PduConfigType *config, const uint8 *data)
+{
+    const uint8 dataId[2] = {(uint8)(config->dataId & 0xFFu), (uint8)(config->dataId >> 8)};
+    uint32 tail = (uint32)config->crcOffset + E2E_CrcBytes[config->crcType];
+    uint32 tailLength = config->dataLength - tail;
+    uint32 crc;
+
+    switch (config->crcType)
+    {
+        case E2E_CRC8:
+            crc = Crc_CalculateCRC8(dataId, 2u, 0u, TRUE);
+            crc = Crc_CalculateCRC8(data, config->crcOffset, (uint8)crc, FALSE);
+            crc = Crc_CalculateCRC8(&data[tail], tailLength, (uint8)crc, FALSE);
+            break;
+
+        case E2E_CRC8H2F:
+            crc = Crc_CalculateCRC8H2F(dataId, 2u, 0u, TRUE);
+            crc = Crc_CalculateCRC8H2F(data, config->crcOffset, (uint8)crc, FALSE);
+            crc = Crc_CalculateCRC8H2F(&data[tail], tailLength, (uint8)crc, FALSE);
+            break;
+
+        case E2E_CRC16:
+            crc = Crc_CalculateCRC16(dataId, 2u, 0u, TRUE);
+            crc = Crc_CalculateCRC16(data, config->crcOffset, (uint16)crc, FALSE);
+            crc = Crc_CalculateCRC16(&data[tail], tailLength, (uint16)crc, FALSE);
+            break;
+
+        default:
+            crc = Crc_CalculateCRC32(dataId, 2u, 0u, TRUE);
+            crc = Crc_CalculateCRC32(data, config->crcOffset, crc, FALSE);
+            crc = Crc_CalculateCRC32(&data[tail], tailLength, crc, FALSE);
+            break;
+    }
+    return crc;
+}
+
+/**
+ * @brief   Add a check result to the window and take the state transition
+ */
+static void E2E_StateMachine(uint8 pdu, E2E_PCheckStatusType status)
+{
+    const E2E_PduConfigType *config = &E2E_PduConfig[pdu];
+    E2E_PduStateType *state = &E2E_PduState[pdu];
+    uint8 entry = E2E_HISTORY_NONE;
+    uint8 oldest;
+    boolean good;
+
+    if (state->state == E2E_SM_NODATA)
+    {
+        if (status == E2E_P_NONEWDATA)
+        {
+            return;
+        }
+        state->state = E2E_SM_INIT;
+    }
+
+    if (status == E2E_P_OK || status == E2E_P_OKSOMELOST)
+    {
+        entry = E2E_HISTORY_OK;
+    }
+    else if (status == E2E_P_ERROR || status == E2E_P_WRONGSEQUENCE)
+    {
+        entry = E2E_HISTORY_ERROR;
+    }
+    else
+    {
+        /* Repeated or no new data: neither good nor an error */
+    }
+
+    /* Slide the window: the oldest entry leaves once it is full */
+    if (state->historyCount == config->windowSize)
+    {
+        oldest = state->history[state->historyIndex];
+        state->okCount -= (oldest == E2E_HISTORY_OK) ? 1u : 0u;
+        state->errorCount -= (oldest == E2E_HISTORY_ERROR) ? 1u : 0u;
+    }
+    else
+    {
+        state->historyCount++;
+    }
+    state->history[state->historyIndex] = entry;
+    state->historyIndex = (uint8)((state->historyIndex + 1u) % config->windowSize);
+    state->okCount += (entry == E2E_HISTORY_OK) ? 1u : 0u;
+    state->errorCount += (entry == E2E_HISTORY_ERROR) ? 1u : 0u;
+
+    good = (state->okCount >= config->minOk && state->errorCount <= config->maxError) ? TRUE : FALSE;
+    if (good == TRUE)
+    {
+        state->state = E2E_SM_VALID;
+    }
+    else if (state->state == E2E_SM_VALID || state->errorCount > config->maxError)
+    {
+        if (state->state != E2E_SM_INVALID)
+        {
+            E2E_Statistics[pdu].invalidTransitions++;
+        }
+        state->state = E2E_SM_INVALID;
+    }
+    else
+    {
+        /* INIT until the window is conclusive; INVALID until it is good */
+    }
+}
+
+/**
+ * @brief   Reset the counters and the state machines of all PDUs
+ */
+void E2E_Init(void)
+{
+    for (uint8 pdu = 0; pdu < E2E_MAX_PDUS; pdu++)
+    {
+        E2E_PduState[pdu].txCounter = 0u;
+        E2E_PduState[pdu].rxSynced = FALSE;
+        E2E_PduState[pdu].state = E2E_SM_NODATA;
+        E2E_PduState[pdu].historyIndex = 0u;
+        E2E_PduState[pdu].historyCount = 0u;
+        E2E_PduState[pdu].okCount = 0u;
+        E2E_PduState[pdu].errorCount = 0u;
+        E2E_Statistics[pdu] = E2E_NoStatistics;
+    }
+}
+
+/**
+ * @brief   Add counter and CRC to a PDU before it is sent
+ */
+Std_ReturnType E2E_Protect(uint8 pdu, uint8 *data, uint8 length)
+{
+    const E2E_PduConfigType *config;
+    uint32 crc;
+
+    if (pdu >= E2E_MAX_PDUS)
+    {
+        Det_ReportError(E2E_MODULE_ID, 0, E2E_PROTECT_SID, E2E_E_PARAM_PDU);
+        return E_NOT_OK;
+    }
+    if (data == NULL_PTR)
+    {
+        Det_ReportError(E2E_MODULE_ID, 0, E2E_PROTECT_SID, E2E_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+    config = &E2E_PduConfig[pdu];
+    if (length < config->dataLength)
+    {
+        Det_ReportError(E2E_MODULE_ID, 0, E2E_PROTECT_SID, E2E_E_PARAM_LENGTH);
+        return E_NOT_OK;
+    }
+
+    data[config->counterOffset] = (uint8)((data[config->counterOffset] & 0xF0u) |
+                                          E2E_PduState[pdu].txCounter);
+    E2E_PduState[pdu].txCounter = (uint8)((E2E_PduState[pdu].txCounter + 1u) % E2E_COUNTER_MODULO);
+
+    crc = E2E_CalculateCrc(config, data);
+    for (uint8 i = 0; i < E2E_CrcBytes[config->crcType]; i++)
+    {
+        data[config->crcOffset + i] = (uint8)(crc >> (8u * i));
+    }
+
+    E2E_Statistics[pdu].protectedPdus++;
+    return E_OK;
+}
+
+/**
+ * @brief   Check a received PDU and run the state machine
+ */
+E2E_PCheckStatusType E2E_Check(uint8 pdu, const uint8 *data, uint8 length)
+{
+    const E2E_PduConfigType *config;
+    E2E_PduStateType *state;
+    E2E_PCheckStatusType status;
+    uint32 crc = 0u;
+    uint8 counter;
+    uint8 delta;
+
+    if (pdu >= E2E_MAX_PDUS)
+    {
+        Det_ReportError(E2E_MODULE_ID, 0, E2E_CHECK_SID, E2E_E_PARAM_PDU);
+        return E2E_P_ERROR;
+    }
+    config = &E2E_PduConfig[pdu];
+    state = &E2E_PduState[pdu];
+
+    if (data == NULL_PTR)
+    {
+        status = E2E_P_NONEWDATA;
+        E2E_Statistics[pdu].noNewData++;
+    }
+    else if (length < config->dataLength)
+    {
+        status = E2E_P_ERROR;
+        E2E_Statistics[pdu].errors++;
+    }
+    else
+    {
+        for (uint8 i = 0; i < E2E_CrcBytes[config->crcType]; i++)
+        {
+            crc |= (uint32)data[config->crcOffset + i] << (8u * i);
+        }
+        counter = (uint8)(data[config->counterOffset] & 0x0Fu);
+        delta = (uint8)((counter + E2E_COUNTER_MODULO - state->rxCounter) % E2E_COUNTER_MODULO);
+
+        if (crc != E2E_CalculateCrc(config, data))
+        {
+            status = E2E_P_ERROR;
+            E2E_Statistics[pdu].errors++;
+        }
+        else if (state->rxSynced == FALSE || delta == 1u)
+        {
+            status = E2E_P_OK;
+            E2E_Statistics[pdu].ok++;
+        }
+        else if (delta == 0u)
+        {
+            status = E2E_P_REPEATED;
+            E2E_Statistics[pdu].repeated++;
+        }
+        else if (delta <= config->maxDeltaCounter)
+        {
+            status = E2E_P_OKSOMELOST;
+            E2E_Statistics[pdu].okSomeLost++;
+        }
+        else
+        {
+            status = E2E_P_WRONGSEQUENCE;
+            E2E_Statistics[pdu].wrongSequence++;
+        }
+
+        /* A good CRC resynchronizes the counter, also after a wrong sequence */
+        if (status != E2E_P_ERROR)
+        {
+            state->rxCounter = counter;
+            state->rxSynced = TRUE;
+        }
+    }
+
+    E2E_StateMachine(pdu, status);
+    return status;
+}
+
+/**
+ * @brief   Get the state machine state of a PDU
+ */
+E2E_SMStateType E2E_GetState(uint8 pdu)
+{
+    if (pdu >= E2E_MAX_PDUS)
+    {
+        Det_ReportError(E2E_MODULE_ID, 0, E2E_GET_STATE_SID, E2E_E_PARAM_PDU);
+        return E2E_SM_INVALID;
+    }
+    return E2E_PduState[pdu].state;
+}
+
+/**
+ * @brief   Get the check statistics of a PDU
+ */
+Std_ReturnType E2E_GetStatistics(uint8 pdu, E2E_StatisticsType *statistics)
+{
+    if (pdu >= E2E_MAX_PDUS)
+    {
+        Det_ReportError(E2E_MODULE_ID, 0, E2E_GET_STATISTICS_SID, E2E_E_PARAM_PDU);
+        return E_NOT_OK;
+    }
+    if (statistics == NULL_PTR)
+    {
+        Det_ReportError(E2E_MODULE_ID, 0, E2E_GET_STATISTICS_SID, E2E_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+
+    *statistics = E2E_Statistics[pdu];
+    return E_OK;
+}
@@ -0,0 +1,112 @@
+/*
+ * E2E.h - AUTOSAR E2E Protection Interface
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface of the end-to-end
+ *              protection of the motor control PDUs for Infineon TC377.
+ *              The sender adds a 4-bit counter and a CRC over the data ID
+ *              and the PDU; the receiver checks both, judges each PDU and
+ *              runs a state machine over a window of the recent results.
+ */
+
+#ifndef E2E_H
+#define E2E_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "E2E_Cfg.h"
+
+/* AUTOSAR Version information */
+#define E2E_VENDOR_ID                    (0x1234)
+#define E2E_MODULE_ID                    (0x00CF)
+#define E2E_AR_RELEASE_MAJOR_VERSION     (4)
+#define E2E_AR_RELEASE_MINOR_VERSION     (4)
+#define E2E_AR_RELEASE_REVISION_VERSION  (0)
+#define E2E_SW_MAJOR_VERSION             (1)
+#define E2E_SW_MINOR_VERSION             (0)
+#define E2E_SW_PATCH_VERSION             (0)
+
+/* Check AUTOSAR version compatibility */
+#if ((STD_AR_RELEASE_MAJOR_VERSION != E2E_AR_RELEASE_MAJOR_VERSION) || \
+     (STD_AR_RELEASE_MINOR_VERSION != E2E_AR_RELEASE_MINOR_VERSION))
+#error "AUTOSAR version mismatch between E2E.h and Std_Types.h"
+#endif
+
+/* API service IDs */
+#define E2E_INIT_SID                     (0x00u)
+#define E2E_PROTECT_SID                  (0x01u)
+#define E2E_CHECK_SID                    (0x02u)
+#define E2E_GET_STATE_SID                (0x03u)
+#define E2E_GET_STATISTICS_SID           (0x04u)
+
+/* Error codes */
+#define E2E_E_PARAM_PDU                  (0x01u)
+#define E2E_E_PARAM_POINTER              (0x02u)
+#define E2E_E_PARAM_LENGTH               (0x03u)
+
+/* Counter range of the 4-bit counter */
+#define E2E_COUNTER_MODULO               (16u)
+
+/* Result of the check of one PDU */
+typedef enum {
+    E2E_P_OK,                    /* CRC good, counter one ahead */
+    E2E_P_OKSOMELOST,            /* CRC good, up to maxDeltaCounter - 1 PDUs lost */
+    E2E_P_REPEATED,              /* CRC good, counter unchanged */
+    E2E_P_WRONGSEQUENCE,         /* CRC good, too many lost or out of order */
+    E2E_P_ERROR,                 /* CRC bad or PDU too short */
+    E2E_P_NONEWDATA              /* No PDU received in the cycle */
+} E2E_PCheckStatusType;
+
+/* State of the check state machine */
+typedef enum {
+    E2E_SM_NODATA,               /* Nothing received yet */
+    E2E_SM_INIT,                 /* Window not yet conclusive */
+    E2E_SM_VALID,                /* Data may be used */
+    E2E_SM_INVALID
+} E2E_SMStateType;
+
+/* Check statistics of a PDU */
+typedef struct {
+    uint32 protectedPdus;
+    uint32 ok;
+    uint32 okSomeLost;
+    uint32 repeated;
+    uint32 wrongSequence;
+    uint32 errors;
+    uint32 noNewData;
+    uint32 invalidTransitions;   /* Times the state machine went to INVALID */
+} E2E_StatisticsType;
+
+/* Function prototypes */
+
+/**
+ * @brief   Reset the counters and the state machines of all PDUs
+ */
+void E2E_Init(void);
+
+/**
+ * @brief   Add counter and CRC to a PDU before it is sent
+ * @param   length  Bytes in data, at least the configured dataLength
+ * @return  E_NOT_OK for an unknown PDU or too short data
+ */
+Std_ReturnType E2E_Protect(uint8 pdu, uint8 *data, uint8 length);
+
+/**
+ * @brief   Check a received PDU and run the state machine
+ * @param   data  NULL_PTR if no PDU arrived in the cycle of the caller
+ * @return  Result of this PDU; the data may be used if it is E2E_P_OK or
+ *          E2E_P_OKSOMELOST and E2E_GetState gives E2E_SM_VALID
+ */
+E2E_PCheckStatusType E2E_Check(uint8 pdu, const uint8 *data, uint8 length);
+
+/* State machine state of a PDU */
+E2E_SMStateType E2E_GetState(uint8 pdu);
+
+/**
+ * @brief   Get the check statistics of a PDU
+ */
+Std_ReturnType E2E_GetStatistics(uint8 pdu, E2E_StatisticsType *statistics);
+
+#endif /* E2E_H */
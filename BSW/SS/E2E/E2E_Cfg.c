@@ -0,0 +1,24 @@
+/*
+ * E2E_Cfg.c - AUTOSAR E2E Protection Configuration Data
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the PDU table of the E2E protection
+ *              module for Infineon TC377. The headers use the bytes the
+ *              signals of MotorControl.dbc leave free.
+ */
+
+#include "E2E_Cfg.h"
+
+/* PDU configurations */
+const E2E_PduConfigType E2E_PduConfig[E2E_MAX_PDUS] = {
+    /* MOTOR_CMD, 10 ms: counter in byte 6, CRC8H2F in byte 7; 2 lost in a
+     * row still accepted, one good frame in the last four keeps it valid */
+    {0x0064u, E2E_CRC8H2F, 8u, 7u, 6u, 3u, 4u, 1u, 1u},
+    /* MOTOR_STATUS, answers MOTOR_CMD: counter in byte 5, CRC16 in bytes 6..7 */
+    {0x0065u, E2E_CRC16, 8u, 6u, 5u, 3u, 4u, 1u, 1u},
+    /* MOTOR_CONFIG, on change: counter in byte 6, CRC32 in bytes 8..11;
+     * each frame is judged on its own */
+    {0x0066u, E2E_CRC32, 12u, 8u, 6u, 15u, 1u, 1u, 0u}
+};
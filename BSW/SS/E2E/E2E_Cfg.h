@@ -0,0 +1,49 @@
+/*
+ * E2E_Cfg.h - AUTOSAR E2E Protection Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the protected PDUs and the layout of
+ *              their E2E header: the position and width of the CRC, the
+ *              position of the 4-bit counter and the limits of the check
+ *              state machine, for Infineon TC377
+ */
+
+#ifndef E2E_CFG_H
+#define E2E_CFG_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+
+/* Protected PDUs (MotorControl.dbc) */
+#define E2E_PDU_MOTOR_CMD            (0u)    /* CRC8H2F */
+#define E2E_PDU_MOTOR_STATUS         (1u)    /* CRC16 */
+#define E2E_PDU_MOTOR_CONFIG         (2u)    /* CRC32 */
+#define E2E_MAX_PDUS                 (3u)
+
+/* CRC types */
+#define E2E_CRC8                     (0u)    /* SAE J1850 */
+#define E2E_CRC8H2F                  (1u)
+#define E2E_CRC16                    (2u)    /* CCITT-FALSE */
+#define E2E_CRC32                    (3u)    /* IEEE 802.3 */
+
+/* Longest state machine window */
+#define E2E_MAX_WINDOW               (16u)
+
+/* PDU configuration */
+typedef struct {
+    uint16 dataId;               /* Included in the CRC, tells PDUs of equal layout apart */
+    uint8 crcType;               /* E2E_CRC8/8H2F/16/32 */
+    uint8 dataLength;            /* Bytes protected, the frame length */
+    uint8 crcOffset;             /* First byte of the CRC, little endian */
+    uint8 counterOffset;         /* Byte with the counter in its low nibble */
+    uint8 maxDeltaCounter;       /* Largest counter step still accepted */
+    uint8 windowSize;            /* Checks the state machine judges over */
+    uint8 minOk;                 /* At least this many OK in the window for VALID */
+    uint8 maxError;              /* At most this many errors in the window for VALID */
+} E2E_PduConfigType;
+
+extern const E2E_PduConfigType E2E_PduConfig[E2E_MAX_PDUS];
+
+#endif /* E2E_CFG_H */
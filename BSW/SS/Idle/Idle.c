@@ -0,0 +1,199 @@
+/*
+ * Idle.c - Idle Management Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the implementation of the
+ *              Idle module for Infineon TC377.
+ *              Before each wait the background loop stores the time the
+ *              wait began. Whichever comes first after the wake-up, the
+ *              interrupt entry or the background loop itself, takes that
+ *              time with an atomic exchange and adds the interval to the
+ *              idle time, so every interval is counted exactly once and
+ *              without the time of the ISR that ended it.
+ */
+
+#include "Idle.h"
+#include "Det.h"
+#include "Tm.h"
+
+/* Interrupt masking and the wait for the next interrupt (DISABLE, ENABLE
+ * and WAIT on the TC377, or host simulation). IdleHw_WaitForInterrupt is
+ * called with interrupts disabled and enables them as it starts to wait,
+ * so an interrupt requested in between ends the wait at once. */
+extern void IdleHw_DisableInterrupts(void);
+extern void IdleHw_EnableInterrupts(void);
+extern void IdleHw_WaitForInterrupt(void);
+
+/* Single-instruction read-modify-write on state shared with ISRs (swap.w
+ * and the LDMST instructions on the TC377) */
+#if defined(__GNUC__)
+#define IDLE_EXCHANGE(ptr, value)     __atomic_exchange_n((ptr), (value), __ATOMIC_ACQ_REL)
+#define IDLE_FETCH_OR(ptr, value)     (void)__atomic_fetch_or((ptr), (value), __ATOMIC_RELEASE)
+#define IDLE_FETCH_ADD(ptr, value)    (void)__atomic_fetch_add((ptr), (value), __ATOMIC_RELAXED)
+#else
+#error "Idle requires atomic exchange support"
+#endif
+
+/* Internal variables */
+static boolean Idle_Initialized = FALSE;
+static volatile uint32 Idle_Events = 0u;
+static volatile uint32 Idle_WaitStart = 0u;     /* Tick the current wait began, 0 if none */
+static volatile uint32 Idle_IdleTicks = 0u;     /* Idle time in the current window */
+static uint32 Idle_WindowStart = 0u;
+static uint32 Idle_WindowMs = 0u;
+static uint32 Idle_HeartbeatMs = 0u;
+static uint16 Idle_Load = 0u;
+static uint16 Idle_PeakLoad = 0u;
+
+/**
+ * @brief   Add the current wait, if any, to the idle time
+ */
+static void Idle_CloseWait(void)
+{
+    uint32 start = IDLE_EXCHANGE(&Idle_WaitStart, 0u);
+
+    if (start != 0u)
+    {
+        IDLE_FETCH_ADD(&Idle_IdleTicks, Tm_GetTicks32() - start);
+    }
+}
+
+/**
+ * @brief   Initialize the Idle module
+ */
+void Idle_Init(void)
+{
+    if (Idle_Initialized == TRUE)
+    {
+        Det_ReportError(IDLE_MODULE_ID, 0, IDLE_INIT_SID, IDLE_E_ALREADY_INITIALIZED);
+        return;
+    }
+
+    Idle_Events = 0u;
+    Idle_WaitStart = 0u;
+    Idle_IdleTicks = 0u;
+    Idle_WindowStart = Tm_GetTicks32();
+    Idle_WindowMs = 0u;
+    Idle_HeartbeatMs = 0u;
+    Idle_Load = 0u;
+    Idle_PeakLoad = 0u;
+    Idle_Initialized = TRUE;
+}
+
+/**
+ * @brief   Post events to the background loop
+ */
+void Idle_SetEvent(uint32 events)
+{
+    IDLE_FETCH_OR(&Idle_Events, events);
+}
+
+/**
+ * @brief   Sleep until at least one event is posted
+ */
+uint32 Idle_Wait(void)
+{
+    uint32 events;
+    uint32 start;
+
+    if (Idle_Initialized == FALSE)
+    {
+        Det_ReportError(IDLE_MODULE_ID, 0, IDLE_WAIT_SID, IDLE_E_UNINIT);
+        return 0u;
+    }
+
+    for (;;)
+    {
+        events = IDLE_EXCHANGE(&Idle_Events, 0u);
+        if (events != 0u)
+        {
+            return events;
+        }
+
+        /* 0 marks "not waiting"; a start tick of 0 is off by one tick */
+        start = Tm_GetTicks32();
+        Idle_WaitStart = (start != 0u) ? start : 1u;
+
+        /* An ISR may have posted an event since the exchange above; check
+         * again with interrupts disabled and only then wait */
+        IdleHw_DisableInterrupts();
+        if (Idle_Events == 0u)
+        {
+            IdleHw_WaitForInterrupt();
+        }
+        else
+        {
+            IdleHw_EnableInterrupts();
+        }
+
+        /* Woken by an interrupt that does not call Idle_IsrEnter */
+        Idle_CloseWait();
+    }
+}
+
+/**
+ * @brief   Mark an interrupt entry for the idle time accounting
+ */
+void Idle_IsrEnter(void)
+{
+    Idle_CloseWait();
+}
+
+/**
+ * @brief   Post the heartbeat and close the CPU load window
+ */
+void Idle_MainFunction(void)
+{
+    uint32 now;
+    uint32 window;
+    uint32 idle;
+    uint32 load;
+
+    if (Idle_Initialized == FALSE)
+    {
+        Det_ReportError(IDLE_MODULE_ID, 0, IDLE_MAIN_FUNCTION_SID, IDLE_E_UNINIT);
+        return;
+    }
+
+    Idle_HeartbeatMs += IDLE_MAIN_FUNCTION_PERIOD_MS;
+    if (Idle_HeartbeatMs >= IDLE_HEARTBEAT_MS)
+    {
+        Idle_HeartbeatMs = 0u;
+        Idle_SetEvent(IDLE_EVENT_HEARTBEAT);
+    }
+
+    Idle_WindowMs += IDLE_MAIN_FUNCTION_PERIOD_MS;
+    if (Idle_WindowMs >= IDLE_LOAD_WINDOW_MS)
+    {
+        now = Tm_GetTicks32();
+        window = now - Idle_WindowStart;
+        idle = IDLE_EXCHANGE(&Idle_IdleTicks, 0u);
+        Idle_WindowStart = now;
+        Idle_WindowMs = 0u;
+
+        load = (window > idle) ? (uint32)(((uint64)(window - idle) * 1000u) / window) : 0u;
+        Idle_Load = (uint16)load;
+        if (Idle_Load > Idle_PeakLoad)
+        {
+            Idle_PeakLoad = Idle_Load;
+        }
+    }
+}
+
+/**
+ * @brief   CPU load of the last complete window in 0.1 %
+ */
+uint16 Idle_GetCpuLoad(void)
+{
+    return Idle_Load;
+}
+
+/**
+ * @brief   Highest CPU load of any window in 0.1 %
+ */
+uint16 Idle_GetPeakCpuLoad(void)
+{
+    return Idle_PeakLoad;
+}
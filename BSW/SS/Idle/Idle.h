@@ -0,0 +1,96 @@
+/*
+ * Idle.h - Idle Management Interface
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface definition for the
+ *              Idle module for Infineon TC377. The background loop sleeps
+ *              in Idle_Wait until an interrupt posts an event, instead of
+ *              spinning. The time spent waiting is accounted as idle time
+ *              and turned into a CPU load figure per window.
+ */
+
+#ifndef IDLE_H
+#define IDLE_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "Idle_Cfg.h"
+
+/* AUTOSAR Version information */
+#define IDLE_VENDOR_ID                    (0x1234)
+#define IDLE_MODULE_ID                    (0x0102)
+#define IDLE_AR_RELEASE_MAJOR_VERSION     (4)
+#define IDLE_AR_RELEASE_MINOR_VERSION     (4)
+#define IDLE_AR_RELEASE_REVISION_VERSION  (0)
+#define IDLE_SW_MAJOR_VERSION             (1)
+#define IDLE_SW_MINOR_VERSION             (0)
+#define IDLE_SW_PATCH_VERSION             (0)
+
+/* Check AUTOSAR version compatibility */
+#if ((STD_AR_RELEASE_MAJOR_VERSION != IDLE_AR_RELEASE_MAJOR_VERSION) || \
+     (STD_AR_RELEASE_MINOR_VERSION != IDLE_AR_RELEASE_MINOR_VERSION))
+#error "AUTOSAR version mismatch between Idle.h and Std_Types.h"
+#endif
+
+/* API service IDs */
+#define IDLE_INIT_SID                     (0x00u)
+#define IDLE_WAIT_SID                     (0x01u)
+#define IDLE_MAIN_FUNCTION_SID            (0x02u)
+
+/* Error codes */
+#define IDLE_E_UNINIT                     (0x01u)
+#define IDLE_E_ALREADY_INITIALIZED        (0x02u)
+
+/* Event posted by Idle_MainFunction every IDLE_HEARTBEAT_MS; the other
+ * bits are free for the application */
+#define IDLE_EVENT_HEARTBEAT              (0x00000001u)
+
+/* Function prototypes */
+
+/**
+ * @brief   Initialize the Idle module; the first load window starts now
+ * @details Requires Tm to be initialized.
+ */
+void Idle_Init(void);
+
+/**
+ * @brief   Post events to the background loop
+ * @details Callable from any ISR or task. The events are returned, and
+ *          cleared, by the next Idle_Wait.
+ */
+void Idle_SetEvent(uint32 events);
+
+/**
+ * @brief   Sleep until at least one event is posted
+ * @details Called from the background loop only. Waits for interrupts
+ *          (WAIT on the TC377) and goes back to sleep after interrupts
+ *          that post no event. The last check for events runs with
+ *          interrupts disabled, so an event posted just before the wait
+ *          ends it at once.
+ * @return  The posted events
+ */
+uint32 Idle_Wait(void);
+
+/**
+ * @brief   Mark an interrupt entry for the idle time accounting
+ * @details Called first in every ISR, so the ISR's execution time is not
+ *          counted as idle time of the wait it interrupted.
+ */
+void Idle_IsrEnter(void);
+
+/**
+ * @brief   Post the heartbeat and close the CPU load window
+ * @details Must be called every IDLE_MAIN_FUNCTION_PERIOD_MS from the tick
+ *          ISR, after Idle_IsrEnter.
+ */
+void Idle_MainFunction(void);
+
+/* CPU load of the last complete window in 0.1 % */
+uint16 Idle_GetCpuLoad(void);
+
+/* Highest CPU load of any window since Idle_Init in 0.1 % */
+uint16 Idle_GetPeakCpuLoad(void);
+
+#endif /* IDLE_H */
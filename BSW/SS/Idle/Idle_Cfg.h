@@ -0,0 +1,27 @@
+/*
+ * Idle_Cfg.h - Idle Management Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the heartbeat and CPU load window of
+ *              the Idle module for Infineon TC377
+ */
+
+#ifndef IDLE_CFG_H
+#define IDLE_CFG_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+
+/* Period of Idle_MainFunction (1 ms system tick, GPT channel 0) */
+#define IDLE_MAIN_FUNCTION_PERIOD_MS       (1u)
+
+/* Heartbeat event period: wakes the background loop often enough for its
+ * 10 ms alive supervision and for polling the buttons */
+#define IDLE_HEARTBEAT_MS                  (5u)
+
+/* CPU load is computed over windows of this length */
+#define IDLE_LOAD_WINDOW_MS                (100u)
+
+#endif /* IDLE_CFG_H */
@@ -0,0 +1,166 @@
+/*
+ * Lut.c - Fixed-Point Lookup Table Library Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interpolation on the tables generated
+ *              from Lut_Cfg.h. The input is split into a table index (upper
+ *              bits) and a fraction (lower bits); the order selected in the
+ *              configuration is a compile-time constant, so the unused
+ *              interpolation branches are removed by the compiler.
+ */
+
+#include "Lut.h"
+#include "Det.h"
+
+/* Fraction bits left below the table index */
+#define LUT_SIN_FRAC_BITS            (16u - LUT_SIN_BITS)
+#define LUT_ATAN_FRAC_BITS           (16u - LUT_ATAN_BITS)
+#define LUT_CURVE_FRAC_BITS          (LUT_ADC_BITS - LUT_CURVE_BITS)
+
+/* Largest raw ADC value */
+#define LUT_ADC_MAX                  ((1u << LUT_ADC_BITS) - 1u)
+
+/* Quarter and half turn in angle units */
+#define LUT_QUARTER_TURN             (0x4000u)
+#define LUT_HALF_TURN                (0x8000u)
+
+/* Forward declarations */
+static sint32 Lut_Interpolate(const sint16 *table, uint32 x, uint32 fracBits, uint32 order);
+
+/**
+ * @brief Fixed-point sine
+ */
+sint16 Lut_Sin(uint16 angle)
+{
+    sint32 y = Lut_Interpolate(Lut_SinTable, angle, LUT_SIN_FRAC_BITS, LUT_SIN_ORDER);
+
+    /* The quadratic term may overshoot the table around +/-1 */
+    if (y > 32767)
+    {
+        y = 32767;
+    }
+    else if (y < -32767)
+    {
+        y = -32767;
+    }
+
+    return (sint16)y;
+}
+
+/**
+ * @brief Fixed-point cosine
+ */
+sint16 Lut_Cos(uint16 angle)
+{
+    return Lut_Sin((uint16)(angle + LUT_QUARTER_TURN));
+}
+
+/**
+ * @brief Fixed-point four-quadrant arc tangent
+ */
+uint16 Lut_Atan2(sint32 y, sint32 x)
+{
+    uint32 ax = (x < 0) ? (0u - (uint32)x) : (uint32)x;
+    uint32 ay = (y < 0) ? (0u - (uint32)y) : (uint32)y;
+    uint32 num;
+    uint32 den;
+    uint32 ratio;
+    uint32 angle;
+
+    if (ax == 0u && ay == 0u)
+    {
+        return 0u;
+    }
+
+    /* Fold onto the first octant: ratio = min / max in Q16 */
+    num = (ay <= ax) ? ay : ax;
+    den = (ay <= ax) ? ax : ay;
+
+    /* Keep num << 16 within 32 bits; num <= den */
+    while (den > 0xFFFFu)
+    {
+        num >>= 1;
+        den >>= 1;
+    }
+    ratio = (num << 16) / den;
+    if (ratio > 0xFFFFu)
+    {
+        /* 45 degrees exactly; one LSB below is within the table accuracy */
+        ratio = 0xFFFFu;
+    }
+
+    angle = (uint32)Lut_Interpolate(Lut_AtanTable, ratio, LUT_ATAN_FRAC_BITS, LUT_ATAN_ORDER);
+
+    /* Unfold octant, half plane and sign */
+    if (ay > ax)
+    {
+        angle = LUT_QUARTER_TURN - angle;
+    }
+    if (x < 0)
+    {
+        angle = LUT_HALF_TURN - angle;
+    }
+    if (y < 0)
+    {
+        angle = 0u - angle;
+    }
+
+    return (uint16)angle;
+}
+
+/**
+ * @brief Convert a raw ADC value through a sensor curve
+ */
+sint16 Lut_Linearize(uint8 curve, uint16 raw)
+{
+    uint32 x = raw;
+
+    if (curve >= LUT_CURVE_COUNT)
+    {
+        Det_ReportError(LUT_MODULE_ID, 0, LUT_LINEARIZE_SID, LUT_E_PARAM_CURVE);
+        return 0;
+    }
+    if (x > LUT_ADC_MAX)
+    {
+        x = LUT_ADC_MAX;
+    }
+
+    return (sint16)Lut_Interpolate(Lut_CurveTable[curve], x, LUT_CURVE_FRAC_BITS, LUT_CURVE_ORDER);
+}
+
+/**
+ * @brief Interpolate between the table entries around x
+ * @param table    Table with two guard entries after the last interval
+ * @param x        Input; upper bits = index, lower fracBits bits = fraction
+ * @param fracBits Number of fraction bits, 1..10 (limited by Lut_Cfg.h)
+ * @param order    Interpolation order 0, 1 or 2
+ * @return Interpolated table value
+ */
+static sint32 Lut_Interpolate(const sint16 *table, uint32 x, uint32 fracBits, uint32 order)
+{
+    uint32 index = x >> fracBits;
+    sint32 frac = (sint32)(x & ((1u << fracBits) - 1u));
+    sint32 y0 = table[index];
+    sint32 d1;
+    sint32 d2;
+
+    if (order == 0u)
+    {
+        /* Nearest entry */
+        return table[(x + (1u << (fracBits - 1u))) >> fracBits];
+    }
+
+    d1 = table[index + 1u] - y0;
+    if (order == 1u)
+    {
+        return y0 + ((d1 * frac + (sint32)(1u << (fracBits - 1u))) >> fracBits);
+    }
+
+    /* y0 + f * d1 + f * (f - 1) / 2 * d2 with f = frac / 2^fracBits, rounded */
+    d2 = table[index + 2u] - 2 * table[index + 1u] + y0;
+    return y0 + ((d1 * frac + (sint32)(1u << (fracBits - 1u))) >> fracBits) +
+           ((d2 * frac * (frac - (sint32)(1u << fracBits)) + (sint32)(1u << (2u * fracBits))) >>
+            (2u * fracBits + 1u));
+}
@@ -0,0 +1,76 @@
+/*
+ * Lut.h - Fixed-Point Lookup Table Library Interface
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface of the interpolated lookup
+ *              tables for trigonometry and sensor linearization. All
+ *              functions are reentrant, work on constant ROM tables and
+ *              need no initialization, so they can be called from the
+ *              PWM-synchronous interrupts.
+ */
+
+#ifndef LUT_H
+#define LUT_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "Lut_Cfg.h"
+
+/* AUTOSAR Version information */
+#define LUT_VENDOR_ID                    (0x1234)
+#define LUT_MODULE_ID                    (0x00CA)
+#define LUT_AR_RELEASE_MAJOR_VERSION     (4)
+#define LUT_AR_RELEASE_MINOR_VERSION     (4)
+#define LUT_AR_RELEASE_REVISION_VERSION  (0)
+#define LUT_SW_MAJOR_VERSION             (1)
+#define LUT_SW_MINOR_VERSION             (0)
+#define LUT_SW_PATCH_VERSION             (0)
+
+/* Check AUTOSAR version compatibility */
+#if ((STD_AR_RELEASE_MAJOR_VERSION != LUT_AR_RELEASE_MAJOR_VERSION) || \
+     (STD_AR_RELEASE_MINOR_VERSION != LUT_AR_RELEASE_MINOR_VERSION))
+#error "AUTOSAR version mismatch between Lut.h and Std_Types.h"
+#endif
+
+/* API service IDs */
+#define LUT_LINEARIZE_SID                (0x01u)
+
+/* Error codes */
+#define LUT_E_PARAM_CURVE                (0x01u)
+
+/* Function prototypes */
+
+/**
+ * @brief   Fixed-point sine
+ * @param   angle  Angle, full turn = 65536
+ * @return  sin(angle) in Q15, saturated to +/-32767
+ */
+sint16 Lut_Sin(uint16 angle);
+
+/**
+ * @brief   Fixed-point cosine
+ * @param   angle  Angle, full turn = 65536
+ * @return  cos(angle) in Q15, saturated to +/-32767
+ */
+sint16 Lut_Cos(uint16 angle);
+
+/**
+ * @brief   Fixed-point four-quadrant arc tangent
+ * @details The inputs only need a common scale; atan2(0, 0) returns 0.
+ * @param   y  Ordinate
+ * @param   x  Abscissa
+ * @return  Angle of (x, y), full turn = 65536
+ */
+uint16 Lut_Atan2(sint32 y, sint32 x);
+
+/**
+ * @brief   Convert a raw ADC value through a sensor curve
+ * @param   curve  Curve identifier (LUT_CURVE_*)
+ * @param   raw    ADC value, LUT_ADC_BITS wide (larger values saturate)
+ * @return  Physical value in the unit of the curve, 0 for an invalid curve
+ */
+sint16 Lut_Linearize(uint8 curve, uint16 raw);
+
+#endif /* LUT_H */
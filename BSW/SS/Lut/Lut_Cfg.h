@@ -0,0 +1,73 @@
+/*
+ * Lut_Cfg.h - Lookup Table Library Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the size and interpolation order of the
+ *              lookup tables and the parameters of the sensor curves. The
+ *              tables themselves are generated from this file at build time
+ *              by Tools/LutGen (Lut_Tables.c) and placed in ROM.
+ */
+
+#ifndef LUT_CFG_H
+#define LUT_CFG_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+
+/*
+ * Each table has 2^bits intervals plus two guard entries, so interpolation
+ * never needs a bounds check. Interpolation orders: 0 = nearest entry,
+ * 1 = linear, 2 = quadratic (forward differences over three entries).
+ */
+
+/* sin/cos: one full turn */
+#define LUT_SIN_BITS                 (8u)
+#define LUT_SIN_ORDER                (1u)
+
+/* atan2: atan(r) for r in [0, 1], the other octants are folded onto it */
+#define LUT_ATAN_BITS                (7u)
+#define LUT_ATAN_ORDER               (1u)
+
+/* Sensor curves: breakpoints uniformly spaced over the ADC range */
+#define LUT_ADC_BITS                 (12u)
+#define LUT_CURVE_BITS               (6u)
+#define LUT_CURVE_ORDER              (1u)
+
+/* Sensor curves of the ADC group 1 channels */
+#define LUT_CURVE_DC_LINK            (0u)    /* Channel 0, output in 0.1 V */
+#define LUT_CURVE_NTC                (1u)    /* Channels 1..3, output in 0.1 degC */
+#define LUT_CURVE_COUNT              (2u)
+
+/* DC link voltage divider: voltage at full ADC scale [V] */
+#define LUT_VDC_FULL_SCALE           (100.0)
+
+/* NTC thermistors on the low side of a divider to the ADC reference, beta model */
+#define LUT_NTC_R25                  (10000.0)   /* Resistance at 25 degC [Ohm] */
+#define LUT_NTC_BETA                 (3435.0)    /* Beta constant [K] */
+#define LUT_NTC_PULLUP               (10000.0)   /* Divider pull-up [Ohm] */
+#define LUT_NTC_T_MIN                (-40.0)     /* Output range [degC], open sensor */
+#define LUT_NTC_T_MAX                (150.0)     /* Output range [degC], shorted sensor */
+
+#if (LUT_SIN_ORDER > 2u) || (LUT_ATAN_ORDER > 2u) || (LUT_CURVE_ORDER > 2u)
+#error "Lut_Cfg.h: interpolation order must be 0, 1 or 2"
+#endif
+
+/* At least one fraction bit, and at most ten to keep the quadratic term within 32 bits */
+#if (LUT_SIN_BITS < 6u) || (LUT_SIN_BITS > 15u) || (LUT_ATAN_BITS < 6u) || (LUT_ATAN_BITS > 15u) || \
+    (LUT_CURVE_BITS < (LUT_ADC_BITS - 10u)) || (LUT_CURVE_BITS > (LUT_ADC_BITS - 1u))
+#error "Lut_Cfg.h: unsupported table size"
+#endif
+
+/* Number of intervals per table */
+#define LUT_SIN_SIZE                 (1u << LUT_SIN_BITS)
+#define LUT_ATAN_SIZE                (1u << LUT_ATAN_BITS)
+#define LUT_CURVE_SIZE               (1u << LUT_CURVE_BITS)
+
+/* Generated tables (Lut_Tables.c) */
+extern const sint16 Lut_SinTable[LUT_SIN_SIZE + 2u];         /* sin, Q15 */
+extern const sint16 Lut_AtanTable[LUT_ATAN_SIZE + 2u];       /* atan, 1/65536 turn */
+extern const sint16 Lut_CurveTable[LUT_CURVE_COUNT][LUT_CURVE_SIZE + 2u];
+
+#endif /* LUT_CFG_H */
@@ -0,0 +1,291 @@
+/*
+ * PduR.c - AUTOSAR PDU Router Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the gateway between the ComM channels
+ *              for Infineon TC377. A received PDU finds its routes through
+ *              the direct-indexed source table of its channel, without a
+ *              search. PDU routes hand the received buffer to the
+ *              destination bus; signal routes copy their signals into the
+ *              composed destination PDU, which keeps the signals of the
+ *              other routes to it.
+ */
+
+#include "PduR.h"
+#include "Det.h"
+
+/* Bus interfaces of the channels (CanIf, LinIf, FrIf, SoAd; HostSim/BusHw) */
+extern Std_ReturnType BusHw_Transmit(uint8 channel, uint16 pduId, const uint8 *data, uint8 length);
+
+/* Internal variables */
+static const PduR_StatisticsType PduR_NoStatistics = {0};
+static boolean PduR_Initialized = FALSE;
+static uint32 PduR_NowMs;
+static PduR_StatisticsType PduR_Statistics;
+
+/**
+ * @brief   Copy one signal of up to 32 bits, little endian bit order
+ */
+static void PduR_CopySignal(const PduR_SignalType *signal, const uint8 *src, uint8 *dst)
+{
+    uint32 srcByte = (uint32)signal->srcBit >> 3;
+    uint32 dstByte = (uint32)signal->dstBit >> 3;
+    uint32 srcShift = (uint32)signal->srcBit & 7u;
+    uint32 dstShift = (uint32)signal->dstBit & 7u;
+    uint32 srcBytes = (srcShift + signal->bitLength + 7u) >> 3;
+    uint32 dstBytes = (dstShift + signal->bitLength + 7u) >> 3;
+    uint64 mask = (((uint64)1u << signal->bitLength) - 1u) << dstShift;
+    uint64 value = 0u;
+    uint64 word = 0u;
+
+    for (uint32 i = 0; i < srcBytes; i++)
+    {
+        value |= (uint64)src[srcByte + i] << (8u * i);
+    }
+    value = ((value >> srcShift) << dstShift) & mask;
+
+    for (uint32 i = 0; i < dstBytes; i++)
+    {
+        word |= (uint64)dst[dstByte + i] << (8u * i);
+    }
+    word = (word & ~mask) | value;
+    for (uint32 i = 0; i < dstBytes; i++)
+    {
+        dst[dstByte + i] = (uint8)(word >> (8u * i));
+    }
+}
+
+/**
+ * @brief   Send a PDU on the destination channel of a route
+ */
+static Std_ReturnType PduR_Send(const PduR_RouteType *route, const uint8 *data, uint8 length)
+{
+    if (BusHw_Transmit(route->dstChannel, route->dstId, data, length) != E_OK)
+    {
+        PduR_Statistics.txFailures++;
+        return E_NOT_OK;
+    }
+    return E_OK;
+}
+
+/**
+ * @brief   Forward a received PDU along one route
+ */
+static void PduR_Route(uint16 index, const uint8 *data, uint8 length)
+{
+    const PduR_RouteType *route = &PduR_Routes[index];
+    PduR_RouteStateType *state = &PduR_RouteState[index];
+    boolean expired = ((PduR_NowMs - state->lastSentMs) >= route->minIntervalMs) ? TRUE : FALSE;
+
+    /* A PDU route of merged signals forwards the bytes they cover; the
+     * source is at least minSrcLength = dstLength long */
+    if (route->signalCount == 0u && route->dstLength != 0u)
+    {
+        length = route->dstLength;
+    }
+
+    if (route->signalCount != 0u)
+    {
+        for (uint16 s = 0; s < route->signalCount; s++)
+        {
+            PduR_CopySignal(&PduR_Signals[route->firstSignal + s], data, route->buffer);
+        }
+    }
+    else if (expired == FALSE)
+    {
+        for (uint8 i = 0; i < length; i++)
+        {
+            route->buffer[i] = data[i];
+        }
+        state->heldLength = length;
+    }
+    else
+    {
+        /* PDU route with its interval passed: sent as received */
+    }
+
+    if (expired == FALSE)
+    {
+        PduR_Statistics.held++;
+        PduR_Statistics.heldReplaced += (state->pending == TRUE) ? 1u : 0u;
+        state->pending = TRUE;
+        return;
+    }
+
+    /* A newer PDU supersedes the held one */
+    state->pending = FALSE;
+    state->lastSentMs = PduR_NowMs;
+    if (route->signalCount != 0u)
+    {
+        if (PduR_Send(route, route->buffer, route->dstLength) == E_OK)
+        {
+            PduR_Statistics.composed++;
+        }
+    }
+    else if (PduR_Send(route, data, length) == E_OK)
+    {
+        PduR_Statistics.zeroCopy++;
+    }
+    else
+    {
+        /* Counted as a transmit failure */
+    }
+}
+
+/**
+ * @brief   Initialize the router
+ */
+void PduR_Init(void)
+{
+    PDUR_ENTER_CRITICAL();
+    PduR_NowMs = 0u;
+    for (uint16 r = 0; r < PduR_RouteCount; r++)
+    {
+        /* The first PDU of every route is sent at once */
+        PduR_RouteState[r].lastSentMs = 0u - (uint32)PduR_Routes[r].minIntervalMs;
+        PduR_RouteState[r].pending = FALSE;
+        PduR_RouteState[r].heldLength = 0u;
+        if (PduR_Routes[r].signalCount != 0u)
+        {
+            for (uint8 i = 0; i < PduR_Routes[r].dstLength; i++)
+            {
+                PduR_Routes[r].buffer[i] = 0u;
+            }
+        }
+    }
+    PduR_Statistics = PduR_NoStatistics;
+    PduR_Initialized = TRUE;
+    PDUR_EXIT_CRITICAL();
+}
+
+/**
+ * @brief   PDU received on a channel
+ */
+void PduR_RxIndication(uint8 Channel, uint16 PduId, const uint8 *Data, uint8 Length)
+{
+    const PduR_ChannelTableType *table;
+    const PduR_SourceType *source;
+    uint16 offset;
+
+    if (PduR_Initialized == FALSE)
+    {
+        Det_ReportError(PDUR_MODULE_ID, 0, PDUR_RX_INDICATION_SID, PDUR_E_UNINIT);
+        return;
+    }
+    if (Channel >= COMM_MAX_CHANNELS)
+    {
+        Det_ReportError(PDUR_MODULE_ID, 0, PDUR_RX_INDICATION_SID, PDUR_E_PARAM_CHANNEL);
+        return;
+    }
+    if (Data == NULL_PTR)
+    {
+        Det_ReportError(PDUR_MODULE_ID, 0, PDUR_RX_INDICATION_SID, PDUR_E_PARAM_POINTER);
+        return;
+    }
+    if (Length > PDUR_MAX_PDU_LENGTH)
+    {
+        Det_ReportError(PDUR_MODULE_ID, 0, PDUR_RX_INDICATION_SID, PDUR_E_PARAM_LENGTH);
+        return;
+    }
+
+    PDUR_ENTER_CRITICAL();
+    PduR_Statistics.received++;
+
+    /* Direct index; IDs below the base wrap around to beyond idCount */
+    table = &PduR_ChannelTable[Channel];
+    offset = (uint16)(PduId - table->baseId);
+    if (offset >= table->idCount || table->sources[offset].routeCount == 0u)
+    {
+        PduR_Statistics.unrouted++;
+        PDUR_EXIT_CRITICAL();
+        return;
+    }
+
+    source = &table->sources[offset];
+    for (uint16 r = source->firstRoute; r < (uint16)(source->firstRoute + source->routeCount); r++)
+    {
+        if (Length < PduR_Routes[r].minSrcLength)
+        {
+            PduR_Statistics.tooShort++;
+            continue;
+        }
+        PduR_Route(r, Data, Length);
+    }
+    PDUR_EXIT_CRITICAL();
+}
+
+/**
+ * @brief   Send the held PDUs whose interval has passed
+ */
+void PduR_MainFunction(void)
+{
+    const PduR_RouteType *route;
+    PduR_RouteStateType *state;
+    uint8 length;
+
+    if (PduR_Initialized == FALSE)
+    {
+        Det_ReportError(PDUR_MODULE_ID, 0, PDUR_MAIN_FUNCTION_SID, PDUR_E_UNINIT);
+        return;
+    }
+
+    PDUR_ENTER_CRITICAL();
+    PduR_NowMs += PDUR_MAIN_FUNCTION_PERIOD_MS;
+    for (uint16 r = 0; r < PduR_RouteCount; r++)
+    {
+        route = &PduR_Routes[r];
+        state = &PduR_RouteState[r];
+        if (state->pending == FALSE || (PduR_NowMs - state->lastSentMs) < route->minIntervalMs)
+        {
+            continue;
+        }
+
+        /* A refused PDU stays held and is tried again in the next cycle */
+        length = (route->signalCount != 0u) ? route->dstLength : state->heldLength;
+        if (PduR_Send(route, route->buffer, length) == E_OK)
+        {
+            state->pending = FALSE;
+            state->lastSentMs = PduR_NowMs;
+            PduR_Statistics.heldSent++;
+        }
+    }
+    PDUR_EXIT_CRITICAL();
+}
+
+/**
+ * @brief   Get the gateway statistics
+ */
+Std_ReturnType PduR_GetStatistics(PduR_StatisticsType *statistics)
+{
+    if (statistics == NULL_PTR)
+    {
+        Det_ReportError(PDUR_MODULE_ID, 0, PDUR_GET_STATISTICS_SID, PDUR_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+
+    PDUR_ENTER_CRITICAL();
+    *statistics = PduR_Statistics;
+    PDUR_EXIT_CRITICAL();
+    return E_OK;
+}
+
+/**
+ * @brief   Get version information
+ */
+void PduR_GetVersionInfo(Std_VersionInfoType *versioninfo)
+{
+    if (versioninfo != NULL_PTR)
+    {
+        versioninfo->vendorID = PDUR_VENDOR_ID;
+        versioninfo->moduleID = PDUR_MODULE_ID;
+        versioninfo->sw_major_version = PDUR_SW_MAJOR_VERSION;
+        versioninfo->sw_minor_version = PDUR_SW_MINOR_VERSION;
+        versioninfo->sw_patch_version = PDUR_SW_PATCH_VERSION;
+    }
+    else
+    {
+        Det_ReportError(PDUR_MODULE_ID, 0, PDUR_GET_VERSION_INFO_SID, PDUR_E_PARAM_POINTER);
+    }
+}
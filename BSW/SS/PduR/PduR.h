@@ -0,0 +1,95 @@
+/*
+ * PduR.h - AUTOSAR PDU Router Interface
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface of the gateway between
+ *              the ComM channels for Infineon TC377. The bus interfaces
+ *              indicate every received PDU; the router looks up its routes
+ *              by channel and source ID and forwards the PDU, or the
+ *              signals routed from it, to the destination channels.
+ */
+
+#ifndef PDUR_H
+#define PDUR_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "PduR_Cfg.h"
+
+/* AUTOSAR Version information */
+#define PDUR_VENDOR_ID                    (0x1234)
+#define PDUR_MODULE_ID                    (0x0033)
+#define PDUR_AR_RELEASE_MAJOR_VERSION     (4)
+#define PDUR_AR_RELEASE_MINOR_VERSION     (4)
+#define PDUR_AR_RELEASE_REVISION_VERSION  (0)
+#define PDUR_SW_MAJOR_VERSION             (1)
+#define PDUR_SW_MINOR_VERSION             (0)
+#define PDUR_SW_PATCH_VERSION             (0)
+
+/* Check AUTOSAR version compatibility */
+#if ((STD_AR_RELEASE_MAJOR_VERSION != PDUR_AR_RELEASE_MAJOR_VERSION) || \
+     (STD_AR_RELEASE_MINOR_VERSION != PDUR_AR_RELEASE_MINOR_VERSION))
+#error "AUTOSAR version mismatch between PduR.h and Std_Types.h"
+#endif
+
+/* API service IDs */
+#define PDUR_INIT_SID                     (0xF0u)
+#define PDUR_RX_INDICATION_SID            (0x01u)
+#define PDUR_MAIN_FUNCTION_SID            (0x02u)
+#define PDUR_GET_STATISTICS_SID           (0x03u)
+#define PDUR_GET_VERSION_INFO_SID         (0xF1u)
+
+/* Error codes */
+#define PDUR_E_UNINIT                     (0x01u)
+#define PDUR_E_PARAM_CHANNEL              (0x02u)
+#define PDUR_E_PARAM_POINTER              (0x03u)
+#define PDUR_E_PARAM_LENGTH               (0x04u)
+
+/* Gateway statistics */
+typedef struct {
+    uint32 received;             /* PDUs indicated by the bus interfaces */
+    uint32 unrouted;             /* ... without a route */
+    uint32 tooShort;             /* ... shorter than their routes need */
+    uint32 zeroCopy;             /* PDUs sent from the received buffer */
+    uint32 composed;             /* PDUs sent composed of routed signals */
+    uint32 held;                 /* PDUs held back by the rate limit of their route */
+    uint32 heldReplaced;         /* Held PDUs replaced by a newer one */
+    uint32 heldSent;             /* Held PDUs sent after the interval */
+    uint32 txFailures;           /* PDUs the destination bus refused */
+} PduR_StatisticsType;
+
+/* Function prototypes */
+
+/**
+ * @brief   Initialize the router; all rate limits start expired
+ */
+void PduR_Init(void);
+
+/**
+ * @brief   PDU received on a channel (bus interface, receive context)
+ * @details The routes of the PDU are found by a direct index on its source
+ *          ID. A PDU route passes the received buffer to the destination
+ *          bus without a copy; a signal route copies its signals into the
+ *          composed destination PDU and sends that. A PDU within the
+ *          minimum interval of its route is held instead.
+ */
+void PduR_RxIndication(uint8 Channel, uint16 PduId, const uint8 *Data, uint8 Length);
+
+/**
+ * @brief   Send the held PDUs whose interval has passed; runs from the 1 ms tick
+ */
+void PduR_MainFunction(void);
+
+/**
+ * @brief   Get the gateway statistics
+ */
+Std_ReturnType PduR_GetStatistics(PduR_StatisticsType *statistics);
+
+/**
+ * @brief   Get version information
+ */
+void PduR_GetVersionInfo(Std_VersionInfoType *versioninfo);
+
+#endif /* PDUR_H */
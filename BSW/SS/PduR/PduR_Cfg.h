@@ -0,0 +1,125 @@
+/*
+ * PduR_Cfg.h - AUTOSAR PDU Router Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the gateway routes between the ComM
+ *              channels for Infineon TC377. The routes are described in
+ *              PDUR_ROUTING_TABLE; Tools/PduRGen turns the description into
+ *              the route tables and the direct-indexed source tables of
+ *              PduR_Routes.c at build time.
+ */
+
+#ifndef PDUR_CFG_H
+#define PDUR_CFG_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "ComM_Cfg.h"
+
+/* Period of PduR_MainFunction, the time base of the rate limits */
+#define PDUR_MAIN_FUNCTION_PERIOD_MS (1u)
+
+/* Longest PDU routed (CAN-FD) */
+#define PDUR_MAX_PDU_LENGTH          (64u)
+
+/* Largest direct-indexed source table of a channel, in entries; PduRGen
+ * refuses source IDs of one channel spread wider than this */
+#define PDUR_MAX_SOURCE_ENTRIES      (2048u)
+
+/*
+ * Routing description, expanded by PduRGen:
+ *
+ *   PDU(srcChannel, srcId, dstChannel, dstId, minIntervalMs)
+ *       forwards the PDU as received
+ *   SIGNAL(srcChannel, srcId, srcBit, bitLength, dstChannel, dstId, dstBit, minIntervalMs)
+ *       copies one signal of up to 32 bits into the destination PDU
+ *
+ * Bits are counted from the LSB of byte 0, little endian (DBC @1). A
+ * destination PDU composed of signals is as long as its last signal
+ * needs. Signals that all come from one source PDU at the same bit
+ * positions and cover the destination PDU without a gap are turned into a
+ * PDU route forwarding that many leading bytes of the source, as the
+ * layouts match. A PDU
+ * arriving less than minIntervalMs after the last one sent on its route
+ * is held, the latest replacing an earlier one, and sent when the
+ * interval has passed; 0 forwards every PDU.
+ */
+#define PDUR_ROUTING_TABLE(PDU, SIGNAL) \
+    /* MOTOR_STATUS to the Ethernet data logger, and every 10 ms on FlexRay */ \
+    PDU(COMM_CHANNEL_CAN, 101u, COMM_CHANNEL_ETH, 0x0401u, 0u) \
+    PDU(COMM_CHANNEL_CAN, 101u, COMM_CHANNEL_FR, 0x0021u, 10u) \
+    /* MOTOR_CONFIG to the data logger, same layout: bytes 0..5 without the
+     * E2E counter and CRC */ \
+    SIGNAL(COMM_CHANNEL_CAN, 102u, 0u, 16u, COMM_CHANNEL_ETH, 0x0402u, 0u, 0u) \
+    SIGNAL(COMM_CHANNEL_CAN, 102u, 16u, 16u, COMM_CHANNEL_ETH, 0x0402u, 16u, 0u) \
+    SIGNAL(COMM_CHANNEL_CAN, 102u, 32u, 16u, COMM_CHANNEL_ETH, 0x0402u, 32u, 0u) \
+    /* Dashboard frame 0x21 on LIN, at most every 50 ms per source: target
+     * speed and mode of MOTOR_CMD, actual speed and fault code of MOTOR_STATUS */ \
+    SIGNAL(COMM_CHANNEL_CAN, 100u, 0u, 16u, COMM_CHANNEL_LIN, 0x21u, 0u, 50u) \
+    SIGNAL(COMM_CHANNEL_CAN, 100u, 32u, 8u, COMM_CHANNEL_LIN, 0x21u, 16u, 50u) \
+    SIGNAL(COMM_CHANNEL_CAN, 101u, 0u, 16u, COMM_CHANNEL_LIN, 0x21u, 24u, 50u) \
+    SIGNAL(COMM_CHANNEL_CAN, 101u, 32u, 8u, COMM_CHANNEL_LIN, 0x21u, 40u, 50u) \
+    /* Speed limit from the Ethernet tester to bytes 2..3 of FlexRay slot 0x22 */ \
+    SIGNAL(COMM_CHANNEL_ETH, 0x0410u, 0u, 16u, COMM_CHANNEL_FR, 0x0022u, 16u, 0u)
+
+/* Signal copied by a signal route */
+typedef struct {
+    uint16 srcBit;
+    uint16 dstBit;
+    uint8 bitLength;             /* 1..32 */
+} PduR_SignalType;
+
+/* Route from one source PDU to one destination PDU */
+typedef struct {
+    uint8 dstChannel;
+    uint16 dstId;
+    uint16 minIntervalMs;        /* 0: not limited */
+    uint16 firstSignal;          /* Index into PduR_Signals */
+    uint8 signalCount;           /* 0: PDU route, forwarded as received */
+    uint8 minSrcLength;          /* Shorter source PDUs are not routed */
+    uint8 dstLength;             /* Signal routes: length of the composed PDU;
+                                    PDU routes: leading bytes forwarded, 0: all */
+    uint8 *buffer;               /* Composed PDU, shared by the routes to it, or the
+                                    held PDU of a limited PDU route; NULL_PTR: none */
+} PduR_RouteType;
+
+/* Runtime state of a route */
+typedef struct {
+    uint32 lastSentMs;
+    boolean pending;             /* Held by the rate limit */
+    uint8 heldLength;
+} PduR_RouteStateType;
+
+/* Routes of one source PDU, consecutive in PduR_Routes */
+typedef struct {
+    uint16 firstRoute;
+    uint8 routeCount;            /* 0: not routed */
+} PduR_SourceType;
+
+/* Direct-indexed source table of a channel */
+typedef struct {
+    const PduR_SourceType *sources;   /* Indexed by source ID - baseId */
+    uint16 baseId;
+    uint16 idCount;                   /* 0: nothing routed from the channel */
+} PduR_ChannelTableType;
+
+/* Route tables, generated by Tools/PduRGen (PduR_Routes.c) */
+extern const PduR_SignalType PduR_Signals[];
+extern const PduR_RouteType PduR_Routes[];
+extern PduR_RouteStateType PduR_RouteState[];
+extern const uint16 PduR_RouteCount;
+extern const PduR_ChannelTableType PduR_ChannelTable[COMM_MAX_CHANNELS];
+
+/* Bus receive interrupts and the tick share the route state and buffers */
+#if defined(HOST_SIM)
+#define PDUR_ENTER_CRITICAL()
+#define PDUR_EXIT_CRITICAL()
+#else
+#include "Gpt.h"
+#define PDUR_ENTER_CRITICAL()        Gpt_DisableNotification(GPT_CHANNEL_0)
+#define PDUR_EXIT_CRITICAL()         Gpt_EnableNotification(GPT_CHANNEL_0)
+#endif
+
+#endif /* PDUR_CFG_H */
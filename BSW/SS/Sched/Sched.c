@@ -0,0 +1,346 @@
+/*
+ * Sched.c - Rate Group Scheduler Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the implementation of the rate group
+ *              scheduler for Infineon TC377.
+ *              Releases are counted down per group, so the base tick does
+ *              no division. Every completed run adds its own time to a
+ *              running total of executed time; a run that was preempted
+ *              finds the runs that preempted it in the growth of that total
+ *              and subtracts them, so each group is charged only for its
+ *              own execution, however deeply the runs nest.
+ */
+
+#include "Sched.h"
+#include "Det.h"
+#include "Tm.h"
+
+/* Raise the software interrupt of a rate group (general purpose service
+ * request on the TC377, or host simulation) */
+extern void SchedHw_TriggerGroup(uint8 group);
+
+/* Single-instruction read-modify-write on state shared between rates
+ * (swap.w and the LDMST instructions on the TC377) */
+#if defined(__GNUC__)
+#define SCHED_EXCHANGE(ptr, value)    __atomic_exchange_n((ptr), (value), __ATOMIC_ACQ_REL)
+#define SCHED_FETCH_ADD(ptr, value)   (void)__atomic_fetch_add((ptr), (value), __ATOMIC_RELAXED)
+#else
+#error "Sched requires atomic exchange support"
+#endif
+
+/* Middle buffer word of an exchange: index and "not yet read" flag */
+#define SCHED_EXCHANGE_INDEX          (0x3u)
+#define SCHED_EXCHANGE_FRESH          (0x4u)
+
+/* Run-time state of one rate group */
+typedef struct {
+    Sched_RunnableType runnables[SCHED_MAX_RUNNABLES];
+    uint32 runnableCount;
+    boolean enabled;                 /* Valid release pattern */
+    uint32 countdown;                /* Base ticks to the next release */
+    volatile boolean pending;        /* Released, not yet completed */
+    volatile uint32 releaseTick;     /* Tm tick of the last release */
+    volatile uint32 busyTicks;       /* Execution time in the current window */
+    uint32 releases;
+    uint32 overruns;
+    uint16 load;
+    uint16 peakLoad;
+    uint32 maxExecTicks;
+    uint32 maxResponseTicks;
+} Sched_GroupType;
+
+/* Internal variables */
+static boolean Sched_Initialized = FALSE;
+static Sched_GroupType Sched_Groups[SCHED_MAX_GROUPS];
+static volatile uint32 Sched_ExecutedTicks = 0u;    /* Own time of all completed runs */
+static uint32 Sched_WindowStart = 0u;
+static uint32 Sched_WindowCount = 0u;
+
+/**
+ * @brief   Charge a completed run to its group
+ * @details The total is read before the end tick: a run that preempts in
+ *          between is then counted in the elapsed time but not subtracted,
+ *          so the result can only be too long by that run, never negative.
+ */
+static void Sched_Account(Sched_GroupType *group, uint32 start, uint32 executedAtStart)
+{
+    uint32 executed = Sched_ExecutedTicks;
+    uint32 end = Tm_GetTicks32();
+    uint32 own = (end - start) - (executed - executedAtStart);
+    uint32 response = end - group->releaseTick;
+
+    SCHED_FETCH_ADD(&Sched_ExecutedTicks, own);
+    SCHED_FETCH_ADD(&group->busyTicks, own);
+    if (own > group->maxExecTicks)
+    {
+        group->maxExecTicks = own;
+    }
+    if (response > group->maxResponseTicks)
+    {
+        group->maxResponseTicks = response;
+    }
+}
+
+/**
+ * @brief   Turn the execution time of the window into the load per group
+ */
+static void Sched_CloseWindow(void)
+{
+    uint32 now = Tm_GetTicks32();
+    uint32 window = now - Sched_WindowStart;
+    uint32 busy;
+    uint32 load;
+
+    Sched_WindowStart = now;
+    Sched_WindowCount = 0u;
+    for (uint32 g = 0; g < SCHED_MAX_GROUPS; g++)
+    {
+        busy = SCHED_EXCHANGE(&Sched_Groups[g].busyTicks, 0u);
+        load = (window > 0u) ? (uint32)(((uint64)busy * 1000u) / window) : 0u;
+        Sched_Groups[g].load = (uint16)((load < 1000u) ? load : 1000u);
+        if (Sched_Groups[g].load > Sched_Groups[g].peakLoad)
+        {
+            Sched_Groups[g].peakLoad = Sched_Groups[g].load;
+        }
+    }
+}
+
+/**
+ * @brief   Initialize the scheduler
+ */
+void Sched_Init(void)
+{
+    const Sched_GroupConfigType *config;
+
+    for (uint32 g = 0; g < SCHED_MAX_GROUPS; g++)
+    {
+        config = &Sched_GroupConfig[g];
+        Sched_Groups[g].runnableCount = 0u;
+        Sched_Groups[g].enabled = (config->divider > 0u && config->offset < config->divider &&
+                                   (g > 0u || config->divider == 1u)) ? TRUE : FALSE;
+        if (Sched_Groups[g].enabled == FALSE)
+        {
+            Det_ReportError(SCHED_MODULE_ID, 0, SCHED_INIT_SID, SCHED_E_PARAM_CONFIG);
+        }
+        Sched_Groups[g].countdown = config->offset + 1u;
+        Sched_Groups[g].pending = FALSE;
+        Sched_Groups[g].releaseTick = 0u;
+        Sched_Groups[g].busyTicks = 0u;
+        Sched_Groups[g].releases = 0u;
+        Sched_Groups[g].overruns = 0u;
+        Sched_Groups[g].load = 0u;
+        Sched_Groups[g].peakLoad = 0u;
+        Sched_Groups[g].maxExecTicks = 0u;
+        Sched_Groups[g].maxResponseTicks = 0u;
+    }
+    Sched_ExecutedTicks = 0u;
+    Sched_WindowStart = Tm_GetTicks32();
+    Sched_WindowCount = 0u;
+    Sched_Initialized = TRUE;
+}
+
+/**
+ * @brief   Append a runnable to a rate group
+ */
+Std_ReturnType Sched_AddRunnable(uint8 group, Sched_RunnableType runnable)
+{
+    if (Sched_Initialized == FALSE)
+    {
+        Det_ReportError(SCHED_MODULE_ID, 0, SCHED_ADD_RUNNABLE_SID, SCHED_E_UNINIT);
+        return E_NOT_OK;
+    }
+    if (group >= SCHED_MAX_GROUPS)
+    {
+        Det_ReportError(SCHED_MODULE_ID, 0, SCHED_ADD_RUNNABLE_SID, SCHED_E_PARAM_GROUP);
+        return E_NOT_OK;
+    }
+    if (runnable == NULL_PTR)
+    {
+        Det_ReportError(SCHED_MODULE_ID, 0, SCHED_ADD_RUNNABLE_SID, SCHED_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+    if (Sched_Groups[group].runnableCount >= SCHED_MAX_RUNNABLES)
+    {
+        Det_ReportError(SCHED_MODULE_ID, 0, SCHED_ADD_RUNNABLE_SID, SCHED_E_FULL);
+        return E_NOT_OK;
+    }
+
+    Sched_Groups[group].runnables[Sched_Groups[group].runnableCount] = runnable;
+    Sched_Groups[group].runnableCount++;
+    return E_OK;
+}
+
+/**
+ * @brief   Base tick: run group 0, release the slower groups due
+ */
+void Sched_Tick(void)
+{
+    Sched_GroupType *group = &Sched_Groups[SCHED_GROUP_CURRENT];
+    uint32 executed = Sched_ExecutedTicks;
+    uint32 start = Tm_GetTicks32();
+
+    if (Sched_Initialized == FALSE)
+    {
+        Det_ReportError(SCHED_MODULE_ID, 0, SCHED_TICK_SID, SCHED_E_UNINIT);
+        return;
+    }
+
+    /* Group 0 first: the shortest delay from the sample to the PWM update */
+    group->releaseTick = start;
+    group->releases++;
+    for (uint32 r = 0; r < group->runnableCount; r++)
+    {
+        group->runnables[r]();
+    }
+
+    for (uint32 g = 1u; g < SCHED_MAX_GROUPS; g++)
+    {
+        group = &Sched_Groups[g];
+        if (group->enabled == FALSE)
+        {
+            continue;
+        }
+        group->countdown--;
+        if (group->countdown == 0u)
+        {
+            group->countdown = Sched_GroupConfig[g].divider;
+            group->releases++;
+            if (group->pending == TRUE)
+            {
+                /* Still queued or running: one request, as in the service request node */
+                group->overruns++;
+            }
+            else
+            {
+                group->releaseTick = start;
+                group->pending = TRUE;
+                SchedHw_TriggerGroup((uint8)g);
+            }
+        }
+    }
+
+    Sched_Account(&Sched_Groups[SCHED_GROUP_CURRENT], start, executed);
+
+    Sched_WindowCount++;
+    if (Sched_WindowCount >= SCHED_LOAD_WINDOW_TICKS)
+    {
+        Sched_CloseWindow();
+    }
+}
+
+/**
+ * @brief   Run the runnables of a released group
+ */
+void Sched_RunGroup(uint8 group)
+{
+    Sched_GroupType *state;
+    uint32 executed = Sched_ExecutedTicks;
+    uint32 start = Tm_GetTicks32();
+
+    if (Sched_Initialized == FALSE)
+    {
+        Det_ReportError(SCHED_MODULE_ID, 0, SCHED_RUN_GROUP_SID, SCHED_E_UNINIT);
+        return;
+    }
+    if (group == SCHED_GROUP_CURRENT || group >= SCHED_MAX_GROUPS)
+    {
+        Det_ReportError(SCHED_MODULE_ID, 0, SCHED_RUN_GROUP_SID, SCHED_E_PARAM_GROUP);
+        return;
+    }
+
+    state = &Sched_Groups[group];
+    for (uint32 r = 0; r < state->runnableCount; r++)
+    {
+        state->runnables[r]();
+    }
+    Sched_Account(state, start, executed);
+    state->pending = FALSE;
+}
+
+/**
+ * @brief   Statistics of a rate group
+ */
+Std_ReturnType Sched_GetGroupStatistics(uint8 group, Sched_GroupStatisticsType *stats)
+{
+    if (group >= SCHED_MAX_GROUPS)
+    {
+        Det_ReportError(SCHED_MODULE_ID, 0, SCHED_GET_STATISTICS_SID, SCHED_E_PARAM_GROUP);
+        return E_NOT_OK;
+    }
+    if (stats == NULL_PTR)
+    {
+        Det_ReportError(SCHED_MODULE_ID, 0, SCHED_GET_STATISTICS_SID, SCHED_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+
+    stats->releases = Sched_Groups[group].releases;
+    stats->overruns = Sched_Groups[group].overruns;
+    stats->load = Sched_Groups[group].load;
+    stats->peakLoad = Sched_Groups[group].peakLoad;
+    stats->maxExecTicks = Sched_Groups[group].maxExecTicks;
+    stats->maxResponseTicks = Sched_Groups[group].maxResponseTicks;
+    return E_OK;
+}
+
+/**
+ * @brief   Set up an exchange on caller-provided storage
+ */
+void Sched_ExchangeInit(Sched_ExchangeType *exchange, void *buffers, uint32 size)
+{
+    if (exchange == NULL_PTR || buffers == NULL_PTR)
+    {
+        Det_ReportError(SCHED_MODULE_ID, 0, SCHED_EXCHANGE_INIT_SID, SCHED_E_PARAM_POINTER);
+        return;
+    }
+
+    exchange->buffers = (uint8 *)buffers;
+    exchange->size = size;
+    exchange->back = 0u;
+    exchange->middle = 1u;
+    exchange->front = 2u;
+    exchange->published = 0u;
+    for (uint32 i = 0; i < 3u; i++)
+    {
+        exchange->sequence[i] = 0u;
+    }
+}
+
+/**
+ * @brief   Buffer for the next record
+ */
+void *Sched_ExchangeWriteBuffer(Sched_ExchangeType *exchange)
+{
+    return &exchange->buffers[exchange->back * exchange->size];
+}
+
+/**
+ * @brief   Make the record in the write buffer the newest one
+ * @details The swap publishes the record and hands the writer the buffer
+ *          the reader has not taken, or its own last one back.
+ */
+void Sched_ExchangePublish(Sched_ExchangeType *exchange)
+{
+    exchange->published++;
+    exchange->sequence[exchange->back] = exchange->published;
+    exchange->back = SCHED_EXCHANGE(&exchange->middle, exchange->back | SCHED_EXCHANGE_FRESH) &
+                     SCHED_EXCHANGE_INDEX;
+}
+
+/**
+ * @brief   Newest complete record
+ */
+const void *Sched_ExchangeRead(Sched_ExchangeType *exchange, uint32 *sequence)
+{
+    if ((exchange->middle & SCHED_EXCHANGE_FRESH) != 0u)
+    {
+        exchange->front = SCHED_EXCHANGE(&exchange->middle, exchange->front) & SCHED_EXCHANGE_INDEX;
+    }
+    if (sequence != NULL_PTR)
+    {
+        *sequence = exchange->sequence[exchange->front];
+    }
+    return &exchange->buffers[exchange->front * exchange->size];
+}
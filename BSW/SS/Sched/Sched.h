@@ -0,0 +1,152 @@
+/*
+ * Sched.h - Rate Group Scheduler Interface
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface definition for the
+ *              rate group scheduler for Infineon TC377. One hardware
+ *              interrupt, the base tick, runs the fastest rate group and
+ *              releases the slower groups with their divider and phase
+ *              offset into software interrupts of lower priority, so they
+ *              run outside the base tick and are preempted by it. Each
+ *              group's execution time is accounted without the time of the
+ *              groups that preempted it. Data passes between rates through
+ *              lock-free exchanges.
+ */
+
+#ifndef SCHED_H
+#define SCHED_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "Sched_Cfg.h"
+
+/* AUTOSAR Version information */
+#define SCHED_VENDOR_ID                   (0x1234)
+#define SCHED_MODULE_ID                   (0x0103)
+#define SCHED_AR_RELEASE_MAJOR_VERSION    (4)
+#define SCHED_AR_RELEASE_MINOR_VERSION    (4)
+#define SCHED_AR_RELEASE_REVISION_VERSION (0)
+#define SCHED_SW_MAJOR_VERSION            (1)
+#define SCHED_SW_MINOR_VERSION            (0)
+#define SCHED_SW_PATCH_VERSION            (0)
+
+/* Check AUTOSAR version compatibility */
+#if ((STD_AR_RELEASE_MAJOR_VERSION != SCHED_AR_RELEASE_MAJOR_VERSION) || \
+     (STD_AR_RELEASE_MINOR_VERSION != SCHED_AR_RELEASE_MINOR_VERSION))
+#error "AUTOSAR version mismatch between Sched.h and Std_Types.h"
+#endif
+
+/* API service IDs */
+#define SCHED_INIT_SID                    (0x00u)
+#define SCHED_ADD_RUNNABLE_SID            (0x01u)
+#define SCHED_TICK_SID                    (0x02u)
+#define SCHED_RUN_GROUP_SID               (0x03u)
+#define SCHED_GET_STATISTICS_SID          (0x04u)
+#define SCHED_EXCHANGE_INIT_SID           (0x05u)
+
+/* Error codes */
+#define SCHED_E_UNINIT                    (0x01u)
+#define SCHED_E_PARAM_GROUP               (0x02u)
+#define SCHED_E_PARAM_POINTER             (0x03u)
+#define SCHED_E_PARAM_CONFIG              (0x04u)
+#define SCHED_E_FULL                      (0x05u)
+
+/* Function run by a rate group */
+typedef void (*Sched_RunnableType)(void);
+
+/* Statistics of one rate group */
+typedef struct {
+    uint32 releases;             /* Releases since Sched_Init */
+    uint32 overruns;             /* Releases lost because the previous one had not finished */
+    uint16 load;                 /* CPU load of the last complete window in 0.1 % */
+    uint16 peakLoad;             /* Highest window since Sched_Init in 0.1 % */
+    uint32 maxExecTicks;         /* Longest run without preemption, Tm ticks */
+    uint32 maxResponseTicks;     /* Longest release to completion, Tm ticks */
+} Sched_GroupStatisticsType;
+
+/*
+ * Single-writer, single-reader exchange of one fixed-size record between
+ * two rates, as a triple buffer: the writer fills its own buffer and swaps
+ * it with the middle one, the reader swaps the middle one with its own if
+ * it is newer. Neither side waits or retries, whichever preempts the other,
+ * and the reader always sees a complete record. Members are private.
+ */
+typedef struct {
+    uint8 *buffers;                  /* Three records of size bytes */
+    uint32 size;
+    volatile uint32 middle;          /* Middle buffer index, SCHED_EXCHANGE_FRESH if not yet read */
+    uint32 back;                     /* Buffer of the writer */
+    uint32 front;                    /* Buffer of the reader */
+    uint32 published;                /* Records published */
+    uint32 sequence[3];              /* Publication number of the record in each buffer */
+} Sched_ExchangeType;
+
+/* Function prototypes */
+
+/**
+ * @brief   Initialize the scheduler; all groups without runnables
+ * @details Requires Tm to be initialized. Groups with an invalid release
+ *          pattern in Sched_Cfg.c are never released.
+ */
+void Sched_Init(void);
+
+/**
+ * @brief   Append a runnable to a rate group
+ * @details Runnables of a group run in the order they were added. Only
+ *          before the base tick is started.
+ * @return  E_NOT_OK if the group is full
+ */
+Std_ReturnType Sched_AddRunnable(uint8 group, Sched_RunnableType runnable);
+
+/**
+ * @brief   Base tick
+ * @details Called from the base tick interrupt every SCHED_BASE_PERIOD_NS.
+ *          Runs group 0, then releases the slower groups due on this tick.
+ *          A group still pending or running from its previous release
+ *          counts an overrun instead.
+ */
+void Sched_Tick(void);
+
+/**
+ * @brief   Run the runnables of a released group
+ * @details Called from the software interrupt of the group, triggered by
+ *          Sched_Tick through SchedHw_TriggerGroup.
+ */
+void Sched_RunGroup(uint8 group);
+
+/**
+ * @brief   Statistics of a rate group
+ * @details The load of a group is its execution time per window without
+ *          preemption by higher groups. Interrupts outside the scheduler
+ *          that preempt a group are counted in its time.
+ */
+Std_ReturnType Sched_GetGroupStatistics(uint8 group, Sched_GroupStatisticsType *stats);
+
+/**
+ * @brief   Set up an exchange on caller-provided storage
+ * @param   buffers  Storage for three records of size bytes
+ */
+void Sched_ExchangeInit(Sched_ExchangeType *exchange, void *buffers, uint32 size);
+
+/**
+ * @brief   Buffer for the next record, written in place by the writer
+ * @details The buffer holds an older record; the writer must write all of
+ *          it before Sched_ExchangePublish.
+ */
+void *Sched_ExchangeWriteBuffer(Sched_ExchangeType *exchange);
+
+/* Make the record in the write buffer the newest one */
+void Sched_ExchangePublish(Sched_ExchangeType *exchange);
+
+/**
+ * @brief   Newest complete record, read in place by the reader
+ * @details The record stays valid and unchanged until the reader's next
+ *          call. Called from the reader's rate only.
+ * @param   sequence  Publication number of the record, 0 before the first
+ *                    one; NULL_PTR if not needed
+ */
+const void *Sched_ExchangeRead(Sched_ExchangeType *exchange, uint32 *sequence);
+
+#endif /* SCHED_H */
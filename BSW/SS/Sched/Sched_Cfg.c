@@ -0,0 +1,21 @@
+/*
+ * Sched_Cfg.c - Rate Group Scheduler Configuration Data
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the release pattern of the rate groups
+ *              of the motor control application for Infineon TC377.
+ */
+
+#include "Sched_Cfg.h"
+
+/* Rate groups */
+const Sched_GroupConfigType Sched_GroupConfig[SCHED_MAX_GROUPS] = {
+    /* Current loop, every PWM period */
+    {1u, 0u},
+    /* Speed loop, 1 kHz, one tick after the period start */
+    {20u, 1u},
+    /* Supervision, 100 Hz, clear of the speed loop releases */
+    {200u, 3u}
+};
@@ -0,0 +1,46 @@
+/*
+ * Sched_Cfg.h - Rate Group Scheduler Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the rate groups of the motor control
+ *              application and their release pattern on the base tick,
+ *              for Infineon TC377
+ */
+
+#ifndef SCHED_CFG_H
+#define SCHED_CFG_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+
+/* Base tick: the group 0 conversion complete interrupt, sampled at the
+ * center of every PWM period (20 kHz) */
+#define SCHED_BASE_PERIOD_NS               (50000u)
+
+/* Rate groups, highest priority first. Group 0 runs in the base tick
+ * interrupt; the others run in software interrupts of descending priority
+ * below it (general purpose service requests on the TC377). */
+#define SCHED_GROUP_CURRENT                (0u)    /* 20 kHz current loop */
+#define SCHED_GROUP_SPEED                  (1u)    /* 1 kHz speed loop */
+#define SCHED_GROUP_SUPERVISION            (2u)    /* 100 Hz supervision */
+#define SCHED_MAX_GROUPS                   (3u)
+
+/* Runnables per rate group */
+#define SCHED_MAX_RUNNABLES                (8u)
+
+/* CPU load is computed over windows of this many base ticks (100 ms) */
+#define SCHED_LOAD_WINDOW_TICKS            (2000u)
+
+/* Release pattern of a rate group: released on base tick n when
+ * n % divider == offset. Offsets keep the slower groups from being released
+ * on the same tick, so they do not queue behind each other. */
+typedef struct {
+    uint32 divider;              /* Base ticks per release, 1 for group 0 */
+    uint32 offset;               /* Phase, 0 .. divider - 1 */
+} Sched_GroupConfigType;
+
+extern const Sched_GroupConfigType Sched_GroupConfig[SCHED_MAX_GROUPS];
+
+#endif /* SCHED_CFG_H */
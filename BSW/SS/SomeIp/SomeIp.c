@@ -0,0 +1,352 @@
+/*
+ * SomeIp.c - SOME/IP Serialization Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the serializer, the deserializer and
+ *              the event publisher of the motor control service for
+ *              Infineon TC377. SomeIp_Init builds the 16-byte header of
+ *              every message once; sending copies it into the transmit
+ *              buffer of the driver, sets the session ID and writes the
+ *              fields behind it by the layout of SomeIp_Cfg.c, without an
+ *              intermediate buffer.
+ */
+
+#include <string.h>
+
+#include "SomeIp.h"
+#include "Det.h"
+
+/* Ethernet driver (UDP socket; HostSim/EthHw on the host) */
+extern Std_ReturnType EthHw_Init(void);
+extern Std_ReturnType EthHw_ProvideTxBuffer(uint8 **buffer, uint16 length);
+extern Std_ReturnType EthHw_Transmit(uint16 length);
+extern Std_ReturnType EthHw_Receive(const uint8 **data, uint16 *length);
+
+/* Header bytes */
+#define SOMEIP_OFFSET_LENGTH         (4u)
+#define SOMEIP_OFFSET_SESSION        (10u)
+#define SOMEIP_OFFSET_PROTOCOL       (12u)
+#define SOMEIP_OFFSET_INTERFACE      (13u)
+#define SOMEIP_OFFSET_TYPE           (14u)
+
+/* The length field counts from the request ID on */
+#define SOMEIP_LENGTH_BASE           (8u)
+
+/* Internal variables */
+static const SomeIp_StatisticsType SomeIp_NoStatistics = {0};
+static boolean SomeIp_Initialized = FALSE;
+static uint8 SomeIp_Header[SOMEIP_MAX_MESSAGES][SOMEIP_HEADER_LENGTH];
+static uint16 SomeIp_Session[SOMEIP_MAX_MESSAGES];
+static uint32 SomeIp_Values[SOMEIP_MAX_MESSAGES][SOMEIP_MAX_FIELDS];
+static boolean SomeIp_NewValues[SOMEIP_MAX_MESSAGES];
+static SomeIp_StatisticsType SomeIp_Statistics;
+
+static uint32 SomeIp_Read(const uint8 *data, uint8 size)
+{
+    uint32 value = 0u;
+
+    for (uint8 i = 0; i < size; i++)
+    {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+static void SomeIp_Write(uint8 *data, uint8 size, uint32 value)
+{
+    for (uint8 i = size; i > 0u; i--)
+    {
+        data[i - 1u] = (uint8)value;
+        value >>= 8;
+    }
+}
+
+/**
+ * @brief   Serialize a message into the driver's transmit buffer and send it
+ */
+static Std_ReturnType SomeIp_Send(uint8 msg, const uint32 *values)
+{
+    const SomeIp_MessageConfigType *config = &SomeIp_MessageConfig[msg];
+    uint16 length = (uint16)(SOMEIP_HEADER_LENGTH + config->payloadLength);
+    uint8 *buffer;
+    uint8 *payload;
+
+    if (SomeIp_Initialized == FALSE)
+    {
+        Det_ReportError(SOMEIP_MODULE_ID, 0, SOMEIP_SEND_SID, SOMEIP_E_UNINIT);
+        return E_NOT_OK;
+    }
+    if (EthHw_ProvideTxBuffer(&buffer, length) != E_OK)
+    {
+        SomeIp_Statistics.txRefused++;
+        return E_NOT_OK;
+    }
+
+    (void)memcpy(buffer, SomeIp_Header[msg], SOMEIP_HEADER_LENGTH);
+    SomeIp_Write(&buffer[SOMEIP_OFFSET_SESSION], 2u, SomeIp_Session[msg]);
+    SomeIp_Session[msg] = (SomeIp_Session[msg] == 0xFFFFu) ? 1u : (uint16)(SomeIp_Session[msg] + 1u);
+
+    payload = &buffer[SOMEIP_HEADER_LENGTH];
+    for (uint8 f = 0; f < config->fieldCount; f++)
+    {
+        SomeIp_Write(&payload[config->fields[f].offset], config->fields[f].size, values[f]);
+    }
+
+    if (EthHw_Transmit(length) != E_OK)
+    {
+        SomeIp_Statistics.txRefused++;
+        return E_NOT_OK;
+    }
+    SomeIp_Statistics.txMessages++;
+    return E_OK;
+}
+
+/**
+ * @brief   Check the header of a received message and read its fields in place
+ */
+static void SomeIp_RxIndication(const uint8 *data, uint16 length)
+{
+    const SomeIp_MessageConfigType *config;
+    const uint8 *payload = &data[SOMEIP_HEADER_LENGTH];
+    uint16 methodId;
+    uint8 msg;
+
+    if (length < SOMEIP_HEADER_LENGTH ||
+        SomeIp_Read(&data[SOMEIP_OFFSET_LENGTH], 4u) != (uint32)length - SOMEIP_LENGTH_BASE ||
+        data[SOMEIP_OFFSET_PROTOCOL] != SOMEIP_PROTOCOL_VERSION)
+    {
+        SomeIp_Statistics.rxMalformed++;
+        return;
+    }
+
+    methodId = (uint16)SomeIp_Read(&data[2], 2u);
+    for (msg = 0; msg < SOMEIP_MAX_MESSAGES; msg++)
+    {
+        if (SomeIp_MessageConfig[msg].methodId == methodId)
+        {
+            break;
+        }
+    }
+    if (SomeIp_Read(data, 2u) != SOMEIP_SERVICE_ID || msg == SOMEIP_MAX_MESSAGES ||
+        data[SOMEIP_OFFSET_TYPE] != SomeIp_MessageConfig[msg].messageType)
+    {
+        SomeIp_Statistics.rxUnknown++;
+        return;
+    }
+
+    config = &SomeIp_MessageConfig[msg];
+    if (data[SOMEIP_OFFSET_INTERFACE] != SOMEIP_INTERFACE_VERSION ||
+        length != SOMEIP_HEADER_LENGTH + config->payloadLength)
+    {
+        SomeIp_Statistics.rxMalformed++;
+        return;
+    }
+
+    for (uint8 f = 0; f < config->fieldCount; f++)
+    {
+        SomeIp_Values[msg][f] = SomeIp_Read(&payload[config->fields[f].offset], config->fields[f].size);
+    }
+    SomeIp_NewValues[msg] = TRUE;
+    SomeIp_Statistics.rxMessages++;
+}
+
+/**
+ * @brief   Take the latest values of a received message
+ */
+static Std_ReturnType SomeIp_Get(uint8 msg, uint32 *values)
+{
+    if (SomeIp_Initialized == FALSE)
+    {
+        Det_ReportError(SOMEIP_MODULE_ID, 0, SOMEIP_GET_SID, SOMEIP_E_UNINIT);
+        return E_NOT_OK;
+    }
+    if (SomeIp_NewValues[msg] == FALSE)
+    {
+        return E_NOT_OK;
+    }
+
+    for (uint8 f = 0; f < SomeIp_MessageConfig[msg].fieldCount; f++)
+    {
+        values[f] = SomeIp_Values[msg][f];
+    }
+    SomeIp_NewValues[msg] = FALSE;
+    return E_OK;
+}
+
+/**
+ * @brief   Build the header templates and start the driver
+ */
+void SomeIp_Init(void)
+{
+    const SomeIp_MessageConfigType *config;
+    uint8 *header;
+
+    for (uint8 msg = 0; msg < SOMEIP_MAX_MESSAGES; msg++)
+    {
+        config = &SomeIp_MessageConfig[msg];
+        header = SomeIp_Header[msg];
+        SomeIp_Write(&header[0], 2u, SOMEIP_SERVICE_ID);
+        SomeIp_Write(&header[2], 2u, config->methodId);
+        SomeIp_Write(&header[SOMEIP_OFFSET_LENGTH], 4u, SOMEIP_LENGTH_BASE + config->payloadLength);
+        SomeIp_Write(&header[8], 2u, SOMEIP_CLIENT_ID);
+        SomeIp_Write(&header[SOMEIP_OFFSET_SESSION], 2u, 0u);
+        header[SOMEIP_OFFSET_PROTOCOL] = SOMEIP_PROTOCOL_VERSION;
+        header[SOMEIP_OFFSET_INTERFACE] = SOMEIP_INTERFACE_VERSION;
+        header[SOMEIP_OFFSET_TYPE] = config->messageType;
+        header[15] = SOMEIP_E_OK;
+
+        SomeIp_Session[msg] = 1u;
+        SomeIp_NewValues[msg] = FALSE;
+    }
+    SomeIp_Statistics = SomeIp_NoStatistics;
+
+    if (EthHw_Init() != E_OK)
+    {
+        Det_ReportError(SOMEIP_MODULE_ID, 0, SOMEIP_INIT_SID, SOMEIP_E_INIT_FAILED);
+        SomeIp_Initialized = FALSE;
+        return;
+    }
+    SomeIp_Initialized = TRUE;
+}
+
+/**
+ * @brief   Deserialize all received messages
+ */
+void SomeIp_MainFunction(void)
+{
+    const uint8 *data;
+    uint16 length;
+
+    if (SomeIp_Initialized == FALSE)
+    {
+        Det_ReportError(SOMEIP_MODULE_ID, 0, SOMEIP_MAIN_FUNCTION_SID, SOMEIP_E_UNINIT);
+        return;
+    }
+
+    while (EthHw_Receive(&data, &length) == E_OK)
+    {
+        SomeIp_RxIndication(data, length);
+    }
+}
+
+/**
+ * @brief   Get the serialization statistics
+ */
+Std_ReturnType SomeIp_GetStatistics(SomeIp_StatisticsType *statistics)
+{
+    if (statistics == NULL_PTR)
+    {
+        Det_ReportError(SOMEIP_MODULE_ID, 0, SOMEIP_GET_STATISTICS_SID, SOMEIP_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+    *statistics = SomeIp_Statistics;
+    return E_OK;
+}
+
+/**
+ * @brief   Send a MOTOR_CMD request
+ * @return  E_NOT_OK if the driver has no transmit buffer free
+ */
+Std_ReturnType SomeIp_SendMotorCmd(uint16 speed, sint16 torque, uint8 mode)
+{
+    const uint32 values[SOMEIP_MAX_FIELDS] = {speed, (uint16)torque, mode};
+
+    return SomeIp_Send(SOMEIP_MSG_MOTOR_CMD, values);
+}
+
+/**
+ * @brief   Send a MOTOR_CONFIG request
+ * @return  E_NOT_OK if the driver has no transmit buffer free
+ */
+Std_ReturnType SomeIp_SendMotorConfig(uint16 maxSpeed, sint16 maxTorque, sint16 acceleration)
+{
+    const uint32 values[SOMEIP_MAX_FIELDS] = {maxSpeed, (uint16)maxTorque, (uint16)acceleration};
+
+    return SomeIp_Send(SOMEIP_MSG_MOTOR_CONFIG, values);
+}
+
+/**
+ * @brief   Send a MOTOR_STATUS event
+ * @return  E_NOT_OK if the driver has no transmit buffer free
+ */
+Std_ReturnType SomeIp_SendMotorStatus(uint16 speed, sint16 torque, uint8 fault)
+{
+    const uint32 values[SOMEIP_MAX_FIELDS] = {speed, (uint16)torque, fault};
+
+    return SomeIp_Send(SOMEIP_MSG_MOTOR_STATUS, values);
+}
+
+/**
+ * @brief   Latest MOTOR_STATUS event
+ * @return  E_OK if an event arrived since the last call
+ */
+Std_ReturnType SomeIp_GetMotorStatus(uint16 *speed, sint16 *torque, uint8 *fault)
+{
+    uint32 values[SOMEIP_MAX_FIELDS];
+
+    if (SomeIp_Get(SOMEIP_MSG_MOTOR_STATUS, values) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+    if (speed != NULL_PTR)
+    {
+        *speed = (uint16)values[0];
+    }
+    if (torque != NULL_PTR)
+    {
+        *torque = (sint16)(uint16)values[1];
+    }
+    if (fault != NULL_PTR)
+    {
+        *fault = (uint8)values[2];
+    }
+    return E_OK;
+}
+
+/**
+ * @brief   Latest MOTOR_CMD request
+ * @return  E_OK if a request arrived since the last call
+ */
+Std_ReturnType SomeIp_GetMotorCmd(uint16 *speed, sint16 *torque, uint8 *mode)
+{
+    uint32 values[SOMEIP_MAX_FIELDS];
+
+    if (SomeIp_Get(SOMEIP_MSG_MOTOR_CMD, values) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+    if (speed != NULL_PTR)
+    {
+        *speed = (uint16)values[0];
+    }
+    if (torque != NULL_PTR)
+    {
+        *torque = (sint16)(uint16)values[1];
+    }
+    if (mode != NULL_PTR)
+    {
+        *mode = (uint8)values[2];
+    }
+    return E_OK;
+}
+
+/**
+ * @brief   Get version information
+ */
+void SomeIp_GetVersionInfo(Std_VersionInfoType *versioninfo)
+{
+    if (versioninfo != NULL_PTR)
+    {
+        versioninfo->vendorID = SOMEIP_VENDOR_ID;
+        versioninfo->moduleID = SOMEIP_MODULE_ID;
+        versioninfo->sw_major_version = SOMEIP_SW_MAJOR_VERSION;
+        versioninfo->sw_minor_version = SOMEIP_SW_MINOR_VERSION;
+        versioninfo->sw_patch_version = SOMEIP_SW_PATCH_VERSION;
+    }
+    else
+    {
+        Det_ReportError(SOMEIP_MODULE_ID, 0, SOMEIP_GET_VERSION_INFO_SID, SOMEIP_E_PARAM_POINTER);
+    }
+}
@@ -0,0 +1,133 @@
+/*
+ * SomeIp.h - SOME/IP Serialization Interface
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface of the motor control
+ *              service on the Ethernet channel for Infineon TC377. Motor
+ *              commands and configuration are fire-and-forget methods, the
+ *              motor status an event. Messages are serialized straight into
+ *              the transmit buffer of the Ethernet driver and deserialized
+ *              in place from its receive buffer.
+ */
+
+#ifndef SOMEIP_H
+#define SOMEIP_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "SomeIp_Cfg.h"
+
+/* AUTOSAR Version information */
+#define SOMEIP_VENDOR_ID                    (0x1234)
+#define SOMEIP_MODULE_ID                    (0x00AE)
+#define SOMEIP_AR_RELEASE_MAJOR_VERSION     (4)
+#define SOMEIP_AR_RELEASE_MINOR_VERSION     (4)
+#define SOMEIP_AR_RELEASE_REVISION_VERSION  (0)
+#define SOMEIP_SW_MAJOR_VERSION             (1)
+#define SOMEIP_SW_MINOR_VERSION             (0)
+#define SOMEIP_SW_PATCH_VERSION             (0)
+
+/* Check AUTOSAR version compatibility */
+#if ((STD_AR_RELEASE_MAJOR_VERSION != SOMEIP_AR_RELEASE_MAJOR_VERSION) || \
+     (STD_AR_RELEASE_MINOR_VERSION != SOMEIP_AR_RELEASE_MINOR_VERSION))
+#error "AUTOSAR version mismatch between SomeIp.h and Std_Types.h"
+#endif
+
+/* API service IDs */
+#define SOMEIP_INIT_SID                     (0x01u)
+#define SOMEIP_SEND_SID                     (0x02u)
+#define SOMEIP_MAIN_FUNCTION_SID            (0x03u)
+#define SOMEIP_GET_SID                      (0x04u)
+#define SOMEIP_GET_STATISTICS_SID           (0x05u)
+#define SOMEIP_GET_VERSION_INFO_SID         (0x06u)
+
+/* Error codes */
+#define SOMEIP_E_UNINIT                     (0x01u)
+#define SOMEIP_E_PARAM_POINTER              (0x02u)
+#define SOMEIP_E_INIT_FAILED                (0x03u)
+
+/* SOME/IP header */
+#define SOMEIP_HEADER_LENGTH                (16u)
+#define SOMEIP_PROTOCOL_VERSION             (1u)
+
+/* Message types */
+#define SOMEIP_MT_REQUEST                   (0x00u)
+#define SOMEIP_MT_REQUEST_NO_RETURN         (0x01u)
+#define SOMEIP_MT_NOTIFICATION              (0x02u)
+#define SOMEIP_MT_RESPONSE                  (0x80u)
+#define SOMEIP_MT_ERROR                     (0x81u)
+
+/* Return code */
+#define SOMEIP_E_OK                         (0x00u)
+
+/* Serialization statistics */
+typedef struct {
+    uint32 txMessages;
+    uint32 txRefused;            /* No transmit buffer, or the driver refused */
+    uint32 rxMessages;           /* Deserialized */
+    uint32 rxMalformed;          /* Too short, wrong length, protocol or interface version */
+    uint32 rxUnknown;            /* Other service, method or message type */
+} SomeIp_StatisticsType;
+
+/* Function prototypes */
+
+/**
+ * @brief   Build the header templates of the messages and start the driver
+ */
+void SomeIp_Init(void);
+
+/**
+ * @brief   Deserialize all received messages; runs from the 1 ms tick
+ * @details The fields are read in place from the receive buffer of the
+ *          driver. The latest values of each message are kept until the
+ *          application reads them.
+ */
+void SomeIp_MainFunction(void);
+
+/**
+ * @brief   Get the serialization statistics
+ */
+Std_ReturnType SomeIp_GetStatistics(SomeIp_StatisticsType *statistics);
+
+/* Motor control service, client side (ECU1) */
+
+/**
+ * @brief   Send a MOTOR_CMD request
+ * @return  E_NOT_OK if the driver has no transmit buffer free
+ */
+Std_ReturnType SomeIp_SendMotorCmd(uint16 speed, sint16 torque, uint8 mode);
+
+/**
+ * @brief   Send a MOTOR_CONFIG request
+ * @return  E_NOT_OK if the driver has no transmit buffer free
+ */
+Std_ReturnType SomeIp_SendMotorConfig(uint16 maxSpeed, sint16 maxTorque, sint16 acceleration);
+
+/**
+ * @brief   Latest MOTOR_STATUS event
+ * @return  E_OK if an event arrived since the last call
+ */
+Std_ReturnType SomeIp_GetMotorStatus(uint16 *speed, sint16 *torque, uint8 *fault);
+
+/* Motor control service, server side (ECU2) */
+
+/**
+ * @brief   Send a MOTOR_STATUS event
+ * @return  E_NOT_OK if the driver has no transmit buffer free
+ */
+Std_ReturnType SomeIp_SendMotorStatus(uint16 speed, sint16 torque, uint8 fault);
+
+/**
+ * @brief   Latest MOTOR_CMD request
+ * @return  E_OK if a request arrived since the last call
+ */
+Std_ReturnType SomeIp_GetMotorCmd(uint16 *speed, sint16 *torque, uint8 *mode);
+
+/**
+ * @brief   Get version information
+ */
+void SomeIp_GetVersionInfo(Std_VersionInfoType *versioninfo);
+
+#endif /* SOMEIP_H */
@@ -0,0 +1,23 @@
+/*
+ * SomeIp_Cfg.c - SOME/IP Serialization Configuration Data
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the message layouts of the motor
+ *              control service for Infineon TC377. The fields carry the
+ *              signals of MotorControl.dbc in their raw units; the E2E
+ *              header of the CAN frames is not part of the payload.
+ */
+
+#include "SomeIp.h"
+
+/* Message layouts */
+const SomeIp_MessageConfigType SomeIp_MessageConfig[SOMEIP_MAX_MESSAGES] = {
+    /* MOTOR_CMD: target speed, target torque, control mode */
+    {0x0001u, SOMEIP_MT_REQUEST_NO_RETURN, 5u, 3u, {{0u, 2u}, {2u, 2u}, {4u, 1u}}},
+    /* MOTOR_CONFIG: max speed, max torque, acceleration */
+    {0x0002u, SOMEIP_MT_REQUEST_NO_RETURN, 6u, 3u, {{0u, 2u}, {2u, 2u}, {4u, 2u}}},
+    /* MOTOR_STATUS: actual speed, actual torque, fault code */
+    {0x8001u, SOMEIP_MT_NOTIFICATION, 5u, 3u, {{0u, 2u}, {2u, 2u}, {4u, 1u}}}
+};
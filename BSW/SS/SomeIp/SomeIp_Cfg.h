@@ -0,0 +1,56 @@
+/*
+ * SomeIp_Cfg.h - SOME/IP Serialization Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the motor control service on the
+ *              Ethernet channel for Infineon TC377: its IDs and the
+ *              payload layout of each message. Fields are big endian, as
+ *              SOME/IP serializes them, and follow each other without
+ *              padding.
+ */
+
+#ifndef SOMEIP_CFG_H
+#define SOMEIP_CFG_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+
+/* Motor control service */
+#define SOMEIP_SERVICE_ID            (0x1001u)
+#define SOMEIP_INTERFACE_VERSION     (1u)
+#define SOMEIP_CLIENT_ID             (0x0001u)   /* This ECU as a client */
+
+/* UDP port of the service (loopback); the host build may use UNIX
+ * datagram sockets instead, see EthHw */
+#define SOMEIP_UDP_PORT              (30501u)
+
+/* Messages */
+#define SOMEIP_MSG_MOTOR_CMD         (0u)    /* Method 0x0001, fire and forget */
+#define SOMEIP_MSG_MOTOR_CONFIG      (1u)    /* Method 0x0002, fire and forget */
+#define SOMEIP_MSG_MOTOR_STATUS      (2u)    /* Event 0x8001 */
+#define SOMEIP_MAX_MESSAGES          (3u)
+
+/* Most fields of a message */
+#define SOMEIP_MAX_FIELDS            (3u)
+
+/* Field of a payload */
+typedef struct {
+    uint8 offset;                /* Byte offset in the payload */
+    uint8 size;                  /* 1, 2 or 4 bytes */
+} SomeIp_FieldType;
+
+/* Message layout */
+typedef struct {
+    uint16 methodId;             /* Events from 0x8000 */
+    uint8 messageType;           /* SOMEIP_MT_* */
+    uint8 payloadLength;
+    uint8 fieldCount;
+    SomeIp_FieldType fields[SOMEIP_MAX_FIELDS];
+} SomeIp_MessageConfigType;
+
+/* Message layouts (SomeIp_Cfg.c) */
+extern const SomeIp_MessageConfigType SomeIp_MessageConfig[SOMEIP_MAX_MESSAGES];
+
+#endif /* SOMEIP_CFG_H */
@@ -0,0 +1,237 @@
+/*
+ * SwTmr.c - Software Timer Service Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the implementation of the
+ *              Software Timer module for Infineon TC377.
+ *              A timer is filed at the level of the highest slot index in
+ *              which its expiry differs from the current tick, in the slot
+ *              given by the expiry. Level 0 slots therefore hold timers
+ *              due within the current 256 ticks. Whenever the lower
+ *              indices of the current tick roll over to zero, the slot of
+ *              the next level that has become current is emptied and its
+ *              timers are filed again, one level lower or more. Every
+ *              timer is moved at most once per level.
+ */
+
+#include "SwTmr.h"
+#include "Det.h"
+
+#define SWTMR_SLOT_MASK           (SWTMR_SLOTS - 1u)
+
+/* Internal variables */
+static boolean SwTmr_Initialized = FALSE;
+static uint32 SwTmr_Now = 0u;
+static SwTmr_TimerType *SwTmr_Wheel[SWTMR_LEVELS][SWTMR_SLOTS];
+
+/**
+ * @brief   File a timer by its expiry relative to the current tick
+ */
+static void SwTmr_Insert(SwTmr_TimerType *timer)
+{
+    uint32 diff = timer->expiry ^ SwTmr_Now;
+    uint32 level = 0u;
+    SwTmr_TimerType **slot;
+
+    while ((diff >> (SWTMR_SLOT_BITS * (level + 1u))) != 0u && (level + 1u) < SWTMR_LEVELS)
+    {
+        level++;
+    }
+    slot = &SwTmr_Wheel[level][(timer->expiry >> (SWTMR_SLOT_BITS * level)) & SWTMR_SLOT_MASK];
+
+    timer->next = *slot;
+    if (timer->next != NULL_PTR)
+    {
+        timer->next->pprev = &timer->next;
+    }
+    timer->pprev = slot;
+    *slot = timer;
+}
+
+/**
+ * @brief   Unlink a running timer
+ */
+static void SwTmr_Remove(SwTmr_TimerType *timer)
+{
+    *timer->pprev = timer->next;
+    if (timer->next != NULL_PTR)
+    {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->next = NULL_PTR;
+    timer->pprev = NULL_PTR;
+}
+
+/**
+ * @brief   Refile the timers of a slot that has become current
+ */
+static void SwTmr_Cascade(uint32 level)
+{
+    SwTmr_TimerType **slot = &SwTmr_Wheel[level][(SwTmr_Now >> (SWTMR_SLOT_BITS * level)) & SWTMR_SLOT_MASK];
+    SwTmr_TimerType *timer = *slot;
+    SwTmr_TimerType *next;
+
+    *slot = NULL_PTR;
+    while (timer != NULL_PTR)
+    {
+        next = timer->next;
+        SwTmr_Insert(timer);
+        timer = next;
+    }
+}
+
+/**
+ * @brief   Initialize the Software Timer module
+ */
+void SwTmr_Init(void)
+{
+    if (SwTmr_Initialized == FALSE)
+    {
+        for (uint32 level = 0; level < SWTMR_LEVELS; level++)
+        {
+            for (uint32 slot = 0; slot < SWTMR_SLOTS; slot++)
+            {
+                SwTmr_Wheel[level][slot] = NULL_PTR;
+            }
+        }
+        SwTmr_Now = 0u;
+        SwTmr_Initialized = TRUE;
+    }
+    else
+    {
+        Det_ReportError(SWTMR_MODULE_ID, 0, SWTMR_INIT_SID, DET_E_ALREADY_INITIALIZED);
+    }
+}
+
+/**
+ * @brief   Bind a timer object to its callback
+ */
+void SwTmr_Setup(SwTmr_TimerType *timer, SwTmr_CallbackType callback, uint32 arg)
+{
+    if (timer == NULL_PTR || callback == NULL_PTR)
+    {
+        Det_ReportError(SWTMR_MODULE_ID, 0, SWTMR_SETUP_SID, SWTMR_E_PARAM_POINTER);
+        return;
+    }
+
+    timer->next = NULL_PTR;
+    timer->pprev = NULL_PTR;
+    timer->expiry = 0u;
+    timer->period = 0u;
+    timer->callback = callback;
+    timer->arg = arg;
+}
+
+/**
+ * @brief   Start or restart a timer
+ */
+Std_ReturnType SwTmr_Start(SwTmr_TimerType *timer, uint32 delay, uint32 period)
+{
+    if (SwTmr_Initialized == FALSE)
+    {
+        Det_ReportError(SWTMR_MODULE_ID, 0, SWTMR_START_SID, SWTMR_E_UNINIT);
+        return E_NOT_OK;
+    }
+    if (timer == NULL_PTR || timer->callback == NULL_PTR)
+    {
+        Det_ReportError(SWTMR_MODULE_ID, 0, SWTMR_START_SID, SWTMR_E_PARAM_POINTER);
+        return E_NOT_OK;
+    }
+    if (delay > SWTMR_MAX_DELAY || period > SWTMR_MAX_DELAY)
+    {
+        Det_ReportError(SWTMR_MODULE_ID, 0, SWTMR_START_SID, SWTMR_E_PARAM_DELAY);
+        return E_NOT_OK;
+    }
+
+    SWTMR_ENTER_CRITICAL();
+    if (timer->pprev != NULL_PTR)
+    {
+        SwTmr_Remove(timer);
+    }
+    timer->expiry = SwTmr_Now + ((delay > 0u) ? delay : 1u);
+    timer->period = period;
+    SwTmr_Insert(timer);
+    SWTMR_EXIT_CRITICAL();
+
+    return E_OK;
+}
+
+/**
+ * @brief   Stop a timer
+ */
+void SwTmr_Stop(SwTmr_TimerType *timer)
+{
+    if (timer == NULL_PTR)
+    {
+        Det_ReportError(SWTMR_MODULE_ID, 0, SWTMR_STOP_SID, SWTMR_E_PARAM_POINTER);
+        return;
+    }
+
+    SWTMR_ENTER_CRITICAL();
+    if (timer->pprev != NULL_PTR)
+    {
+        SwTmr_Remove(timer);
+    }
+    SWTMR_EXIT_CRITICAL();
+}
+
+/**
+ * @brief   Check whether a timer is running
+ */
+boolean SwTmr_IsRunning(const SwTmr_TimerType *timer)
+{
+    return (timer != NULL_PTR && timer->pprev != NULL_PTR) ? TRUE : FALSE;
+}
+
+/**
+ * @brief   Get the ticks since initialization
+ */
+uint32 SwTmr_GetTicks(void)
+{
+    return SwTmr_Now;
+}
+
+/**
+ * @brief   Advance the wheel by one tick and run the expired callbacks
+ */
+void SwTmr_MainFunction(void)
+{
+    SwTmr_TimerType **slot;
+    SwTmr_TimerType *timer;
+
+    if (SwTmr_Initialized == FALSE)
+    {
+        Det_ReportError(SWTMR_MODULE_ID, 0, SWTMR_MAIN_FUNCTION_SID, SWTMR_E_UNINIT);
+        return;
+    }
+
+    SwTmr_Now++;
+
+    /* Refile the next level's current slot whenever the lower indices roll over */
+    for (uint32 level = 1u; level < SWTMR_LEVELS; level++)
+    {
+        if ((SwTmr_Now & ((1u << (SWTMR_SLOT_BITS * level)) - 1u)) != 0u)
+        {
+            break;
+        }
+        SwTmr_Cascade(level);
+    }
+
+    /* Everything in the current level 0 slot is due now. Callbacks may start
+     * and stop timers; none can be filed into this slot again before the
+     * wheel has turned once. */
+    slot = &SwTmr_Wheel[0][SwTmr_Now & SWTMR_SLOT_MASK];
+    while (*slot != NULL_PTR)
+    {
+        timer = *slot;
+        SwTmr_Remove(timer);
+        if (timer->period != 0u)
+        {
+            timer->expiry += timer->period;
+            SwTmr_Insert(timer);
+        }
+        timer->callback(timer->arg);
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * SwTmr.h - Software Timer Service Interface
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface definition for the
+ *              Software Timer module for Infineon TC377. Timers are
+ *              statically allocated by their users and kept in a
+ *              hierarchical timing wheel on the 1 ms tick: start, stop and
+ *              expiry are O(1), so the cost per tick does not depend on
+ *              the number of running timers.
+ */
+
+#ifndef SWTMR_H
+#define SWTMR_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "SwTmr_Cfg.h"
+
+/* AUTOSAR Version information */
+#define SWTMR_VENDOR_ID                   (0x1234)
+#define SWTMR_MODULE_ID                   (0x0100)
+#define SWTMR_AR_RELEASE_MAJOR_VERSION    (4)
+#define SWTMR_AR_RELEASE_MINOR_VERSION    (4)
+#define SWTMR_AR_RELEASE_REVISION_VERSION (0)
+#define SWTMR_SW_MAJOR_VERSION            (1)
+#define SWTMR_SW_MINOR_VERSION            (0)
+#define SWTMR_SW_PATCH_VERSION            (0)
+
+/* Check AUTOSAR version compatibility */
+#if ((STD_AR_RELEASE_MAJOR_VERSION != SWTMR_AR_RELEASE_MAJOR_VERSION) || \
+     (STD_AR_RELEASE_MINOR_VERSION != SWTMR_AR_RELEASE_MINOR_VERSION))
+#error "AUTOSAR version mismatch between SwTmr.h and Std_Types.h"
+#endif
+
+/* API service IDs */
+#define SWTMR_INIT_SID                    (0x00u)
+#define SWTMR_SETUP_SID                   (0x01u)
+#define SWTMR_START_SID                   (0x02u)
+#define SWTMR_STOP_SID                    (0x03u)
+#define SWTMR_MAIN_FUNCTION_SID           (0x04u)
+
+/* Error codes */
+#define SWTMR_E_UNINIT                    (0x01u)
+#define SWTMR_E_PARAM_POINTER             (0x02u)
+#define SWTMR_E_PARAM_DELAY               (0x03u)
+
+/* Expiry callback, called from SwTmr_MainFunction */
+typedef void (*SwTmr_CallbackType)(uint32 arg);
+
+/* Timer object, owned by the user; members are private to SwTmr */
+typedef struct SwTmr_TimerTag {
+    struct SwTmr_TimerTag *next;
+    struct SwTmr_TimerTag **pprev;    /* Link pointing here, NULL_PTR if stopped */
+    uint32 expiry;                    /* Absolute tick */
+    uint32 period;                    /* 0: one-shot */
+    SwTmr_CallbackType callback;
+    uint32 arg;
+} SwTmr_TimerType;
+
+/* Function prototypes */
+
+/**
+ * @brief   Initialize the Software Timer module with an empty wheel
+ */
+void SwTmr_Init(void);
+
+/**
+ * @brief   Bind a timer object to its callback; the timer is stopped
+ */
+void SwTmr_Setup(SwTmr_TimerType *timer, SwTmr_CallbackType callback, uint32 arg);
+
+/**
+ * @brief   Start or restart a timer
+ * @details The callback runs delay ticks from now (at least one), then
+ *          every period ticks if period is not 0. May be called from
+ *          callbacks.
+ * @param   delay   1 .. SWTMR_MAX_DELAY ticks, 0 is treated as 1
+ * @param   period  0 .. SWTMR_MAX_DELAY ticks
+ */
+Std_ReturnType SwTmr_Start(SwTmr_TimerType *timer, uint32 delay, uint32 period);
+
+/**
+ * @brief   Stop a timer; stopping a stopped timer has no effect
+ */
+void SwTmr_Stop(SwTmr_TimerType *timer);
+
+boolean SwTmr_IsRunning(const SwTmr_TimerType *timer);
+
+/* Ticks since SwTmr_Init */
+uint32 SwTmr_GetTicks(void);
+
+/**
+ * @brief   Advance the wheel by one tick and run the expired callbacks
+ * @details Must be called every SWTMR_TICK_MS.
+ */
+void SwTmr_MainFunction(void);
+
+#endif /* SWTMR_H */
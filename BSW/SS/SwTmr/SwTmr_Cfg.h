@@ -0,0 +1,44 @@
+/*
+ * SwTmr_Cfg.h - Software Timer Service Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the timing wheel geometry and the tick
+ *              interrupt lock of the Software Timer module for Infineon
+ *              TC377
+ */
+
+#ifndef SWTMR_CFG_H
+#define SWTMR_CFG_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+
+/* Period of SwTmr_MainFunction (1 ms system tick, GPT channel 0) */
+#define SWTMR_TICK_MS                      (1u)
+
+/* Wheel geometry: levels of 2^SWTMR_SLOT_BITS slots covering the 32-bit tick */
+#define SWTMR_SLOT_BITS                    (8u)
+#define SWTMR_LEVELS                       (4u)
+#define SWTMR_SLOTS                        (1u << SWTMR_SLOT_BITS)
+
+#if (SWTMR_SLOT_BITS * SWTMR_LEVELS != 32u)
+#error "SwTmr wheel levels must cover exactly 32 bits"
+#endif
+
+/* Longest delay or period in ticks (24.8 days at 1 ms) */
+#define SWTMR_MAX_DELAY                    (0x80000000u)
+
+/* Wheel updates outside the tick lock the tick notification; the host
+ * simulation runs timers and the tick in one context */
+#if defined(HOST_SIM)
+#define SWTMR_ENTER_CRITICAL()
+#define SWTMR_EXIT_CRITICAL()
+#else
+#include "Gpt.h"
+#define SWTMR_ENTER_CRITICAL()             Gpt_DisableNotification(GPT_CHANNEL_0)
+#define SWTMR_EXIT_CRITICAL()              Gpt_EnableNotification(GPT_CHANNEL_0)
+#endif
+
+#endif /* SWTMR_CFG_H */
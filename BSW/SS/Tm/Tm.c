@@ -0,0 +1,151 @@
+/*
+ * Tm.c - AUTOSAR Time Service Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the implementation of the
+ *              Time Service module for Infineon TC377.
+ *              Tm_MainFunction publishes the upper word together with the
+ *              timer value it was derived from. Readers combine the
+ *              published pair with a fresh timer read: if the timer is
+ *              below the published value, it wrapped since, and the upper
+ *              word is one higher.
+ *
+ *              The pair is kept twice and a sequence counter selects the
+ *              copy that is not being written (a seqlock latch), so a
+ *              reader that interrupts the writer on the same core reads
+ *              the other, consistent copy instead of spinning on it.
+ */
+
+#include "Tm.h"
+#include "Det.h"
+
+/* Hardware timer (STM0 lower word, or host simulation) */
+extern uint32 TmHw_GetCounter(void);
+
+/* Order the accesses to the shared state as seen from other cores: the
+ * writer's stores and the reader's loads (dsync on the TC377) */
+#if defined(__GNUC__)
+#define TM_WRITE_BARRIER()        __atomic_thread_fence(__ATOMIC_RELEASE)
+#define TM_READ_BARRIER()         __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#else
+#define TM_WRITE_BARRIER()
+#define TM_READ_BARRIER()
+#endif
+
+/* Upper word and the timer value it is valid from */
+typedef struct {
+    uint32 high;
+    uint32 low;
+} Tm_ExtensionType;
+
+/* Internal variables */
+static boolean Tm_Initialized = FALSE;
+static volatile uint32 Tm_Sequence = 0u;
+static volatile Tm_ExtensionType Tm_Extension[2];
+
+/**
+ * @brief   Publish a new extension pair, copy 0 first, then copy 1
+ */
+static void Tm_Publish(uint32 high, uint32 low)
+{
+    /* Odd: readers use copy 1 while copy 0 is written */
+    Tm_Sequence++;
+    TM_WRITE_BARRIER();
+    Tm_Extension[0].high = high;
+    Tm_Extension[0].low = low;
+    TM_WRITE_BARRIER();
+
+    /* Even: readers use copy 0 while copy 1 is written */
+    Tm_Sequence++;
+    TM_WRITE_BARRIER();
+    Tm_Extension[1].high = high;
+    Tm_Extension[1].low = low;
+    TM_WRITE_BARRIER();
+}
+
+/**
+ * @brief   Initialize the Time Service module
+ */
+void Tm_Init(void)
+{
+    if (Tm_Initialized == FALSE)
+    {
+        Tm_Publish(0u, TmHw_GetCounter());
+        Tm_Initialized = TRUE;
+    }
+    else
+    {
+        Det_ReportError(TM_MODULE_ID, 0, TM_INIT_SID, DET_E_ALREADY_INITIALIZED);
+    }
+}
+
+/**
+ * @brief   Account for hardware timer wraps
+ */
+void Tm_MainFunction(void)
+{
+    uint32 now;
+    uint32 high;
+
+    if (Tm_Initialized == FALSE)
+    {
+        Det_ReportError(TM_MODULE_ID, 0, TM_MAIN_FUNCTION_SID, TM_E_UNINIT);
+        return;
+    }
+
+    /* Only this function writes, so copy 1 is current here */
+    now = TmHw_GetCounter();
+    high = Tm_Extension[1].high;
+    if (now < Tm_Extension[1].low)
+    {
+        high++;
+    }
+    Tm_Publish(high, now);
+}
+
+/**
+ * @brief   Get the 64-bit monotonic tick count
+ */
+uint64 Tm_GetTicks(void)
+{
+    uint32 sequence;
+    uint32 high;
+    uint32 low;
+    uint32 now;
+
+    do
+    {
+        sequence = Tm_Sequence;
+        TM_READ_BARRIER();
+        high = Tm_Extension[sequence & 1u].high;
+        low = Tm_Extension[sequence & 1u].low;
+        /* Inside the check, so the timer is read within one wrap of low */
+        now = TmHw_GetCounter();
+        TM_READ_BARRIER();
+    } while (sequence != Tm_Sequence);
+
+    if (now < low)
+    {
+        high++;
+    }
+
+    return ((uint64)high << 32) | now;
+}
+
+/**
+ * @brief   Get the monotonic time in nanoseconds
+ */
+uint64 Tm_GetTimeNs(void)
+{
+    return TM_TICKS_TO_NS(Tm_GetTicks());
+}
+
+/**
+ * @brief   Get the lower 32 bits of the tick count
+ */
+uint32 Tm_GetTicks32(void)
+{
+    return TmHw_GetCounter();
+}
@@ -0,0 +1,78 @@
+/*
+ * Tm.h - AUTOSAR Time Service Interface
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface definition for the
+ *              Time Service module for Infineon TC377. The module extends
+ *              the 32-bit hardware timer to a 64-bit monotonic tick count
+ *              that ISRs, tasks and other cores read without locks.
+ */
+
+#ifndef TM_H
+#define TM_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "Tm_Cfg.h"
+
+/* AUTOSAR Version information */
+#define TM_VENDOR_ID                      (0x1234)
+#define TM_MODULE_ID                      (0x0082)
+#define TM_AR_RELEASE_MAJOR_VERSION       (4)
+#define TM_AR_RELEASE_MINOR_VERSION       (4)
+#define TM_AR_RELEASE_REVISION_VERSION    (0)
+#define TM_SW_MAJOR_VERSION               (1)
+#define TM_SW_MINOR_VERSION               (0)
+#define TM_SW_PATCH_VERSION               (0)
+
+/* Check AUTOSAR version compatibility */
+#if ((STD_AR_RELEASE_MAJOR_VERSION != TM_AR_RELEASE_MAJOR_VERSION) || \
+     (STD_AR_RELEASE_MINOR_VERSION != TM_AR_RELEASE_MINOR_VERSION))
+#error "AUTOSAR version mismatch between Tm.h and Std_Types.h"
+#endif
+
+/* API service IDs */
+#define TM_INIT_SID                       (0x00u)
+#define TM_MAIN_FUNCTION_SID              (0x01u)
+
+/* Error codes */
+#define TM_E_UNINIT                       (0x01u)
+
+/* Function prototypes */
+
+/**
+ * @brief   Initialize the Time Service
+ * @details The 64-bit count continues from the current hardware timer
+ *          value with an upper word of zero.
+ */
+void Tm_Init(void);
+
+/**
+ * @brief   Account for hardware timer wraps
+ * @details Must be called every TM_MAIN_FUNCTION_PERIOD_MS from one
+ *          context only. It is the only writer of the shared state.
+ */
+void Tm_MainFunction(void);
+
+/**
+ * @brief   Get the 64-bit monotonic tick count
+ * @details Lock-free: callable from any task, ISR or core, including an
+ *          ISR that interrupted Tm_MainFunction. A reader only retries
+ *          if Tm_MainFunction completed an update on another core while
+ *          it was reading.
+ */
+uint64 Tm_GetTicks(void);
+
+/* Monotonic time in nanoseconds, Tm_GetTicks converted */
+uint64 Tm_GetTimeNs(void);
+
+/**
+ * @brief   Get the lower 32 bits of the tick count
+ * @details A single timer read, for intervals shorter than the timer
+ *          range (42.9 s) measured with wrap-safe unsigned subtraction.
+ */
+uint32 Tm_GetTicks32(void);
+
+#endif /* TM_H */
@@ -0,0 +1,47 @@
+/*
+ * Tm_Cfg.h - AUTOSAR Time Service Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the hardware timer parameters of the
+ *              Time Service module for Infineon TC377 and the compile-time
+ *              conversions between timer ticks and physical units
+ */
+
+#ifndef TM_CFG_H
+#define TM_CFG_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+
+/* Free-running hardware timer (STM0 lower word at 100 MHz) */
+#define TM_TICKS_PER_SECOND                (100000000u)
+
+/* Period of Tm_MainFunction (1 ms system tick) */
+#define TM_MAIN_FUNCTION_PERIOD_MS         (1u)
+
+/* The 32-bit timer must not wrap twice between two Tm_MainFunction calls;
+ * half its range leaves room for a late tick */
+#if ((TM_TICKS_PER_SECOND / 1000u) * TM_MAIN_FUNCTION_PERIOD_MS >= 0x80000000u)
+#error "Tm_MainFunction period exceeds half the timer range"
+#endif
+
+/* Conversions from physical units to ticks; constant arguments fold at compile time */
+#define TM_S_TO_TICKS(s)                   ((uint64)(s) * TM_TICKS_PER_SECOND)
+#define TM_MS_TO_TICKS(ms)                 ((uint64)(ms) * TM_TICKS_PER_SECOND / 1000u)
+#define TM_US_TO_TICKS(us)                 ((uint64)(us) * TM_TICKS_PER_SECOND / 1000000u)
+#define TM_NS_TO_TICKS(ns)                 ((uint64)(ns) * TM_TICKS_PER_SECOND / 1000000000u)
+
+/* Conversion from ticks to nanoseconds, a single multiplication if a tick
+ * is a whole number of nanoseconds */
+#if ((1000000000u % TM_TICKS_PER_SECOND) == 0u)
+#define TM_TICKS_TO_NS(t)                  ((uint64)(t) * (1000000000u / TM_TICKS_PER_SECOND))
+#else
+#define TM_TICKS_TO_NS(t)                  (((uint64)(t) / TM_TICKS_PER_SECOND) * 1000000000u + \
+                                            ((uint64)(t) % TM_TICKS_PER_SECOND) * 1000000000u / \
+                                            TM_TICKS_PER_SECOND)
+#endif
+#define TM_TICKS_TO_US(t)                  ((uint64)(t) / (TM_TICKS_PER_SECOND / 1000000u))
+
+#endif /* TM_CFG_H */
@@ -0,0 +1,398 @@
+/*
+ * WdgM.c - AUTOSAR Watchdog Manager Implementation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the implementation of the
+ *              Watchdog Manager module for Infineon TC377.
+ *              WdgM_CheckpointReached only bumps counters and, for
+ *              deadline checkpoints, reads the timer; everything else is
+ *              evaluated in WdgM_MainFunction. Each counter has exactly
+ *              one writer, so no locks are needed between the two.
+ */
+
+#include "WdgM.h"
+#include "Det.h"
+#include "Tm.h"
+
+/* Watchdog driver (hardware or host simulation) */
+extern void WdgHw_Trigger(void);
+
+#define WDGM_NO_DEADLINE          (0xFFu)
+#define WDGM_ALL_CHECKPOINTS      (0xFFFFFFFFu)
+
+/* Run-time state of a supervised entity */
+typedef struct {
+    boolean active;
+    WdgM_LocalStatusType status;
+    /* Written by WdgM_CheckpointReached only */
+    uint32 aliveCount[WDGM_MAX_CHECKPOINTS];
+    uint32 allowedNext;
+    uint32 flowErrors;
+    uint32 deadlineErrors;
+    uint32 deadlineStart[WDGM_MAX_CHECKPOINTS];
+    boolean deadlineOpen[WDGM_MAX_CHECKPOINTS];
+    /* Written by WdgM_MainFunction and WdgM_SetMode only */
+    uint32 aliveSeen[WDGM_MAX_CHECKPOINTS];
+    uint16 aliveCycle[WDGM_MAX_CHECKPOINTS];
+    boolean aliveSkip[WDGM_MAX_CHECKPOINTS];
+    uint32 flowErrorsSeen;
+    uint32 deadlineErrorsSeen;
+} WdgM_EntityStateType;
+
+/* Internal variables */
+static boolean WdgM_Initialized = FALSE;
+static WdgM_GlobalStatusType WdgM_GlobalStatus = WDGM_GLOBAL_STATUS_DEACTIVATED;
+static WdgM_EntityStateType WdgM_EntityState[WDGM_MAX_ENTITIES];
+
+/* Per-checkpoint lookups built from the configuration at init */
+static uint32 WdgM_Successors[WDGM_MAX_ENTITIES][WDGM_MAX_CHECKPOINTS];
+static uint8 WdgM_DeadlineStarts[WDGM_MAX_ENTITIES][WDGM_MAX_CHECKPOINTS];
+static uint8 WdgM_DeadlineEnds[WDGM_MAX_ENTITIES][WDGM_MAX_CHECKPOINTS];
+
+/**
+ * @brief   Build the per-checkpoint successor and deadline lookups
+ */
+static void WdgM_BuildLookups(void)
+{
+    const WdgM_EntityConfigType *config;
+
+    for (uint8 se = 0; se < WDGM_MAX_ENTITIES; se++)
+    {
+        config = &WdgM_EntityConfig[se];
+        for (uint8 cp = 0; cp < WDGM_MAX_CHECKPOINTS; cp++)
+        {
+            if ((config->successors != NULL_PTR) && (cp < config->checkpoints))
+            {
+                WdgM_Successors[se][cp] = config->successors[cp];
+            }
+            else
+            {
+                WdgM_Successors[se][cp] = WDGM_ALL_CHECKPOINTS;
+            }
+            WdgM_DeadlineStarts[se][cp] = WDGM_NO_DEADLINE;
+            WdgM_DeadlineEnds[se][cp] = WDGM_NO_DEADLINE;
+        }
+        for (uint8 d = 0; d < config->deadlineCount; d++)
+        {
+            WdgM_DeadlineStarts[se][config->deadline[d].startCheckpoint] = d;
+            WdgM_DeadlineEnds[se][config->deadline[d].endCheckpoint] = d;
+        }
+    }
+}
+
+/**
+ * @brief   Start supervising an entity from a clean state
+ */
+static void WdgM_ActivateEntity(uint8 seId)
+{
+    const WdgM_EntityConfigType *config = &WdgM_EntityConfig[seId];
+    WdgM_EntityStateType *state = &WdgM_EntityState[seId];
+
+    state->allowedNext = (config->successors != NULL_PTR) ? config->initialCheckpoints
+                                                          : WDGM_ALL_CHECKPOINTS;
+    for (uint8 d = 0; d < WDGM_MAX_CHECKPOINTS; d++)
+    {
+        state->deadlineOpen[d] = FALSE;
+    }
+    for (uint8 a = 0; a < config->aliveCount; a++)
+    {
+        state->aliveSeen[a] = state->aliveCount[config->alive[a].checkpoint];
+        state->aliveCycle[a] = 0u;
+        state->aliveSkip[a] = TRUE;
+    }
+    state->flowErrorsSeen = state->flowErrors;
+    state->deadlineErrorsSeen = state->deadlineErrors;
+    state->status = WDGM_LOCAL_STATUS_OK;
+    state->active = TRUE;
+}
+
+/**
+ * @brief   Evaluate the supervisions of an active entity
+ * @return  TRUE if every supervision passed
+ */
+static boolean WdgM_EvaluateEntity(uint8 seId)
+{
+    const WdgM_EntityConfigType *config = &WdgM_EntityConfig[seId];
+    WdgM_EntityStateType *state = &WdgM_EntityState[seId];
+    const WdgM_AliveSupervisionType *alive;
+    boolean ok = TRUE;
+    uint32 count;
+    uint32 now;
+
+    /* Logical supervision */
+    if (state->flowErrors != state->flowErrorsSeen)
+    {
+        state->flowErrorsSeen = state->flowErrors;
+        ok = FALSE;
+    }
+
+    /* Deadline supervision: closed out of range, or still open past the maximum */
+    if (state->deadlineErrors != state->deadlineErrorsSeen)
+    {
+        state->deadlineErrorsSeen = state->deadlineErrors;
+        ok = FALSE;
+    }
+    if (config->deadlineCount > 0u)
+    {
+        now = Tm_GetTicks32();
+        for (uint8 d = 0; d < config->deadlineCount; d++)
+        {
+            if ((state->deadlineOpen[d] == TRUE) &&
+                ((now - state->deadlineStart[d]) > config->deadline[d].maxTicks))
+            {
+                ok = FALSE;
+            }
+        }
+    }
+
+    /* Alive supervision, once per reference cycle */
+    for (uint8 a = 0; a < config->aliveCount; a++)
+    {
+        alive = &config->alive[a];
+        state->aliveCycle[a]++;
+        if (state->aliveCycle[a] >= alive->referenceCycles)
+        {
+            state->aliveCycle[a] = 0u;
+            count = state->aliveCount[alive->checkpoint] - state->aliveSeen[a];
+            state->aliveSeen[a] = state->aliveCount[alive->checkpoint];
+            if (state->aliveSkip[a] == TRUE)
+            {
+                state->aliveSkip[a] = FALSE;
+            }
+            else if ((count < alive->minCount) || (count > alive->maxCount))
+            {
+                ok = FALSE;
+            }
+        }
+    }
+
+    return ok;
+}
+
+/**
+ * @brief   Initialize the Watchdog Manager module
+ */
+void WdgM_Init(void)
+{
+    if (WdgM_Initialized == FALSE)
+    {
+        WdgM_BuildLookups();
+        for (uint8 se = 0; se < WDGM_MAX_ENTITIES; se++)
+        {
+            WdgM_EntityState[se].active = FALSE;
+            WdgM_EntityState[se].status = WDGM_LOCAL_STATUS_DEACTIVATED;
+        }
+        WdgM_GlobalStatus = WDGM_GLOBAL_STATUS_OK;
+        WdgM_Initialized = TRUE;
+        (void)WdgM_SetMode(WDGM_MODE_IDLE);
+    }
+    else
+    {
+        Det_ReportError(WDGM_MODULE_ID, 0, WDGM_INIT_SID, DET_E_ALREADY_INITIALIZED);
+    }
+}
+
+/**
+ * @brief   Switch the set of supervised entities
+ */
+Std_ReturnType WdgM_SetMode(uint8 mode)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    boolean wanted;
+
+    if (WdgM_Initialized == FALSE)
+    {
+        Det_ReportError(WDGM_MODULE_ID, 0, WDGM_SET_MODE_SID, WDGM_E_UNINIT);
+    }
+    else if (mode >= WDGM_MAX_MODES)
+    {
+        Det_ReportError(WDGM_MODULE_ID, 0, WDGM_SET_MODE_SID, WDGM_E_PARAM_MODE);
+    }
+    else
+    {
+        for (uint8 se = 0; se < WDGM_MAX_ENTITIES; se++)
+        {
+            wanted = ((WdgM_ModeEntities[mode] & ((uint32)1u << se)) != 0u) ? TRUE : FALSE;
+            if ((wanted == TRUE) && (WdgM_EntityState[se].active == FALSE))
+            {
+                WdgM_ActivateEntity(se);
+            }
+            else if ((wanted == FALSE) && (WdgM_EntityState[se].active == TRUE))
+            {
+                WdgM_EntityState[se].active = FALSE;
+                WdgM_EntityState[se].status = WDGM_LOCAL_STATUS_DEACTIVATED;
+            }
+        }
+        retVal = E_OK;
+    }
+
+    return retVal;
+}
+
+/**
+ * @brief   Report a checkpoint of a supervised entity
+ */
+void WdgM_CheckpointReached(uint8 seId, uint8 cpId)
+{
+    WdgM_EntityStateType *state;
+    uint8 deadline;
+    uint32 now = 0u;
+    uint32 elapsed;
+
+    if (seId >= WDGM_MAX_ENTITIES)
+    {
+        Det_ReportError(WDGM_MODULE_ID, 0, WDGM_CHECKPOINT_REACHED_SID, WDGM_E_PARAM_SEID);
+        return;
+    }
+    if (cpId >= WdgM_EntityConfig[seId].checkpoints)
+    {
+        Det_ReportError(WDGM_MODULE_ID, 0, WDGM_CHECKPOINT_REACHED_SID, WDGM_E_CPID);
+        return;
+    }
+
+    state = &WdgM_EntityState[seId];
+    if (state->active == FALSE)
+    {
+        return;
+    }
+
+    /* Alive indication */
+    state->aliveCount[cpId]++;
+
+    /* Logical supervision: was this checkpoint allowed after the previous one? */
+    if ((state->allowedNext & ((uint32)1u << cpId)) == 0u)
+    {
+        state->flowErrors++;
+    }
+    state->allowedNext = WdgM_Successors[seId][cpId];
+
+    /* Deadline supervision; an end without a start is a flow error */
+    deadline = WdgM_DeadlineEnds[seId][cpId];
+    if (deadline != WDGM_NO_DEADLINE)
+    {
+        now = Tm_GetTicks32();
+        if (state->deadlineOpen[deadline] == TRUE)
+        {
+            elapsed = now - state->deadlineStart[deadline];
+            if ((elapsed < WdgM_EntityConfig[seId].deadline[deadline].minTicks) ||
+                (elapsed > WdgM_EntityConfig[seId].deadline[deadline].maxTicks))
+            {
+                state->deadlineErrors++;
+            }
+            state->deadlineOpen[deadline] = FALSE;
+        }
+    }
+    deadline = WdgM_DeadlineStarts[seId][cpId];
+    if (deadline != WDGM_NO_DEADLINE)
+    {
+        if (WdgM_DeadlineEnds[seId][cpId] == WDGM_NO_DEADLINE)
+        {
+            now = Tm_GetTicks32();
+        }
+        state->deadlineStart[deadline] = now;
+        state->deadlineOpen[deadline] = TRUE;
+    }
+}
+
+/**
+ * @brief   Evaluate the supervisions and trigger the watchdog
+ */
+void WdgM_MainFunction(void)
+{
+    boolean healthy = TRUE;
+
+    if (WdgM_Initialized == FALSE)
+    {
+        Det_ReportError(WDGM_MODULE_ID, 0, WDGM_MAIN_FUNCTION_SID, WDGM_E_UNINIT);
+        return;
+    }
+
+    for (uint8 se = 0; se < WDGM_MAX_ENTITIES; se++)
+    {
+        if (WdgM_EntityState[se].active == TRUE)
+        {
+            if ((WdgM_EvaluateEntity(se) == FALSE) ||
+                (WdgM_EntityState[se].status == WDGM_LOCAL_STATUS_EXPIRED))
+            {
+                WdgM_EntityState[se].status = WDGM_LOCAL_STATUS_EXPIRED;
+                healthy = FALSE;
+            }
+        }
+    }
+
+    if ((healthy == FALSE) && (WdgM_GlobalStatus == WDGM_GLOBAL_STATUS_OK))
+    {
+        WdgM_GlobalStatus = WDGM_GLOBAL_STATUS_EXPIRED;
+    }
+
+    /* Only a fully healthy ECU keeps the watchdog from expiring */
+    if (WdgM_GlobalStatus == WDGM_GLOBAL_STATUS_OK)
+    {
+        WdgHw_Trigger();
+    }
+}
+
+/**
+ * @brief   Get the local status of a supervised entity
+ */
+Std_ReturnType WdgM_GetLocalStatus(uint8 seId, WdgM_LocalStatusType *status)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+
+    if (WdgM_Initialized == FALSE)
+    {
+        Det_ReportError(WDGM_MODULE_ID, 0, WDGM_GET_LOCAL_STATUS_SID, WDGM_E_UNINIT);
+    }
+    else if (seId >= WDGM_MAX_ENTITIES)
+    {
+        Det_ReportError(WDGM_MODULE_ID, 0, WDGM_GET_LOCAL_STATUS_SID, WDGM_E_PARAM_SEID);
+    }
+    else if (status == NULL_PTR)
+    {
+        Det_ReportError(WDGM_MODULE_ID, 0, WDGM_GET_LOCAL_STATUS_SID, WDGM_E_PARAM_POINTER);
+    }
+    else
+    {
+        *status = WdgM_EntityState[seId].status;
+        retVal = E_OK;
+    }
+
+    return retVal;
+}
+
+/**
+ * @brief   Get the global status
+ */
+Std_ReturnType WdgM_GetGlobalStatus(WdgM_GlobalStatusType *status)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+
+    if (status == NULL_PTR)
+    {
+        Det_ReportError(WDGM_MODULE_ID, 0, WDGM_GET_GLOBAL_STATUS_SID, WDGM_E_PARAM_POINTER);
+    }
+    else
+    {
+        *status = WdgM_GlobalStatus;
+        retVal = E_OK;
+    }
+
+    return retVal;
+}
+
+/**
+ * @brief   Stop triggering the watchdog so that it resets the ECU
+ */
+void WdgM_PerformReset(void)
+{
+    if (WdgM_Initialized == FALSE)
+    {
+        Det_ReportError(WDGM_MODULE_ID, 0, WDGM_PERFORM_RESET_SID, WDGM_E_UNINIT);
+    }
+    else
+    {
+        WdgM_GlobalStatus = WDGM_GLOBAL_STATUS_STOPPED;
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * WdgM.h - AUTOSAR Watchdog Manager Interface
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface definition for the
+ *              Watchdog Manager module for Infineon TC377. Runnables report
+ *              checkpoints; WdgM_MainFunction evaluates alive, deadline and
+ *              logical (control flow) supervision and triggers the hardware
+ *              watchdog only while every active supervised entity is OK.
+ */
+
+#ifndef WDGM_H
+#define WDGM_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "WdgM_Cfg.h"
+
+/* AUTOSAR Version information */
+#define WDGM_VENDOR_ID                    (0x1234)
+#define WDGM_MODULE_ID                    (0x000D)
+#define WDGM_AR_RELEASE_MAJOR_VERSION     (4)
+#define WDGM_AR_RELEASE_MINOR_VERSION     (4)
+#define WDGM_AR_RELEASE_REVISION_VERSION  (0)
+#define WDGM_SW_MAJOR_VERSION             (1)
+#define WDGM_SW_MINOR_VERSION             (0)
+#define WDGM_SW_PATCH_VERSION             (0)
+
+/* Check AUTOSAR version compatibility */
+#if ((STD_AR_RELEASE_MAJOR_VERSION != WDGM_AR_RELEASE_MAJOR_VERSION) || \
+     (STD_AR_RELEASE_MINOR_VERSION != WDGM_AR_RELEASE_MINOR_VERSION))
+#error "AUTOSAR version mismatch between WdgM.h and Std_Types.h"
+#endif
+
+/* API service IDs */
+#define WDGM_INIT_SID                     (0x00u)
+#define WDGM_SET_MODE_SID                 (0x03u)
+#define WDGM_GET_LOCAL_STATUS_SID         (0x0Cu)
+#define WDGM_GET_GLOBAL_STATUS_SID        (0x0Du)
+#define WDGM_PERFORM_RESET_SID            (0x0Eu)
+#define WDGM_CHECKPOINT_REACHED_SID       (0x0Fu)
+#define WDGM_MAIN_FUNCTION_SID            (0x08u)
+
+/* Error codes */
+#define WDGM_E_UNINIT                     (0x10u)
+#define WDGM_E_PARAM_MODE                 (0x12u)
+#define WDGM_E_PARAM_SEID                 (0x13u)
+#define WDGM_E_PARAM_POINTER              (0x14u)
+#define WDGM_E_CPID                       (0x15u)
+
+/* Local status of a supervised entity */
+typedef enum {
+    WDGM_LOCAL_STATUS_OK,
+    WDGM_LOCAL_STATUS_EXPIRED,      /* A supervision failed; latched */
+    WDGM_LOCAL_STATUS_DEACTIVATED   /* Not supervised in the current mode */
+} WdgM_LocalStatusType;
+
+/* Global status */
+typedef enum {
+    WDGM_GLOBAL_STATUS_OK,
+    WDGM_GLOBAL_STATUS_EXPIRED,     /* A supervised entity expired; latched until reset */
+    WDGM_GLOBAL_STATUS_STOPPED,     /* Reset requested, the watchdog is no longer triggered */
+    WDGM_GLOBAL_STATUS_DEACTIVATED  /* Not initialized */
+} WdgM_GlobalStatusType;
+
+/* Function prototypes */
+
+/**
+ * @brief   Initialize the Watchdog Manager in WDGM_MODE_IDLE
+ */
+void WdgM_Init(void);
+
+/**
+ * @brief   Switch the set of supervised entities
+ * @details Newly activated entities start in the OK state and their first
+ *          alive reference cycle is not evaluated, as it is only partly
+ *          covered. Entities leaving supervision are deactivated.
+ * @param   mode  WDGM_MODE_*
+ * @return  E_OK if the mode was changed
+ */
+Std_ReturnType WdgM_SetMode(uint8 mode);
+
+/**
+ * @brief   Report a checkpoint of a supervised entity
+ * @details Constant time, no loops: counts the alive indication, checks
+ *          the transition against the allowed successors and opens or
+ *          closes a deadline. Each entity must report from one context
+ *          (task or interrupt) only. Checkpoints of deactivated entities
+ *          are ignored.
+ * @param   seId  Supervised entity (WDGM_SE_*)
+ * @param   cpId  Checkpoint of that entity (WDGM_CP_*)
+ */
+void WdgM_CheckpointReached(uint8 seId, uint8 cpId);
+
+/**
+ * @brief   Evaluate the supervisions and trigger the watchdog
+ * @details Must be called every WDGM_MAIN_FUNCTION_PERIOD_MS.
+ */
+void WdgM_MainFunction(void);
+
+Std_ReturnType WdgM_GetLocalStatus(uint8 seId, WdgM_LocalStatusType *status);
+Std_ReturnType WdgM_GetGlobalStatus(WdgM_GlobalStatusType *status);
+
+/**
+ * @brief   Stop triggering the watchdog so that it resets the ECU
+ */
+void WdgM_PerformReset(void);
+
+#endif /* WDGM_H */
@@ -0,0 +1,66 @@
+/*
+ * WdgM_Cfg.c - AUTOSAR Watchdog Manager Configuration Data
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the supervised entities and modes of
+ *              the Watchdog Manager module for Infineon TC377
+ */
+
+#include "WdgM_Cfg.h"
+
+#define WDGM_CP_BIT(cp)          ((uint32)1u << (cp))
+#define WDGM_SE_BIT(se)          ((uint32)1u << (se))
+
+/* Main loop: runs at least once per 10 ms, no upper bound */
+static const WdgM_AliveSupervisionType WdgM_BackgroundAlive[] = {
+    {WDGM_CP_BACKGROUND_LOOP, 10u, 1u, WDGM_ALIVE_UNLIMITED}
+};
+
+/* Control step: 200 starts per 10 ms at 20 kHz, start to end within 20 us */
+static const uint32 WdgM_ControlSuccessors[] = {
+    WDGM_CP_BIT(WDGM_CP_CONTROL_END),        /* after START */
+    WDGM_CP_BIT(WDGM_CP_CONTROL_START)       /* after END */
+};
+
+static const WdgM_AliveSupervisionType WdgM_ControlAlive[] = {
+    {WDGM_CP_CONTROL_START, 10u, 190u, 210u}
+};
+
+static const WdgM_DeadlineSupervisionType WdgM_ControlDeadline[] = {
+    {WDGM_CP_CONTROL_START, WDGM_CP_CONTROL_END, 0u, 20u * WDGM_TICKS_PER_US}
+};
+
+/* Voltage and temperature checks: 5 per 50 ms at 100 Hz */
+static const WdgM_AliveSupervisionType WdgM_MeasurementAlive[] = {
+    {WDGM_CP_MEASUREMENT, 50u, 4u, 6u}
+};
+
+/* Error state loop: at least once per 100 ms */
+static const WdgM_AliveSupervisionType WdgM_ErrorHandlerAlive[] = {
+    {WDGM_CP_ERROR_LOOP, 100u, 1u, WDGM_ALIVE_UNLIMITED}
+};
+
+/* Supervised entities */
+const WdgM_EntityConfigType WdgM_EntityConfig[WDGM_MAX_ENTITIES] = {
+    /* Background */
+    {1u, WDGM_CP_BIT(WDGM_CP_BACKGROUND_LOOP), NULL_PTR, WdgM_BackgroundAlive, 1u, NULL_PTR, 0u},
+    /* Control */
+    {2u, WDGM_CP_BIT(WDGM_CP_CONTROL_START), WdgM_ControlSuccessors, WdgM_ControlAlive, 1u,
+     WdgM_ControlDeadline, 1u},
+    /* Measurement */
+    {1u, WDGM_CP_BIT(WDGM_CP_MEASUREMENT), NULL_PTR, WdgM_MeasurementAlive, 1u, NULL_PTR, 0u},
+    /* Error handler */
+    {1u, WDGM_CP_BIT(WDGM_CP_ERROR_LOOP), NULL_PTR, WdgM_ErrorHandlerAlive, 1u, NULL_PTR, 0u}
+};
+
+/* Active supervised entities per mode */
+const uint32 WdgM_ModeEntities[WDGM_MAX_MODES] = {
+    /* Idle: only the main loop runs */
+    WDGM_SE_BIT(WDGM_SE_BACKGROUND),
+    /* Run: main loop, control step and measurement checks */
+    WDGM_SE_BIT(WDGM_SE_BACKGROUND) | WDGM_SE_BIT(WDGM_SE_CONTROL) | WDGM_SE_BIT(WDGM_SE_MEASUREMENT),
+    /* Error: the error loop replaces the main loop */
+    WDGM_SE_BIT(WDGM_SE_ERROR_HANDLER)
+};
@@ -0,0 +1,83 @@
+/*
+ * WdgM_Cfg.h - AUTOSAR Watchdog Manager Configuration
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the supervised entities, their
+ *              checkpoints and the supervision parameters of the
+ *              Watchdog Manager module for Infineon TC377
+ */
+
+#ifndef WDGM_CFG_H
+#define WDGM_CFG_H
+
+/* Include AUTOSAR standard types */
+#include "Std_Types.h"
+#include "Tm_Cfg.h"
+
+/* Period of WdgM_MainFunction (1 ms system tick) */
+#define WDGM_MAIN_FUNCTION_PERIOD_MS       (1u)
+
+/* Resolution of the deadline timer (Tm_GetTicks32) */
+#define WDGM_TICKS_PER_US                  (TM_TICKS_PER_SECOND / 1000000u)
+
+/* Supervised entities */
+#define WDGM_SE_BACKGROUND                 (0u)    /* Main loop */
+#define WDGM_SE_CONTROL                    (1u)    /* 20 kHz current control step */
+#define WDGM_SE_MEASUREMENT                (2u)    /* 100 Hz voltage and temperature checks */
+#define WDGM_SE_ERROR_HANDLER              (3u)    /* Error state loop */
+#define WDGM_MAX_ENTITIES                  (4u)
+
+/* Checkpoints, numbered per supervised entity */
+#define WDGM_CP_BACKGROUND_LOOP            (0u)
+#define WDGM_CP_CONTROL_START              (0u)
+#define WDGM_CP_CONTROL_END                (1u)
+#define WDGM_CP_MEASUREMENT                (0u)
+#define WDGM_CP_ERROR_LOOP                 (0u)
+
+/* Maximum checkpoints per supervised entity (one bit each in the flow masks) */
+#define WDGM_MAX_CHECKPOINTS               (8u)
+
+/* Supervision modes; each mode activates a set of supervised entities */
+#define WDGM_MODE_IDLE                     (0u)
+#define WDGM_MODE_RUN                      (1u)
+#define WDGM_MODE_ERROR                    (2u)
+#define WDGM_MAX_MODES                     (3u)
+
+/* Upper bound of an alive supervision that only checks the minimum */
+#define WDGM_ALIVE_UNLIMITED               (0xFFFFFFFFu)
+
+/* Alive supervision: checkpoint count per reference cycle of main function periods */
+typedef struct {
+    uint8 checkpoint;
+    uint16 referenceCycles;
+    uint32 minCount;
+    uint32 maxCount;
+} WdgM_AliveSupervisionType;
+
+/* Deadline supervision: time from the start to the end checkpoint */
+typedef struct {
+    uint8 startCheckpoint;      /* A checkpoint starts at most one deadline */
+    uint8 endCheckpoint;
+    uint32 minTicks;
+    uint32 maxTicks;
+} WdgM_DeadlineSupervisionType;
+
+/* Supervised entity */
+typedef struct {
+    uint8 checkpoints;                               /* Number of checkpoints */
+    uint32 initialCheckpoints;                       /* Checkpoints allowed first after activation */
+    const uint32 *successors;                        /* Allowed next checkpoints per checkpoint,
+                                                        NULL_PTR: no logical supervision */
+    const WdgM_AliveSupervisionType *alive;
+    uint8 aliveCount;
+    const WdgM_DeadlineSupervisionType *deadline;
+    uint8 deadlineCount;
+} WdgM_EntityConfigType;
+
+/* Supervised entities and modes (WdgM_Cfg.c) */
+extern const WdgM_EntityConfigType WdgM_EntityConfig[WDGM_MAX_ENTITIES];
+extern const uint32 WdgM_ModeEntities[WDGM_MAX_MODES];
+
+#endif /* WDGM_CFG_H */
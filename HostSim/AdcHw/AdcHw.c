@@ -0,0 +1,179 @@
+/*
+ * AdcHw.c - ADC Converter Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains a single converter serving one request
+ *              source per group. A started group converts its channels
+ *              back to back; starts that arrive while the converter is busy
+ *              wait in arbitration order (lower group first). The
+ *              end-of-conversion interrupt calls AdcIf_GroupConversionComplete
+ *              after the configured entry latency. Events run on the
+ *              SimTime timeline. The results of each conversion pass
+ *              the RecLog input point.
+ */
+
+#include "AdcHw.h"
+#include "SimTime.h"
+#include "RecLog.h"
+
+/* Internal variables */
+static uint32 AdcHw_ChannelTicks = 1u;
+static uint32 AdcHw_IsrTicks = 0u;
+static uint8 AdcHw_GroupChannels[ADCHW_MAX_GROUPS];
+static boolean AdcHw_TriggerEnable[ADCHW_MAX_GROUPS];
+static boolean AdcHw_Pending[ADCHW_MAX_GROUPS];
+static boolean AdcHw_Busy = FALSE;
+static uint64 AdcHw_ConversionStart = 0u;
+static uint64 AdcHw_SampleTick[ADCHW_MAX_GROUPS];
+static AdcIf_ValueType AdcHw_Results[ADCHW_MAX_GROUPS][ADCHW_MAX_GROUP_CHANNELS];
+static uint32 AdcHw_Overruns = 0u;
+static AdcHw_SimSourceType AdcHw_Source = NULL_PTR;
+
+/* Forward declarations */
+static void AdcHw_Request(uint8 group);
+static void AdcHw_Arbitrate(void);
+static void AdcHw_ConversionEndEvent(uint32 group);
+static void AdcHw_InterruptEvent(uint32 group);
+
+void AdcHw_SimInit(uint32 channelTicks, uint32 isrTicks)
+{
+    for (uint8 g = 0; g < ADCHW_MAX_GROUPS; g++)
+    {
+        SimTime_Cancel(AdcHw_ConversionEndEvent, g);
+        SimTime_Cancel(AdcHw_InterruptEvent, g);
+        AdcHw_GroupChannels[g] = 1u;
+        AdcHw_TriggerEnable[g] = FALSE;
+        AdcHw_Pending[g] = FALSE;
+        AdcHw_SampleTick[g] = 0u;
+        for (uint8 i = 0; i < ADCHW_MAX_GROUP_CHANNELS; i++)
+        {
+            AdcHw_Results[g][i] = 0u;
+        }
+    }
+    AdcHw_ChannelTicks = (channelTicks > 0u) ? channelTicks : 1u;
+    AdcHw_IsrTicks = isrTicks;
+    AdcHw_Busy = FALSE;
+    AdcHw_Overruns = 0u;
+    AdcHw_Source = NULL_PTR;
+}
+
+void AdcHw_SimSetGroupChannels(uint8 group, uint8 channels)
+{
+    if (group < ADCHW_MAX_GROUPS && channels > 0u && channels <= ADCHW_MAX_GROUP_CHANNELS)
+    {
+        AdcHw_GroupChannels[group] = channels;
+    }
+}
+
+void AdcHw_SimSetSource(AdcHw_SimSourceType source)
+{
+    AdcHw_Source = source;
+}
+
+void AdcHw_SimHardwareTrigger(void)
+{
+    for (uint8 g = 0; g < ADCHW_MAX_GROUPS; g++)
+    {
+        if (AdcHw_TriggerEnable[g] == TRUE)
+        {
+            AdcHw_Request(g);
+        }
+    }
+}
+
+uint64 AdcHw_SimGetSampleTick(uint8 group)
+{
+    return (group < ADCHW_MAX_GROUPS) ? AdcHw_SampleTick[group] : 0u;
+}
+
+uint32 AdcHw_SimGetOverruns(void)
+{
+    return AdcHw_Overruns;
+}
+
+void AdcHw_EnableHwTrigger(uint8 group, boolean enable)
+{
+    if (group < ADCHW_MAX_GROUPS)
+    {
+        AdcHw_TriggerEnable[group] = enable;
+    }
+}
+
+void AdcHw_StartGroup(uint8 group)
+{
+    if (group < ADCHW_MAX_GROUPS)
+    {
+        AdcHw_Request(group);
+    }
+}
+
+void AdcHw_ReadGroupResults(uint8 group, AdcIf_ValueType *buffer, uint8 count)
+{
+    if (group >= ADCHW_MAX_GROUPS)
+    {
+        return;
+    }
+    for (uint8 i = 0; i < count && i < ADCHW_MAX_GROUP_CHANNELS; i++)
+    {
+        buffer[i] = AdcHw_Results[group][i];
+    }
+}
+
+static void AdcHw_Request(uint8 group)
+{
+    if (AdcHw_Pending[group] == TRUE)
+    {
+        AdcHw_Overruns++;
+        return;
+    }
+    AdcHw_Pending[group] = TRUE;
+    AdcHw_Arbitrate();
+}
+
+static void AdcHw_Arbitrate(void)
+{
+    uint64 now = SimTime_Now();
+
+    if (AdcHw_Busy == TRUE)
+    {
+        return;
+    }
+    for (uint8 g = 0; g < ADCHW_MAX_GROUPS; g++)
+    {
+        if (AdcHw_Pending[g] == TRUE)
+        {
+            AdcHw_Busy = TRUE;
+            AdcHw_ConversionStart = now;
+            (void)SimTime_Schedule(now + (uint64)AdcHw_GroupChannels[g] * AdcHw_ChannelTicks,
+                                   AdcHw_ConversionEndEvent, g);
+            return;
+        }
+    }
+}
+
+static void AdcHw_ConversionEndEvent(uint32 group)
+{
+    uint64 sampleTick;
+
+    /* Channel i was sampled at the start of its conversion slot */
+    for (uint8 i = 0; i < AdcHw_GroupChannels[group]; i++)
+    {
+        sampleTick = AdcHw_ConversionStart + (uint64)i * AdcHw_ChannelTicks;
+        AdcHw_Results[group][i] = (AdcHw_Source != NULL_PTR) ?
+                                  AdcHw_Source((uint8)group, i, sampleTick) : 0u;
+    }
+    RecLog_AdcResults((uint8)group, AdcHw_Results[group], AdcHw_GroupChannels[group]);
+    AdcHw_SampleTick[group] = AdcHw_ConversionStart;
+    AdcHw_Pending[group] = FALSE;
+    AdcHw_Busy = FALSE;
+
+    (void)SimTime_Schedule(SimTime_Now() + AdcHw_IsrTicks, AdcHw_InterruptEvent, group);
+    AdcHw_Arbitrate();
+}
+
+static void AdcHw_InterruptEvent(uint32 group)
+{
+    AdcIf_GroupConversionComplete((uint8)group);
+}
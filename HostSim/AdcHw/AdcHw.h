@@ -0,0 +1,58 @@
+/*
+ * AdcHw.h - ADC Converter Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the request-source interface AdcIf
+ *              expects from the ADC driver, plus host-only controls of the
+ *              simulated converter
+ */
+
+#ifndef ADCHW_H
+#define ADCHW_H
+
+#include "Std_Types.h"
+#include "AdcIf.h"
+
+/* Number of simulated request sources (one per group) */
+#define ADCHW_MAX_GROUPS             (2u)
+
+/* Maximum number of channels per group */
+#define ADCHW_MAX_GROUP_CHANNELS     (8u)
+
+/* Signal source: value of a group channel at its sampling tick */
+typedef AdcIf_ValueType (*AdcHw_SimSourceType)(uint8 group, uint8 index, uint64 sampleTick);
+
+/* Driver interface used by AdcIf */
+void AdcHw_EnableHwTrigger(uint8 group, boolean enable);
+void AdcHw_StartGroup(uint8 group);
+void AdcHw_ReadGroupResults(uint8 group, AdcIf_ValueType *buffer, uint8 count);
+
+/**
+ * @brief   Reset the converter
+ * @param   channelTicks  Sample and conversion time of one channel
+ * @param   isrTicks      End-of-conversion interrupt entry latency
+ */
+void AdcHw_SimInit(uint32 channelTicks, uint32 isrTicks);
+
+/* Number of channels converted per group start */
+void AdcHw_SimSetGroupChannels(uint8 group, uint8 channels);
+
+void AdcHw_SimSetSource(AdcHw_SimSourceType source);
+
+/**
+ * @brief   Hardware trigger input
+ * @details Connected to the PWM trigger output with
+ *          PwmHw_SimSetTriggerCallback. Starts every group whose hardware
+ *          trigger is enabled.
+ */
+void AdcHw_SimHardwareTrigger(void);
+
+/* SimTime tick at which the last completed conversion of a group started sampling */
+uint64 AdcHw_SimGetSampleTick(uint8 group);
+
+/* Group starts that arrived while the same group was still pending */
+uint32 AdcHw_SimGetOverruns(void);
+
+#endif /* ADCHW_H */
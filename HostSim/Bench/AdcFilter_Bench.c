@@ -0,0 +1,219 @@
+/*
+ * AdcFilter_Bench.c - ADC Filter Stage Noise Reduction and Throughput
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Feeds a noisy constant and a step through every AdcIf filter
+ *              type and reports the output noise, the step response time
+ *              and the throughput in samples per microsecond for several
+ *              block sizes. Block size 1 is the per-sample cost of calling
+ *              the stage from an interrupt; the baseline is a per-sample
+ *              moving average that divides by a run-time window length.
+ *              Links its own filter table instead of AdcIf_Cfg.c, one
+ *              filter variant per channel.
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "Det.h"
+#include "AdcIf.h"
+#include "AdcIf_Cfg.h"
+#include "Bench.h"
+
+#define BENCH_SAMPLES                (1u << 16)
+#define BENCH_THROUGHPUT_SAMPLES     (1u << 24)
+#define BENCH_LEVEL                  (2000.0)
+#define BENCH_NOISE_LSB              (8.0)       /* Standard deviation of the input noise */
+#define BENCH_STEP_LOW               (1000u)
+#define BENCH_STEP_HIGH              (3000u)
+
+/* One filter variant per channel */
+const AdcIf_FilterConfigType AdcIf_FilterConfig[ADCIF_FILTER_CHANNELS] = {
+    {ADCIF_FILTER_NONE, 0u, 0u},
+    {ADCIF_FILTER_MOVING_AVERAGE, 3u, 0u},
+    {ADCIF_FILTER_MOVING_AVERAGE, 5u, 0u},
+    {ADCIF_FILTER_IIR, 3u, 0u},
+    {ADCIF_FILTER_IIR, 5u, 0u},
+    {ADCIF_FILTER_CIC, 3u, 2u},
+    {ADCIF_FILTER_CIC, 4u, 3u}
+};
+
+static const char *const Bench_Names[ADCIF_FILTER_CHANNELS] = {
+    "none", "moving average 8", "moving average 32", "IIR 1/8", "IIR 1/32",
+    "CIC order 2, R 8", "CIC order 3, R 16"
+};
+
+static const uint32 Bench_BlockSizes[] = {1u, 8u, 64u, 1024u};
+
+static AdcIf_ValueType Bench_Input[BENCH_SAMPLES];
+static AdcIf_ValueType Bench_Output[BENCH_SAMPLES];
+static volatile uint32 Bench_Window = 24u;
+static volatile uint32 Bench_Sink;
+
+/* Hardware hooks of AdcIf, unused here */
+void AdcHw_EnableHwTrigger(uint8 group, boolean enable)
+{
+    (void)group;
+    (void)enable;
+}
+
+void AdcHw_StartGroup(uint8 group)
+{
+    (void)group;
+}
+
+void AdcHw_ReadGroupResults(uint8 group, AdcIf_ValueType *buffer, uint8 count)
+{
+    (void)group;
+    (void)buffer;
+    (void)count;
+}
+
+static double Bench_Uniform(void)
+{
+    static uint32 state = 0x2545F491u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return ((double)state + 1.0) / 4294967297.0;
+}
+
+/* Normally distributed noise (Box-Muller) on a constant, quantized to 12 bit */
+static void Bench_MakeNoisyInput(void)
+{
+    const double pi = 3.14159265358979;
+    double v;
+
+    for (uint32 i = 0; i < BENCH_SAMPLES; i++)
+    {
+        v = BENCH_LEVEL + BENCH_NOISE_LSB * sqrt(-2.0 * log(Bench_Uniform())) *
+                                            cos(2.0 * pi * Bench_Uniform());
+        Bench_Input[i] = (AdcIf_ValueType)lround(v);
+    }
+}
+
+static double Bench_StdDev(const AdcIf_ValueType *x, uint32 count)
+{
+    double sum = 0.0;
+    double sumSquares = 0.0;
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        sum += x[i];
+        sumSquares += (double)x[i] * x[i];
+    }
+    return sqrt(sumSquares / count - (sum / count) * (sum / count));
+}
+
+/* Input samples until the output reaches 95 % of a step, -1 if never */
+static sint32 Bench_StepResponse(uint8 filter)
+{
+    AdcIf_ValueType in = BENCH_STEP_LOW;
+    AdcIf_ValueType out = 0u;
+    uint32 threshold = BENCH_STEP_LOW + (BENCH_STEP_HIGH - BENCH_STEP_LOW) * 95u / 100u;
+
+    AdcIf_Init();
+    for (uint32 i = 0; i < 256u; i++)
+    {
+        (void)AdcIf_FilterBlock(filter, &in, 1u, NULL_PTR);
+    }
+    in = BENCH_STEP_HIGH;
+    for (uint32 i = 1; i <= 4096u; i++)
+    {
+        if (AdcIf_FilterBlock(filter, &in, 1u, &out) > 0u && out >= threshold)
+        {
+            return (sint32)i;
+        }
+    }
+    return -1;
+}
+
+static double Bench_Throughput(uint8 filter, uint32 block)
+{
+    uint64 start;
+    uint32 produced = 0u;
+
+    AdcIf_Init();
+    start = Bench_NowNs();
+    for (uint32 n = 0; n < BENCH_THROUGHPUT_SAMPLES; n += block)
+    {
+        produced += AdcIf_FilterBlock(filter, &Bench_Input[n & (BENCH_SAMPLES - 1u)], block, NULL_PTR);
+    }
+    Bench_Sink = produced;
+    return (double)BENCH_THROUGHPUT_SAMPLES * 1000.0 / (double)(Bench_NowNs() - start);
+}
+
+/* Baseline: per-sample moving average with a division by the window length */
+static AdcIf_ValueType Bench_DivideAverage(AdcIf_ValueType sample)
+{
+    static AdcIf_ValueType history[32];
+    static uint32 pos;
+    static uint32 sum;
+    uint32 window = Bench_Window;
+
+    sum += (uint32)sample - history[pos];
+    history[pos] = sample;
+    pos = (pos + 1u < window) ? pos + 1u : 0u;
+    return (AdcIf_ValueType)(sum / window);
+}
+
+int main(void)
+{
+    uint32 outputs;
+    uint32 skip;
+    uint64 start;
+    uint32 acc = 0u;
+
+    Det_Init();
+    Bench_MakeNoisyInput();
+
+    printf("Noise reduction, %u samples at %.0f LSB with %.1f LSB rms noise\n",
+           (unsigned)BENCH_SAMPLES, BENCH_LEVEL, BENCH_NOISE_LSB);
+    printf("  %-20s %8s %9s %8s %10s\n", "filter", "outputs", "rms LSB", "gain", "95% step");
+    for (uint8 f = 0; f < ADCIF_FILTER_CHANNELS; f++)
+    {
+        AdcIf_Init();
+        outputs = 0u;
+        for (uint32 n = 0; n < BENCH_SAMPLES; n += 64u)
+        {
+            outputs += AdcIf_FilterBlock(f, &Bench_Input[n], 64u, &Bench_Output[outputs]);
+        }
+        /* Skip the settling of the slowest filters */
+        skip = outputs / 16u;
+        printf("  %-20s %8u %9.2f %7.1fx %7d sa\n", Bench_Names[f], (unsigned)outputs,
+               Bench_StdDev(&Bench_Output[skip], outputs - skip),
+               Bench_StdDev(Bench_Input, BENCH_SAMPLES) / Bench_StdDev(&Bench_Output[skip], outputs - skip),
+               (int)Bench_StepResponse(f));
+    }
+
+    printf("Throughput [samples/us] by block size\n");
+    printf("  %-20s", "filter");
+    for (uint32 b = 0; b < sizeof(Bench_BlockSizes) / sizeof(Bench_BlockSizes[0]); b++)
+    {
+        printf(" %8u", (unsigned)Bench_BlockSizes[b]);
+    }
+    printf("\n");
+    for (uint8 f = 1; f < ADCIF_FILTER_CHANNELS; f++)
+    {
+        printf("  %-20s", Bench_Names[f]);
+        for (uint32 b = 0; b < sizeof(Bench_BlockSizes) / sizeof(Bench_BlockSizes[0]); b++)
+        {
+            printf(" %8.1f", Bench_Throughput(f, Bench_BlockSizes[b]));
+        }
+        printf("\n");
+    }
+
+    start = Bench_NowNs();
+    for (uint32 n = 0; n < BENCH_THROUGHPUT_SAMPLES; n++)
+    {
+        acc += Bench_DivideAverage(Bench_Input[n & (BENCH_SAMPLES - 1u)]);
+    }
+    Bench_Sink = acc;
+    printf("  %-20s %8.1f (per sample, division by a run-time window of %u)\n", "baseline average",
+           (double)BENCH_THROUGHPUT_SAMPLES * 1000.0 / (double)(Bench_NowNs() - start),
+           (unsigned)Bench_Window);
+
+    return 0;
+}
@@ -0,0 +1,415 @@
+/*
+ * AdcSnapshot_Bench.c - ADC Result Snapshot Coherence and Copy Cost
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Runs the rate groups of the motor control on the simulated
+ *              timeline and reads the ADC results from all of them, once
+ *              through copies and once through AdcIf snapshots:
+ *
+ *              - copy: the group notifications copy the results into
+ *                shared buffers (AdcIf_ReadGroup), every consumer copies
+ *                them again into its own
+ *              - snapshot: every consumer reads the newest snapshot in
+ *                place and checks it with AdcIf_SnapshotValid after use,
+ *                fetching it again if it was overwritten
+ *
+ *              The speed loop and the supervision read the phase currents
+ *              across a preemption. The source gives all channels of one
+ *              conversion the same value, so a read that mixes two
+ *              conversions shows as unequal currents. Reported per
+ *              consumer: torn reads, snapshot retries, values copied, and
+ *              the missed and repeated publications told apart by the
+ *              generations, against the counts expected from the rates.
+ *              Finally the host cost of one read through either path.
+ */
+
+#include <stdio.h>
+
+#include "Det.h"
+#include "AdcIf.h"
+#include "AdcIf_Cfg.h"
+#include "PwmIf.h"
+#include "PwmIf_Cfg.h"
+#include "AdcHw.h"
+#include "PwmHw.h"
+#include "SimTime.h"
+#include "Tm.h"
+#include "Sched.h"
+#include "SchedHw.h"
+#include "Bench.h"
+
+#define BENCH_US                     (SIMTIME_TICKS_PER_SECOND / 1000000u)
+#define BENCH_MS                     (1000u * BENCH_US)
+#define BENCH_RUN_MS                 (2000u)
+#define BENCH_READS                  (1u << 24)
+
+/* Converter timing: 1 us per channel, 200 ns interrupt entry */
+#define BENCH_CHANNEL_TICKS          (100u)
+#define BENCH_ISR_TICKS              (20u)
+
+/* Execution time of the loops */
+#define BENCH_CURRENT_TICKS          (12u * BENCH_US)
+#define BENCH_SPEED_TICKS            (40u * BENCH_US)
+#define BENCH_SUPERVISION_TICKS      (150u * BENCH_US)
+
+/* Supervision reads of one snapshot before its result is dropped */
+#define BENCH_SUPERVISION_ATTEMPTS   (3u)
+
+typedef enum {
+    BENCH_COPY,
+    BENCH_SNAPSHOT
+} Bench_ModeType;
+
+/* Reads of one consumer */
+typedef struct {
+    const char *name;
+    uint32 reads;
+    uint32 torn;                 /* Currents from two conversions */
+    uint32 retries;              /* Snapshots overwritten while in use */
+    uint32 dropped;              /* Reads given up after BENCH_SUPERVISION_ATTEMPTS */
+    uint32 copied;               /* Values copied */
+    uint32 generation;           /* Last generation seen */
+    uint32 fresh;                /* Reads of a newer publication */
+    uint32 missed;               /* Publications skipped between two reads */
+    uint32 repeated;             /* Reads of the same publication again */
+} Bench_ConsumerType;
+
+#define BENCH_CURRENT                (0u)
+#define BENCH_SPEED                  (1u)
+#define BENCH_SPEED_MEASUREMENT      (2u)
+#define BENCH_SUPERVISION            (3u)
+#define BENCH_SUPERVISION_MEASUREMENT (4u)
+#define BENCH_CONSUMERS              (5u)
+
+static Bench_ModeType Bench_Mode;
+static uint64 Bench_SpanTicks;
+static uint64 Bench_Executed;
+static Bench_ConsumerType Bench_Consumers[BENCH_CONSUMERS];
+static uint32 Bench_NotificationCopies;
+
+/* Shared result buffers of the copy path */
+static AdcIf_ValueType Bench_Group0Results[ADCIF_GROUP0_CHANNELS];
+static AdcIf_ValueType Bench_Group1Results[ADCIF_GROUP1_CHANNELS];
+
+static volatile uint32 Bench_Sink;
+
+/* Same value on all channels of a conversion: its PWM period number */
+static AdcIf_ValueType Bench_Source(uint8 group, uint8 index, uint64 sampleTick)
+{
+    (void)group;
+    (void)index;
+    return (AdcIf_ValueType)((sampleTick / PWMIF_PERIOD_TICKS) & 0xFFFu);
+}
+
+/**
+ * @brief   Execute for a number of ticks of own time
+ * @details The interrupts due meanwhile run nested; their execution does
+ *          not count towards the ticks of the code they preempted.
+ */
+static void Bench_Execute(uint64 ticks)
+{
+    uint64 start;
+    uint64 nested;
+    uint64 own;
+
+    while (ticks > 0u)
+    {
+        start = SimTime_Now();
+        nested = Bench_Executed;
+        SimTime_Advance(ticks);
+        own = (SimTime_Now() - start) - (Bench_Executed - nested);
+        own = (own < ticks) ? own : ticks;
+        Bench_Executed += own;
+        ticks -= own;
+    }
+}
+
+/* Count the step from the consumer's last generation */
+static void Bench_Track(Bench_ConsumerType *consumer, uint32 generation)
+{
+    if (consumer->fresh + consumer->repeated > 0u)
+    {
+        if (generation == consumer->generation)
+        {
+            consumer->repeated++;
+            return;
+        }
+        consumer->missed += generation - consumer->generation - 1u;
+    }
+    consumer->generation = generation;
+    consumer->fresh++;
+}
+
+/**
+ * @brief   Read the phase currents in two parts, running between them
+ * @details The first current before, the other two after ticks of own
+ *          time. A snapshot overwritten meanwhile is read again.
+ */
+static void Bench_ReadCurrents(Bench_ConsumerType *consumer, uint64 ticks, uint32 attempts)
+{
+    AdcIf_ValueType currents[ADCIF_GROUP0_CHANNELS];
+    const AdcIf_SnapshotType *snapshot;
+    uint32 generation;
+    uint32 attempt;
+
+    consumer->reads++;
+    if (Bench_Mode == BENCH_COPY)
+    {
+        currents[0] = Bench_Group0Results[0];
+        Bench_Execute(ticks);
+        currents[1] = Bench_Group0Results[1];
+        currents[2] = Bench_Group0Results[2];
+        consumer->copied += ADCIF_GROUP0_CHANNELS;
+    }
+    else
+    {
+        for (attempt = 1u; ; attempt++)
+        {
+            snapshot = AdcIf_GetSnapshot(ADCIF_GROUP_0, &generation);
+            currents[0] = snapshot->values[0];
+            Bench_Execute(ticks);
+            currents[1] = snapshot->values[1];
+            currents[2] = snapshot->values[2];
+            if (AdcIf_SnapshotValid(snapshot, generation) == TRUE)
+            {
+                break;
+            }
+            consumer->retries++;
+            if (attempt >= attempts)
+            {
+                consumer->dropped++;
+                return;
+            }
+        }
+        Bench_Track(consumer, generation);
+    }
+
+    consumer->torn += (currents[0] != currents[1] || currents[0] != currents[2]) ? 1u : 0u;
+}
+
+/* Current loop: reads the conversion its notification just published */
+static void Bench_CurrentLoop(void)
+{
+    Bench_ReadCurrents(&Bench_Consumers[BENCH_CURRENT], 0u, 1u);
+    Bench_Execute(BENCH_CURRENT_TICKS);
+}
+
+/* Speed loop: currents across its run, DC link voltage at its start */
+static void Bench_SpeedLoop(void)
+{
+    Bench_ConsumerType *consumer = &Bench_Consumers[BENCH_SPEED_MEASUREMENT];
+    const AdcIf_SnapshotType *snapshot;
+    uint32 generation;
+
+    consumer->reads++;
+    if (Bench_Mode == BENCH_COPY)
+    {
+        Bench_Sink = Bench_Group1Results[0];
+        consumer->copied++;
+    }
+    else
+    {
+        snapshot = AdcIf_GetSnapshot(ADCIF_GROUP_1, &generation);
+        if (snapshot != NULL_PTR)
+        {
+            Bench_Sink = snapshot->values[0];
+            Bench_Track(consumer, generation);
+        }
+    }
+
+    Bench_ReadCurrents(&Bench_Consumers[BENCH_SPEED], BENCH_SPEED_TICKS, 1u);
+}
+
+/* Supervision: group 1 limits, currents read across Bench_SpanTicks */
+static void Bench_Supervision(void)
+{
+    Bench_ConsumerType *consumer = &Bench_Consumers[BENCH_SUPERVISION_MEASUREMENT];
+    AdcIf_ValueType measurements[ADCIF_GROUP1_CHANNELS];
+    const AdcIf_SnapshotType *snapshot;
+    uint32 generation;
+    uint32 sum = 0u;
+
+    if (Bench_Mode == BENCH_COPY)
+    {
+        for (uint8 i = 0; i < ADCIF_GROUP1_CHANNELS; i++)
+        {
+            measurements[i] = Bench_Group1Results[i];
+            sum += measurements[i];
+        }
+        consumer->copied += ADCIF_GROUP1_CHANNELS;
+    }
+    else
+    {
+        snapshot = AdcIf_GetSnapshot(ADCIF_GROUP_1, &generation);
+        if (snapshot != NULL_PTR)
+        {
+            for (uint8 i = 0; i < ADCIF_GROUP1_CHANNELS; i++)
+            {
+                sum += snapshot->values[i];
+            }
+            Bench_Track(consumer, generation);
+        }
+    }
+
+    consumer->reads++;
+    Bench_Sink = sum;
+
+    Bench_ReadCurrents(&Bench_Consumers[BENCH_SUPERVISION], Bench_SpanTicks, BENCH_SUPERVISION_ATTEMPTS);
+    if (Bench_SpanTicks < BENCH_SUPERVISION_TICKS)
+    {
+        Bench_Execute(BENCH_SUPERVISION_TICKS - Bench_SpanTicks);
+    }
+}
+
+/* Adc_GroupNotification_0 */
+static void Bench_Group0Isr(void)
+{
+    if (Bench_Mode == BENCH_COPY)
+    {
+        (void)AdcIf_ReadGroup(ADCIF_GROUP_0, Bench_Group0Results);
+        Bench_NotificationCopies += ADCIF_GROUP0_CHANNELS;
+    }
+    Sched_Tick();
+}
+
+/* Adc_GroupNotification_1 */
+static void Bench_Group1Isr(void)
+{
+    if (Bench_Mode == BENCH_COPY)
+    {
+        (void)AdcIf_ReadGroup(ADCIF_GROUP_1, Bench_Group1Results);
+        Bench_NotificationCopies += ADCIF_GROUP1_CHANNELS;
+    }
+}
+
+static void Bench_Run(Bench_ModeType mode, uint64 spanTicks)
+{
+    static const char *const names[] = {"copy", "snapshot"};
+    const Bench_ConsumerType *consumer;
+    uint32 conversions;
+    uint32 blocks;
+    uint32 copied;
+
+    SimTime_Init();
+    PwmHw_SimInit(PWMIF_PERIOD_TICKS);
+    AdcHw_SimInit(BENCH_CHANNEL_TICKS, BENCH_ISR_TICKS);
+    AdcHw_SimSetGroupChannels(ADCIF_GROUP_0, ADCIF_GROUP0_CHANNELS);
+    AdcHw_SimSetGroupChannels(ADCIF_GROUP_1, ADCIF_GROUP1_CHANNELS);
+    AdcHw_SimSetSource(Bench_Source);
+    PwmHw_SimSetTriggerCallback(AdcHw_SimHardwareTrigger);
+    PwmIf_Init();
+    AdcIf_Init();
+    AdcIf_RegisterGroupNotification(ADCIF_GROUP_0, Bench_Group0Isr);
+    AdcIf_RegisterGroupNotification(ADCIF_GROUP_1, Bench_Group1Isr);
+    SchedHw_SimInit();
+    Sched_Init();
+    (void)Sched_AddRunnable(SCHED_GROUP_CURRENT, Bench_CurrentLoop);
+    (void)Sched_AddRunnable(SCHED_GROUP_SPEED, Bench_SpeedLoop);
+    (void)Sched_AddRunnable(SCHED_GROUP_SUPERVISION, Bench_Supervision);
+
+    for (uint32 i = 0; i < BENCH_CONSUMERS; i++)
+    {
+        Bench_Consumers[i] = (Bench_ConsumerType){0};
+    }
+    Bench_Consumers[BENCH_CURRENT].name = "current loop, currents";
+    Bench_Consumers[BENCH_SPEED].name = "speed loop, currents";
+    Bench_Consumers[BENCH_SPEED_MEASUREMENT].name = "speed loop, DC link";
+    Bench_Consumers[BENCH_SUPERVISION].name = "supervision, currents";
+    Bench_Consumers[BENCH_SUPERVISION_MEASUREMENT].name = "supervision, group 1";
+    for (uint8 i = 0; i < ADCIF_GROUP1_CHANNELS; i++)
+    {
+        Bench_Group1Results[i] = 0u;
+    }
+    for (uint8 i = 0; i < ADCIF_GROUP0_CHANNELS; i++)
+    {
+        Bench_Group0Results[i] = 0u;
+    }
+    Bench_Mode = mode;
+    Bench_SpanTicks = spanTicks;
+    Bench_Executed = 0u;
+    Bench_NotificationCopies = 0u;
+
+    AdcIf_EnableGroupTrigger();
+    SimTime_Advance((uint64)BENCH_RUN_MS * BENCH_MS);
+    AdcIf_DisableGroupTrigger();
+
+    (void)AdcIf_GetSnapshot(ADCIF_GROUP_0, &conversions);
+    (void)AdcIf_GetSnapshot(ADCIF_GROUP_1, &blocks);
+    copied = Bench_NotificationCopies;
+    for (uint32 i = 0; i < BENCH_CONSUMERS; i++)
+    {
+        copied += Bench_Consumers[i].copied;
+    }
+
+    printf("%s, supervision reads the currents across %u us\n", names[mode], (unsigned)(spanTicks / BENCH_US));
+    printf("  %u conversions, %u group 1 blocks, %.0f values copied per second\n", (unsigned)conversions,
+           (unsigned)blocks, (double)copied * 1000.0 / BENCH_RUN_MS);
+    printf("  %-24s %7s %7s %8s %8s %9s %9s %9s\n", "consumer", "reads", "torn", "retries", "dropped",
+           "fresh", "missed", "repeated");
+    for (uint32 i = 0; i < BENCH_CONSUMERS; i++)
+    {
+        consumer = &Bench_Consumers[i];
+        printf("  %-24s %7u %7u %8u %8u", consumer->name, (unsigned)consumer->reads, (unsigned)consumer->torn,
+               (unsigned)consumer->retries, (unsigned)consumer->dropped);
+        if (mode == BENCH_COPY)
+        {
+            printf(" %9s %9s %9s\n", "-", "-", "-");
+        }
+        else
+        {
+            printf(" %9u %9u %9u\n", (unsigned)consumer->fresh, (unsigned)consumer->missed,
+                   (unsigned)consumer->repeated);
+        }
+    }
+}
+
+/* Host cost of reading the phase currents once */
+static void Bench_Cost(void)
+{
+    AdcIf_ValueType currents[ADCIF_GROUP0_CHANNELS];
+    const AdcIf_SnapshotType *snapshot;
+    uint32 generation;
+    uint32 sum = 0u;
+    uint64 start;
+    double copyNs;
+    double snapshotNs;
+
+    start = Bench_NowNs();
+    for (uint32 n = 0; n < BENCH_READS; n++)
+    {
+        (void)AdcIf_ReadGroup(ADCIF_GROUP_0, currents);
+        sum += (uint32)currents[0] + currents[1] + currents[2];
+    }
+    copyNs = (double)(Bench_NowNs() - start) / BENCH_READS;
+
+    start = Bench_NowNs();
+    for (uint32 n = 0; n < BENCH_READS; n++)
+    {
+        snapshot = AdcIf_GetSnapshot(ADCIF_GROUP_0, &generation);
+        sum += (uint32)snapshot->values[0] + snapshot->values[1] + snapshot->values[2];
+        sum += (uint32)AdcIf_SnapshotValid(snapshot, generation);
+    }
+    snapshotNs = (double)(Bench_NowNs() - start) / BENCH_READS;
+    Bench_Sink = sum;
+
+    printf("host cost of one read of the currents\n");
+    printf("  %-40s %8.2f ns\n", "AdcIf_ReadGroup into a buffer", copyNs);
+    printf("  %-40s %8.2f ns\n", "AdcIf_GetSnapshot and SnapshotValid", snapshotNs);
+}
+
+int main(void)
+{
+    Det_Init();
+    SimTime_Init();
+    Tm_Init();
+
+    printf("%u snapshot buffers per group, %u ms simulated\n", (unsigned)ADCIF_SNAPSHOT_BUFFERS,
+           (unsigned)BENCH_RUN_MS);
+    Bench_Run(BENCH_COPY, 75u * BENCH_US);
+    Bench_Run(BENCH_SNAPSHOT, 75u * BENCH_US);
+    Bench_Run(BENCH_SNAPSHOT, 200u * BENCH_US);
+    Bench_Cost();
+    return 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * AdcTrigger_Bench.c - PWM-Synchronized ADC Sample-to-Actuation Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Runs the motor control step on the simulated PWM timer and
+ *              ADC and measures the delay from the phase-current sample to
+ *              the period boundary at which the duty cycle computed from
+ *              it is latched.
+ *
+ *              Triggered: group 0 started by the PWM trigger at the period
+ *              center, control step in the group 0 notification, group 1
+ *              chained by AdcIf.
+ *              Polled: the former 1 kHz timer task that starts group 0 by
+ *              software and reads the result buffer right away, i.e. the
+ *              values of the previous conversion.
+ *
+ *              Every update writes a distinct compare value, so the active
+ *              compare register identifies the sample it was computed from.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Det.h"
+#include "AdcIf.h"
+#include "AdcIf_Cfg.h"
+#include "PwmIf.h"
+#include "PwmIf_Cfg.h"
+#include "AdcHw.h"
+#include "PwmHw.h"
+#include "SimTime.h"
+
+#define BENCH_PERIODS                (200000u)   /* 10 s of 20 kHz carrier */
+
+/* Converter timing (100 MHz ticks): 1 us per channel, 200 ns ISR entry */
+#define BENCH_CHANNEL_TICKS          (100u)
+#define BENCH_ISR_TICKS              (20u)
+#define BENCH_ACCESS_TICKS           (4u)
+
+/* Former control loop: 1 kHz timer task */
+#define BENCH_POLL_PERIOD_TICKS      (SIMTIME_TICKS_PER_SECOND / 1000u)
+
+/* Distinct compare values used to tag updates */
+#define BENCH_TAGS                   (4000u)
+
+#define TICKS_TO_US(t)               ((double)(t) / (SIMTIME_TICKS_PER_SECOND / 1000000u))
+
+static const uint32 Bench_ComputeTicks[] = {500u, 1500u, 2100u, 2300u};
+
+static uint32 Bench_Compute;
+static uint32 Bench_Tag;
+static uint64 Bench_TagSample[BENCH_TAGS + 1u];
+static uint32 Bench_LastActive;
+static uint32 *Bench_Delay;
+static uint32 Bench_DelayCount;
+static uint32 Bench_Updates;
+static uint32 Bench_Group1Count;
+
+static int Bench_CompareU32(const void *a, const void *b)
+{
+    uint32 x = *(const uint32 *)a;
+    uint32 y = *(const uint32 *)b;
+    return (x > y) - (x < y);
+}
+
+static AdcIf_ValueType Bench_Source(uint8 group, uint8 index, uint64 sampleTick)
+{
+    return (AdcIf_ValueType)(((sampleTick >> 4) + group * 1000u + index * 333u) & 0x0FFFu);
+}
+
+/* Duty cycle whose compare value is exactly the tag */
+static PwmIf_DutyType Bench_TagDuty(uint32 tag)
+{
+    return (PwmIf_DutyType)(((tag * 0xFFFFu) - 0x7FFFu + PWMIF_PERIOD_TICKS - 1u) / PWMIF_PERIOD_TICKS);
+}
+
+static void Bench_ControlStep(void)
+{
+    AdcIf_ValueType currents[ADCIF_GROUP0_CHANNELS];
+    PwmIf_DutyType duty;
+
+    (void)AdcIf_ReadGroup(ADCIF_GROUP_0, currents);
+    Bench_Tag = (Bench_Tag % BENCH_TAGS) + 1u;
+    Bench_TagSample[Bench_Tag] = AdcHw_SimGetSampleTick(ADCIF_GROUP_0);
+
+    /* Control algorithm execution time */
+    SimTime_Advance(Bench_Compute);
+
+    duty = Bench_TagDuty(Bench_Tag);
+    PwmIf_SetPhaseDutyCycles(duty, duty, duty);
+    Bench_Updates++;
+}
+
+static void Bench_Group1Notification(void)
+{
+    Bench_Group1Count++;
+}
+
+static void Bench_PeriodCallback(uint32 periodCount)
+{
+    uint32 active = PwmHw_SimGetActiveCompare(PWMIF_HW_CHANNEL_U);
+
+    (void)periodCount;
+    if (active != Bench_LastActive && active <= BENCH_TAGS && active != 0u)
+    {
+        Bench_Delay[Bench_DelayCount++] = (uint32)(SimTime_Now() - Bench_TagSample[active]);
+    }
+    Bench_LastActive = active;
+}
+
+static void Bench_PollTask(uint32 arg)
+{
+    (void)arg;
+
+    /* Old scheme: software start and immediate read */
+    AdcHw_StartGroup(ADCIF_GROUP_0);
+    Bench_ControlStep();
+    (void)SimTime_Schedule(SimTime_Now() - Bench_Compute - 4u * BENCH_ACCESS_TICKS +
+                           BENCH_POLL_PERIOD_TICKS, Bench_PollTask, 0u);
+}
+
+static void Bench_Setup(uint32 compute)
+{
+    SimTime_Init();
+    Det_Init();
+    PwmHw_SimInit(PWMIF_PERIOD_TICKS);
+    AdcHw_SimInit(BENCH_CHANNEL_TICKS, BENCH_ISR_TICKS);
+    AdcHw_SimSetGroupChannels(ADCIF_GROUP_0, ADCIF_GROUP0_CHANNELS);
+    AdcHw_SimSetGroupChannels(ADCIF_GROUP_1, ADCIF_GROUP1_CHANNELS);
+    AdcHw_SimSetSource(Bench_Source);
+    PwmIf_Init();
+    AdcIf_Init();
+    PwmHw_SimSetAccessCost(BENCH_ACCESS_TICKS);
+    PwmHw_SimSetPeriodCallback(Bench_PeriodCallback);
+
+    Bench_Compute = compute;
+    Bench_Tag = 0u;
+    Bench_LastActive = 0u;
+    Bench_DelayCount = 0u;
+    Bench_Updates = 0u;
+    Bench_Group1Count = 0u;
+}
+
+static void Bench_Report(const char *name)
+{
+    uint32 late = 0u;
+    uint32 n = Bench_DelayCount;
+
+    for (uint32 i = 0; i < n; i++)
+    {
+        if (Bench_Delay[i] > PWMIF_PERIOD_TICKS)
+        {
+            late++;
+        }
+    }
+    qsort(Bench_Delay, n, sizeof(uint32), Bench_CompareU32);
+    printf("  %-26s %5u %8u %8u %9.2f %9.2f %9.2f %7u\n", name, (unsigned)Bench_Compute,
+           (unsigned)Bench_Updates, (unsigned)n,
+           (n > 0u) ? TICKS_TO_US(Bench_Delay[n / 2u]) : 0.0,
+           (n > 0u) ? TICKS_TO_US(Bench_Delay[(n * 99u) / 100u]) : 0.0,
+           (n > 0u) ? TICKS_TO_US(Bench_Delay[n - 1u]) : 0.0, (unsigned)late);
+}
+
+static void Bench_RunTriggered(uint32 compute)
+{
+    Bench_Setup(compute);
+    PwmHw_SimSetTriggerCallback(AdcHw_SimHardwareTrigger);
+    AdcIf_RegisterGroupNotification(ADCIF_GROUP_0, Bench_ControlStep);
+    AdcIf_RegisterGroupNotification(ADCIF_GROUP_1, Bench_Group1Notification);
+    AdcIf_EnableGroupTrigger();
+
+    SimTime_Advance((uint64)BENCH_PERIODS * PWMIF_PERIOD_TICKS);
+    Bench_Report("PWM triggered");
+}
+
+static void Bench_RunPolled(uint32 compute)
+{
+    Bench_Setup(compute);
+    (void)SimTime_Schedule(BENCH_POLL_PERIOD_TICKS, Bench_PollTask, 0u);
+
+    SimTime_Advance((uint64)BENCH_PERIODS * PWMIF_PERIOD_TICKS);
+    Bench_Report("1 kHz start + read");
+}
+
+int main(void)
+{
+    Bench_Delay = malloc(BENCH_PERIODS * sizeof(uint32));
+
+    printf("Sample-to-actuation delay, %u periods of %u ticks (%.1f us), ADC %u ticks/channel\n",
+           (unsigned)BENCH_PERIODS, (unsigned)PWMIF_PERIOD_TICKS, TICKS_TO_US(PWMIF_PERIOD_TICKS),
+           (unsigned)BENCH_CHANNEL_TICKS);
+    printf("  %-26s %5s %8s %8s %9s %9s %9s %7s\n", "scheme", "calc", "updates", "latched",
+           "p50 us", "p99 us", "max us", "late");
+    for (uint32 i = 0; i < sizeof(Bench_ComputeTicks) / sizeof(Bench_ComputeTicks[0]); i++)
+    {
+        Bench_RunTriggered(Bench_ComputeTicks[i]);
+        if (i == 0u)
+        {
+            printf("    group 1 results: %u (%.1f Hz), ADC overruns: %u\n",
+                   (unsigned)Bench_Group1Count,
+                   (double)Bench_Group1Count * SIMTIME_TICKS_PER_SECOND /
+                   ((double)BENCH_PERIODS * PWMIF_PERIOD_TICKS),
+                   (unsigned)AdcHw_SimGetOverruns());
+        }
+    }
+    Bench_RunPolled(Bench_ComputeTicks[0]);
+
+    free(Bench_Delay);
+    return 0;
+}
@@ -0,0 +1,48 @@
+/*
+ * Bench.c - Timing Helpers Shared by the Host Benchmarks
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the clock reads and the cost report
+ *              used by the benchmarks in HostSim/Bench
+ */
+
+#include <stdio.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Bench.h"
+
+uint64 Bench_ClockNs(clockid_t clock)
+{
+    struct timespec ts;
+    (void)clock_gettime(clock, &ts);
+    return (uint64)ts.tv_sec * 1000000000u + (uint64)ts.tv_nsec;
+}
+
+uint64 Bench_NowNs(void)
+{
+    return Bench_ClockNs(CLOCK_MONOTONIC);
+}
+
+uint64 Bench_Cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0u;
+#endif
+}
+
+void Bench_PrintCost(const char *name, int width, uint64 ns, uint64 cycles,
+                     uint32 count, const char *unit)
+{
+    printf("  %-*s %7.2f ns/%s", width, name, (double)ns / count, unit);
+    if (cycles != 0u)
+    {
+        printf("  %7.1f TSC cycles/%s", (double)cycles / count, unit);
+    }
+    printf("\n");
+}
@@ -0,0 +1,42 @@
+/*
+ * Bench.h - Timing Helpers Shared by the Host Benchmarks
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Wall clock, CPU clock and TSC reads and the per-call cost
+ *              line printed by the micro benchmarks
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <time.h>
+
+#include "Std_Types.h"
+
+/* Nanoseconds on the given POSIX clock, e.g. CLOCK_THREAD_CPUTIME_ID */
+uint64 Bench_ClockNs(clockid_t clock);
+
+/* Nanoseconds on the monotonic wall clock */
+uint64 Bench_NowNs(void);
+
+/**
+ * @brief   Read the time stamp counter
+ * @return  TSC value, 0 on hosts without one
+ */
+uint64 Bench_Cycles(void);
+
+/**
+ * @brief   Print the average cost of one operation of a timed loop
+ * @param   name    Label, left-aligned in a column of the given width
+ * @param   width   Label column width
+ * @param   ns      Wall time of the loop
+ * @param   cycles  TSC cycles of the loop; the cycle column is omitted if 0
+ * @param   count   Operations in the loop
+ * @param   unit    Operation name in the cost columns, e.g. "call"
+ */
+void Bench_PrintCost(const char *name, int width, uint64 ns, uint64 cycles,
+                     uint32 count, const char *unit);
+
+#endif /* BENCH_H */
@@ -0,0 +1,251 @@
+/*
+ * BusOff_Bench.c - CAN Bus-Off Recovery and Transmit Backlog Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Sends eight cyclic frames, each every 10 ms, through CanSM
+ *              on the paced loopback bus and takes the controller to
+ *              bus-off, once as a single bus-off and once for a bus
+ *              disturbance of 300 ms, during which every restart ends in
+ *              the next bus-off. Each case repeats with every backlog
+ *              policy and reports, per policy:
+ *              - the recovery time, from the end of the disturbance and from
+ *                the first bus-off to the first frame received,
+ *              - the frames received in the 10 ms after the recovery against
+ *                the 8 of a normal period,
+ *              - the age of the oldest frame received after a recovery,
+ *              - the CanSM restarts and backlog counts.
+ */
+
+#include <stdio.h>
+
+#include "Det.h"
+#include "Tm.h"
+#include "SimTime.h"
+#include "ComM.h"
+#include "CanSM.h"
+#include "CanFdHw.h"
+
+#define BENCH_MS                     (SIMTIME_TICKS_PER_SECOND / 1000u)
+#define BENCH_MS_NS                  (1000000u)
+
+/* Cyclic frames: IDs, period, 8 bytes; the send time is in bytes 0..3 */
+#define BENCH_FRAMES                 (8u)
+#define BENCH_FRAME_ID               (0x200u)
+#define BENCH_PERIOD_MS              (10u)
+
+/* Scenario repetitions, spaced so each one starts with fast recovery */
+#define BENCH_REPEATS                (20u)
+#define BENCH_SPACING_MS             (1000u)
+#define BENCH_FIRST_MS               (100u)
+
+static const uint32 Bench_Disturbances[] = {1u, 300u};
+
+static const char *const Bench_PolicyNames[] = {"drop", "latest", "all"};
+
+static uint32 Bench_NowMs;
+
+/* Per scenario, over the repetitions */
+static uint32 Bench_MaxFromEnd;
+static uint32 Bench_MaxFromStart;
+static uint32 Bench_MaxBurst;
+static uint32 Bench_MaxAge;
+
+static void Bench_SendCyclic(void)
+{
+    CanSM_FdFrameType frame;
+
+    for (uint32 i = 0; i < BENCH_FRAMES; i++)
+    {
+        if ((Bench_NowMs % BENCH_PERIOD_MS) != i)
+        {
+            continue;
+        }
+        frame.id = BENCH_FRAME_ID + i;
+        frame.length = 8u;
+        frame.brs = TRUE;
+        for (uint32 b = 0; b < 8u; b++)
+        {
+            frame.data[b] = (b < 4u) ? (uint8)(Bench_NowMs >> (8u * b)) : 0u;
+        }
+        (void)CanSM_TransmitFdFrame(&frame);
+    }
+}
+
+/* Frames received in this tick, and the age of the oldest one */
+static uint32 Bench_Receive(uint32 *oldest)
+{
+    CanSM_FdFrameType frame;
+    uint32 count = 0u;
+    uint32 sentMs;
+
+    *oldest = 0u;
+    while (CanSM_ReceiveFdFrame(&frame) == E_OK)
+    {
+        sentMs = (uint32)frame.data[0] | ((uint32)frame.data[1] << 8) |
+                 ((uint32)frame.data[2] << 16) | ((uint32)frame.data[3] << 24);
+        if (Bench_NowMs - sentMs > *oldest)
+        {
+            *oldest = Bench_NowMs - sentMs;
+        }
+        count++;
+    }
+    return count;
+}
+
+/* One 1 ms tick; the bus is disturbed up to disturbedUntil */
+static uint32 Bench_Tick(uint32 disturbedUntil, uint32 *restarts, uint32 *oldest)
+{
+    CanSM_StatisticsType stats;
+
+    Bench_NowMs++;
+    SimTime_Advance(BENCH_MS);
+    CanFdHw_LoopbackGrantBusTime(BENCH_MS_NS);
+
+    /* A controller restarted into the disturbance goes bus-off again */
+    (void)CanSM_GetStatistics(&stats);
+    if (Bench_NowMs < disturbedUntil && stats.restarts != *restarts)
+    {
+        *restarts = stats.restarts;
+        CanFdHw_LoopbackBusOff();
+    }
+
+    Bench_SendCyclic();
+    ComM_MainFunction();
+    CanSM_MainFunction();
+    return Bench_Receive(oldest);
+}
+
+static void Bench_Scenario(uint32 disturbanceMs)
+{
+    CanSM_StatisticsType stats;
+    uint32 restarts = 0u;
+    uint32 start;
+    uint32 end;
+    uint32 received;
+    uint32 oldest;
+    uint32 burst;
+    boolean recovered;
+
+    Bench_MaxFromEnd = 0u;
+    Bench_MaxFromStart = 0u;
+    Bench_MaxBurst = 0u;
+    Bench_MaxAge = 0u;
+
+    for (uint32 r = 0; r < BENCH_REPEATS; r++)
+    {
+        /* Normal traffic up to the bus-off */
+        start = Bench_NowMs + BENCH_FIRST_MS;
+        while (Bench_NowMs < start)
+        {
+            (void)Bench_Tick(0u, &restarts, &oldest);
+        }
+
+        (void)CanSM_GetStatistics(&stats);
+        restarts = stats.restarts;
+        CanFdHw_LoopbackBusOff();
+        end = start + disturbanceMs;
+
+        /* Up to the first frame received after the disturbance */
+        recovered = FALSE;
+        while (recovered == FALSE)
+        {
+            received = Bench_Tick(end, &restarts, &oldest);
+            if (received > 0u && Bench_NowMs >= end)
+            {
+                recovered = TRUE;
+            }
+        }
+        if (Bench_NowMs - end > Bench_MaxFromEnd)
+        {
+            Bench_MaxFromEnd = Bench_NowMs - end;
+        }
+        if (Bench_NowMs - start > Bench_MaxFromStart)
+        {
+            Bench_MaxFromStart = Bench_NowMs - start;
+        }
+
+        /* The period after the recovery */
+        burst = received;
+        for (uint32 t = 1u; t < BENCH_PERIOD_MS; t++)
+        {
+            if (oldest > Bench_MaxAge)
+            {
+                Bench_MaxAge = oldest;
+            }
+            burst += Bench_Tick(0u, &restarts, &oldest);
+        }
+        if (oldest > Bench_MaxAge)
+        {
+            Bench_MaxAge = oldest;
+        }
+        if (burst > Bench_MaxBurst)
+        {
+            Bench_MaxBurst = burst;
+        }
+
+        /* Settle: tx ensured, the next repetition starts fast again */
+        start = Bench_NowMs + BENCH_SPACING_MS;
+        while (Bench_NowMs < start)
+        {
+            (void)Bench_Tick(0u, &restarts, &oldest);
+        }
+    }
+}
+
+static void Bench_Print(uint32 disturbanceMs, uint8 policy, const CanSM_StatisticsType *before,
+                        const CanSM_StatisticsType *after)
+{
+    printf("  %5u %-7s %7u %9u %6u/%u %7u %8u %9u %8u %8u %8u %8u\n", (unsigned)disturbanceMs,
+           Bench_PolicyNames[policy], (unsigned)Bench_MaxFromEnd, (unsigned)Bench_MaxFromStart,
+           (unsigned)Bench_MaxBurst, (unsigned)BENCH_FRAMES, (unsigned)Bench_MaxAge,
+           (unsigned)((after->restarts - before->restarts) / BENCH_REPEATS),
+           (unsigned)(after->backlogged - before->backlogged),
+           (unsigned)(after->backlogReplaced - before->backlogReplaced),
+           (unsigned)(after->backlogDropped - before->backlogDropped),
+           (unsigned)(after->backlogExpired - before->backlogExpired),
+           (unsigned)(after->backlogSent - before->backlogSent));
+}
+
+int main(void)
+{
+    CanSM_StatisticsType before;
+    CanSM_StatisticsType after;
+    uint32 restarts = 0u;
+    uint32 oldest;
+
+    Det_Init();
+    SimTime_Init();
+    Tm_Init();
+    ComM_Init();
+    CanSM_Init();
+
+    /* ComM and CanSM main functions take the network to full communication */
+    Bench_NowMs = 0u;
+    (void)Bench_Tick(0u, &restarts, &oldest);
+
+    printf("Bus-off recovery, %u cyclic frames every %u ms, %u bus-offs per row [ms]\n",
+           (unsigned)BENCH_FRAMES, (unsigned)BENCH_PERIOD_MS, (unsigned)BENCH_REPEATS);
+    printf("  %5s %-7s %7s %9s %8s %7s %8s %9s %8s %8s %8s %8s\n", "dist", "policy", "to end",
+           "to start", "burst", "age", "restart", "backlog", "replaced", "dropped", "expired",
+           "sent");
+    for (uint32 d = 0; d < sizeof(Bench_Disturbances) / sizeof(Bench_Disturbances[0]); d++)
+    {
+        for (uint8 policy = CANSM_BACKLOG_DROP; policy <= CANSM_BACKLOG_ALL; policy++)
+        {
+            (void)CanSM_SetBacklogPolicy(policy);
+            (void)CanSM_GetStatistics(&before);
+            Bench_Scenario(Bench_Disturbances[d]);
+            (void)CanSM_GetStatistics(&after);
+            Bench_Print(Bench_Disturbances[d], policy, &before, &after);
+        }
+    }
+
+    (void)CanSM_GetStatistics(&after);
+    printf("CanSM: %u bus-offs, %u restarts, %u recoveries, max %u ms bus-off to next frame sent\n",
+           (unsigned)after.busOffs, (unsigned)after.restarts, (unsigned)after.recoveries,
+           (unsigned)after.maxRecoveryMs);
+
+    return 0;
+}
@@ -0,0 +1,215 @@
+/*
+ * CanBuf_Bench.c - Compact CAN Frame Buffer RAM and Copy Cost Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Reports the RAM a frame queue takes at typical depths when
+ *              it holds CanSM_FdFrameType elements and when it holds CanBuf
+ *              entries of each DLC class. Then measures the cost per frame
+ *              of passing frames through a queue, filled to its depth and
+ *              drained again as after a bus burst: a ring of
+ *              CanSM_FdFrameType copied by assignment, as the loopback bus
+ *              kept it, against CanBuf queues, for 8-byte MotorControl.dbc
+ *              frames and for full 64-byte FD frames. The deepest queue no
+ *              longer fits the first level cache as a CanSM_FdFrameType
+ *              ring; run to run, the two are then about even for 8-byte
+ *              frames. Everywhere else the struct ring is faster.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Det.h"
+#include "CanSM.h"
+#include "CanBuf.h"
+#include "Bench.h"
+
+#define BENCH_FRAMES                 (1u << 24)
+#define BENCH_MAX_DEPTH              (4096u)
+
+static const uint32 Bench_Depths[] = {16u, 64u, 256u, 4096u};
+static const uint32 Bench_Classes[] = {CANBUF_CLASS_8, CANBUF_CLASS_16, CANBUF_CLASS_32, CANBUF_CLASS_64};
+
+/* Baseline: ring of full frame structures */
+static CanSM_FdFrameType Bench_Ring[BENCH_MAX_DEPTH];
+static uint32 Bench_RingDepth;
+static uint32 Bench_RingHead;
+static uint32 Bench_RingTail;
+static uint32 Bench_Storage[CANBUF_QUEUE_WORDS(BENCH_MAX_DEPTH, CANBUF_CLASS_64)];
+static CanBuf_QueueType Bench_Queue;
+static volatile uint32 Bench_Sink;
+
+static void Bench_MakeFrame(CanSM_FdFrameType *frame, uint8 length)
+{
+    (void)memset(frame, 0, sizeof(*frame));
+    frame->id = CANSM_MOTOR_STATUS_ID;
+    frame->length = length;
+    frame->brs = TRUE;
+    for (uint32 i = 0; i < length; i++)
+    {
+        frame->data[i] = (uint8)(i * 37u + 1u);
+    }
+}
+
+static void Bench_Ram(void)
+{
+    printf("Queue RAM [bytes], CanSM_FdFrameType is %u bytes\n", (unsigned)sizeof(CanSM_FdFrameType));
+    printf("  %6s %12s", "depth", "FdFrameType");
+    for (uint32 c = 0; c < sizeof(Bench_Classes) / sizeof(Bench_Classes[0]); c++)
+    {
+        printf(" %9s%-3u", "class ", (unsigned)Bench_Classes[c]);
+    }
+    printf("\n");
+
+    for (uint32 d = 0; d < sizeof(Bench_Depths) / sizeof(Bench_Depths[0]); d++)
+    {
+        printf("  %6u %12u", (unsigned)Bench_Depths[d],
+               (unsigned)(Bench_Depths[d] * sizeof(CanSM_FdFrameType)));
+        for (uint32 c = 0; c < sizeof(Bench_Classes) / sizeof(Bench_Classes[0]); c++)
+        {
+            printf(" %12u", (unsigned)(CANBUF_QUEUE_WORDS(Bench_Depths[d], Bench_Classes[c]) * 4u));
+        }
+        printf("\n");
+    }
+}
+
+/* Baseline put and get, kept out of line like the CanBuf calls */
+__attribute__((noinline)) static Std_ReturnType Bench_RingPut(const CanSM_FdFrameType *frame)
+{
+    if ((Bench_RingHead - Bench_RingTail) >= Bench_RingDepth)
+    {
+        return E_NOT_OK;
+    }
+    Bench_Ring[Bench_RingHead & (Bench_RingDepth - 1u)] = *frame;
+    Bench_RingHead++;
+    return E_OK;
+}
+
+__attribute__((noinline)) static Std_ReturnType Bench_RingGet(CanSM_FdFrameType *frame)
+{
+    if (Bench_RingHead == Bench_RingTail)
+    {
+        return E_NOT_OK;
+    }
+    *frame = Bench_Ring[Bench_RingTail & (Bench_RingDepth - 1u)];
+    Bench_RingTail++;
+    return E_OK;
+}
+
+/* Fill the ring to its depth, then drain it */
+static void Bench_RingCost(uint32 depth, const CanSM_FdFrameType *frame)
+{
+    CanSM_FdFrameType out;
+    uint32 acc = 0u;
+    uint64 startNs;
+    uint64 startCycles;
+
+    Bench_RingDepth = depth;
+    Bench_RingHead = 0u;
+    Bench_RingTail = 0u;
+    startNs = Bench_NowNs();
+    startCycles = Bench_Cycles();
+    for (uint32 n = 0; n < BENCH_FRAMES; n += depth)
+    {
+        for (uint32 i = 0; i < depth; i++)
+        {
+            (void)Bench_RingPut(frame);
+        }
+        for (uint32 i = 0; i < depth; i++)
+        {
+            (void)Bench_RingGet(&out);
+            acc += out.data[out.length - 1u];
+        }
+    }
+    uint64 cycles = Bench_Cycles() - startCycles;
+    Bench_PrintCost("CanSM_FdFrameType ring", 34, Bench_NowNs() - startNs, cycles,
+                    BENCH_FRAMES, "frame");
+    Bench_Sink = acc;
+}
+
+static void Bench_QueueCost(uint32 depth, uint32 payloadClass, const CanSM_FdFrameType *frame)
+{
+    CanSM_FdFrameType out;
+    char name[40];
+    uint32 acc = 0u;
+    uint64 startNs;
+    uint64 startCycles;
+
+    (void)CanBuf_InitQueue(&Bench_Queue, Bench_Storage, depth, payloadClass);
+    startNs = Bench_NowNs();
+    startCycles = Bench_Cycles();
+    for (uint32 n = 0; n < BENCH_FRAMES; n += depth)
+    {
+        for (uint32 i = 0; i < depth; i++)
+        {
+            (void)CanBuf_Put(&Bench_Queue, frame);
+        }
+        for (uint32 i = 0; i < depth; i++)
+        {
+            (void)CanBuf_Get(&Bench_Queue, &out);
+            acc += out.data[out.length - 1u];
+        }
+    }
+    uint64 cycles = Bench_Cycles() - startCycles;
+    (void)snprintf(name, sizeof(name), "CanBuf queue, class %u", (unsigned)payloadClass);
+    Bench_PrintCost(name, 34, Bench_NowNs() - startNs, cycles,
+                    BENCH_FRAMES, "frame");
+    Bench_Sink = acc;
+}
+
+static void Bench_Copy(uint8 length)
+{
+    CanSM_FdFrameType frame;
+
+    Bench_MakeFrame(&frame, length);
+    for (uint32 d = 0; d < sizeof(Bench_Depths) / sizeof(Bench_Depths[0]); d++)
+    {
+        printf("Put + get, %u-byte frames, depth %u (%u frames)\n", (unsigned)length,
+               (unsigned)Bench_Depths[d], (unsigned)BENCH_FRAMES);
+        Bench_RingCost(Bench_Depths[d], &frame);
+        for (uint32 c = 0; c < sizeof(Bench_Classes) / sizeof(Bench_Classes[0]); c++)
+        {
+            if (length <= Bench_Classes[c])
+            {
+                Bench_QueueCost(Bench_Depths[d], Bench_Classes[c], &frame);
+            }
+        }
+    }
+}
+
+/* Round trip through a queue must give back the same frames */
+static void Bench_Check(void)
+{
+    CanSM_FdFrameType in;
+    CanSM_FdFrameType out;
+    uint32 errors = 0u;
+
+    (void)CanBuf_InitQueue(&Bench_Queue, Bench_Storage, 64u, CANBUF_CLASS_64);
+    for (uint32 length = 0; length <= 64u; length++)
+    {
+        Bench_MakeFrame(&in, (uint8)length);
+        in.id = 0x1ABCDEF0u + length;
+        in.brs = ((length & 1u) != 0u) ? TRUE : FALSE;
+        (void)CanBuf_Put(&Bench_Queue, &in);
+        (void)memset(&out, 0, sizeof(out));
+        if (CanBuf_Get(&Bench_Queue, &out) != E_OK || out.id != in.id || out.brs != in.brs ||
+            out.length != in.length || memcmp(out.data, in.data, length) != 0)
+        {
+            errors++;
+        }
+    }
+    printf("Round trip, lengths 0..64: %u mismatches\n", (unsigned)errors);
+}
+
+int main(void)
+{
+    Det_Init();
+
+    Bench_Ram();
+    Bench_Check();
+    Bench_Copy(8u);
+    Bench_Copy(64u);
+
+    return 0;
+}
@@ -0,0 +1,300 @@
+/*
+ * CanFdHw_Shm_Bench.c - Shared-Memory CAN-FD Bus Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Forks several ECU processes onto the shared-memory bus and
+ *              measures frame rate and transmit-to-receive latency through
+ *              the full CanSM path, unpaced and paced at 500 kbit/s /
+ *              2 Mbit/s, and checks that the frames of every ID arrive in
+ *              the order they were sent. A UNIX datagram socket pair
+ *              provides the socket-based loopback baseline.
+ */
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Det.h"
+#include "CanSM.h"
+#include "CanFdHw.h"
+#include "Bench.h"
+
+#define BENCH_SHM_NAME               "/canfdhw_bench"
+#define BENCH_MAX_SENDERS            (4u)
+
+/* Receivers stop once all senders are done and the bus stayed quiet this long */
+#define BENCH_DRAIN_NS               (20000000u)
+
+typedef struct {
+    const char *name;
+    boolean paced;
+    uint32 nodes;
+    uint32 senders;
+    uint32 framesPerSender;
+    uint8 length;
+} Bench_ScenarioType;
+
+static const Bench_ScenarioType Bench_Scenarios[] = {
+    {"unpaced, 1 sender, 8 byte", FALSE, 4u, 1u, 200000u, 8u},
+    {"unpaced, 2 senders, 64 byte", FALSE, 4u, 2u, 100000u, 64u},
+    {"paced 500k/2M, 2 senders, 64 byte", TRUE, 4u, 2u, 1000u, 64u},
+    {"paced 500k/2M, 2 senders, 8 byte", TRUE, 4u, 2u, 2000u, 8u}
+};
+
+/* Number of senders that finished, shared by all forked nodes */
+static _Atomic uint32 *Bench_SendersDone;
+
+static int Bench_CompareU32(const void *a, const void *b)
+{
+    uint32 x = *(const uint32 *)a;
+    uint32 y = *(const uint32 *)b;
+    return (x > y) - (x < y);
+}
+
+static void Bench_PrintLatency(const char *label, uint32 *lat, uint32 count)
+{
+    if (count == 0u)
+    {
+        printf("    %-10s no frames\n", label);
+        return;
+    }
+    qsort(lat, count, sizeof(uint32), Bench_CompareU32);
+    printf("    %-10s p50 %7.2f us  p99 %7.2f us  max %8.2f us\n", label,
+           lat[count / 2u] / 1000.0, lat[(count * 99u) / 100u] / 1000.0, lat[count - 1u] / 1000.0);
+}
+
+static void Bench_Sender(const Bench_ScenarioType *sc, uint32 index)
+{
+    CanSM_FdFrameType frame;
+    uint64 now;
+
+    (void)memset(&frame, 0, sizeof(frame));
+    frame.id = 0x100u * (index + 1u);
+    frame.length = sc->length;
+    frame.brs = TRUE;
+
+    for (uint32 i = 0; i < sc->framesPerSender; i++)
+    {
+        now = Bench_NowNs();
+        (void)memcpy(&frame.data[0], &now, sizeof(now));
+        while (CanSM_TransmitFdFrame(&frame) != E_OK)
+        {
+            (void)sched_yield();
+        }
+    }
+
+    /* Frames still in our mailboxes are arbitrated by the polling receivers */
+    atomic_fetch_add(Bench_SendersDone, 1u);
+}
+
+static void Bench_Receiver(const Bench_ScenarioType *sc)
+{
+    CanSM_FdFrameType frame;
+    CanFdHw_StatisticsType stats;
+    uint32 *lat[BENCH_MAX_SENDERS];
+    uint32 count[BENCH_MAX_SENDERS] = {0u};
+    uint64 lastSent[BENCH_MAX_SENDERS] = {0u};
+    uint32 reordered = 0u;
+    uint64 idleSince = 0u;
+    uint32 total = 0u;
+    uint64 first = 0u;
+    uint64 last = 0u;
+    uint64 sent;
+    uint64 now;
+    uint32 sender;
+    char label[16];
+
+    for (uint32 s = 0; s < sc->senders; s++)
+    {
+        lat[s] = malloc(sc->framesPerSender * sizeof(uint32));
+    }
+
+    for (;;)
+    {
+        if (CanSM_ReceiveFdFrame(&frame) != E_OK)
+        {
+            now = Bench_NowNs();
+            if (atomic_load(Bench_SendersDone) < sc->senders || idleSince == 0u)
+            {
+                idleSince = now;
+            }
+            else if ((now - idleSince) > BENCH_DRAIN_NS)
+            {
+                break;
+            }
+            /* Let the other ECU processes run when cores are scarce */
+            (void)sched_yield();
+            continue;
+        }
+        now = Bench_NowNs();
+        idleSince = 0u;
+        sender = frame.id / 0x100u - 1u;
+        (void)memcpy(&sent, &frame.data[0], sizeof(sent));
+        if (sender < sc->senders && count[sender] < sc->framesPerSender)
+        {
+            lat[sender][count[sender]++] = (uint32)(now - sent);
+        }
+        if (sender < sc->senders)
+        {
+            /* Send timestamps of one ID only increase */
+            reordered += (sent < lastSent[sender]) ? 1u : 0u;
+            lastSent[sender] = sent;
+        }
+        if (total == 0u)
+        {
+            first = now;
+        }
+        last = now;
+        total++;
+    }
+
+    CanFdHw_GetStatistics(&stats);
+    printf("  node %u: %u/%u frames, %u lost, %u out of order, %.0f frames/s, bus time %.1f ms\n",
+           (unsigned)CanFdHw_ShmGetNodeId(), (unsigned)total,
+           (unsigned)(sc->senders * sc->framesPerSender), (unsigned)stats.rxOverruns, (unsigned)reordered,
+           (last > first) ? (double)(total - 1u) * 1e9 / (double)(last - first) : 0.0,
+           (double)stats.busTimeNs / 1e6);
+    for (uint32 s = 0; s < sc->senders; s++)
+    {
+        (void)snprintf(label, sizeof(label), "id 0x%03X", (unsigned)(0x100u * (s + 1u)));
+        Bench_PrintLatency(label, lat[s], count[s]);
+        free(lat[s]);
+    }
+}
+
+static void Bench_RunScenario(const Bench_ScenarioType *sc)
+{
+    int ready[2];
+    int go[2];
+    char token = 0;
+    pid_t pid;
+
+    printf("%s (%u nodes)\n", sc->name, (unsigned)sc->nodes);
+    fflush(stdout);
+    CanFdHw_ShmUnlink(BENCH_SHM_NAME);
+    atomic_store(Bench_SendersDone, 0u);
+    if (pipe(ready) != 0 || pipe(go) != 0)
+    {
+        return;
+    }
+
+    for (uint32 n = 0; n < sc->nodes; n++)
+    {
+        pid = fork();
+        if (pid == 0)
+        {
+            CanFdHw_ShmConfigure(BENCH_SHM_NAME, sc->paced);
+            Det_Init();
+            CanSM_Init();
+            CanSM_SetState(CANSM_READY);
+
+            /* Everyone joins before the first frame goes out */
+            (void)write(ready[1], &token, 1);
+            (void)read(go[0], &token, 1);
+
+            if (n < sc->senders)
+            {
+                Bench_Sender(sc, n);
+            }
+            else
+            {
+                Bench_Receiver(sc);
+            }
+            CanFdHw_ShmClose();
+            fflush(stdout);
+            _exit(0);
+        }
+    }
+
+    for (uint32 n = 0; n < sc->nodes; n++)
+    {
+        (void)read(ready[0], &token, 1);
+    }
+    for (uint32 n = 0; n < sc->nodes; n++)
+    {
+        (void)write(go[1], &token, 1);
+    }
+    while (wait(NULL) > 0)
+    {
+    }
+
+    (void)close(ready[0]);
+    (void)close(ready[1]);
+    (void)close(go[0]);
+    (void)close(go[1]);
+    CanFdHw_ShmUnlink(BENCH_SHM_NAME);
+}
+
+static void Bench_RunSocketBaseline(uint32 frames)
+{
+    int sv[2];
+    CanSM_FdFrameType frame;
+    uint32 *lat;
+    uint64 first = 0u;
+    uint64 last = 0u;
+    uint64 sent;
+    uint64 now;
+
+    printf("socket baseline: UNIX datagram socket pair, 8 byte, 1 receiver\n");
+    fflush(stdout);
+    if (socketpair(AF_UNIX, SOCK_DGRAM, 0, sv) != 0)
+    {
+        return;
+    }
+
+    if (fork() == 0)
+    {
+        lat = malloc(frames * sizeof(uint32));
+        for (uint32 i = 0; i < frames; i++)
+        {
+            (void)recv(sv[1], &frame, sizeof(frame), 0);
+            now = Bench_NowNs();
+            (void)memcpy(&sent, &frame.data[0], sizeof(sent));
+            lat[i] = (uint32)(now - sent);
+            if (i == 0u)
+            {
+                first = now;
+            }
+            last = now;
+        }
+        printf("  receiver: %u frames, %.0f frames/s\n", (unsigned)frames,
+               (double)(frames - 1u) * 1e9 / (double)(last - first));
+        Bench_PrintLatency("socket", lat, frames);
+        free(lat);
+        fflush(stdout);
+        _exit(0);
+    }
+
+    (void)memset(&frame, 0, sizeof(frame));
+    frame.id = 0x100u;
+    frame.length = 8u;
+    for (uint32 i = 0; i < frames; i++)
+    {
+        now = Bench_NowNs();
+        (void)memcpy(&frame.data[0], &now, sizeof(now));
+        (void)send(sv[0], &frame, sizeof(frame), 0);
+    }
+    (void)wait(NULL);
+    (void)close(sv[0]);
+    (void)close(sv[1]);
+}
+
+int main(void)
+{
+    Bench_SendersDone = mmap(NULL_PTR, sizeof(*Bench_SendersDone), PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    for (uint32 i = 0; i < sizeof(Bench_Scenarios) / sizeof(Bench_Scenarios[0]); i++)
+    {
+        Bench_RunScenario(&Bench_Scenarios[i]);
+    }
+    Bench_RunSocketBaseline(200000u);
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * CanTp_Bench.c - ISO-TP Throughput Benchmark on the Loopback Bus
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Runs concurrent multi-kilobyte CanTp transfers over the
+ *              in-process loopback bus, paced at 500 kbit/s nominal and
+ *              2 Mbit/s data rate, and compares the achieved payload rate
+ *              with the bus-load limit. Runs on the connections of
+ *              CanTp_Cfg.c: the bench wires them in pairs by translating
+ *              the CAN IDs between sender and receiver, as a gateway would.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Det.h"
+#include "CanTp.h"
+#include "CanSM.h"
+#include "CanFdHw.h"
+#include "Bench.h"
+
+/* Bus time granted per simulated main function period */
+#define BENCH_TICK_NS                (CANTP_MAIN_FUNCTION_PERIOD_MS * 1000000u)
+
+/* Payload size per transfer; above 4095 to exercise the escaped first frame */
+#define BENCH_PAYLOAD_SIZE           (16384u)
+
+#define BENCH_ITERATIONS             (20u)
+
+/* Sender and receiver connection of each transfer */
+static const uint8 Bench_Pairs[2][2] = {
+    {CANTP_CONN_DIAG, CANTP_CONN_TRACE},
+    {CANTP_CONN_ECU2, CANTP_CONN_CALIBRATION}
+};
+
+static uint8 Bench_TxData[2][BENCH_PAYLOAD_SIZE];
+static uint8 Bench_RxData[2][BENCH_PAYLOAD_SIZE];
+static uint32 Bench_RxDone;
+static uint32 Bench_RxErrors;
+
+static void Bench_RxIndication(uint8 ConnectionId, const uint8 *Data, uint32 Length,
+                               Std_ReturnType Result)
+{
+    uint8 pair = (ConnectionId == Bench_Pairs[0][1]) ? 0u : 1u;
+
+    if (Result != E_OK || Length != BENCH_PAYLOAD_SIZE ||
+        memcmp(Data, Bench_TxData[pair], Length) != 0)
+    {
+        Bench_RxErrors++;
+    }
+    Bench_RxDone++;
+}
+
+/* Deliver a frame of one side of a pair on the receive ID of the other */
+static void Bench_Wire(CanSM_FdFrameType *frame)
+{
+    const CanTp_ConnectionConfigType *sender;
+    const CanTp_ConnectionConfigType *receiver;
+
+    for (uint32 p = 0; p < 2u; p++)
+    {
+        sender = &CanTp_ConnectionConfig[Bench_Pairs[p][0]];
+        receiver = &CanTp_ConnectionConfig[Bench_Pairs[p][1]];
+        if (frame->id == sender->txId)
+        {
+            frame->id = receiver->rxId;
+            return;
+        }
+        if (frame->id == receiver->txId)
+        {
+            frame->id = sender->rxId;
+            return;
+        }
+    }
+}
+
+int main(void)
+{
+    CanSM_FdFrameType frame;
+    CanFdHw_StatisticsType stats;
+    uint64 ticks = 0u;
+    uint64 start;
+    uint64 wallNs;
+    uint32 limitNs;
+    double limitBytesPerSec;
+    double achievedBytesPerSec;
+
+    for (uint32 i = 0; i < BENCH_PAYLOAD_SIZE; i++)
+    {
+        Bench_TxData[0][i] = (uint8)(i * 7u);
+        Bench_TxData[1][i] = (uint8)(i * 13u + 1u);
+    }
+
+    Det_Init();
+    CanSM_Init();
+    CanSM_SetState(CANSM_READY);
+    CanTp_Init();
+    for (uint32 p = 0; p < 2u; p++)
+    {
+        CanTp_SetRxBuffer(Bench_Pairs[p][1], Bench_RxData[p], BENCH_PAYLOAD_SIZE);
+        CanTp_RegisterCallbacks(Bench_Pairs[p][1], NULL_PTR, Bench_RxIndication);
+    }
+
+    start = Bench_NowNs();
+    for (uint32 iter = 0; iter < BENCH_ITERATIONS; iter++)
+    {
+        Bench_RxDone = 0u;
+        (void)CanTp_Transmit(Bench_Pairs[0][0], Bench_TxData[0], BENCH_PAYLOAD_SIZE);
+        (void)CanTp_Transmit(Bench_Pairs[1][0], Bench_TxData[1], BENCH_PAYLOAD_SIZE);
+
+        while (Bench_RxDone < 2u)
+        {
+            CanFdHw_LoopbackGrantBusTime(BENCH_TICK_NS);
+            CanTp_MainFunction();
+            while (CanSM_ReceiveFdFrame(&frame) == E_OK)
+            {
+                Bench_Wire(&frame);
+                CanTp_RxIndication(&frame);
+            }
+            ticks++;
+        }
+    }
+    wallNs = Bench_NowNs() - start;
+
+    CanFdHw_GetStatistics(&stats);
+
+    /* Limit: back-to-back 64 byte consecutive frames carrying 63 bytes each */
+    frame.id = 0x600u;
+    frame.length = 64u;
+    frame.brs = TRUE;
+    limitNs = CanFdHw_FrameDurationNs(&frame, CANFDHW_NOMINAL_BAUDRATE, CANFDHW_DATA_BAUDRATE);
+    limitBytesPerSec = 63.0 * 1e9 / (double)limitNs;
+    achievedBytesPerSec = (double)BENCH_ITERATIONS * 2.0 * BENCH_PAYLOAD_SIZE /
+                          ((double)ticks * BENCH_TICK_NS / 1e9);
+
+    printf("CanTp loopback benchmark: %u x 2 transfers of %u bytes\n",
+           (unsigned)BENCH_ITERATIONS, (unsigned)BENCH_PAYLOAD_SIZE);
+    printf("  errors            : %u\n", (unsigned)Bench_RxErrors);
+    printf("  frames            : %u (rejected %u)\n", (unsigned)stats.txFrames, (unsigned)stats.txRejected);
+    printf("  simulated time    : %llu ms\n", (unsigned long long)ticks * CANTP_MAIN_FUNCTION_PERIOD_MS);
+    printf("  bus load          : %.1f %%\n",
+           100.0 * (double)stats.busTimeNs / ((double)ticks * BENCH_TICK_NS));
+    printf("  payload rate      : %.1f kB/s (limit %.1f kB/s, %.1f %%)\n",
+           achievedBytesPerSec / 1000.0, limitBytesPerSec / 1000.0,
+           100.0 * achievedBytesPerSec / limitBytesPerSec);
+    printf("  host cost         : %.2f ns/byte, %.1f ns/frame\n",
+           (double)wallNs / ((double)BENCH_ITERATIONS * 2.0 * BENCH_PAYLOAD_SIZE),
+           (double)wallNs / (double)stats.txFrames);
+
+    return (Bench_RxErrors == 0u) ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+/*
+ * CoSim_Bench.c - ECU1/ECU2 Co-Simulation and Bus-Load Sweep
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Runs the two nodes of MotorControl.dbc as separate
+ *              processes on the paced shared-memory CAN-FD bus. ECU1 sends
+ *              MOTOR_CMD at a swept rate through CanSM_SendMotorCmd and
+ *              collects MOTOR_STATUS through CanSM_GetMotorStatus; ECU2
+ *              (HostSim/Ecu2) answers every command. Each command carries
+ *              a unique TARGET_SPEED that the unlimited ECU2 ramp echoes
+ *              as ACTUAL_SPEED, which pairs commands with their status.
+ *
+ *              Reported per rate: round-trip latency, frame loss, bus load
+ *              and CPU time per handled frame on both nodes. Only the calls
+ *              that sent or received a frame are timed; idle polling of the
+ *              bus is left out and the clock read cost is subtracted.
+ */
+
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Det.h"
+#include "CanSM.h"
+#include "CanFdHw.h"
+#include "Ecu2.h"
+#include "Bench.h"
+
+#define BENCH_SHM_NAME               "/canfdhw_cosim"
+#define BENCH_WINDOW_NS              (500000000u)    /* measurement window per rate */
+#define BENCH_DRAIN_NS               (20000000u)     /* wait for late statuses */
+#define BENCH_SPEED_RANGE            (60000u)        /* TARGET_SPEED raw range */
+
+static const uint32 Bench_Rates[] = {250u, 500u, 1000u, 2000u, 3000u, 4000u, 5000u, 6000u, 8000u};
+
+/* Results written by the node processes */
+typedef struct {
+    _Atomic uint32 stop;
+    uint32 sent;
+    uint32 matched;
+    uint32 rttP50Ns;
+    uint32 rttP99Ns;
+    uint32 rttMaxNs;
+    uint64 busTimeNs;
+    uint64 ecu1CpuNs;
+    uint32 ecu1Frames;
+    uint64 ecu2CpuNs;
+    uint32 ecu2Frames;
+} Bench_ResultType;
+
+static Bench_ResultType *Bench_Result;
+
+/* CPU cost of the clock reads that bracket a timed call */
+static uint64 Bench_ClockOverheadNs(void)
+{
+    uint64 start = Bench_ClockNs(CLOCK_THREAD_CPUTIME_ID);
+
+    for (uint32 i = 0; i < 1000u; i++)
+    {
+        (void)Bench_ClockNs(CLOCK_THREAD_CPUTIME_ID);
+    }
+    return (Bench_ClockNs(CLOCK_THREAD_CPUTIME_ID) - start) / 1000u;
+}
+
+/* CPU time since start without the clock reads themselves */
+static uint64 Bench_CpuSince(uint64 start, uint64 overhead)
+{
+    uint64 elapsed = Bench_ClockNs(CLOCK_THREAD_CPUTIME_ID) - start;
+    return (elapsed > overhead) ? (elapsed - overhead) : 0u;
+}
+
+static int Bench_CompareU32(const void *a, const void *b)
+{
+    uint32 x = *(const uint32 *)a;
+    uint32 y = *(const uint32 *)b;
+    return (x > y) - (x < y);
+}
+
+static void Bench_JoinBus(void)
+{
+    CanFdHw_ShmConfigure(BENCH_SHM_NAME, TRUE);
+    Det_Init();
+    CanSM_Init();
+    CanSM_SetState(CANSM_READY);
+}
+
+static void Bench_Ecu2Node(void)
+{
+    Ecu2_StatisticsType stats;
+    uint64 overhead = Bench_ClockOverheadNs();
+    uint64 nextTick = Bench_ClockNs(CLOCK_MONOTONIC);
+    uint64 cpuNs = 0u;
+    uint64 cpuStart;
+    uint32 frames = 0u;
+    uint32 handled;
+
+    Ecu2_Init();
+    while (atomic_load(&Bench_Result->stop) == 0u)
+    {
+        cpuStart = Bench_ClockNs(CLOCK_THREAD_CPUTIME_ID);
+        Ecu2_RxProcessing();
+        if (Bench_ClockNs(CLOCK_MONOTONIC) >= nextTick)
+        {
+            Ecu2_MainFunction();
+            nextTick += ECU2_MAIN_FUNCTION_PERIOD_MS * 1000000u;
+        }
+        Ecu2_GetStatistics(&stats);
+        handled = stats.cmdFrames + stats.statusFrames;
+        if (handled != frames)
+        {
+            cpuNs += Bench_CpuSince(cpuStart, overhead);
+            frames = handled;
+        }
+        (void)sched_yield();
+    }
+
+    Bench_Result->ecu2CpuNs = cpuNs;
+    Bench_Result->ecu2Frames = frames;
+}
+
+static void Bench_Ecu1Node(uint32 rate)
+{
+    static uint64 sentAt[BENCH_SPEED_RANGE];
+    static uint32 rtt[BENCH_SPEED_RANGE];
+    CanFdHw_StatisticsType busStart;
+    CanFdHw_StatisticsType busEnd;
+    uint64 periodNs = 1000000000u / rate;
+    uint64 overhead = Bench_ClockOverheadNs();
+    uint64 cpuNs = 0u;
+    uint64 cpuStart;
+    uint64 start = Bench_ClockNs(CLOCK_MONOTONIC);
+    uint64 now = start;
+    uint64 nextSend = start;
+    uint64 endSend = start + BENCH_WINDOW_NS;
+    uint32 sent = 0u;
+    uint32 matched = 0u;
+    uint16 speed;
+
+    (void)memset(sentAt, 0, sizeof(sentAt));
+    CanFdHw_GetStatistics(&busStart);
+
+    while (now < endSend + BENCH_DRAIN_NS)
+    {
+        if (now < endSend && now >= nextSend && sent < BENCH_SPEED_RANGE)
+        {
+            speed = (uint16)sent;
+            sentAt[speed] = now;
+            cpuStart = Bench_ClockNs(CLOCK_THREAD_CPUTIME_ID);
+            CanSM_SendMotorCmd(speed, 0, ECU2_MODE_SPEED);
+            cpuNs += Bench_CpuSince(cpuStart, overhead);
+            sent++;
+            nextSend += periodNs;
+        }
+        cpuStart = Bench_ClockNs(CLOCK_THREAD_CPUTIME_ID);
+        if (CanSM_GetMotorStatus(&speed, NULL_PTR, NULL_PTR) == E_OK)
+        {
+            cpuNs += Bench_CpuSince(cpuStart, overhead);
+            now = Bench_ClockNs(CLOCK_MONOTONIC);
+            if (speed < BENCH_SPEED_RANGE && sentAt[speed] != 0u)
+            {
+                rtt[matched++] = (uint32)(now - sentAt[speed]);
+                sentAt[speed] = 0u;
+            }
+            continue;
+        }
+        (void)sched_yield();
+        now = Bench_ClockNs(CLOCK_MONOTONIC);
+    }
+
+    CanFdHw_GetStatistics(&busEnd);
+    Bench_Result->ecu1CpuNs = cpuNs;
+    Bench_Result->ecu1Frames = sent + matched;
+    Bench_Result->busTimeNs = busEnd.busTimeNs - busStart.busTimeNs;
+    Bench_Result->sent = sent;
+    Bench_Result->matched = matched;
+    if (matched > 0u)
+    {
+        qsort(rtt, matched, sizeof(uint32), Bench_CompareU32);
+        Bench_Result->rttP50Ns = rtt[matched / 2u];
+        Bench_Result->rttP99Ns = rtt[(matched * 99u) / 100u];
+        Bench_Result->rttMaxNs = rtt[matched - 1u];
+    }
+}
+
+static void Bench_RunRate(uint32 rate)
+{
+    int ready[2];
+    int go[2];
+    char token = 0;
+    pid_t ecu1;
+    pid_t ecu2;
+
+    CanFdHw_ShmUnlink(BENCH_SHM_NAME);
+    (void)memset(Bench_Result, 0, sizeof(*Bench_Result));
+    if (pipe(ready) != 0 || pipe(go) != 0)
+    {
+        return;
+    }
+
+    ecu2 = fork();
+    if (ecu2 == 0)
+    {
+        Bench_JoinBus();
+        (void)write(ready[1], &token, 1);
+        (void)read(go[0], &token, 1);
+        Bench_Ecu2Node();
+        CanFdHw_ShmClose();
+        _exit(0);
+    }
+    ecu1 = fork();
+    if (ecu1 == 0)
+    {
+        Bench_JoinBus();
+        (void)write(ready[1], &token, 1);
+        (void)read(go[0], &token, 1);
+        Bench_Ecu1Node(rate);
+        CanFdHw_ShmClose();
+        _exit(0);
+    }
+
+    (void)read(ready[0], &token, 1);
+    (void)read(ready[0], &token, 1);
+    (void)write(go[1], &token, 1);
+    (void)write(go[1], &token, 1);
+
+    (void)waitpid(ecu1, NULL, 0);
+    atomic_store(&Bench_Result->stop, 1u);
+    (void)waitpid(ecu2, NULL, 0);
+
+    printf("%6u %7u %7u %6.2f %6.1f %9.1f %9.1f %9.1f %9.0f %9.0f\n",
+           (unsigned)rate, (unsigned)Bench_Result->sent, (unsigned)Bench_Result->matched,
+           (Bench_Result->sent > 0u) ?
+               100.0 * (double)(Bench_Result->sent - Bench_Result->matched) / Bench_Result->sent : 0.0,
+           100.0 * (double)Bench_Result->busTimeNs / (BENCH_WINDOW_NS + BENCH_DRAIN_NS),
+           Bench_Result->rttP50Ns / 1000.0, Bench_Result->rttP99Ns / 1000.0,
+           Bench_Result->rttMaxNs / 1000.0,
+           (Bench_Result->ecu1Frames > 0u) ? (double)Bench_Result->ecu1CpuNs / Bench_Result->ecu1Frames : 0.0,
+           (Bench_Result->ecu2Frames > 0u) ? (double)Bench_Result->ecu2CpuNs / Bench_Result->ecu2Frames : 0.0);
+    fflush(stdout);
+
+    (void)close(ready[0]);
+    (void)close(ready[1]);
+    (void)close(go[0]);
+    (void)close(go[1]);
+    CanFdHw_ShmUnlink(BENCH_SHM_NAME);
+}
+
+int main(void)
+{
+    Bench_Result = mmap(NULL_PTR, sizeof(*Bench_Result), PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    printf("ECU1/ECU2 co-simulation, paced %u/%u bit/s, %u ms per rate\n",
+           (unsigned)CANFDHW_NOMINAL_BAUDRATE, (unsigned)CANFDHW_DATA_BAUDRATE,
+           (unsigned)(BENCH_WINDOW_NS / 1000000u));
+    printf("%6s %7s %7s %6s %6s %9s %9s %9s %9s %9s\n", "cmd/s", "sent", "status", "loss%",
+           "load%", "rtt50 us", "rtt99 us", "rttmax us", "ECU1 ns/f", "ECU2 ns/f");
+    for (uint32 i = 0; i < sizeof(Bench_Rates) / sizeof(Bench_Rates[0]); i++)
+    {
+        Bench_RunRate(Bench_Rates[i]);
+    }
+    return 0;
+}
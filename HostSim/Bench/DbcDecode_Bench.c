@@ -0,0 +1,281 @@
+/*
+ * DbcDecode_Bench.c - DBC Decoder Throughput Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Writes a candump log and a RecLog log of the same frames:
+ *              the MotorControl.dbc messages every 100 us with frames of
+ *              other IDs in between. Reads each log with read() once from
+ *              disk and once from the page cache, then decodes it with
+ *              Tools/DbcDecode on 1 to N threads, with and without writing
+ *              the columns, and compares the MB/s with the disk read speed.
+ *              Finally checks the decoded columns against the frames sent.
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SimTime.h"
+#include "RecLog.h"
+#include "CanSM.h"
+#include "DbcDecode.h"
+#include "Bench.h"
+
+#define BENCH_FRAMES                 (6000000u)
+#define BENCH_PERIOD_TICKS           (SIMTIME_TICKS_PER_SECOND / 10000u)   /* 100 us */
+#define BENCH_START_SECONDS          (1700000000u)
+
+#define BENCH_DBC_PATH               "BSW/SS/CanSM/MotorControl.dbc"
+#define BENCH_CANDUMP_PATH           "/tmp/dbcdecode_bench.log"
+#define BENCH_RECLOG_PATH            "/tmp/dbcdecode_bench.rlog"
+#define BENCH_OUTPUT_DIR             "/tmp/dbcdecode_bench"
+
+#define BENCH_READ_BUFFER            (1u << 20)
+#define BENCH_WRITE_BUFFER           (1u << 20)
+
+/* Frames of the log, in a cycle of 10: IDs not in the DBC interleaved */
+static const uint32 Bench_Cycle[10] = {
+    CANSM_MOTOR_CMD_ID, CANSM_MOTOR_STATUS_ID, 0x200u, CANSM_MOTOR_CMD_ID, CANSM_MOTOR_STATUS_ID,
+    0x18FF1234u, CANSM_MOTOR_CMD_ID, CANSM_MOTOR_STATUS_ID, 0x7DFu, CANSM_MOTOR_CONFIG_ID
+};
+
+static DbcDecode_DatabaseType Bench_Database;
+static uint8 Bench_Buffer[BENCH_READ_BUFFER];
+
+/* Expected MOTOR_CMD.TARGET_SPEED column */
+static uint64 Bench_CmdRows;
+static double Bench_SpeedSum;
+
+static void Bench_Frame(uint32 n, CanSM_FdFrameType *frame)
+{
+    uint32 id = Bench_Cycle[n % 10u];
+    sint16 speed = (sint16)((n * 7u) % 60001u);
+
+    (void)memset(frame, 0, sizeof(*frame));
+    frame->id = id;
+    frame->brs = TRUE;
+    frame->length = (id == CANSM_MOTOR_CONFIG_ID) ? 12u : 8u;
+    for (uint8 i = 0; i < frame->length; i++)
+    {
+        frame->data[i] = (uint8)((n >> (i % 4u) * 8u) + i);
+    }
+    if (id == CANSM_MOTOR_CMD_ID)
+    {
+        frame->data[0] = (uint8)((uint16)speed & 0xFFu);
+        frame->data[1] = (uint8)((uint16)speed >> 8);
+        frame->data[4] = (uint8)(n & 0x3u);
+        Bench_CmdRows++;
+        Bench_SpeedSum += (double)speed * 0.1;
+    }
+}
+
+/**
+ * @brief   Write both logs; the candump log through a buffer of text lines
+ */
+static void Bench_Generate(void)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    static char text[BENCH_WRITE_BUFFER];
+    CanSM_FdFrameType frame;
+    size_t used = 0u;
+    uint64 micros;
+    FILE *file;
+
+    file = fopen(BENCH_CANDUMP_PATH, "wb");
+    if (file == NULL || RecLog_StartRecording(BENCH_RECLOG_PATH) != E_OK)
+    {
+        printf("cannot create the logs in /tmp\n");
+        exit(1);
+    }
+    SimTime_Init();
+    for (uint32 n = 0; n < BENCH_FRAMES; n++)
+    {
+        Bench_Frame(n, &frame);
+        SimTime_Advance(BENCH_PERIOD_TICKS);
+        (void)RecLog_CanReceive(&frame, E_OK);
+
+        micros = SimTime_Now() / (SIMTIME_TICKS_PER_SECOND / 1000000u);
+        used += (size_t)sprintf(&text[used], "(%u.%06u) can0 ", (unsigned)(BENCH_START_SECONDS + micros / 1000000u),
+                                (unsigned)(micros % 1000000u));
+        used += (size_t)sprintf(&text[used], (frame.id > 0x7FFu) ? "%08X##1" : "%03X##1", (unsigned)frame.id);
+        for (uint8 i = 0; i < frame.length; i++)
+        {
+            text[used++] = hex[frame.data[i] >> 4];
+            text[used++] = hex[frame.data[i] & 0xFu];
+        }
+        text[used++] = '\n';
+        if (used > sizeof(text) - 256u)
+        {
+            (void)fwrite(text, 1u, used, file);
+            used = 0u;
+        }
+    }
+    (void)fwrite(text, 1u, used, file);
+    (void)fclose(file);
+    RecLog_Stop();
+}
+
+/**
+ * @brief   read() speed of a log, in MB/s
+ * @param   cold  Drop the log from the page cache first
+ */
+static double Bench_Read(const char *path, boolean cold)
+{
+    uint64 bytes = 0u;
+    uint64 start;
+    ssize_t n;
+    int file = open(path, O_RDONLY);
+
+    if (file < 0)
+    {
+        return 0.0;
+    }
+    if (cold == TRUE)
+    {
+        (void)fdatasync(file);
+        (void)posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+    }
+    start = Bench_NowNs();
+    while ((n = read(file, Bench_Buffer, sizeof(Bench_Buffer))) > 0)
+    {
+        bytes += (uint64)n;
+    }
+    start = Bench_NowNs() - start;
+    (void)close(file);
+    return (double)bytes * 1e3 / (double)start;
+}
+
+static void Bench_Evict(const char *path)
+{
+    int file = open(path, O_RDONLY);
+
+    if (file >= 0)
+    {
+        (void)posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+        (void)close(file);
+    }
+}
+
+static void Bench_Decode(const char *path, unsigned int threads, boolean columns, boolean cold, double readMBs)
+{
+    DbcDecode_StatisticsType stats;
+    char error[512];
+    char row[48];
+    double mbs;
+
+    if (cold == TRUE)
+    {
+        Bench_Evict(path);
+    }
+    if (DbcDecode_File(&Bench_Database, path, (columns == TRUE) ? BENCH_OUTPUT_DIR : NULL, threads, &stats, error,
+                       sizeof(error)) != 0)
+    {
+        printf("  DbcDecode: %s\n", error);
+        return;
+    }
+    mbs = (double)stats.bytes / stats.seconds / 1e6;
+    (void)snprintf(row, sizeof(row), "%u thread%s, %s%s", threads, (threads == 1u) ? "" : "s",
+                   (columns == TRUE) ? "columns" : "no output", (cold == TRUE) ? ", cold" : "");
+    printf("  %-32s %9.0f %12.2f %9.2f\n", row, mbs, (double)stats.frames / stats.seconds / 1e6, mbs / readMBs);
+}
+
+/**
+ * @brief   Compare the written MOTOR_CMD columns with the frames sent
+ */
+static void Bench_Check(const char *name)
+{
+    double value;
+    double sum = 0.0;
+    uint64 rows = 0u;
+    FILE *file = fopen(BENCH_OUTPUT_DIR "/MOTOR_CMD.TARGET_SPEED.f64", "rb");
+
+    while (file != NULL && fread(&value, sizeof(value), 1u, file) == 1u)
+    {
+        sum += value;
+        rows++;
+    }
+    if (file != NULL)
+    {
+        (void)fclose(file);
+    }
+    printf("  %s: %llu of %llu MOTOR_CMD rows, TARGET_SPEED sum %.1f of %.1f: %s\n", name,
+           (unsigned long long)rows, (unsigned long long)Bench_CmdRows, sum, Bench_SpeedSum,
+           (rows == Bench_CmdRows && sum == Bench_SpeedSum) ? "match" : "MISMATCH");
+}
+
+static void Bench_RemoveColumns(void)
+{
+    char path[256];
+
+    for (unsigned int m = 0; m < Bench_Database.messageCount; m++)
+    {
+        const DbcDecode_MessageType *message = &Bench_Database.messages[m];
+
+        (void)snprintf(path, sizeof(path), "%s/%s.time.f64", BENCH_OUTPUT_DIR, message->name);
+        (void)unlink(path);
+        for (unsigned int s = 0; s < message->signalCount; s++)
+        {
+            (void)snprintf(path, sizeof(path), "%s/%s.%s.f64", BENCH_OUTPUT_DIR, message->name,
+                           message->signals[s].name);
+            (void)unlink(path);
+        }
+    }
+    (void)unlink(BENCH_OUTPUT_DIR "/columns.txt");
+    (void)rmdir(BENCH_OUTPUT_DIR);
+}
+
+static void Bench_Log(const char *name, const char *path)
+{
+    static const unsigned int threads[] = {1u, 2u, 4u};
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    double cold = Bench_Read(path, TRUE);
+    double cached = Bench_Read(path, FALSE);
+
+    printf("%s log\n", name);
+    printf("  %-32s %9.0f\n", "read(), from disk", cold);
+    printf("  %-32s %9.0f\n", "read(), from the page cache", cached);
+    printf("  %-32s %9s %12s %9s\n", "decode", "MB/s", "Mframes/s", "x disk");
+    for (unsigned int t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+    {
+        Bench_Decode(path, threads[t], FALSE, FALSE, cold);
+    }
+    if (online > 4)
+    {
+        Bench_Decode(path, (unsigned int)online, FALSE, FALSE, cold);
+    }
+    Bench_Decode(path, 1u, TRUE, FALSE, cold);
+    Bench_Decode(path, (online > 1) ? (unsigned int)online : 2u, TRUE, TRUE, cold);
+}
+
+int main(void)
+{
+    char error[512];
+    uint64 start;
+
+    if (DbcDecode_Load(BENCH_DBC_PATH, &Bench_Database, error, sizeof(error)) != 0)
+    {
+        printf("DbcDecode: %s (run from the repository root)\n", error);
+        return 1;
+    }
+
+    start = Bench_NowNs();
+    Bench_Generate();
+    printf("%u frames, %llu MOTOR_CMD, written in %.1f s\n", (unsigned)BENCH_FRAMES,
+           (unsigned long long)Bench_CmdRows, (double)(Bench_NowNs() - start) * 1e-9);
+    (void)mkdir(BENCH_OUTPUT_DIR, 0755);
+
+    Bench_Log("candump", BENCH_CANDUMP_PATH);
+    Bench_Check("candump");
+    Bench_Log("RecLog", BENCH_RECLOG_PATH);
+    Bench_Check("RecLog");
+
+    (void)unlink(BENCH_CANDUMP_PATH);
+    (void)unlink(BENCH_RECLOG_PATH);
+    Bench_RemoveColumns();
+    return 0;
+}
@@ -0,0 +1,445 @@
+/*
+ * E2E_Bench.c - E2E Protection Cost and Detection Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Checks the CRC library against the standard check values
+ *              and measures its configured kernels against bit-by-bit and
+ *              single-table references. Then measures the cost of
+ *              E2E_Protect and E2E_Check per motor PDU and sets it against
+ *              the frame rate of a fully loaded bus, and finally sends a
+ *              stream of MOTOR_CMD through a channel that flips bits, loses,
+ *              repeats and reorders frames, and reports the check results
+ *              and whether any damaged frame was accepted.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Det.h"
+#include "Crc.h"
+#include "E2E.h"
+#include "CanSM.h"
+#include "CanFdHw.h"
+#include "Bench.h"
+
+#define BENCH_ITERATIONS             (1u << 22)
+#define BENCH_BYTES                  (1u << 26)
+#define BENCH_STREAM_FRAMES          (1000000u)
+
+/* Channel faults per 10000 frames */
+#define BENCH_FLIP_RATE              (100u)
+#define BENCH_LOSS_RATE              (100u)
+#define BENCH_REPEAT_RATE            (50u)
+#define BENCH_SWAP_RATE              (20u)
+#define BENCH_BURST_RATE             (5u)     /* 6 frames lost in a row */
+
+static const uint32 Bench_Lengths[] = {8u, 12u, 64u, 1024u};
+
+static uint8 Bench_Buffer[1024];
+static volatile uint32 Bench_Sink;
+
+/* Reference kernels: bit by bit, and one table lookup per byte for CRC32 */
+static uint32 Bench_Crc8Bitwise(const uint8 *data, uint32 length)
+{
+    uint8 crc = CRC_INITIAL_VALUE8;
+
+    for (uint32 i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (uint32 bit = 0; bit < 8u; bit++)
+        {
+            crc = ((crc & 0x80u) != 0u) ? (uint8)((crc << 1) ^ CRC_8_POLYNOMIAL) : (uint8)(crc << 1);
+        }
+    }
+    return (uint8)(crc ^ CRC_XOR_VALUE8);
+}
+
+static uint32 Bench_Crc8H2FBitwise(const uint8 *data, uint32 length)
+{
+    uint8 crc = CRC_INITIAL_VALUE8H2F;
+
+    for (uint32 i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (uint32 bit = 0; bit < 8u; bit++)
+        {
+            crc = ((crc & 0x80u) != 0u) ? (uint8)((crc << 1) ^ CRC_8H2F_POLYNOMIAL) : (uint8)(crc << 1);
+        }
+    }
+    return (uint8)(crc ^ CRC_XOR_VALUE8H2F);
+}
+
+static uint32 Bench_Crc16Bitwise(const uint8 *data, uint32 length)
+{
+    uint16 crc = CRC_INITIAL_VALUE16;
+
+    for (uint32 i = 0; i < length; i++)
+    {
+        crc ^= (uint16)((uint16)data[i] << 8);
+        for (uint32 bit = 0; bit < 8u; bit++)
+        {
+            crc = ((crc & 0x8000u) != 0u) ? (uint16)((crc << 1) ^ CRC_16_POLYNOMIAL) : (uint16)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint32 Bench_Crc32Bitwise(const uint8 *data, uint32 length)
+{
+    uint32 crc = CRC_INITIAL_VALUE32;
+
+    for (uint32 i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (uint32 bit = 0; bit < 8u; bit++)
+        {
+            crc = ((crc & 1u) != 0u) ? ((crc >> 1) ^ CRC_32_POLYNOMIAL_REFLECTED) : (crc >> 1);
+        }
+    }
+    return crc ^ CRC_XOR_VALUE32;
+}
+
+static uint32 Bench_Crc32Table(const uint8 *data, uint32 length)
+{
+    uint32 crc = CRC_INITIAL_VALUE32;
+
+    for (uint32 i = 0; i < length; i++)
+    {
+        crc = (crc >> 8) ^ Crc_Table32[0][(crc ^ data[i]) & 0xFFu];
+    }
+    return crc ^ CRC_XOR_VALUE32;
+}
+
+static uint32 Bench_Crc8(const uint8 *data, uint32 length)
+{
+    return Crc_CalculateCRC8(data, length, 0u, TRUE);
+}
+
+static uint32 Bench_Crc8H2F(const uint8 *data, uint32 length)
+{
+    return Crc_CalculateCRC8H2F(data, length, 0u, TRUE);
+}
+
+static uint32 Bench_Crc16(const uint8 *data, uint32 length)
+{
+    return Crc_CalculateCRC16(data, length, 0u, TRUE);
+}
+
+static uint32 Bench_Crc32(const uint8 *data, uint32 length)
+{
+    return Crc_CalculateCRC32(data, length, 0u, TRUE);
+}
+
+typedef uint32 (*Bench_KernelType)(const uint8 *data, uint32 length);
+
+typedef struct {
+    const char *name;
+    Bench_KernelType kernel;
+    Bench_KernelType reference;
+    uint32 check;
+} Bench_KernelEntryType;
+
+static const Bench_KernelEntryType Bench_Kernels[] = {
+    {"CRC8 bitwise", Bench_Crc8Bitwise, Bench_Crc8Bitwise, 0x4Bu},
+    {"CRC8 Crc (table)", Bench_Crc8, Bench_Crc8Bitwise, 0x4Bu},
+    {"CRC8H2F Crc (table)", Bench_Crc8H2F, Bench_Crc8H2FBitwise, 0xDFu},
+    {"CRC16 bitwise", Bench_Crc16Bitwise, Bench_Crc16Bitwise, 0x29B1u},
+    {"CRC16 Crc (table)", Bench_Crc16, Bench_Crc16Bitwise, 0x29B1u},
+    {"CRC32 bitwise", Bench_Crc32Bitwise, Bench_Crc32Bitwise, 0xCBF43926u},
+    {"CRC32 table", Bench_Crc32Table, Bench_Crc32Bitwise, 0xCBF43926u},
+    {"CRC32 Crc (slice-by-4)", Bench_Crc32, Bench_Crc32Bitwise, 0xCBF43926u}
+};
+
+static boolean Bench_Verify(const Bench_KernelEntryType *entry)
+{
+    static const uint8 check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    uint32 chained;
+
+    if (entry->kernel(check, sizeof(check)) != entry->check)
+    {
+        return FALSE;
+    }
+
+    /* Every length and alignment against the reference */
+    for (uint32 offset = 0; offset < 4u; offset++)
+    {
+        for (uint32 length = 0; length <= 64u; length++)
+        {
+            if (entry->kernel(&Bench_Buffer[offset], length) !=
+                entry->reference(&Bench_Buffer[offset], length))
+            {
+                return FALSE;
+            }
+        }
+    }
+
+    /* Chained calls give the CRC of the whole buffer */
+    if (entry->kernel == Bench_Crc8)
+    {
+        chained = Crc_CalculateCRC8(&Bench_Buffer[5], 64u, Crc_CalculateCRC8(Bench_Buffer, 5u, 0u, TRUE), FALSE);
+    }
+    else if (entry->kernel == Bench_Crc8H2F)
+    {
+        chained = Crc_CalculateCRC8H2F(&Bench_Buffer[5], 64u, Crc_CalculateCRC8H2F(Bench_Buffer, 5u, 0u, TRUE),
+                                       FALSE);
+    }
+    else if (entry->kernel == Bench_Crc16)
+    {
+        chained = Crc_CalculateCRC16(&Bench_Buffer[5], 64u, Crc_CalculateCRC16(Bench_Buffer, 5u, 0u, TRUE), FALSE);
+    }
+    else if (entry->kernel == Bench_Crc32)
+    {
+        chained = Crc_CalculateCRC32(&Bench_Buffer[5], 64u, Crc_CalculateCRC32(Bench_Buffer, 5u, 0u, TRUE), FALSE);
+    }
+    else
+    {
+        return TRUE;
+    }
+    return (chained == entry->kernel(Bench_Buffer, 69u)) ? TRUE : FALSE;
+}
+
+static void Bench_CrcKernels(void)
+{
+    uint64 start;
+    uint32 rounds;
+
+    printf("CRC kernels, ns per call\n");
+    printf("  %-24s %6s", "kernel", "check");
+    for (uint32 l = 0; l < sizeof(Bench_Lengths) / sizeof(Bench_Lengths[0]); l++)
+    {
+        printf(" %7u B", (unsigned)Bench_Lengths[l]);
+    }
+    printf(" %9s\n", "MB/s");
+
+    for (uint32 k = 0; k < sizeof(Bench_Kernels) / sizeof(Bench_Kernels[0]); k++)
+    {
+        printf("  %-24s %6s", Bench_Kernels[k].name, (Bench_Verify(&Bench_Kernels[k]) == TRUE) ? "ok" : "FAIL");
+        for (uint32 l = 0; l < sizeof(Bench_Lengths) / sizeof(Bench_Lengths[0]); l++)
+        {
+            rounds = BENCH_BYTES / Bench_Lengths[l] / 16u;
+            start = Bench_NowNs();
+            for (uint32 n = 0; n < rounds; n++)
+            {
+                Bench_Buffer[0] = (uint8)n;
+                Bench_Sink += Bench_Kernels[k].kernel(Bench_Buffer, Bench_Lengths[l]);
+            }
+            printf(" %9.1f", (double)(Bench_NowNs() - start) / rounds);
+            if (l + 1u == sizeof(Bench_Lengths) / sizeof(Bench_Lengths[0]))
+            {
+                printf(" %9.0f\n", (double)rounds * Bench_Lengths[l] * 1000.0 / (double)(Bench_NowNs() - start));
+            }
+        }
+    }
+}
+
+static const char *const Bench_CrcNames[] = {"CRC8", "CRC8H2F", "CRC16", "CRC32"};
+
+static void Bench_PduCost(uint8 pdu, const char *name)
+{
+    CanSM_FdFrameType frame;
+    uint64 protectNs;
+    uint64 checkNs;
+    uint64 start;
+    uint32 accepted = 0u;
+    double framesPerSecond;
+
+    (void)memset(&frame, 0, sizeof(frame));
+    frame.length = E2E_PduConfig[pdu].dataLength;
+    frame.brs = TRUE;
+
+    start = Bench_NowNs();
+    for (uint32 n = 0; n < BENCH_ITERATIONS; n++)
+    {
+        frame.data[0] = (uint8)n;
+        (void)E2E_Protect(pdu, frame.data, frame.length);
+    }
+    protectNs = Bench_NowNs() - start;
+
+    /* Protect outside the timed part: every check sees a fresh frame */
+    checkNs = 0u;
+    for (uint32 n = 0; n < BENCH_ITERATIONS; n += 1024u)
+    {
+        static uint8 frames[1024][12];
+        for (uint32 i = 0; i < 1024u; i++)
+        {
+            frame.data[0] = (uint8)i;
+            (void)E2E_Protect(pdu, frame.data, frame.length);
+            (void)memcpy(frames[i], frame.data, frame.length);
+        }
+        start = Bench_NowNs();
+        for (uint32 i = 0; i < 1024u; i++)
+        {
+            if (E2E_Check(pdu, frames[i], frame.length) == E2E_P_OK)
+            {
+                accepted++;
+            }
+        }
+        checkNs += Bench_NowNs() - start;
+    }
+
+    /* Back-to-back frames of this PDU on the 500 kbit/s / 2 Mbit/s bus */
+    framesPerSecond = 1e9 / CanFdHw_FrameDurationNs(&frame, CANFDHW_NOMINAL_BAUDRATE, CANFDHW_DATA_BAUDRATE);
+    printf("  %-14s %4u %8s %11.1f %11.1f %10.0f %12.4f %9s\n", name, (unsigned)frame.length,
+           Bench_CrcNames[E2E_PduConfig[pdu].crcType],
+           (double)protectNs / BENCH_ITERATIONS, (double)checkNs / BENCH_ITERATIONS, framesPerSecond,
+           framesPerSecond * ((double)(protectNs + checkNs) / BENCH_ITERATIONS) / 1e7,
+           (accepted == BENCH_ITERATIONS) ? "all OK" : "MISSED");
+}
+
+/* Frames as they leave the sender, with a flag for damage on the way */
+typedef struct {
+    uint8 data[8];
+    boolean damaged;
+} Bench_ChannelFrameType;
+
+static void Bench_Stream(void)
+{
+    static const char *const statusNames[] = {"OK", "OKSOMELOST", "REPEATED", "WRONGSEQUENCE",
+                                              "ERROR", "NONEWDATA"};
+    CanSM_FdFrameType frame;
+    Bench_ChannelFrameType sent;
+    Bench_ChannelFrameType held;
+    Bench_ChannelFrameType out[3];
+    E2E_StatisticsType stats;
+    E2E_PCheckStatusType status;
+    uint32 counts[E2E_P_NONEWDATA + 1u] = {0u};
+    uint32 count;
+    uint32 damaged = 0u;
+    uint32 damagedAccepted = 0u;
+    uint32 validChecks = 0u;
+    uint32 checks = 0u;
+    uint32 burst = 0u;
+    uint32 r;
+    boolean holding = FALSE;
+
+    E2E_Init();
+    srand(7u);
+    (void)memset(&frame, 0, sizeof(frame));
+    frame.length = 8u;
+
+    for (uint32 n = 0; n < BENCH_STREAM_FRAMES; n++)
+    {
+        /* MOTOR_CMD as CanSM_SendMotorCmd packs it */
+        frame.data[0] = (uint8)n;
+        frame.data[1] = (uint8)(n >> 8);
+        frame.data[4] = 1u;
+        (void)E2E_Protect(E2E_PDU_MOTOR_CMD, frame.data, frame.length);
+        (void)memcpy(sent.data, frame.data, 8u);
+        sent.damaged = FALSE;
+
+        /* Channel */
+        count = 0u;
+        r = (uint32)rand() % 10000u;
+        if (burst > 0u)
+        {
+            burst--;
+        }
+        else if (r < BENCH_BURST_RATE)
+        {
+            burst = 5u;
+        }
+        else if (r < BENCH_BURST_RATE + BENCH_LOSS_RATE)
+        {
+            /* Lost */
+        }
+        else if (r < BENCH_BURST_RATE + BENCH_LOSS_RATE + BENCH_FLIP_RATE)
+        {
+            /* 1 to 3 bit flips anywhere in the frame */
+            for (uint32 f = 0; f <= ((uint32)rand() % 3u); f++)
+            {
+                sent.data[(uint32)rand() % 8u] ^= (uint8)(1u << ((uint32)rand() % 8u));
+            }
+            sent.damaged = (memcmp(sent.data, frame.data, 8u) != 0) ? TRUE : FALSE;
+            out[count++] = sent;
+        }
+        else if (r < BENCH_BURST_RATE + BENCH_LOSS_RATE + BENCH_FLIP_RATE + BENCH_REPEAT_RATE)
+        {
+            out[count++] = sent;
+            out[count++] = sent;
+        }
+        else if (r < BENCH_BURST_RATE + BENCH_LOSS_RATE + BENCH_FLIP_RATE + BENCH_REPEAT_RATE +
+                     BENCH_SWAP_RATE && holding == FALSE)
+        {
+            /* Overtaken by the next frame */
+            held = sent;
+            holding = TRUE;
+        }
+        else
+        {
+            out[count++] = sent;
+            if (holding == TRUE)
+            {
+                out[count++] = held;
+                holding = FALSE;
+            }
+        }
+
+        /* Receiver: one check per 10 ms cycle and frame, NONEWDATA if none */
+        if (count == 0u)
+        {
+            status = E2E_Check(E2E_PDU_MOTOR_CMD, NULL_PTR, 0u);
+            counts[status]++;
+            checks++;
+        }
+        for (uint32 i = 0; i < count; i++)
+        {
+            status = E2E_Check(E2E_PDU_MOTOR_CMD, out[i].data, 8u);
+            counts[status]++;
+            checks++;
+            if (out[i].damaged == TRUE)
+            {
+                damaged++;
+                if ((status == E2E_P_OK || status == E2E_P_OKSOMELOST) &&
+                    E2E_GetState(E2E_PDU_MOTOR_CMD) == E2E_SM_VALID)
+                {
+                    damagedAccepted++;
+                }
+            }
+            if (E2E_GetState(E2E_PDU_MOTOR_CMD) == E2E_SM_VALID)
+            {
+                validChecks++;
+            }
+        }
+    }
+
+    (void)E2E_GetStatistics(E2E_PDU_MOTOR_CMD, &stats);
+    printf("MOTOR_CMD stream, %u frames, per 10000: %u flipped, %u lost, %u repeated, %u overtaken, "
+           "%u bursts of 6 lost\n", (unsigned)BENCH_STREAM_FRAMES, (unsigned)BENCH_FLIP_RATE,
+           (unsigned)BENCH_LOSS_RATE, (unsigned)BENCH_REPEAT_RATE, (unsigned)BENCH_SWAP_RATE,
+           (unsigned)BENCH_BURST_RATE);
+    for (uint32 s = 0; s <= E2E_P_NONEWDATA; s++)
+    {
+        printf("  %-14s %8u\n", statusNames[s], (unsigned)counts[s]);
+    }
+    printf("  damaged frames %u, accepted %u; VALID after %.2f %% of the frames; %u times INVALID\n",
+           (unsigned)damaged, (unsigned)damagedAccepted, 100.0 * validChecks / (double)checks,
+           (unsigned)stats.invalidTransitions);
+}
+
+int main(void)
+{
+    Det_Init();
+    E2E_Init();
+
+    srand(1u);
+    for (uint32 i = 0; i < sizeof(Bench_Buffer); i++)
+    {
+        Bench_Buffer[i] = (uint8)rand();
+    }
+
+    Bench_CrcKernels();
+
+    printf("E2E per PDU, ns per call; CPU share of protect + check at full bus load\n");
+    printf("  %-14s %4s %8s %11s %11s %10s %12s %9s\n", "PDU", "len", "CRC", "protect", "check",
+           "frames/s", "CPU %", "result");
+    Bench_PduCost(E2E_PDU_MOTOR_CMD, "MOTOR_CMD");
+    Bench_PduCost(E2E_PDU_MOTOR_STATUS, "MOTOR_STATUS");
+    Bench_PduCost(E2E_PDU_MOTOR_CONFIG, "MOTOR_CONFIG");
+
+    Bench_Stream();
+
+    return 0;
+}
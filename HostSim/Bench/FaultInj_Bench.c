@@ -0,0 +1,435 @@
+/*
+ * FaultInj_Bench.c - Fault Injection Reaction Time Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Runs the reaction paths of the motor control demo on the
+ *              simulated timeline while FaultInj injects faults, and
+ *              reports the distribution of the reaction times per fault
+ *              class, first for each class alone, then for all classes
+ *              together at the nominal and at five times the nominal rate.
+ *
+ *              Reactions measured:
+ *              - ADC over-range, group 0 (phase current) or group 1 (DC link
+ *                voltage, after the oversampling filter): from the sample to
+ *                the PWM outputs off, through the check in the group
+ *                notification, the background loop woken from Idle_Wait and
+ *                App_HandleErrors. The motor restarts 2 ms later.
+ *              - CAN transmit failure and bus-off: from the refused frame to
+ *                the next frame accepted, with MOTOR_CMD sent every 10 ms
+ *                from a software timer. Bus-off lasts 128 x 11 bit times.
+ *              - Delayed system tick: from the nominal tick to the end of its
+ *                SwTmr_MainFunction.
+ *              - Control step overrun: from the start of the overrunning
+ *                step to the end of the first step sampled after it.
+ *
+ *              CPU model: the control step (group 0 notification) preempts
+ *              the tick and the background loop; the tick preempts the
+ *              background loop. A control step requested while the previous
+ *              one still runs is lost.
+ */
+
+#include <stdio.h>
+
+#include "Det.h"
+#include "AdcIf.h"
+#include "AdcIf_Cfg.h"
+#include "PwmIf.h"
+#include "PwmIf_Cfg.h"
+#include "AdcHw.h"
+#include "PwmHw.h"
+#include "SimTime.h"
+#include "SwTmr.h"
+#include "CanSM.h"
+#include "CanFdHw.h"
+#include "FaultInj.h"
+
+#define BENCH_US                     (SIMTIME_TICKS_PER_SECOND / 1000000u)
+#define BENCH_MS                     (1000u * BENCH_US)
+#define BENCH_RUN_TICKS              ((uint64)20000u * BENCH_MS)
+
+/* Converter timing: 1 us per channel, 200 ns interrupt entry */
+#define BENCH_CHANNEL_TICKS          (100u)
+#define BENCH_ISR_TICKS              (20u)
+
+/* CPU time of the interrupt handlers and the background loop */
+#define BENCH_CONTROL_TICKS          (15u * BENCH_US)
+#define BENCH_TICK_ISR_TICKS         (2u * BENCH_US)
+#define BENCH_BACKGROUND_TICKS       (5u * BENCH_US)    /* Wake-up to App_HandleErrors */
+
+/* Reset and start after an error stop */
+#define BENCH_RESTART_TICKS          (2u * BENCH_MS)
+
+/* MOTOR_CMD period */
+#define BENCH_CAN_PERIOD_MS          (10u)
+
+/* 12-bit readings */
+#define BENCH_FULL_SCALE             (0x0FFFu)
+#define BENCH_CURRENT_NOMINAL        (2048u)
+#define BENCH_VOLTAGE_NOMINAL        (2400u)
+#define BENCH_TEMPERATURE_NOMINAL    (1500u)
+#define BENCH_OVER_CURRENT           (3800u)
+#define BENCH_OVER_VOLTAGE           (3800u)
+
+/* Load levels of the combined runs */
+#define BENCH_HEAVY_FACTOR           (5u)
+
+#define TICKS_TO_US(t)               ((double)(t) / BENCH_US)
+
+typedef enum {
+    BENCH_STATE_IDLE,
+    BENCH_STATE_RUNNING,
+    BENCH_STATE_ERROR
+} Bench_StateType;
+
+/* Nominal schedule per class: first, mean interval, jitter, duration */
+static const FaultInj_ConfigType Bench_Nominal[FAULTINJ_CLASSES] = {
+    /* ADC group 0 over-range: one sample */
+    {10u * BENCH_MS, 40u * BENCH_MS, 15u * BENCH_MS, 1u},
+    /* ADC group 1 over-range: held for 20 ms, the filter spans 10 ms */
+    {15u * BENCH_MS, 200u * BENCH_MS, 50u * BENCH_MS, 20u * BENCH_MS},
+    /* CAN transmit failure */
+    {20u * BENCH_MS, 50u * BENCH_MS, 20u * BENCH_MS, 0u},
+    /* Bus-off, 128 x 11 bits at 500 kbit/s */
+    {25u * BENCH_MS, 300u * BENCH_MS, 100u * BENCH_MS, 2816u * BENCH_US},
+    /* System tick 200 us late */
+    {5u * BENCH_MS, 10u * BENCH_MS, 4u * BENCH_MS, 200u * BENCH_US},
+    /* Control step 60 us longer, past the 50 us period */
+    {7u * BENCH_MS, 10u * BENCH_MS, 4u * BENCH_MS, 60u * BENCH_US}
+};
+
+static const char *const Bench_ClassNames[FAULTINJ_CLASSES] = {
+    "ADC over-range grp 0", "ADC over-range grp 1", "CAN transmit failure",
+    "CAN bus-off", "GPT tick delay", "ISR overrun"
+};
+
+static Bench_StateType Bench_State;
+static uint32 Bench_IsrActive;
+static uint64 Bench_IsrEnd;
+static boolean Bench_ControlActive;
+static uint64 Bench_OverrangeUntil[ADCIF_MAX_GROUPS];
+static uint64 Bench_OverrunEnd;
+static uint64 Bench_BusOffUntil;
+static uint64 Bench_TickNominal;
+static uint32 Bench_LostSteps;
+static uint32 Bench_ErrorStops;
+static SwTmr_TimerType Bench_CanTimer;
+
+/* Forward declarations */
+static void Bench_TickEvent(uint32 arg);
+static void Bench_BackgroundEvent(uint32 arg);
+static void Bench_RestartEvent(uint32 arg);
+
+/* Hold an event back while an interrupt handler runs */
+static boolean Bench_Deferred(SimTime_EventCallbackType event)
+{
+    if (Bench_IsrActive > 0u)
+    {
+        (void)SimTime_Schedule(Bench_IsrEnd + 1u, event, 0u);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static AdcIf_ValueType Bench_Source(uint8 group, uint8 index, uint64 sampleTick)
+{
+    FaultInj_ClassType faultClass = (group == ADCIF_GROUP_0) ? FAULTINJ_ADC_OVERRANGE_0 :
+                                                               FAULTINJ_ADC_OVERRANGE_1;
+
+    /* Phase U and the DC link voltage are the channels hit */
+    if (index == 0u)
+    {
+        if (sampleTick >= Bench_OverrangeUntil[group] && FaultInj_Fire(faultClass, sampleTick) == TRUE)
+        {
+            Bench_OverrangeUntil[group] = sampleTick + FaultInj_GetMagnitude(faultClass);
+        }
+        if (sampleTick < Bench_OverrangeUntil[group])
+        {
+            return BENCH_FULL_SCALE;
+        }
+    }
+
+    if (group == ADCIF_GROUP_0)
+    {
+        return (AdcIf_ValueType)(BENCH_CURRENT_NOMINAL + ((sampleTick >> 6) & 0x7Fu));
+    }
+    return (index == 0u) ? BENCH_VOLTAGE_NOMINAL : BENCH_TEMPERATURE_NOMINAL;
+}
+
+/* Fault flagged by an interrupt: wake the background loop */
+static void Bench_SetError(void)
+{
+    if (Bench_State != BENCH_STATE_ERROR)
+    {
+        Bench_State = BENCH_STATE_ERROR;
+        (void)SimTime_Schedule(SimTime_Now(), Bench_BackgroundEvent, 0u);
+    }
+}
+
+/* Adc_GroupNotification_0 */
+static void Bench_ControlIsr(void)
+{
+    AdcIf_ValueType currents[ADCIF_GROUP0_CHANNELS];
+    uint64 start = SimTime_Now();
+    uint64 exec = BENCH_CONTROL_TICKS;
+    boolean recovered = FALSE;
+
+    if (Bench_ControlActive == TRUE)
+    {
+        Bench_LostSteps++;
+        return;
+    }
+
+    if (FaultInj_Fire(FAULTINJ_ISR_OVERRUN, start) == TRUE)
+    {
+        exec += FaultInj_GetMagnitude(FAULTINJ_ISR_OVERRUN);
+        Bench_OverrunEnd = start + exec;
+    }
+    else if (FaultInj_IsOpen(FAULTINJ_ISR_OVERRUN) == TRUE &&
+             AdcHw_SimGetSampleTick(ADCIF_GROUP_0) >= Bench_OverrunEnd)
+    {
+        recovered = TRUE;
+    }
+
+    Bench_ControlActive = TRUE;
+    Bench_IsrActive++;
+    Bench_IsrEnd = start + exec;
+
+    (void)AdcIf_ReadGroup(ADCIF_GROUP_0, currents);
+    for (uint8 i = 0; i < ADCIF_GROUP0_CHANNELS; i++)
+    {
+        if (currents[i] > BENCH_OVER_CURRENT)
+        {
+            Bench_SetError();
+            break;
+        }
+    }
+
+    /* Control algorithm; higher priority hardware events keep running */
+    SimTime_Advance(exec);
+    if (Bench_State == BENCH_STATE_RUNNING)
+    {
+        PwmIf_SetPhaseDutyCycles(3000u, 3000u, 3000u);
+    }
+
+    Bench_IsrActive--;
+    Bench_ControlActive = FALSE;
+    if (recovered == TRUE)
+    {
+        FaultInj_Reacted(FAULTINJ_ISR_OVERRUN, SimTime_Now());
+    }
+}
+
+/* Adc_GroupNotification_1 */
+static void Bench_MeasurementIsr(void)
+{
+    AdcIf_ValueType values[ADCIF_GROUP1_CHANNELS];
+
+    (void)AdcIf_ReadGroup(ADCIF_GROUP_1, values);
+    if (values[0] > BENCH_OVER_VOLTAGE)
+    {
+        Bench_SetError();
+    }
+}
+
+/* App_MainFunction finds APP_STATE_ERROR and runs App_HandleErrors */
+static void Bench_BackgroundEvent(uint32 arg)
+{
+    uint64 now;
+
+    (void)arg;
+    if (Bench_Deferred(Bench_BackgroundEvent) == TRUE)
+    {
+        return;
+    }
+
+    /* Interrupts preempt the background loop on its way */
+    SimTime_Advance(BENCH_BACKGROUND_TICKS);
+    PwmIf_StopPhases();
+    AdcIf_DisableGroupTrigger();
+    Bench_ErrorStops++;
+
+    now = SimTime_Now();
+    FaultInj_Reacted(FAULTINJ_ADC_OVERRANGE_0, now);
+    FaultInj_Reacted(FAULTINJ_ADC_OVERRANGE_1, now);
+    (void)SimTime_Schedule(now + BENCH_RESTART_TICKS, Bench_RestartEvent, 0u);
+}
+
+/* Reset and start button */
+static void Bench_RestartEvent(uint32 arg)
+{
+    (void)arg;
+    if (Bench_Deferred(Bench_RestartEvent) == TRUE)
+    {
+        return;
+    }
+
+    Bench_State = BENCH_STATE_RUNNING;
+    AdcIf_EnableGroupTrigger();
+}
+
+static boolean Bench_TxFault(const CanSM_FdGatherType *frame)
+{
+    uint64 now = SimTime_Now();
+
+    (void)frame;
+    if (now < Bench_BusOffUntil)
+    {
+        return TRUE;
+    }
+    if (FaultInj_Fire(FAULTINJ_CAN_BUS_OFF, now) == TRUE)
+    {
+        Bench_BusOffUntil = now + FaultInj_GetMagnitude(FAULTINJ_CAN_BUS_OFF);
+        return TRUE;
+    }
+    return FaultInj_Fire(FAULTINJ_CAN_TX_FAIL, now);
+}
+
+static void Bench_CanTx(uint32 arg)
+{
+    (void)arg;
+    CanSM_SendMotorCmd(1500u, 0, 1u);
+}
+
+static void Bench_ScheduleTick(void)
+{
+    uint64 delay = 0u;
+
+    Bench_TickNominal += BENCH_MS;
+    if (FaultInj_Fire(FAULTINJ_GPT_TICK_DELAY, Bench_TickNominal) == TRUE)
+    {
+        delay = FaultInj_GetMagnitude(FAULTINJ_GPT_TICK_DELAY);
+    }
+    (void)SimTime_Schedule(Bench_TickNominal + delay, Bench_TickEvent, 0u);
+}
+
+/* Gpt_Notification_0 */
+static void Bench_TickEvent(uint32 arg)
+{
+    CanSM_FdFrameType frame;
+    CanFdHw_StatisticsType before;
+    CanFdHw_StatisticsType after;
+
+    (void)arg;
+    if (Bench_Deferred(Bench_TickEvent) == TRUE)
+    {
+        return;
+    }
+
+    Bench_IsrActive++;
+    Bench_IsrEnd = SimTime_Now() + BENCH_TICK_ISR_TICKS;
+
+    CanFdHw_GetStatistics(&before);
+    SwTmr_MainFunction();
+    CanFdHw_GetStatistics(&after);
+    if (after.txFrames != before.txFrames)
+    {
+        FaultInj_Reacted(FAULTINJ_CAN_TX_FAIL, SimTime_Now());
+        FaultInj_Reacted(FAULTINJ_CAN_BUS_OFF, SimTime_Now());
+    }
+
+    /* Keep the loopback queue empty, as the receiving node would */
+    while (CanSM_ReceiveFdFrame(&frame) == E_OK)
+    {
+    }
+
+    SimTime_Advance(BENCH_TICK_ISR_TICKS);
+    Bench_IsrActive--;
+
+    FaultInj_Reacted(FAULTINJ_GPT_TICK_DELAY, SimTime_Now());
+    Bench_ScheduleTick();
+}
+
+static void Bench_Run(const char *load, uint32 classMask, uint32 rateFactor)
+{
+    FaultInj_ConfigType config;
+    FaultInj_ResultType result;
+
+    SimTime_Init();
+    PwmHw_SimInit(PWMIF_PERIOD_TICKS);
+    AdcHw_SimInit(BENCH_CHANNEL_TICKS, BENCH_ISR_TICKS);
+    AdcHw_SimSetGroupChannels(ADCIF_GROUP_0, ADCIF_GROUP0_CHANNELS);
+    AdcHw_SimSetGroupChannels(ADCIF_GROUP_1, ADCIF_GROUP1_CHANNELS);
+    AdcHw_SimSetSource(Bench_Source);
+    PwmHw_SimSetTriggerCallback(AdcHw_SimHardwareTrigger);
+    PwmIf_Init();
+    AdcIf_Init();
+    AdcIf_RegisterGroupNotification(ADCIF_GROUP_0, Bench_ControlIsr);
+    AdcIf_RegisterGroupNotification(ADCIF_GROUP_1, Bench_MeasurementIsr);
+
+    FaultInj_Init(0x2545F491u);
+    for (uint32 c = 0; c < FAULTINJ_CLASSES; c++)
+    {
+        if ((classMask & (1u << c)) != 0u)
+        {
+            config = Bench_Nominal[c];
+            config.meanInterval /= rateFactor;
+            config.jitter /= rateFactor;
+            FaultInj_Configure((FaultInj_ClassType)c, &config);
+        }
+    }
+
+    Bench_OverrangeUntil[ADCIF_GROUP_0] = 0u;
+    Bench_OverrangeUntil[ADCIF_GROUP_1] = 0u;
+
+    Bench_IsrActive = 0u;
+    Bench_ControlActive = FALSE;
+    Bench_OverrunEnd = 0u;
+    Bench_BusOffUntil = 0u;
+    Bench_TickNominal = 0u;
+    Bench_LostSteps = 0u;
+    Bench_ErrorStops = 0u;
+    (void)SwTmr_Start(&Bench_CanTimer, BENCH_CAN_PERIOD_MS / SWTMR_TICK_MS,
+                      BENCH_CAN_PERIOD_MS / SWTMR_TICK_MS);
+    Bench_ScheduleTick();
+
+    /* Start button */
+    Bench_State = BENCH_STATE_RUNNING;
+    AdcIf_EnableGroupTrigger();
+
+    SimTime_Advance(BENCH_RUN_TICKS);
+
+    for (uint32 c = 0; c < FAULTINJ_CLASSES; c++)
+    {
+        if ((classMask & (1u << c)) == 0u)
+        {
+            continue;
+        }
+        FaultInj_GetResult((FaultInj_ClassType)c, &result);
+        printf("  %-10s %-22s %8u %8u %6u %9.1f %9.1f %9.1f %9.1f\n", load, Bench_ClassNames[c],
+               (unsigned)result.injected, (unsigned)result.measured, (unsigned)result.merged,
+               TICKS_TO_US(result.p50), TICKS_TO_US(result.p90), TICKS_TO_US(result.p99),
+               TICKS_TO_US(result.max));
+    }
+    if ((classMask & (classMask - 1u)) != 0u)
+    {
+        printf("  %-10s error stops %u, lost control steps %u, ADC overruns %u\n", load,
+               (unsigned)Bench_ErrorStops, (unsigned)Bench_LostSteps, (unsigned)AdcHw_SimGetOverruns());
+    }
+}
+
+int main(void)
+{
+    char name[16];
+
+    Det_Init();
+    SwTmr_Init();
+    SwTmr_Setup(&Bench_CanTimer, Bench_CanTx, 0u);
+    CanSM_Init();
+    CanSM_SetState(CANSM_READY);
+    CanFdHw_LoopbackSetTxFault(Bench_TxFault);
+
+    printf("Fault reaction times [us], %.0f s simulated per run\n", (double)BENCH_RUN_TICKS / SIMTIME_TICKS_PER_SECOND);
+    printf("  %-10s %-22s %8s %8s %6s %9s %9s %9s %9s\n", "load", "fault class", "injected",
+           "measured", "merged", "p50", "p90", "p99", "max");
+    for (uint32 c = 0; c < FAULTINJ_CLASSES; c++)
+    {
+        Bench_Run("alone", 1u << c, 1u);
+    }
+    Bench_Run("all", (1u << FAULTINJ_CLASSES) - 1u, 1u);
+    (void)snprintf(name, sizeof(name), "all x%u", (unsigned)BENCH_HEAVY_FACTOR);
+    Bench_Run(name, (1u << FAULTINJ_CLASSES) - 1u, BENCH_HEAVY_FACTOR);
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+/*
+ * Idle_Bench.c - Event-Driven Idle Host CPU and Load Accounting Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Runs the background loop of the motor control demo against
+ *              a real-time paced interrupt thread, once spinning as the
+ *              demo used to and once sleeping in Idle_Wait, each with the
+ *              application idle and running. Every simulated second takes
+ *              one second of wall time, so the host CPU time consumed per
+ *              simulated second shows what the loop costs, next to the CPU
+ *              load Idle reports.
+ *
+ *              The interrupt thread stands in for the TC377 interrupts:
+ *              every 1 ms it runs the system tick and, while the motor
+ *              runs, the 20 control steps of that millisecond, each with a
+ *              fixed amount of busy work, held off while the background
+ *              loop has interrupts disabled. It then signals IdleHw as the
+ *              interrupt request would wake the core.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "Det.h"
+#include "Tm.h"
+#include "Idle.h"
+#include "IdleHw.h"
+#include "Bench.h"
+
+#define BENCH_PHASE_MS               (2000u)
+#define BENCH_CONTROL_STEPS_PER_MS   (20u)
+#define BENCH_CONTROL_WORK           (400u)
+
+/* Application event posted when the application state changes */
+#define BENCH_EVENT_STATE            (0x00000002u)
+
+typedef enum {
+    BENCH_LOOP_SPIN,
+    BENCH_LOOP_IDLE
+} Bench_LoopType;
+
+typedef struct {
+    const char *name;
+    Bench_LoopType loop;
+    boolean running;
+} Bench_PhaseType;
+
+static const Bench_PhaseType Bench_Phases[] = {
+    {"busy loop, motor idle", BENCH_LOOP_SPIN, FALSE},
+    {"Idle_Wait, motor idle", BENCH_LOOP_IDLE, FALSE},
+    {"busy loop, motor running", BENCH_LOOP_SPIN, TRUE},
+    {"Idle_Wait, motor running", BENCH_LOOP_IDLE, TRUE}
+};
+
+static volatile boolean Bench_Stop;
+static volatile boolean Bench_Running;
+static Bench_LoopType Bench_Loop;
+static volatile uint32 Bench_Sink;
+static uint32 Bench_LoopCount;
+static uint32 Bench_LoadSum;
+static uint32 Bench_LoadWindows;
+static uint64 Bench_BackgroundCpuNs;
+
+/* STM model: wall time at 100 MHz */
+uint32 TmHw_GetCounter(void)
+{
+    return (uint32)(Bench_ClockNs(CLOCK_MONOTONIC) / (1000000000u / TM_TICKS_PER_SECOND));
+}
+
+/* Stand-in for one current control step */
+static void Bench_ControlStep(void)
+{
+    uint32 acc = Bench_Sink;
+
+    Idle_IsrEnter();
+    for (uint32 i = 0; i < BENCH_CONTROL_WORK; i++)
+    {
+        acc = acc * 1664525u + 1013904223u;
+    }
+    Bench_Sink = acc;
+}
+
+static void Bench_Tick(void)
+{
+    Idle_IsrEnter();
+    Tm_MainFunction();
+    Idle_MainFunction();
+}
+
+static void *Bench_InterruptThread(void *arg)
+{
+    struct timespec next;
+    uint32 ms = 0u;
+
+    (void)arg;
+    (void)clock_gettime(CLOCK_MONOTONIC, &next);
+    while (Bench_Stop == FALSE)
+    {
+        next.tv_nsec += 1000000;
+        if (next.tv_nsec >= 1000000000)
+        {
+            next.tv_nsec -= 1000000000;
+            next.tv_sec++;
+        }
+        (void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL_PTR);
+
+        IdleHw_SimIsrEnter();
+        Bench_Tick();
+        if (Bench_Running == TRUE)
+        {
+            for (uint32 s = 0; s < BENCH_CONTROL_STEPS_PER_MS; s++)
+            {
+                Bench_ControlStep();
+            }
+        }
+        IdleHw_SimIsrExit();
+        IdleHw_SimInterrupt();
+
+        /* Average the load windows after the first one */
+        ms++;
+        if ((ms % IDLE_LOAD_WINDOW_MS) == 0u && ms > IDLE_LOAD_WINDOW_MS)
+        {
+            Bench_LoadSum += Idle_GetCpuLoad();
+            Bench_LoadWindows++;
+        }
+    }
+    return NULL_PTR;
+}
+
+/* The demo's background work: state machine and button polling */
+static void Bench_MainFunction(void)
+{
+    Bench_LoopCount++;
+    Bench_Sink = Bench_LoopCount;
+}
+
+static void *Bench_BackgroundThread(void *arg)
+{
+    uint64 start = Bench_ClockNs(CLOCK_THREAD_CPUTIME_ID);
+
+    (void)arg;
+    while (Bench_Stop == FALSE)
+    {
+        Bench_MainFunction();
+        if (Bench_Loop == BENCH_LOOP_IDLE)
+        {
+            (void)Idle_Wait();
+        }
+    }
+    Bench_BackgroundCpuNs = Bench_ClockNs(CLOCK_THREAD_CPUTIME_ID) - start;
+    return NULL_PTR;
+}
+
+static void Bench_RunPhase(const Bench_PhaseType *phase)
+{
+    pthread_t interrupt;
+    pthread_t background;
+    struct timespec duration = {BENCH_PHASE_MS / 1000u, (BENCH_PHASE_MS % 1000u) * 1000000};
+    uint64 processStart = Bench_ClockNs(CLOCK_PROCESS_CPUTIME_ID);
+    uint64 wallStart = Bench_ClockNs(CLOCK_MONOTONIC);
+    uint32 wakeups = IdleHw_SimGetWakeups();
+    double seconds;
+
+    Bench_Stop = FALSE;
+    Bench_Running = phase->running;
+    Bench_Loop = phase->loop;
+    Bench_LoopCount = 0u;
+    Bench_LoadSum = 0u;
+    Bench_LoadWindows = 0u;
+
+    (void)pthread_create(&interrupt, NULL_PTR, Bench_InterruptThread, NULL_PTR);
+    (void)pthread_create(&background, NULL_PTR, Bench_BackgroundThread, NULL_PTR);
+    (void)nanosleep(&duration, NULL_PTR);
+    Bench_Stop = TRUE;
+    (void)pthread_join(interrupt, NULL_PTR);
+
+    /* Release a background loop still waiting */
+    Idle_SetEvent(BENCH_EVENT_STATE);
+    IdleHw_SimInterrupt();
+    (void)pthread_join(background, NULL_PTR);
+
+    seconds = (double)(Bench_ClockNs(CLOCK_MONOTONIC) - wallStart) / 1e9;
+    printf("  %-26s %10.1f %10.1f %10.1f %9.1f %12.0f\n", phase->name,
+           (double)Bench_BackgroundCpuNs / 1e6 / seconds,
+           (double)(Bench_ClockNs(CLOCK_PROCESS_CPUTIME_ID) - processStart) / 1e6 / seconds,
+           (Bench_LoadWindows > 0u) ? (double)Bench_LoadSum / Bench_LoadWindows / 10.0 : 0.0,
+           (double)(IdleHw_SimGetWakeups() - wakeups) / seconds,
+           (double)Bench_LoopCount / seconds);
+    (void)fflush(stdout);
+}
+
+int main(void)
+{
+    Det_Init();
+    Tm_Init();
+    Idle_Init();
+
+    printf("Host CPU per simulated second (%u ms per phase, real-time paced)\n", (unsigned)BENCH_PHASE_MS);
+    printf("  %-26s %10s %10s %10s %9s %12s\n", "background loop", "bg [ms/s]", "all [ms/s]",
+           "load [%]", "wakes/s", "loops/s");
+    for (uint32 p = 0; p < sizeof(Bench_Phases) / sizeof(Bench_Phases[0]); p++)
+    {
+        Bench_RunPhase(&Bench_Phases[p]);
+    }
+
+    return 0;
+}
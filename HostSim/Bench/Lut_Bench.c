@@ -0,0 +1,199 @@
+/*
+ * Lut_Bench.c - Lookup Table Accuracy and Cost versus libm
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Compares Lut_Sin, Lut_Cos, Lut_Atan2 and the sensor curves
+ *              of the ADC group 1 channels with the double precision
+ *              libm equivalents: worst-case and RMS error over the full
+ *              input range, and host time per call. Cycles are counted with
+ *              the x86 time stamp counter where available. The table sizes
+ *              and interpolation orders are those of Lut_Cfg.h; rebuild
+ *              after changing them to compare configurations.
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "Det.h"
+#include "Lut.h"
+#include "Bench.h"
+
+#define BENCH_PI                     (3.14159265358979323846)
+#define BENCH_INPUTS                 (4096u)     /* power of two */
+#define BENCH_CALLS                  (1u << 23)
+
+/* Accumulated error of one function */
+typedef struct {
+    double maxError;
+    double sumSquares;
+    uint32 count;
+} Bench_ErrorType;
+
+/* Inputs for the timing loops, random so branches and table accesses do not repeat */
+static uint16 Bench_Angles[BENCH_INPUTS];
+static sint32 Bench_PointsX[BENCH_INPUTS];
+static sint32 Bench_PointsY[BENCH_INPUTS];
+static uint16 Bench_Raw[BENCH_INPUTS];
+
+/* Results are summed here so the calls are not optimized away */
+static volatile double Bench_SinkDouble;
+static volatile sint32 Bench_SinkInt;
+
+static uint32 Bench_Random(void)
+{
+    static uint32 state = 0x12345678u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static void Bench_AddError(Bench_ErrorType *e, double error)
+{
+    if (fabs(error) > e->maxError)
+    {
+        e->maxError = fabs(error);
+    }
+    e->sumSquares += error * error;
+    e->count++;
+}
+
+static void Bench_PrintError(const char *name, const Bench_ErrorType *e, const char *unit, double scale)
+{
+    printf("  %-22s max %8.4f %-6s rms %8.4f %-6s (%u points)\n", name, e->maxError * scale, unit,
+           sqrt(e->sumSquares / (double)e->count) * scale, unit, (unsigned)e->count);
+}
+
+/* Wrap an angle error in 1/65536 turn to [-32768, 32768) */
+static double Bench_WrapAngle(double error)
+{
+    return error - 65536.0 * floor((error + 32768.0) / 65536.0);
+}
+
+/* NTC temperature in degC for a raw ADC value, beta model of Lut_Cfg.h */
+static double Bench_NtcExact(double raw)
+{
+    double ratio = raw / (double)(1u << LUT_ADC_BITS);
+    double r = LUT_NTC_PULLUP * ratio / (1.0 - ratio);
+    return 1.0 / (1.0 / 298.15 + log(r / LUT_NTC_R25) / LUT_NTC_BETA) - 273.15;
+}
+
+static void Bench_Accuracy(void)
+{
+    Bench_ErrorType sinErr = {0.0, 0.0, 0u};
+    Bench_ErrorType cosErr = {0.0, 0.0, 0u};
+    Bench_ErrorType atanErr = {0.0, 0.0, 0u};
+    Bench_ErrorType atanSmallErr = {0.0, 0.0, 0u};
+    Bench_ErrorType vdcErr = {0.0, 0.0, 0u};
+    Bench_ErrorType ntcErr = {0.0, 0.0, 0u};
+    double a;
+    double t;
+    sint32 x;
+    sint32 y;
+
+    for (uint32 i = 0; i < 65536u; i++)
+    {
+        a = 2.0 * BENCH_PI * (double)i / 65536.0;
+        Bench_AddError(&sinErr, Lut_Sin((uint16)i) - sin(a) * 32768.0);
+        Bench_AddError(&cosErr, Lut_Cos((uint16)i) - cos(a) * 32768.0);
+    }
+
+    /* Full-scale Q15 vectors and small vectors, where the ratio quantization dominates */
+    for (uint32 i = 0; i < 65536u; i++)
+    {
+        a = 2.0 * BENCH_PI * ((double)i + 0.5) / 65536.0;
+        x = (sint32)lround(cos(a) * 32767.0);
+        y = (sint32)lround(sin(a) * 32767.0);
+        Bench_AddError(&atanErr, Bench_WrapAngle(Lut_Atan2(y, x) - atan2((double)y, (double)x) *
+                                                 65536.0 / (2.0 * BENCH_PI)));
+        x = (sint32)lround(cos(a) * 100.0);
+        y = (sint32)lround(sin(a) * 100.0);
+        Bench_AddError(&atanSmallErr, Bench_WrapAngle(Lut_Atan2(y, x) - atan2((double)y, (double)x) *
+                                                      65536.0 / (2.0 * BENCH_PI)));
+    }
+
+    for (uint32 raw = 0; raw < (1u << LUT_ADC_BITS); raw++)
+    {
+        Bench_AddError(&vdcErr, Lut_Linearize(LUT_CURVE_DC_LINK, (uint16)raw) / 10.0 -
+                                (double)raw * LUT_VDC_FULL_SCALE / (double)(1u << LUT_ADC_BITS));
+        if (raw > 0u)
+        {
+            t = Bench_NtcExact((double)raw);
+            if (t >= LUT_NTC_T_MIN && t <= LUT_NTC_T_MAX)
+            {
+                Bench_AddError(&ntcErr, Lut_Linearize(LUT_CURVE_NTC, (uint16)raw) / 10.0 - t);
+            }
+        }
+    }
+
+    printf("Accuracy against libm (double):\n");
+    Bench_PrintError("Lut_Sin", &sinErr, "LSB", 1.0);
+    Bench_PrintError("Lut_Cos", &cosErr, "LSB", 1.0);
+    Bench_PrintError("Lut_Atan2 |v| = 32767", &atanErr, "deg", 360.0 / 65536.0);
+    Bench_PrintError("Lut_Atan2 |v| = 100", &atanSmallErr, "deg", 360.0 / 65536.0);
+    Bench_PrintError("DC link curve", &vdcErr, "V", 1.0);
+    Bench_PrintError("NTC curve", &ntcErr, "degC", 1.0);
+}
+
+#define BENCH_TIME(name, type, sink, expr)                                  \
+    do {                                                                    \
+        type acc = 0;                                                       \
+        uint64 startNs = Bench_NowNs();                                     \
+        uint64 startCycles = Bench_Cycles();                                \
+        for (uint32 n = 0; n < BENCH_CALLS; n++)                            \
+        {                                                                   \
+            uint32 i = n & (BENCH_INPUTS - 1u);                             \
+            acc += (expr);                                                  \
+        }                                                                   \
+        uint64 cycles = Bench_Cycles() - startCycles;                       \
+        Bench_PrintCost(name, 22, Bench_NowNs() - startNs, cycles,          \
+                        BENCH_CALLS, "call");                               \
+        sink = acc;                                                         \
+    } while (0)
+
+static void Bench_Cost(void)
+{
+    for (uint32 i = 0; i < BENCH_INPUTS; i++)
+    {
+        Bench_Angles[i] = (uint16)Bench_Random();
+        Bench_PointsX[i] = (sint32)(Bench_Random() % 65535u) - 32767;
+        Bench_PointsY[i] = (sint32)(Bench_Random() % 65535u) - 32767;
+        Bench_Raw[i] = (uint16)(1u + Bench_Random() % ((1u << LUT_ADC_BITS) - 1u));
+    }
+
+    printf("Cost per call (%u calls each):\n", (unsigned)BENCH_CALLS);
+    BENCH_TIME("Lut_Sin", sint32, Bench_SinkInt, Lut_Sin(Bench_Angles[i]));
+    BENCH_TIME("libm sin", double, Bench_SinkDouble,
+               sin((double)Bench_Angles[i] * (2.0 * BENCH_PI / 65536.0)));
+    BENCH_TIME("libm sinf", double, Bench_SinkDouble,
+               sinf((float)Bench_Angles[i] * (float)(2.0 * BENCH_PI / 65536.0)));
+    BENCH_TIME("Lut_Sin + Lut_Cos", sint32, Bench_SinkInt,
+               Lut_Sin(Bench_Angles[i]) + Lut_Cos(Bench_Angles[i]));
+    BENCH_TIME("libm sin + cos", double, Bench_SinkDouble,
+               sin((double)Bench_Angles[i] * (2.0 * BENCH_PI / 65536.0)) +
+               cos((double)Bench_Angles[i] * (2.0 * BENCH_PI / 65536.0)));
+    BENCH_TIME("Lut_Atan2", sint32, Bench_SinkInt, Lut_Atan2(Bench_PointsY[i], Bench_PointsX[i]));
+    BENCH_TIME("libm atan2", double, Bench_SinkDouble,
+               atan2((double)Bench_PointsY[i], (double)Bench_PointsX[i]));
+    BENCH_TIME("libm atan2f", double, Bench_SinkDouble,
+               atan2f((float)Bench_PointsY[i], (float)Bench_PointsX[i]));
+    BENCH_TIME("Lut_Linearize NTC", sint32, Bench_SinkInt, Lut_Linearize(LUT_CURVE_NTC, Bench_Raw[i]));
+    BENCH_TIME("beta model with log()", double, Bench_SinkDouble, Bench_NtcExact((double)Bench_Raw[i]));
+}
+
+int main(void)
+{
+    Det_Init();
+
+    printf("Lookup tables: sin %u intervals order %u, atan %u intervals order %u, "
+           "curves %u intervals order %u\n",
+           (unsigned)LUT_SIN_SIZE, (unsigned)LUT_SIN_ORDER, (unsigned)LUT_ATAN_SIZE,
+           (unsigned)LUT_ATAN_ORDER, (unsigned)LUT_CURVE_SIZE, (unsigned)LUT_CURVE_ORDER);
+    printf("ROM: %u bytes\n", (unsigned)(sizeof(Lut_SinTable) + sizeof(Lut_AtanTable) +
+                                         sizeof(Lut_CurveTable)));
+    Bench_Accuracy();
+    Bench_Cost();
+    return 0;
+}
@@ -0,0 +1,186 @@
+/*
+ * ModeReq_Bench.c - Mode Request Pipeline Cost and Latency Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Drives the BswM -> ComM -> CanSM mode request pipeline
+ *              on the simulated 1 ms tick. A storm of mode requests, from
+ *              one to thousands per tick, is passed once the way BswM used
+ *              to handle it, each request carried through to CanSM at
+ *              once, and once through the coalescing pipeline, where the
+ *              requests are recorded and the main functions of the next
+ *              tick make one switch of them. Reports the total cost per
+ *              request, requests and ticks together, the cost of one tick
+ *              and the switches made.
+ *
+ *              Then issues single requests at random times within the tick
+ *              and reports the end-to-end latency from the request to the
+ *              completion notification, in simulated time.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Det.h"
+#include "Tm.h"
+#include "SimTime.h"
+#include "SwTmr.h"
+#include "ComM.h"
+#include "CanSM.h"
+#include "BSWM.h"
+#include "Bench.h"
+
+#define BENCH_REQUESTS               (1u << 20)
+#define BENCH_TICK                   (SIMTIME_TICKS_PER_SECOND / 1000u)
+#define BENCH_LATENCY_SAMPLES        (10000u)
+
+static const uint32 Bench_StormSizes[] = {1u, 16u, 256u, 4096u};
+
+static uint32 Bench_Notifications;
+static uint8 Bench_NotifiedMode;
+
+static void Bench_Completed(uint8 mode)
+{
+    Bench_Notifications++;
+    Bench_NotifiedMode = mode;
+}
+
+/* The mode request main functions of one 1 ms tick, in their order */
+static void Bench_Tick(void)
+{
+    BSWM_MainFunction();
+    ComM_MainFunction();
+    CanSM_MainFunction();
+}
+
+static uint32 Bench_Switches(void)
+{
+    ComM_StatisticsType stats;
+
+    (void)ComM_GetStatistics(COMM_CHANNEL_CAN, &stats);
+    return stats.switches;
+}
+
+/* Alternate between the two CAN modes so every request changes the mode */
+static uint8 Bench_Mode(uint32 n)
+{
+    return ((n & 1u) != 0u) ? BSWM_MODE_SILENT : BSWM_MODE_NORMAL;
+}
+
+/* Each request carried through at once; the storm size makes no difference */
+static void Bench_AtOnce(void)
+{
+    uint64 start;
+    uint32 switches = Bench_Switches();
+
+    start = Bench_NowNs();
+    for (uint32 n = 0; n < BENCH_REQUESTS; n++)
+    {
+        BSWM_RequestMode(BSWM_REQUEST_SOURCE_COMM, Bench_Mode(n));
+        Bench_Tick();
+    }
+    printf("  %6s %-14s %9.1f %12s %10u\n", "any", "at once",
+           (double)(Bench_NowNs() - start) / BENCH_REQUESTS, "-", (unsigned)(Bench_Switches() - switches));
+}
+
+static void Bench_Storm(uint32 perTick)
+{
+    uint64 requestNs;
+    uint64 tickNs = 0u;
+    uint64 start;
+    uint64 tickStart;
+    uint32 switches;
+    uint32 notifications;
+
+    /* Recorded, one switch per tick; the tick is timed on its own as well */
+    switches = Bench_Switches();
+    notifications = Bench_Notifications;
+    start = Bench_NowNs();
+    for (uint32 n = 0; n < BENCH_REQUESTS; n += perTick)
+    {
+        for (uint32 i = 0; i < perTick; i++)
+        {
+            BSWM_RequestMode(BSWM_REQUEST_SOURCE_COMM, Bench_Mode(n + i));
+        }
+        tickStart = Bench_NowNs();
+        Bench_Tick();
+        tickNs += Bench_NowNs() - tickStart;
+        SimTime_Advance(BENCH_TICK);
+    }
+    requestNs = Bench_NowNs() - start;
+    printf("  %6u %-14s %9.1f %12.1f %10u\n", (unsigned)perTick, "coalesced",
+           (double)requestNs / BENCH_REQUESTS, (double)tickNs / (BENCH_REQUESTS / perTick),
+           (unsigned)(Bench_Switches() - switches));
+
+    if (Bench_NotifiedMode != BSWM_GetCurrentMode() ||
+        BSWM_GetCurrentMode() != Bench_Mode(BENCH_REQUESTS - 1u) ||
+        Bench_Notifications - notifications != BENCH_REQUESTS / perTick)
+    {
+        printf("  mode or notification mismatch\n");
+    }
+}
+
+static void Bench_Latency(void)
+{
+    BSWM_StatisticsType stats;
+    uint64 sum = 0u;
+    uint32 max = 0u;
+    uint32 offset;
+
+    srand(1u);
+    for (uint32 n = 0; n < BENCH_LATENCY_SAMPLES; n++)
+    {
+        /* Request at a random time within the tick, then run to the tick */
+        offset = (uint32)rand() % BENCH_TICK;
+        SimTime_Advance(offset);
+        BSWM_RequestMode(BSWM_REQUEST_SOURCE_DIAG, Bench_Mode(n));
+        SimTime_Advance(BENCH_TICK - offset);
+        Bench_Tick();
+
+        (void)BSWM_GetStatistics(&stats);
+        sum += stats.lastLatency;
+        if (stats.lastLatency > max)
+        {
+            max = stats.lastLatency;
+        }
+    }
+
+    printf("End-to-end latency, request to notification (%u requests at random times)\n",
+           (unsigned)BENCH_LATENCY_SAMPLES);
+    printf("  mean %.1f us, max %.1f us, 1 ms tick\n",
+           (double)sum / BENCH_LATENCY_SAMPLES / (TM_TICKS_PER_SECOND / 1000000u),
+           (double)max / (TM_TICKS_PER_SECOND / 1000000u));
+}
+
+int main(void)
+{
+    BSWM_StatisticsType stats;
+
+    Det_Init();
+    SimTime_Init();
+    Tm_Init();
+    SwTmr_Init();
+    ComM_Init();
+    CanSM_Init();
+    BSWM_Init();
+    BSWM_RegisterModeNotification(BSWM_REQUEST_SOURCE_COMM, Bench_Completed);
+    BSWM_RegisterModeNotification(BSWM_REQUEST_SOURCE_DIAG, Bench_Completed);
+    Bench_Tick();
+
+    printf("Request storms, %u mode requests each\n", (unsigned)BENCH_REQUESTS);
+    printf("  %6s %-14s %9s %12s %10s\n", "/tick", "handling", "ns/req", "ns/tick", "switches");
+    Bench_AtOnce();
+    for (uint32 s = 0; s < sizeof(Bench_StormSizes) / sizeof(Bench_StormSizes[0]); s++)
+    {
+        Bench_Storm(Bench_StormSizes[s]);
+    }
+
+    Bench_Latency();
+
+    (void)BSWM_GetStatistics(&stats);
+    printf("BswM: %u requests, %u coalesced, %u switches\n", (unsigned)stats.requests,
+           (unsigned)stats.coalesced, (unsigned)stats.switches);
+
+    return 0;
+}
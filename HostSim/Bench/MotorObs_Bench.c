@@ -0,0 +1,279 @@
+/*
+ * MotorObs_Bench.c - Sensorless Observer Convergence and Cost Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Closes the loop between MotorObs and the PMSM plant model.
+ *              Each 50 us period the voltage vector for the current set
+ *              point is computed from the true rotor angle, the plant runs
+ *              for one period, the phase currents are sampled at the
+ *              period center through a 12 bit ADC model with noise, and
+ *              MotorObs_Update runs on the result.
+ *
+ *              The observer angle after an update is the prediction for the
+ *              next sample, so it is compared with the plant angle at that
+ *              next sample.
+ *
+ *              Reported per scenario: time to lock, time until the angle
+ *              error stays below BENCH_CONVERGED_DEG, angle and speed error
+ *              after settling, and the angle error of a double-precision
+ *              reference of the same observer. Per-iteration cost is
+ *              measured on recorded inputs.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Det.h"
+#include "MotorObs.h"
+#include "MotorObs_Cfg.h"
+#include "MotorPlant.h"
+#include "Bench.h"
+
+#define BENCH_TWO_PI                 (6.283185307179586)
+#define BENCH_RAD_TO_DEG             (360.0 / BENCH_TWO_PI)
+
+/* Current set point of the feed-forward voltage control [A] */
+#define BENCH_IQ_REF                 (5.0)
+
+/* ADC noise, uniform +/- LSB */
+#define BENCH_ADC_NOISE              (2)
+
+/* Settling time excluded from the error statistics [periods] */
+#define BENCH_SETTLE_PERIODS         (10000u)
+
+/* Angle error bound for convergence [deg] */
+#define BENCH_CONVERGED_DEG          (5.0)
+
+#define BENCH_COST_INPUTS            (4096u)
+#define BENCH_COST_ITERATIONS        (20000000u)
+
+typedef struct {
+    const char *name;
+    double startRpm;
+    double endRpm;
+    double seconds;
+    double rsFactor;     /* Plant parameter deviation from MotorObs_Cfg.h */
+    double lsFactor;
+} Bench_ScenarioType;
+
+static const Bench_ScenarioType Bench_Scenarios[] = {
+    {"1500 rpm", 1500.0, 1500.0, 1.5, 1.0, 1.0},
+    {"4500 rpm", 4500.0, 4500.0, 1.5, 1.0, 1.0},
+    {"ramp 300 -> 4500 rpm in 1.5 s", 300.0, 4500.0, 1.5, 1.0, 1.0},
+    {"1500 rpm, Rs +50 %", 1500.0, 1500.0, 1.5, 1.5, 1.0},
+    {"1500 rpm, Ls +20 %", 1500.0, 1500.0, 1.5, 1.0, 1.2},
+    {"300 rpm", 300.0, 300.0, 1.5, 1.0, 1.0},
+    {"150 rpm", 150.0, 150.0, 1.5, 1.0, 1.0}
+};
+
+/* Double-precision reference of the observer */
+typedef struct {
+    double psiAlpha;
+    double psiBeta;
+    double speedInt;
+    double theta;
+} Bench_RefObsType;
+
+/* Recorded observer inputs for the cost measurement */
+typedef struct {
+    AdcIf_ValueType currents[3];
+    PwmIf_DutyType duty[3];
+} Bench_InputType;
+
+static Bench_InputType Bench_Inputs[BENCH_COST_INPUTS];
+
+static double Bench_WrapAngle(double a)
+{
+    while (a > BENCH_TWO_PI / 2.0)
+    {
+        a -= BENCH_TWO_PI;
+    }
+    while (a < -BENCH_TWO_PI / 2.0)
+    {
+        a += BENCH_TWO_PI;
+    }
+    return a;
+}
+
+static AdcIf_ValueType Bench_AdcSample(double current)
+{
+    sint32 raw = MOTOROBS_ADC_CURRENT_OFFSET +
+                 (sint32)lround(current / MOTOROBS_ADC_CURRENT_FULL_SCALE * 2048.0) +
+                 (rand() % (2 * BENCH_ADC_NOISE + 1)) - BENCH_ADC_NOISE;
+    return (AdcIf_ValueType)((raw < 0) ? 0 : ((raw > 4095) ? 4095 : raw));
+}
+
+static PwmIf_DutyType Bench_Duty(double v, double vdc)
+{
+    double d = (0.5 + v / vdc) * 65536.0;
+    return (PwmIf_DutyType)((d < 0.0) ? 0.0 : ((d > 65535.0) ? 65535.0 : d));
+}
+
+static void Bench_RefUpdate(Bench_RefObsType *obs, const double *i, const double *v)
+{
+    const double ts = MOTOROBS_TS;
+    const double leak = 1.0 / (double)(1u << MOTOROBS_FLUX_LEAK_SHIFT);
+    const double wn = MOTOROBS_PLL_WN;
+    const double psiM = MOTOROBS_PSI_M;
+    double iAlpha = (2.0 * i[0] - i[1] - i[2]) / 3.0;
+    double iBeta = (i[1] - i[2]) / sqrt(3.0);
+    double vAlpha = (2.0 * v[0] - v[1] - v[2]) / 3.0;
+    double vBeta = (v[1] - v[2]) / sqrt(3.0);
+    double err;
+
+    obs->psiAlpha += ts * (vAlpha - MOTOROBS_RS * iAlpha);
+    obs->psiBeta += ts * (vBeta - MOTOROBS_RS * iBeta);
+    obs->psiAlpha -= obs->psiAlpha * leak;
+    obs->psiBeta -= obs->psiBeta * leak;
+    err = ((obs->psiBeta - MOTOROBS_LS * iBeta) * cos(obs->theta) -
+           (obs->psiAlpha - MOTOROBS_LS * iAlpha) * sin(obs->theta)) / psiM;
+    obs->speedInt += wn * wn * ts * err;
+    obs->theta = fmod(obs->theta + ts * (obs->speedInt + 2.0 * MOTOROBS_PLL_ZETA * wn * err) +
+                      BENCH_TWO_PI, BENCH_TWO_PI);
+}
+
+static void Bench_RunScenario(const Bench_ScenarioType *sc)
+{
+    MotorPlant_ParamType params = {
+        MOTORPLANT_RS * sc->rsFactor, MOTORPLANT_LS * sc->lsFactor, MOTORPLANT_PSI_M,
+        MOTORPLANT_POLE_PAIRS, MOTORPLANT_INERTIA, MOTORPLANT_FRICTION
+    };
+    Bench_RefObsType ref = {0.0, 0.0, 0.0, 0.0};
+    uint32 periods = (uint32)(sc->seconds / MOTOROBS_TS);
+    uint32 lockPeriod = 0u;
+    uint32 lastOutside = 0u;
+    uint16 predicted = 0u;
+    double refPredicted = 0.0;
+    uint32 count = 0u;
+    double vdc = MOTOROBS_VDC_NOMINAL;
+    double sumSq = 0.0;
+    double maxErr = 0.0;
+    double refSumSq = 0.0;
+    double speedErrSum = 0.0;
+    double speedErrMax = 0.0;
+    double i[3];
+    double v[3];
+    AdcIf_ValueType adc[3];
+    PwmIf_DutyType duty[3];
+    double theta, omegaE, rpm, vd, vq, vAlpha, vBeta, err, refErr, speedErr;
+
+    srand(1u);
+    MotorPlant_Init(&params);
+    MotorObs_Init();
+    MotorObs_SetDcLinkVoltage((AdcIf_ValueType)lround(vdc / MOTOROBS_ADC_VDC_FULL_SCALE * 4096.0));
+
+    for (uint32 k = 0; k < periods; k++)
+    {
+        rpm = sc->startRpm + (sc->endRpm - sc->startRpm) * (double)k / (double)periods;
+        MotorPlant_SetImposedSpeed(rpm);
+
+        /* Feed-forward voltage for i_d = 0, i_q = BENCH_IQ_REF at the true angle */
+        theta = MotorPlant_GetAngle();
+        omegaE = rpm / 60.0 * BENCH_TWO_PI * MOTOROBS_POLE_PAIRS;
+        vd = -omegaE * MOTOROBS_LS * BENCH_IQ_REF;
+        vq = MOTOROBS_RS * BENCH_IQ_REF + omegaE * MOTOROBS_PSI_M;
+        vAlpha = vd * cos(theta) - vq * sin(theta);
+        vBeta = vd * sin(theta) + vq * cos(theta);
+        duty[0] = Bench_Duty(vAlpha, vdc);
+        duty[1] = Bench_Duty(-0.5 * vAlpha + 0.5 * sqrt(3.0) * vBeta, vdc);
+        duty[2] = Bench_Duty(-0.5 * vAlpha - 0.5 * sqrt(3.0) * vBeta, vdc);
+        for (uint32 n = 0; n < 3u; n++)
+        {
+            v[n] = ((double)duty[n] / 65536.0 - 0.5) * vdc;
+        }
+
+        /* Sample at the period center */
+        MotorPlant_Step(MOTOROBS_TS / 2.0, v[0], v[1], v[2]);
+        MotorPlant_GetCurrents(&i[0], &i[1], &i[2]);
+        for (uint32 n = 0; n < 3u; n++)
+        {
+            adc[n] = Bench_AdcSample(i[n]);
+        }
+
+        /* Error of the previous prediction at this sample */
+        theta = MotorPlant_GetAngle();
+        err = fabs(Bench_WrapAngle((double)predicted / 65536.0 * BENCH_TWO_PI - theta));
+        refErr = Bench_WrapAngle(refPredicted - theta);
+        speedErr = fabs((double)MotorObs_GetMechanicalSpeed() / 10.0 - MotorPlant_GetSpeedRpm());
+        if (err * BENCH_RAD_TO_DEG > BENCH_CONVERGED_DEG)
+        {
+            lastOutside = k + 1u;
+        }
+        if (k >= BENCH_SETTLE_PERIODS)
+        {
+            sumSq += err * err;
+            refSumSq += refErr * refErr;
+            maxErr = (err > maxErr) ? err : maxErr;
+            speedErrSum += speedErr;
+            speedErrMax = (speedErr > speedErrMax) ? speedErr : speedErrMax;
+            count++;
+        }
+
+        MotorObs_Update(adc, duty[0], duty[1], duty[2]);
+        Bench_RefUpdate(&ref, i, v);
+        predicted = MotorObs_GetAngle();
+        refPredicted = ref.theta;
+        MotorPlant_Step(MOTOROBS_TS / 2.0, v[0], v[1], v[2]);
+
+        if (k < BENCH_COST_INPUTS)
+        {
+            for (uint32 n = 0; n < 3u; n++)
+            {
+                Bench_Inputs[k].currents[n] = adc[n];
+                Bench_Inputs[k].duty[n] = duty[n];
+            }
+        }
+
+        if (lockPeriod == 0u && MotorObs_IsLocked() == TRUE)
+        {
+            lockPeriod = k + 1u;
+        }
+    }
+
+    printf("  %-30s %8.1f %8.1f %8.2f %8.2f %8.2f %8.1f %8.1f\n", sc->name,
+           (lockPeriod > 0u) ? lockPeriod * MOTOROBS_TS * 1000.0 : -1.0,
+           lastOutside * MOTOROBS_TS * 1000.0,
+           sqrt(sumSq / count) * BENCH_RAD_TO_DEG, maxErr * BENCH_RAD_TO_DEG,
+           sqrt(refSumSq / count) * BENCH_RAD_TO_DEG, speedErrSum / count, speedErrMax);
+}
+
+static void Bench_Cost(void)
+{
+    const Bench_InputType *in;
+    uint64 start;
+    uint64 elapsed;
+
+    MotorObs_Init();
+    start = Bench_NowNs();
+    for (uint32 k = 0; k < BENCH_COST_ITERATIONS; k++)
+    {
+        in = &Bench_Inputs[k & (BENCH_COST_INPUTS - 1u)];
+        MotorObs_Update(in->currents, in->duty[0], in->duty[1], in->duty[2]);
+    }
+    elapsed = Bench_NowNs() - start;
+
+    printf("Cost: %.2f ns per MotorObs_Update (%u iterations, speed %ld x0.1 rpm)\n",
+           (double)elapsed / BENCH_COST_ITERATIONS, (unsigned)BENCH_COST_ITERATIONS,
+           (long)MotorObs_GetMechanicalSpeed());
+}
+
+int main(void)
+{
+    Det_Init();
+
+    printf("Observer vs plant, %.0f us period, i_q %.1f A, settle %.0f ms excluded\n",
+           MOTOROBS_TS * 1e6, BENCH_IQ_REF, BENCH_SETTLE_PERIODS * MOTOROBS_TS * 1000.0);
+    printf("  %-30s %8s %8s %8s %8s %8s %8s %8s\n", "scenario", "lock ms", "conv ms", "rms deg", "max deg",
+           "ref deg", "avg rpm", "max rpm");
+    for (uint32 s = 0; s < sizeof(Bench_Scenarios) / sizeof(Bench_Scenarios[0]); s++)
+    {
+        Bench_RunScenario(&Bench_Scenarios[s]);
+    }
+
+    /* Cost on the inputs recorded at the start of the last scenario */
+    Bench_Cost();
+    return 0;
+}
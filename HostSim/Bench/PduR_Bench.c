@@ -0,0 +1,326 @@
+/*
+ * PduR_Bench.c - Gateway Throughput and Latency Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Runs the routes of PduR_Cfg.h on the stand-in buses of
+ *              BusHw. First the cost of PduR_RxIndication per source PDU,
+ *              by kind of route, and the PDUs routed per second of host
+ *              time. Then the latency a hop adds, from the indication to
+ *              the transmit request on the destination bus. Finally 10 s of
+ *              simulated traffic on the 1 ms tick: MOTOR_STATUS every 1 ms
+ *              and MOTOR_CMD every 10 ms, with the rate and the data age of
+ *              what arrives on each destination. Before that, the length
+ *              and content of what each PDU route forwards are checked.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Det.h"
+#include "PduR.h"
+#include "BusHw.h"
+
+#define BENCH_INDICATIONS            (1u << 22)
+#define BENCH_BATCH                  (64u)    /* Indications between two drains */
+#define BENCH_LATENCY_SAMPLES        (200000u)
+#define BENCH_SIM_MS                 (10000u)
+
+/* Source PDUs */
+typedef struct {
+    const char *name;
+    uint8 channel;
+    uint16 pduId;
+    uint8 length;
+} Bench_SourceType;
+
+static const Bench_SourceType Bench_Sources[] = {
+    {"CAN 0x66 bytes 0..5",  COMM_CHANNEL_CAN, 102u, 12u},   /* Same layout, zero-copy to ETH */
+    {"ETH 0x410 signal",     COMM_CHANNEL_ETH, 0x0410u, 8u}, /* Composed on FR */
+    {"CAN 0x65 fan-out 3",   COMM_CHANNEL_CAN, 101u, 8u},    /* ETH, FR held, LIN held */
+    {"CAN 0x64 signals",     COMM_CHANNEL_CAN, 100u, 8u},    /* LIN held */
+    {"CAN 0x200 unrouted",   COMM_CHANNEL_CAN, 0x200u, 8u},
+    {"LIN 0x10 unrouted",    COMM_CHANNEL_LIN, 0x10u, 8u}
+};
+
+static uint8 Bench_Data[64];
+static uint64 Bench_Samples[BENCH_LATENCY_SAMPLES];
+
+static void Bench_Drain(void)
+{
+    BusHw_FrameType frame;
+
+    for (uint8 ch = 0; ch < COMM_MAX_CHANNELS; ch++)
+    {
+        while (BusHw_Receive(ch, &frame) == E_OK)
+        {
+        }
+    }
+}
+
+static uint32 Bench_Transmitted(void)
+{
+    BusHw_StatisticsType stats;
+    uint32 frames = 0u;
+
+    for (uint8 ch = 0; ch < COMM_MAX_CHANNELS; ch++)
+    {
+        BusHw_GetStatistics(ch, &stats);
+        frames += stats.txFrames;
+    }
+    return frames;
+}
+
+static int Bench_Compare(const void *a, const void *b)
+{
+    uint64 x = *(const uint64 *)a;
+    uint64 y = *(const uint64 *)b;
+    return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+/* Forwarded length and content of the PDU routes; 0 if all match */
+static uint32 Bench_CheckForwarded(void)
+{
+    /* MOTOR_STATUS whole, MOTOR_CONFIG without E2E counter and CRC */
+    static const struct {
+        const char *name;
+        uint8 srcChannel;
+        uint16 srcId;
+        uint8 srcLength;
+        uint8 dstChannel;
+        uint16 dstId;
+        uint8 dstLength;
+    } checks[] = {
+        {"CAN 0x65 -> ETH 0x401", COMM_CHANNEL_CAN, 101u, 8u, COMM_CHANNEL_ETH, 0x0401u, 8u},
+        {"CAN 0x66 -> ETH 0x402", COMM_CHANNEL_CAN, 102u, 12u, COMM_CHANNEL_ETH, 0x0402u, 6u}
+    };
+    BusHw_FrameType frame;
+    uint32 errors = 0u;
+    uint32 found;
+    uint8 length;
+
+    printf("Forwarded PDUs\n");
+    for (uint32 c = 0; c < sizeof(checks) / sizeof(checks[0]); c++)
+    {
+        PduR_Init();
+        BusHw_Init();
+        for (uint8 i = 0; i < checks[c].srcLength; i++)
+        {
+            Bench_Data[i] = (uint8)(0x10u + i);
+        }
+        PduR_RxIndication(checks[c].srcChannel, checks[c].srcId, Bench_Data, checks[c].srcLength);
+
+        found = 0u;
+        length = 0u;
+        while (BusHw_Receive(checks[c].dstChannel, &frame) == E_OK)
+        {
+            if (frame.pduId == checks[c].dstId)
+            {
+                found++;
+                length = frame.length;
+                errors += (frame.length != checks[c].dstLength ||
+                           memcmp(frame.data, Bench_Data, checks[c].dstLength) != 0) ? 1u : 0u;
+            }
+        }
+        errors += (found != 1u) ? 1u : 0u;
+        printf("  %-22s %u of %u bytes, %s\n", checks[c].name, (unsigned)length,
+               (unsigned)checks[c].srcLength, (found == 1u) ? "sent" : "missing");
+        Bench_Drain();
+    }
+    printf("  %u mismatches\n", (unsigned)errors);
+    memset(Bench_Data, 0x5A, sizeof(Bench_Data));
+    return errors;
+}
+
+static void Bench_Throughput(void)
+{
+    uint64 elapsed;
+    uint64 start;
+    uint32 sent;
+
+    printf("PduR_RxIndication per source PDU, host time\n");
+    printf("  %-22s %9s %12s %12s\n", "source", "ns/PDU", "sent/PDU", "sent/s");
+
+    /* The stand-in bus alone: copy and time stamp of a transmission */
+    BusHw_Init();
+    elapsed = 0u;
+    for (uint32 n = 0; n < BENCH_INDICATIONS; n += BENCH_BATCH)
+    {
+        start = BusHw_NowNs();
+        for (uint32 b = 0; b < BENCH_BATCH; b++)
+        {
+            (void)BusHw_Transmit(COMM_CHANNEL_ETH, 0x0402u, Bench_Data, 12u);
+        }
+        elapsed += BusHw_NowNs() - start;
+        Bench_Drain();
+    }
+    printf("  %-22s %9.1f %12s %12s\n", "BusHw_Transmit alone", (double)elapsed / BENCH_INDICATIONS, "-", "-");
+
+    for (uint32 s = 0; s < sizeof(Bench_Sources) / sizeof(Bench_Sources[0]); s++)
+    {
+        const Bench_SourceType *source = &Bench_Sources[s];
+
+        PduR_Init();
+        BusHw_Init();
+        elapsed = 0u;
+        for (uint32 n = 0; n < BENCH_INDICATIONS; n += BENCH_BATCH)
+        {
+            start = BusHw_NowNs();
+            for (uint32 b = 0; b < BENCH_BATCH; b++)
+            {
+                Bench_Data[0] = (uint8)b;
+                PduR_RxIndication(source->channel, source->pduId, Bench_Data, source->length);
+            }
+            elapsed += BusHw_NowNs() - start;
+
+            /* Held PDUs leave with the tick */
+            PduR_MainFunction();
+            Bench_Drain();
+        }
+        sent = Bench_Transmitted();
+        printf("  %-22s %9.1f %12.3f %12.0f\n", source->name, (double)elapsed / BENCH_INDICATIONS,
+               (double)sent / BENCH_INDICATIONS,
+               (elapsed != 0u) ? (double)sent * 1e9 / (double)elapsed : 0.0);
+    }
+}
+
+static void Bench_HopLatency(const Bench_SourceType *source, uint8 dstChannel, uint64 timerNs)
+{
+    BusHw_FrameType frame;
+    uint32 count = 0u;
+    uint64 start;
+    uint64 sum = 0u;
+
+    PduR_Init();
+    BusHw_Init();
+    while (count < BENCH_LATENCY_SAMPLES)
+    {
+        start = BusHw_NowNs();
+        PduR_RxIndication(source->channel, source->pduId, Bench_Data, source->length);
+        while (BusHw_Receive(dstChannel, &frame) == E_OK)
+        {
+            Bench_Samples[count++] = frame.stampNs - start;
+        }
+        Bench_Drain();
+    }
+
+    qsort(Bench_Samples, count, sizeof(Bench_Samples[0]), Bench_Compare);
+    for (uint32 i = 0; i < count; i++)
+    {
+        sum += Bench_Samples[i];
+    }
+    printf("  %-22s %9.1f %9llu %9llu %9llu\n", source->name, (double)sum / count - (double)timerNs,
+           (unsigned long long)(Bench_Samples[count / 2u] - timerNs),
+           (unsigned long long)(Bench_Samples[(count * 99u) / 100u] - timerNs),
+           (unsigned long long)(Bench_Samples[count - 1u] - timerNs));
+}
+
+static void Bench_Latency(void)
+{
+    uint64 timerNs = ~(uint64)0u;
+    uint64 a;
+    uint64 b;
+
+    /* The stamp of the destination frame is one clock read after the start */
+    for (uint32 i = 0; i < 100000u; i++)
+    {
+        a = BusHw_NowNs();
+        b = BusHw_NowNs();
+        timerNs = (b - a < timerNs) ? (b - a) : timerNs;
+    }
+
+    printf("Latency per hop, indication to transmit request, ns (clock read of %llu ns removed)\n",
+           (unsigned long long)timerNs);
+    printf("  %-22s %9s %9s %9s %9s\n", "route", "mean", "p50", "p99", "max");
+    Bench_HopLatency(&Bench_Sources[0], COMM_CHANNEL_ETH, timerNs);
+    Bench_HopLatency(&Bench_Sources[1], COMM_CHANNEL_FR, timerNs);
+}
+
+static void Bench_RateLimits(void)
+{
+    /* Destinations of MOTOR_STATUS and MOTOR_CMD, and where their data shows */
+    static const struct {
+        const char *name;
+        uint8 channel;
+        uint16 pduId;
+        uint8 stampByte;         /* Byte of the 16-bit source time in the destination */
+    } dests[] = {
+        {"ETH 0x401 PDU",        COMM_CHANNEL_ETH, 0x0401u, 0u},
+        {"FR 0x21 PDU, 10 ms",   COMM_CHANNEL_FR, 0x0021u, 0u},
+        {"LIN 0x21 sig, 50 ms",  COMM_CHANNEL_LIN, 0x0021u, 3u}
+    };
+    uint32 frames[3] = {0u, 0u, 0u};
+    uint32 ageSum[3] = {0u, 0u, 0u};
+    uint32 ageMax[3] = {0u, 0u, 0u};
+    uint8 status[8] = {0u};
+    uint8 cmd[8] = {0u};
+    BusHw_FrameType frame;
+    PduR_StatisticsType stats;
+    uint32 age;
+
+    PduR_Init();
+    BusHw_Init();
+    for (uint32 ms = 0; ms < BENCH_SIM_MS; ms++)
+    {
+        /* The tick comes first, the PDUs of the millisecond after it */
+        PduR_MainFunction();
+
+        /* Source time in ACTUAL_SPEED, bits 0..15 of MOTOR_STATUS */
+        status[0] = (uint8)ms;
+        status[1] = (uint8)(ms >> 8);
+        PduR_RxIndication(COMM_CHANNEL_CAN, 101u, status, sizeof(status));
+        if ((ms % 10u) == 0u)
+        {
+            cmd[0] = (uint8)ms;
+            cmd[1] = (uint8)(ms >> 8);
+            PduR_RxIndication(COMM_CHANNEL_CAN, 100u, cmd, sizeof(cmd));
+        }
+
+        for (uint32 d = 0; d < 3u; d++)
+        {
+            while (BusHw_Receive(dests[d].channel, &frame) == E_OK)
+            {
+                if (frame.pduId != dests[d].pduId)
+                {
+                    continue;
+                }
+                age = (uint16)((uint16)ms - (uint16)(frame.data[dests[d].stampByte] |
+                                                     ((uint16)frame.data[dests[d].stampByte + 1u] << 8)));
+                frames[d]++;
+                ageSum[d] += age;
+                ageMax[d] = (age > ageMax[d]) ? age : ageMax[d];
+            }
+        }
+        Bench_Drain();
+    }
+
+    printf("Rate limits, %u ms simulated: MOTOR_STATUS every 1 ms, MOTOR_CMD every 10 ms\n",
+           (unsigned)BENCH_SIM_MS);
+    printf("  %-22s %9s %12s %12s\n", "destination", "frames/s", "age mean ms", "age max ms");
+    for (uint32 d = 0; d < 3u; d++)
+    {
+        printf("  %-22s %9.1f %12.2f %12u\n", dests[d].name, (double)frames[d] * 1000.0 / BENCH_SIM_MS,
+               (frames[d] != 0u) ? (double)ageSum[d] / frames[d] : 0.0, (unsigned)ageMax[d]);
+    }
+    (void)PduR_GetStatistics(&stats);
+    printf("PduR: %u received, %u zero-copy, %u composed, %u held, %u replaced, %u sent after the interval\n",
+           (unsigned)stats.received, (unsigned)stats.zeroCopy, (unsigned)stats.composed, (unsigned)stats.held,
+           (unsigned)stats.heldReplaced, (unsigned)stats.heldSent);
+}
+
+int main(void)
+{
+    Det_Init();
+    memset(Bench_Data, 0x5A, sizeof(Bench_Data));
+
+    if (Bench_CheckForwarded() != 0u)
+    {
+        return 1;
+    }
+    Bench_Throughput();
+    Bench_Latency();
+    Bench_RateLimits();
+    return 0;
+}
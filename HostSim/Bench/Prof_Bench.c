@@ -0,0 +1,377 @@
+/*
+ * Prof_Bench.c - Function Profile of a Simulated Drive Cycle
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Runs 4 s of a drive cycle on the simulated timeline with
+ *              the BSW and application code instrumented: the observer and
+ *              V/f control step in the group 0 notification of the
+ *              PWM-triggered ADC at 20 kHz, the DC link voltage from group
+ *              1, and a 1 ms tick with the BSWM, ComM, CanSM, SwTmr and
+ *              SetpointGen main functions, MOTOR_CMD from the remote node
+ *              and MOTOR_STATUS every 10 ms, both E2E protected.
+ *
+ *              The cycle runs with profiling stopped, then profiled.
+ *              Reported: the host time of both runs, the calls and the
+ *              calibrated cost of the hooks, the functions and the modules
+ *              by self time, and the folded stacks in /tmp/prof_bench.folded
+ *              for flamegraph.pl.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Det.h"
+#include "AdcIf.h"
+#include "AdcIf_Cfg.h"
+#include "PwmIf.h"
+#include "PwmIf_Cfg.h"
+#include "AdcHw.h"
+#include "PwmHw.h"
+#include "SimTime.h"
+#include "Tm.h"
+#include "SwTmr.h"
+#include "ComM.h"
+#include "BSWM.h"
+#include "CanSM.h"
+#include "CanFdHw.h"
+#include "E2E.h"
+#include "MotorObs.h"
+#include "SetpointGen.h"
+#include "MotorPlant.h"
+#include "Prof.h"
+#include "Bench.h"
+
+#define BENCH_US                     (SIMTIME_TICKS_PER_SECOND / 1000000u)
+#define BENCH_MS                     (1000u * BENCH_US)
+#define BENCH_RUN_MS                 (4000u)
+#define BENCH_FOLDED_PATH            "/tmp/prof_bench.folded"
+#define BENCH_TOP_FUNCTIONS          (15u)
+#define BENCH_MAX_FUNCTIONS          (512u)
+#define BENCH_MAX_MODULES            (32u)
+
+/* Converter timing: 1 us per channel, 200 ns interrupt entry */
+#define BENCH_CHANNEL_TICKS          (100u)
+#define BENCH_ISR_TICKS              (20u)
+
+/* Remote node and status */
+#define BENCH_CMD_PERIOD_MS          (10u)
+#define BENCH_STATUS_PERIOD_MS       (10u)
+
+/* Inverter, current sensing, V/f */
+#define BENCH_VDC                    (24.0)
+#define BENCH_COUNTS_PER_AMP         (50.0)
+#define BENCH_CURRENT_OFFSET         (2048.0)
+#define BENCH_VOLTAGE_COUNTS         (2400u)
+#define BENCH_TEMPERATURE_COUNTS     (1500u)
+#define BENCH_VOLTS_PER_HZ           (0.05)
+#define BENCH_MAX_MODULATION         (0.45)
+
+/* Speed profile of the remote node [rpm] */
+static const struct {
+    uint32 fromMs;
+    uint16 rpm;
+} Bench_Profile[] = {
+    {0u, 0u}, {100u, 1500u}, {1500u, 3000u}, {2500u, 1000u}, {3200u, 2500u}
+};
+
+static uint32 Bench_Compare[3];
+static PwmIf_DutyType Bench_Duty[3];
+static double Bench_Angle;
+static uint32 Bench_TickCount;
+static SwTmr_TimerType Bench_Timer;
+static uint32 Bench_TimerCount;
+
+static AdcIf_ValueType Bench_Source(uint8 group, uint8 index, uint64 sampleTick)
+{
+    double current[3];
+    double counts;
+
+    if (group == ADCIF_GROUP_0 && index < 3u)
+    {
+        MotorPlant_GetCurrents(&current[0], &current[1], &current[2]);
+        counts = BENCH_CURRENT_OFFSET + current[index] * BENCH_COUNTS_PER_AMP;
+        counts = (counts < 0.0) ? 0.0 : ((counts > 4095.0) ? 4095.0 : counts);
+        return (AdcIf_ValueType)counts;
+    }
+    if (index == 0u)
+    {
+        return (AdcIf_ValueType)(BENCH_VOLTAGE_COUNTS + ((sampleTick >> 10) & 0xFu));
+    }
+    return (AdcIf_ValueType)(BENCH_TEMPERATURE_COUNTS + (uint32)(sampleTick / (100u * BENCH_MS)));
+}
+
+static void Bench_PeriodCallback(uint32 periodCount)
+{
+    double v[3];
+
+    (void)periodCount;
+    for (uint8 p = 0; p < 3u; p++)
+    {
+        v[p] = ((double)Bench_Compare[p] / PWMIF_PERIOD_TICKS - 0.5) * BENCH_VDC;
+    }
+    MotorPlant_Step((double)PWMIF_PERIOD_TICKS / SIMTIME_TICKS_PER_SECOND, v[0], v[1], v[2]);
+
+    Bench_Compare[0] = PwmHw_SimGetActiveCompare(PWMIF_HW_CHANNEL_U);
+    Bench_Compare[1] = PwmHw_SimGetActiveCompare(PWMIF_HW_CHANNEL_V);
+    Bench_Compare[2] = PwmHw_SimGetActiveCompare(PWMIF_HW_CHANNEL_W);
+}
+
+/* Adc_GroupNotification_0: observer and V/f step */
+static void Bench_ControlStep(void)
+{
+    AdcIf_ValueType currents[ADCIF_GROUP0_CHANNELS];
+    double frequency;
+    double modulation;
+
+    (void)AdcIf_ReadGroup(ADCIF_GROUP_0, currents);
+    MotorObs_Update(currents, Bench_Duty[0], Bench_Duty[1], Bench_Duty[2]);
+
+    /* SetpointGen speed in 0.1 rpm */
+    frequency = (double)SetpointGen_GetSpeed() / 600.0 * MOTORPLANT_POLE_PAIRS;
+    Bench_Angle = fmod(Bench_Angle + 2.0 * M_PI * frequency * PWMIF_PERIOD_TICKS / SIMTIME_TICKS_PER_SECOND,
+                       2.0 * M_PI);
+    modulation = BENCH_VOLTS_PER_HZ * frequency / BENCH_VDC;
+    modulation = (modulation > BENCH_MAX_MODULATION) ? BENCH_MAX_MODULATION : modulation;
+    for (uint8 p = 0; p < 3u; p++)
+    {
+        Bench_Duty[p] = (PwmIf_DutyType)(32768.0 + 65535.0 * modulation *
+                                         sin(Bench_Angle - (double)p * 2.0 * M_PI / 3.0));
+    }
+    PwmIf_SetPhaseDutyCycles(Bench_Duty[0], Bench_Duty[1], Bench_Duty[2]);
+}
+
+/* Adc_GroupNotification_1: DC link voltage */
+static void Bench_SupervisionStep(void)
+{
+    AdcIf_ValueType values[ADCIF_GROUP1_CHANNELS];
+
+    if (AdcIf_ReadGroup(ADCIF_GROUP_1, values) == E_OK)
+    {
+        MotorObs_SetDcLinkVoltage(values[0]);
+    }
+}
+
+static void Bench_TimerCallback(uint32 arg)
+{
+    (void)arg;
+    Bench_TimerCount++;
+}
+
+/* Gpt_Notification_0 */
+static void Bench_TickEvent(uint32 arg)
+{
+    CanSM_FdFrameType frame;
+    uint32 ms = (uint32)(SimTime_Now() / BENCH_MS);
+    uint16 rpm = 0u;
+
+    (void)arg;
+    BSWM_MainFunction();
+    ComM_MainFunction();
+    CanSM_MainFunction();
+    SwTmr_MainFunction();
+    Tm_MainFunction();
+
+    /* The remote node on the same bus */
+    if ((ms % BENCH_CMD_PERIOD_MS) == 3u)
+    {
+        for (uint32 i = 0; i < sizeof(Bench_Profile) / sizeof(Bench_Profile[0]); i++)
+        {
+            rpm = (ms >= Bench_Profile[i].fromMs) ? Bench_Profile[i].rpm : rpm;
+        }
+        CanSM_SendMotorCmd((uint16)(rpm * 10u), 0, 1u);
+    }
+
+    while (CanSM_ReceiveFdFrame(&frame) == E_OK)
+    {
+        if (frame.id == CANSM_MOTOR_CMD_ID && E2E_Check(E2E_PDU_MOTOR_CMD, frame.data, frame.length) == E2E_P_OK)
+        {
+            (void)SetpointGen_SetTarget((sint16)(frame.data[0] | (frame.data[1] << 8)),
+                                        (sint16)(frame.data[2] | (frame.data[3] << 8)));
+        }
+        else if (frame.id == CANSM_MOTOR_STATUS_ID)
+        {
+            (void)E2E_Check(E2E_PDU_MOTOR_STATUS, frame.data, frame.length);
+        }
+        else
+        {
+            /* Not for this node */
+        }
+    }
+    SetpointGen_MainFunction();
+
+    Bench_TickCount++;
+    if ((Bench_TickCount % BENCH_STATUS_PERIOD_MS) == 0u)
+    {
+        CanSM_SendMotorStatus((uint16)(MotorObs_GetMechanicalSpeed() / 10), 0, 0u);
+    }
+    (void)SimTime_Schedule(SimTime_Now() + BENCH_MS, Bench_TickEvent, 0u);
+}
+
+/**
+ * @brief   Run the drive cycle once
+ * @details The modules initialized once per program keep running from the
+ *          previous run, as they would through a restart of the drive.
+ * @return  Host time [ns]
+ */
+static uint64 Bench_Run(void)
+{
+    uint64 start = Bench_NowNs();
+
+    SimTime_Init();
+    CanSM_Init();
+    E2E_Init();
+    CanFdHw_Init();
+    PwmHw_SimInit(PWMIF_PERIOD_TICKS);
+    AdcHw_SimInit(BENCH_CHANNEL_TICKS, BENCH_ISR_TICKS);
+    AdcHw_SimSetGroupChannels(ADCIF_GROUP_0, ADCIF_GROUP0_CHANNELS);
+    AdcHw_SimSetGroupChannels(ADCIF_GROUP_1, ADCIF_GROUP1_CHANNELS);
+    AdcHw_SimSetSource(Bench_Source);
+    PwmHw_SimSetTriggerCallback(AdcHw_SimHardwareTrigger);
+    PwmHw_SimSetPeriodCallback(Bench_PeriodCallback);
+    PwmIf_Init();
+    AdcIf_Init();
+    AdcIf_RegisterGroupNotification(ADCIF_GROUP_0, Bench_ControlStep);
+    AdcIf_RegisterGroupNotification(ADCIF_GROUP_1, Bench_SupervisionStep);
+    MotorObs_Init();
+    SetpointGen_Init();
+    MotorPlant_Init(NULL_PTR);
+    MotorPlant_SetLoadTorque(0.005);
+
+    Bench_Compare[0] = Bench_Compare[1] = Bench_Compare[2] = PWMIF_PERIOD_TICKS / 2u;
+    Bench_Duty[0] = Bench_Duty[1] = Bench_Duty[2] = 32768u;
+    Bench_Angle = 0.0;
+    Bench_TickCount = 0u;
+    Bench_TimerCount = 0u;
+
+    (void)SimTime_Schedule(BENCH_MS, Bench_TickEvent, 0u);
+    AdcIf_EnableGroupTrigger();
+    SimTime_Advance((uint64)BENCH_RUN_MS * BENCH_MS);
+    return Bench_NowNs() - start;
+}
+
+/* Totals of the functions per module, the name up to the first '_' */
+static void Bench_PrintModules(const Prof_FunctionType *functions, uint32 count, uint64 cycles)
+{
+    char names[BENCH_MAX_MODULES][24];
+    uint64 self[BENCH_MAX_MODULES];
+    uint64 calls[BENCH_MAX_MODULES];
+    uint32 modules = 0u;
+    uint32 m;
+
+    for (uint32 f = 0; f < count; f++)
+    {
+        const char *end = strchr(functions[f].name, '_');
+        size_t length = (end != NULL_PTR) ? (size_t)(end - functions[f].name) : strlen(functions[f].name);
+
+        length = (length < sizeof(names[0]) - 1u) ? length : sizeof(names[0]) - 1u;
+        for (m = 0; m < modules; m++)
+        {
+            if (strlen(names[m]) == length && strncmp(names[m], functions[f].name, length) == 0)
+            {
+                break;
+            }
+        }
+        if (m == modules)
+        {
+            if (modules == BENCH_MAX_MODULES)
+            {
+                continue;
+            }
+            (void)memcpy(names[m], functions[f].name, length);
+            names[m][length] = '\0';
+            self[m] = 0u;
+            calls[m] = 0u;
+            modules++;
+        }
+        self[m] += functions[f].selfCycles;
+        calls[m] += functions[f].calls;
+    }
+
+    printf("Modules by self time\n");
+    printf("  %-16s %12s %8s\n", "module", "calls", "self %");
+    while (modules > 0u)
+    {
+        uint32 best = 0u;
+
+        for (m = 1u; m < modules; m++)
+        {
+            best = (self[m] > self[best]) ? m : best;
+        }
+        printf("  %-16s %12llu %7.1f%%\n", names[best], (unsigned long long)calls[best],
+               (cycles != 0u) ? 100.0 * (double)self[best] / (double)cycles : 0.0);
+        modules--;
+        (void)memcpy(names[best], names[modules], sizeof(names[0]));
+        self[best] = self[modules];
+        calls[best] = calls[modules];
+    }
+}
+
+int main(void)
+{
+    static Prof_FunctionType functions[BENCH_MAX_FUNCTIONS];
+    Prof_StatisticsType stats;
+    uint64 stopped;
+    uint64 profiled;
+    uint64 self = 0u;
+    uint32 count;
+
+    Det_Init();
+    Tm_Init();
+    SwTmr_Init();
+    ComM_Init();
+    BSWM_Init();
+    SwTmr_Setup(&Bench_Timer, Bench_TimerCallback, 0u);
+    (void)SwTmr_Start(&Bench_Timer, 5u, 5u);
+    Prof_Init();
+
+    /* Warm-up, then the hooks return at once */
+    (void)Bench_Run();
+    stopped = Bench_Run();
+
+    Prof_Reset();
+    Prof_Start();
+    profiled = Bench_Run();
+    Prof_Stop();
+
+    Prof_GetStatistics(&stats);
+    count = Prof_GetFunctions(functions, BENCH_MAX_FUNCTIONS);
+    for (uint32 f = 0; f < count; f++)
+    {
+        self += functions[f].selfCycles;
+    }
+
+    printf("Drive cycle of %u ms, %u functions instrumented and called\n", (unsigned)BENCH_RUN_MS,
+           (unsigned)count);
+    printf("  %-36s %10.1f ms\n", "host time, profiling stopped", (double)stopped / 1e6);
+    printf("  %-36s %10.1f ms\n", "host time, profiled", (double)profiled / 1e6);
+    printf("  %-36s %10.2f cycles/ns\n", "cycle counter", stats.cyclesPerNs);
+    printf("  %-36s %10llu\n", "calls", (unsigned long long)stats.calls);
+    printf("  %-36s %10u cycles, %.1f ns\n", "hook cost per call", (unsigned)stats.hookCycles,
+           (double)stats.hookCycles / stats.cyclesPerNs);
+    printf("  %-36s %10.1f ms, %.1f%% of the instrumented code\n", "hook cost in the profile",
+           (double)stats.overheadCycles / stats.cyclesPerNs / 1e6,
+           100.0 * (double)stats.overheadCycles / (double)stats.cycles);
+    printf("  %-36s %10.1f ms, %.1f%% of the host time\n", "instrumented code, without hooks",
+           (double)self / stats.cyclesPerNs / 1e6, (double)self / stats.cyclesPerNs * 100.0 / (double)profiled);
+    printf("  %-36s %10u, %llu dropped\n", "call paths", (unsigned)stats.nodes, (unsigned long long)stats.dropped);
+
+    printf("Functions by self time\n");
+    printf("  %-32s %10s %10s %8s %8s\n", "function", "calls", "ns/call", "self %", "total %");
+    for (uint32 f = 0; f < count && f < BENCH_TOP_FUNCTIONS; f++)
+    {
+        printf("  %-32s %10llu %10.1f %7.1f%% %7.1f%%\n", functions[f].name, (unsigned long long)functions[f].calls,
+               (double)functions[f].selfCycles / stats.cyclesPerNs / (double)functions[f].calls,
+               100.0 * (double)functions[f].selfCycles / (double)self,
+               100.0 * (double)functions[f].totalCycles / (double)stats.cycles);
+    }
+    Bench_PrintModules(functions, count, self);
+
+    if (Prof_WriteFolded(BENCH_FOLDED_PATH) == E_OK)
+    {
+        printf("Folded stacks in %s\n", BENCH_FOLDED_PATH);
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * PwmIf_Bench.c - Grouped Three-Phase PWM Update Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Checks on the simulated PWM timer that phase updates never
+ *              straddle a period boundary, and compares the host cost of
+ *              PwmIf_SetPhaseDutyCycles with three PwmIf_SetDutyCycle calls.
+ *
+ *              Every update writes the same duty to all three phases; a
+ *              period in which the active compare values differ is torn.
+ *              Each register access consumes simulated timer ticks and
+ *              updates start at random carrier positions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Det.h"
+#include "PwmIf.h"
+#include "PwmIf_Cfg.h"
+#include "PwmHw.h"
+#include "Bench.h"
+
+#define BENCH_UPDATES                (200000u)
+#define BENCH_COST_ITERATIONS        (10000000u)
+
+/* Simulated ticks per register access (100 MHz clock: 400 ns) */
+#define BENCH_ACCESS_TICKS           (40u)
+
+static uint32 Bench_TornPeriods;
+
+static void Bench_CheckPeriod(uint32 periodCount)
+{
+    uint32 u = PwmHw_SimGetActiveCompare(PWMIF_HW_CHANNEL_U);
+
+    (void)periodCount;
+    if (PwmHw_SimGetActiveCompare(PWMIF_HW_CHANNEL_V) != u ||
+        PwmHw_SimGetActiveCompare(PWMIF_HW_CHANNEL_W) != u)
+    {
+        Bench_TornPeriods++;
+    }
+}
+
+static void Bench_Single(PwmIf_DutyType duty)
+{
+    PwmIf_SetDutyCycle(PWMIF_CHANNEL_U, duty);
+    PwmIf_SetDutyCycle(PWMIF_CHANNEL_V, duty);
+    PwmIf_SetDutyCycle(PWMIF_CHANNEL_W, duty);
+}
+
+static void Bench_Grouped(PwmIf_DutyType duty)
+{
+    PwmIf_SetPhaseDutyCycles(duty, duty, duty);
+}
+
+static void Bench_TearCheck(const char *name, void (*update)(PwmIf_DutyType duty))
+{
+    PwmHw_SimInit(PWMIF_PERIOD_TICKS);
+    PwmIf_Init();
+    PwmHw_SimSetAccessCost(BENCH_ACCESS_TICKS);
+    PwmHw_SimSetPeriodCallback(Bench_CheckPeriod);
+    Bench_TornPeriods = 0u;
+    srand(1u);
+
+    for (uint32 i = 0; i < BENCH_UPDATES; i++)
+    {
+        /* One update per period, starting at a random carrier position */
+        PwmHw_SimAdvance((uint32)rand() % PWMIF_PERIOD_TICKS);
+        update((PwmIf_DutyType)(i * 997u));
+        PwmHw_SimAdvance(PWMIF_PERIOD_TICKS - PwmHw_SimGetCounter());
+    }
+
+    printf("  %-28s %u of %u periods torn\n", name, (unsigned)Bench_TornPeriods,
+           (unsigned)PwmHw_SimGetPeriodCount());
+    PwmIf_DeInit();
+}
+
+static void Bench_Cost(const char *name, void (*update)(PwmIf_DutyType duty))
+{
+    uint64 start;
+    uint64 elapsed;
+
+    PwmHw_SimInit(PWMIF_PERIOD_TICKS);
+    PwmIf_Init();
+
+    start = Bench_NowNs();
+    for (uint32 i = 0; i < BENCH_COST_ITERATIONS; i++)
+    {
+        update((PwmIf_DutyType)i);
+    }
+    elapsed = Bench_NowNs() - start;
+
+    printf("  %-28s %6.2f ns per three-phase update\n", name,
+           (double)elapsed / BENCH_COST_ITERATIONS);
+    PwmIf_DeInit();
+}
+
+int main(void)
+{
+    Det_Init();
+
+    printf("Tear check: %u updates, %u ticks per register access, period %u ticks\n",
+           (unsigned)BENCH_UPDATES, (unsigned)BENCH_ACCESS_TICKS, (unsigned)PWMIF_PERIOD_TICKS);
+    Bench_TearCheck("3 x PwmIf_SetDutyCycle", Bench_Single);
+    Bench_TearCheck("PwmIf_SetPhaseDutyCycles", Bench_Grouped);
+
+    printf("Host cost (no simulated access time)\n");
+    Bench_Cost("3 x PwmIf_SetDutyCycle", Bench_Single);
+    Bench_Cost("PwmIf_SetPhaseDutyCycles", Bench_Grouped);
+
+    return 0;
+}
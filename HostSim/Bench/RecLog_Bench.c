@@ -0,0 +1,465 @@
+/*
+ * RecLog_Bench.c - Input Record and Replay Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Runs 10 s of a motor control scenario on the simulated
+ *              timeline: the control step in the group 0 notification of
+ *              the PWM-triggered ADC, a 1 ms tick with jitter that reads
+ *              the start and stop buttons, takes MOTOR_CMD from the CAN bus
+ *              and sends MOTOR_STATUS every 10 ms. Live, the phase currents
+ *              come from the plant model driven by the PWM outputs, and a
+ *              remote node sends the speed profile.
+ *
+ *              The live run is recorded, then replayed from the log without
+ *              the plant and the remote node. Reported: the log size, the
+ *              host time of the live run with and without recording and of
+ *              each replay, and whether the replay reproduces the control
+ *              outputs of the live run bit-exact (digest of every duty
+ *              cycle and status frame). A second control variant is then
+ *              replayed on the same inputs and compared to the first.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Det.h"
+#include "AdcIf.h"
+#include "AdcIf_Cfg.h"
+#include "PwmIf.h"
+#include "PwmIf_Cfg.h"
+#include "AdcHw.h"
+#include "PwmHw.h"
+#include "SimTime.h"
+#include "CanSM.h"
+#include "CanFdHw.h"
+#include "E2E.h"
+#include "MotorPlant.h"
+#include "RecLog.h"
+#include "Bench.h"
+
+#define BENCH_US                     (SIMTIME_TICKS_PER_SECOND / 1000000u)
+#define BENCH_MS                     (1000u * BENCH_US)
+#define BENCH_RUN_MS                 (10000u)
+#define BENCH_STEPS                  ((BENCH_RUN_MS * BENCH_MS) / PWMIF_PERIOD_TICKS)
+#define BENCH_REPLAYS                (20u)
+#define BENCH_LOG_PATH               "/tmp/reclog_bench.log"
+
+/* Converter timing: 1 us per channel, 200 ns interrupt entry */
+#define BENCH_CHANNEL_TICKS          (100u)
+#define BENCH_ISR_TICKS              (20u)
+
+/* Tick interrupt taken up to 50 us late */
+#define BENCH_TICK_JITTER            (50u * BENCH_US)
+
+/* MOTOR_CMD from the remote node, MOTOR_STATUS from this node */
+#define BENCH_CMD_PERIOD_MS          (10u)
+#define BENCH_CMD_OFFSET             (3u * BENCH_MS)
+#define BENCH_STATUS_PERIOD_MS       (10u)
+
+/* Buttons */
+#define BENCH_DIO_START              (0u)
+#define BENCH_DIO_STOP               (1u)
+#define BENCH_PRESS_MS               (20u)
+
+/* Inverter and current sensing */
+#define BENCH_VDC                    (24.0)
+#define BENCH_COUNTS_PER_AMP         (50.0)
+#define BENCH_CURRENT_OFFSET         (2048.0)
+#define BENCH_VOLTAGE_COUNTS         (2400u)
+#define BENCH_TEMPERATURE_COUNTS     (1500u)
+
+/* Control: V/f with damping of the current magnitude */
+#define BENCH_VOLTS_PER_HZ           (0.05)
+#define BENCH_CURRENT_REF            (2.0)      /* [A] */
+#define BENCH_MAX_MODULATION         (0.45)
+
+#define BENCH_FNV_OFFSET             (0xCBF29CE484222325u)
+#define BENCH_FNV_PRIME              (0x100000001B3u)
+
+typedef struct {
+    const char *name;
+    double damping;              /* Modulation per ampere of current error */
+} Bench_VariantType;
+
+static const Bench_VariantType Bench_Variants[] = {
+    {"A, damping 0.010", 0.010},
+    {"B, damping 0.025", 0.025}
+};
+
+/* Speed profile of the remote node [rpm] */
+static const struct {
+    uint32 fromMs;
+    uint16 rpm;
+} Bench_Profile[] = {
+    {0u, 0u}, {200u, 1500u}, {2500u, 3000u}, {5000u, 1000u}, {7000u, 2500u}
+};
+
+/* Button presses */
+static const struct {
+    uint8 channel;
+    uint32 atMs;
+} Bench_Presses[] = {
+    {BENCH_DIO_START, 100u}, {BENCH_DIO_STOP, 4000u}, {BENCH_DIO_START, 4500u}
+};
+
+static boolean Bench_Live;
+static const Bench_VariantType *Bench_Variant;
+static uint64 Bench_TickNominal;
+static uint32 Bench_TickCount;
+static uint32 Bench_Random;
+static uint32 Bench_Compare[3];
+
+/* Control state */
+static boolean Bench_Running;
+static uint16 Bench_CmdRpm;
+static double Bench_Angle;
+static double Bench_Current;
+static uint32 Bench_Step;
+static uint64 Bench_Digest;
+static PwmIf_DutyType Bench_Duty[BENCH_STEPS + 1u];
+static PwmIf_DutyType Bench_DutyA[BENCH_STEPS + 1u];
+
+/* Forward declarations */
+static void Bench_TickEvent(uint32 arg);
+
+static void Bench_Hash(uint32 value)
+{
+    for (uint8 i = 0; i < 4u; i++)
+    {
+        Bench_Digest = (Bench_Digest ^ (uint8)(value >> (8u * i))) * BENCH_FNV_PRIME;
+    }
+}
+
+/* Live inputs: plant currents, DC link voltage and temperatures */
+static AdcIf_ValueType Bench_Source(uint8 group, uint8 index, uint64 sampleTick)
+{
+    double current[3];
+    double counts;
+
+    if (group == ADCIF_GROUP_0 && index < 3u)
+    {
+        MotorPlant_GetCurrents(&current[0], &current[1], &current[2]);
+        counts = BENCH_CURRENT_OFFSET + current[index] * BENCH_COUNTS_PER_AMP;
+        counts = (counts < 0.0) ? 0.0 : ((counts > 4095.0) ? 4095.0 : counts);
+        return (AdcIf_ValueType)counts;
+    }
+    if (index == 0u)
+    {
+        return (AdcIf_ValueType)(BENCH_VOLTAGE_COUNTS + ((sampleTick >> 10) & 0xFu));
+    }
+    return (AdcIf_ValueType)(BENCH_TEMPERATURE_COUNTS + (uint32)(sampleTick / (100u * BENCH_MS)));
+}
+
+/* Live plant: the phase voltages of the period that ended */
+static void Bench_PeriodCallback(uint32 periodCount)
+{
+    double v[3];
+
+    (void)periodCount;
+    for (uint8 p = 0; p < 3u; p++)
+    {
+        v[p] = ((double)Bench_Compare[p] / PWMIF_PERIOD_TICKS - 0.5) * BENCH_VDC;
+    }
+    MotorPlant_Step((double)PWMIF_PERIOD_TICKS / SIMTIME_TICKS_PER_SECOND, v[0], v[1], v[2]);
+
+    Bench_Compare[0] = PwmHw_SimGetActiveCompare(PWMIF_HW_CHANNEL_U);
+    Bench_Compare[1] = PwmHw_SimGetActiveCompare(PWMIF_HW_CHANNEL_V);
+    Bench_Compare[2] = PwmHw_SimGetActiveCompare(PWMIF_HW_CHANNEL_W);
+}
+
+/* Adc_GroupNotification_0: the control step */
+static void Bench_ControlStep(void)
+{
+    AdcIf_ValueType currents[ADCIF_GROUP0_CHANNELS];
+    PwmIf_DutyType duty[3];
+    double frequency;
+    double alpha;
+    double beta;
+    double modulation;
+    double value;
+
+    (void)AdcIf_ReadGroup(ADCIF_GROUP_0, currents);
+    alpha = ((double)currents[0] - BENCH_CURRENT_OFFSET) / BENCH_COUNTS_PER_AMP;
+    beta = (alpha + 2.0 * (((double)currents[1] - BENCH_CURRENT_OFFSET) / BENCH_COUNTS_PER_AMP)) / sqrt(3.0);
+    Bench_Current = sqrt(alpha * alpha + beta * beta);
+
+    if (Bench_Running == TRUE)
+    {
+        frequency = (double)Bench_CmdRpm / 60.0 * MOTORPLANT_POLE_PAIRS;
+        Bench_Angle = fmod(Bench_Angle + 2.0 * M_PI * frequency * PWMIF_PERIOD_TICKS / SIMTIME_TICKS_PER_SECOND,
+                           2.0 * M_PI);
+        modulation = BENCH_VOLTS_PER_HZ * frequency / BENCH_VDC +
+                     Bench_Variant->damping * (BENCH_CURRENT_REF - Bench_Current);
+        modulation = (modulation < 0.0) ? 0.0 :
+                     ((modulation > BENCH_MAX_MODULATION) ? BENCH_MAX_MODULATION : modulation);
+        for (uint8 p = 0; p < 3u; p++)
+        {
+            value = 32768.0 + 65535.0 * modulation * sin(Bench_Angle - (double)p * 2.0 * M_PI / 3.0);
+            duty[p] = (PwmIf_DutyType)value;
+        }
+    }
+    else
+    {
+        duty[0] = duty[1] = duty[2] = 32768u;
+    }
+    PwmIf_SetPhaseDutyCycles(duty[0], duty[1], duty[2]);
+
+    Bench_Hash(((uint32)duty[0] << 16) | duty[1]);
+    Bench_Hash(duty[2]);
+    if (Bench_Step <= BENCH_STEPS)
+    {
+        Bench_Duty[Bench_Step] = duty[0];
+    }
+    Bench_Step++;
+}
+
+/* Live environment: button levels */
+static uint8 Bench_Button(uint8 channel, uint64 now)
+{
+    for (uint32 i = 0; i < sizeof(Bench_Presses) / sizeof(Bench_Presses[0]); i++)
+    {
+        if (Bench_Presses[i].channel == channel && now >= (uint64)Bench_Presses[i].atMs * BENCH_MS &&
+            now < (uint64)(Bench_Presses[i].atMs + BENCH_PRESS_MS) * BENCH_MS)
+        {
+            return STD_HIGH;
+        }
+    }
+    return STD_LOW;
+}
+
+/* Live environment: the remote node sends MOTOR_CMD */
+static void Bench_RemoteEvent(uint32 arg)
+{
+    CanSM_FdFrameType frame = {0};
+    uint32 ms = (uint32)(SimTime_Now() / BENCH_MS);
+    uint16 rpm = 0u;
+
+    (void)arg;
+    for (uint32 i = 0; i < sizeof(Bench_Profile) / sizeof(Bench_Profile[0]); i++)
+    {
+        rpm = (ms >= Bench_Profile[i].fromMs) ? Bench_Profile[i].rpm : rpm;
+    }
+    frame.id = CANSM_MOTOR_CMD_ID;
+    frame.length = 8u;
+    frame.brs = TRUE;
+    frame.data[0] = (uint8)rpm;
+    frame.data[1] = (uint8)(rpm >> 8);
+    (void)CanFdHw_Transmit(&frame);
+    (void)SimTime_Schedule(SimTime_Now() + BENCH_CMD_PERIOD_MS * BENCH_MS, Bench_RemoteEvent, 0u);
+}
+
+static void Bench_ScheduleTick(void)
+{
+    uint64 at;
+
+    if (Bench_Live == TRUE)
+    {
+        /* Linear congruential jitter, the same in every live run */
+        Bench_Random = Bench_Random * 1664525u + 1013904223u;
+        Bench_TickNominal += BENCH_MS;
+        at = Bench_TickNominal + (Bench_Random >> 8) % BENCH_TICK_JITTER;
+    }
+    else if (RecLog_Peek(RECLOG_STREAM_GPT_TICK, &at) == FALSE)
+    {
+        return;
+    }
+    else
+    {
+        /* Replayed at the recorded tick */
+    }
+    (void)SimTime_Schedule(at, Bench_TickEvent, 0u);
+}
+
+/* Gpt_Notification_0 */
+static void Bench_TickEvent(uint32 arg)
+{
+    CanSM_FdFrameType frame;
+    uint64 now = SimTime_Now();
+    const uint8 *data;
+    uint8 length;
+
+    (void)arg;
+    if (Bench_Live == TRUE)
+    {
+        RecLog_Write(RECLOG_STREAM_GPT_TICK, NULL_PTR, 0u);
+    }
+    else
+    {
+        (void)RecLog_Take(RECLOG_STREAM_GPT_TICK, &data, &length);
+    }
+
+    if (RecLog_DioRead(BENCH_DIO_START, Bench_Live ? Bench_Button(BENCH_DIO_START, now) : STD_LOW) == STD_HIGH)
+    {
+        Bench_Running = TRUE;
+    }
+    if (RecLog_DioRead(BENCH_DIO_STOP, Bench_Live ? Bench_Button(BENCH_DIO_STOP, now) : STD_LOW) == STD_HIGH)
+    {
+        Bench_Running = FALSE;
+    }
+
+    while (CanSM_ReceiveFdFrame(&frame) == E_OK)
+    {
+        if (frame.id == CANSM_MOTOR_CMD_ID)
+        {
+            Bench_CmdRpm = (uint16)(frame.data[0] | (frame.data[1] << 8));
+        }
+    }
+
+    Bench_TickCount++;
+    if ((Bench_TickCount % BENCH_STATUS_PERIOD_MS) == 0u)
+    {
+        CanSM_SendMotorStatus(Bench_CmdRpm, (sint16)(Bench_Current * 100.0), (Bench_Running == TRUE) ? 0u : 1u);
+        Bench_Hash(((uint32)Bench_CmdRpm << 16) | (uint16)(sint16)(Bench_Current * 100.0));
+    }
+    Bench_ScheduleTick();
+}
+
+/**
+ * @brief   Run the scenario once
+ * @param   live  TRUE: with the plant and the remote node; FALSE: inputs from
+ *                the log being replayed
+ * @return  Host time [ns]
+ */
+static uint64 Bench_Run(boolean live, const Bench_VariantType *variant)
+{
+    uint64 start = Bench_NowNs();
+
+    SimTime_Init();
+    PwmHw_SimInit(PWMIF_PERIOD_TICKS);
+    AdcHw_SimInit(BENCH_CHANNEL_TICKS, BENCH_ISR_TICKS);
+    AdcHw_SimSetGroupChannels(ADCIF_GROUP_0, ADCIF_GROUP0_CHANNELS);
+    AdcHw_SimSetGroupChannels(ADCIF_GROUP_1, ADCIF_GROUP1_CHANNELS);
+    PwmHw_SimSetTriggerCallback(AdcHw_SimHardwareTrigger);
+    PwmIf_Init();
+    AdcIf_Init();
+    AdcIf_RegisterGroupNotification(ADCIF_GROUP_0, Bench_ControlStep);
+    CanFdHw_Init();
+    E2E_Init();
+
+    Bench_Live = live;
+    Bench_Variant = variant;
+    Bench_TickNominal = 0u;
+    Bench_TickCount = 0u;
+    Bench_Random = 0x2545F491u;
+    Bench_Running = FALSE;
+    Bench_CmdRpm = 0u;
+    Bench_Angle = 0.0;
+    Bench_Current = 0.0;
+    Bench_Step = 0u;
+    Bench_Digest = BENCH_FNV_OFFSET;
+
+    if (live == TRUE)
+    {
+        MotorPlant_Init(NULL_PTR);
+        MotorPlant_SetLoadTorque(0.005);
+        Bench_Compare[0] = Bench_Compare[1] = Bench_Compare[2] = PWMIF_PERIOD_TICKS / 2u;
+        AdcHw_SimSetSource(Bench_Source);
+        PwmHw_SimSetPeriodCallback(Bench_PeriodCallback);
+        (void)SimTime_Schedule(BENCH_CMD_OFFSET, Bench_RemoteEvent, 0u);
+    }
+    else
+    {
+        PwmHw_SimSetPeriodCallback(NULL_PTR);
+    }
+    Bench_ScheduleTick();
+    AdcIf_EnableGroupTrigger();
+
+    SimTime_Advance((uint64)BENCH_RUN_MS * BENCH_MS);
+    return Bench_NowNs() - start;
+}
+
+static void Bench_PrintRun(const char *name, uint64 ns)
+{
+    printf("  %-30s %10.1f %10.1f  %016llx\n", name, (double)ns / 1e6,
+           (double)BENCH_RUN_MS * 1e6 / (double)ns, (unsigned long long)Bench_Digest);
+}
+
+int main(void)
+{
+    static const char *const streamNames[RECLOG_STREAMS] = {
+        "CAN rx", "CAN tx refused", "ADC group 0", "ADC group 1", "GPT tick", "DIO change"
+    };
+    RecLog_StatisticsType recorded;
+    RecLog_StatisticsType stats;
+    uint64 ns;
+    uint64 best = ~(uint64)0u;
+    uint64 liveDigest;
+    uint32 exact = 0u;
+    uint32 late = 0u;
+    uint32 remaining = 0u;
+    uint32 differing = 0u;
+    uint32 maxDelta = 0u;
+    uint32 delta;
+
+    Det_Init();
+    CanSM_Init();
+    CanSM_SetState(CANSM_READY);
+
+    printf("Record and replay, %u ms simulated, %u control steps\n", (unsigned)BENCH_RUN_MS,
+           (unsigned)BENCH_STEPS);
+    printf("  %-30s %10s %10s  %16s\n", "run", "host ms", "x realtime", "output digest");
+
+    ns = Bench_Run(TRUE, &Bench_Variants[0]);
+    Bench_PrintRun("live", ns);
+
+    if (RecLog_StartRecording(BENCH_LOG_PATH) != E_OK)
+    {
+        printf("  cannot create %s\n", BENCH_LOG_PATH);
+        return 1;
+    }
+    ns = Bench_Run(TRUE, &Bench_Variants[0]);
+    RecLog_Stop();
+    Bench_PrintRun("live, recording", ns);
+    liveDigest = Bench_Digest;
+    RecLog_GetStatistics(&recorded);
+
+    for (uint32 r = 0; r < BENCH_REPLAYS; r++)
+    {
+        if (RecLog_StartReplay(BENCH_LOG_PATH) != E_OK)
+        {
+            printf("  cannot map %s\n", BENCH_LOG_PATH);
+            return 1;
+        }
+        ns = Bench_Run(FALSE, &Bench_Variants[0]);
+        RecLog_Stop();
+        best = (ns < best) ? ns : best;
+        exact += (Bench_Digest == liveDigest) ? 1u : 0u;
+        RecLog_GetStatistics(&stats);
+        late += stats.late;
+        remaining += stats.remaining;
+    }
+    Bench_PrintRun("replay A, best", best);
+    for (uint32 i = 0; i <= BENCH_STEPS; i++)
+    {
+        Bench_DutyA[i] = Bench_Duty[i];
+    }
+
+    (void)RecLog_StartReplay(BENCH_LOG_PATH);
+    ns = Bench_Run(FALSE, &Bench_Variants[1]);
+    RecLog_Stop();
+    Bench_PrintRun("replay B", ns);
+
+    printf("Replays of A bit-exact to the live run: %u of %u (%u records taken late, %u never taken)\n",
+           (unsigned)exact, (unsigned)BENCH_REPLAYS, (unsigned)late, (unsigned)remaining);
+
+    for (uint32 i = 0; i <= BENCH_STEPS; i++)
+    {
+        delta = (uint32)abs((int)Bench_Duty[i] - (int)Bench_DutyA[i]);
+        differing += (delta != 0u) ? 1u : 0u;
+        maxDelta = (delta > maxDelta) ? delta : maxDelta;
+    }
+    printf("Variant %s against %s on the same inputs: phase U duty differs in %u of %u steps, "
+           "max %.2f %%\n", Bench_Variants[1].name, Bench_Variants[0].name, (unsigned)differing,
+           (unsigned)BENCH_STEPS, 100.0 * maxDelta / 65536.0);
+
+    printf("Log: %llu bytes\n", (unsigned long long)recorded.bytes);
+    printf("  %-30s %10s\n", "stream", "records");
+    for (uint32 st = 0; st < RECLOG_STREAMS; st++)
+    {
+        printf("  %-30s %10u\n", streamNames[st], (unsigned)recorded.records[st]);
+    }
+    return 0;
+}
@@ -0,0 +1,322 @@
+/*
+ * Sched_Bench.c - Multi-Rate Scheduling Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Runs a 20 kHz current loop, a 1 kHz speed loop and a 100 Hz
+ *              supervision on the simulated timeline, with the execution
+ *              time of each modelled by advancing the simulated clock, so
+ *              that the interrupts due meanwhile preempt it:
+ *
+ *              - single rate: all three in the group 0 notification, the
+ *                slower ones on every 20th and 200th call; a notification
+ *                arriving while the previous one runs is lost
+ *              - multi-rate: Sched_Tick in the group 0 notification, the
+ *                slower loops in the software interrupts of their rate
+ *                groups, with phase offsets
+ *              - multi-rate with the supervision overloaded beyond its
+ *                period
+ *
+ *              Reported: lost current steps and the longest delay from the
+ *              current sample to the end of the step, the load, execution
+ *              and response time per rate group, and torn records between
+ *              the rates, through Sched exchanges and through plain shared
+ *              variables, each filled or read across a preemption.
+ */
+
+#include <stdio.h>
+
+#include "Det.h"
+#include "AdcIf.h"
+#include "AdcIf_Cfg.h"
+#include "PwmIf.h"
+#include "PwmIf_Cfg.h"
+#include "AdcHw.h"
+#include "PwmHw.h"
+#include "SimTime.h"
+#include "Tm.h"
+#include "Sched.h"
+#include "SchedHw.h"
+
+#define BENCH_US                     (SIMTIME_TICKS_PER_SECOND / 1000000u)
+#define BENCH_MS                     (1000u * BENCH_US)
+#define BENCH_RUN_MS                 (2000u)
+
+/* Converter timing: 1 us per channel, 200 ns interrupt entry */
+#define BENCH_CHANNEL_TICKS          (100u)
+#define BENCH_ISR_TICKS              (20u)
+
+/* Execution time of the loops */
+#define BENCH_CURRENT_TICKS          (12u * BENCH_US)
+#define BENCH_SPEED_TICKS            (40u * BENCH_US)
+#define BENCH_SUPERVISION_TICKS      (150u * BENCH_US)
+#define BENCH_OVERLOAD_TICKS         (12u * BENCH_MS)
+
+/* Base ticks per speed loop and supervision run in the single rate ISR */
+#define BENCH_SPEED_DIVIDER          (20u)
+#define BENCH_SUPERVISION_DIVIDER    (200u)
+
+typedef enum {
+    BENCH_SINGLE_RATE,
+    BENCH_MULTI_RATE,
+    BENCH_MULTI_RATE_OVERLOAD
+} Bench_ModeType;
+
+/* Record passed between two rates; check is the complement of value */
+typedef struct {
+    uint32 value;
+    uint32 check;
+} Bench_RecordType;
+
+static Bench_ModeType Bench_Mode;
+static boolean Bench_BaseActive;
+static uint32 Bench_BaseCount;
+static uint32 Bench_CurrentSteps;
+static uint32 Bench_LostSteps;
+static uint64 Bench_MaxLatency;
+static uint64 Bench_Executed;
+
+/* Speed loop to current loop */
+static Bench_RecordType Bench_CommandBuffers[3];
+static Sched_ExchangeType Bench_Command;
+static Bench_RecordType Bench_SharedCommand;
+static uint32 Bench_CommandValue;
+
+/* Current loop to supervision */
+static Bench_RecordType Bench_MeasurementBuffers[3];
+static Sched_ExchangeType Bench_Measurement;
+static Bench_RecordType Bench_SharedMeasurement;
+static uint32 Bench_MeasurementSequence;
+static uint32 Bench_SupervisionReads;
+static uint32 Bench_SequenceGaps;
+
+/* Torn records seen: [0] through the exchange, [1] through the shared variable */
+static uint32 Bench_TornCommands[2];
+static uint32 Bench_TornMeasurements[2];
+
+static AdcIf_ValueType Bench_Source(uint8 group, uint8 index, uint64 sampleTick)
+{
+    (void)group;
+    (void)index;
+    return (AdcIf_ValueType)(2048u + ((sampleTick >> 8) & 0xFFu));
+}
+
+/**
+ * @brief   Execute for a number of ticks of own time
+ * @details The interrupts due meanwhile run nested; their execution does
+ *          not count towards the ticks of the code they preempted.
+ */
+static void Bench_Execute(uint64 ticks)
+{
+    uint64 start;
+    uint64 nested;
+    uint64 own;
+
+    while (ticks > 0u)
+    {
+        start = SimTime_Now();
+        nested = Bench_Executed;
+        SimTime_Advance(ticks);
+        own = (SimTime_Now() - start) - (Bench_Executed - nested);
+        own = (own < ticks) ? own : ticks;
+        Bench_Executed += own;
+        ticks -= own;
+    }
+}
+
+static void Bench_CurrentLoop(void)
+{
+    AdcIf_ValueType currents[ADCIF_GROUP0_CHANNELS];
+    const Bench_RecordType *command;
+    Bench_RecordType *measurement;
+    uint64 latency;
+
+    (void)AdcIf_ReadGroup(ADCIF_GROUP_0, currents);
+
+    command = (const Bench_RecordType *)Sched_ExchangeRead(&Bench_Command, NULL_PTR);
+    Bench_TornCommands[0] += (command->check != ~command->value) ? 1u : 0u;
+    Bench_TornCommands[1] += (Bench_SharedCommand.check != ~Bench_SharedCommand.value) ? 1u : 0u;
+    Bench_Execute(BENCH_CURRENT_TICKS);
+    PwmIf_SetPhaseDutyCycles((PwmIf_DutyType)(command->value & 0x7FFFu), currents[1], currents[2]);
+
+    Bench_MeasurementSequence++;
+    measurement = (Bench_RecordType *)Sched_ExchangeWriteBuffer(&Bench_Measurement);
+    measurement->value = Bench_MeasurementSequence;
+    measurement->check = ~Bench_MeasurementSequence;
+    Sched_ExchangePublish(&Bench_Measurement);
+    Bench_SharedMeasurement.value = Bench_MeasurementSequence;
+    Bench_SharedMeasurement.check = ~Bench_MeasurementSequence;
+
+    Bench_CurrentSteps++;
+    latency = SimTime_Now() - AdcHw_SimGetSampleTick(ADCIF_GROUP_0);
+    Bench_MaxLatency = (latency > Bench_MaxLatency) ? latency : Bench_MaxLatency;
+}
+
+/* Fills both records over the whole run, preempted in between */
+static void Bench_SpeedLoop(void)
+{
+    Bench_RecordType *command = (Bench_RecordType *)Sched_ExchangeWriteBuffer(&Bench_Command);
+
+    Bench_CommandValue++;
+    command->value = Bench_CommandValue;
+    Bench_SharedCommand.value = Bench_CommandValue;
+    Bench_Execute(BENCH_SPEED_TICKS);
+    command->check = ~Bench_CommandValue;
+    Bench_SharedCommand.check = ~Bench_CommandValue;
+    Sched_ExchangePublish(&Bench_Command);
+}
+
+/* Reads both records in two halves, preempted in between */
+static void Bench_Supervision(void)
+{
+    static uint32 lastSequence;
+    uint32 sequence;
+    const Bench_RecordType *measurement;
+    uint32 value;
+    uint32 sharedValue;
+    uint64 ticks = (Bench_Mode == BENCH_MULTI_RATE_OVERLOAD) ? BENCH_OVERLOAD_TICKS : BENCH_SUPERVISION_TICKS;
+
+    measurement = (const Bench_RecordType *)Sched_ExchangeRead(&Bench_Measurement, &sequence);
+    value = measurement->value;
+    sharedValue = Bench_SharedMeasurement.value;
+    Bench_Execute(ticks / 2u);
+    Bench_TornMeasurements[0] += (measurement->check != ~value) ? 1u : 0u;
+    Bench_TornMeasurements[1] += (Bench_SharedMeasurement.check != ~sharedValue) ? 1u : 0u;
+    Bench_Execute(ticks / 2u);
+
+    if (Bench_SupervisionReads > 0u)
+    {
+        Bench_SequenceGaps += sequence - lastSequence;
+    }
+    lastSequence = sequence;
+    Bench_SupervisionReads++;
+}
+
+/* Adc_GroupNotification_0 */
+static void Bench_BaseIsr(void)
+{
+    if (Bench_BaseActive == TRUE)
+    {
+        Bench_LostSteps++;
+        return;
+    }
+    Bench_BaseActive = TRUE;
+
+    if (Bench_Mode == BENCH_SINGLE_RATE)
+    {
+        Bench_CurrentLoop();
+        if ((Bench_BaseCount % BENCH_SPEED_DIVIDER) == 0u)
+        {
+            Bench_SpeedLoop();
+        }
+        if ((Bench_BaseCount % BENCH_SUPERVISION_DIVIDER) == 0u)
+        {
+            Bench_Supervision();
+        }
+    }
+    else
+    {
+        Sched_Tick();
+    }
+    Bench_BaseCount++;
+
+    Bench_BaseActive = FALSE;
+}
+
+static void Bench_Run(Bench_ModeType mode)
+{
+    static const char *const names[] = {"single rate ISR", "multi-rate", "multi-rate, supervision overloaded"};
+    static const char *const groups[SCHED_MAX_GROUPS] = {"current 20 kHz", "speed 1 kHz", "supervision 100 Hz"};
+    Sched_GroupStatisticsType stats;
+    uint32 periods;
+
+    SimTime_Init();
+    PwmHw_SimInit(PWMIF_PERIOD_TICKS);
+    AdcHw_SimInit(BENCH_CHANNEL_TICKS, BENCH_ISR_TICKS);
+    AdcHw_SimSetGroupChannels(ADCIF_GROUP_0, ADCIF_GROUP0_CHANNELS);
+    AdcHw_SimSetGroupChannels(ADCIF_GROUP_1, ADCIF_GROUP1_CHANNELS);
+    AdcHw_SimSetSource(Bench_Source);
+    PwmHw_SimSetTriggerCallback(AdcHw_SimHardwareTrigger);
+    PwmIf_Init();
+    AdcIf_Init();
+    AdcIf_RegisterGroupNotification(ADCIF_GROUP_0, Bench_BaseIsr);
+    SchedHw_SimInit();
+    Sched_Init();
+    (void)Sched_AddRunnable(SCHED_GROUP_CURRENT, Bench_CurrentLoop);
+    (void)Sched_AddRunnable(SCHED_GROUP_SPEED, Bench_SpeedLoop);
+    (void)Sched_AddRunnable(SCHED_GROUP_SUPERVISION, Bench_Supervision);
+
+    Sched_ExchangeInit(&Bench_Command, Bench_CommandBuffers, sizeof(Bench_RecordType));
+    Sched_ExchangeInit(&Bench_Measurement, Bench_MeasurementBuffers, sizeof(Bench_RecordType));
+    for (uint32 i = 0; i < 3u; i++)
+    {
+        Bench_CommandBuffers[i].value = 0u;
+        Bench_CommandBuffers[i].check = ~0u;
+        Bench_MeasurementBuffers[i] = Bench_CommandBuffers[i];
+    }
+    Bench_SharedCommand = Bench_CommandBuffers[0];
+    Bench_SharedMeasurement = Bench_CommandBuffers[0];
+    Bench_Mode = mode;
+    Bench_BaseActive = FALSE;
+    Bench_BaseCount = 0u;
+    Bench_CurrentSteps = 0u;
+    Bench_LostSteps = 0u;
+    Bench_MaxLatency = 0u;
+    Bench_Executed = 0u;
+    Bench_CommandValue = 0u;
+    Bench_MeasurementSequence = 0u;
+    Bench_SupervisionReads = 0u;
+    Bench_SequenceGaps = 0u;
+    Bench_TornCommands[0] = Bench_TornCommands[1] = 0u;
+    Bench_TornMeasurements[0] = Bench_TornMeasurements[1] = 0u;
+
+    AdcIf_EnableGroupTrigger();
+    SimTime_Advance((uint64)BENCH_RUN_MS * BENCH_MS);
+    periods = PwmHw_SimGetPeriodCount();
+
+    printf("%s\n", names[mode]);
+    printf("  %-40s %u of %u periods, %u lost\n", "current steps", (unsigned)Bench_CurrentSteps,
+           (unsigned)periods, (unsigned)Bench_LostSteps);
+    printf("  %-40s %8.1f us\n", "longest sample to end of step", (double)Bench_MaxLatency / BENCH_US);
+    printf("  %-40s %8u exchange, %u shared\n", "torn commands, speed to current",
+           (unsigned)Bench_TornCommands[0], (unsigned)Bench_TornCommands[1]);
+    printf("  %-40s %8u exchange, %u shared\n", "torn measurements, current to supervision",
+           (unsigned)Bench_TornMeasurements[0], (unsigned)Bench_TornMeasurements[1]);
+    if (Bench_SupervisionReads > 1u)
+    {
+        printf("  %-40s %8.1f\n", "current steps per supervision read",
+               (double)Bench_SequenceGaps / (double)(Bench_SupervisionReads - 1u));
+    }
+    if (mode == BENCH_SINGLE_RATE)
+    {
+        return;
+    }
+
+    printf("  %-20s %9s %9s %8s %8s %10s %13s\n", "rate group", "releases", "overruns", "load %", "peak %",
+           "exec us", "response us");
+    for (uint8 g = 0; g < SCHED_MAX_GROUPS; g++)
+    {
+        (void)Sched_GetGroupStatistics(g, &stats);
+        printf("  %-20s %9u %9u %8.1f %8.1f %10.1f %13.1f\n", groups[g], (unsigned)stats.releases,
+               (unsigned)stats.overruns, stats.load / 10.0, stats.peakLoad / 10.0,
+               (double)TM_TICKS_TO_US(stats.maxExecTicks), (double)TM_TICKS_TO_US(stats.maxResponseTicks));
+    }
+    printf("  %-40s %8u, nested %u deep\n", "software interrupts taken", (unsigned)SchedHw_SimGetDispatches(),
+           (unsigned)SchedHw_SimGetMaxNesting());
+}
+
+int main(void)
+{
+    Det_Init();
+    SimTime_Init();
+    Tm_Init();
+
+    printf("Current loop %u us, speed loop %u us, supervision %u us, %u ms simulated\n",
+           (unsigned)(BENCH_CURRENT_TICKS / BENCH_US), (unsigned)(BENCH_SPEED_TICKS / BENCH_US),
+           (unsigned)(BENCH_SUPERVISION_TICKS / BENCH_US), (unsigned)BENCH_RUN_MS);
+    Bench_Run(BENCH_SINGLE_RATE);
+    Bench_Run(BENCH_MULTI_RATE);
+    Bench_Run(BENCH_MULTI_RATE_OVERLOAD);
+    return 0;
+}
@@ -0,0 +1,197 @@
+/*
+ * SetpointGen_Bench.c - S-Curve Setpoint Generator Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Drives SetpointGen with a random MOTOR_CMD sequence
+ *              (including commands that arrive mid-ramp and MOTOR_CONFIG
+ *              changes) and compares two ways of running it:
+ *
+ *              precomputed: SetpointGen_SetTarget on command arrival only,
+ *                           SetpointGen_MainFunction every tick
+ *              re-solve:    SetpointGen_SetTarget with the active target
+ *                           before every tick, i.e. the trajectory is
+ *                           planned again from the current state each
+ *                           period
+ *
+ *              Reported: host cost per tick, worst acceleration and jerk
+ *              against the limits, how many ramps ended exactly on their
+ *              target, and the largest deviation between the two runs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Det.h"
+#include "SetpointGen.h"
+#include "SetpointGen_Cfg.h"
+#include "Bench.h"
+
+#define BENCH_TICKS                  (2000000u)   /* 2000 s of 1 ms ticks */
+#define BENCH_MAX_SPEED              (50000u)     /* 5000 rpm */
+#define BENCH_MAX_TORQUE             (800)        /* 80 % */
+
+typedef struct {
+    uint32 tick;
+    sint32 speed;
+    sint16 acceleration;   /* > 0: MOTOR_CONFIG instead of MOTOR_CMD */
+} Bench_EventType;
+
+#define BENCH_MAX_EVENTS             (4096u)
+
+static Bench_EventType Bench_Events[BENCH_MAX_EVENTS];
+static uint32 Bench_EventCount;
+static sint32 Bench_Speed[BENCH_TICKS];
+static sint32 Bench_Accel[BENCH_TICKS];
+
+static void Bench_MakeEvents(void)
+{
+    uint32 tick = 0u;
+    sint32 speed = 0;
+    static const sint16 accelerations[] = {100, 500, 1000};
+
+    srand(7u);
+    Bench_EventCount = 0u;
+    while (Bench_EventCount < BENCH_MAX_EVENTS)
+    {
+        /* Commands every 0.2 .. 8 s, so many arrive before the ramp ended */
+        tick += 200u + (uint32)rand() % 7800u;
+        if (tick >= BENCH_TICKS)
+        {
+            break;
+        }
+        Bench_Events[Bench_EventCount].tick = tick;
+        if (rand() % 10 == 0)
+        {
+            Bench_Events[Bench_EventCount].speed = 0;
+            Bench_Events[Bench_EventCount].acceleration = accelerations[rand() % 3];
+        }
+        else
+        {
+            /* Steps of up to +/- 400 rpm, some beyond MAX_SPEED */
+            speed += (sint32)(rand() % 8001) - 4000;
+            speed = (speed > 55000) ? 55000 : ((speed < -55000) ? -55000 : speed);
+            Bench_Events[Bench_EventCount].speed = speed;
+            Bench_Events[Bench_EventCount].acceleration = 0;
+        }
+        Bench_EventCount++;
+    }
+}
+
+static uint64 Bench_Run(boolean resolve, sint32 *speedOut, sint32 *accelOut)
+{
+    uint32 next = 0u;
+    sint32 target = 0;
+    sint16 torque = 100;
+    uint64 start;
+
+    SetpointGen_Init();
+    SetpointGen_SetLimits(BENCH_MAX_SPEED, BENCH_MAX_TORQUE, 500);
+
+    start = Bench_NowNs();
+    for (uint32 t = 0; t < BENCH_TICKS; t++)
+    {
+        while (next < Bench_EventCount && Bench_Events[next].tick == t)
+        {
+            if (Bench_Events[next].acceleration > 0)
+            {
+                SetpointGen_SetLimits(BENCH_MAX_SPEED, BENCH_MAX_TORQUE, Bench_Events[next].acceleration);
+            }
+            else
+            {
+                target = Bench_Events[next].speed;
+                (void)SetpointGen_SetTarget(target, torque);
+            }
+            next++;
+        }
+        if (resolve == TRUE)
+        {
+            (void)SetpointGen_SetTarget(target, torque);
+        }
+        SetpointGen_MainFunction();
+        speedOut[t] = SetpointGen_GetSpeed();
+        accelOut[t] = SetpointGen_GetAcceleration();
+    }
+    return Bench_NowNs() - start;
+}
+
+int main(void)
+{
+    static sint32 resolveSpeed[BENCH_TICKS];
+    static sint32 resolveAccel[BENCH_TICKS];
+    uint64 precomputedNs;
+    uint64 resolveNs;
+    uint32 next = 0u;
+    sint32 accelLimit = 500;
+    sint32 maxAccelRatio = 0;    /* per mille of the limit */
+    sint32 maxJerkRatio = 0;
+    uint32 settled = 0u;
+    uint32 reached = 0u;
+    sint32 lastTarget = 0;
+    sint32 target;
+    sint32 maxDeviation = 0;
+    sint32 value;
+
+    Det_Init();
+    Bench_MakeEvents();
+
+    precomputedNs = Bench_Run(FALSE, Bench_Speed, Bench_Accel);
+    resolveNs = Bench_Run(TRUE, resolveSpeed, resolveAccel);
+
+    for (uint32 t = 1; t < BENCH_TICKS; t++)
+    {
+        while (next < Bench_EventCount && Bench_Events[next].tick <= t)
+        {
+            if (Bench_Events[next].acceleration > 0)
+            {
+                accelLimit = Bench_Events[next].acceleration;
+            }
+            next++;
+        }
+
+        /* Acceleration and jerk relative to the configured limits */
+        value = (Bench_Accel[t] < 0 ? -Bench_Accel[t] : Bench_Accel[t]) * 1000 / accelLimit;
+        maxAccelRatio = (value > maxAccelRatio) ? value : maxAccelRatio;
+        /* One LSB of the reported acceleration is rounding */
+        value = Bench_Accel[t] - Bench_Accel[t - 1];
+        value = ((value < 0) ? -value : value) - 1;
+        value = ((value < 0) ? 0 : value) * 1000 /
+                (accelLimit / (sint32)(SETPOINTGEN_JERK_TIME_MS / SETPOINTGEN_TICK_MS));
+        if (next == 0u || Bench_Events[next - 1u].tick != t)
+        {
+            maxJerkRatio = (value > maxJerkRatio) ? value : maxJerkRatio;
+        }
+
+        /* Ramps that settled before the next event must sit on their target */
+        if (Bench_Accel[t] == 0 && Bench_Speed[t] == Bench_Speed[t - 1] && next > 0u &&
+            (next == Bench_EventCount || Bench_Events[next].tick == t + 1u))
+        {
+            target = (Bench_Events[next - 1u].acceleration > 0) ? lastTarget : Bench_Events[next - 1u].speed;
+            target = (target > (sint32)BENCH_MAX_SPEED) ? (sint32)BENCH_MAX_SPEED :
+                     ((target < -(sint32)BENCH_MAX_SPEED) ? -(sint32)BENCH_MAX_SPEED : target);
+            settled++;
+            reached += (Bench_Speed[t] == target) ? 1u : 0u;
+        }
+        if (next > 0u && Bench_Events[next - 1u].acceleration == 0)
+        {
+            lastTarget = Bench_Events[next - 1u].speed;
+        }
+
+        value = Bench_Speed[t] - resolveSpeed[t];
+        value = (value < 0) ? -value : value;
+        maxDeviation = (value > maxDeviation) ? value : maxDeviation;
+    }
+
+    printf("S-curve setpoint generator, %u ticks of %u ms, %u commands/configs\n",
+           (unsigned)BENCH_TICKS, (unsigned)SETPOINTGEN_TICK_MS, (unsigned)Bench_EventCount);
+    printf("  precomputed segments : %6.2f ns per tick\n", (double)precomputedNs / BENCH_TICKS);
+    printf("  re-solve every tick  : %6.2f ns per tick (x%.1f)\n", (double)resolveNs / BENCH_TICKS,
+           (double)resolveNs / (double)precomputedNs);
+    printf("  peak acceleration    : %5.1f %% of ACCELERATION\n", maxAccelRatio / 10.0);
+    printf("  peak jerk            : %5.1f %% of the jerk limit (command ticks excluded)\n",
+           maxJerkRatio / 10.0);
+    printf("  settled ramps        : %u, %u exactly on target\n", (unsigned)settled, (unsigned)reached);
+    printf("  precomputed vs re-solve: max %d x 0.1 rpm apart\n", (int)maxDeviation);
+    return 0;
+}
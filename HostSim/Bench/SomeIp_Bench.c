@@ -0,0 +1,181 @@
+/*
+ * SomeIp_Bench.c - SOME/IP Serialization and Throughput Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Compares the motor status on the Ethernet channel with the
+ *              CAN path. First the host cost of one MOTOR_STATUS through
+ *              serialization and deserialization: SOME/IP on the in-memory
+ *              driver against CanSM with E2E on the unpaced loopback bus.
+ *              Then the messages per second through UDP loopback and UNIX
+ *              datagram sockets, one message per round trip and in bursts.
+ *              Finally the messages per second each wire can carry: CAN-FD
+ *              at the configured bit rates against 100 Mbit/s Ethernet.
+ */
+
+#include <stdio.h>
+
+#include "Det.h"
+#include "Tm.h"
+#include "SimTime.h"
+#include "ComM.h"
+#include "CanSM.h"
+#include "CanFdHw.h"
+#include "E2E.h"
+#include "SomeIp.h"
+#include "EthHw.h"
+#include "Bench.h"
+
+#define BENCH_MESSAGES               (1u << 20)
+#define BENCH_SOCKET_MESSAGES        (1u << 18)
+#define BENCH_BURST                  (32u)
+#define BENCH_UNIX_PATH              "unix:/tmp/someip_bench.sock"
+
+/* Ethernet II header and FCS, IPv4 and UDP headers; minimum frame, and
+ * preamble, start delimiter and inter-frame gap */
+#define BENCH_ETH_OVERHEAD           (14u + 4u + 20u + 8u)
+#define BENCH_ETH_MIN_FRAME          (64u)
+#define BENCH_ETH_GAP                (8u + 12u)
+#define BENCH_ETH_BITRATE            (100000000u)
+
+static volatile uint32 Bench_Sink;
+
+static void Bench_Row(const char *name, uint32 messages, uint32 received, uint64 elapsed)
+{
+    printf("  %-30s %9.1f %12.0f %10u\n", name, (double)elapsed / messages,
+           (elapsed != 0u) ? (double)received * 1e9 / (double)elapsed : 0.0, (unsigned)(messages - received));
+}
+
+/**
+ * @brief   Host cost of one MOTOR_STATUS, sent and read back, without a socket
+ */
+static void Bench_Serialization(void)
+{
+    uint32 received = 0u;
+    uint16 speed;
+    sint16 torque;
+    uint8 fault;
+    uint64 start;
+
+    printf("MOTOR_STATUS serialized and deserialized, host time\n");
+    printf("  %-30s %9s %12s %10s\n", "path", "ns/msg", "msg/s", "lost");
+
+    EthHw_Configure("mem", "mem");
+    SomeIp_Init();
+    start = Bench_NowNs();
+    for (uint32 n = 0; n < BENCH_MESSAGES; n++)
+    {
+        (void)SomeIp_SendMotorStatus((uint16)n, (sint16)-100, (uint8)(n & 0x7u));
+        SomeIp_MainFunction();
+        if (SomeIp_GetMotorStatus(&speed, &torque, &fault) == E_OK)
+        {
+            Bench_Sink += speed;
+            received++;
+        }
+    }
+    Bench_Row("SOME/IP, 21 bytes, no E2E", BENCH_MESSAGES, received, Bench_NowNs() - start);
+
+    /* CanSM at full communication on the loopback bus, not paced */
+    Det_Init();
+    SimTime_Init();
+    Tm_Init();
+    ComM_Init();
+    CanSM_Init();
+    E2E_Init();
+    ComM_MainFunction();
+    CanSM_MainFunction();
+
+    received = 0u;
+    start = Bench_NowNs();
+    for (uint32 n = 0; n < BENCH_MESSAGES; n++)
+    {
+        CanSM_SendMotorStatus((uint16)n, (sint16)-100, (uint8)(n & 0x7u));
+        if (CanSM_GetMotorStatus(&speed, &torque, &fault) == E_OK)
+        {
+            Bench_Sink += speed;
+            received++;
+        }
+    }
+    Bench_Row("CAN-FD, 8 bytes, E2E CRC16", BENCH_MESSAGES, received, Bench_NowNs() - start);
+}
+
+/**
+ * @brief   MOTOR_STATUS through a datagram socket to the same node
+ * @param   burst  Messages sent before SomeIp_MainFunction reads them
+ */
+static void Bench_Socket(const char *name, const char *address, uint32 burst)
+{
+    SomeIp_StatisticsType before;
+    SomeIp_StatisticsType after;
+    char row[40];
+    uint64 start;
+
+    EthHw_Configure(address, address);
+    SomeIp_Init();
+    (void)SomeIp_GetStatistics(&before);
+    if (SomeIp_SendMotorStatus(0u, 0, 0u) != E_OK)
+    {
+        printf("  %-30s unavailable\n", name);
+        return;
+    }
+    SomeIp_MainFunction();
+
+    start = Bench_NowNs();
+    for (uint32 n = 0; n < BENCH_SOCKET_MESSAGES; n += burst)
+    {
+        for (uint32 b = 0; b < burst; b++)
+        {
+            (void)SomeIp_SendMotorStatus((uint16)(n + b), (sint16)-100, 0u);
+        }
+        SomeIp_MainFunction();
+        (void)SomeIp_GetMotorStatus(NULL_PTR, NULL_PTR, NULL_PTR);
+    }
+    (void)SomeIp_GetStatistics(&after);
+
+    (void)snprintf(row, sizeof(row), "%s, burst %u", name, (unsigned)burst);
+    Bench_Row(row, BENCH_SOCKET_MESSAGES, after.rxMessages - before.rxMessages - 1u, Bench_NowNs() - start);
+    EthHw_Close();
+}
+
+/**
+ * @brief   Messages per second each wire carries, one message per frame
+ */
+static void Bench_Wire(void)
+{
+    CanSM_FdFrameType frame = {0};
+    uint32 canNs;
+    uint32 ethBytes;
+    uint32 ethNs;
+
+    frame.id = 0x101u;
+    frame.length = 8u;
+    frame.brs = TRUE;
+    canNs = CanFdHw_FrameDurationNs(&frame, CANFDHW_NOMINAL_BAUDRATE, CANFDHW_DATA_BAUDRATE);
+
+    ethBytes = BENCH_ETH_OVERHEAD + SOMEIP_HEADER_LENGTH + SomeIp_MessageConfig[SOMEIP_MSG_MOTOR_STATUS].payloadLength;
+    ethBytes = ((ethBytes < BENCH_ETH_MIN_FRAME) ? BENCH_ETH_MIN_FRAME : ethBytes) + BENCH_ETH_GAP;
+    ethNs = (uint32)((uint64)ethBytes * 8u * 1000000000u / BENCH_ETH_BITRATE);
+
+    printf("MOTOR_STATUS on the wire, bus fully loaded\n");
+    printf("  %-30s %9s %12s\n", "wire", "ns/msg", "msg/s");
+    printf("  %-30s %9u %12.0f\n", "CAN-FD 500 kbit/s, 2 Mbit/s", (unsigned)canNs, 1e9 / canNs);
+    printf("  %-30s %9u %12.0f\n", "Ethernet 100 Mbit/s, UDP", (unsigned)ethNs, 1e9 / ethNs);
+}
+
+int main(void)
+{
+    Det_Init();
+
+    Bench_Serialization();
+
+    printf("MOTOR_STATUS through a datagram socket, host time\n");
+    printf("  %-30s %9s %12s %10s\n", "socket", "ns/msg", "msg/s", "lost");
+    Bench_Socket("UDP loopback", "udp:30501", 1u);
+    Bench_Socket("UDP loopback", "udp:30501", BENCH_BURST);
+    Bench_Socket("UNIX datagram", BENCH_UNIX_PATH, 1u);
+    Bench_Socket("UNIX datagram", BENCH_UNIX_PATH, BENCH_BURST);
+
+    Bench_Wire();
+    return 0;
+}
@@ -0,0 +1,246 @@
+/*
+ * SwTmr_Bench.c - Software Timer Wheel Cost and Accuracy Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Runs sets of periodic timers with random periods of
+ *              100 ms to 10 s on the timing wheel and on a baseline that
+ *              counts every timer down on every tick, and reports the cost
+ *              per tick. The wheel's tick cost grows only with the number
+ *              of expiries, the baseline's with the number of timers.
+ *              Then measures start/stop cost and checks that many one-shot
+ *              timers with random delays, restarts and stops fire on
+ *              exactly their due tick.
+ */
+
+#include <stdio.h>
+
+#include "Det.h"
+#include "SwTmr.h"
+#include "Bench.h"
+
+#define BENCH_MAX_TIMERS             (4096u)
+#define BENCH_TICKS                  (100000u)
+#define BENCH_MIN_PERIOD             (100u)
+#define BENCH_MAX_PERIOD             (10000u)
+#define BENCH_CALLS                  (1u << 22)
+#define BENCH_CHECK_TIMERS           (BENCH_MAX_TIMERS)
+#define BENCH_CHECK_MAX_DELAY        (1u << 20)
+
+/* Baseline: count down every timer on every tick */
+typedef struct {
+    uint32 remaining;
+    uint32 period;
+    SwTmr_CallbackType callback;
+    uint32 arg;
+} Bench_CountdownType;
+
+static const uint32 Bench_TimerCounts[] = {8u, 64u, 512u, 4096u};
+
+static SwTmr_TimerType Bench_Timers[BENCH_MAX_TIMERS];
+static Bench_CountdownType Bench_Countdown[BENCH_MAX_TIMERS];
+static uint32 Bench_Periods[BENCH_MAX_TIMERS];
+static uint32 Bench_Due[BENCH_CHECK_TIMERS];
+static uint32 Bench_Expiries;
+static uint32 Bench_Expected;
+static uint32 Bench_Early;
+static uint32 Bench_Late;
+
+static uint32 Bench_Random(void)
+{
+    static uint32 state = 0x9E3779B9u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static void Bench_Count(uint32 arg)
+{
+    (void)arg;
+    Bench_Expiries++;
+}
+
+static void Bench_CountdownTick(uint32 count)
+{
+    for (uint32 i = 0; i < count; i++)
+    {
+        if (Bench_Countdown[i].remaining != 0u)
+        {
+            Bench_Countdown[i].remaining--;
+            if (Bench_Countdown[i].remaining == 0u)
+            {
+                Bench_Countdown[i].remaining = Bench_Countdown[i].period;
+                Bench_Countdown[i].callback(Bench_Countdown[i].arg);
+            }
+        }
+    }
+}
+
+static void Bench_TickCost(void)
+{
+    uint64 start;
+    double wheelNs;
+    double baselineNs;
+
+    printf("Cost per 1 ms tick, periodic timers of %u..%u ms, %u ticks\n",
+           (unsigned)BENCH_MIN_PERIOD, (unsigned)BENCH_MAX_PERIOD, (unsigned)BENCH_TICKS);
+    printf("  %8s %14s %14s %14s\n", "timers", "wheel [ns]", "countdown [ns]", "expiries/tick");
+    for (uint32 c = 0; c < sizeof(Bench_TimerCounts) / sizeof(Bench_TimerCounts[0]); c++)
+    {
+        uint32 count = Bench_TimerCounts[c];
+
+        for (uint32 i = 0; i < count; i++)
+        {
+            Bench_Periods[i] = BENCH_MIN_PERIOD + Bench_Random() % (BENCH_MAX_PERIOD - BENCH_MIN_PERIOD);
+            SwTmr_Setup(&Bench_Timers[i], Bench_Count, i);
+            (void)SwTmr_Start(&Bench_Timers[i], Bench_Periods[i], Bench_Periods[i]);
+            Bench_Countdown[i].remaining = Bench_Periods[i];
+            Bench_Countdown[i].period = Bench_Periods[i];
+            Bench_Countdown[i].callback = Bench_Count;
+            Bench_Countdown[i].arg = i;
+        }
+
+        Bench_Expiries = 0u;
+        start = Bench_NowNs();
+        for (uint32 t = 0; t < BENCH_TICKS; t++)
+        {
+            SwTmr_MainFunction();
+        }
+        wheelNs = (double)(Bench_NowNs() - start) / BENCH_TICKS;
+
+        start = Bench_NowNs();
+        for (uint32 t = 0; t < BENCH_TICKS; t++)
+        {
+            Bench_CountdownTick(count);
+        }
+        baselineNs = (double)(Bench_NowNs() - start) / BENCH_TICKS;
+
+        printf("  %8u %14.1f %14.1f %14.2f\n", (unsigned)count, wheelNs, baselineNs,
+               (double)Bench_Expiries / (2.0 * BENCH_TICKS));
+
+        for (uint32 i = 0; i < count; i++)
+        {
+            SwTmr_Stop(&Bench_Timers[i]);
+        }
+    }
+}
+
+static void Bench_StartStopCost(void)
+{
+    uint64 start;
+
+    for (uint32 i = 0; i < BENCH_MAX_TIMERS; i++)
+    {
+        SwTmr_Setup(&Bench_Timers[i], Bench_Count, i);
+        Bench_Periods[i] = 1u + Bench_Random() % BENCH_CHECK_MAX_DELAY;
+    }
+
+    start = Bench_NowNs();
+    for (uint32 n = 0; n < BENCH_CALLS; n++)
+    {
+        uint32 i = n & (BENCH_MAX_TIMERS - 1u);
+        (void)SwTmr_Start(&Bench_Timers[i], Bench_Periods[i], 0u);
+    }
+    printf("  %-36s %7.2f ns/call\n", "SwTmr_Start (running timers restarted)",
+           (double)(Bench_NowNs() - start) / BENCH_CALLS);
+
+    start = Bench_NowNs();
+    for (uint32 n = 0; n < BENCH_CALLS; n++)
+    {
+        uint32 i = n & (BENCH_MAX_TIMERS - 1u);
+        SwTmr_Stop(&Bench_Timers[i]);
+        (void)SwTmr_Start(&Bench_Timers[i], Bench_Periods[i], 0u);
+    }
+    printf("  %-36s %7.2f ns/call\n", "SwTmr_Stop + SwTmr_Start",
+           (double)(Bench_NowNs() - start) / BENCH_CALLS);
+
+    for (uint32 i = 0; i < BENCH_MAX_TIMERS; i++)
+    {
+        SwTmr_Stop(&Bench_Timers[i]);
+    }
+}
+
+static void Bench_Check(uint32 arg)
+{
+    uint32 now = SwTmr_GetTicks();
+
+    Bench_Expiries++;
+    if (now < Bench_Due[arg])
+    {
+        Bench_Early++;
+    }
+    else if (now > Bench_Due[arg])
+    {
+        Bench_Late++;
+    }
+    Bench_Due[arg] = 0u;
+
+    /* Every eighth expiry restarts another timer */
+    if ((Bench_Random() & 7u) == 0u)
+    {
+        uint32 other = Bench_Random() % BENCH_CHECK_TIMERS;
+        uint32 delay = 1u + Bench_Random() % 5000u;
+        if (Bench_Due[other] == 0u)
+        {
+            Bench_Expected++;
+        }
+        Bench_Due[other] = now + delay;
+        (void)SwTmr_Start(&Bench_Timers[other], delay, 0u);
+    }
+}
+
+static void Bench_Accuracy(void)
+{
+    uint32 stopped = 0u;
+    uint32 now = SwTmr_GetTicks();
+
+    Bench_Expiries = 0u;
+    Bench_Expected = 0u;
+    for (uint32 i = 0; i < BENCH_CHECK_TIMERS; i++)
+    {
+        uint32 delay = 1u + Bench_Random() % BENCH_CHECK_MAX_DELAY;
+        SwTmr_Setup(&Bench_Timers[i], Bench_Check, i);
+        Bench_Due[i] = now + delay;
+        (void)SwTmr_Start(&Bench_Timers[i], delay, 0u);
+        Bench_Expected++;
+    }
+
+    /* Stop every sixteenth timer half way */
+    for (uint32 t = 0; t < BENCH_CHECK_MAX_DELAY + 5000u; t++)
+    {
+        SwTmr_MainFunction();
+        if (t == BENCH_CHECK_MAX_DELAY / 2u)
+        {
+            for (uint32 i = 0; i < BENCH_CHECK_TIMERS; i += 16u)
+            {
+                if (SwTmr_IsRunning(&Bench_Timers[i]) == TRUE)
+                {
+                    SwTmr_Stop(&Bench_Timers[i]);
+                    Bench_Due[i] = 0u;
+                    stopped++;
+                }
+            }
+        }
+    }
+
+    printf("Accuracy, %u one-shot timers up to %u ticks, restarts from callbacks\n",
+           (unsigned)BENCH_CHECK_TIMERS, (unsigned)BENCH_CHECK_MAX_DELAY);
+    printf("  expected %u, stopped %u, fired %u, early %u, late %u\n",
+           (unsigned)Bench_Expected, (unsigned)stopped, (unsigned)Bench_Expiries,
+           (unsigned)Bench_Early, (unsigned)Bench_Late);
+}
+
+int main(void)
+{
+    Det_Init();
+    SwTmr_Init();
+
+    Bench_TickCost();
+    printf("Cost per call, %u timers\n", (unsigned)BENCH_MAX_TIMERS);
+    Bench_StartStopCost();
+    Bench_Accuracy();
+
+    return 0;
+}
@@ -0,0 +1,220 @@
+/*
+ * Tm_Bench.c - Time Service Read Cost and Consistency Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Measures the cost of the lock-free 64-bit reads against a
+ *              read under a spinlock, the host stand-in for an interrupt
+ *              lock plus inter-core lock. Then a timer thread advances a
+ *              fast-wrapping counter and runs Tm_MainFunction while
+ *              reader threads check that every read is monotonic. The same
+ *              check runs on an unprotected extension (upper word and
+ *              timer value read without the sequence counter) to show
+ *              what the seqlock prevents. On a single-core host the
+ *              threads only interleave at preemption, so a torn read of
+ *              the unprotected extension is rare there.
+ *
+ *              The timer register is a volatile word provided here, so a
+ *              timer read is a single load as on the STM.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "Det.h"
+#include "Tm.h"
+#include "Bench.h"
+
+#define BENCH_CALLS                  (1u << 24)
+#define BENCH_READERS                (3u)
+#define BENCH_STRESS_NS              (2000000000u)
+
+/* Counter step of the timer thread: wraps every 256 steps, updated every 16 */
+#define BENCH_STEP                   (0x01000000u)
+#define BENCH_UPDATE_STEPS           (16u)
+
+typedef struct {
+    uint64 reads;
+    uint64 violations;
+    uint64 naiveReads;
+    uint64 naiveViolations;
+} Bench_ReaderType;
+
+/* Simulated timer register */
+static volatile uint32 Bench_Counter = 0u;
+
+/* Baseline state, protected by the spinlock */
+static volatile uint32 Bench_Lock = 0u;
+static uint32 Bench_LockedHigh = 0u;
+static uint32 Bench_LockedLow = 0u;
+
+/* Unprotected extension, written by the timer thread */
+static volatile uint32 Bench_NaiveHigh = 0u;
+static volatile uint32 Bench_NaiveLow = 0u;
+
+static volatile boolean Bench_Stop = FALSE;
+static volatile uint64 Bench_Sink;
+static Bench_ReaderType Bench_Readers[BENCH_READERS];
+
+uint32 TmHw_GetCounter(void)
+{
+    return Bench_Counter;
+}
+
+static uint64 Bench_LockedGetTicks(void)
+{
+    uint32 high;
+    uint32 now;
+
+    while (__atomic_exchange_n(&Bench_Lock, 1u, __ATOMIC_ACQUIRE) != 0u)
+    {
+    }
+    high = Bench_LockedHigh;
+    now = Bench_Counter;
+    if (now < Bench_LockedLow)
+    {
+        high++;
+    }
+    __atomic_store_n(&Bench_Lock, 0u, __ATOMIC_RELEASE);
+
+    return ((uint64)high << 32) | now;
+}
+
+static uint64 Bench_NaiveGetTicks(void)
+{
+    uint32 high = Bench_NaiveHigh;
+    uint32 low = Bench_NaiveLow;
+    uint32 now = Bench_Counter;
+
+    if (now < low)
+    {
+        high++;
+    }
+    return ((uint64)high << 32) | now;
+}
+
+static void Bench_NaiveUpdate(void)
+{
+    uint32 now = Bench_Counter;
+
+    if (now < Bench_NaiveLow)
+    {
+        Bench_NaiveHigh = Bench_NaiveHigh + 1u;
+    }
+    Bench_NaiveLow = now;
+}
+
+#define BENCH_TIME(name, expr)                                              \
+    do {                                                                    \
+        uint64 acc = 0u;                                                    \
+        uint64 startNs = Bench_NowNs();                                     \
+        uint64 startCycles = Bench_Cycles();                                \
+        for (uint32 n = 0; n < BENCH_CALLS; n++)                            \
+        {                                                                   \
+            acc += (expr);                                                  \
+        }                                                                   \
+        uint64 cycles = Bench_Cycles() - startCycles;                       \
+        Bench_PrintCost(name, 30, Bench_NowNs() - startNs, cycles,          \
+                        BENCH_CALLS, "call");                               \
+        Bench_Sink = acc;                                                   \
+    } while (0)
+
+static void *Bench_TimerThread(void *arg)
+{
+    uint32 steps = 0u;
+
+    (void)arg;
+    while (Bench_Stop == FALSE)
+    {
+        Bench_Counter = Bench_Counter + BENCH_STEP;
+        steps++;
+        if ((steps % BENCH_UPDATE_STEPS) == 0u)
+        {
+            Tm_MainFunction();
+            Bench_NaiveUpdate();
+        }
+    }
+    return NULL_PTR;
+}
+
+static void *Bench_ReaderThread(void *arg)
+{
+    Bench_ReaderType *reader = (Bench_ReaderType *)arg;
+    uint64 last = 0u;
+    uint64 naiveLast = 0u;
+    uint64 now;
+
+    while (Bench_Stop == FALSE)
+    {
+        now = Tm_GetTicks();
+        if (now < last)
+        {
+            reader->violations++;
+        }
+        last = now;
+        reader->reads++;
+
+        now = Bench_NaiveGetTicks();
+        if (now < naiveLast)
+        {
+            reader->naiveViolations++;
+        }
+        naiveLast = now;
+        reader->naiveReads++;
+    }
+    return NULL_PTR;
+}
+
+static void Bench_Stress(void)
+{
+    pthread_t timer;
+    pthread_t readers[BENCH_READERS];
+    struct timespec duration = {BENCH_STRESS_NS / 1000000000u, BENCH_STRESS_NS % 1000000000u};
+    Bench_ReaderType total = {0u, 0u, 0u, 0u};
+
+    (void)pthread_create(&timer, NULL_PTR, Bench_TimerThread, NULL_PTR);
+    for (uint32 r = 0; r < BENCH_READERS; r++)
+    {
+        (void)pthread_create(&readers[r], NULL_PTR, Bench_ReaderThread, &Bench_Readers[r]);
+    }
+    (void)nanosleep(&duration, NULL_PTR);
+    Bench_Stop = TRUE;
+    (void)pthread_join(timer, NULL_PTR);
+    for (uint32 r = 0; r < BENCH_READERS; r++)
+    {
+        (void)pthread_join(readers[r], NULL_PTR);
+        total.reads += Bench_Readers[r].reads;
+        total.violations += Bench_Readers[r].violations;
+        total.naiveReads += Bench_Readers[r].naiveReads;
+        total.naiveViolations += Bench_Readers[r].naiveViolations;
+    }
+
+    printf("Consistency, %u readers against a timer wrapping every %u steps, %.0f s\n",
+           (unsigned)BENCH_READERS, (unsigned)(0x100000000ull / BENCH_STEP),
+           (double)BENCH_STRESS_NS / 1e9);
+    printf("  %-30s %12llu reads %8llu backward steps\n", "Tm_GetTicks",
+           (unsigned long long)total.reads, (unsigned long long)total.violations);
+    printf("  %-30s %12llu reads %8llu backward steps\n", "unprotected extension",
+           (unsigned long long)total.naiveReads, (unsigned long long)total.naiveViolations);
+    printf("  %-30s %12llu wraps\n", "final 64-bit count",
+           (unsigned long long)(Tm_GetTicks() >> 32));
+}
+
+int main(void)
+{
+    Det_Init();
+    Tm_Init();
+
+    printf("Cost per call (%u calls each):\n", (unsigned)BENCH_CALLS);
+    BENCH_TIME("Tm_GetTicks32", Tm_GetTicks32());
+    BENCH_TIME("Tm_GetTicks", Tm_GetTicks());
+    BENCH_TIME("Tm_GetTimeNs", Tm_GetTimeNs());
+    BENCH_TIME("spinlocked 64-bit read", Bench_LockedGetTicks());
+    BENCH_TIME("Tm_MainFunction", (Tm_MainFunction(), 0u));
+
+    Bench_Stress();
+
+    return 0;
+}
@@ -0,0 +1,274 @@
+/*
+ * WdgM_Bench.c - Watchdog Manager Overhead and Fault Detection Benchmark
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Runs the production supervision configuration on the
+ *              simulated timeline with one injected fault per scenario and
+ *              reports the time from the fault to its detection and to the
+ *              watchdog reset, then measures the cost of
+ *              WdgM_CheckpointReached and WdgM_MainFunction on the host.
+ *
+ *              Simulated schedule: control step every 50 us (START, then
+ *              END after its execution time), measurement every 10 ms,
+ *              main loop every 100 us, WdgM_MainFunction every 1 ms. The
+ *              watchdog times out 5 ms after the last trigger. Each
+ *              scenario runs in its own process, since WdgM latches its
+ *              global status until reset.
+ */
+
+#include <stdio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Det.h"
+#include "WdgM.h"
+#include "WdgM_Cfg.h"
+#include "WdgHw.h"
+#include "Tm.h"
+#include "SimTime.h"
+#include "Bench.h"
+
+#define BENCH_CALLS                  (1u << 24)
+
+#define BENCH_US                     (SIMTIME_TICKS_PER_SECOND / 1000000u)
+#define BENCH_CONTROL_PERIOD         (50u * BENCH_US)
+#define BENCH_CONTROL_EXEC           (10u * BENCH_US)
+#define BENCH_OVERRUN_EXEC           (30u * BENCH_US)
+#define BENCH_MEASUREMENT_PERIOD     (10000u * BENCH_US)
+#define BENCH_BACKGROUND_PERIOD      (100u * BENCH_US)
+#define BENCH_MAIN_PERIOD            (WDGM_MAIN_FUNCTION_PERIOD_MS * 1000u * BENCH_US)
+#define BENCH_WATCHDOG_TIMEOUT       (5000u * BENCH_US)
+#define BENCH_FAULT_TICK             (100000u * BENCH_US)
+#define BENCH_RUN_TICKS              (300000u * BENCH_US)
+
+#define TICKS_TO_MS(t)               ((double)(t) / (SIMTIME_TICKS_PER_SECOND / 1000u))
+
+typedef enum {
+    BENCH_FAULT_NONE,
+    BENCH_FAULT_CONTROL_STALL,       /* Control step stops */
+    BENCH_FAULT_DEADLINE_OVERRUN,    /* One control step takes 30 us */
+    BENCH_FAULT_FLOW,                /* One control step skips its END checkpoint */
+    BENCH_FAULT_MEASUREMENT_FAST,    /* Measurement runs at 200 Hz */
+    BENCH_FAULT_BACKGROUND_HANG,     /* Main loop stops */
+    BENCH_FAULT_ERROR_MODE           /* Error state entered, error loop runs */
+} Bench_FaultType;
+
+typedef struct {
+    const char *name;
+    Bench_FaultType fault;
+} Bench_ScenarioType;
+
+static const Bench_ScenarioType Bench_Scenarios[] = {
+    {"no fault", BENCH_FAULT_NONE},
+    {"control step stalls", BENCH_FAULT_CONTROL_STALL},
+    {"control deadline overrun", BENCH_FAULT_DEADLINE_OVERRUN},
+    {"control END skipped", BENCH_FAULT_FLOW},
+    {"measurement too fast", BENCH_FAULT_MEASUREMENT_FAST},
+    {"main loop hangs", BENCH_FAULT_BACKGROUND_HANG},
+    {"error mode (no fault)", BENCH_FAULT_ERROR_MODE}
+};
+
+static Bench_FaultType Bench_Fault;
+static boolean Bench_Faulted;
+static boolean Bench_ErrorMode;
+static uint64 Bench_DetectTick;
+
+static boolean Bench_FaultActive(Bench_FaultType fault)
+{
+    return ((Bench_Fault == fault) && (SimTime_Now() >= BENCH_FAULT_TICK)) ? TRUE : FALSE;
+}
+
+/* Faults that happen once are reported once */
+static boolean Bench_FaultOnce(Bench_FaultType fault)
+{
+    if ((Bench_FaultActive(fault) == TRUE) && (Bench_Faulted == FALSE))
+    {
+        Bench_Faulted = TRUE;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static void Bench_ControlEnd(uint32 arg)
+{
+    (void)arg;
+    WdgM_CheckpointReached(WDGM_SE_CONTROL, WDGM_CP_CONTROL_END);
+}
+
+static void Bench_ControlStart(uint32 arg)
+{
+    uint64 now = SimTime_Now();
+    uint32 exec = BENCH_CONTROL_EXEC;
+
+    (void)arg;
+    if ((Bench_ErrorMode == TRUE) || (Bench_FaultActive(BENCH_FAULT_CONTROL_STALL) == TRUE))
+    {
+        return;
+    }
+
+    WdgM_CheckpointReached(WDGM_SE_CONTROL, WDGM_CP_CONTROL_START);
+    if (Bench_FaultOnce(BENCH_FAULT_DEADLINE_OVERRUN) == TRUE)
+    {
+        exec = BENCH_OVERRUN_EXEC;
+    }
+    if (Bench_FaultOnce(BENCH_FAULT_FLOW) == FALSE)
+    {
+        (void)SimTime_Schedule(now + exec, Bench_ControlEnd, 0u);
+    }
+    (void)SimTime_Schedule(now + BENCH_CONTROL_PERIOD, Bench_ControlStart, 0u);
+}
+
+static void Bench_Measurement(uint32 arg)
+{
+    uint64 period = BENCH_MEASUREMENT_PERIOD;
+
+    (void)arg;
+    if (Bench_ErrorMode == TRUE)
+    {
+        return;
+    }
+    WdgM_CheckpointReached(WDGM_SE_MEASUREMENT, WDGM_CP_MEASUREMENT);
+    if (Bench_FaultActive(BENCH_FAULT_MEASUREMENT_FAST) == TRUE)
+    {
+        period /= 2u;
+    }
+    (void)SimTime_Schedule(SimTime_Now() + period, Bench_Measurement, 0u);
+}
+
+static void Bench_Background(uint32 arg)
+{
+    (void)arg;
+    if (Bench_FaultActive(BENCH_FAULT_BACKGROUND_HANG) == TRUE)
+    {
+        return;
+    }
+    if (Bench_ErrorMode == TRUE)
+    {
+        WdgM_CheckpointReached(WDGM_SE_ERROR_HANDLER, WDGM_CP_ERROR_LOOP);
+    }
+    else
+    {
+        WdgM_CheckpointReached(WDGM_SE_BACKGROUND, WDGM_CP_BACKGROUND_LOOP);
+    }
+    (void)SimTime_Schedule(SimTime_Now() + BENCH_BACKGROUND_PERIOD, Bench_Background, 0u);
+}
+
+static void Bench_MainFunction(uint32 arg)
+{
+    WdgM_GlobalStatusType status;
+
+    (void)arg;
+    if (Bench_FaultOnce(BENCH_FAULT_ERROR_MODE) == TRUE)
+    {
+        Bench_ErrorMode = TRUE;
+        (void)WdgM_SetMode(WDGM_MODE_ERROR);
+    }
+
+    WdgM_MainFunction();
+    (void)WdgM_GetGlobalStatus(&status);
+    if ((status != WDGM_GLOBAL_STATUS_OK) && (Bench_DetectTick == 0u))
+    {
+        Bench_DetectTick = SimTime_Now();
+    }
+    (void)SimTime_Schedule(SimTime_Now() + BENCH_MAIN_PERIOD, Bench_MainFunction, 0u);
+}
+
+static void Bench_RunScenario(const Bench_ScenarioType *scenario)
+{
+    Bench_Fault = scenario->fault;
+
+    SimTime_Init();
+    Det_Init();
+    Tm_Init();
+    WdgM_Init();
+    WdgHw_SimInit(BENCH_WATCHDOG_TIMEOUT);
+    (void)WdgM_SetMode(WDGM_MODE_RUN);
+
+    (void)SimTime_Schedule(BENCH_CONTROL_PERIOD, Bench_ControlStart, 0u);
+    (void)SimTime_Schedule(BENCH_MEASUREMENT_PERIOD, Bench_Measurement, 0u);
+    (void)SimTime_Schedule(BENCH_BACKGROUND_PERIOD, Bench_Background, 0u);
+    (void)SimTime_Schedule(BENCH_MAIN_PERIOD, Bench_MainFunction, 0u);
+    SimTime_Advance(BENCH_RUN_TICKS);
+
+    printf("  %-26s %7u %7u", scenario->name, (unsigned)WdgHw_SimGetTriggers(),
+           (unsigned)WdgHw_SimGetResets());
+    if (Bench_DetectTick != 0u)
+    {
+        printf(" %11.2f", TICKS_TO_MS(Bench_DetectTick - BENCH_FAULT_TICK));
+    }
+    else
+    {
+        printf(" %11s", "-");
+    }
+    if (WdgHw_SimGetResets() > 0u)
+    {
+        printf(" %11.2f", TICKS_TO_MS(WdgHw_SimGetResetTick() - BENCH_FAULT_TICK));
+    }
+    else
+    {
+        printf(" %11s", "-");
+    }
+    printf("\n");
+    (void)fflush(stdout);
+}
+
+#define BENCH_TIME(name, calls, body)                                       \
+    do {                                                                    \
+        uint64 startNs = Bench_NowNs();                                     \
+        uint64 startCycles = Bench_Cycles();                                \
+        for (uint32 n = 0; n < (calls); n++)                                \
+        {                                                                   \
+            body;                                                           \
+        }                                                                   \
+        uint64 cycles = Bench_Cycles() - startCycles;                       \
+        Bench_PrintCost(name, 40, Bench_NowNs() - startNs, cycles,          \
+                        (calls), "call");                                   \
+    } while (0)
+
+/* Runs in the parent after the scenarios; the watchdog model is not started */
+static void Bench_Overhead(void)
+{
+    SimTime_Init();
+    Det_Init();
+    Tm_Init();
+    WdgM_Init();
+    (void)WdgM_SetMode(WDGM_MODE_RUN);
+
+    printf("Cost per call (%u calls each):\n", (unsigned)BENCH_CALLS);
+    BENCH_TIME("checkpoint, alive only", BENCH_CALLS,
+               WdgM_CheckpointReached(WDGM_SE_BACKGROUND, WDGM_CP_BACKGROUND_LOOP));
+    BENCH_TIME("checkpoint, alive + flow + deadline", BENCH_CALLS,
+               WdgM_CheckpointReached(WDGM_SE_CONTROL, (uint8)(n & 1u)));
+    BENCH_TIME("checkpoint, deactivated entity", BENCH_CALLS,
+               WdgM_CheckpointReached(WDGM_SE_ERROR_HANDLER, WDGM_CP_ERROR_LOOP));
+    BENCH_TIME("main function, run mode", BENCH_CALLS / 16u, WdgM_MainFunction());
+}
+
+int main(void)
+{
+    pid_t pid;
+
+    printf("Fault detection, fault injected at %.0f ms, watchdog timeout %.0f ms\n",
+           TICKS_TO_MS(BENCH_FAULT_TICK), TICKS_TO_MS(BENCH_WATCHDOG_TIMEOUT));
+    printf("  %-26s %7s %7s %11s %11s\n", "scenario", "trigger", "resets", "detect [ms]", "reset [ms]");
+    (void)fflush(stdout);
+    for (uint32 s = 0; s < sizeof(Bench_Scenarios) / sizeof(Bench_Scenarios[0]); s++)
+    {
+        pid = fork();
+        if (pid == 0)
+        {
+            Bench_RunScenario(&Bench_Scenarios[s]);
+            _exit(0);
+        }
+        if (pid > 0)
+        {
+            (void)waitpid(pid, NULL_PTR, 0);
+        }
+    }
+
+    Bench_Overhead();
+
+    return 0;
+}
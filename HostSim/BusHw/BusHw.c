@@ -0,0 +1,100 @@
+/*
+ * BusHw.c - Stand-in Buses for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains one frame ring per ComM channel. A
+ *              transmission copies the frame into the ring, as a bus
+ *              controller copies it into its message buffer, and stamps it
+ *              with the host time, so a bench can measure the time a frame
+ *              spent in the gateway.
+ */
+
+#include <time.h>
+
+#include "BusHw.h"
+
+/* Frame ring of a channel */
+typedef struct {
+    BusHw_FrameType frames[BUSHW_QUEUE_DEPTH];
+    uint32 head;
+    uint32 count;
+    BusHw_StatisticsType stats;
+} BusHw_ChannelType;
+
+/* Internal variables */
+static BusHw_ChannelType BusHw_Channels[COMM_MAX_CHANNELS];
+
+uint64 BusHw_NowNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64)ts.tv_sec * 1000000000u + (uint64)ts.tv_nsec;
+}
+
+void BusHw_Init(void)
+{
+    for (uint8 ch = 0; ch < COMM_MAX_CHANNELS; ch++)
+    {
+        BusHw_Channels[ch].head = 0u;
+        BusHw_Channels[ch].count = 0u;
+        BusHw_Channels[ch].stats.txFrames = 0u;
+        BusHw_Channels[ch].stats.txRejected = 0u;
+        BusHw_Channels[ch].stats.rxFrames = 0u;
+    }
+}
+
+Std_ReturnType BusHw_Transmit(uint8 channel, uint16 pduId, const uint8 *data, uint8 length)
+{
+    BusHw_ChannelType *bus;
+    BusHw_FrameType *frame;
+
+    if (channel >= COMM_MAX_CHANNELS || length > sizeof(frame->data))
+    {
+        return E_NOT_OK;
+    }
+    bus = &BusHw_Channels[channel];
+    if (bus->count == BUSHW_QUEUE_DEPTH)
+    {
+        bus->stats.txRejected++;
+        return E_NOT_OK;
+    }
+
+    frame = &bus->frames[(bus->head + bus->count) % BUSHW_QUEUE_DEPTH];
+    frame->pduId = pduId;
+    frame->length = length;
+    for (uint8 i = 0; i < length; i++)
+    {
+        frame->data[i] = data[i];
+    }
+    frame->stampNs = BusHw_NowNs();
+    bus->count++;
+    bus->stats.txFrames++;
+    return E_OK;
+}
+
+Std_ReturnType BusHw_Receive(uint8 channel, BusHw_FrameType *frame)
+{
+    BusHw_ChannelType *bus;
+
+    if (channel >= COMM_MAX_CHANNELS || BusHw_Channels[channel].count == 0u)
+    {
+        return E_NOT_OK;
+    }
+    bus = &BusHw_Channels[channel];
+    *frame = bus->frames[bus->head];
+    bus->head = (bus->head + 1u) % BUSHW_QUEUE_DEPTH;
+    bus->count--;
+    bus->stats.rxFrames++;
+    return E_OK;
+}
+
+void BusHw_GetStatistics(uint8 channel, BusHw_StatisticsType *stats)
+{
+    if (channel < COMM_MAX_CHANNELS)
+    {
+        *stats = BusHw_Channels[channel].stats;
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * BusHw.h - Stand-in Buses for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the transmit interface PduR expects
+ *              from the bus interfaces of the ComM channels, plus host-only
+ *              helpers. Each channel is a local frame queue standing in for
+ *              CAN, LIN, FlexRay and Ethernet; what is sent on a channel is
+ *              read back from the same queue.
+ */
+
+#ifndef BUSHW_H
+#define BUSHW_H
+
+#include "Std_Types.h"
+#include "ComM_Cfg.h"
+
+/* Frames a channel queues before it refuses to transmit */
+#define BUSHW_QUEUE_DEPTH            (256u)
+
+/* Frame on a stand-in bus */
+typedef struct {
+    uint16 pduId;
+    uint8 length;
+    uint8 data[64];
+    uint64 stampNs;              /* Host time of the transmit request */
+} BusHw_FrameType;
+
+/* Channel statistics */
+typedef struct {
+    uint32 txFrames;
+    uint32 txRejected;           /* Queue full */
+    uint32 rxFrames;
+} BusHw_StatisticsType;
+
+/* Bus interface used by PduR */
+Std_ReturnType BusHw_Transmit(uint8 channel, uint16 pduId, const uint8 *data, uint8 length);
+
+/* Host helpers */
+
+/* Empty all queues and reset the statistics */
+void BusHw_Init(void);
+
+/* Take the oldest frame of a channel; E_NOT_OK when empty */
+Std_ReturnType BusHw_Receive(uint8 channel, BusHw_FrameType *frame);
+
+void BusHw_GetStatistics(uint8 channel, BusHw_StatisticsType *stats);
+
+/* Host monotonic time, the time base of the frame stamps */
+uint64 BusHw_NowNs(void);
+
+#endif /* BUSHW_H */
@@ -0,0 +1,97 @@
+/*
+ * CanFdHw.h - CAN-FD Hardware Abstraction for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface CanSM expects from the
+ *              CAN-FD controller driver, plus host-only helpers shared
+ *              by the simulated bus backends
+ */
+
+#ifndef CANFDHW_H
+#define CANFDHW_H
+
+#include "Std_Types.h"
+#include "CanSM.h"
+
+/* Nominal (arbitration phase) bit rate of the simulated bus */
+#define CANFDHW_NOMINAL_BAUDRATE     (500000u)
+
+/* Default data phase bit rate, overridden by CanFdHw_SetBaudrate */
+#define CANFDHW_DATA_BAUDRATE        (2000000u)
+
+/* Bus statistics */
+typedef struct {
+    uint32 txFrames;        /* Frames accepted for transmission */
+    uint32 txRejected;      /* Transmit requests refused (queue full or bus busy) */
+    uint32 rxFrames;        /* Frames handed to the receiver */
+    uint32 rxOverruns;      /* Frames overwritten before the receiver read them */
+    uint64 payloadBytes;    /* Sum of frame lengths transmitted */
+    uint64 busTimeNs;       /* Bus time occupied by transmitted frames */
+} CanFdHw_StatisticsType;
+
+/* Driver interface used by CanSM */
+void CanFdHw_Init(void);
+void CanFdHw_SetBaudrate(uint32 baudrate);
+Std_ReturnType CanFdHw_Transmit(const CanSM_FdFrameType *frame);
+Std_ReturnType CanFdHw_TransmitGather(const CanSM_FdGatherType *frame);
+Std_ReturnType CanFdHw_Receive(CanSM_FdFrameType *frame);
+
+/* Leave bus-off; the controller sends again after 128 x 11 recessive bits */
+void CanFdHw_StartController(void);
+
+/* Host helpers */
+void CanFdHw_GetStatistics(CanFdHw_StatisticsType *stats);
+
+/**
+ * @brief   Time a frame occupies the bus
+ * @details Arbitration, ACK and EOF fields run at the nominal rate; with BRS
+ *          the control, data and CRC fields run at the data rate. Bit
+ *          stuffing is approximated as one stuff bit per ten bits.
+ */
+uint32 CanFdHw_FrameDurationNs(const CanSM_FdFrameType *frame, uint32 nominalBaudrate,
+                               uint32 dataBaudrate);
+
+/* Bus time of a frame given in pieces, as CanFdHw_FrameDurationNs */
+uint32 CanFdHw_GatherDurationNs(const CanSM_FdGatherType *frame, uint32 nominalBaudrate,
+                                uint32 dataBaudrate);
+
+/* Loopback backend: grant bus time for the next simulated interval */
+void CanFdHw_LoopbackGrantBusTime(uint32 ns);
+
+/* Transmit fault hook: TRUE makes the controller refuse the frame, as on
+ * an error or in bus-off */
+typedef boolean (*CanFdHw_SimTxFaultType)(const CanSM_FdGatherType *frame);
+
+/* Loopback backend: consult a fault hook on every transmission (NULL_PTR: none) */
+void CanFdHw_LoopbackSetTxFault(CanFdHw_SimTxFaultType fault);
+
+/**
+ * @brief   Loopback backend: take the controller to bus-off
+ * @details Transmission is refused until CanFdHw_StartController, and with
+ *          granted bus time for the 128 x 11 recessive bits after it.
+ *          CanSM is notified through CanSM_ControllerBusOff.
+ */
+void CanFdHw_LoopbackBusOff(void);
+
+/**
+ * @brief   Shared-memory backend: select the bus segment and pacing
+ * @details Must be called before CanFdHw_Init (i.e. before CanSM_Init).
+ *          Without this call the CANFDHW_SHM_NAME and CANFDHW_SHM_PACED
+ *          environment variables are used.
+ * @param   name   POSIX shared memory object name, e.g. "/canfdhw_bus0"
+ * @param   paced  TRUE to hold frames for their bit time on the bus
+ */
+void CanFdHw_ShmConfigure(const char *name, boolean paced);
+
+/* Shared-memory backend: node index of this process on the bus */
+uint32 CanFdHw_ShmGetNodeId(void);
+
+/* Shared-memory backend: send the pending frames and leave the bus, freeing the node slot */
+void CanFdHw_ShmClose(void);
+
+/* Shared-memory backend: remove the bus segment (last user) */
+void CanFdHw_ShmUnlink(const char *name);
+
+#endif /* CANFDHW_H */
@@ -0,0 +1,167 @@
+/*
+ * CanFdHw_Loopback.c - In-Process CAN-FD Loopback Bus
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains a single-process stand-in for the
+ *              CAN-FD controller: transmitted frames are queued and read
+ *              back by the same node. When bus time is granted with
+ *              CanFdHw_LoopbackGrantBusTime, transmission is limited to
+ *              what the configured bit rates can carry. The queue keeps
+ *              frames as compact CanBuf entries of the DLC class set by
+ *              CANFDHW_LOOPBACK_CLASS. Received frames and refused
+ *              transmissions pass the RecLog input points.
+ */
+
+#include <string.h>
+
+#include "CanFdHw.h"
+#include "CanBuf.h"
+#include "RecLog.h"
+
+/* Depth of the loopback queue */
+#define CANFDHW_LOOPBACK_DEPTH       (64u)
+
+/* Payload storage per queued frame; CanTp uses full 64-byte FD frames */
+#define CANFDHW_LOOPBACK_CLASS       (CANBUF_CLASS_64)
+
+/* Bus-off recovery: 128 occurrences of 11 recessive bits */
+#define CANFDHW_BUSOFF_RECOVERY_BITS (128u * 11u)
+
+/* Internal variables */
+static uint32 CanFdHw_Storage[CANBUF_QUEUE_WORDS(CANFDHW_LOOPBACK_DEPTH, CANFDHW_LOOPBACK_CLASS)];
+static CanBuf_QueueType CanFdHw_Queue;
+static uint32 CanFdHw_DataBaudrate = CANFDHW_DATA_BAUDRATE;
+static boolean CanFdHw_Paced = FALSE;
+static sint64 CanFdHw_BusBudgetNs = 0;
+static CanFdHw_StatisticsType CanFdHw_Stats;
+static CanFdHw_SimTxFaultType CanFdHw_TxFault = NULL_PTR;
+static boolean CanFdHw_BusOff = FALSE;
+
+void CanFdHw_Init(void)
+{
+    (void)CanBuf_InitQueue(&CanFdHw_Queue, CanFdHw_Storage, CANFDHW_LOOPBACK_DEPTH,
+                           CANFDHW_LOOPBACK_CLASS);
+    CanFdHw_Paced = FALSE;
+    CanFdHw_BusBudgetNs = 0;
+    CanFdHw_TxFault = NULL_PTR;
+    CanFdHw_BusOff = FALSE;
+    (void)memset(&CanFdHw_Stats, 0, sizeof(CanFdHw_Stats));
+}
+
+void CanFdHw_SetBaudrate(uint32 baudrate)
+{
+    CanFdHw_DataBaudrate = baudrate;
+}
+
+Std_ReturnType CanFdHw_Transmit(const CanSM_FdFrameType *frame)
+{
+    CanSM_FdGatherType pieces;
+
+    pieces.id = frame->id;
+    pieces.length = frame->length;
+    pieces.brs = frame->brs;
+    pieces.head = frame->data;
+    pieces.headLength = frame->length;
+    pieces.body = NULL_PTR;
+    pieces.bodyLength = 0u;
+    pieces.padding = 0u;
+    return CanFdHw_TransmitGather(&pieces);
+}
+
+/**
+ * @brief   Assemble the pieces directly in the queue entry
+ */
+Std_ReturnType CanFdHw_TransmitGather(const CanSM_FdGatherType *frame)
+{
+    uint32 duration;
+
+    if (CanFdHw_BusOff == TRUE ||
+        CanBuf_GetCount(&CanFdHw_Queue) >= CANFDHW_LOOPBACK_DEPTH ||
+        frame->length > CANFDHW_LOOPBACK_CLASS ||
+        (CanFdHw_Paced == TRUE && CanFdHw_BusBudgetNs <= 0) ||
+        (CanFdHw_TxFault != NULL_PTR && CanFdHw_TxFault(frame) == TRUE))
+    {
+        CanFdHw_Stats.txRejected++;
+        return RecLog_CanTransmit(frame, E_NOT_OK);
+    }
+
+    /* Pieces longer than the frame are refused */
+    if (CanBuf_PutGather(&CanFdHw_Queue, frame) != E_OK)
+    {
+        CanFdHw_Stats.txRejected++;
+        return RecLog_CanTransmit(frame, E_NOT_OK);
+    }
+
+    duration = CanFdHw_GatherDurationNs(frame, CANFDHW_NOMINAL_BAUDRATE, CanFdHw_DataBaudrate);
+
+    /* A frame that started inside the granted interval may finish after it */
+    CanFdHw_BusBudgetNs -= duration;
+
+    CanFdHw_Stats.txFrames++;
+    CanFdHw_Stats.payloadBytes += frame->length;
+    CanFdHw_Stats.busTimeNs += duration;
+    return RecLog_CanTransmit(frame, E_OK);
+}
+
+/**
+ * @brief   Leave bus-off
+ * @details With paced transmission the recovery sequence takes its bus time
+ *          before the next frame; without, the controller sends at once.
+ */
+void CanFdHw_StartController(void)
+{
+    CanFdHw_BusOff = FALSE;
+    if (CanFdHw_Paced == TRUE)
+    {
+        CanFdHw_BusBudgetNs = -(sint64)((uint64)CANFDHW_BUSOFF_RECOVERY_BITS * 1000000000u /
+                                        CANFDHW_NOMINAL_BAUDRATE);
+    }
+}
+
+Std_ReturnType CanFdHw_Receive(CanSM_FdFrameType *frame)
+{
+    if (CanBuf_Get(&CanFdHw_Queue, frame) != E_OK)
+    {
+        return RecLog_CanReceive(frame, E_NOT_OK);
+    }
+
+    CanFdHw_Stats.rxFrames++;
+    return RecLog_CanReceive(frame, E_OK);
+}
+
+void CanFdHw_GetStatistics(CanFdHw_StatisticsType *stats)
+{
+    if (stats != NULL_PTR)
+    {
+        *stats = CanFdHw_Stats;
+    }
+}
+
+/**
+ * @brief   Grant bus time for the next simulated interval
+ * @details An idle bus cannot bank time, so the budget never exceeds one
+ *          interval; an overrun from a frame crossing the interval end is
+ *          carried over.
+ */
+void CanFdHw_LoopbackGrantBusTime(uint32 ns)
+{
+    CanFdHw_Paced = TRUE;
+    CanFdHw_BusBudgetNs += ns;
+    if (CanFdHw_BusBudgetNs > (sint64)ns)
+    {
+        CanFdHw_BusBudgetNs = (sint64)ns;
+    }
+}
+
+void CanFdHw_LoopbackSetTxFault(CanFdHw_SimTxFaultType fault)
+{
+    CanFdHw_TxFault = fault;
+}
+
+void CanFdHw_LoopbackBusOff(void)
+{
+    CanFdHw_BusOff = TRUE;
+    CanSM_ControllerBusOff();
+}
@@ -0,0 +1,556 @@
+/*
+ * CanFdHw_Shm.c - Shared-Memory Virtual CAN-FD Bus
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains a multi-process CAN-FD bus for the host
+ *              simulation. All nodes map one POSIX shared memory segment:
+ *
+ *              - Each node owns a set of TX mailboxes (single producer,
+ *                single consumer, handed over with an atomic state word).
+ *              - Whichever node wins a non-blocking try-lock arbitrates:
+ *                among the pending mailboxes it picks the lowest CAN ID,
+ *                exactly like bitwise arbitration on a real bus, the
+ *                oldest request among equal IDs, and publishes the winner
+ *                into a broadcast ring. The lock holds the owner's process
+ *                ID, so the lock of a node that died while arbitrating is
+ *                taken over once the owner is gone.
+ *              - Nodes occupy a slot each, freed by CanFdHw_ShmClose or
+ *                taken over from a process that no longer exists.
+ *              - Readers never lock. Every ring slot is a seqlock whose
+ *                sequence encodes the ticket it holds, so a reader detects
+ *                empty slots and overruns from a single load.
+ *
+ *              With pacing enabled the bus is busy for the bit time of
+ *              each frame (nominal rate for arbitration, data rate after
+ *              BRS) and receivers only see a frame once its EOF has
+ *              passed.
+ *
+ *              Mailboxes and ring slots hold compact CanBuf entries, so
+ *              handing a frame over copies its header and used payload
+ *              only. Received frames and refused transmissions pass the
+ *              RecLog input points, stamped with SimTime, which the node
+ *              advances if the log is to keep the timing.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "CanFdHw.h"
+#include "CanBuf.h"
+#include "RecLog.h"
+
+/* Segment layout parameters; every node must agree on them */
+#define CANFDHW_SHM_MAGIC            (0x43414E46u)   /* "CANF" */
+#define CANFDHW_SHM_RING_SIZE        (4096u)         /* power of two */
+#define CANFDHW_SHM_MAX_NODES        (8u)
+#define CANFDHW_SHM_MAILBOXES        (8u)            /* TX buffers per node */
+#define CANFDHW_SHM_DEFAULT_NAME     "/canfdhw_bus0"
+
+/* Arbiter lock held longer than this is checked for a dead owner */
+#define CANFDHW_SHM_LEASE_NS         (100000000u)
+
+/* Mailbox states */
+#define CANFDHW_MB_EMPTY             (0u)
+#define CANFDHW_MB_FULL              (1u)
+
+/* Segment initialization states */
+#define CANFDHW_SEG_UNINIT           (0u)
+#define CANFDHW_SEG_INITIALIZING     (1u)
+
+typedef struct {
+    _Atomic uint32 state;
+    uint32 durationNs;
+    uint64 requestNs;
+    uint32 sequence;                 /* Request order within the node */
+    uint32 entry[CANBUF_ENTRY_WORDS(CANBUF_CLASS_64)];
+} CanFdHw_MailboxType;
+
+typedef struct {
+    /* 2 * ticket + 2 when valid, odd while being written, 0 when never used */
+    _Atomic uint64 seq;
+    uint64 eofNs;
+    uint32 sender;
+    uint32 entry[CANBUF_ENTRY_WORDS(CANBUF_CLASS_64)];
+} CanFdHw_SlotType;
+
+typedef struct {
+    _Atomic uint32 magic;
+    _Atomic uint32 node[CANFDHW_SHM_MAX_NODES];   /* Process ID of each node, 0 if free */
+    _Atomic uint32 arbiter;                       /* Process ID of the arbiter, 0 if free */
+    _Atomic uint64 arbiterSinceNs;
+    _Atomic uint64 head;
+    _Atomic uint64 busFreeNs;
+    _Atomic uint64 busTimeNs;
+    CanFdHw_MailboxType mailbox[CANFDHW_SHM_MAX_NODES][CANFDHW_SHM_MAILBOXES];
+    CanFdHw_SlotType ring[CANFDHW_SHM_RING_SIZE];
+} CanFdHw_SegmentType;
+
+/* Internal variables (per process) */
+static const char *CanFdHw_Name = NULL_PTR;
+static boolean CanFdHw_Paced = FALSE;
+static boolean CanFdHw_Configured = FALSE;
+static CanFdHw_SegmentType *CanFdHw_Seg = NULL_PTR;
+static uint32 CanFdHw_NodeId = 0u;
+static uint64 CanFdHw_RxTicket = 0u;
+static uint32 CanFdHw_Pid = 0u;
+static uint32 CanFdHw_TxSequence = 0u;
+static uint32 CanFdHw_DataBaudrate = CANFDHW_DATA_BAUDRATE;
+static CanFdHw_StatisticsType CanFdHw_Stats;
+
+/* Forward declarations */
+static uint64 CanFdHw_NowNs(void);
+static boolean CanFdHw_ProcessGone(uint32 pid);
+static boolean CanFdHw_Join(void);
+static void CanFdHw_Arbitrate(void);
+static Std_ReturnType CanFdHw_ShmTransmit(const CanSM_FdGatherType *frame);
+static Std_ReturnType CanFdHw_ShmReceive(CanSM_FdFrameType *frame);
+
+void CanFdHw_ShmConfigure(const char *name, boolean paced)
+{
+    CanFdHw_Name = name;
+    CanFdHw_Paced = paced;
+    CanFdHw_Configured = TRUE;
+}
+
+uint32 CanFdHw_ShmGetNodeId(void)
+{
+    return CanFdHw_NodeId;
+}
+
+void CanFdHw_ShmUnlink(const char *name)
+{
+    (void)shm_unlink((name != NULL_PTR) ? name : CANFDHW_SHM_DEFAULT_NAME);
+}
+
+void CanFdHw_Init(void)
+{
+    const char *env;
+    uint32 expected = CANFDHW_SEG_UNINIT;
+    int fd;
+    void *addr;
+
+    if (CanFdHw_Configured == FALSE)
+    {
+        CanFdHw_Name = getenv("CANFDHW_SHM_NAME");
+        env = getenv("CANFDHW_SHM_PACED");
+        CanFdHw_Paced = (env != NULL_PTR && env[0] == '1') ? TRUE : FALSE;
+    }
+    if (CanFdHw_Name == NULL_PTR)
+    {
+        CanFdHw_Name = CANFDHW_SHM_DEFAULT_NAME;
+    }
+
+    fd = shm_open(CanFdHw_Name, O_CREAT | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        return;
+    }
+    /* ftruncate zero-fills, and all-zero is the valid empty bus state */
+    if (ftruncate(fd, (off_t)sizeof(CanFdHw_SegmentType)) != 0)
+    {
+        (void)close(fd);
+        return;
+    }
+    addr = mmap(NULL_PTR, sizeof(CanFdHw_SegmentType), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        return;
+    }
+    CanFdHw_Seg = (CanFdHw_SegmentType *)addr;
+
+    /* First node stamps the segment; the others wait until it is stamped */
+    if (atomic_compare_exchange_strong(&CanFdHw_Seg->magic, &expected, CANFDHW_SEG_INITIALIZING))
+    {
+        atomic_store(&CanFdHw_Seg->magic, CANFDHW_SHM_MAGIC);
+    }
+    while (atomic_load(&CanFdHw_Seg->magic) != CANFDHW_SHM_MAGIC)
+    {
+    }
+
+    if (CanFdHw_Join() == FALSE)
+    {
+        (void)munmap(addr, sizeof(CanFdHw_SegmentType));
+        CanFdHw_Seg = NULL_PTR;
+        return;
+    }
+
+    /* A joining node only sees traffic from now on */
+    CanFdHw_RxTicket = atomic_load(&CanFdHw_Seg->head);
+    (void)memset(&CanFdHw_Stats, 0, sizeof(CanFdHw_Stats));
+}
+
+/**
+ * @brief   Take a free node slot, or the slot of a process that is gone
+ * @details Frames the previous owner left pending are discarded.
+ */
+static boolean CanFdHw_Join(void)
+{
+    uint32 owner;
+
+    CanFdHw_Pid = (uint32)getpid();
+    for (uint32 n = 0; n < CANFDHW_SHM_MAX_NODES; n++)
+    {
+        owner = atomic_load(&CanFdHw_Seg->node[n]);
+        if ((owner == 0u || CanFdHw_ProcessGone(owner) == TRUE) &&
+            atomic_compare_exchange_strong(&CanFdHw_Seg->node[n], &owner, CanFdHw_Pid))
+        {
+            for (uint32 i = 0; i < CANFDHW_SHM_MAILBOXES; i++)
+            {
+                atomic_store_explicit(&CanFdHw_Seg->mailbox[n][i].state, CANFDHW_MB_EMPTY,
+                                      memory_order_release);
+            }
+            CanFdHw_NodeId = n;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/**
+ * @brief   Leave the bus
+ * @details Frames still in the mailboxes of this node are sent first,
+ *          then its slot is freed for the next node that joins.
+ */
+void CanFdHw_ShmClose(void)
+{
+    boolean pending = TRUE;
+
+    if (CanFdHw_Seg == NULL_PTR)
+    {
+        return;
+    }
+
+    while (pending == TRUE)
+    {
+        CanFdHw_Arbitrate();
+        pending = FALSE;
+        for (uint32 i = 0; i < CANFDHW_SHM_MAILBOXES; i++)
+        {
+            if (atomic_load_explicit(&CanFdHw_Seg->mailbox[CanFdHw_NodeId][i].state,
+                                     memory_order_acquire) == CANFDHW_MB_FULL)
+            {
+                pending = TRUE;
+            }
+        }
+        if (pending == TRUE)
+        {
+            (void)sched_yield();
+        }
+    }
+
+    atomic_store(&CanFdHw_Seg->node[CanFdHw_NodeId], 0u);
+    (void)munmap(CanFdHw_Seg, sizeof(CanFdHw_SegmentType));
+    CanFdHw_Seg = NULL_PTR;
+}
+
+void CanFdHw_SetBaudrate(uint32 baudrate)
+{
+    CanFdHw_DataBaudrate = baudrate;
+}
+
+Std_ReturnType CanFdHw_Transmit(const CanSM_FdFrameType *frame)
+{
+    CanSM_FdGatherType pieces;
+
+    pieces.id = frame->id;
+    pieces.length = frame->length;
+    pieces.brs = frame->brs;
+    pieces.head = frame->data;
+    pieces.headLength = frame->length;
+    pieces.body = NULL_PTR;
+    pieces.bodyLength = 0u;
+    pieces.padding = 0u;
+    return CanFdHw_TransmitGather(&pieces);
+}
+
+Std_ReturnType CanFdHw_TransmitGather(const CanSM_FdGatherType *frame)
+{
+    return RecLog_CanTransmit(frame, CanFdHw_ShmTransmit(frame));
+}
+
+/* The pieces are assembled directly in a free TX mailbox */
+static Std_ReturnType CanFdHw_ShmTransmit(const CanSM_FdGatherType *frame)
+{
+    CanFdHw_MailboxType *mb;
+
+    if (CanFdHw_Seg == NULL_PTR)
+    {
+        return E_NOT_OK;
+    }
+
+    for (uint32 i = 0; i < CANFDHW_SHM_MAILBOXES; i++)
+    {
+        mb = &CanFdHw_Seg->mailbox[CanFdHw_NodeId][i];
+        if (atomic_load_explicit(&mb->state, memory_order_acquire) == CANFDHW_MB_EMPTY)
+        {
+            if (CanBuf_PackGather(mb->entry, CANBUF_CLASS_64, frame) != E_OK)
+            {
+                break;
+            }
+            mb->durationNs = CanFdHw_GatherDurationNs(frame, CANFDHW_NOMINAL_BAUDRATE, CanFdHw_DataBaudrate);
+            mb->requestNs = CanFdHw_NowNs();
+            mb->sequence = CanFdHw_TxSequence++;
+            atomic_store_explicit(&mb->state, CANFDHW_MB_FULL, memory_order_release);
+
+            CanFdHw_Stats.txFrames++;
+            CanFdHw_Stats.payloadBytes += frame->length;
+            CanFdHw_Arbitrate();
+            return E_OK;
+        }
+    }
+
+    /* All TX buffers pending: give arbitration a chance and report busy */
+    CanFdHw_Stats.txRejected++;
+    CanFdHw_Arbitrate();
+    return E_NOT_OK;
+}
+
+/* The shared memory bus has no error states, the controller never leaves it */
+void CanFdHw_StartController(void)
+{
+}
+
+Std_ReturnType CanFdHw_Receive(CanSM_FdFrameType *frame)
+{
+    return RecLog_CanReceive(frame, CanFdHw_ShmReceive(frame));
+}
+
+static Std_ReturnType CanFdHw_ShmReceive(CanSM_FdFrameType *frame)
+{
+    CanFdHw_SlotType *slot;
+    uint64 expected;
+    uint64 seq;
+    uint64 head;
+    uint32 sender;
+    uint64 eofNs;
+
+    if (CanFdHw_Seg == NULL_PTR)
+    {
+        return E_NOT_OK;
+    }
+
+    CanFdHw_Arbitrate();
+
+    for (;;)
+    {
+        slot = &CanFdHw_Seg->ring[CanFdHw_RxTicket & (CANFDHW_SHM_RING_SIZE - 1u)];
+        expected = 2u * CanFdHw_RxTicket + 2u;
+
+        seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        if (seq < expected)
+        {
+            /* Not yet published (or being written for this ticket) */
+            return E_NOT_OK;
+        }
+        if (seq == expected)
+        {
+            CanBuf_Unpack(slot->entry, CANBUF_CLASS_64, frame);
+            sender = slot->sender;
+            eofNs = slot->eofNs;
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&slot->seq, memory_order_relaxed) == expected)
+            {
+                if (CanFdHw_Paced == TRUE && eofNs > CanFdHw_NowNs())
+                {
+                    /* Still on the wire */
+                    return E_NOT_OK;
+                }
+                CanFdHw_RxTicket++;
+                if (sender != CanFdHw_NodeId)
+                {
+                    CanFdHw_Stats.rxFrames++;
+                    return E_OK;
+                }
+                /* Own frame: controllers do not receive what they sent */
+                continue;
+            }
+        }
+
+        /* The writer lapped us: resynchronize to the oldest frame still held */
+        head = atomic_load(&CanFdHw_Seg->head);
+        CanFdHw_Stats.rxOverruns += (uint32)(head - CANFDHW_SHM_RING_SIZE + 1u - CanFdHw_RxTicket);
+        CanFdHw_RxTicket = head - CANFDHW_SHM_RING_SIZE + 1u;
+    }
+}
+
+void CanFdHw_GetStatistics(CanFdHw_StatisticsType *stats)
+{
+    if (stats != NULL_PTR)
+    {
+        *stats = CanFdHw_Stats;
+        if (CanFdHw_Seg != NULL_PTR)
+        {
+            stats->busTimeNs = atomic_load(&CanFdHw_Seg->busTimeNs);
+        }
+    }
+}
+
+static uint64 CanFdHw_NowNs(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64)ts.tv_sec * 1000000000u + (uint64)ts.tv_nsec;
+}
+
+/* TRUE if no process with this ID exists any more */
+static boolean CanFdHw_ProcessGone(uint32 pid)
+{
+    return (kill((pid_t)pid, 0) != 0 && errno == ESRCH) ? TRUE : FALSE;
+}
+
+/* TRUE if the pending frame a goes on the bus before b: lower ID, then older request */
+static boolean CanFdHw_Precedes(const CanFdHw_MailboxType *a, const CanFdHw_MailboxType *b)
+{
+    uint32 idA = CanBuf_GetId(a->entry);
+    uint32 idB = CanBuf_GetId(b->entry);
+
+    if (idA != idB)
+    {
+        return (idA < idB) ? TRUE : FALSE;
+    }
+    if (a->requestNs != b->requestNs)
+    {
+        return (a->requestNs < b->requestNs) ? TRUE : FALSE;
+    }
+    return ((sint32)(a->sequence - b->sequence) < 0) ? TRUE : FALSE;
+}
+
+/**
+ * @brief   Take the arbiter lock
+ * @details A lock held beyond CANFDHW_SHM_LEASE_NS by a process that no
+ *          longer exists is taken over; its frame in flight, if any, is
+ *          published again under the same ticket.
+ */
+static boolean CanFdHw_LockArbiter(CanFdHw_SegmentType *seg)
+{
+    uint32 owner = 0u;
+    uint64 now;
+
+    if (!atomic_compare_exchange_strong_explicit(&seg->arbiter, &owner, CanFdHw_Pid,
+                                                 memory_order_acquire, memory_order_relaxed))
+    {
+        now = CanFdHw_NowNs();
+        if ((now - atomic_load_explicit(&seg->arbiterSinceNs, memory_order_relaxed)) < CANFDHW_SHM_LEASE_NS ||
+            CanFdHw_ProcessGone(owner) == FALSE ||
+            !atomic_compare_exchange_strong_explicit(&seg->arbiter, &owner, CanFdHw_Pid,
+                                                     memory_order_acquire, memory_order_relaxed))
+        {
+            return FALSE;
+        }
+    }
+    atomic_store_explicit(&seg->arbiterSinceNs, CanFdHw_NowNs(), memory_order_relaxed);
+    return TRUE;
+}
+
+/**
+ * @brief   Move pending mailboxes onto the bus
+ * @details Runs in whichever node wins the arbiter try-lock; a node that
+ *          loses simply returns, as the winner will pick up its frames.
+ *          A frame competes if it was pending when the bus became free;
+ *          among those the lowest CAN ID wins, and among frames of equal
+ *          ID the oldest request, so every ID keeps its request order.
+ */
+static void CanFdHw_Arbitrate(void)
+{
+    CanFdHw_SegmentType *seg = CanFdHw_Seg;
+    CanFdHw_MailboxType *mb;
+    CanFdHw_MailboxType *winner;
+    CanFdHw_SlotType *slot;
+    uint32 winnerNode;
+    uint64 now;
+    uint64 start;
+    uint64 earliest;
+    uint64 ticket;
+    uint32 duration;
+
+    if (CanFdHw_LockArbiter(seg) == FALSE)
+    {
+        return;
+    }
+    now = CanFdHw_NowNs();
+
+    for (;;)
+    {
+        /* Bus idle time: the later of bus free and the oldest pending request */
+        earliest = UINT64_MAX;
+        for (uint32 n = 0; n < CANFDHW_SHM_MAX_NODES; n++)
+        {
+            for (uint32 i = 0; i < CANFDHW_SHM_MAILBOXES; i++)
+            {
+                mb = &seg->mailbox[n][i];
+                if (atomic_load_explicit(&mb->state, memory_order_acquire) == CANFDHW_MB_FULL &&
+                    mb->requestNs < earliest)
+                {
+                    earliest = mb->requestNs;
+                }
+            }
+        }
+        if (earliest == UINT64_MAX)
+        {
+            break;
+        }
+
+        start = now;
+        if (CanFdHw_Paced == TRUE)
+        {
+            start = atomic_load_explicit(&seg->busFreeNs, memory_order_relaxed);
+            if (earliest > start)
+            {
+                start = earliest;
+            }
+            if (start > now)
+            {
+                /* Bus still busy with the previous frame */
+                break;
+            }
+        }
+
+        winner = NULL_PTR;
+        winnerNode = 0u;
+        for (uint32 n = 0; n < CANFDHW_SHM_MAX_NODES; n++)
+        {
+            for (uint32 i = 0; i < CANFDHW_SHM_MAILBOXES; i++)
+            {
+                mb = &seg->mailbox[n][i];
+                if (atomic_load_explicit(&mb->state, memory_order_acquire) == CANFDHW_MB_FULL &&
+                    (CanFdHw_Paced == FALSE || mb->requestNs <= start) &&
+                    (winner == NULL_PTR || CanFdHw_Precedes(mb, winner) == TRUE))
+                {
+                    winner = mb;
+                    winnerNode = n;
+                }
+            }
+        }
+
+        duration = winner->durationNs;
+
+        /* Single writer (the arbiter): seqlock publish into the ring */
+        ticket = atomic_load_explicit(&seg->head, memory_order_relaxed);
+        slot = &seg->ring[ticket & (CANFDHW_SHM_RING_SIZE - 1u)];
+        atomic_store_explicit(&slot->seq, 2u * ticket + 1u, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        CanBuf_CopyEntry(slot->entry, winner->entry, CANBUF_CLASS_64);
+        slot->sender = winnerNode;
+        slot->eofNs = start + duration;
+        atomic_store_explicit(&slot->seq, 2u * ticket + 2u, memory_order_release);
+        atomic_store_explicit(&seg->head, ticket + 1u, memory_order_release);
+
+        atomic_store_explicit(&seg->busFreeNs, start + duration, memory_order_relaxed);
+        atomic_fetch_add_explicit(&seg->busTimeNs, duration, memory_order_relaxed);
+        atomic_store_explicit(&winner->state, CANFDHW_MB_EMPTY, memory_order_release);
+    }
+
+    atomic_store_explicit(&seg->arbiter, 0u, memory_order_release);
+}
@@ -0,0 +1,70 @@
+/*
+ * CanFdHw_Timing.c - CAN-FD Frame Timing Model
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the bit-time model shared by the
+ *              host CAN-FD bus backends
+ */
+
+#include "CanFdHw.h"
+
+/* Largest standard (11-bit) identifier */
+#define CANFDHW_MAX_STD_ID           (0x7FFu)
+
+/**
+ * @brief   Time a frame of the given header occupies the bus
+ */
+static uint32 CanFdHw_DurationNs(uint32 id, boolean brs, uint8 length, uint32 nominalBaudrate,
+                                 uint32 dataBaudrate)
+{
+    uint32 nominalBits;
+    uint32 dataBits;
+    uint64 ns;
+
+    /* SOF, identifier, RRS, IDE, FDF, res, BRS */
+    nominalBits = (id > CANFDHW_MAX_STD_ID) ? 36u : 17u;
+
+    /* ESI, DLC, data, stuff count, CRC (17 or 21 bits), CRC delimiter */
+    dataBits = 1u + 4u + ((uint32)length * 8u) + 4u +
+               ((length > 16u) ? 21u : 17u) + 1u;
+
+    /* Approximate bit stuffing */
+    nominalBits += nominalBits / 10u;
+    dataBits += dataBits / 10u;
+
+    /* ACK slot, ACK delimiter, EOF, intermission */
+    nominalBits += 1u + 1u + 7u + 3u;
+
+    if (brs == FALSE || dataBaudrate == 0u)
+    {
+        nominalBits += dataBits;
+        dataBits = 0u;
+    }
+
+    ns = ((uint64)nominalBits * 1000000000u) / nominalBaudrate;
+    if (dataBits > 0u)
+    {
+        ns += ((uint64)dataBits * 1000000000u) / dataBaudrate;
+    }
+    return (uint32)ns;
+}
+
+/**
+ * @brief   Time a frame occupies the bus
+ */
+uint32 CanFdHw_FrameDurationNs(const CanSM_FdFrameType *frame, uint32 nominalBaudrate,
+                               uint32 dataBaudrate)
+{
+    return CanFdHw_DurationNs(frame->id, frame->brs, frame->length, nominalBaudrate, dataBaudrate);
+}
+
+/**
+ * @brief   Time a frame given in pieces occupies the bus
+ */
+uint32 CanFdHw_GatherDurationNs(const CanSM_FdGatherType *frame, uint32 nominalBaudrate,
+                                uint32 dataBaudrate)
+{
+    return CanFdHw_DurationNs(frame->id, frame->brs, frame->length, nominalBaudrate, dataBaudrate);
+}
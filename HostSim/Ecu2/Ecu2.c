@@ -0,0 +1,134 @@
+/*
+ * Ecu2.c - ECU2 Motor Drive Node for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the ECU2 counterpart of the ECU1 motor
+ *              messages in CanSM. The motor follows the S-curve set point
+ *              of SetpointGen, limited by MOTOR_CONFIG (MAX_SPEED,
+ *              MAX_TORQUE, ACCELERATION). Until a MOTOR_CONFIG arrives the
+ *              ramp is unlimited, so the reported speed equals the last
+ *              commanded speed.
+ */
+
+#include <string.h>
+
+#include "Ecu2.h"
+#include "CanSM.h"
+#include "E2E.h"
+#include "SetpointGen.h"
+
+/* Internal variables */
+static uint8 Ecu2_Fault = ECU2_FAULT_NONE;
+static Ecu2_StatisticsType Ecu2_Stats;
+
+/* Forward declarations */
+static boolean Ecu2_Accepted(uint8 pdu, const CanSM_FdFrameType *frame);
+static void Ecu2_HandleCmd(const CanSM_FdFrameType *frame);
+static void Ecu2_HandleConfig(const CanSM_FdFrameType *frame);
+static void Ecu2_SendStatus(void);
+
+void Ecu2_Init(void)
+{
+    SetpointGen_Init();
+    Ecu2_Fault = ECU2_FAULT_NONE;
+    (void)memset(&Ecu2_Stats, 0, sizeof(Ecu2_Stats));
+}
+
+void Ecu2_RxProcessing(void)
+{
+    CanSM_FdFrameType frame;
+
+    while (CanSM_ReceiveFdFrame(&frame) == E_OK)
+    {
+        switch (frame.id)
+        {
+            case CANSM_MOTOR_CMD_ID:
+                if (Ecu2_Accepted(E2E_PDU_MOTOR_CMD, &frame) == TRUE)
+                {
+                    Ecu2_HandleCmd(&frame);
+                    Ecu2_SendStatus();
+                }
+                break;
+
+            case CANSM_MOTOR_CONFIG_ID:
+                if (Ecu2_Accepted(E2E_PDU_MOTOR_CONFIG, &frame) == TRUE)
+                {
+                    Ecu2_HandleConfig(&frame);
+                }
+                break;
+
+            default:
+                Ecu2_Stats.otherFrames++;
+                break;
+        }
+    }
+}
+
+void Ecu2_MainFunction(void)
+{
+    SetpointGen_MainFunction();
+}
+
+void Ecu2_GetStatistics(Ecu2_StatisticsType *stats)
+{
+    if (stats != NULL_PTR)
+    {
+        *stats = Ecu2_Stats;
+    }
+}
+
+/* E2E check; a rejected command gets no MOTOR_STATUS answer */
+static boolean Ecu2_Accepted(uint8 pdu, const CanSM_FdFrameType *frame)
+{
+    E2E_PCheckStatusType status = E2E_Check(pdu, frame->data, frame->length);
+
+    if ((status == E2E_P_OK || status == E2E_P_OKSOMELOST) && E2E_GetState(pdu) == E2E_SM_VALID)
+    {
+        return TRUE;
+    }
+    Ecu2_Stats.rejectedFrames++;
+    return FALSE;
+}
+
+static void Ecu2_HandleCmd(const CanSM_FdFrameType *frame)
+{
+    uint16 speed = (uint16)(frame->data[0] | (frame->data[1] << 8));
+    sint16 torque = (sint16)(frame->data[2] | (frame->data[3] << 8));
+    uint8 mode = frame->data[4];
+    uint8 limited;
+
+    Ecu2_Stats.cmdFrames++;
+    Ecu2_Fault = ECU2_FAULT_NONE;
+
+    if (mode == ECU2_MODE_STOP)
+    {
+        speed = 0u;
+        torque = 0;
+    }
+
+    limited = SetpointGen_SetTarget((sint32)speed, torque);
+    if ((limited & SETPOINTGEN_SPEED_LIMITED) != 0u)
+    {
+        Ecu2_Fault |= ECU2_FAULT_SPEED_LIMITED;
+    }
+    if ((limited & SETPOINTGEN_TORQUE_LIMITED) != 0u)
+    {
+        Ecu2_Fault |= ECU2_FAULT_TORQUE_LIMITED;
+    }
+}
+
+static void Ecu2_HandleConfig(const CanSM_FdFrameType *frame)
+{
+    Ecu2_Stats.configFrames++;
+    SetpointGen_SetLimits((uint16)(frame->data[0] | (frame->data[1] << 8)),
+                          (sint16)(frame->data[2] | (frame->data[3] << 8)),
+                          (sint16)(frame->data[4] | (frame->data[5] << 8)));
+}
+
+static void Ecu2_SendStatus(void)
+{
+    CanSM_SendMotorStatus((uint16)SetpointGen_GetSpeed(), SetpointGen_GetTorque(), Ecu2_Fault);
+    Ecu2_Stats.statusFrames++;
+}
@@ -0,0 +1,64 @@
+/*
+ * Ecu2.h - ECU2 Motor Drive Node for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the interface of the ECU2 side of
+ *              MotorControl.dbc: it consumes MOTOR_CMD and MOTOR_CONFIG
+ *              and answers with MOTOR_STATUS
+ */
+
+#ifndef ECU2_H
+#define ECU2_H
+
+#include "Std_Types.h"
+
+/* Period of Ecu2_MainFunction (set point ramp step) */
+#define ECU2_MAIN_FUNCTION_PERIOD_MS     (1u)
+
+/* FAULT_CODE values reported in MOTOR_STATUS */
+#define ECU2_FAULT_NONE                  (0x00u)
+#define ECU2_FAULT_SPEED_LIMITED         (0x01u)
+#define ECU2_FAULT_TORQUE_LIMITED        (0x02u)
+
+/* CONTROL_MODE value table */
+#define ECU2_MODE_TORQUE                 (0u)
+#define ECU2_MODE_SPEED                  (1u)
+#define ECU2_MODE_POSITION               (2u)
+#define ECU2_MODE_STOP                   (3u)
+
+/* Node statistics */
+typedef struct {
+    uint32 cmdFrames;
+    uint32 configFrames;
+    uint32 statusFrames;
+    uint32 otherFrames;
+    uint32 rejectedFrames;       /* MOTOR_CMD/CONFIG failing the E2E check */
+} Ecu2_StatisticsType;
+
+/* Function prototypes */
+
+/**
+ * @brief   Initialize the ECU2 node (CanSM must already be initialized)
+ */
+void Ecu2_Init(void);
+
+/**
+ * @brief   Drain received frames; every MOTOR_CMD is answered immediately
+ *          with a MOTOR_STATUS (event-triggered response)
+ */
+void Ecu2_RxProcessing(void);
+
+/**
+ * @brief   Advance the speed ramp by one period; must be called every
+ *          ECU2_MAIN_FUNCTION_PERIOD_MS (= SETPOINTGEN_TICK_MS)
+ */
+void Ecu2_MainFunction(void);
+
+/**
+ * @brief   Get node statistics
+ */
+void Ecu2_GetStatistics(Ecu2_StatisticsType *stats);
+
+#endif /* ECU2_H */
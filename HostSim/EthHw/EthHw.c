@@ -0,0 +1,224 @@
+/*
+ * EthHw.c - Datagram Socket Ethernet Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains a non-blocking datagram socket in
+ *              place of the Ethernet controller and UDP stack. The
+ *              transmit buffer handed to the caller is the one passed to
+ *              the socket, and received frames are read in place from the
+ *              receive buffer, so the stack above copies nothing. The
+ *              "mem" address replaces the socket by an in-memory loopback
+ *              of one frame, to measure the stack above without the kernel.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "EthHw.h"
+
+#define ETHHW_DEFAULT_ADDRESS        "udp:30501"
+
+/* Socket address of either family */
+typedef struct {
+    union {
+        struct sockaddr_in in;
+        struct sockaddr_un un;
+    } addr;
+    socklen_t length;
+    int family;
+} EthHw_AddressType;
+
+/* Internal variables */
+static const char *EthHw_LocalName = NULL_PTR;
+static const char *EthHw_PeerName = NULL_PTR;
+static EthHw_AddressType EthHw_Local;
+static EthHw_AddressType EthHw_Peer;
+static int EthHw_Socket = -1;
+static uint8 EthHw_TxBuffer[ETHHW_MTU];
+static uint8 EthHw_RxBuffer[ETHHW_MTU];
+static boolean EthHw_TxProvided = FALSE;
+static boolean EthHw_Memory = FALSE;
+static uint16 EthHw_MemoryLength = 0u;   /* Frame looped back in EthHw_TxBuffer; 0: none */
+static EthHw_StatisticsType EthHw_Stats;
+
+static Std_ReturnType EthHw_ParseAddress(const char *name, EthHw_AddressType *address)
+{
+    (void)memset(address, 0, sizeof(*address));
+    if (strcmp(name, "mem") == 0)
+    {
+        address->family = AF_UNSPEC;
+        return E_OK;
+    }
+    if (strncmp(name, "udp:", 4u) == 0)
+    {
+        address->family = AF_INET;
+        address->addr.in.sin_family = AF_INET;
+        address->addr.in.sin_port = htons((uint16)atoi(&name[4]));
+        address->addr.in.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address->length = sizeof(address->addr.in);
+        return E_OK;
+    }
+    if (strncmp(name, "unix:", 5u) == 0 && strlen(&name[5]) < sizeof(address->addr.un.sun_path))
+    {
+        address->family = AF_UNIX;
+        address->addr.un.sun_family = AF_UNIX;
+        (void)strcpy(address->addr.un.sun_path, &name[5]);
+        address->length = sizeof(address->addr.un);
+        return E_OK;
+    }
+    return E_NOT_OK;
+}
+
+void EthHw_Configure(const char *local, const char *peer)
+{
+    EthHw_LocalName = local;
+    EthHw_PeerName = peer;
+}
+
+Std_ReturnType EthHw_Init(void)
+{
+    const char *local = EthHw_LocalName;
+    const char *peer = EthHw_PeerName;
+
+    if (local == NULL_PTR)
+    {
+        local = getenv("ETHHW_LOCAL");
+        local = (local != NULL_PTR) ? local : ETHHW_DEFAULT_ADDRESS;
+    }
+    if (peer == NULL_PTR)
+    {
+        peer = getenv("ETHHW_PEER");
+        peer = (peer != NULL_PTR) ? peer : local;
+    }
+    if (EthHw_ParseAddress(local, &EthHw_Local) != E_OK || EthHw_ParseAddress(peer, &EthHw_Peer) != E_OK ||
+        EthHw_Local.family != EthHw_Peer.family)
+    {
+        return E_NOT_OK;
+    }
+
+    EthHw_Close();
+    EthHw_TxProvided = FALSE;
+    EthHw_MemoryLength = 0u;
+    (void)memset(&EthHw_Stats, 0, sizeof(EthHw_Stats));
+    EthHw_Memory = (EthHw_Local.family == AF_UNSPEC) ? TRUE : FALSE;
+    if (EthHw_Memory == TRUE)
+    {
+        return E_OK;
+    }
+
+    EthHw_Socket = socket(EthHw_Local.family, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if (EthHw_Socket < 0)
+    {
+        return E_NOT_OK;
+    }
+    if (EthHw_Local.family == AF_UNIX)
+    {
+        (void)unlink(EthHw_Local.addr.un.sun_path);
+    }
+    if (bind(EthHw_Socket, (const struct sockaddr *)&EthHw_Local.addr, EthHw_Local.length) != 0)
+    {
+        EthHw_Close();
+        return E_NOT_OK;
+    }
+    return E_OK;
+}
+
+void EthHw_Close(void)
+{
+    if (EthHw_Socket >= 0)
+    {
+        (void)close(EthHw_Socket);
+        EthHw_Socket = -1;
+        if (EthHw_Local.family == AF_UNIX)
+        {
+            (void)unlink(EthHw_Local.addr.un.sun_path);
+        }
+    }
+}
+
+Std_ReturnType EthHw_ProvideTxBuffer(uint8 **buffer, uint16 length)
+{
+    if ((EthHw_Socket < 0 && EthHw_Memory == FALSE) || EthHw_TxProvided == TRUE || EthHw_MemoryLength != 0u ||
+        length > ETHHW_MTU)
+    {
+        EthHw_Stats.txRefused++;
+        return E_NOT_OK;
+    }
+    EthHw_TxProvided = TRUE;
+    *buffer = EthHw_TxBuffer;
+    return E_OK;
+}
+
+Std_ReturnType EthHw_Transmit(uint16 length)
+{
+    ssize_t sent;
+
+    if (EthHw_TxProvided == FALSE)
+    {
+        EthHw_Stats.txRefused++;
+        return E_NOT_OK;
+    }
+    EthHw_TxProvided = FALSE;
+
+    if (EthHw_Memory == TRUE)
+    {
+        EthHw_MemoryLength = length;
+        EthHw_Stats.txFrames++;
+        EthHw_Stats.txBytes += length;
+        return E_OK;
+    }
+    sent = sendto(EthHw_Socket, EthHw_TxBuffer, length, 0, (const struct sockaddr *)&EthHw_Peer.addr,
+                  EthHw_Peer.length);
+    if (sent != (ssize_t)length)
+    {
+        /* Socket buffer full (EAGAIN) or no peer bound yet (ECONNREFUSED, ENOENT) */
+        EthHw_Stats.txRefused++;
+        return E_NOT_OK;
+    }
+    EthHw_Stats.txFrames++;
+    EthHw_Stats.txBytes += length;
+    return E_OK;
+}
+
+Std_ReturnType EthHw_Receive(const uint8 **data, uint16 *length)
+{
+    ssize_t received;
+
+    if (EthHw_Memory == TRUE)
+    {
+        if (EthHw_MemoryLength == 0u)
+        {
+            return E_NOT_OK;
+        }
+        EthHw_Stats.rxFrames++;
+        *data = EthHw_TxBuffer;
+        *length = EthHw_MemoryLength;
+        EthHw_MemoryLength = 0u;
+        return E_OK;
+    }
+    if (EthHw_Socket < 0)
+    {
+        return E_NOT_OK;
+    }
+    received = recv(EthHw_Socket, EthHw_RxBuffer, sizeof(EthHw_RxBuffer), 0);
+    if (received < 0)
+    {
+        return E_NOT_OK;
+    }
+    EthHw_Stats.rxFrames++;
+    *data = EthHw_RxBuffer;
+    *length = (uint16)received;
+    return E_OK;
+}
+
+void EthHw_GetStatistics(EthHw_StatisticsType *stats)
+{
+    *stats = EthHw_Stats;
+}
@@ -0,0 +1,64 @@
+/*
+ * EthHw.h - Datagram Socket Ethernet Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the driver interface SomeIp expects from
+ *              the Ethernet stack, plus host-only helpers. Each node owns
+ *              one datagram socket, UDP on the loopback interface or a UNIX
+ *              datagram socket, and sends to one peer address.
+ */
+
+#ifndef ETHHW_H
+#define ETHHW_H
+
+#include "Std_Types.h"
+
+/* Largest UDP payload in one Ethernet frame */
+#define ETHHW_MTU                    (1472u)
+
+/* Socket statistics */
+typedef struct {
+    uint32 txFrames;
+    uint32 txRefused;            /* Buffer busy, too long, or the socket refused */
+    uint32 rxFrames;
+    uint64 txBytes;
+} EthHw_StatisticsType;
+
+/* Driver interface used by SomeIp */
+Std_ReturnType EthHw_Init(void);
+
+/**
+ * @brief   Get the transmit buffer for a frame of the given length
+ * @details The caller writes the frame in place and passes it on with
+ *          EthHw_Transmit.
+ */
+Std_ReturnType EthHw_ProvideTxBuffer(uint8 **buffer, uint16 length);
+Std_ReturnType EthHw_Transmit(uint16 length);
+
+/**
+ * @brief   Receive a frame without blocking
+ * @details The data stays valid until the next call.
+ */
+Std_ReturnType EthHw_Receive(const uint8 **data, uint16 *length);
+
+/* Host helpers */
+
+/**
+ * @brief   Select the local and the peer address
+ * @details Must be called before EthHw_Init (i.e. before SomeIp_Init).
+ *          Addresses are "udp:<port>" on 127.0.0.1, "unix:<path>", or
+ *          "mem" for an in-memory loopback of one frame without a socket.
+ *          Without this call the ETHHW_LOCAL and ETHHW_PEER environment
+ *          variables are used, and without them "udp:30501" for both, so
+ *          the node receives what it sends.
+ */
+void EthHw_Configure(const char *local, const char *peer);
+
+/* Close the socket and remove a UNIX socket path */
+void EthHw_Close(void);
+
+void EthHw_GetStatistics(EthHw_StatisticsType *stats);
+
+#endif /* ETHHW_H */
@@ -0,0 +1,175 @@
+/*
+ * FaultInj.c - Fault Injection Scheduler for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the schedules and the latency records of
+ *              the fault classes. Only one injection per class awaits its
+ *              reaction at a time: the stack reacts to a fault condition,
+ *              not to every cause of it, so injections on top of an open
+ *              one are counted as merged.
+ */
+
+#include <stdlib.h>
+
+#include "FaultInj.h"
+
+typedef struct {
+    FaultInj_ConfigType config;
+    uint64 nextTick;
+    boolean open;
+    uint64 openTick;
+    uint32 injected;
+    uint32 merged;
+    uint32 measured;
+    uint64 max;
+    uint64 samples[FAULTINJ_MAX_SAMPLES];
+} FaultInj_ClassStateType;
+
+/* Internal variables */
+static FaultInj_ClassStateType FaultInj_Classes[FAULTINJ_CLASSES];
+static uint32 FaultInj_Random = 1u;
+
+/* xorshift32, never 0 */
+static uint32 FaultInj_NextRandom(void)
+{
+    FaultInj_Random ^= FaultInj_Random << 13;
+    FaultInj_Random ^= FaultInj_Random >> 17;
+    FaultInj_Random ^= FaultInj_Random << 5;
+    return FaultInj_Random;
+}
+
+static uint64 FaultInj_Interval(const FaultInj_ConfigType *config)
+{
+    uint64 span = 2u * config->jitter + 1u;
+    uint64 interval = config->meanInterval - config->jitter + (FaultInj_NextRandom() % span);
+
+    return (interval > 0u) ? interval : 1u;
+}
+
+static int FaultInj_CompareU64(const void *a, const void *b)
+{
+    uint64 x = *(const uint64 *)a;
+    uint64 y = *(const uint64 *)b;
+    return (x > y) - (x < y);
+}
+
+void FaultInj_Init(uint32 seed)
+{
+    for (uint32 c = 0; c < FAULTINJ_CLASSES; c++)
+    {
+        FaultInj_Classes[c].config.meanInterval = 0u;
+        FaultInj_Classes[c].open = FALSE;
+        FaultInj_Classes[c].injected = 0u;
+        FaultInj_Classes[c].merged = 0u;
+        FaultInj_Classes[c].measured = 0u;
+        FaultInj_Classes[c].max = 0u;
+    }
+    FaultInj_Random = (seed != 0u) ? seed : 1u;
+}
+
+void FaultInj_Configure(FaultInj_ClassType faultClass, const FaultInj_ConfigType *config)
+{
+    FaultInj_ClassStateType *state;
+
+    if (faultClass >= FAULTINJ_CLASSES || config == NULL_PTR)
+    {
+        return;
+    }
+
+    state = &FaultInj_Classes[faultClass];
+    state->config = *config;
+    if (state->config.jitter >= state->config.meanInterval)
+    {
+        state->config.jitter = (state->config.meanInterval > 0u) ? state->config.meanInterval - 1u : 0u;
+    }
+    state->nextTick = config->firstTick;
+}
+
+boolean FaultInj_Fire(FaultInj_ClassType faultClass, uint64 tick)
+{
+    FaultInj_ClassStateType *state;
+
+    if (faultClass >= FAULTINJ_CLASSES)
+    {
+        return FALSE;
+    }
+
+    state = &FaultInj_Classes[faultClass];
+    if (state->config.meanInterval == 0u || tick < state->nextTick)
+    {
+        return FALSE;
+    }
+
+    /* Missed opportunities do not queue up injections */
+    state->nextTick = tick + FaultInj_Interval(&state->config);
+    state->injected++;
+    if (state->open == TRUE)
+    {
+        state->merged++;
+    }
+    else
+    {
+        state->open = TRUE;
+        state->openTick = tick;
+    }
+    return TRUE;
+}
+
+uint64 FaultInj_GetMagnitude(FaultInj_ClassType faultClass)
+{
+    return (faultClass < FAULTINJ_CLASSES) ? FaultInj_Classes[faultClass].config.magnitude : 0u;
+}
+
+void FaultInj_Reacted(FaultInj_ClassType faultClass, uint64 tick)
+{
+    FaultInj_ClassStateType *state;
+    uint64 latency;
+
+    if (faultClass >= FAULTINJ_CLASSES || FaultInj_Classes[faultClass].open == FALSE)
+    {
+        return;
+    }
+
+    state = &FaultInj_Classes[faultClass];
+    state->open = FALSE;
+    latency = (tick > state->openTick) ? (tick - state->openTick) : 0u;
+    if (state->measured < FAULTINJ_MAX_SAMPLES)
+    {
+        state->samples[state->measured] = latency;
+    }
+    state->measured++;
+    if (latency > state->max)
+    {
+        state->max = latency;
+    }
+}
+
+boolean FaultInj_IsOpen(FaultInj_ClassType faultClass)
+{
+    return (faultClass < FAULTINJ_CLASSES) ? FaultInj_Classes[faultClass].open : FALSE;
+}
+
+void FaultInj_GetResult(FaultInj_ClassType faultClass, FaultInj_ResultType *result)
+{
+    FaultInj_ClassStateType *state;
+    uint32 n;
+
+    if (faultClass >= FAULTINJ_CLASSES || result == NULL_PTR)
+    {
+        return;
+    }
+
+    state = &FaultInj_Classes[faultClass];
+    n = (state->measured < FAULTINJ_MAX_SAMPLES) ? state->measured : FAULTINJ_MAX_SAMPLES;
+    qsort(state->samples, n, sizeof(uint64), FaultInj_CompareU64);
+
+    result->injected = state->injected;
+    result->measured = state->measured;
+    result->merged = state->merged;
+    result->p50 = (n > 0u) ? state->samples[n / 2u] : 0u;
+    result->p90 = (n > 0u) ? state->samples[(n * 90u) / 100u] : 0u;
+    result->p99 = (n > 0u) ? state->samples[(n * 99u) / 100u] : 0u;
+    result->max = state->max;
+}
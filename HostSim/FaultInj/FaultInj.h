@@ -0,0 +1,85 @@
+/*
+ * FaultInj.h - Fault Injection Scheduler for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the fault injector the hardware models
+ *              and host programs consult at their injection points. Each
+ *              fault class fires at a configured mean interval with uniform
+ *              jitter, and the time from an injection to the reaction of
+ *              the stack is collected into a latency distribution per
+ *              class. Times are SimTime ticks.
+ */
+
+#ifndef FAULTINJ_H
+#define FAULTINJ_H
+
+#include "Std_Types.h"
+
+/* Latencies kept per class for the percentiles; the maximum covers all */
+#define FAULTINJ_MAX_SAMPLES         (16384u)
+
+/* Fault classes */
+typedef enum {
+    FAULTINJ_ADC_OVERRANGE_0,       /* Group 0 (phase current) reads full scale */
+    FAULTINJ_ADC_OVERRANGE_1,       /* Group 1 (DC link voltage) reads full scale */
+    FAULTINJ_CAN_TX_FAIL,           /* One CanFdHw_Transmit refused */
+    FAULTINJ_CAN_BUS_OFF,           /* Controller bus-off, all transmissions refused */
+    FAULTINJ_GPT_TICK_DELAY,        /* System tick interrupt taken late */
+    FAULTINJ_ISR_OVERRUN,           /* Control step runs past its period */
+    FAULTINJ_CLASSES
+} FaultInj_ClassType;
+
+/* Injection schedule of a class */
+typedef struct {
+    uint64 firstTick;               /* No injection before */
+    uint64 meanInterval;            /* Mean time between injections, 0 disables the class */
+    uint64 jitter;                  /* Interval varies uniformly by +/- jitter */
+    uint64 magnitude;               /* Duration of the fault: over-range, bus-off,
+                                       tick delay or overrun */
+} FaultInj_ConfigType;
+
+/* Reaction times of a class */
+typedef struct {
+    uint32 injected;                /* Faults injected */
+    uint32 measured;                /* Injections with a reaction */
+    uint32 merged;                  /* Injected while the previous one awaited its reaction */
+    uint64 p50;
+    uint64 p90;
+    uint64 p99;
+    uint64 max;
+} FaultInj_ResultType;
+
+/**
+ * @brief   Disable all classes and clear the results
+ * @param   seed  Start value of the jitter generator, so runs repeat
+ */
+void FaultInj_Init(uint32 seed);
+
+/* Set the schedule of a class; the first injection is due at firstTick */
+void FaultInj_Configure(FaultInj_ClassType faultClass, const FaultInj_ConfigType *config);
+
+/**
+ * @brief   Injection point: decide whether the fault happens at tick
+ * @details TRUE once the next injection of the class is due; the fault is
+ *          then recorded as injected at tick and the next one scheduled.
+ */
+boolean FaultInj_Fire(FaultInj_ClassType faultClass, uint64 tick);
+
+/* Configured duration of the faults of a class */
+uint64 FaultInj_GetMagnitude(FaultInj_ClassType faultClass);
+
+/**
+ * @brief   The stack reacted to the fault of a class at tick
+ * @details Closes the injection awaiting its reaction, if any.
+ */
+void FaultInj_Reacted(FaultInj_ClassType faultClass, uint64 tick);
+
+/* TRUE while an injection of the class awaits its reaction */
+boolean FaultInj_IsOpen(FaultInj_ClassType faultClass);
+
+/* Counts and latency percentiles of a class */
+void FaultInj_GetResult(FaultInj_ClassType faultClass, FaultInj_ResultType *result);
+
+#endif /* FAULTINJ_H */
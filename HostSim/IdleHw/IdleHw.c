@@ -0,0 +1,72 @@
+/*
+ * IdleHw.c - Wait-For-Interrupt Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the host stand-in for the WAIT
+ *              instruction: the waiting thread sleeps in the kernel, so it
+ *              consumes no host CPU until a simulated interrupt arrives.
+ *              Disabled interrupts are a mutex the simulated ISRs take.
+ */
+
+#include <pthread.h>
+
+#include "IdleHw.h"
+
+/* Internal variables */
+static pthread_mutex_t IdleHw_IrqLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t IdleHw_Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t IdleHw_Cond = PTHREAD_COND_INITIALIZER;
+static boolean IdleHw_Pending = FALSE;
+static uint32 IdleHw_Wakeups = 0u;
+
+void IdleHw_DisableInterrupts(void)
+{
+    (void)pthread_mutex_lock(&IdleHw_IrqLock);
+}
+
+void IdleHw_EnableInterrupts(void)
+{
+    (void)pthread_mutex_unlock(&IdleHw_IrqLock);
+}
+
+void IdleHw_WaitForInterrupt(void)
+{
+    /* Enable interrupts only once a signal can no longer be missed */
+    (void)pthread_mutex_lock(&IdleHw_Lock);
+    (void)pthread_mutex_unlock(&IdleHw_IrqLock);
+    if (IdleHw_Pending == FALSE)
+    {
+        while (IdleHw_Pending == FALSE)
+        {
+            (void)pthread_cond_wait(&IdleHw_Cond, &IdleHw_Lock);
+        }
+        IdleHw_Wakeups++;
+    }
+    IdleHw_Pending = FALSE;
+    (void)pthread_mutex_unlock(&IdleHw_Lock);
+}
+
+void IdleHw_SimIsrEnter(void)
+{
+    (void)pthread_mutex_lock(&IdleHw_IrqLock);
+}
+
+void IdleHw_SimIsrExit(void)
+{
+    (void)pthread_mutex_unlock(&IdleHw_IrqLock);
+}
+
+void IdleHw_SimInterrupt(void)
+{
+    (void)pthread_mutex_lock(&IdleHw_Lock);
+    IdleHw_Pending = TRUE;
+    (void)pthread_cond_signal(&IdleHw_Cond);
+    (void)pthread_mutex_unlock(&IdleHw_Lock);
+}
+
+uint32 IdleHw_SimGetWakeups(void)
+{
+    return IdleHw_Wakeups;
+}
@@ -0,0 +1,51 @@
+/*
+ * IdleHw.h - Wait-For-Interrupt Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the wait interface Idle expects, plus
+ *              the host-only interrupt signal. The background loop blocks
+ *              on a condition variable until a simulated interrupt source
+ *              signals that an ISR ran.
+ */
+
+#ifndef IDLEHW_H
+#define IDLEHW_H
+
+#include "Std_Types.h"
+
+/* Driver interface used by Idle: mask and unmask the simulated interrupts */
+void IdleHw_DisableInterrupts(void);
+void IdleHw_EnableInterrupts(void);
+
+/**
+ * @brief   Block until the next interrupt
+ * @details Called with interrupts disabled; enables them as the wait
+ *          starts, so no interrupt is taken between the caller's last
+ *          check and the wait.
+ */
+void IdleHw_WaitForInterrupt(void);
+
+/* Host helpers */
+
+/**
+ * @brief   Enter and leave a simulated ISR
+ * @details The simulated interrupt source brackets its ISR with these; the
+ *          ISR waits while the background loop has interrupts disabled.
+ */
+void IdleHw_SimIsrEnter(void);
+void IdleHw_SimIsrExit(void);
+
+/**
+ * @brief   Signal that an interrupt was taken
+ * @details Called by the simulated interrupt source after its ISR. Like
+ *          the pending interrupt request on the core, a signal given while
+ *          nobody waits ends the next wait at once.
+ */
+void IdleHw_SimInterrupt(void);
+
+/* Number of waits that blocked and were ended by an interrupt */
+uint32 IdleHw_SimGetWakeups(void);
+
+#endif /* IDLEHW_H */
@@ -0,0 +1,120 @@
+/*
+ * MotorPlant.c - PMSM Plant Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the motor model, integrated with
+ *              explicit Euler steps of at most MOTORPLANT_MAX_STEP:
+ *
+ *              Ls di/dt = v - Rs i - w psiM [-sin th, cos th]
+ *              J dw_m/dt = 1.5 p psiM (i_beta cos th - i_alpha sin th) - B w_m - T_load
+ */
+
+#include <math.h>
+
+#include "MotorPlant.h"
+
+#define MOTORPLANT_TWO_PI            (6.283185307179586)
+#define MOTORPLANT_RPM_TO_RAD        (MOTORPLANT_TWO_PI / 60.0)
+
+/* Internal variables */
+static MotorPlant_ParamType MotorPlant_Params = {
+    MOTORPLANT_RS, MOTORPLANT_LS, MOTORPLANT_PSI_M, MOTORPLANT_POLE_PAIRS,
+    MOTORPLANT_INERTIA, MOTORPLANT_FRICTION
+};
+static double MotorPlant_IAlpha;
+static double MotorPlant_IBeta;
+static double MotorPlant_Theta;         /* Electrical angle [rad] */
+static double MotorPlant_Omega;         /* Mechanical speed [rad/s] */
+static double MotorPlant_ImposedOmega;  /* < 0: free running */
+static double MotorPlant_Load;
+static double MotorPlant_Torque;
+
+void MotorPlant_Init(const MotorPlant_ParamType *params)
+{
+    if (params != NULL_PTR)
+    {
+        MotorPlant_Params = *params;
+    }
+    MotorPlant_IAlpha = 0.0;
+    MotorPlant_IBeta = 0.0;
+    MotorPlant_Theta = 0.0;
+    MotorPlant_Omega = 0.0;
+    MotorPlant_ImposedOmega = -1.0;
+    MotorPlant_Load = 0.0;
+    MotorPlant_Torque = 0.0;
+}
+
+void MotorPlant_SetImposedSpeed(double rpm)
+{
+    MotorPlant_ImposedOmega = (rpm < 0.0) ? -1.0 : rpm * MOTORPLANT_RPM_TO_RAD;
+}
+
+void MotorPlant_SetLoadTorque(double torque)
+{
+    MotorPlant_Load = torque;
+}
+
+void MotorPlant_Step(double dt, double vu, double vv, double vw)
+{
+    const MotorPlant_ParamType *p = &MotorPlant_Params;
+    double vAlpha = (2.0 * vu - vv - vw) / 3.0;
+    double vBeta = (vv - vw) / sqrt(3.0);
+    uint32 steps = (uint32)ceil(dt / MOTORPLANT_MAX_STEP);
+    double h = dt / (double)steps;
+    double omegaE;
+    double s;
+    double c;
+
+    for (uint32 k = 0; k < steps; k++)
+    {
+        s = sin(MotorPlant_Theta);
+        c = cos(MotorPlant_Theta);
+        omegaE = MotorPlant_Omega * (double)p->polePairs;
+
+        MotorPlant_IAlpha += h * (vAlpha - p->rs * MotorPlant_IAlpha + omegaE * p->psiM * s) / p->ls;
+        MotorPlant_IBeta += h * (vBeta - p->rs * MotorPlant_IBeta - omegaE * p->psiM * c) / p->ls;
+        MotorPlant_Torque = 1.5 * (double)p->polePairs * p->psiM *
+                            (MotorPlant_IBeta * c - MotorPlant_IAlpha * s);
+
+        if (MotorPlant_ImposedOmega >= 0.0)
+        {
+            MotorPlant_Omega = MotorPlant_ImposedOmega;
+        }
+        else
+        {
+            MotorPlant_Omega += h * (MotorPlant_Torque - p->friction * MotorPlant_Omega - MotorPlant_Load) /
+                                p->inertia;
+        }
+
+        MotorPlant_Theta += h * MotorPlant_Omega * (double)p->polePairs;
+        MotorPlant_Theta = fmod(MotorPlant_Theta, MOTORPLANT_TWO_PI);
+        if (MotorPlant_Theta < 0.0)
+        {
+            MotorPlant_Theta += MOTORPLANT_TWO_PI;
+        }
+    }
+}
+
+void MotorPlant_GetCurrents(double *iu, double *iv, double *iw)
+{
+    *iu = MotorPlant_IAlpha;
+    *iv = -0.5 * MotorPlant_IAlpha + 0.5 * sqrt(3.0) * MotorPlant_IBeta;
+    *iw = -0.5 * MotorPlant_IAlpha - 0.5 * sqrt(3.0) * MotorPlant_IBeta;
+}
+
+double MotorPlant_GetAngle(void)
+{
+    return MotorPlant_Theta;
+}
+
+double MotorPlant_GetSpeedRpm(void)
+{
+    return MotorPlant_Omega / MOTORPLANT_RPM_TO_RAD;
+}
+
+double MotorPlant_GetTorque(void)
+{
+    return MotorPlant_Torque;
+}
@@ -0,0 +1,52 @@
+/*
+ * MotorPlant.h - PMSM Plant Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains a surface-mounted permanent magnet
+ *              synchronous motor in stationary (alpha/beta) coordinates,
+ *              driven by three phase voltages, with a rigid mechanical load
+ *              or an imposed speed
+ */
+
+#ifndef MOTORPLANT_H
+#define MOTORPLANT_H
+
+#include "Std_Types.h"
+
+/* Default motor parameters (match MotorObs_Cfg.h unless overridden) */
+#define MOTORPLANT_RS                (0.10)      /* [Ohm] */
+#define MOTORPLANT_LS                (200.0e-6)  /* [H] */
+#define MOTORPLANT_PSI_M             (0.010)     /* [Vs] */
+#define MOTORPLANT_POLE_PAIRS        (4)
+#define MOTORPLANT_INERTIA           (20.0e-6)   /* [kg m^2] */
+#define MOTORPLANT_FRICTION          (10.0e-6)   /* [Nm s/rad] */
+
+/* Integration step used inside MotorPlant_Step */
+#define MOTORPLANT_MAX_STEP          (1.0e-6)
+
+typedef struct {
+    double rs;
+    double ls;
+    double psiM;
+    uint32 polePairs;
+    double inertia;
+    double friction;
+} MotorPlant_ParamType;
+
+void MotorPlant_Init(const MotorPlant_ParamType *params);
+
+/* Hold the mechanical speed (negative: release, speed follows the torque) */
+void MotorPlant_SetImposedSpeed(double rpm);
+void MotorPlant_SetLoadTorque(double torque);
+
+/* Apply the phase-to-midpoint voltages for dt seconds */
+void MotorPlant_Step(double dt, double vu, double vv, double vw);
+
+void MotorPlant_GetCurrents(double *iu, double *iv, double *iw);
+double MotorPlant_GetAngle(void);       /* Electrical angle [rad], 0..2pi */
+double MotorPlant_GetSpeedRpm(void);    /* Mechanical speed [rpm] */
+double MotorPlant_GetTorque(void);      /* Electromagnetic torque [Nm] */
+
+#endif /* MOTORPLANT_H */
@@ -0,0 +1,671 @@
+/*
+ * Prof.c - Function Profiler for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the entry and exit hooks and the call
+ *              trees. A node of the tree is one call path; the children of
+ *              a node are a list kept most recently called first, so the
+ *              entry hook finds the node of a call that repeats at its
+ *              first compare. The cycle counter is read last in the entry
+ *              hook and first in the exit hook. The cost of the hooks that
+ *              still falls into the measured intervals is calibrated by
+ *              Prof_Init and subtracted in the export. Function names come
+ *              from the symbol table of the executable, so static functions
+ *              are named too.
+ */
+
+#include <elf.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Prof.h"
+
+/* Prof itself is never instrumented, whatever the flags of its file */
+#define PROF_NO_HOOK                 __attribute__((no_instrument_function))
+
+#define PROF_NONE                    (0xFFFFFFFFu)
+#define PROF_ROOT                    (0u)
+
+/* Hook pairs per calibration round, and rounds; the cheapest round counts */
+#define PROF_CALIBRATION_CALLS       (200000u)
+#define PROF_CALIBRATION_ROUNDS      (5u)
+#define PROF_RATE_NS                 (20000000u)
+
+/* Distinct functions in Prof_GetFunctions, a power of two */
+#define PROF_MAX_FUNCTIONS           (4096u)
+
+typedef struct {
+    void *function;
+    uint32 parent;
+    uint32 child;                /* Most recently called child first */
+    uint32 sibling;
+    uint64 calls;
+    uint64 cycles;               /* With the children */
+} Prof_NodeType;
+
+typedef struct {
+    void *function;
+    uint32 node;                 /* PROF_NONE: no node left */
+    uint64 start;
+} Prof_FrameType;
+
+typedef struct {
+    Prof_NodeType nodes[PROF_MAX_NODES];
+    uint32 nodeCount;
+    uint32 current;
+    Prof_FrameType stack[PROF_MAX_DEPTH];
+    uint32 depth;
+    uint32 overflow;             /* Calls beyond PROF_MAX_DEPTH still running */
+    uint64 calls;
+    uint64 dropped;
+} Prof_ThreadType;
+
+typedef struct {
+    uintptr_t address;
+    uintptr_t size;
+    const char *name;
+} Prof_SymbolType;
+
+/* Hooks, called by the instrumented code */
+void __cyg_profile_func_enter(void *function, void *site) PROF_NO_HOOK;
+void __cyg_profile_func_exit(void *function, void *site) PROF_NO_HOOK;
+
+/* Internal variables */
+static volatile boolean Prof_Enabled = FALSE;
+static __thread Prof_ThreadType *Prof_Thread = NULL_PTR;
+static __thread boolean Prof_Refused = FALSE;
+static Prof_ThreadType *Prof_Threads[PROF_MAX_THREADS];
+static uint32 Prof_ThreadCount = 0u;
+static pthread_mutex_t Prof_Lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Calibration */
+static uint32 Prof_PairCycles = 0u;      /* Entry and exit hook */
+static uint32 Prof_InnerCycles = 0u;     /* Part inside the interval of the function itself */
+static double Prof_CyclesPerNs = 1.0;
+
+/* Symbols of the executable */
+static char *Prof_Image = NULL_PTR;
+static Prof_SymbolType *Prof_Symbols = NULL_PTR;
+static uint32 Prof_SymbolCount = 0u;
+static uintptr_t Prof_LoadBias = 0u;
+static boolean Prof_SymbolsLoaded = FALSE;
+
+/* Functions of Prof_GetFunctions */
+static Prof_FunctionType Prof_Functions[PROF_MAX_FUNCTIONS];
+static void *Prof_FunctionKeys[PROF_MAX_FUNCTIONS];
+static char Prof_Unnamed[PROF_MAX_FUNCTIONS][24];
+
+static const char *Prof_Output = NULL_PTR;
+
+static inline PROF_NO_HOOK uint64 Prof_Cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64)ts.tv_sec * 1000000000u + (uint64)ts.tv_nsec;
+#endif
+}
+
+static PROF_NO_HOOK uint64 Prof_NowNs(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64)ts.tv_sec * 1000000000u + (uint64)ts.tv_nsec;
+}
+
+static PROF_NO_HOOK void Prof_Clear(Prof_ThreadType *thread)
+{
+    thread->nodes[PROF_ROOT].function = NULL_PTR;
+    thread->nodes[PROF_ROOT].parent = PROF_NONE;
+    thread->nodes[PROF_ROOT].child = PROF_NONE;
+    thread->nodes[PROF_ROOT].sibling = PROF_NONE;
+    thread->nodes[PROF_ROOT].calls = 0u;
+    thread->nodes[PROF_ROOT].cycles = 0u;
+    thread->nodeCount = 1u;
+    thread->current = PROF_ROOT;
+    thread->depth = 0u;
+    thread->overflow = 0u;
+    thread->calls = 0u;
+    thread->dropped = 0u;
+}
+
+/* Call tree of the calling thread, at its first profiled call */
+static PROF_NO_HOOK Prof_ThreadType *Prof_NewThread(void)
+{
+    Prof_ThreadType *thread;
+
+    if (Prof_Refused == TRUE)
+    {
+        return NULL_PTR;
+    }
+    thread = malloc(sizeof(Prof_ThreadType));
+    (void)pthread_mutex_lock(&Prof_Lock);
+    if (thread != NULL_PTR && Prof_ThreadCount < PROF_MAX_THREADS)
+    {
+        Prof_Clear(thread);
+        Prof_Threads[Prof_ThreadCount++] = thread;
+        Prof_Thread = thread;
+    }
+    else
+    {
+        free(thread);
+        thread = NULL_PTR;
+        Prof_Refused = TRUE;
+    }
+    (void)pthread_mutex_unlock(&Prof_Lock);
+    return thread;
+}
+
+/* Node of a call of function from the current node; becomes the current node */
+static inline PROF_NO_HOOK uint32 Prof_Child(Prof_ThreadType *thread, void *function)
+{
+    Prof_NodeType *nodes = thread->nodes;
+    uint32 parent = thread->current;
+    uint32 previous = PROF_NONE;
+    uint32 n;
+
+    for (n = nodes[parent].child; n != PROF_NONE; previous = n, n = nodes[n].sibling)
+    {
+        if (nodes[n].function == function)
+        {
+            if (previous != PROF_NONE)
+            {
+                nodes[previous].sibling = nodes[n].sibling;
+                nodes[n].sibling = nodes[parent].child;
+                nodes[parent].child = n;
+            }
+            thread->current = n;
+            return n;
+        }
+    }
+    if (thread->nodeCount >= PROF_MAX_NODES)
+    {
+        thread->dropped++;
+        return PROF_NONE;
+    }
+    n = thread->nodeCount++;
+    nodes[n].function = function;
+    nodes[n].parent = parent;
+    nodes[n].child = PROF_NONE;
+    nodes[n].sibling = nodes[parent].child;
+    nodes[n].calls = 0u;
+    nodes[n].cycles = 0u;
+    nodes[parent].child = n;
+    thread->current = n;
+    return n;
+}
+
+void __cyg_profile_func_enter(void *function, void *site)
+{
+    Prof_ThreadType *thread = Prof_Thread;
+    Prof_FrameType *frame;
+
+    (void)site;
+    if (Prof_Enabled == FALSE)
+    {
+        return;
+    }
+    if (thread == NULL_PTR)
+    {
+        thread = Prof_NewThread();
+        if (thread == NULL_PTR)
+        {
+            return;
+        }
+    }
+    if (thread->depth >= PROF_MAX_DEPTH)
+    {
+        thread->overflow++;
+        thread->dropped++;
+        return;
+    }
+    frame = &thread->stack[thread->depth++];
+    frame->function = function;
+    frame->node = Prof_Child(thread, function);
+    frame->start = Prof_Cycles();
+}
+
+void __cyg_profile_func_exit(void *function, void *site)
+{
+    uint64 now = Prof_Cycles();
+    Prof_ThreadType *thread = Prof_Thread;
+    Prof_FrameType *frame;
+    Prof_NodeType *node;
+
+    (void)site;
+    if (thread == NULL_PTR || thread->depth == 0u)
+    {
+        return;
+    }
+    if (thread->overflow > 0u)
+    {
+        thread->overflow--;
+        return;
+    }
+
+    /* Entered while profiling was stopped: not on the stack */
+    frame = &thread->stack[thread->depth - 1u];
+    if (frame->function != function)
+    {
+        return;
+    }
+    thread->depth--;
+    thread->calls++;
+    if (frame->node != PROF_NONE)
+    {
+        node = &thread->nodes[frame->node];
+        node->calls++;
+        node->cycles += now - frame->start;
+        thread->current = node->parent;
+    }
+}
+
+static PROF_NO_HOOK void Prof_CalibrationTarget(void)
+{
+}
+
+void Prof_Init(void)
+{
+    uint64 startNs;
+    uint64 start;
+    uint64 ns;
+    uint64 pair;
+    uint64 inner;
+    uint64 bestPair = ~(uint64)0u;
+    uint64 bestInner = ~(uint64)0u;
+    void *target = (void *)&Prof_CalibrationTarget;
+    Prof_ThreadType *thread;
+
+    Prof_Enabled = FALSE;
+
+    /* Counter rate against the monotonic clock */
+    startNs = Prof_NowNs();
+    start = Prof_Cycles();
+    do
+    {
+        ns = Prof_NowNs() - startNs;
+    } while (ns < PROF_RATE_NS);
+    Prof_CyclesPerNs = (double)(Prof_Cycles() - start) / (double)ns;
+
+    /* Hooks around no function at all */
+    for (uint32 round = 0; round < PROF_CALIBRATION_ROUNDS; round++)
+    {
+        Prof_Reset();
+        Prof_Enabled = TRUE;
+        start = Prof_Cycles();
+        for (uint32 i = 0; i < PROF_CALIBRATION_CALLS; i++)
+        {
+            __cyg_profile_func_enter(target, NULL_PTR);
+            __cyg_profile_func_exit(target, NULL_PTR);
+        }
+        pair = (Prof_Cycles() - start) / PROF_CALIBRATION_CALLS;
+        Prof_Enabled = FALSE;
+
+        thread = Prof_Thread;
+        if (thread == NULL_PTR || thread->nodes[PROF_ROOT].child == PROF_NONE)
+        {
+            break;
+        }
+        inner = thread->nodes[thread->nodes[PROF_ROOT].child].cycles / PROF_CALIBRATION_CALLS;
+        bestPair = (pair < bestPair) ? pair : bestPair;
+        bestInner = (inner < bestInner) ? inner : bestInner;
+    }
+    Prof_PairCycles = (bestPair != ~(uint64)0u) ? (uint32)bestPair : 0u;
+    Prof_InnerCycles = (bestInner <= bestPair) ? (uint32)bestInner : 0u;
+    Prof_Reset();
+}
+
+void Prof_Start(void)
+{
+    Prof_Enabled = TRUE;
+}
+
+void Prof_Stop(void)
+{
+    Prof_Enabled = FALSE;
+}
+
+void Prof_Reset(void)
+{
+    (void)pthread_mutex_lock(&Prof_Lock);
+    for (uint32 t = 0; t < Prof_ThreadCount; t++)
+    {
+        Prof_Clear(Prof_Threads[t]);
+    }
+    (void)pthread_mutex_unlock(&Prof_Lock);
+}
+
+/* Cycles of a node without its children and without the hooks */
+static uint64 Prof_SelfCycles(const Prof_ThreadType *thread, const Prof_NodeType *node)
+{
+    uint64 children = 0u;
+    uint64 childCalls = 0u;
+    uint64 hooks;
+
+    for (uint32 c = node->child; c != PROF_NONE; c = thread->nodes[c].sibling)
+    {
+        children += thread->nodes[c].cycles;
+        childCalls += thread->nodes[c].calls;
+    }
+    hooks = node->calls * Prof_InnerCycles + childCalls * (uint64)(Prof_PairCycles - Prof_InnerCycles);
+    return (node->cycles > children + hooks) ? (node->cycles - children - hooks) : 0u;
+}
+
+void Prof_GetStatistics(Prof_StatisticsType *stats)
+{
+    (void)memset(stats, 0, sizeof(*stats));
+    stats->hookCycles = Prof_PairCycles;
+    stats->cyclesPerNs = Prof_CyclesPerNs;
+    (void)pthread_mutex_lock(&Prof_Lock);
+    stats->threads = Prof_ThreadCount;
+    for (uint32 t = 0; t < Prof_ThreadCount; t++)
+    {
+        const Prof_ThreadType *thread = Prof_Threads[t];
+        uint64 topCalls = 0u;
+
+        for (uint32 c = thread->nodes[PROF_ROOT].child; c != PROF_NONE; c = thread->nodes[c].sibling)
+        {
+            stats->cycles += thread->nodes[c].cycles;
+            topCalls += thread->nodes[c].calls;
+        }
+        stats->calls += thread->calls;
+        stats->nodes += thread->nodeCount - 1u;
+        stats->dropped += thread->dropped;
+
+        /* Every nested pair, and the inner part of the outermost calls */
+        stats->overheadCycles += (thread->calls - topCalls) * Prof_PairCycles + topCalls * Prof_InnerCycles;
+    }
+    (void)pthread_mutex_unlock(&Prof_Lock);
+}
+
+static int Prof_CompareSymbols(const void *a, const void *b)
+{
+    const Prof_SymbolType *x = a;
+    const Prof_SymbolType *y = b;
+
+    return (x->address < y->address) ? -1 : ((x->address > y->address) ? 1 : 0);
+}
+
+/**
+ * @brief   Read the function symbols of the executable
+ * @details The load bias of a position-independent executable is the
+ *          difference between the address of Prof_Init and its symbol.
+ */
+static void Prof_LoadSymbols(void)
+{
+    const Elf64_Ehdr *header;
+    const Elf64_Shdr *sections;
+    FILE *file;
+    long size;
+
+    Prof_SymbolsLoaded = TRUE;
+    file = fopen("/proc/self/exe", "rb");
+    if (file == NULL_PTR)
+    {
+        return;
+    }
+    (void)fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    (void)fseek(file, 0, SEEK_SET);
+    Prof_Image = (size > (long)sizeof(Elf64_Ehdr)) ? malloc((size_t)size) : NULL_PTR;
+    if (Prof_Image == NULL_PTR || fread(Prof_Image, 1u, (size_t)size, file) != (size_t)size)
+    {
+        (void)fclose(file);
+        return;
+    }
+    (void)fclose(file);
+
+    header = (const Elf64_Ehdr *)Prof_Image;
+    if (memcmp(header->e_ident, ELFMAG, SELFMAG) != 0 || header->e_ident[EI_CLASS] != ELFCLASS64 ||
+        header->e_shoff + (uint64)header->e_shnum * sizeof(Elf64_Shdr) > (uint64)size)
+    {
+        return;
+    }
+    sections = (const Elf64_Shdr *)(Prof_Image + header->e_shoff);
+    for (uint32 s = 0; s < header->e_shnum; s++)
+    {
+        const Elf64_Sym *symbols;
+        const char *names;
+        uint32 count;
+
+        if (sections[s].sh_type != SHT_SYMTAB || sections[s].sh_link >= header->e_shnum)
+        {
+            continue;
+        }
+        symbols = (const Elf64_Sym *)(Prof_Image + sections[s].sh_offset);
+        names = Prof_Image + sections[sections[s].sh_link].sh_offset;
+        count = (uint32)(sections[s].sh_size / sizeof(Elf64_Sym));
+        Prof_Symbols = malloc(count * sizeof(Prof_SymbolType));
+        if (Prof_Symbols == NULL_PTR)
+        {
+            return;
+        }
+        for (uint32 i = 0; i < count; i++)
+        {
+            if (ELF64_ST_TYPE(symbols[i].st_info) == STT_FUNC && symbols[i].st_value != 0u)
+            {
+                Prof_Symbols[Prof_SymbolCount].address = (uintptr_t)symbols[i].st_value;
+                Prof_Symbols[Prof_SymbolCount].size = (uintptr_t)symbols[i].st_size;
+                Prof_Symbols[Prof_SymbolCount].name = &names[symbols[i].st_name];
+                if (strcmp(Prof_Symbols[Prof_SymbolCount].name, "Prof_Init") == 0)
+                {
+                    Prof_LoadBias = (uintptr_t)&Prof_Init - (uintptr_t)symbols[i].st_value;
+                }
+                Prof_SymbolCount++;
+            }
+        }
+        qsort(Prof_Symbols, Prof_SymbolCount, sizeof(Prof_SymbolType), Prof_CompareSymbols);
+        return;
+    }
+}
+
+/* Name of a function; NULL if the executable has no symbol for it */
+static const char *Prof_Name(const void *function)
+{
+    uintptr_t address;
+    uint32 low = 0u;
+    uint32 high;
+
+    if (Prof_SymbolsLoaded == FALSE)
+    {
+        Prof_LoadSymbols();
+    }
+    address = (uintptr_t)function - Prof_LoadBias;
+    high = Prof_SymbolCount;
+    while (low < high)
+    {
+        uint32 mid = (low + high) / 2u;
+
+        if (Prof_Symbols[mid].address <= address)
+        {
+            low = mid + 1u;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    if (low > 0u && address < Prof_Symbols[low - 1u].address + Prof_Symbols[low - 1u].size + 1u)
+    {
+        return Prof_Symbols[low - 1u].name;
+    }
+    return NULL_PTR;
+}
+
+static int Prof_CompareFunctions(const void *a, const void *b)
+{
+    const Prof_FunctionType *x = a;
+    const Prof_FunctionType *y = b;
+
+    return (x->selfCycles > y->selfCycles) ? -1 : ((x->selfCycles < y->selfCycles) ? 1 : 0);
+}
+
+uint32 Prof_GetFunctions(Prof_FunctionType *functions, uint32 count)
+{
+    uint32 used = 0u;
+
+    (void)memset(Prof_FunctionKeys, 0, sizeof(Prof_FunctionKeys));
+    (void)pthread_mutex_lock(&Prof_Lock);
+    for (uint32 t = 0; t < Prof_ThreadCount; t++)
+    {
+        const Prof_ThreadType *thread = Prof_Threads[t];
+
+        for (uint32 n = 1u; n < thread->nodeCount; n++)
+        {
+            const Prof_NodeType *node = &thread->nodes[n];
+            uint32 slot = (uint32)(((uintptr_t)node->function >> 4) * 2654435761u) & (PROF_MAX_FUNCTIONS - 1u);
+            uint32 a;
+
+            while (Prof_FunctionKeys[slot] != NULL_PTR && Prof_FunctionKeys[slot] != node->function)
+            {
+                slot = (slot + 1u) & (PROF_MAX_FUNCTIONS - 1u);
+            }
+            if (Prof_FunctionKeys[slot] == NULL_PTR)
+            {
+                if (used == PROF_MAX_FUNCTIONS - 1u)
+                {
+                    continue;
+                }
+                used++;
+                Prof_FunctionKeys[slot] = node->function;
+                Prof_Functions[slot].name = Prof_Name(node->function);
+                if (Prof_Functions[slot].name == NULL_PTR)
+                {
+                    (void)snprintf(Prof_Unnamed[slot], sizeof(Prof_Unnamed[slot]), "%p", node->function);
+                    Prof_Functions[slot].name = Prof_Unnamed[slot];
+                }
+                Prof_Functions[slot].calls = 0u;
+                Prof_Functions[slot].selfCycles = 0u;
+                Prof_Functions[slot].totalCycles = 0u;
+            }
+            Prof_Functions[slot].calls += node->calls;
+            Prof_Functions[slot].selfCycles += Prof_SelfCycles(thread, node);
+
+            /* Inclusive cycles at the outermost call of a recursion only */
+            for (a = node->parent; a != PROF_ROOT && thread->nodes[a].function != node->function;
+                 a = thread->nodes[a].parent)
+            {
+            }
+            if (a == PROF_ROOT)
+            {
+                Prof_Functions[slot].totalCycles += node->cycles;
+            }
+        }
+    }
+    (void)pthread_mutex_unlock(&Prof_Lock);
+
+    /* Gather the used slots at the front and sort them */
+    used = 0u;
+    for (uint32 slot = 0; slot < PROF_MAX_FUNCTIONS; slot++)
+    {
+        if (Prof_FunctionKeys[slot] != NULL_PTR)
+        {
+            Prof_Functions[used++] = Prof_Functions[slot];
+        }
+    }
+    qsort(Prof_Functions, used, sizeof(Prof_FunctionType), Prof_CompareFunctions);
+    count = (count < used) ? count : used;
+    (void)memcpy(functions, Prof_Functions, count * sizeof(Prof_FunctionType));
+    return count;
+}
+
+static void Prof_WriteName(FILE *file, const void *function)
+{
+    const char *name = Prof_Name(function);
+
+    if (name != NULL_PTR)
+    {
+        fputs(name, file);
+    }
+    else
+    {
+        fprintf(file, "%p", function);
+    }
+}
+
+Std_ReturnType Prof_WriteFolded(const char *path)
+{
+    uint32 chain[PROF_MAX_DEPTH];
+    uint32 depth;
+    uint32 active = 0u;
+    uint64 self;
+    FILE *file = fopen(path, "w");
+
+    if (file == NULL_PTR)
+    {
+        return E_NOT_OK;
+    }
+    (void)pthread_mutex_lock(&Prof_Lock);
+    for (uint32 t = 0; t < Prof_ThreadCount; t++)
+    {
+        active += (Prof_Threads[t]->nodeCount > 1u) ? 1u : 0u;
+    }
+    for (uint32 t = 0; t < Prof_ThreadCount; t++)
+    {
+        const Prof_ThreadType *thread = Prof_Threads[t];
+
+        for (uint32 n = 1u; n < thread->nodeCount; n++)
+        {
+            self = Prof_SelfCycles(thread, &thread->nodes[n]);
+            if (self == 0u)
+            {
+                continue;
+            }
+            depth = 0u;
+            for (uint32 a = n; a != PROF_ROOT && depth < PROF_MAX_DEPTH; a = thread->nodes[a].parent)
+            {
+                chain[depth++] = a;
+            }
+            if (active > 1u)
+            {
+                fprintf(file, "thread %u;", (unsigned)t);
+            }
+            while (depth > 0u)
+            {
+                Prof_WriteName(file, thread->nodes[chain[--depth]].function);
+                fputc((depth > 0u) ? ';' : ' ', file);
+            }
+            fprintf(file, "%llu\n", (unsigned long long)self);
+        }
+    }
+    (void)pthread_mutex_unlock(&Prof_Lock);
+    return (fclose(file) == 0) ? E_OK : E_NOT_OK;
+}
+
+static void Prof_WriteAtExit(void)
+{
+    Prof_StatisticsType stats;
+
+    Prof_Stop();
+    Prof_GetStatistics(&stats);
+    if (Prof_WriteFolded(Prof_Output) == E_OK)
+    {
+        fprintf(stderr, "Prof: %llu calls, %.1f ms profiled, hooks %.1f%% of it, folded stacks in %s\n",
+                (unsigned long long)stats.calls, (double)stats.cycles / stats.cyclesPerNs / 1e6,
+                (stats.cycles != 0u) ? 100.0 * (double)stats.overheadCycles / (double)stats.cycles : 0.0,
+                Prof_Output);
+    }
+}
+
+/* Profile the whole program when PROF_OUTPUT names the folded stacks file */
+static void __attribute__((constructor)) Prof_StartFromEnvironment(void)
+{
+    Prof_Output = getenv("PROF_OUTPUT");
+    if (Prof_Output != NULL_PTR && Prof_Output[0] != '\0')
+    {
+        Prof_Init();
+        Prof_Start();
+        (void)atexit(Prof_WriteAtExit);
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Prof.h - Function Profiler for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the function-level profiler of the
+ *              host build. The BSW and application sources are compiled
+ *              with -finstrument-functions, and the compiler calls the
+ *              entry and exit hooks of Prof around every function. Each
+ *              thread keeps its own call tree with the calls and cycles of
+ *              every call path, so the hooks take no lock. The trees are
+ *              exported as folded stacks for flame graphs, with the cost of
+ *              the hooks measured at Prof_Init and taken off the functions.
+ *
+ *              Host programs built with HOST_PROFILE=1 are instrumented;
+ *              with PROF_OUTPUT=<path> in the environment they profile from
+ *              start to exit and write the folded stacks to <path>.
+ */
+
+#ifndef PROF_H
+#define PROF_H
+
+#include "Std_Types.h"
+
+/* Threads with a call tree */
+#define PROF_MAX_THREADS             (64u)
+
+/* Call paths per thread, and call depth followed */
+#define PROF_MAX_NODES               (65536u)
+#define PROF_MAX_DEPTH               (512u)
+
+typedef struct {
+    uint64 calls;                /* Function calls seen by the hooks */
+    uint64 cycles;               /* Cycles in the outermost instrumented functions */
+    uint64 overheadCycles;       /* Cost of the hooks within them, taken off in the export */
+    uint32 hookCycles;           /* Cost of one entry and exit hook pair */
+    double cyclesPerNs;          /* Rate of the cycle counter */
+    uint32 threads;
+    uint32 nodes;                /* Call paths of all threads */
+    uint64 dropped;              /* Calls deeper than PROF_MAX_DEPTH or beyond PROF_MAX_NODES */
+} Prof_StatisticsType;
+
+/* Totals of one function over all its call paths */
+typedef struct {
+    const char *name;
+    uint64 calls;
+    uint64 selfCycles;           /* Without the functions it calls, without hook cost */
+    uint64 totalCycles;          /* With the functions it calls, recursion counted once */
+} Prof_FunctionType;
+
+/**
+ * @brief   Measure the rate of the cycle counter and the cost of the hooks
+ * @details Profiling stays stopped; the call trees are cleared.
+ */
+void Prof_Init(void);
+
+/* Account the calls from now on, in every thread */
+void Prof_Start(void);
+
+/* Stop accounting; functions still running are accounted when they return */
+void Prof_Stop(void);
+
+/* Clear the call trees of all threads; only while stopped */
+void Prof_Reset(void);
+
+void Prof_GetStatistics(Prof_StatisticsType *stats);
+
+/**
+ * @brief   Functions sorted by self cycles
+ * @return  Number of functions written, at most count
+ */
+uint32 Prof_GetFunctions(Prof_FunctionType *functions, uint32 count);
+
+/**
+ * @brief   Write one line "caller;...;function <self cycles>" per call path
+ * @details Paths of different threads start with the thread number when more
+ *          than one thread was profiled.
+ * @return  E_NOT_OK if the file cannot be written
+ */
+Std_ReturnType Prof_WriteFolded(const char *path);
+
+#endif /* PROF_H */
@@ -0,0 +1,176 @@
+/*
+ * PwmHw.c - PWM Timer Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains an edge-aligned PWM timer with shadow
+ *              compare registers. Shadow values of channels whose transfer
+ *              is enabled are copied to the active compare registers when
+ *              the counter wraps, after which the enable is cleared, as on
+ *              the GTM ATOM with update enable. Period boundaries and the
+ *              trigger output are SimTime events.
+ */
+
+#include "PwmHw.h"
+#include "SimTime.h"
+
+/* Trigger compare value meaning "no trigger" */
+#define PWMHW_TRIGGER_DISABLED       (0xFFFFFFFFu)
+
+/* Internal variables */
+static uint32 PwmHw_Period = 1u;
+static uint64 PwmHw_PeriodStart = 0u;
+static uint32 PwmHw_PeriodCount = 0u;
+static uint32 PwmHw_AccessCost = 0u;
+static uint32 PwmHw_TransferEnable = 0u;
+static uint32 PwmHw_TriggerCompare = PWMHW_TRIGGER_DISABLED;
+static uint32 PwmHw_Shadow[PWMHW_MAX_CHANNELS];
+static uint32 PwmHw_Active[PWMHW_MAX_CHANNELS];
+static PwmHw_SimPeriodCallbackType PwmHw_PeriodCallback = NULL_PTR;
+static PwmHw_SimTriggerCallbackType PwmHw_TriggerCallback = NULL_PTR;
+
+/* Forward declarations */
+static void PwmHw_Transfer(uint32 channelMask);
+static void PwmHw_WrapEvent(uint32 arg);
+static void PwmHw_TriggerEvent(uint32 arg);
+
+void PwmHw_SimInit(uint32 periodTicks)
+{
+    SimTime_Cancel(PwmHw_WrapEvent, 0u);
+    SimTime_Cancel(PwmHw_TriggerEvent, 0u);
+
+    PwmHw_Period = (periodTicks > 0u) ? periodTicks : 1u;
+    PwmHw_PeriodStart = SimTime_Now();
+    PwmHw_PeriodCount = 0u;
+    PwmHw_AccessCost = 0u;
+    PwmHw_TransferEnable = 0u;
+    PwmHw_TriggerCompare = PWMHW_TRIGGER_DISABLED;
+    PwmHw_PeriodCallback = NULL_PTR;
+    PwmHw_TriggerCallback = NULL_PTR;
+    for (uint8 i = 0; i < PWMHW_MAX_CHANNELS; i++)
+    {
+        PwmHw_Shadow[i] = 0u;
+        PwmHw_Active[i] = 0u;
+    }
+
+    (void)SimTime_Schedule(PwmHw_PeriodStart + PwmHw_Period, PwmHw_WrapEvent, 0u);
+}
+
+void PwmHw_SimSetAccessCost(uint32 ticks)
+{
+    PwmHw_AccessCost = ticks;
+}
+
+void PwmHw_SimSetPeriodCallback(PwmHw_SimPeriodCallbackType callback)
+{
+    PwmHw_PeriodCallback = callback;
+}
+
+void PwmHw_SimSetTriggerCallback(PwmHw_SimTriggerCallbackType callback)
+{
+    PwmHw_TriggerCallback = callback;
+}
+
+void PwmHw_SimAdvance(uint32 ticks)
+{
+    SimTime_Advance(ticks);
+}
+
+uint32 PwmHw_SimGetActiveCompare(uint8 channel)
+{
+    return (channel < PWMHW_MAX_CHANNELS) ? PwmHw_Active[channel] : 0u;
+}
+
+uint32 PwmHw_SimGetCounter(void)
+{
+    return (uint32)(SimTime_Now() - PwmHw_PeriodStart);
+}
+
+uint32 PwmHw_SimGetPeriodCount(void)
+{
+    return PwmHw_PeriodCount;
+}
+
+uint64 PwmHw_SimGetPeriodStart(void)
+{
+    return PwmHw_PeriodStart;
+}
+
+void PwmHw_WriteShadowCompare(uint8 channel, uint32 compare)
+{
+    PwmHw_SimAdvance(PwmHw_AccessCost);
+    if (channel < PWMHW_MAX_CHANNELS)
+    {
+        PwmHw_Shadow[channel] = compare;
+    }
+}
+
+void PwmHw_SetShadowTransfer(uint32 channelMask, boolean enable)
+{
+    PwmHw_SimAdvance(PwmHw_AccessCost);
+    if (enable == TRUE)
+    {
+        PwmHw_TransferEnable |= channelMask;
+    }
+    else
+    {
+        PwmHw_TransferEnable &= ~channelMask;
+    }
+}
+
+void PwmHw_ForceShadowTransfer(uint32 channelMask)
+{
+    PwmHw_SimAdvance(PwmHw_AccessCost);
+    PwmHw_Transfer(channelMask);
+    PwmHw_TransferEnable &= ~channelMask;
+}
+
+void PwmHw_SetTriggerCompare(uint32 compare)
+{
+    PwmHw_SimAdvance(PwmHw_AccessCost);
+    PwmHw_TriggerCompare = (compare < PwmHw_Period) ? compare : PWMHW_TRIGGER_DISABLED;
+}
+
+static void PwmHw_WrapEvent(uint32 arg)
+{
+    (void)arg;
+
+    /* Period boundary: latch enabled shadow registers */
+    PwmHw_PeriodStart = SimTime_Now();
+    PwmHw_PeriodCount++;
+    PwmHw_Transfer(PwmHw_TransferEnable);
+    PwmHw_TransferEnable = 0u;
+
+    (void)SimTime_Schedule(PwmHw_PeriodStart + PwmHw_Period, PwmHw_WrapEvent, 0u);
+    if (PwmHw_TriggerCompare != PWMHW_TRIGGER_DISABLED)
+    {
+        (void)SimTime_Schedule(PwmHw_PeriodStart + PwmHw_TriggerCompare, PwmHw_TriggerEvent, 0u);
+    }
+
+    if (PwmHw_PeriodCallback != NULL_PTR)
+    {
+        PwmHw_PeriodCallback(PwmHw_PeriodCount);
+    }
+}
+
+static void PwmHw_TriggerEvent(uint32 arg)
+{
+    (void)arg;
+
+    if (PwmHw_TriggerCallback != NULL_PTR)
+    {
+        PwmHw_TriggerCallback();
+    }
+}
+
+static void PwmHw_Transfer(uint32 channelMask)
+{
+    for (uint8 i = 0; i < PWMHW_MAX_CHANNELS; i++)
+    {
+        if ((channelMask & (1u << i)) != 0u)
+        {
+            PwmHw_Active[i] = PwmHw_Shadow[i];
+        }
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * PwmHw.h - PWM Timer Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the shadow-register interface PwmIf
+ *              expects from the PWM timer driver, plus host-only controls
+ *              of the simulated edge-aligned carrier. The timer runs on
+ *              the SimTime timeline.
+ */
+
+#ifndef PWMHW_H
+#define PWMHW_H
+
+#include "Std_Types.h"
+
+/* Number of simulated timer channels */
+#define PWMHW_MAX_CHANNELS           (8u)
+
+/* Called at every period boundary after pending shadow transfers */
+typedef void (*PwmHw_SimPeriodCallbackType)(uint32 periodCount);
+
+/* Trigger output of the timer, routed to a peripheral input (e.g. ADC) */
+typedef void (*PwmHw_SimTriggerCallbackType)(void);
+
+/* Driver interface used by PwmIf */
+void PwmHw_WriteShadowCompare(uint8 channel, uint32 compare);
+void PwmHw_SetShadowTransfer(uint32 channelMask, boolean enable);
+void PwmHw_ForceShadowTransfer(uint32 channelMask);
+void PwmHw_SetTriggerCompare(uint32 compare);
+
+/* Host helpers */
+void PwmHw_SimInit(uint32 periodTicks);
+
+/**
+ * @brief   Make every register access consume simulated timer ticks
+ * @details Models bus access latency plus the code around it, so that a
+ *          sequence of accesses can be split by a period boundary.
+ */
+void PwmHw_SimSetAccessCost(uint32 ticks);
+
+void PwmHw_SimSetPeriodCallback(PwmHw_SimPeriodCallbackType callback);
+
+/**
+ * @brief   Connect the trigger output
+ * @details The trigger fires each period when the counter reaches the
+ *          value set by PwmHw_SetTriggerCompare, starting with the period
+ *          after the compare value was written.
+ */
+void PwmHw_SimSetTriggerCallback(PwmHw_SimTriggerCallbackType callback);
+
+void PwmHw_SimAdvance(uint32 ticks);
+uint32 PwmHw_SimGetActiveCompare(uint8 channel);
+uint32 PwmHw_SimGetCounter(void);
+uint32 PwmHw_SimGetPeriodCount(void);
+
+/* SimTime tick at which the current period started */
+uint64 PwmHw_SimGetPeriodStart(void);
+
+#endif /* PWMHW_H */
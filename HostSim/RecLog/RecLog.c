@@ -0,0 +1,439 @@
+/*
+ * RecLog.c - Input Record and Replay for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the input log. The log is a 16-byte
+ *              file header followed by records of a 6-byte header (tick
+ *              delta to the previous record, stream, payload length) and
+ *              the payload, little endian, appended through a write buffer.
+ *              Replay maps the file read-only and keeps one cursor per
+ *              stream that walks the records in place, so the streams are
+ *              consumed independently and no record is copied.
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "RecLog.h"
+#include "SimTime.h"
+
+#define RECLOG_MAGIC                 (0x474F4C52u)   /* "RLOG" */
+#define RECLOG_VERSION               (1u)
+#define RECLOG_FILE_HEADER           (16u)
+#define RECLOG_RECORD_HEADER         (6u)
+
+/* Record that only carries a tick delta too long for one record */
+#define RECLOG_STREAM_GAP            (0xFFu)
+#define RECLOG_MAX_DELTA             (0xFFFFFFFFu)
+
+/* Write buffer of the recorder */
+#define RECLOG_BUFFER_SIZE           (65536u)
+
+/* CAN record: ID, BRS, data */
+#define RECLOG_CAN_HEADER            (5u)
+
+#define RECLOG_DIO_UNKNOWN           (0xFFu)
+
+/* Replay position in one stream */
+typedef struct {
+    uint64 offset;               /* Next record of the stream, or the end of the log */
+    uint64 tick;                 /* Tick of the record at offset */
+    boolean found;
+} RecLog_CursorType;
+
+/* Internal variables */
+static RecLog_ModeType RecLog_Mode = RECLOG_OFF;
+static RecLog_StatisticsType RecLog_Stats;
+static uint8 RecLog_DioLevel[RECLOG_DIO_CHANNELS];
+
+/* Recorder */
+static int RecLog_File = -1;
+static uint8 RecLog_Buffer[RECLOG_BUFFER_SIZE];
+static uint32 RecLog_BufferUsed = 0u;
+static uint64 RecLog_LastTick = 0u;
+
+/* Replayer */
+static const uint8 *RecLog_Map = NULL_PTR;
+static uint64 RecLog_Size = 0u;
+static uint32 RecLog_Total = 0u;
+static RecLog_CursorType RecLog_Cursor[RECLOG_STREAMS];
+
+static void RecLog_Put32(uint8 *data, uint32 value)
+{
+    data[0] = (uint8)value;
+    data[1] = (uint8)(value >> 8);
+    data[2] = (uint8)(value >> 16);
+    data[3] = (uint8)(value >> 24);
+}
+
+static uint32 RecLog_Get32(const uint8 *data)
+{
+    return (uint32)data[0] | ((uint32)data[1] << 8) | ((uint32)data[2] << 16) | ((uint32)data[3] << 24);
+}
+
+static void RecLog_Flush(void)
+{
+    uint32 done = 0u;
+    ssize_t written;
+
+    while (done < RecLog_BufferUsed)
+    {
+        written = write(RecLog_File, &RecLog_Buffer[done], RecLog_BufferUsed - done);
+        if (written <= 0)
+        {
+            break;
+        }
+        done += (uint32)written;
+    }
+    RecLog_BufferUsed = 0u;
+}
+
+static void RecLog_Append(uint8 stream, uint32 delta, const void *data, uint8 length)
+{
+    uint8 *record;
+
+    if (RecLog_BufferUsed + RECLOG_RECORD_HEADER + length > RECLOG_BUFFER_SIZE)
+    {
+        RecLog_Flush();
+    }
+    record = &RecLog_Buffer[RecLog_BufferUsed];
+    RecLog_Put32(record, delta);
+    record[4] = stream;
+    record[5] = length;
+    if (length > 0u)
+    {
+        (void)memcpy(&record[RECLOG_RECORD_HEADER], data, length);
+    }
+    RecLog_BufferUsed += RECLOG_RECORD_HEADER + length;
+    RecLog_Stats.bytes += RECLOG_RECORD_HEADER + length;
+}
+
+/**
+ * @brief   Move a cursor to the next record of its stream
+ * @details The cursor stands on the record after the last one taken, with
+ *          the tick of the record before it. A record cut off at the end of
+ *          the log, as left by a recorder that did not stop, ends the walk.
+ */
+static void RecLog_Find(RecLog_CursorType *cursor, uint8 stream)
+{
+    const uint8 *record;
+
+    cursor->found = FALSE;
+    while (cursor->offset + RECLOG_RECORD_HEADER <= RecLog_Size)
+    {
+        record = &RecLog_Map[cursor->offset];
+        if (cursor->offset + RECLOG_RECORD_HEADER + record[5] > RecLog_Size)
+        {
+            cursor->offset = RecLog_Size;
+            return;
+        }
+        cursor->tick += RecLog_Get32(record);
+        if (record[4] == stream)
+        {
+            cursor->found = TRUE;
+            return;
+        }
+        cursor->offset += RECLOG_RECORD_HEADER + record[5];
+    }
+}
+
+Std_ReturnType RecLog_StartRecording(const char *path)
+{
+    uint8 header[RECLOG_FILE_HEADER] = {0u};
+
+    RecLog_Stop();
+    RecLog_File = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (RecLog_File < 0)
+    {
+        return E_NOT_OK;
+    }
+
+    (void)memset(&RecLog_Stats, 0, sizeof(RecLog_Stats));
+    (void)memset(RecLog_DioLevel, RECLOG_DIO_UNKNOWN, sizeof(RecLog_DioLevel));
+    RecLog_Put32(&header[0], RECLOG_MAGIC);
+    RecLog_Put32(&header[4], RECLOG_VERSION);
+    RecLog_Put32(&header[8], SIMTIME_TICKS_PER_SECOND);
+    (void)memcpy(RecLog_Buffer, header, sizeof(header));
+    RecLog_BufferUsed = RECLOG_FILE_HEADER;
+    RecLog_Stats.bytes = RECLOG_FILE_HEADER;
+    RecLog_LastTick = 0u;            /* Ticks are absolute SimTime ticks */
+    RecLog_Mode = RECLOG_RECORDING;
+    return E_OK;
+}
+
+Std_ReturnType RecLog_StartReplay(const char *path)
+{
+    struct stat info;
+    RecLog_CursorType all = {RECLOG_FILE_HEADER, 0u, FALSE};
+    void *map;
+    int file;
+
+    RecLog_Stop();
+    file = open(path, O_RDONLY);
+    if (file < 0)
+    {
+        return E_NOT_OK;
+    }
+    if (fstat(file, &info) != 0 || info.st_size < (off_t)RECLOG_FILE_HEADER)
+    {
+        (void)close(file);
+        return E_NOT_OK;
+    }
+    map = mmap(NULL_PTR, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    (void)close(file);
+    if (map == MAP_FAILED)
+    {
+        return E_NOT_OK;
+    }
+    RecLog_Map = (const uint8 *)map;
+    RecLog_Size = (uint64)info.st_size;
+    if (RecLog_Get32(&RecLog_Map[0]) != RECLOG_MAGIC || RecLog_Get32(&RecLog_Map[4]) != RECLOG_VERSION ||
+        RecLog_Get32(&RecLog_Map[8]) != SIMTIME_TICKS_PER_SECOND)
+    {
+        RecLog_Stop();
+        return E_NOT_OK;
+    }
+    (void)madvise(map, (size_t)RecLog_Size, MADV_WILLNEED);
+
+    (void)memset(&RecLog_Stats, 0, sizeof(RecLog_Stats));
+    (void)memset(RecLog_DioLevel, RECLOG_DIO_UNKNOWN, sizeof(RecLog_DioLevel));
+    RecLog_Stats.bytes = RecLog_Size;
+
+    /* Count the records, so RecLog_Stop can tell how many were left */
+    RecLog_Total = 0u;
+    while (all.offset + RECLOG_RECORD_HEADER <= RecLog_Size)
+    {
+        if (RecLog_Map[all.offset + 4u] < RECLOG_STREAMS)
+        {
+            RecLog_Total++;
+        }
+        all.offset += RECLOG_RECORD_HEADER + RecLog_Map[all.offset + 5u];
+    }
+
+    for (uint8 s = 0; s < RECLOG_STREAMS; s++)
+    {
+        RecLog_Cursor[s].offset = RECLOG_FILE_HEADER;
+        RecLog_Cursor[s].tick = 0u;
+        RecLog_Find(&RecLog_Cursor[s], s);
+    }
+    RecLog_Mode = RECLOG_REPLAYING;
+    return E_OK;
+}
+
+void RecLog_Stop(void)
+{
+    uint32 taken = 0u;
+
+    if (RecLog_Mode == RECLOG_RECORDING)
+    {
+        RecLog_Flush();
+        (void)close(RecLog_File);
+        RecLog_File = -1;
+    }
+    else if (RecLog_Mode == RECLOG_REPLAYING)
+    {
+        for (uint8 s = 0; s < RECLOG_STREAMS; s++)
+        {
+            taken += RecLog_Stats.records[s];
+        }
+        RecLog_Stats.remaining = RecLog_Total - taken;
+    }
+    else
+    {
+        /* Nothing open */
+    }
+    if (RecLog_Map != NULL_PTR)
+    {
+        (void)munmap((void *)RecLog_Map, (size_t)RecLog_Size);
+        RecLog_Map = NULL_PTR;
+        RecLog_Size = 0u;
+    }
+    RecLog_Mode = RECLOG_OFF;
+}
+
+RecLog_ModeType RecLog_GetMode(void)
+{
+    return RecLog_Mode;
+}
+
+void RecLog_GetStatistics(RecLog_StatisticsType *stats)
+{
+    if (stats != NULL_PTR)
+    {
+        *stats = RecLog_Stats;
+    }
+}
+
+void RecLog_Write(RecLog_StreamType stream, const void *data, uint8 length)
+{
+    uint64 now = SimTime_Now();
+    uint64 delta = now - RecLog_LastTick;
+
+    if (RecLog_Mode != RECLOG_RECORDING)
+    {
+        return;
+    }
+    while (delta > RECLOG_MAX_DELTA)
+    {
+        RecLog_Append(RECLOG_STREAM_GAP, RECLOG_MAX_DELTA, NULL_PTR, 0u);
+        delta -= RECLOG_MAX_DELTA;
+    }
+    RecLog_Append((uint8)stream, (uint32)delta, data, length);
+    RecLog_LastTick = now;
+    RecLog_Stats.records[stream]++;
+}
+
+boolean RecLog_Take(RecLog_StreamType stream, const uint8 **data, uint8 *length)
+{
+    RecLog_CursorType *cursor = &RecLog_Cursor[stream];
+    const uint8 *record;
+    uint64 now = SimTime_Now();
+
+    if (RecLog_Mode != RECLOG_REPLAYING || cursor->found == FALSE || cursor->tick > now)
+    {
+        return FALSE;
+    }
+
+    record = &RecLog_Map[cursor->offset];
+    *data = &record[RECLOG_RECORD_HEADER];
+    *length = record[5];
+    if (cursor->tick < now)
+    {
+        RecLog_Stats.late++;
+    }
+    RecLog_Stats.records[stream]++;
+
+    cursor->offset += RECLOG_RECORD_HEADER + record[5];
+    RecLog_Find(cursor, (uint8)stream);
+    return TRUE;
+}
+
+boolean RecLog_Peek(RecLog_StreamType stream, uint64 *tick)
+{
+    if (RecLog_Mode != RECLOG_REPLAYING || RecLog_Cursor[stream].found == FALSE)
+    {
+        return FALSE;
+    }
+    *tick = RecLog_Cursor[stream].tick;
+    return TRUE;
+}
+
+Std_ReturnType RecLog_CanReceive(CanSM_FdFrameType *frame, Std_ReturnType result)
+{
+    uint8 record[RECLOG_CAN_HEADER + sizeof(frame->data)];
+    const uint8 *data;
+    uint8 length;
+
+    if (RecLog_Mode == RECLOG_RECORDING && result == E_OK)
+    {
+        RecLog_Put32(record, frame->id);
+        record[4] = (uint8)frame->brs;
+        (void)memcpy(&record[RECLOG_CAN_HEADER], frame->data, frame->length);
+        RecLog_Write(RECLOG_STREAM_CAN_RX, record, (uint8)(RECLOG_CAN_HEADER + frame->length));
+    }
+    else if (RecLog_Mode == RECLOG_REPLAYING)
+    {
+        if (RecLog_Take(RECLOG_STREAM_CAN_RX, &data, &length) == FALSE || length < RECLOG_CAN_HEADER)
+        {
+            return E_NOT_OK;
+        }
+        frame->id = RecLog_Get32(data);
+        frame->brs = (boolean)data[4];
+        frame->length = (uint8)(length - RECLOG_CAN_HEADER);
+        (void)memcpy(frame->data, &data[RECLOG_CAN_HEADER], frame->length);
+        return E_OK;
+    }
+    else
+    {
+        /* Pass the frame of the model */
+    }
+    return result;
+}
+
+Std_ReturnType RecLog_CanTransmit(const CanSM_FdGatherType *frame, Std_ReturnType result)
+{
+    uint8 record[4];
+    const uint8 *data;
+    uint8 length;
+
+    if (RecLog_Mode == RECLOG_RECORDING && result != E_OK)
+    {
+        RecLog_Put32(record, frame->id);
+        RecLog_Write(RECLOG_STREAM_CAN_TX, record, sizeof(record));
+    }
+    else if (RecLog_Mode == RECLOG_REPLAYING)
+    {
+        return (RecLog_Take(RECLOG_STREAM_CAN_TX, &data, &length) == TRUE) ? E_NOT_OK : E_OK;
+    }
+    else
+    {
+        /* Pass the result of the model */
+    }
+    return result;
+}
+
+void RecLog_AdcResults(uint8 group, AdcIf_ValueType *results, uint8 count)
+{
+    RecLog_StreamType stream = (group == 0u) ? RECLOG_STREAM_ADC_0 : RECLOG_STREAM_ADC_1;
+    const uint8 *data;
+    uint8 length;
+
+    if (group > 1u)
+    {
+        return;
+    }
+    if (RecLog_Mode == RECLOG_RECORDING)
+    {
+        RecLog_Write(stream, results, (uint8)(count * sizeof(AdcIf_ValueType)));
+    }
+    else if (RecLog_Mode == RECLOG_REPLAYING && RecLog_Take(stream, &data, &length) == TRUE)
+    {
+        (void)memcpy(results, data, (length < count * sizeof(AdcIf_ValueType)) ?
+                                    length : count * sizeof(AdcIf_ValueType));
+    }
+    else
+    {
+        /* Pass the results of the model */
+    }
+}
+
+uint8 RecLog_DioRead(uint8 channel, uint8 level)
+{
+    uint8 record[2];
+    const uint8 *data;
+    uint8 length;
+
+    if (channel >= RECLOG_DIO_CHANNELS)
+    {
+        return level;
+    }
+    if (RecLog_Mode == RECLOG_RECORDING && level != RecLog_DioLevel[channel])
+    {
+        /* Only changes are recorded; the level holds until the next one */
+        record[0] = channel;
+        record[1] = level;
+        RecLog_Write(RECLOG_STREAM_DIO, record, sizeof(record));
+        RecLog_DioLevel[channel] = level;
+    }
+    else if (RecLog_Mode == RECLOG_REPLAYING)
+    {
+        while (RecLog_Take(RECLOG_STREAM_DIO, &data, &length) == TRUE)
+        {
+            if (length == 2u && data[0] < RECLOG_DIO_CHANNELS)
+            {
+                RecLog_DioLevel[data[0]] = data[1];
+            }
+        }
+        return (RecLog_DioLevel[channel] != RECLOG_DIO_UNKNOWN) ? RecLog_DioLevel[channel] : level;
+    }
+    else
+    {
+        /* Pass the level of the model */
+    }
+    return level;
+}
@@ -0,0 +1,96 @@
+/*
+ * RecLog.h - Input Record and Replay for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the recorder of the inputs the stack
+ *              consumes and its replayer. The hardware models and host
+ *              programs pass every input through RecLog at their input
+ *              points: CAN-FD frames received and transmissions refused,
+ *              ADC group results, GPT tick interrupts and DIO reads. While
+ *              recording, the inputs are appended to a binary log with
+ *              their SimTime tick; while replaying, the log is mapped into
+ *              memory and the input points return the recorded inputs
+ *              instead of those of the models, so a recorded scenario runs
+ *              again bit-exact without the plant and the other nodes.
+ */
+
+#ifndef RECLOG_H
+#define RECLOG_H
+
+#include "Std_Types.h"
+#include "CanSM.h"
+#include "AdcIf.h"
+
+/* DIO channels whose level RecLog follows */
+#define RECLOG_DIO_CHANNELS          (32u)
+
+/* Longest record payload */
+#define RECLOG_MAX_PAYLOAD           (255u)
+
+/* Input streams */
+typedef enum {
+    RECLOG_STREAM_CAN_RX,        /* Frame returned by CanFdHw_Receive: ID, BRS, data */
+    RECLOG_STREAM_CAN_TX,        /* Transmission refused by the controller: ID */
+    RECLOG_STREAM_ADC_0,         /* Results of ADC group 0 */
+    RECLOG_STREAM_ADC_1,         /* Results of ADC group 1 */
+    RECLOG_STREAM_GPT_TICK,      /* Tick interrupt taken, no payload */
+    RECLOG_STREAM_DIO,           /* Level change seen by a read: channel, level */
+    RECLOG_STREAMS
+} RecLog_StreamType;
+
+typedef enum {
+    RECLOG_OFF,                  /* Input points pass the inputs of the models */
+    RECLOG_RECORDING,
+    RECLOG_REPLAYING
+} RecLog_ModeType;
+
+/* Log statistics */
+typedef struct {
+    uint32 records[RECLOG_STREAMS];   /* Written, or taken in replay */
+    uint64 bytes;                     /* Size of the log */
+    uint32 late;                      /* Replay: taken after the recorded tick */
+    uint32 remaining;                 /* Replay: never taken, counted by RecLog_Stop */
+} RecLog_StatisticsType;
+
+/**
+ * @brief   Start a new log; inputs are recorded until RecLog_Stop
+ * @return  E_NOT_OK if the file cannot be created
+ */
+Std_ReturnType RecLog_StartRecording(const char *path);
+
+/**
+ * @brief   Map a log for replay
+ * @details Each stream is replayed in its recorded order. A record is due
+ *          once SimTime reaches its tick; its input point takes it then.
+ * @return  E_NOT_OK if the file cannot be mapped or is not a log
+ */
+Std_ReturnType RecLog_StartReplay(const char *path);
+
+/* Flush and close the log, or unmap it; the statistics stay readable */
+void RecLog_Stop(void);
+
+RecLog_ModeType RecLog_GetMode(void);
+
+void RecLog_GetStatistics(RecLog_StatisticsType *stats);
+
+/* Append a record stamped with SimTime_Now */
+void RecLog_Write(RecLog_StreamType stream, const void *data, uint8 length);
+
+/**
+ * @brief   Take the next record of a stream if it is due
+ * @details The payload is read in place from the mapped log.
+ */
+boolean RecLog_Take(RecLog_StreamType stream, const uint8 **data, uint8 *length);
+
+/* Tick of the next record of a stream; FALSE at the end of the stream */
+boolean RecLog_Peek(RecLog_StreamType stream, uint64 *tick);
+
+/* Input points; each returns what the stack sees */
+Std_ReturnType RecLog_CanReceive(CanSM_FdFrameType *frame, Std_ReturnType result);
+Std_ReturnType RecLog_CanTransmit(const CanSM_FdGatherType *frame, Std_ReturnType result);
+void RecLog_AdcResults(uint8 group, AdcIf_ValueType *results, uint8 count);
+uint8 RecLog_DioRead(uint8 channel, uint8 level);
+
+#endif /* RECLOG_H */
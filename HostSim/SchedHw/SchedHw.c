@@ -0,0 +1,88 @@
+/*
+ * SchedHw.c - Software Interrupt Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the host stand-in for the general
+ *              purpose service requests of the TC377 used by Sched: a
+ *              pending bit per rate group and the running priority, checked
+ *              by a dispatch event on the simulated timeline.
+ */
+
+#include "SchedHw.h"
+#include "Sched.h"
+#include "SimTime.h"
+
+/* Internal variables */
+static uint32 SchedHw_Pending = 0u;
+static uint32 SchedHw_Running = SCHED_MAX_GROUPS;   /* Running group, SCHED_MAX_GROUPS if none */
+static uint32 SchedHw_Nesting = 0u;
+static uint32 SchedHw_MaxNesting = 0u;
+static uint32 SchedHw_Dispatches = 0u;
+
+/**
+ * @brief   Take the pending requests of higher priority than the running group
+ */
+static void SchedHw_Dispatch(uint32 arg)
+{
+    uint32 group;
+    uint32 interrupted;
+
+    (void)arg;
+    for (;;)
+    {
+        for (group = 1u; group < SchedHw_Running; group++)
+        {
+            if ((SchedHw_Pending & (1u << group)) != 0u)
+            {
+                break;
+            }
+        }
+        if (group >= SchedHw_Running)
+        {
+            return;
+        }
+
+        SchedHw_Pending &= ~(1u << group);
+        interrupted = SchedHw_Running;
+        SchedHw_Running = group;
+        SchedHw_Nesting++;
+        SchedHw_MaxNesting = (SchedHw_Nesting > SchedHw_MaxNesting) ? SchedHw_Nesting : SchedHw_MaxNesting;
+        SchedHw_Dispatches++;
+
+        Sched_RunGroup((uint8)group);
+
+        SchedHw_Nesting--;
+        SchedHw_Running = interrupted;
+    }
+}
+
+void SchedHw_TriggerGroup(uint8 group)
+{
+    if (group == 0u || group >= SCHED_MAX_GROUPS)
+    {
+        return;
+    }
+    SchedHw_Pending |= 1u << group;
+    (void)SimTime_Schedule(SimTime_Now(), SchedHw_Dispatch, 0u);
+}
+
+void SchedHw_SimInit(void)
+{
+    SchedHw_Pending = 0u;
+    SchedHw_Running = SCHED_MAX_GROUPS;
+    SchedHw_Nesting = 0u;
+    SchedHw_MaxNesting = 0u;
+    SchedHw_Dispatches = 0u;
+}
+
+uint32 SchedHw_SimGetDispatches(void)
+{
+    return SchedHw_Dispatches;
+}
+
+uint32 SchedHw_SimGetMaxNesting(void)
+{
+    return SchedHw_MaxNesting;
+}
@@ -0,0 +1,37 @@
+/*
+ * SchedHw.h - Software Interrupt Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the software interrupt interface Sched
+ *              expects, plus host-only controls. Each rate group above 0
+ *              has a service request of its own priority, lower for higher
+ *              group numbers. A request is taken on the simulated timeline
+ *              once the code that raised it returns, and only if no group
+ *              of the same or higher priority is running; the handler calls
+ *              Sched_RunGroup. A handler that advances the simulated time is
+ *              preempted by the events due meanwhile, the base tick and the
+ *              requests of higher groups included.
+ */
+
+#ifndef SCHEDHW_H
+#define SCHEDHW_H
+
+#include "Std_Types.h"
+
+/* Driver interface used by Sched */
+void SchedHw_TriggerGroup(uint8 group);
+
+/* Host helpers */
+
+/* Clear the pending requests; none running */
+void SchedHw_SimInit(void);
+
+/* Requests taken so far */
+uint32 SchedHw_SimGetDispatches(void);
+
+/* Deepest nesting of group handlers seen */
+uint32 SchedHw_SimGetMaxNesting(void);
+
+#endif /* SCHEDHW_H */
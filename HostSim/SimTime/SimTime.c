@@ -0,0 +1,93 @@
+/*
+ * SimTime.c - Discrete-Event Timeline for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the simulated clock and its event
+ *              queue, kept as a small array sorted by due time
+ */
+
+#include "SimTime.h"
+
+typedef struct {
+    uint64 at;
+    SimTime_EventCallbackType callback;
+    uint32 arg;
+} SimTime_EventType;
+
+/* Internal variables */
+static uint64 SimTime_Ticks = 0u;
+static SimTime_EventType SimTime_Events[SIMTIME_MAX_EVENTS];
+static uint32 SimTime_EventCount = 0u;
+
+void SimTime_Init(void)
+{
+    SimTime_Ticks = 0u;
+    SimTime_EventCount = 0u;
+}
+
+uint64 SimTime_Now(void)
+{
+    return SimTime_Ticks;
+}
+
+Std_ReturnType SimTime_Schedule(uint64 at, SimTime_EventCallbackType callback, uint32 arg)
+{
+    uint32 pos;
+
+    if (SimTime_EventCount >= SIMTIME_MAX_EVENTS || callback == NULL_PTR)
+    {
+        return E_NOT_OK;
+    }
+
+    /* Keep the array sorted by due time, latest first, FIFO among equals */
+    pos = SimTime_EventCount;
+    while (pos > 0u && SimTime_Events[pos - 1u].at <= at)
+    {
+        SimTime_Events[pos] = SimTime_Events[pos - 1u];
+        pos--;
+    }
+    SimTime_Events[pos].at = at;
+    SimTime_Events[pos].callback = callback;
+    SimTime_Events[pos].arg = arg;
+    SimTime_EventCount++;
+    return E_OK;
+}
+
+void SimTime_Cancel(SimTime_EventCallbackType callback, uint32 arg)
+{
+    uint32 out = 0u;
+
+    for (uint32 i = 0; i < SimTime_EventCount; i++)
+    {
+        if (SimTime_Events[i].callback != callback || SimTime_Events[i].arg != arg)
+        {
+            SimTime_Events[out++] = SimTime_Events[i];
+        }
+    }
+    SimTime_EventCount = out;
+}
+
+void SimTime_Advance(uint64 ticks)
+{
+    uint64 end = SimTime_Ticks + ticks;
+    SimTime_EventType event;
+
+    /* The earliest event is at the end of the array */
+    while (SimTime_EventCount > 0u && SimTime_Events[SimTime_EventCount - 1u].at <= end)
+    {
+        event = SimTime_Events[--SimTime_EventCount];
+        if (event.at > SimTime_Ticks)
+        {
+            SimTime_Ticks = event.at;
+        }
+        event.callback(event.arg);
+    }
+
+    /* A callback that advanced the clock itself may have gone past the end */
+    if (SimTime_Ticks < end)
+    {
+        SimTime_Ticks = end;
+    }
+}
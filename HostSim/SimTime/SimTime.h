@@ -0,0 +1,43 @@
+/*
+ * SimTime.h - Discrete-Event Timeline for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the shared simulated clock. Hardware
+ *              models (PWM timer, ADC) schedule their events here so that
+ *              trigger, conversion and interrupt times line up on one
+ *              timeline measured in timer ticks.
+ */
+
+#ifndef SIMTIME_H
+#define SIMTIME_H
+
+#include "Std_Types.h"
+
+/* Simulated timer clock (GTM clock of the TC377) */
+#define SIMTIME_TICKS_PER_SECOND     (100000000u)
+
+/* Maximum number of pending events */
+#define SIMTIME_MAX_EVENTS           (32u)
+
+typedef void (*SimTime_EventCallbackType)(uint32 arg);
+
+void SimTime_Init(void);
+uint64 SimTime_Now(void);
+
+/**
+ * @brief   Schedule a callback at an absolute tick
+ * @details Events at the same tick run in scheduling order. Events in the
+ *          past run at the next SimTime_Advance.
+ * @return  E_NOT_OK if the event pool is exhausted
+ */
+Std_ReturnType SimTime_Schedule(uint64 at, SimTime_EventCallbackType callback, uint32 arg);
+
+/* Cancel all pending events with this callback and argument */
+void SimTime_Cancel(SimTime_EventCallbackType callback, uint32 arg);
+
+/* Advance the clock, running due events in time order */
+void SimTime_Advance(uint64 ticks);
+
+#endif /* SIMTIME_H */
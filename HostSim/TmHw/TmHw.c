@@ -0,0 +1,17 @@
+/*
+ * TmHw.c - Free-Running Timer Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the simulated STM, the lower word of
+ *              the SimTime clock
+ */
+
+#include "TmHw.h"
+#include "SimTime.h"
+
+uint32 TmHw_GetCounter(void)
+{
+    return (uint32)SimTime_Now();
+}
@@ -0,0 +1,19 @@
+/*
+ * TmHw.h - Free-Running Timer Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the timer interface Tm expects. The
+ *              simulated STM counts SimTime ticks.
+ */
+
+#ifndef TMHW_H
+#define TMHW_H
+
+#include "Std_Types.h"
+
+/* Driver interface used by Tm: lower 32 bits of the free-running timer */
+uint32 TmHw_GetCounter(void);
+
+#endif /* TMHW_H */
@@ -0,0 +1,76 @@
+/*
+ * WdgHw.c - Watchdog Timer Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains a timeout watchdog. Each trigger moves
+ *              the expiry event on the SimTime timeline; an expiry counts
+ *              a reset and calls the reset callback.
+ */
+
+#include "WdgHw.h"
+#include "SimTime.h"
+
+/* Internal variables */
+static uint64 WdgHw_Timeout = 0u;
+static boolean WdgHw_Running = FALSE;
+static uint32 WdgHw_Resets = 0u;
+static uint32 WdgHw_Triggers = 0u;
+static uint64 WdgHw_ResetTick = 0u;
+static WdgHw_SimResetCallbackType WdgHw_ResetCallback = NULL_PTR;
+
+/* Forward declarations */
+static void WdgHw_ExpireEvent(uint32 arg);
+
+void WdgHw_SimInit(uint64 timeoutTicks)
+{
+    SimTime_Cancel(WdgHw_ExpireEvent, 0u);
+
+    WdgHw_Timeout = timeoutTicks;
+    WdgHw_Running = TRUE;
+    (void)SimTime_Schedule(SimTime_Now() + WdgHw_Timeout, WdgHw_ExpireEvent, 0u);
+}
+
+void WdgHw_SimSetResetCallback(WdgHw_SimResetCallbackType callback)
+{
+    WdgHw_ResetCallback = callback;
+}
+
+uint32 WdgHw_SimGetResets(void)
+{
+    return WdgHw_Resets;
+}
+
+uint32 WdgHw_SimGetTriggers(void)
+{
+    return WdgHw_Triggers;
+}
+
+uint64 WdgHw_SimGetResetTick(void)
+{
+    return WdgHw_ResetTick;
+}
+
+void WdgHw_Trigger(void)
+{
+    if (WdgHw_Running == TRUE)
+    {
+        SimTime_Cancel(WdgHw_ExpireEvent, 0u);
+        (void)SimTime_Schedule(SimTime_Now() + WdgHw_Timeout, WdgHw_ExpireEvent, 0u);
+        WdgHw_Triggers++;
+    }
+}
+
+static void WdgHw_ExpireEvent(uint32 arg)
+{
+    (void)arg;
+
+    WdgHw_Running = FALSE;
+    WdgHw_Resets++;
+    WdgHw_ResetTick = SimTime_Now();
+    if (WdgHw_ResetCallback != NULL_PTR)
+    {
+        WdgHw_ResetCallback();
+    }
+}
@@ -0,0 +1,39 @@
+/*
+ * WdgHw.h - Watchdog Timer Model for the Host Simulation
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the watchdog driver interface WdgM
+ *              expects, plus host-only controls of a simulated timeout
+ *              watchdog. The timeout runs on the SimTime timeline.
+ */
+
+#ifndef WDGHW_H
+#define WDGHW_H
+
+#include "Std_Types.h"
+
+/* Called when the watchdog expires, in place of the ECU reset */
+typedef void (*WdgHw_SimResetCallbackType)(void);
+
+/* Driver interface used by WdgM */
+void WdgHw_Trigger(void);
+
+/* Host helpers */
+
+/**
+ * @brief   Start the watchdog
+ * @details It expires timeoutTicks after the start or the last trigger.
+ *          After an expiry it stays stopped until started again.
+ */
+void WdgHw_SimInit(uint64 timeoutTicks);
+
+void WdgHw_SimSetResetCallback(WdgHw_SimResetCallbackType callback);
+uint32 WdgHw_SimGetResets(void);
+uint32 WdgHw_SimGetTriggers(void);
+
+/* Tick of the last expiry */
+uint64 WdgHw_SimGetResetTick(void);
+
+#endif /* WDGHW_H */
@@ -14,6 +14,15 @@
 #include "Adc.h"
 #include "Pwm.h"
 #include "Gpt.h"
+#include "PwmIf.h"
+#include "AdcIf.h"
+#include "MotorObs.h"
+#include "Lut.h"
+#include "WdgM.h"
+#include "Tm.h"
+#include "SwTmr.h"
+#include "Idle.h"
+#include "Sched.h"
 
 /* Application states */
 typedef enum {
@@ -26,23 +35,46 @@ typedef enum {
 /* Global variables */
 App_StateType App_CurrentState = APP_STATE_INIT;
 
-/* ADC result buffers */
-#define ADC_GROUP0_BUFFER_SIZE    (3u)  /* U, V, W phase currents */
-#define ADC_GROUP1_BUFFER_SIZE    (4u)  /* DC link voltage and temperatures */
+/* ADC results are read in place from the AdcIf snapshots (group 0: U, V, W
+ * phase currents; group 1: DC link voltage and temperatures) */
 
-Adc_ValueType Adc_Group0_Results[ADC_GROUP0_BUFFER_SIZE];
-Adc_ValueType Adc_Group1_Results[ADC_GROUP1_BUFFER_SIZE];
+/* Supervision runs without a new group 1 block before the measurements are stale */
+#define APP_MEASUREMENT_STALE_RUNS    (3u)
+
+/* Generation of the group 1 snapshot last checked by the supervision */
+static uint32 App_MeasurementGeneration = 0u;
+static uint8 App_MeasurementStaleRuns = 0u;
+
+/* Duty cycles applied to the U, V, W phases (input of the observer) */
+static PwmIf_DutyType App_PhaseDuty[3];
+
+/* Duty command of the speed loop, read by the current loop */
+static PwmIf_DutyType App_DutyCommandBuffers[3];
+static Sched_ExchangeType App_DutyCommand;
+
+/* Error LED blink, toggled from the system tick */
+#define APP_ERROR_BLINK_MS        (250u)
+static SwTmr_TimerType App_ErrorBlinkTimer;
+
+/* Background loop event posted by ISRs that change the application state;
+ * buttons are polled on the Idle heartbeat */
+#define APP_EVENT_STATE           (0x00000002u)
 
 /* Function prototypes */
 static void App_Init(void);
 static void App_MainFunction(void);
 static void App_ProcessADCData(void);
+static void App_CurrentLoop(void);
+static void App_SpeedLoop(void);
 static void App_UpdatePWM(void);
 static void App_HandleErrors(void);
+static void App_ToggleErrorLed(uint32 arg);
 
 /* Interrupt handlers */
 static void Gpt_MotorControl_ISR(void);
 static void Adc_CurrentMeasurement_ISR(void);
+void Adc_GroupNotification_0(void);
+void Adc_GroupNotification_1(void);
 
 /* Main function */
 int main(void)
@@ -55,6 +87,12 @@ int main(void)
     {
         /* Run main application function */
         App_MainFunction();
+        
+        /* Main loop alive indication */
+        WdgM_CheckpointReached(WDGM_SE_BACKGROUND, WDGM_CP_BACKGROUND_LOOP);
+        
+        /* Sleep until the next heartbeat or state change */
+        (void)Idle_Wait();
     }
     
     return 0;
@@ -74,15 +112,39 @@ static void App_Init(void)
     
     /* Initialize PWM module - for motor phase control */
     Pwm_Init(&Pwm_Configuration);
+    PwmIf_Init();
     
     /* Initialize ADC module - for current and voltage measurements */
     Adc_Init(&Adc_Configuration);
-    Adc_SetupResultBuffer(ADC_GROUP_0, Adc_Group0_Results);
-    Adc_SetupResultBuffer(ADC_GROUP_1, Adc_Group1_Results);
+    AdcIf_Init();
+    
+    /* Initialize sensorless rotor position and speed observer */
+    MotorObs_Init();
     
     /* Initialize GPT module - for timing control */
     Gpt_Init(&Gpt_Configuration);
     
+    /* Initialize time base, extended to 64 bits on the system tick */
+    Tm_Init();
+    
+    /* Initialize idle management and CPU load accounting on the time base */
+    Idle_Init();
+    
+    /* Initialize software timers on the system tick */
+    SwTmr_Init();
+    SwTmr_Setup(&App_ErrorBlinkTimer, App_ToggleErrorLed, 0u);
+    
+    /* Initialize watchdog manager, supervising the main loop until the motor runs */
+    WdgM_Init();
+    
+    /* Rate groups on the current sample: current loop in the ADC interrupt,
+     * speed loop and supervision in software interrupts below it */
+    Sched_Init();
+    Sched_ExchangeInit(&App_DutyCommand, App_DutyCommandBuffers, sizeof(PwmIf_DutyType));
+    (void)Sched_AddRunnable(SCHED_GROUP_CURRENT, App_CurrentLoop);
+    (void)Sched_AddRunnable(SCHED_GROUP_SPEED, App_SpeedLoop);
+    (void)Sched_AddRunnable(SCHED_GROUP_SUPERVISION, App_ProcessADCData);
+    
     /* Set initial state */
     App_CurrentState = APP_STATE_IDLE;
     
@@ -93,12 +155,9 @@ static void App_Init(void)
     Gpt_StartTimer(GPT_CHANNEL_0, Gpt_Configuration.channels[GPT_CHANNEL_0].maxValue);
     Gpt_EnableNotification(GPT_CHANNEL_0);
     
-    /* Start motor control loop timer */
-    Gpt_StartTimer(GPT_CHANNEL_3, Gpt_Configuration.channels[GPT_CHANNEL_3].maxValue);
-    Gpt_EnableNotification(GPT_CHANNEL_3);
-    
-    /* Enable current measurement interrupts */
-    Adc_EnableGroupNotification(ADC_GROUP_0);
+    /* Enable conversion complete notifications; group 0 is the scheduler base tick */
+    AdcIf_RegisterGroupNotification(ADCIF_GROUP_0, Adc_GroupNotification_0);
+    AdcIf_RegisterGroupNotification(ADCIF_GROUP_1, Adc_GroupNotification_1);
 }
 
 /*
@@ -126,8 +185,16 @@ static void App_MainFunction(void)
                 Pwm_StartChannel(PWM_CHANNEL_PHASE_V);
                 Pwm_StartChannel(PWM_CHANNEL_PHASE_W);
                 
-                /* Start ADC conversions for current measurements */
-                Adc_StartGroupConversion(ADC_GROUP_0);
+                /* Supervise the control step and the measurement checks */
+                (void)WdgM_SetMode(WDGM_MODE_RUN);
+                
+                /* Group 1 was stopped while idle: start the staleness
+                 * check over instead of counting the idle time */
+                App_MeasurementGeneration = 0u;
+                App_MeasurementStaleRuns = 0u;
+                
+                /* Sample currents at the PWM center, group 1 chained */
+                AdcIf_EnableGroupTrigger();
                 
                 /* Change state to running */
                 App_CurrentState = APP_STATE_RUNNING;
@@ -135,25 +202,21 @@ static void App_MainFunction(void)
             break;
             
         case APP_STATE_RUNNING:
-            /* Process ADC data */
-            App_ProcessADCData();
-            
-            /* Update PWM signals */
-            App_UpdatePWM();
-            
-            /* Check if stop button is pressed */
+            /* Control runs from the ADC notifications, check if stop button is pressed */
             if (Dio_ReadChannel(DIO_CHANNEL_STOP_BUTTON) == STD_HIGH)
             {
                 /* Stop motor */
-                Pwm_StopChannel(PWM_CHANNEL_PHASE_U);
-                Pwm_StopChannel(PWM_CHANNEL_PHASE_V);
-                Pwm_StopChannel(PWM_CHANNEL_PHASE_W);
+                PwmIf_StopPhases();
+                App_PhaseDuty[0] = 0u;
+                App_PhaseDuty[1] = 0u;
+                App_PhaseDuty[2] = 0u;
                 
                 /* Disable motor */
                 Dio_WriteChannel(DIO_CHANNEL_MOTOR_ENABLE, STD_LOW);
                 
                 /* Stop ADC conversions */
-                Adc_StopGroupConversion(ADC_GROUP_0);
+                AdcIf_DisableGroupTrigger();
+                (void)WdgM_SetMode(WDGM_MODE_IDLE);
                 
                 /* Change state to idle */
                 App_CurrentState = APP_STATE_IDLE;
@@ -174,49 +237,96 @@ static void App_MainFunction(void)
 
 /*
  * @brief   Process ADC measurement data
- * @details This function processes the current and voltage measurements from ADC
+ * @details Supervision rate group (100 Hz). This function checks the
+ *          voltage and temperature measurements of the last group 1 block
+ *          (chained and filtered by AdcIf at 100 Hz). The NTC
+ *          readings fall with temperature, so they are linearized to
+ *          0.1 degC before the comparison with OVER_TEMPERATURE_THRESHOLD.
+ *          The snapshot is checked in place; the verdict only counts if
+ *          no newer blocks overwrote it meanwhile. Measurements that stop
+ *          being updated are treated as an error too.
  */
 static void App_ProcessADCData(void)
 {
-    /* Request voltage and temperature measurements periodically */
-    static uint32 counter = 0;
-    
-    /* Read group 0 results (phase currents) */
-    Adc_ReadGroup(ADC_GROUP_0, Adc_Group0_Results);
+    const AdcIf_SnapshotType *measurements;
+    uint32 generation;
+    boolean fault = FALSE;
     
-    /* Read group 1 results (DC link voltage and temperatures) every 10 control loops */
-    if (counter % 10 == 0)
+    do
     {
-        Adc_StartGroupConversion(ADC_GROUP_1);
-        Adc_ReadGroup(ADC_GROUP_1, Adc_Group1_Results);
+        measurements = AdcIf_GetSnapshot(ADCIF_GROUP_1, &generation);
+        if (measurements == NULL_PTR)
+        {
+            break;
+        }
         
         /* Check for over-temperature or over-voltage conditions */
-        if (Adc_Group1_Results[0] > OVER_VOLTAGE_THRESHOLD || 
-            Adc_Group1_Results[1] > OVER_TEMPERATURE_THRESHOLD ||
-            Adc_Group1_Results[2] > OVER_TEMPERATURE_THRESHOLD ||
-            Adc_Group1_Results[3] > OVER_TEMPERATURE_THRESHOLD)
+        fault = (measurements->values[0] > OVER_VOLTAGE_THRESHOLD ||
+                 Lut_Linearize(LUT_CURVE_NTC, measurements->values[1]) > OVER_TEMPERATURE_THRESHOLD ||
+                 Lut_Linearize(LUT_CURVE_NTC, measurements->values[2]) > OVER_TEMPERATURE_THRESHOLD ||
+                 Lut_Linearize(LUT_CURVE_NTC, measurements->values[3]) > OVER_TEMPERATURE_THRESHOLD)
+                ? TRUE : FALSE;
+    } while (AdcIf_SnapshotValid(measurements, generation) == FALSE);
+    
+    /* The same block as on the last run means group 1 has not completed since */
+    if (generation == App_MeasurementGeneration)
+    {
+        if (App_MeasurementStaleRuns < APP_MEASUREMENT_STALE_RUNS)
         {
-            App_CurrentState = APP_STATE_ERROR;
+            App_MeasurementStaleRuns++;
         }
+        fault = (App_MeasurementStaleRuns >= APP_MEASUREMENT_STALE_RUNS) ? TRUE : FALSE;
+    }
+    else
+    {
+        App_MeasurementGeneration = generation;
+        App_MeasurementStaleRuns = 0u;
     }
     
-    counter++;
+    if (fault == TRUE)
+    {
+        App_CurrentState = APP_STATE_ERROR;
+        Idle_SetEvent(APP_EVENT_STATE);
+    }
+    
+    WdgM_CheckpointReached(WDGM_SE_MEASUREMENT, WDGM_CP_MEASUREMENT);
+}
+
+/*
+ * @brief   Speed loop
+ * @details Speed rate group (1 kHz). Publishes the duty command for the
+ *          current loop.
+ */
+static void App_SpeedLoop(void)
+{
+    PwmIf_DutyType *command = (PwmIf_DutyType *)Sched_ExchangeWriteBuffer(&App_DutyCommand);
+    
+    /* Example: Simple open-loop control with fixed duty cycle */
+    /* In a real application, this would close the loop on MotorObs_GetMechanicalSpeed */
+    *command = 3000u;  /* Example duty cycle value (0-65535) */
+    Sched_ExchangePublish(&App_DutyCommand);
 }
 
 /*
  * @brief   Update PWM signals for motor control
- * @details This function updates the PWM duty cycles based on control algorithm
+ * @details This function applies the latest duty command of the speed loop
  */
 static void App_UpdatePWM(void)
 {
-    /* Example: Simple open-loop control with fixed duty cycle */
-    /* In a real application, this would use FOC or other control algorithm */
+    uint32 sequence;
+    uint16 dutyCycle = *(const PwmIf_DutyType *)Sched_ExchangeRead(&App_DutyCommand, &sequence);
     
-    uint16 dutyCycle = 3000;  /* Example duty cycle value (0-65535) */
+    /* No command before the first speed loop run */
+    if (sequence == 0u)
+    {
+        return;
+    }
     
-    Pwm_SetDutyCycle(PWM_CHANNEL_PHASE_U, dutyCycle);
-    Pwm_SetDutyCycle(PWM_CHANNEL_PHASE_V, dutyCycle);
-    Pwm_SetDutyCycle(PWM_CHANNEL_PHASE_W, dutyCycle);
+    /* All three phases are latched at the same period boundary */
+    PwmIf_SetPhaseDutyCycles(dutyCycle, dutyCycle, dutyCycle);
+    App_PhaseDuty[0] = dutyCycle;
+    App_PhaseDuty[1] = dutyCycle;
+    App_PhaseDuty[2] = dutyCycle;
 }
 
 /*
@@ -225,40 +335,53 @@ static void App_UpdatePWM(void)
  */
 static void App_HandleErrors(void)
 {
-    /* Stop PWM signals */
-    Pwm_StopChannel(PWM_CHANNEL_PHASE_U);
-    Pwm_StopChannel(PWM_CHANNEL_PHASE_V);
-    Pwm_StopChannel(PWM_CHANNEL_PHASE_W);
+    /* Stop PWM signals on all phases at once */
+    PwmIf_StopPhases();
+    AdcIf_DisableGroupTrigger();
+    
+    /* Only the error loop below is supervised from now on */
+    (void)WdgM_SetMode(WDGM_MODE_ERROR);
+    App_PhaseDuty[0] = 0u;
+    App_PhaseDuty[1] = 0u;
+    App_PhaseDuty[2] = 0u;
     
     /* Disable motor */
     Dio_WriteChannel(DIO_CHANNEL_MOTOR_ENABLE, STD_LOW);
     
-    /* Turn on error LED */
+    /* Turn on error LED and blink it */
     Dio_WriteChannel(DIO_CHANNEL_ERROR_LED, STD_HIGH);
+    (void)SwTmr_Start(&App_ErrorBlinkTimer, APP_ERROR_BLINK_MS / SWTMR_TICK_MS,
+                      APP_ERROR_BLINK_MS / SWTMR_TICK_MS);
     
     /* Wait for reset or user intervention */
     while (1)
     {
-        /* Blink error LED */
-        static uint32 blinkCounter = 0;
-        if (blinkCounter % 1000000 == 0)
-        {
-            Dio_WriteChannel(DIO_CHANNEL_ERROR_LED, 
-                            !Dio_ReadChannel(DIO_CHANNEL_ERROR_LED));
-        }
-        blinkCounter++;
+        WdgM_CheckpointReached(WDGM_SE_ERROR_HANDLER, WDGM_CP_ERROR_LOOP);
         
         /* Check if reset button is pressed */
         if (Dio_ReadChannel(DIO_CHANNEL_RESET_BUTTON) == STD_HIGH)
         {
             /* Reset error state */
+            SwTmr_Stop(&App_ErrorBlinkTimer);
             Dio_WriteChannel(DIO_CHANNEL_ERROR_LED, STD_LOW);
+            (void)WdgM_SetMode(WDGM_MODE_IDLE);
             App_CurrentState = APP_STATE_IDLE;
             break;
         }
+        
+        (void)Idle_Wait();
     }
 }
 
+/*
+ * @brief   Error LED blink timer callback
+ */
+static void App_ToggleErrorLed(uint32 arg)
+{
+    (void)arg;
+    Dio_WriteChannel(DIO_CHANNEL_ERROR_LED, !Dio_ReadChannel(DIO_CHANNEL_ERROR_LED));
+}
+
 /* Interrupt service routines */
 
 /*
@@ -267,47 +390,97 @@ static void App_HandleErrors(void)
  */
 void Gpt_Notification_0(void)
 {
-    /* System tick handling */
-    /* This could include: 
-     * - Updating system time
-     * - Handling timeouts
-     * - Managing periodic tasks
-     */
+    Idle_IsrEnter();
+    
+    /* Account for timer wraps of the 64-bit time base */
+    Tm_MainFunction();
+    
+    /* Run expired software timers */
+    SwTmr_MainFunction();
+    
+    /* Evaluate the supervised entities, trigger the watchdog if all are OK */
+    WdgM_MainFunction();
+    
+    /* Wake the background loop for its heartbeat, account the CPU load */
+    Idle_MainFunction();
 }
 
 /*
- * @brief   Motor control loop interrupt handler
- * @details This function is called at the motor control loop frequency (1kHz)
+ * @brief   Current measurement interrupt handler
+ * @details This function is called when the PWM triggered current measurement
+ *          is complete (every PWM period). It is the scheduler base tick:
+ *          the current loop runs here, the slower rate groups are released.
  */
-void Gpt_Notification_3(void)
+void Adc_GroupNotification_0(void)
 {
-    /* Run main application function in interrupt context */
-    /* In a real application, you might want to set a flag and process in main loop */
-    if (App_CurrentState == APP_STATE_RUNNING)
-    {
-        App_ProcessADCData();
-        App_UpdatePWM();
-    }
+    Idle_IsrEnter();
+    Sched_Tick();
 }
 
 /*
- * @brief   Current measurement interrupt handler
- * @details This function is called when current measurement ADC conversion is complete
+ * @brief   Speed loop software interrupt handler
+ * @details Raised by Sched_Tick every millisecond, below the ADC interrupt
  */
-void Adc_GroupNotification_0(void)
+void Gpsr_Notification_1(void)
+{
+    Idle_IsrEnter();
+    Sched_RunGroup(SCHED_GROUP_SPEED);
+}
+
+/*
+ * @brief   Supervision software interrupt handler
+ * @details Raised by Sched_Tick every 10 ms, below the speed loop
+ */
+void Gpsr_Notification_2(void)
 {
-    /* Read current measurements */
-    Adc_ReadGroup(ADC_GROUP_0, Adc_Group0_Results);
+    Idle_IsrEnter();
+    Sched_RunGroup(SCHED_GROUP_SUPERVISION);
+}
+
+/*
+ * @brief   Current loop
+ * @details Current rate group (20 kHz), run by Sched_Tick in the group 0
+ *          notification, so that its update is latched half a period after
+ *          the sample
+ */
+static void App_CurrentLoop(void)
+{
+    const AdcIf_SnapshotType *currents;
+    uint32 generation;
+    
+    /* Current measurements of this conversion; published just before, so
+     * no newer conversion can overwrite them while the loop runs. Fetched
+     * before the control step starts, so that an exit without them leaves
+     * no step open in the logical supervision */
+    currents = AdcIf_GetSnapshot(ADCIF_GROUP_0, &generation);
+    if (currents == NULL_PTR)
+    {
+        return;
+    }
+    
+    WdgM_CheckpointReached(WDGM_SE_CONTROL, WDGM_CP_CONTROL_START);
     
     /* Check for over-current conditions */
-    for (uint8 i = 0; i < ADC_GROUP0_BUFFER_SIZE; i++)
+    for (uint8 i = 0; i < ADCIF_GROUP0_CHANNELS; i++)
     {
-        if (Adc_Group0_Results[i] > OVER_CURRENT_THRESHOLD)
+        if (currents->values[i] > OVER_CURRENT_THRESHOLD)
         {
             App_CurrentState = APP_STATE_ERROR;
+            Idle_SetEvent(APP_EVENT_STATE);
             break;
         }
     }
+    
+    /* Rotor angle and speed from the currents and the applied voltages */
+    MotorObs_Update(currents->values, App_PhaseDuty[0], App_PhaseDuty[1], App_PhaseDuty[2]);
+    
+    /* Update must be written before the period ends to be latched with it */
+    if (App_CurrentState == APP_STATE_RUNNING)
+    {
+        App_UpdatePWM();
+    }
+    
+    WdgM_CheckpointReached(WDGM_SE_CONTROL, WDGM_CP_CONTROL_END);
 }
 
 /*
@@ -316,10 +489,17 @@ void Adc_GroupNotification_0(void)
  */
 void Adc_GroupNotification_1(void)
 {
-    /* Read voltage and temperature measurements */
-    Adc_ReadGroup(ADC_GROUP_1, Adc_Group1_Results);
+    const AdcIf_SnapshotType *measurements;
+    uint32 generation;
+    
+    Idle_IsrEnter();
     
-    /* Process measurements (could be done here or in main loop) */
+    /* DC link voltage for the observer; the checks run in the supervision */
+    measurements = AdcIf_GetSnapshot(ADCIF_GROUP_1, &generation);
+    if (measurements != NULL_PTR)
+    {
+        MotorObs_SetDcLinkVoltage(measurements->values[0]);
+    }
 }
 
 /*
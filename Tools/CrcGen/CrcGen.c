@@ -0,0 +1,140 @@
+/*
+ * CrcGen.c - CRC Table Generator
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Host tool run by the Makefile before the BSW is compiled.
+ *              Calculates the byte tables of the polynomials configured in
+ *              Crc_Cfg.h, and the three further CRC32 tables of slice-by-4,
+ *              and writes them as constant tables to Crc_Tables.c.
+ *
+ *              Usage: CrcGen <output file>
+ */
+
+#include <stdio.h>
+
+#include "Crc_Cfg.h"
+
+#define CRCGEN_VALUES_PER_LINE       (8u)
+
+static unsigned long CrcGen_Table8[256];
+static unsigned long CrcGen_Table8H2F[256];
+static unsigned long CrcGen_Table16[256];
+static unsigned long CrcGen_Table32[4][256];
+
+static void CrcGen_Calculate(void)
+{
+    unsigned long crc;
+
+    for (unsigned int k = 0; k < 256u; k++)
+    {
+        crc = k;
+        for (unsigned int bit = 0; bit < 8u; bit++)
+        {
+            crc = ((crc & 0x80u) != 0u) ? (((crc << 1) ^ CRC_8_POLYNOMIAL) & 0xFFu) : ((crc << 1) & 0xFFu);
+        }
+        CrcGen_Table8[k] = crc;
+
+        crc = k;
+        for (unsigned int bit = 0; bit < 8u; bit++)
+        {
+            crc = ((crc & 0x80u) != 0u) ? (((crc << 1) ^ CRC_8H2F_POLYNOMIAL) & 0xFFu) : ((crc << 1) & 0xFFu);
+        }
+        CrcGen_Table8H2F[k] = crc;
+
+        crc = (unsigned long)k << 8;
+        for (unsigned int bit = 0; bit < 8u; bit++)
+        {
+            crc = ((crc & 0x8000u) != 0u) ? (((crc << 1) ^ CRC_16_POLYNOMIAL) & 0xFFFFu) :
+                                            ((crc << 1) & 0xFFFFu);
+        }
+        CrcGen_Table16[k] = crc;
+
+        crc = k;
+        for (unsigned int bit = 0; bit < 8u; bit++)
+        {
+            crc = ((crc & 1u) != 0u) ? ((crc >> 1) ^ CRC_32_POLYNOMIAL_REFLECTED) : (crc >> 1);
+        }
+        CrcGen_Table32[0][k] = crc;
+    }
+
+    /* Table n: the CRC of a byte followed by n zero bytes */
+    for (unsigned int n = 1; n < 4u; n++)
+    {
+        for (unsigned int k = 0; k < 256u; k++)
+        {
+            crc = CrcGen_Table32[n - 1u][k];
+            CrcGen_Table32[n][k] = (crc >> 8) ^ CrcGen_Table32[0][crc & 0xFFu];
+        }
+    }
+}
+
+static void CrcGen_WriteValues(FILE *out, const char *indent, const unsigned long *values,
+                               unsigned int digits)
+{
+    for (unsigned int k = 0; k < 256u; k++)
+    {
+        if ((k % CRCGEN_VALUES_PER_LINE) == 0u)
+        {
+            fprintf(out, "%s", indent);
+        }
+        fprintf(out, "0x%0*lXu%s", (int)digits, values[k], (k + 1u < 256u) ? "," : "");
+        fprintf(out, "%s", ((k % CRCGEN_VALUES_PER_LINE) == CRCGEN_VALUES_PER_LINE - 1u) ? "\n" : " ");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    FILE *out;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <output file>\n", argv[0]);
+        return 1;
+    }
+    out = fopen(argv[1], "w");
+    if (out == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    CrcGen_Calculate();
+
+    fprintf(out, "/*\n * Crc_Tables.c - Generated by Tools/CrcGen from Crc_Cfg.h, do not edit\n */\n\n");
+    fprintf(out, "#include \"Crc_Cfg.h\"\n\n");
+
+    fprintf(out, "/* CRC8, polynomial 0x%02X */\n", CRC_8_POLYNOMIAL);
+    fprintf(out, "const uint8 Crc_Table8[256] = {\n");
+    CrcGen_WriteValues(out, "    ", CrcGen_Table8, 2u);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "/* CRC8H2F, polynomial 0x%02X */\n", CRC_8H2F_POLYNOMIAL);
+    fprintf(out, "const uint8 Crc_Table8H2F[256] = {\n");
+    CrcGen_WriteValues(out, "    ", CrcGen_Table8H2F, 2u);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "/* CRC16, polynomial 0x%04X */\n", CRC_16_POLYNOMIAL);
+    fprintf(out, "const uint16 Crc_Table16[256] = {\n");
+    CrcGen_WriteValues(out, "    ", CrcGen_Table16, 4u);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "/* CRC32, reflected polynomial 0x%08lX, slice-by-4 */\n",
+            (unsigned long)CRC_32_POLYNOMIAL_REFLECTED);
+    fprintf(out, "const uint32 Crc_Table32[4][256] = {\n");
+    for (unsigned int n = 0; n < 4u; n++)
+    {
+        fprintf(out, "    {\n");
+        CrcGen_WriteValues(out, "        ", CrcGen_Table32[n], 8u);
+        fprintf(out, "    }%s\n", (n + 1u < 4u) ? "," : "");
+    }
+    fprintf(out, "};\n");
+
+    if (fclose(out) != 0)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    return 0;
+}
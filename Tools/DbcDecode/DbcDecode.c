@@ -0,0 +1,1554 @@
+/*
+ * DbcDecode.c - Streaming DBC Decoder for Recorded CAN-FD Logs
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: This file contains the DBC parser, the compilation of the
+ *              extraction plans and the chunked decoder. A plan reduces a
+ *              signal to one unaligned 8-byte load, a shift and a mask, so
+ *              the per-frame work is a direct-indexed message lookup and a
+ *              few instructions per signal; parsing the log text is most of
+ *              the cost. Each chunk decodes into columns of its own, which
+ *              grow once and are reused, so threads share nothing but the
+ *              read-only database and mapping.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "DbcDecode.h"
+
+/* Input of one chunk; chunk boundaries fall on frame boundaries */
+#define DBCDECODE_CHUNK_SIZE         (8u * 1024u * 1024u)
+
+/* First rows of a message column of a chunk */
+#define DBCDECODE_INITIAL_ROWS       (4096u)
+
+/* Frame buffer: the longest frame and the 8-byte window after its last byte */
+#define DBCDECODE_FRAME_BUFFER       (DBCDECODE_MAX_DATA + 8u)
+
+/* RecLog log: see HostSim/RecLog/RecLog.c */
+#define DBCDECODE_RECLOG_MAGIC       (0x474F4C52u)   /* "RLOG" */
+#define DBCDECODE_RECLOG_VERSION     (1u)
+#define DBCDECODE_RECLOG_HEADER      (16u)
+#define DBCDECODE_RECLOG_RECORD      (6u)
+#define DBCDECODE_RECLOG_CAN_RX      (0u)
+#define DBCDECODE_RECLOG_CAN_HEADER  (5u)
+
+#define DBCDECODE_TOKEN_LENGTH       (DBCDECODE_COMMENT_LENGTH)
+
+typedef enum {
+    DBCDECODE_CANDUMP,
+    DBCDECODE_RECLOG
+} DbcDecode_FormatType;
+
+/* DBC text being parsed */
+typedef struct {
+    const char *p;
+    unsigned int line;
+} DbcDecode_CursorType;
+
+/* One chunk of the log and the columns decoded from it */
+typedef struct {
+    const DbcDecode_DatabaseType *db;
+    DbcDecode_FormatType format;
+    const unsigned char *begin;
+    const unsigned char *end;
+    unsigned long long startTick;    /* RecLog: tick of the record before the chunk */
+    double tickPeriod;
+    double **columns;
+    size_t rows[DBCDECODE_MAX_MESSAGES];
+    size_t capacity[DBCDECODE_MAX_MESSAGES];
+    unsigned long long frames;
+    unsigned long long decoded;
+    unsigned long long unknown;
+    unsigned long long malformed;
+    int failed;                      /* Out of memory */
+    pthread_t thread;
+} DbcDecode_ChunkType;
+
+/* Chunk boundaries, found before decoding */
+typedef struct {
+    size_t begin;
+    size_t end;
+    unsigned long long startTick;
+} DbcDecode_RangeType;
+
+/* Hex digit values; -1: not a digit */
+static signed char DbcDecode_Hex[256];
+
+static const double DbcDecode_Scale[10] = {1.0, 1e-1, 1e-2, 1e-3, 1e-4, 1e-5, 1e-6, 1e-7, 1e-8, 1e-9};
+
+/* ------------------------------------------------------------------------ */
+/* DBC parser                                                               */
+/* ------------------------------------------------------------------------ */
+
+static int DbcDecode_IsBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static int DbcDecode_IsSpecial(char c)
+{
+    return c != '\0' && strchr(":|@()[],;\"", c) != NULL;
+}
+
+static void DbcDecode_SkipBlank(DbcDecode_CursorType *cursor)
+{
+    while (DbcDecode_IsBlank(*cursor->p))
+    {
+        cursor->line += (*cursor->p == '\n') ? 1u : 0u;
+        cursor->p++;
+    }
+}
+
+/**
+ * @brief   Read the next token
+ * @return  0 at the end of the text, '"' for a string (without the quotes),
+ *          the character of a separator, or 'a' for a word or number
+ */
+static int DbcDecode_Next(DbcDecode_CursorType *cursor, char *token)
+{
+    size_t n = 0u;
+
+    DbcDecode_SkipBlank(cursor);
+    token[0] = '\0';
+    if (*cursor->p == '\0')
+    {
+        return 0;
+    }
+    if (*cursor->p == '"')
+    {
+        cursor->p++;
+        while (*cursor->p != '\0' && *cursor->p != '"')
+        {
+            if (*cursor->p == '\\' && cursor->p[1] != '\0')
+            {
+                cursor->p++;
+            }
+            cursor->line += (*cursor->p == '\n') ? 1u : 0u;
+            if (n < DBCDECODE_TOKEN_LENGTH - 1u)
+            {
+                token[n++] = *cursor->p;
+            }
+            cursor->p++;
+        }
+        cursor->p += (*cursor->p == '"') ? 1 : 0;
+        token[n] = '\0';
+        return '"';
+    }
+    if (DbcDecode_IsSpecial(*cursor->p))
+    {
+        token[0] = *cursor->p;
+        token[1] = '\0';
+        return *cursor->p++;
+    }
+    while (*cursor->p != '\0' && !DbcDecode_IsBlank(*cursor->p) && !DbcDecode_IsSpecial(*cursor->p))
+    {
+        if (n < DBCDECODE_TOKEN_LENGTH - 1u)
+        {
+            token[n++] = *cursor->p;
+        }
+        cursor->p++;
+    }
+    token[n] = '\0';
+    return 'a';
+}
+
+/* Skip to the end of the line, over strings that span lines */
+static void DbcDecode_SkipLine(DbcDecode_CursorType *cursor)
+{
+    while (*cursor->p != '\0' && *cursor->p != '\n')
+    {
+        if (*cursor->p == '"')
+        {
+            char token[DBCDECODE_TOKEN_LENGTH];
+            (void)DbcDecode_Next(cursor, token);
+        }
+        else
+        {
+            cursor->p++;
+        }
+    }
+}
+
+/* Skip to the ';' closing the statement */
+static void DbcDecode_SkipStatement(DbcDecode_CursorType *cursor)
+{
+    char token[DBCDECODE_TOKEN_LENGTH];
+    int kind;
+
+    do
+    {
+        kind = DbcDecode_Next(cursor, token);
+    } while (kind != 0 && kind != ';');
+}
+
+/* NS_ lists the keywords on the indented lines that follow it */
+static void DbcDecode_SkipNamespace(DbcDecode_CursorType *cursor)
+{
+    DbcDecode_SkipLine(cursor);
+    while (*cursor->p == '\n')
+    {
+        const char *next = cursor->p + 1;
+
+        if (*next != ' ' && *next != '\t' && *next != '\r' && *next != '\n')
+        {
+            break;
+        }
+        cursor->p = next;
+        cursor->line++;
+        DbcDecode_SkipLine(cursor);
+    }
+}
+
+static int DbcDecode_Number(const char *token, double *value)
+{
+    char *end;
+
+    *value = strtod(token, &end);
+    return (end != token && *end == '\0') ? 0 : -1;
+}
+
+static int DbcDecode_Integer(const char *token, unsigned long long *value)
+{
+    char *end;
+
+    *value = strtoull(token, &end, 10);
+    return (end != token && *end == '\0') ? 0 : -1;
+}
+
+static DbcDecode_MessageType *DbcDecode_MessageById(DbcDecode_DatabaseType *db, unsigned int id)
+{
+    for (unsigned int m = 0; m < db->messageCount; m++)
+    {
+        if (db->messages[m].id == id)
+        {
+            return &db->messages[m];
+        }
+    }
+    return NULL;
+}
+
+static DbcDecode_SignalType *DbcDecode_SignalByName(DbcDecode_MessageType *message, const char *name)
+{
+    for (unsigned int s = 0; (message != NULL) && (s < message->signalCount); s++)
+    {
+        if (strcmp(message->signals[s].name, name) == 0)
+        {
+            return &message->signals[s];
+        }
+    }
+    return NULL;
+}
+
+/* Copy a token into a name, cut to its size */
+static void DbcDecode_Copy(char *destination, const char *source, size_t size)
+{
+    size_t n = 0u;
+
+    while (n + 1u < size && source[n] != '\0')
+    {
+        destination[n] = source[n];
+        n++;
+    }
+    destination[n] = '\0';
+}
+
+/**
+ * @brief   Parse "<value> "<label>" ..." up to the closing ';'
+ */
+static int DbcDecode_ParseTable(DbcDecode_CursorType *cursor, DbcDecode_TableType *table)
+{
+    char token[DBCDECODE_TOKEN_LENGTH];
+    char label[DBCDECODE_TOKEN_LENGTH];
+    double value;
+
+    int kind;
+
+    table->count = 0u;
+    while ((kind = DbcDecode_Next(cursor, token)) == 'a')
+    {
+        if (DbcDecode_Number(token, &value) != 0 || DbcDecode_Next(cursor, label) != '"')
+        {
+            return -1;
+        }
+        if (table->count < DBCDECODE_MAX_VALUES)
+        {
+            table->values[table->count].value = (long long)value;
+            DbcDecode_Copy(table->values[table->count].label, label, DBCDECODE_NAME_LENGTH);
+            table->count++;
+        }
+    }
+    return (kind == ';') ? 0 : -1;
+}
+
+static int DbcDecode_ParseMessage(DbcDecode_CursorType *cursor, DbcDecode_DatabaseType *db,
+                                  DbcDecode_MessageType **current)
+{
+    char token[DBCDECODE_TOKEN_LENGTH];
+    char name[DBCDECODE_TOKEN_LENGTH];
+    unsigned long long id;
+    unsigned long long length;
+    DbcDecode_MessageType *message;
+
+    if (DbcDecode_Next(cursor, token) != 'a' || DbcDecode_Integer(token, &id) != 0 ||
+        DbcDecode_Next(cursor, name) != 'a' || DbcDecode_Next(cursor, token) != ':' ||
+        DbcDecode_Next(cursor, token) != 'a' || DbcDecode_Integer(token, &length) != 0)
+    {
+        return -1;
+    }
+    DbcDecode_SkipLine(cursor);
+
+    /* Holder of the signals not sent in any message */
+    if (strcmp(name, "VECTOR__INDEPENDENT_SIG_MSG") == 0)
+    {
+        *current = NULL;
+        return 0;
+    }
+    if (db->messageCount >= DBCDECODE_MAX_MESSAGES || length > DBCDECODE_MAX_DATA ||
+        DbcDecode_MessageById(db, (unsigned int)id) != NULL)
+    {
+        return -1;
+    }
+
+    message = &db->messages[db->messageCount++];
+    (void)memset(message, 0, sizeof(*message));
+    message->id = (unsigned int)id;
+    DbcDecode_Copy(message->name, name, sizeof(message->name));
+    message->length = (unsigned int)length;
+    message->multiplexor = -1;
+    *current = message;
+    return 0;
+}
+
+static int DbcDecode_ParseSignal(DbcDecode_CursorType *cursor, DbcDecode_MessageType *message)
+{
+    char token[DBCDECODE_TOKEN_LENGTH];
+    char name[DBCDECODE_TOKEN_LENGTH];
+    unsigned long long startBit;
+    unsigned long long bitLength;
+    DbcDecode_SignalType signal;
+    int kind;
+
+    (void)memset(&signal, 0, sizeof(signal));
+    signal.multiplexValue = -1;
+    signal.table = -1;
+
+    if (DbcDecode_Next(cursor, name) != 'a')
+    {
+        return -1;
+    }
+    kind = DbcDecode_Next(cursor, token);
+    if (kind == 'a')
+    {
+        /* Multiplexing: "M" for the multiplexor, "m<value>" for a multiplexed signal */
+        if (strcmp(token, "M") == 0)
+        {
+            signal.multiplexor = 1;
+        }
+        else if (token[0] == 'm')
+        {
+            signal.multiplexValue = strtoll(&token[1], NULL, 10);
+        }
+        kind = DbcDecode_Next(cursor, token);
+    }
+    if (kind != ':' ||
+        DbcDecode_Next(cursor, token) != 'a' || DbcDecode_Integer(token, &startBit) != 0 ||
+        DbcDecode_Next(cursor, token) != '|' ||
+        DbcDecode_Next(cursor, token) != 'a' || DbcDecode_Integer(token, &bitLength) != 0 ||
+        DbcDecode_Next(cursor, token) != '@' ||
+        DbcDecode_Next(cursor, token) != 'a' || (token[0] != '0' && token[0] != '1') ||
+        (token[1] != '+' && token[1] != '-'))
+    {
+        return -1;
+    }
+    signal.motorola = (token[0] == '0') ? 1 : 0;
+    signal.isSigned = (token[1] == '-') ? 1 : 0;
+
+    if (DbcDecode_Next(cursor, token) != '(' ||
+        DbcDecode_Next(cursor, token) != 'a' || DbcDecode_Number(token, &signal.factor) != 0 ||
+        DbcDecode_Next(cursor, token) != ',' ||
+        DbcDecode_Next(cursor, token) != 'a' || DbcDecode_Number(token, &signal.offset) != 0 ||
+        DbcDecode_Next(cursor, token) != ')' ||
+        DbcDecode_Next(cursor, token) != '[' ||
+        DbcDecode_Next(cursor, token) != 'a' || DbcDecode_Number(token, &signal.minimum) != 0 ||
+        DbcDecode_Next(cursor, token) != '|' ||
+        DbcDecode_Next(cursor, token) != 'a' || DbcDecode_Number(token, &signal.maximum) != 0 ||
+        DbcDecode_Next(cursor, token) != ']' ||
+        DbcDecode_Next(cursor, token) != '"')
+    {
+        return -1;
+    }
+    DbcDecode_Copy(signal.unit, token, sizeof(signal.unit));
+    DbcDecode_SkipLine(cursor);      /* Receivers */
+
+    if (message == NULL)
+    {
+        return 0;
+    }
+    if (bitLength == 0u || bitLength > 64u || startBit >= DBCDECODE_MAX_DATA * 8u ||
+        message->signalCount >= DBCDECODE_MAX_SIGNALS)
+    {
+        return -1;
+    }
+    DbcDecode_Copy(signal.name, name, sizeof(signal.name));
+    signal.startBit = (unsigned int)startBit;
+    signal.bitLength = (unsigned int)bitLength;
+    if (signal.multiplexor != 0)
+    {
+        message->multiplexor = (int)message->signalCount;
+    }
+    message->signals[message->signalCount++] = signal;
+    return 0;
+}
+
+static int DbcDecode_ParseValues(DbcDecode_CursorType *cursor, DbcDecode_DatabaseType *db)
+{
+    char token[DBCDECODE_TOKEN_LENGTH];
+    char name[DBCDECODE_TOKEN_LENGTH];
+    unsigned long long id;
+    DbcDecode_SignalType *signal;
+    DbcDecode_TableType *table;
+
+    if (DbcDecode_Next(cursor, token) != 'a')
+    {
+        return -1;
+    }
+    if (DbcDecode_Integer(token, &id) != 0)
+    {
+        /* Values of an environment variable */
+        DbcDecode_SkipStatement(cursor);
+        return 0;
+    }
+    if (DbcDecode_Next(cursor, name) != 'a' || db->tableCount >= DBCDECODE_MAX_TABLES)
+    {
+        return -1;
+    }
+    table = &db->tables[db->tableCount];
+    DbcDecode_Copy(table->name, name, sizeof(table->name));
+    if (DbcDecode_ParseTable(cursor, table) != 0)
+    {
+        return -1;
+    }
+    signal = DbcDecode_SignalByName(DbcDecode_MessageById(db, (unsigned int)id), name);
+    if (signal != NULL)
+    {
+        signal->table = (int)db->tableCount++;
+    }
+    return 0;
+}
+
+static int DbcDecode_ParseAttribute(DbcDecode_CursorType *cursor, DbcDecode_DatabaseType *db)
+{
+    char attribute[DBCDECODE_TOKEN_LENGTH];
+    char token[DBCDECODE_TOKEN_LENGTH];
+    unsigned long long id;
+    DbcDecode_MessageType *message;
+    int kind;
+
+    if (DbcDecode_Next(cursor, attribute) != '"')
+    {
+        return -1;
+    }
+    kind = DbcDecode_Next(cursor, token);
+    if (kind != 'a' || strcmp(token, "BO_") != 0)
+    {
+        /* Attribute of the network, a node or a signal */
+        if (kind != ';')
+        {
+            DbcDecode_SkipStatement(cursor);
+        }
+        return 0;
+    }
+    if (DbcDecode_Next(cursor, token) != 'a' || DbcDecode_Integer(token, &id) != 0)
+    {
+        return -1;
+    }
+    kind = DbcDecode_Next(cursor, token);
+    message = DbcDecode_MessageById(db, (unsigned int)id);
+    if (message != NULL)
+    {
+        if (strcmp(attribute, "CANFD_BRS") == 0)
+        {
+            message->brs = (strcmp(token, "YES") == 0 || strcmp(token, "1") == 0) ? 1 : 0;
+        }
+        else if (strcmp(attribute, "CANFD_DataRate") == 0 && kind == 'a')
+        {
+            message->dataRate = strtoul(token, NULL, 10);
+        }
+        else if (strcmp(attribute, "VFrameFormat") == 0 && kind == 'a')
+        {
+            /* StandardCAN_FD and ExtendedCAN_FD */
+            message->fd = (atoi(token) >= 14) ? 1 : message->fd;
+        }
+    }
+    if (kind != ';')
+    {
+        DbcDecode_SkipStatement(cursor);
+    }
+    return 0;
+}
+
+static int DbcDecode_ParseComment(DbcDecode_CursorType *cursor, DbcDecode_DatabaseType *db)
+{
+    char token[DBCDECODE_TOKEN_LENGTH];
+    unsigned long long id;
+    DbcDecode_MessageType *message;
+    int kind;
+
+    kind = DbcDecode_Next(cursor, token);
+    if (kind == 'a' && strcmp(token, "BO_") == 0)
+    {
+        if (DbcDecode_Next(cursor, token) != 'a' || DbcDecode_Integer(token, &id) != 0 ||
+            DbcDecode_Next(cursor, token) != '"')
+        {
+            return -1;
+        }
+        message = DbcDecode_MessageById(db, (unsigned int)id);
+        if (message != NULL)
+        {
+            DbcDecode_Copy(message->comment, token, sizeof(message->comment));
+        }
+    }
+    if (kind != ';')
+    {
+        DbcDecode_SkipStatement(cursor);
+    }
+    return 0;
+}
+
+static int DbcDecode_ParseValueType(DbcDecode_CursorType *cursor, DbcDecode_DatabaseType *db)
+{
+    char token[DBCDECODE_TOKEN_LENGTH];
+    char name[DBCDECODE_TOKEN_LENGTH];
+    unsigned long long id;
+    unsigned long long type;
+    DbcDecode_SignalType *signal;
+
+    if (DbcDecode_Next(cursor, token) != 'a' || DbcDecode_Integer(token, &id) != 0 ||
+        DbcDecode_Next(cursor, name) != 'a')
+    {
+        return -1;
+    }
+    (void)DbcDecode_Next(cursor, token);
+    if ((token[0] == ':' && DbcDecode_Next(cursor, token) != 'a') || DbcDecode_Integer(token, &type) != 0 ||
+        type > DBCDECODE_FLOAT64)
+    {
+        return -1;
+    }
+    signal = DbcDecode_SignalByName(DbcDecode_MessageById(db, (unsigned int)id), name);
+    if (signal != NULL)
+    {
+        signal->valueType = (unsigned int)type;
+        if ((type == DBCDECODE_FLOAT32 && signal->bitLength != 32u) ||
+            (type == DBCDECODE_FLOAT64 && signal->bitLength != 64u))
+        {
+            return -1;
+        }
+    }
+    DbcDecode_SkipStatement(cursor);
+    return 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Extraction plans                                                         */
+/* ------------------------------------------------------------------------ */
+
+static void DbcDecode_Compile(DbcDecode_SignalType *signal)
+{
+    DbcDecode_PlanType *plan = &signal->plan;
+    unsigned int position;
+
+    plan->mask = (signal->bitLength == 64u) ? ~0ull : ((1ull << signal->bitLength) - 1u);
+    plan->signBit = (signal->isSigned != 0) ? (1ull << (signal->bitLength - 1u)) : 0u;
+    if (signal->motorola == 0)
+    {
+        /* Start bit is the LSB; little endian window */
+        plan->byteOffset = signal->startBit / 8u;
+        plan->shift = signal->startBit % 8u;
+        plan->needed = (signal->startBit + signal->bitLength + 7u) / 8u;
+        plan->bigEndian = 0;
+        plan->wide = (plan->shift + signal->bitLength > 64u) ? 1 : 0;
+    }
+    else
+    {
+        /* Start bit is the MSB, numbered within its byte from bit 0 up; the
+         * position is counted from the MSB of byte 0 down */
+        position = (signal->startBit / 8u) * 8u + (7u - (signal->startBit % 8u));
+        plan->byteOffset = position / 8u;
+        plan->needed = (position + signal->bitLength + 7u) / 8u;
+        plan->bigEndian = 1;
+        plan->wide = ((position % 8u) + signal->bitLength > 64u) ? 1 : 0;
+        plan->shift = (plan->wide == 0) ? (64u - (position % 8u) - signal->bitLength) : 0u;
+    }
+}
+
+int DbcDecode_Load(const char *path, DbcDecode_DatabaseType *db, char *error, size_t errorSize)
+{
+    char token[DBCDECODE_TOKEN_LENGTH];
+    DbcDecode_CursorType cursor;
+    DbcDecode_MessageType *current = NULL;
+    FILE *file;
+    char *text;
+    long size;
+    unsigned int line;
+    int result = 0;
+    int kind;
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        (void)snprintf(error, errorSize, "%s: %s", path, strerror(errno));
+        return -1;
+    }
+    (void)fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    (void)fseek(file, 0, SEEK_SET);
+    text = (size >= 0) ? malloc((size_t)size + 1u) : NULL;
+    if (text == NULL || fread(text, 1u, (size_t)size, file) != (size_t)size)
+    {
+        (void)snprintf(error, errorSize, "%s: cannot be read", path);
+        (void)fclose(file);
+        free(text);
+        return -1;
+    }
+    (void)fclose(file);
+    text[size] = '\0';
+
+    (void)memset(db, 0, sizeof(*db));
+    cursor.p = text;
+    cursor.line = 1u;
+    while (result == 0)
+    {
+        kind = DbcDecode_Next(&cursor, token);
+        line = cursor.line;
+        if (kind == 0)
+        {
+            break;
+        }
+        if (strcmp(token, "BO_") == 0)
+        {
+            result = DbcDecode_ParseMessage(&cursor, db, &current);
+        }
+        else if (strcmp(token, "SG_") == 0)
+        {
+            result = DbcDecode_ParseSignal(&cursor, current);
+        }
+        else if (strcmp(token, "VAL_TABLE_") == 0)
+        {
+            if (db->tableCount >= DBCDECODE_MAX_TABLES || DbcDecode_Next(&cursor, token) != 'a')
+            {
+                result = -1;
+            }
+            else
+            {
+                DbcDecode_Copy(db->tables[db->tableCount].name, token, DBCDECODE_NAME_LENGTH);
+                result = DbcDecode_ParseTable(&cursor, &db->tables[db->tableCount]);
+                db->tableCount++;
+            }
+        }
+        else if (strcmp(token, "VAL_") == 0)
+        {
+            result = DbcDecode_ParseValues(&cursor, db);
+        }
+        else if (strcmp(token, "BA_") == 0)
+        {
+            result = DbcDecode_ParseAttribute(&cursor, db);
+        }
+        else if (strcmp(token, "CM_") == 0)
+        {
+            result = DbcDecode_ParseComment(&cursor, db);
+        }
+        else if (strcmp(token, "SIG_VALTYPE_") == 0)
+        {
+            result = DbcDecode_ParseValueType(&cursor, db);
+        }
+        else if (strcmp(token, "NS_") == 0)
+        {
+            DbcDecode_SkipNamespace(&cursor);
+        }
+        else
+        {
+            DbcDecode_SkipLine(&cursor);
+        }
+        if (result != 0)
+        {
+            (void)snprintf(error, errorSize, "%s:%u: cannot parse %s", path, line, token);
+        }
+    }
+    free(text);
+    if (result != 0)
+    {
+        return -1;
+    }
+
+    /* Value tables named after a signal describe it unless VAL_ does */
+    for (unsigned int t = 0; t < db->tableCount; t++)
+    {
+        for (unsigned int m = 0; m < db->messageCount; m++)
+        {
+            DbcDecode_SignalType *signal = DbcDecode_SignalByName(&db->messages[m], db->tables[t].name);
+
+            if (signal != NULL && signal->table < 0)
+            {
+                signal->table = (int)t;
+            }
+        }
+    }
+
+    (void)memset(db->direct, 0xFF, sizeof(db->direct));
+    for (unsigned int m = 0; m < db->messageCount; m++)
+    {
+        DbcDecode_MessageType *message = &db->messages[m];
+
+        message->fd = (message->fd != 0 || message->brs != 0 || message->length > 8u) ? 1 : 0;
+        message->column = db->columnCount;
+        db->columnCount += 1u + message->signalCount;
+        for (unsigned int s = 0; s < message->signalCount; s++)
+        {
+            DbcDecode_Compile(&message->signals[s]);
+            if (message->signals[s].plan.needed > DBCDECODE_MAX_DATA)
+            {
+                (void)snprintf(error, errorSize, "%s: %s.%s lies outside a 64-byte frame", path, message->name,
+                               message->signals[s].name);
+                return -1;
+            }
+        }
+        if ((message->id & DBCDECODE_EXTENDED) == 0u && message->id < DBCDECODE_DIRECT_IDS)
+        {
+            db->direct[message->id] = (short)m;
+        }
+    }
+    return 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Decoder                                                                  */
+/* ------------------------------------------------------------------------ */
+
+const DbcDecode_MessageType *DbcDecode_Find(const DbcDecode_DatabaseType *db, unsigned int id)
+{
+    if (id < DBCDECODE_DIRECT_IDS)
+    {
+        return (db->direct[id] >= 0) ? &db->messages[db->direct[id]] : NULL;
+    }
+    for (unsigned int m = 0; m < db->messageCount; m++)
+    {
+        if (db->messages[m].id == id)
+        {
+            return &db->messages[m];
+        }
+    }
+    return NULL;
+}
+
+static unsigned long long DbcDecode_Window(const unsigned char *data, int bigEndian)
+{
+    unsigned long long window;
+
+    (void)memcpy(&window, data, sizeof(window));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return (bigEndian != 0) ? window : __builtin_bswap64(window);
+#else
+    return (bigEndian != 0) ? __builtin_bswap64(window) : window;
+#endif
+}
+
+/* Raw value of a signal longer than its window allows, bit by bit */
+static unsigned long long DbcDecode_Wide(const DbcDecode_SignalType *signal, const unsigned char *data)
+{
+    unsigned long long raw = 0u;
+    unsigned int bit;
+
+    if (signal->motorola == 0)
+    {
+        for (unsigned int i = 0; i < signal->bitLength; i++)
+        {
+            bit = signal->startBit + i;
+            raw |= (unsigned long long)((data[bit / 8u] >> (bit % 8u)) & 1u) << i;
+        }
+    }
+    else
+    {
+        bit = (signal->startBit / 8u) * 8u + (7u - (signal->startBit % 8u));
+        for (unsigned int i = 0; i < signal->bitLength; i++, bit++)
+        {
+            raw = (raw << 1) | ((data[bit / 8u] >> (7u - (bit % 8u))) & 1u);
+        }
+    }
+    return raw;
+}
+
+static inline unsigned long long DbcDecode_Raw(const DbcDecode_SignalType *signal, const unsigned char *data)
+{
+    const DbcDecode_PlanType *plan = &signal->plan;
+
+    if (plan->wide != 0)
+    {
+        return DbcDecode_Wide(signal, data);
+    }
+    return (DbcDecode_Window(&data[plan->byteOffset], plan->bigEndian) >> plan->shift) & plan->mask;
+}
+
+static inline double DbcDecode_Physical(const DbcDecode_SignalType *signal, unsigned long long raw)
+{
+    double value;
+
+    if (signal->valueType == DBCDECODE_FLOAT32)
+    {
+        unsigned int bits = (unsigned int)raw;
+        float single;
+
+        (void)memcpy(&single, &bits, sizeof(single));
+        value = single;
+    }
+    else if (signal->valueType == DBCDECODE_FLOAT64)
+    {
+        (void)memcpy(&value, &raw, sizeof(value));
+    }
+    else if ((raw & signal->plan.signBit) != 0u)
+    {
+        value = (double)(long long)(raw | ~signal->plan.mask);
+    }
+    else
+    {
+        value = (double)raw;
+    }
+    return value * signal->factor + signal->offset;
+}
+
+/**
+ * @brief   Decode one frame into the columns of its message
+ * @param   data  Frame in a buffer of DBCDECODE_FRAME_BUFFER bytes
+ */
+static void DbcDecode_Frame(DbcDecode_ChunkType *chunk, unsigned int id, const unsigned char *data,
+                            unsigned int length, double time)
+{
+    const DbcDecode_DatabaseType *db = chunk->db;
+    const DbcDecode_MessageType *message;
+    unsigned long long muxValue = 0u;
+    unsigned int index;
+    size_t row;
+
+    chunk->frames++;
+    message = (id < DBCDECODE_DIRECT_IDS) ? ((db->direct[id] >= 0) ? &db->messages[db->direct[id]] : NULL)
+                                          : DbcDecode_Find(db, id);
+    if (message == NULL)
+    {
+        chunk->unknown++;
+        return;
+    }
+    index = (unsigned int)(message - db->messages);
+    row = chunk->rows[index];
+
+    /* All columns of a message grow together */
+    if (row == chunk->capacity[index])
+    {
+        size_t capacity = (row == 0u) ? DBCDECODE_INITIAL_ROWS : 2u * row;
+
+        for (unsigned int c = 0; c <= message->signalCount; c++)
+        {
+            double *column = realloc(chunk->columns[message->column + c], capacity * sizeof(double));
+
+            if (column == NULL)
+            {
+                chunk->failed = 1;
+                return;
+            }
+            chunk->columns[message->column + c] = column;
+        }
+        chunk->capacity[index] = capacity;
+    }
+
+    chunk->decoded++;
+    chunk->columns[message->column][row] = time;
+    if (message->multiplexor >= 0)
+    {
+        muxValue = DbcDecode_Raw(&message->signals[message->multiplexor], data);
+    }
+    for (unsigned int s = 0; s < message->signalCount; s++)
+    {
+        const DbcDecode_SignalType *signal = &message->signals[s];
+        double value = NAN;
+
+        if (signal->plan.needed <= length &&
+            (signal->multiplexValue < 0 || (unsigned long long)signal->multiplexValue == muxValue))
+        {
+            value = DbcDecode_Physical(signal, DbcDecode_Raw(signal, data));
+        }
+        chunk->columns[message->column + 1u + s][row] = value;
+    }
+    chunk->rows[index] = row + 1u;
+}
+
+double DbcDecode_Signal(const DbcDecode_MessageType *message, unsigned int signal, const unsigned char *data,
+                        unsigned int length)
+{
+    unsigned char frame[DBCDECODE_FRAME_BUFFER] = {0u};
+    const DbcDecode_SignalType *entry = &message->signals[signal];
+
+    length = (length > DBCDECODE_MAX_DATA) ? DBCDECODE_MAX_DATA : length;
+    (void)memcpy(frame, data, length);
+    if (entry->plan.needed > length)
+    {
+        return NAN;
+    }
+    if (entry->multiplexValue >= 0 &&
+        DbcDecode_Raw(&message->signals[message->multiplexor], frame) != (unsigned long long)entry->multiplexValue)
+    {
+        return NAN;
+    }
+    return DbcDecode_Physical(entry, DbcDecode_Raw(entry, frame));
+}
+
+/**
+ * @brief   Decode the candump lines of a chunk
+ * @details "(<seconds>.<fraction>) <interface> <ID>#<data>" for classic
+ *          frames, "<ID>##<flags><data>" for CAN-FD frames; 3 ID digits
+ *          for standard IDs, 8 for extended IDs.
+ */
+static void DbcDecode_Candump(DbcDecode_ChunkType *chunk)
+{
+    unsigned char data[DBCDECODE_FRAME_BUFFER];
+    const unsigned char *p = chunk->begin;
+    const unsigned char *end = chunk->end;
+    const unsigned char *line;
+    unsigned long long seconds;
+    unsigned long long fraction;
+    double time;
+    unsigned int digits;
+    unsigned int id;
+    unsigned int length;
+    int high;
+    int low;
+
+    while (p < end && chunk->failed == 0)
+    {
+        line = memchr(p, '\n', (size_t)(end - p));
+        line = (line != NULL) ? line : end;
+
+        while (p < line && (*p == ' ' || *p == '\t' || *p == '\r'))
+        {
+            p++;
+        }
+        if (p == line)
+        {
+            p = line + 1;
+            continue;
+        }
+
+        /* Time stamp */
+        if (*p++ != '(')
+        {
+            goto malformed;
+        }
+        seconds = 0u;
+        while (p < line && *p >= '0' && *p <= '9')
+        {
+            seconds = seconds * 10u + (unsigned int)(*p++ - '0');
+        }
+        fraction = 0u;
+        digits = 0u;
+        if (p < line && *p == '.')
+        {
+            p++;
+            while (p < line && *p >= '0' && *p <= '9')
+            {
+                if (digits < 9u)
+                {
+                    fraction = fraction * 10u + (unsigned int)(*p - '0');
+                    digits++;
+                }
+                p++;
+            }
+        }
+        if (p + 2 >= line || p[0] != ')' || p[1] != ' ')
+        {
+            goto malformed;
+        }
+        time = (double)seconds + (double)fraction * DbcDecode_Scale[digits];
+        p += 2;
+
+        /* Interface */
+        while (p < line && *p != ' ')
+        {
+            p++;
+        }
+        p++;
+
+        /* ID */
+        id = 0u;
+        digits = 0u;
+        while (p < line && DbcDecode_Hex[*p] >= 0)
+        {
+            id = (id << 4) | (unsigned int)DbcDecode_Hex[*p++];
+            digits++;
+        }
+        if (p >= line || *p++ != '#' || digits == 0u || digits > 8u)
+        {
+            goto malformed;
+        }
+        id = (digits > 3u) ? (id | DBCDECODE_EXTENDED) : id;
+        if (p < line && *p == '#')
+        {
+            /* CAN-FD flags nibble */
+            if (p + 1 >= line || DbcDecode_Hex[p[1]] < 0)
+            {
+                goto malformed;
+            }
+            p += 2;
+        }
+        else if (p < line && *p == 'R')
+        {
+            /* Remote frame: no data to decode */
+            chunk->frames++;
+            p = line + 1;
+            continue;
+        }
+
+        length = 0u;
+        while (p + 1 < line && length < DBCDECODE_MAX_DATA)
+        {
+            if ((high = DbcDecode_Hex[p[0]]) < 0 || (low = DbcDecode_Hex[p[1]]) < 0)
+            {
+                break;
+            }
+            data[length++] = (unsigned char)((high << 4) | low);
+            p += 2;
+        }
+        if (p < line && *p != ' ' && *p != '\r')
+        {
+            goto malformed;
+        }
+
+        DbcDecode_Frame(chunk, id, data, length, time);
+        p = line + 1;
+        continue;
+
+    malformed:
+        chunk->malformed++;
+        p = line + 1;
+    }
+}
+
+static unsigned int DbcDecode_Get32(const unsigned char *data)
+{
+    return (unsigned int)data[0] | ((unsigned int)data[1] << 8) | ((unsigned int)data[2] << 16) |
+           ((unsigned int)data[3] << 24);
+}
+
+/* Decode the CAN_RX records of a RecLog chunk; the other streams are skipped */
+static void DbcDecode_RecLog(DbcDecode_ChunkType *chunk)
+{
+    unsigned char data[DBCDECODE_FRAME_BUFFER];
+    const unsigned char *p = chunk->begin;
+    unsigned long long tick = chunk->startTick;
+    unsigned int length;
+
+    while (p < chunk->end && chunk->failed == 0)
+    {
+        if ((size_t)(chunk->end - p) < DBCDECODE_RECLOG_RECORD ||
+            (size_t)(chunk->end - p) < DBCDECODE_RECLOG_RECORD + p[5])
+        {
+            chunk->malformed++;
+            break;
+        }
+        tick += DbcDecode_Get32(p);
+        length = p[5];
+        if (p[4] == DBCDECODE_RECLOG_CAN_RX)
+        {
+            if (length < DBCDECODE_RECLOG_CAN_HEADER || length - DBCDECODE_RECLOG_CAN_HEADER > DBCDECODE_MAX_DATA)
+            {
+                chunk->malformed++;
+            }
+            else
+            {
+                (void)memcpy(data, &p[DBCDECODE_RECLOG_RECORD + DBCDECODE_RECLOG_CAN_HEADER],
+                             length - DBCDECODE_RECLOG_CAN_HEADER);
+                DbcDecode_Frame(chunk, DbcDecode_Get32(&p[DBCDECODE_RECLOG_RECORD]), data,
+                                length - DBCDECODE_RECLOG_CAN_HEADER, (double)tick * chunk->tickPeriod);
+            }
+        }
+        p += DBCDECODE_RECLOG_RECORD + length;
+    }
+}
+
+static void *DbcDecode_Worker(void *argument)
+{
+    DbcDecode_ChunkType *chunk = argument;
+
+    (void)memset(chunk->rows, 0, sizeof(chunk->rows));
+    chunk->frames = 0u;
+    chunk->decoded = 0u;
+    chunk->unknown = 0u;
+    chunk->malformed = 0u;
+    if (chunk->format == DBCDECODE_RECLOG)
+    {
+        DbcDecode_RecLog(chunk);
+    }
+    else
+    {
+        DbcDecode_Candump(chunk);
+    }
+    return NULL;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Log files                                                                */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief   Split the log into chunks at frame boundaries
+ * @details Candump chunks end after a newline. RecLog records carry the
+ *          tick delta to the previous record and nothing marks their
+ *          start, so the record headers are walked once, which touches
+ *          one cache line per record, to find the boundaries and the tick
+ *          each chunk starts from.
+ * @return  Number of chunks; the ranges are allocated for the caller
+ */
+static size_t DbcDecode_Split(const unsigned char *map, size_t size, DbcDecode_FormatType format,
+                              DbcDecode_RangeType **ranges)
+{
+    size_t capacity = size / DBCDECODE_CHUNK_SIZE + 2u;
+    size_t count = 0u;
+    size_t position;
+    size_t next;
+    unsigned long long tick = 0u;
+
+    *ranges = malloc(capacity * sizeof(DbcDecode_RangeType));
+    if (*ranges == NULL)
+    {
+        return 0u;
+    }
+
+    position = (format == DBCDECODE_RECLOG) ? DBCDECODE_RECLOG_HEADER : 0u;
+    while (position < size)
+    {
+        (*ranges)[count].begin = position;
+        (*ranges)[count].startTick = tick;
+        if (format == DBCDECODE_RECLOG)
+        {
+            next = position;
+            while (next < size && next - position < DBCDECODE_CHUNK_SIZE)
+            {
+                if (size - next < DBCDECODE_RECLOG_RECORD)
+                {
+                    next = size;
+                    break;
+                }
+                tick += DbcDecode_Get32(&map[next]);
+                next += DBCDECODE_RECLOG_RECORD + map[next + 5u];
+            }
+            next = (next > size) ? size : next;
+        }
+        else
+        {
+            const unsigned char *newline;
+
+            next = position + DBCDECODE_CHUNK_SIZE;
+            newline = (next < size) ? memchr(&map[next], '\n', size - next) : NULL;
+            next = (newline != NULL) ? (size_t)(newline - map) + 1u : size;
+        }
+        (*ranges)[count].end = next;
+        count++;
+        position = next;
+    }
+    return count;
+}
+
+typedef struct {
+    const DbcDecode_DatabaseType *db;
+    const char *directory;
+    int *files;                  /* Per column; -1: not open */
+} DbcDecode_OutputType;
+
+static void DbcDecode_ColumnPath(const DbcDecode_OutputType *output, unsigned int column, char *path, size_t size)
+{
+    const DbcDecode_MessageType *message = NULL;
+
+    for (unsigned int m = 0; m < output->db->messageCount; m++)
+    {
+        if (column >= output->db->messages[m].column)
+        {
+            message = &output->db->messages[m];
+        }
+    }
+    if (column == message->column)
+    {
+        (void)snprintf(path, size, "%s/%s.time.f64", output->directory, message->name);
+    }
+    else
+    {
+        (void)snprintf(path, size, "%s/%s.%s.f64", output->directory, message->name,
+                       message->signals[column - message->column - 1u].name);
+    }
+}
+
+static int DbcDecode_Open(DbcDecode_OutputType *output, unsigned int column, char *error, size_t errorSize)
+{
+    char path[1024];
+
+    if (output->files[column] < 0)
+    {
+        DbcDecode_ColumnPath(output, column, path, sizeof(path));
+        output->files[column] = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (output->files[column] < 0)
+        {
+            (void)snprintf(error, errorSize, "%s: %s", path, strerror(errno));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Append the columns of a chunk to the column files */
+static int DbcDecode_Write(DbcDecode_OutputType *output, const DbcDecode_ChunkType *chunk, char *error,
+                           size_t errorSize)
+{
+    const DbcDecode_DatabaseType *db = output->db;
+
+    for (unsigned int m = 0; m < db->messageCount; m++)
+    {
+        const DbcDecode_MessageType *message = &db->messages[m];
+
+        if (chunk->rows[m] == 0u)
+        {
+            continue;
+        }
+        for (unsigned int c = message->column; c <= message->column + message->signalCount; c++)
+        {
+            const char *data = (const char *)chunk->columns[c];
+            size_t remaining = chunk->rows[m] * sizeof(double);
+            ssize_t written;
+
+            if (DbcDecode_Open(output, c, error, errorSize) != 0)
+            {
+                return -1;
+            }
+            while (remaining > 0u)
+            {
+                written = write(output->files[c], data, remaining);
+                if (written <= 0)
+                {
+                    (void)snprintf(error, errorSize, "%s: %s", output->directory, strerror(errno));
+                    return -1;
+                }
+                data += written;
+                remaining -= (size_t)written;
+            }
+        }
+    }
+    return 0;
+}
+
+static void DbcDecode_Quoted(FILE *file, const char *text)
+{
+    fputc('"', file);
+    for (; *text != '\0'; text++)
+    {
+        if (*text == '"' || *text == '\\')
+        {
+            fputc('\\', file);
+        }
+        fputc((*text == '\n') ? ' ' : *text, file);
+    }
+    fputc('"', file);
+}
+
+/**
+ * @brief   Describe the columns in columns.txt and create the empty ones
+ */
+static int DbcDecode_Manifest(DbcDecode_OutputType *output, const char *logPath,
+                              const DbcDecode_StatisticsType *stats, char *error, size_t errorSize)
+{
+    const DbcDecode_DatabaseType *db = output->db;
+    char path[1024];
+    FILE *file;
+
+    for (unsigned int c = 0; c < db->columnCount; c++)
+    {
+        if (DbcDecode_Open(output, c, error, errorSize) != 0)
+        {
+            return -1;
+        }
+    }
+
+    (void)snprintf(path, sizeof(path), "%s/columns.txt", output->directory);
+    file = fopen(path, "w");
+    if (file == NULL)
+    {
+        (void)snprintf(error, errorSize, "%s: %s", path, strerror(errno));
+        return -1;
+    }
+    fprintf(file, "# Decoded by DbcDecode from %s\n", logPath);
+    fprintf(file, "# Columns are float64, little endian, one file per column; NaN: not in the frame\n");
+    fprintf(file, "# message <name> <ID> <length> <classic|fd> <brs> <data rate> <rows> <comment>\n");
+    fprintf(file, "# column <file> <unit> <factor> <offset> <minimum> <maximum> [<value>=<label>,...]\n");
+    for (unsigned int m = 0; m < db->messageCount; m++)
+    {
+        const DbcDecode_MessageType *message = &db->messages[m];
+
+        fprintf(file, "message %s 0x%X %u %s %d %lu %llu ", message->name, message->id & ~DBCDECODE_EXTENDED,
+                message->length, (message->fd != 0) ? "fd" : "classic", message->brs, message->dataRate,
+                stats->rows[m]);
+        DbcDecode_Quoted(file, message->comment);
+        fprintf(file, "\ncolumn %s.time.f64 \"s\"\n", message->name);
+        for (unsigned int s = 0; s < message->signalCount; s++)
+        {
+            const DbcDecode_SignalType *signal = &message->signals[s];
+
+            fprintf(file, "column %s.%s.f64 ", message->name, signal->name);
+            DbcDecode_Quoted(file, signal->unit);
+            fprintf(file, " %.15g %.15g %.15g %.15g", signal->factor, signal->offset, signal->minimum,
+                    signal->maximum);
+            if (signal->table >= 0)
+            {
+                const DbcDecode_TableType *table = &db->tables[signal->table];
+
+                fputc(' ', file);
+                for (unsigned int v = 0; v < table->count; v++)
+                {
+                    fprintf(file, "%s%lld=%s", (v == 0u) ? "" : ",", table->values[v].value,
+                            table->values[v].label);
+                }
+            }
+            fputc('\n', file);
+        }
+    }
+    if (fclose(file) != 0)
+    {
+        (void)snprintf(error, errorSize, "%s: %s", path, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+static void DbcDecode_InitHex(void)
+{
+    for (unsigned int c = 0; c < 256u; c++)
+    {
+        DbcDecode_Hex[c] = (c >= '0' && c <= '9') ? (signed char)(c - '0')
+                         : (c >= 'A' && c <= 'F') ? (signed char)(c - 'A' + 10u)
+                         : (c >= 'a' && c <= 'f') ? (signed char)(c - 'a' + 10u) : (signed char)-1;
+    }
+}
+
+static double DbcDecode_Now(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Account a decoded chunk, write it and let the kernel drop its pages */
+static int DbcDecode_Retire(DbcDecode_OutputType *output, DbcDecode_ChunkType *chunk,
+                            DbcDecode_StatisticsType *stats, const unsigned char *map, char *error, size_t errorSize)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t first = (size_t)(chunk->begin - map) & ~(page - 1u);
+    size_t last = (size_t)(chunk->end - map) & ~(page - 1u);
+
+    if (chunk->failed != 0)
+    {
+        (void)snprintf(error, errorSize, "out of memory for the columns");
+        return -1;
+    }
+    stats->frames += chunk->frames;
+    stats->decoded += chunk->decoded;
+    stats->unknown += chunk->unknown;
+    stats->malformed += chunk->malformed;
+    for (unsigned int m = 0; m < output->db->messageCount; m++)
+    {
+        stats->rows[m] += chunk->rows[m];
+    }
+    if (last > first)
+    {
+        (void)madvise((void *)(map + first), last - first, MADV_DONTNEED);
+    }
+    return (output->directory != NULL) ? DbcDecode_Write(output, chunk, error, errorSize) : 0;
+}
+
+int DbcDecode_File(const DbcDecode_DatabaseType *db, const char *logPath, const char *outputDir,
+                   unsigned int threads, DbcDecode_StatisticsType *stats, char *error, size_t errorSize)
+{
+    DbcDecode_ChunkType *chunks = NULL;
+    DbcDecode_RangeType *ranges = NULL;
+    DbcDecode_OutputType output = {db, outputDir, NULL};
+    DbcDecode_FormatType format = DBCDECODE_CANDUMP;
+    double tickPeriod = 0.0;
+    double start = DbcDecode_Now();
+    unsigned char *map = NULL;
+    struct stat info;
+    struct rlimit limit;
+    size_t rangeCount = 0u;
+    size_t next = 0u;
+    unsigned int previous = 0u;
+    unsigned int set = 0u;
+    int result = -1;
+    int file;
+
+    (void)memset(stats, 0, sizeof(*stats));
+    DbcDecode_InitHex();
+    if (threads == 0u)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (unsigned int)online : 1u;
+    }
+    threads = (threads > DBCDECODE_MAX_THREADS) ? DBCDECODE_MAX_THREADS : threads;
+
+    file = open(logPath, O_RDONLY);
+    if (file < 0 || fstat(file, &info) != 0)
+    {
+        (void)snprintf(error, errorSize, "%s: %s", logPath, strerror(errno));
+        if (file >= 0)
+        {
+            (void)close(file);
+        }
+        return -1;
+    }
+    stats->bytes = (unsigned long long)info.st_size;
+    if (info.st_size > 0)
+    {
+        map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    (void)close(file);
+    if (map == MAP_FAILED || map == NULL)
+    {
+        (void)snprintf(error, errorSize, "%s: cannot be mapped", logPath);
+        return -1;
+    }
+    (void)madvise(map, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+    if ((size_t)info.st_size >= DBCDECODE_RECLOG_HEADER && DbcDecode_Get32(map) == DBCDECODE_RECLOG_MAGIC)
+    {
+        if (DbcDecode_Get32(&map[4]) != DBCDECODE_RECLOG_VERSION || DbcDecode_Get32(&map[8]) == 0u)
+        {
+            (void)snprintf(error, errorSize, "%s: unsupported RecLog version", logPath);
+            goto done;
+        }
+        format = DBCDECODE_RECLOG;
+        tickPeriod = 1.0 / (double)DbcDecode_Get32(&map[8]);
+    }
+    else if (map[0] != '(')
+    {
+        (void)snprintf(error, errorSize, "%s: neither a candump nor a RecLog log", logPath);
+        goto done;
+    }
+
+    rangeCount = DbcDecode_Split(map, (size_t)info.st_size, format, &ranges);
+    chunks = calloc(2u * threads, sizeof(DbcDecode_ChunkType));
+    output.files = malloc(db->columnCount * sizeof(int));
+    if (ranges == NULL || chunks == NULL || output.files == NULL)
+    {
+        (void)snprintf(error, errorSize, "out of memory");
+        goto done;
+    }
+    for (unsigned int c = 0; c < db->columnCount; c++)
+    {
+        output.files[c] = -1;
+    }
+    for (unsigned int c = 0; c < 2u * threads; c++)
+    {
+        chunks[c].db = db;
+        chunks[c].format = format;
+        chunks[c].tickPeriod = tickPeriod;
+        chunks[c].columns = calloc(db->columnCount + 1u, sizeof(double *));
+        if (chunks[c].columns == NULL)
+        {
+            (void)snprintf(error, errorSize, "out of memory");
+            goto done;
+        }
+    }
+
+    /* One file descriptor per column */
+    if (outputDir != NULL && getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max)
+    {
+        limit.rlim_cur = limit.rlim_max;
+        (void)setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    /* Two sets of chunks: one set decodes while the previous is written */
+    while (next < rangeCount || previous > 0u)
+    {
+        DbcDecode_ChunkType *current = &chunks[set * threads];
+        unsigned int count = 0u;
+
+        while (count < threads && next < rangeCount)
+        {
+            current[count].begin = map + ranges[next].begin;
+            current[count].end = map + ranges[next].end;
+            current[count].startTick = ranges[next].startTick;
+            if (pthread_create(&current[count].thread, NULL, DbcDecode_Worker, &current[count]) != 0)
+            {
+                break;
+            }
+            count++;
+            next++;
+        }
+
+        result = 0;
+        for (unsigned int c = 0; c < previous && result == 0; c++)
+        {
+            result = DbcDecode_Retire(&output, &chunks[(set ^ 1u) * threads + c], stats, map, error, errorSize);
+        }
+        for (unsigned int c = 0; c < count; c++)
+        {
+            (void)pthread_join(current[c].thread, NULL);
+        }
+        if (result != 0 || (count == 0u && next < rangeCount))
+        {
+            if (result == 0)
+            {
+                (void)snprintf(error, errorSize, "cannot start a decoding thread");
+            }
+            result = -1;
+            goto done;
+        }
+        previous = count;
+        set ^= 1u;
+    }
+    stats->chunks = (unsigned int)rangeCount;
+    result = (outputDir != NULL) ? DbcDecode_Manifest(&output, logPath, stats, error, errorSize) : 0;
+
+done:
+    if (chunks != NULL)
+    {
+        for (unsigned int c = 0; c < 2u * threads; c++)
+        {
+            for (unsigned int k = 0; (chunks[c].columns != NULL) && (k < db->columnCount); k++)
+            {
+                free(chunks[c].columns[k]);
+            }
+            free(chunks[c].columns);
+        }
+    }
+    if (output.files != NULL)
+    {
+        for (unsigned int c = 0; c < db->columnCount; c++)
+        {
+            if (output.files[c] >= 0)
+            {
+                (void)close(output.files[c]);
+            }
+        }
+    }
+    free(output.files);
+    free(chunks);
+    free(ranges);
+    (void)munmap(map, (size_t)info.st_size);
+    stats->seconds = DbcDecode_Now() - start;
+    return result;
+}
@@ -0,0 +1,144 @@
+/*
+ * DbcDecode.h - Streaming DBC Decoder for Recorded CAN-FD Logs
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Host tool for the post-processing of recorded logs. Loads a
+ *              DBC file, compiles one extraction plan per signal, and
+ *              decodes candump logs (SocketCAN "candump -l") and RecLog
+ *              logs into one column of float64 per signal and one time
+ *              column per message. The log is mapped into memory, split
+ *              into chunks at frame boundaries and decoded by a pool of
+ *              threads, one chunk per thread, while the columns of the
+ *              previous chunks are written in log order.
+ */
+
+#ifndef DBCDECODE_H
+#define DBCDECODE_H
+
+#include <stddef.h>
+
+#define DBCDECODE_MAX_MESSAGES       (256u)
+#define DBCDECODE_MAX_SIGNALS        (64u)
+#define DBCDECODE_MAX_TABLES         (256u)
+#define DBCDECODE_MAX_VALUES         (64u)
+#define DBCDECODE_NAME_LENGTH        (64u)
+#define DBCDECODE_COMMENT_LENGTH     (256u)
+
+/* Standard IDs are looked up directly, extended IDs through a search */
+#define DBCDECODE_DIRECT_IDS         (0x800u)
+
+/* DBC ID flag of extended IDs */
+#define DBCDECODE_EXTENDED           (0x80000000u)
+
+/* Longest CAN-FD frame */
+#define DBCDECODE_MAX_DATA           (64u)
+
+#define DBCDECODE_MAX_THREADS        (64u)
+
+/* Raw value types of SIG_VALTYPE_ */
+#define DBCDECODE_INTEGER            (0u)
+#define DBCDECODE_FLOAT32            (1u)
+#define DBCDECODE_FLOAT64            (2u)
+
+typedef struct {
+    long long value;
+    char label[DBCDECODE_NAME_LENGTH];
+} DbcDecode_ValueType;
+
+/* VAL_TABLE_, or the VAL_ description of one signal */
+typedef struct {
+    char name[DBCDECODE_NAME_LENGTH];
+    DbcDecode_ValueType values[DBCDECODE_MAX_VALUES];
+    unsigned int count;
+} DbcDecode_TableType;
+
+/* Extraction plan of a signal: raw = (window(byteOffset) >> shift) & mask */
+typedef struct {
+    unsigned int byteOffset;     /* First byte of the 8-byte window */
+    unsigned int shift;
+    unsigned long long mask;
+    unsigned long long signBit;  /* 0: unsigned */
+    unsigned int needed;         /* Frame length that holds the signal */
+    int bigEndian;               /* Window loaded big endian (Motorola) */
+    int wide;                    /* Signal does not fit one window; read bit by bit */
+} DbcDecode_PlanType;
+
+typedef struct {
+    char name[DBCDECODE_NAME_LENGTH];
+    char unit[DBCDECODE_NAME_LENGTH];
+    unsigned int startBit;
+    unsigned int bitLength;
+    int motorola;                /* @0: big endian, start bit is the MSB */
+    int isSigned;
+    unsigned int valueType;
+    double factor;
+    double offset;
+    double minimum;
+    double maximum;
+    int multiplexor;             /* Signal is the multiplexor of its message */
+    long long multiplexValue;    /* -1: not multiplexed */
+    int table;                   /* Value table; -1: none */
+    DbcDecode_PlanType plan;
+} DbcDecode_SignalType;
+
+typedef struct {
+    unsigned int id;             /* DBC ID, DBCDECODE_EXTENDED for extended IDs */
+    char name[DBCDECODE_NAME_LENGTH];
+    char comment[DBCDECODE_COMMENT_LENGTH];
+    unsigned int length;
+    int fd;                      /* CAN-FD frame: longer than 8 bytes or CANFD_BRS */
+    int brs;                     /* CANFD_BRS */
+    unsigned long dataRate;      /* CANFD_DataRate; 0: not given */
+    int multiplexor;             /* Signal index of the multiplexor; -1: none */
+    unsigned int column;         /* Time column; the signal columns follow */
+    DbcDecode_SignalType signals[DBCDECODE_MAX_SIGNALS];
+    unsigned int signalCount;
+} DbcDecode_MessageType;
+
+typedef struct {
+    DbcDecode_MessageType messages[DBCDECODE_MAX_MESSAGES];
+    unsigned int messageCount;
+    DbcDecode_TableType tables[DBCDECODE_MAX_TABLES];
+    unsigned int tableCount;
+    unsigned int columnCount;
+    short direct[DBCDECODE_DIRECT_IDS];   /* Message per standard ID; -1: none */
+} DbcDecode_DatabaseType;
+
+typedef struct {
+    unsigned long long bytes;
+    unsigned long long frames;
+    unsigned long long decoded;  /* Frames of a message of the database */
+    unsigned long long unknown;  /* Frames of other IDs */
+    unsigned long long malformed;
+    unsigned long long rows[DBCDECODE_MAX_MESSAGES];
+    unsigned int chunks;
+    double seconds;
+} DbcDecode_StatisticsType;
+
+/**
+ * @brief   Load a DBC file and compile the extraction plans
+ * @return  0, or -1 with the reason and line in error
+ */
+int DbcDecode_Load(const char *path, DbcDecode_DatabaseType *db, char *error, size_t errorSize);
+
+/**
+ * @brief   Decode a log into columns
+ * @details The format is taken from the first bytes of the log. With
+ *          outputDir NULL the columns are decoded and dropped, to measure
+ *          the decoder alone.
+ * @param   threads  Decoding threads; 0: one per online CPU
+ * @return  0, or -1 with the reason in error
+ */
+int DbcDecode_File(const DbcDecode_DatabaseType *db, const char *logPath, const char *outputDir,
+                   unsigned int threads, DbcDecode_StatisticsType *stats, char *error, size_t errorSize);
+
+/* Physical value of a signal in a frame; NaN if the frame does not carry it */
+double DbcDecode_Signal(const DbcDecode_MessageType *message, unsigned int signal, const unsigned char *data,
+                        unsigned int length);
+
+/* Message of a DBC ID; NULL if the database has none */
+const DbcDecode_MessageType *DbcDecode_Find(const DbcDecode_DatabaseType *db, unsigned int id);
+
+#endif /* DBCDECODE_H */
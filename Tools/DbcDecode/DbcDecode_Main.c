@@ -0,0 +1,72 @@
+/*
+ * DbcDecode_Main.c - Command Line of the DBC Decoder
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Decodes a candump or RecLog log with the messages of a DBC
+ *              file into one float64 column file per signal, described by
+ *              columns.txt in the output directory.
+ *
+ *              Usage: DbcDecode [-j <threads>] <DBC file> <log> [<output directory>]
+ *
+ *              Without an output directory the log is decoded and only the
+ *              statistics are printed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "DbcDecode.h"
+
+static DbcDecode_DatabaseType DbcDecode_Database;
+
+static int DbcDecode_Usage(void)
+{
+    fprintf(stderr, "Usage: DbcDecode [-j <threads>] <DBC file> <log> [<output directory>]\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    DbcDecode_StatisticsType stats;
+    char error[512];
+    unsigned int threads = 0u;
+    const char *outputDir = NULL;
+    int arg = 1;
+
+    if (argc > 2 && strcmp(argv[1], "-j") == 0)
+    {
+        threads = (unsigned int)atoi(argv[2]);
+        arg = 3;
+    }
+    if (argc - arg < 2 || argc - arg > 3)
+    {
+        return DbcDecode_Usage();
+    }
+    if (argc - arg == 3)
+    {
+        outputDir = argv[arg + 2];
+        (void)mkdir(outputDir, 0755);
+    }
+
+    if (DbcDecode_Load(argv[arg], &DbcDecode_Database, error, sizeof(error)) != 0 ||
+        DbcDecode_File(&DbcDecode_Database, argv[arg + 1], outputDir, threads, &stats, error, sizeof(error)) != 0)
+    {
+        fprintf(stderr, "DbcDecode: %s\n", error);
+        return 1;
+    }
+
+    printf("%llu bytes in %u chunks, %.3f s, %.0f MB/s\n", stats.bytes, stats.chunks, stats.seconds,
+           (stats.seconds > 0.0) ? (double)stats.bytes / stats.seconds / 1e6 : 0.0);
+    printf("%llu frames: %llu decoded, %llu of other IDs, %llu malformed\n", stats.frames, stats.decoded,
+           stats.unknown, stats.malformed);
+    for (unsigned int m = 0; m < DbcDecode_Database.messageCount; m++)
+    {
+        printf("  %-24s %12llu rows, %u signals\n", DbcDecode_Database.messages[m].name, stats.rows[m],
+               DbcDecode_Database.messages[m].signalCount);
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*
+ * LutGen.c - Lookup Table Generator
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Host tool run by the Makefile before the BSW is compiled.
+ *              Evaluates the functions and sensor curves configured in
+ *              Lut_Cfg.h in double precision and writes them as constant
+ *              tables to Lut_Tables.c, so a change of table size or curve
+ *              parameters only needs a rebuild.
+ *
+ *              Usage: LutGen <output file>
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "Lut_Cfg.h"
+
+#define LUTGEN_PI                    (3.14159265358979323846)
+#define LUTGEN_VALUES_PER_LINE       (8u)
+
+/* Round to the nearest integer and saturate to the sint16 range used by the tables */
+static long LutGen_Quantize(double value)
+{
+    double r = floor(value + 0.5);
+
+    if (r > 32767.0)
+    {
+        r = 32767.0;
+    }
+    else if (r < -32767.0)
+    {
+        r = -32767.0;
+    }
+    return (long)r;
+}
+
+/* sin in Q15 at entry k of a full turn */
+static double LutGen_Sin(unsigned int k)
+{
+    return sin(2.0 * LUTGEN_PI * (double)k / (double)LUT_SIN_SIZE) * 32768.0;
+}
+
+/* atan(k / size) in 1/65536 turn */
+static double LutGen_Atan(unsigned int k)
+{
+    return atan((double)k / (double)LUT_ATAN_SIZE) * 65536.0 / (2.0 * LUTGEN_PI);
+}
+
+/* Raw ADC value at breakpoint k of a sensor curve */
+static double LutGen_CurveRaw(unsigned int k)
+{
+    return (double)k * (double)(1u << LUT_ADC_BITS) / (double)LUT_CURVE_SIZE;
+}
+
+/* DC link voltage in 0.1 V at breakpoint k */
+static double LutGen_DcLink(unsigned int k)
+{
+    return LutGen_CurveRaw(k) * LUT_VDC_FULL_SCALE * 10.0 / (double)(1u << LUT_ADC_BITS);
+}
+
+/* NTC temperature in 0.1 degC at breakpoint k; the divider ratio gives the resistance */
+static double LutGen_Ntc(unsigned int k)
+{
+    double ratio = LutGen_CurveRaw(k) / (double)(1u << LUT_ADC_BITS);
+    double r;
+    double t;
+
+    if (ratio <= 0.0)
+    {
+        return LUT_NTC_T_MAX * 10.0;
+    }
+    if (ratio >= 1.0)
+    {
+        return LUT_NTC_T_MIN * 10.0;
+    }
+
+    r = LUT_NTC_PULLUP * ratio / (1.0 - ratio);
+    t = 1.0 / (1.0 / 298.15 + log(r / LUT_NTC_R25) / LUT_NTC_BETA) - 273.15;
+    if (t > LUT_NTC_T_MAX)
+    {
+        t = LUT_NTC_T_MAX;
+    }
+    else if (t < LUT_NTC_T_MIN)
+    {
+        t = LUT_NTC_T_MIN;
+    }
+    return t * 10.0;
+}
+
+/* Curve functions, indexed by LUT_CURVE_* */
+static double (*const LutGen_Curves[LUT_CURVE_COUNT])(unsigned int) = {
+    LutGen_DcLink,
+    LutGen_Ntc
+};
+
+static void LutGen_WriteValues(FILE *out, const char *indent, unsigned int count,
+                               double (*eval)(unsigned int))
+{
+    for (unsigned int k = 0; k < count; k++)
+    {
+        if ((k % LUTGEN_VALUES_PER_LINE) == 0u)
+        {
+            fprintf(out, "%s", indent);
+        }
+        fprintf(out, "%ld%s", LutGen_Quantize(eval(k)), (k + 1u < count) ? "," : "");
+        fprintf(out, "%s", ((k % LUTGEN_VALUES_PER_LINE) == LUTGEN_VALUES_PER_LINE - 1u ||
+                            k + 1u == count) ? "\n" : " ");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    FILE *out;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <output file>\n", argv[0]);
+        return 1;
+    }
+    out = fopen(argv[1], "w");
+    if (out == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    fprintf(out, "/*\n * Lut_Tables.c - Generated by Tools/LutGen from Lut_Cfg.h, do not edit\n */\n\n");
+    fprintf(out, "#include \"Lut_Cfg.h\"\n\n");
+
+    fprintf(out, "/* sin, Q15, %u entries per turn */\n", LUT_SIN_SIZE);
+    fprintf(out, "const sint16 Lut_SinTable[LUT_SIN_SIZE + 2u] = {\n");
+    LutGen_WriteValues(out, "    ", LUT_SIN_SIZE + 2u, LutGen_Sin);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "/* atan(r), r = [0, 1] in %u steps, 1/65536 turn */\n", LUT_ATAN_SIZE);
+    fprintf(out, "const sint16 Lut_AtanTable[LUT_ATAN_SIZE + 2u] = {\n");
+    LutGen_WriteValues(out, "    ", LUT_ATAN_SIZE + 2u, LutGen_Atan);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "/* Sensor curves, %u raw ADC counts per step */\n",
+            (1u << LUT_ADC_BITS) / LUT_CURVE_SIZE);
+    fprintf(out, "const sint16 Lut_CurveTable[LUT_CURVE_COUNT][LUT_CURVE_SIZE + 2u] = {\n");
+    for (unsigned int curve = 0; curve < LUT_CURVE_COUNT; curve++)
+    {
+        fprintf(out, "    {\n");
+        LutGen_WriteValues(out, "        ", LUT_CURVE_SIZE + 2u, LutGen_Curves[curve]);
+        fprintf(out, "    }%s\n", (curve + 1u < LUT_CURVE_COUNT) ? "," : "");
+    }
+    fprintf(out, "};\n");
+
+    if (fclose(out) != 0)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,486 @@
+/*
+ * PduRGen.c - PDU Router Table Generator
+ *
+ * Created on: 2023-xx-xx
+ * Author: BSW Team
+ *
+ * Description: Host tool run by the Makefile before the BSW is compiled.
+ *              Expands PDUR_ROUTING_TABLE of PduR_Cfg.h, groups the signals
+ *              into routes, turns signal routes of matching layout into PDU
+ *              routes forwarding the leading bytes they cover, and writes the route tables, the buffers and a
+ *              direct-indexed source table per channel to PduR_Routes.c.
+ *
+ *              Usage: PduRGen <output file>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "PduR_Cfg.h"
+
+#define PDURGEN_MAX_ENTRIES          (256u)
+
+/* One PDU or SIGNAL entry of the description */
+typedef struct {
+    unsigned int srcChannel;
+    unsigned int srcId;
+    unsigned int srcBit;
+    unsigned int bitLength;      /* 0: PDU entry */
+    unsigned int dstChannel;
+    unsigned int dstId;
+    unsigned int dstBit;
+    unsigned int minIntervalMs;
+} PduRGen_EntryType;
+
+/* A route: the entries from one source PDU to one destination PDU */
+typedef struct {
+    unsigned int srcChannel;
+    unsigned int srcId;
+    unsigned int dstChannel;
+    unsigned int dstId;
+    unsigned int minIntervalMs;
+    unsigned int signals[PDURGEN_MAX_ENTRIES];
+    unsigned int signalCount;    /* 0: PDU route */
+    unsigned int minSrcLength;
+    unsigned int prefixLength;   /* Merged PDU route: leading bytes forwarded */
+    int buffer;                  /* -1: none */
+} PduRGen_RouteType;
+
+/* Destination PDU composed of signals */
+typedef struct {
+    unsigned int channel;
+    unsigned int id;
+    unsigned int length;
+} PduRGen_ComposedType;
+
+static PduRGen_EntryType PduRGen_Entries[PDURGEN_MAX_ENTRIES];
+static unsigned int PduRGen_EntryCount;
+static PduRGen_RouteType PduRGen_Routes[PDURGEN_MAX_ENTRIES];
+static unsigned int PduRGen_RouteCount;
+static PduRGen_ComposedType PduRGen_Composed[PDURGEN_MAX_ENTRIES];
+static unsigned int PduRGen_ComposedCount;
+static unsigned int PduRGen_Merged;
+
+static void PduRGen_Fail(const char *message, unsigned int channel, unsigned int id)
+{
+    fprintf(stderr, "PduRGen: %s (channel %u, ID 0x%X)\n", message, channel, id);
+    exit(1);
+}
+
+static void PduRGen_Add(unsigned int srcChannel, unsigned int srcId, unsigned int srcBit,
+                        unsigned int bitLength, unsigned int dstChannel, unsigned int dstId,
+                        unsigned int dstBit, unsigned int minIntervalMs)
+{
+    PduRGen_EntryType *entry = &PduRGen_Entries[PduRGen_EntryCount++];
+
+    entry->srcChannel = srcChannel;
+    entry->srcId = srcId;
+    entry->srcBit = srcBit;
+    entry->bitLength = bitLength;
+    entry->dstChannel = dstChannel;
+    entry->dstId = dstId;
+    entry->dstBit = dstBit;
+    entry->minIntervalMs = minIntervalMs;
+}
+
+#define PDURGEN_PDU(SrcChannel, SrcId, DstChannel, DstId, MinIntervalMs) \
+    PduRGen_Add((SrcChannel), (SrcId), 0u, 0u, (DstChannel), (DstId), 0u, (MinIntervalMs));
+#define PDURGEN_SIGNAL(SrcChannel, SrcId, SrcBit, BitLength, DstChannel, DstId, DstBit, MinIntervalMs) \
+    PduRGen_Add((SrcChannel), (SrcId), (SrcBit), (BitLength), (DstChannel), (DstId), (DstBit), (MinIntervalMs));
+
+static PduRGen_RouteType *PduRGen_FindRoute(const PduRGen_EntryType *entry)
+{
+    for (unsigned int r = 0; r < PduRGen_RouteCount; r++)
+    {
+        PduRGen_RouteType *route = &PduRGen_Routes[r];
+
+        if (route->srcChannel == entry->srcChannel && route->srcId == entry->srcId &&
+            route->dstChannel == entry->dstChannel && route->dstId == entry->dstId)
+        {
+            return route;
+        }
+    }
+    return NULL;
+}
+
+/* Group the entries into routes and check them */
+static void PduRGen_Group(void)
+{
+    for (unsigned int e = 0; e < PduRGen_EntryCount; e++)
+    {
+        const PduRGen_EntryType *entry = &PduRGen_Entries[e];
+        PduRGen_RouteType *route = PduRGen_FindRoute(entry);
+        unsigned int srcEnd = (entry->srcBit + entry->bitLength + 7u) / 8u;
+
+        if (entry->srcChannel >= COMM_MAX_CHANNELS || entry->dstChannel >= COMM_MAX_CHANNELS ||
+            entry->srcId > 0xFFFFu || entry->dstId > 0xFFFFu)
+        {
+            PduRGen_Fail("channel or ID out of range", entry->srcChannel, entry->srcId);
+        }
+        if (entry->bitLength > 32u || srcEnd > PDUR_MAX_PDU_LENGTH ||
+            (entry->dstBit + entry->bitLength + 7u) / 8u > PDUR_MAX_PDU_LENGTH)
+        {
+            PduRGen_Fail("signal longer than 32 bits or beyond the PDU", entry->srcChannel, entry->srcId);
+        }
+
+        if (route == NULL)
+        {
+            route = &PduRGen_Routes[PduRGen_RouteCount++];
+            route->srcChannel = entry->srcChannel;
+            route->srcId = entry->srcId;
+            route->dstChannel = entry->dstChannel;
+            route->dstId = entry->dstId;
+            route->minIntervalMs = entry->minIntervalMs;
+            route->signalCount = 0u;
+            route->minSrcLength = 0u;
+            route->prefixLength = 0u;
+            route->buffer = -1;
+        }
+        else if (entry->bitLength == 0u || route->signalCount == 0u)
+        {
+            PduRGen_Fail("PDU routed twice to one destination", entry->srcChannel, entry->srcId);
+        }
+        else if (route->minIntervalMs != entry->minIntervalMs)
+        {
+            PduRGen_Fail("signals of one route with different intervals", entry->srcChannel, entry->srcId);
+        }
+        else
+        {
+            /* Next signal of the route */
+        }
+
+        if (entry->bitLength != 0u)
+        {
+            route->signals[route->signalCount++] = e;
+            route->minSrcLength = (srcEnd > route->minSrcLength) ? srcEnd : route->minSrcLength;
+        }
+        if (route->minIntervalMs > 0xFFFFu)
+        {
+            PduRGen_Fail("interval out of range", entry->srcChannel, entry->srcId);
+        }
+    }
+}
+
+/* Number of routes to a destination PDU, and whether a PDU route is among them */
+static unsigned int PduRGen_Writers(unsigned int channel, unsigned int id, unsigned int *pduRoutes)
+{
+    unsigned int writers = 0u;
+
+    *pduRoutes = 0u;
+    for (unsigned int r = 0; r < PduRGen_RouteCount; r++)
+    {
+        if (PduRGen_Routes[r].dstChannel == channel && PduRGen_Routes[r].dstId == id)
+        {
+            writers++;
+            *pduRoutes += (PduRGen_Routes[r].signalCount == 0u) ? 1u : 0u;
+        }
+    }
+    return writers;
+}
+
+/* Whether the signals of a route, each at its source position, cover bits
+ * 0 up to the end of their last byte without a gap or an overlap */
+static unsigned int PduRGen_Tiles(const PduRGen_RouteType *route)
+{
+    unsigned int covered = 0u;
+    unsigned int progress = 1u;
+
+    while (progress != 0u)
+    {
+        progress = 0u;
+        for (unsigned int s = 0; s < route->signalCount; s++)
+        {
+            const PduRGen_EntryType *entry = &PduRGen_Entries[route->signals[s]];
+
+            if (entry->srcBit == covered)
+            {
+                covered += entry->bitLength;
+                progress = 1u;
+            }
+        }
+    }
+    return (covered == route->minSrcLength * 8u) ? 1u : 0u;
+}
+
+/* A signal route that alone writes its destination PDU, every signal at its
+ * source position and together tiling the composed PDU, forwards that many
+ * leading bytes of the source PDU as they are. Bytes beyond them, such as
+ * E2E counters and CRCs, are not forwarded. */
+static void PduRGen_MergeLayouts(void)
+{
+    unsigned int pduRoutes;
+    unsigned int bits;
+
+    for (unsigned int r = 0; r < PduRGen_RouteCount; r++)
+    {
+        PduRGen_RouteType *route = &PduRGen_Routes[r];
+        unsigned int same = 1u;
+
+        if (route->signalCount == 0u)
+        {
+            continue;
+        }
+        if (PduRGen_Writers(route->dstChannel, route->dstId, &pduRoutes) != 1u)
+        {
+            continue;
+        }
+        bits = 0u;
+        for (unsigned int s = 0; s < route->signalCount; s++)
+        {
+            const PduRGen_EntryType *entry = &PduRGen_Entries[route->signals[s]];
+
+            same = (entry->srcBit == entry->dstBit) ? same : 0u;
+            bits += entry->bitLength;
+        }
+        if (same != 0u && bits == route->minSrcLength * 8u && PduRGen_Tiles(route) != 0u)
+        {
+            route->prefixLength = route->minSrcLength;
+            route->signalCount = 0u;
+            PduRGen_Merged++;
+        }
+    }
+}
+
+/* Buffers: one per composed destination PDU, one per limited PDU route */
+static void PduRGen_AssignBuffers(void)
+{
+    unsigned int pduRoutes;
+
+    for (unsigned int r = 0; r < PduRGen_RouteCount; r++)
+    {
+        PduRGen_RouteType *route = &PduRGen_Routes[r];
+        unsigned int c;
+
+        if (route->signalCount == 0u)
+        {
+            if (route->minIntervalMs != 0u)
+            {
+                route->buffer = (int)PduRGen_ComposedCount;
+                PduRGen_Composed[PduRGen_ComposedCount].channel = route->dstChannel;
+                PduRGen_Composed[PduRGen_ComposedCount].id = route->dstId;
+                PduRGen_Composed[PduRGen_ComposedCount].length = PDUR_MAX_PDU_LENGTH;
+                PduRGen_ComposedCount++;
+            }
+            continue;
+        }
+        if (PduRGen_Writers(route->dstChannel, route->dstId, &pduRoutes) != 1u && pduRoutes != 0u)
+        {
+            PduRGen_Fail("PDU route and signal routes to one destination", route->dstChannel, route->dstId);
+        }
+
+        for (c = 0; c < PduRGen_ComposedCount; c++)
+        {
+            if (PduRGen_Composed[c].channel == route->dstChannel && PduRGen_Composed[c].id == route->dstId)
+            {
+                break;
+            }
+        }
+        if (c == PduRGen_ComposedCount)
+        {
+            PduRGen_Composed[c].channel = route->dstChannel;
+            PduRGen_Composed[c].id = route->dstId;
+            PduRGen_Composed[c].length = 0u;
+            PduRGen_ComposedCount++;
+        }
+        for (unsigned int s = 0; s < route->signalCount; s++)
+        {
+            const PduRGen_EntryType *entry = &PduRGen_Entries[route->signals[s]];
+            unsigned int end = (entry->dstBit + entry->bitLength + 7u) / 8u;
+
+            PduRGen_Composed[c].length = (end > PduRGen_Composed[c].length) ? end : PduRGen_Composed[c].length;
+        }
+        route->buffer = (int)c;
+    }
+}
+
+/* Order the routes by channel and source ID, stable, so the routes of one
+ * source keep the description order */
+static void PduRGen_Sort(void)
+{
+    for (unsigned int r = 1; r < PduRGen_RouteCount; r++)
+    {
+        PduRGen_RouteType route = PduRGen_Routes[r];
+        unsigned long key = ((unsigned long)route.srcChannel << 16) | route.srcId;
+        unsigned int i = r;
+
+        while (i > 0u &&
+               (((unsigned long)PduRGen_Routes[i - 1u].srcChannel << 16) | PduRGen_Routes[i - 1u].srcId) > key)
+        {
+            PduRGen_Routes[i] = PduRGen_Routes[i - 1u];
+            i--;
+        }
+        PduRGen_Routes[i] = route;
+    }
+}
+
+static unsigned int PduRGen_Length(const PduRGen_RouteType *route)
+{
+    return (route->signalCount != 0u) ? PduRGen_Composed[route->buffer].length : route->prefixLength;
+}
+
+static void PduRGen_Write(FILE *out)
+{
+    static const char *const channelNames[COMM_MAX_CHANNELS] = {"Can", "Lin", "Fr", "Eth"};
+    unsigned int signal = 0u;
+
+    fprintf(out, "/*\n * PduR_Routes.c - Generated by Tools/PduRGen from PduR_Cfg.h, do not edit\n *\n");
+    fprintf(out, " * %u routes, %u of them signal routes turned into PDU routes as the\n", PduRGen_RouteCount,
+            PduRGen_Merged);
+    fprintf(out, " * layouts match\n */\n\n");
+    fprintf(out, "#include \"PduR_Cfg.h\"\n\n");
+
+    fprintf(out, "/* Composed and held PDUs */\n");
+    for (unsigned int c = 0; c < PduRGen_ComposedCount; c++)
+    {
+        fprintf(out, "static uint8 PduR_Buffer%u[%uu];   /* %s 0x%X */\n", c, PduRGen_Composed[c].length,
+                channelNames[PduRGen_Composed[c].channel], PduRGen_Composed[c].id);
+    }
+    fprintf(out, "\n");
+
+    fprintf(out, "const PduR_SignalType PduR_Signals[] = {\n");
+    for (unsigned int r = 0; r < PduRGen_RouteCount; r++)
+    {
+        for (unsigned int s = 0; s < PduRGen_Routes[r].signalCount; s++)
+        {
+            const PduRGen_EntryType *entry = &PduRGen_Entries[PduRGen_Routes[r].signals[s]];
+
+            fprintf(out, "    {%uu, %uu, %uu},\n", entry->srcBit, entry->dstBit, entry->bitLength);
+            signal++;
+        }
+    }
+    if (signal == 0u)
+    {
+        fprintf(out, "    {0u, 0u, 0u}   /* No signal routes */\n");
+    }
+    fprintf(out, "};\n\n");
+
+    signal = 0u;
+    fprintf(out, "const PduR_RouteType PduR_Routes[] = {\n");
+    for (unsigned int r = 0; r < PduRGen_RouteCount; r++)
+    {
+        const PduRGen_RouteType *route = &PduRGen_Routes[r];
+        char buffer[32];
+
+        if (route->buffer < 0)
+        {
+            snprintf(buffer, sizeof(buffer), "NULL_PTR");
+        }
+        else
+        {
+            snprintf(buffer, sizeof(buffer), "PduR_Buffer%d", route->buffer);
+        }
+        fprintf(out, "    /* %s 0x%X -> %s 0x%X */\n", channelNames[route->srcChannel], route->srcId,
+                channelNames[route->dstChannel], route->dstId);
+        fprintf(out, "    {%uu, 0x%04Xu, %uu, %uu, %uu, %uu, %uu, %s},\n", route->dstChannel, route->dstId,
+                route->minIntervalMs, signal, route->signalCount, route->minSrcLength, PduRGen_Length(route),
+                buffer);
+        signal += route->signalCount;
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "PduR_RouteStateType PduR_RouteState[%uu];\n\n", PduRGen_RouteCount);
+    fprintf(out, "const uint16 PduR_RouteCount = %uu;\n\n", PduRGen_RouteCount);
+
+    /* Direct-indexed source tables */
+    for (unsigned int ch = 0; ch < COMM_MAX_CHANNELS; ch++)
+    {
+        unsigned int first = 0xFFFFFFFFu;
+        unsigned int last = 0u;
+        unsigned int r = 0u;
+
+        for (unsigned int i = 0; i < PduRGen_RouteCount; i++)
+        {
+            if (PduRGen_Routes[i].srcChannel == ch)
+            {
+                first = (PduRGen_Routes[i].srcId < first) ? PduRGen_Routes[i].srcId : first;
+                last = (PduRGen_Routes[i].srcId > last) ? PduRGen_Routes[i].srcId : last;
+            }
+        }
+        if (first == 0xFFFFFFFFu)
+        {
+            continue;
+        }
+        if (last - first + 1u > PDUR_MAX_SOURCE_ENTRIES)
+        {
+            PduRGen_Fail("source IDs spread wider than PDUR_MAX_SOURCE_ENTRIES", ch, last);
+        }
+
+        fprintf(out, "/* %s source IDs 0x%X..0x%X */\n", channelNames[ch], first, last);
+        fprintf(out, "static const PduR_SourceType PduR_Sources%s[%uu] = {\n", channelNames[ch], last - first + 1u);
+        for (unsigned int id = first; id <= last; id++)
+        {
+            unsigned int count = 0u;
+
+            while (r < PduRGen_RouteCount &&
+                   (PduRGen_Routes[r].srcChannel < ch ||
+                    (PduRGen_Routes[r].srcChannel == ch && PduRGen_Routes[r].srcId < id)))
+            {
+                r++;
+            }
+            while (r + count < PduRGen_RouteCount && PduRGen_Routes[r + count].srcChannel == ch &&
+                   PduRGen_Routes[r + count].srcId == id)
+            {
+                count++;
+            }
+            fprintf(out, "    {%uu, %uu}%s\n", (count != 0u) ? r : 0u, count, (id < last) ? "," : "");
+        }
+        fprintf(out, "};\n\n");
+    }
+
+    fprintf(out, "const PduR_ChannelTableType PduR_ChannelTable[COMM_MAX_CHANNELS] = {\n");
+    for (unsigned int ch = 0; ch < COMM_MAX_CHANNELS; ch++)
+    {
+        unsigned int first = 0xFFFFFFFFu;
+        unsigned int last = 0u;
+
+        for (unsigned int i = 0; i < PduRGen_RouteCount; i++)
+        {
+            if (PduRGen_Routes[i].srcChannel == ch)
+            {
+                first = (PduRGen_Routes[i].srcId < first) ? PduRGen_Routes[i].srcId : first;
+                last = (PduRGen_Routes[i].srcId > last) ? PduRGen_Routes[i].srcId : last;
+            }
+        }
+        if (first == 0xFFFFFFFFu)
+        {
+            fprintf(out, "    {NULL_PTR, 0u, 0u}%s\n", (ch + 1u < COMM_MAX_CHANNELS) ? "," : "");
+        }
+        else
+        {
+            fprintf(out, "    {PduR_Sources%s, 0x%04Xu, %uu}%s\n", channelNames[ch], first, last - first + 1u,
+                    (ch + 1u < COMM_MAX_CHANNELS) ? "," : "");
+        }
+    }
+    fprintf(out, "};\n");
+}
+
+int main(int argc, char **argv)
+{
+    FILE *out;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <output file>\n", argv[0]);
+        return 1;
+    }
+
+    PDUR_ROUTING_TABLE(PDURGEN_PDU, PDURGEN_SIGNAL)
+    PduRGen_Group();
+    PduRGen_MergeLayouts();
+    PduRGen_AssignBuffers();
+    PduRGen_Sort();
+
+    out = fopen(argv[1], "w");
+    if (out == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    PduRGen_Write(out);
+    if (fclose(out) != 0)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    return 0;
+}